@@ -38,6 +38,7 @@
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/FlagArray.h>
 
 #include <casacore/casa/Arrays/ArrayIter.h>
 #include <casacore/casa/Arrays/MatrixIter.h>
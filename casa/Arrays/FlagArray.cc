@@ -0,0 +1,219 @@
+//# FlagArray.cc: Packed N-dimensional array of flags
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/Arrays/FlagArray.h>
+#include <casacore/casa/Arrays/ArrayError.h>
+#include <casacore/casa/OS/Conversion.h>
+#include <cstring>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+FlagArray::FlagArray()
+{}
+
+FlagArray::FlagArray (const IPosition& shape, Bool state)
+: shape_p (shape),
+  bits_p  (shape.product(), state)
+{}
+
+FlagArray::FlagArray (const Array<Bool>& flags)
+{
+    fromArray (flags);
+}
+
+void FlagArray::resize (const IPosition& shape, Bool state)
+{
+    shape_p.resize (shape.nelements(), False);
+    shape_p = shape;
+    bits_p.resize (shape.product(), state, False);
+}
+
+uInt FlagArray::toIndex (const IPosition& position) const
+{
+    if (! (position.nelements() == shape_p.nelements()  &&
+           position >= 0  &&  position < shape_p)) {
+        throw ArrayIndexError ("FlagArray: invalid position " +
+                               position.toString());
+    }
+    uInt index = 0;
+    for (Int i=shape_p.size()-1; i>=0; i--) {
+        index = index*shape_p[i] + position[i];
+    }
+    return index;
+}
+
+void FlagArray::checkShape (const FlagArray& that) const
+{
+    if (! shape_p.isEqual (that.shape_p)) {
+        throw ArrayConformanceError ("FlagArray: shapes " +
+                                     shape_p.toString() + " and " +
+                                     that.shape_p.toString() + " differ");
+    }
+}
+
+Bool FlagArray::anyFlagged() const
+{
+    uInt nbits  = nelements();
+    uInt nfull  = nbits / WORDSIZE;
+    const uInt* words = bits_p.storage();
+    for (uInt i=0; i<nfull; i++) {
+        if (words[i] != 0) {
+            return True;
+        }
+    }
+    //# Ignore the unused bits in the last word.
+    uInt nrem = nbits - nfull*WORDSIZE;
+    return nrem > 0  &&  (words[nfull] & ((1u << nrem) - 1)) != 0;
+}
+
+FlagArray& FlagArray::operator&= (const FlagArray& that)
+{
+    checkShape (that);
+    bits_p &= that.bits_p;
+    return *this;
+}
+FlagArray& FlagArray::operator|= (const FlagArray& that)
+{
+    checkShape (that);
+    bits_p |= that.bits_p;
+    return *this;
+}
+FlagArray& FlagArray::operator^= (const FlagArray& that)
+{
+    checkShape (that);
+    bits_p ^= that.bits_p;
+    return *this;
+}
+FlagArray FlagArray::operator& (const FlagArray& that) const
+{
+    FlagArray result(*this);
+    result &= that;
+    return result;
+}
+FlagArray FlagArray::operator| (const FlagArray& that) const
+{
+    FlagArray result(*this);
+    result |= that;
+    return result;
+}
+FlagArray FlagArray::operator^ (const FlagArray& that) const
+{
+    FlagArray result(*this);
+    result ^= that;
+    return result;
+}
+FlagArray FlagArray::operator~ () const
+{
+    FlagArray result(*this);
+    result.reverse();
+    return result;
+}
+
+Bool FlagArray::operator== (const FlagArray& that) const
+{
+    return shape_p.isEqual (that.shape_p)  &&  bits_p == that.bits_p;
+}
+
+void FlagArray::fromArray (const Array<Bool>& flags)
+{
+    if (! shape_p.isEqual (flags.shape())) {
+        resize (flags.shape());
+    }
+    Bool deleteIt;
+    const Bool* data = flags.getStorage (deleteIt);
+#if defined(AIPS_LITTLE_ENDIAN)
+    //# The bytes of the words have the packed bits format.
+    Conversion::boolToBit (bits_p.storage(), data, nelements());
+#else
+    std::vector<uChar> buf((nelements() + 7) / 8);
+    if (! buf.empty()) {
+        Conversion::boolToBit (&(buf[0]), data, nelements());
+        fromBits (&(buf[0]));
+    }
+#endif
+    flags.freeStorage (data, deleteIt);
+}
+
+void FlagArray::toArray (Array<Bool>& flags) const
+{
+    if (! flags.shape().isEqual (shape_p)) {
+        flags.resize (shape_p);
+    }
+    Bool deleteIt;
+    Bool* data = flags.getStorage (deleteIt);
+#if defined(AIPS_LITTLE_ENDIAN)
+    Conversion::bitToBool (data, bits_p.storage(), nelements());
+#else
+    std::vector<uChar> buf((nelements() + 7) / 8);
+    if (! buf.empty()) {
+        toBits (&(buf[0]));
+        Conversion::bitToBool (data, &(buf[0]), nelements());
+    }
+#endif
+    flags.putStorage (data, deleteIt);
+}
+
+Array<Bool> FlagArray::array() const
+{
+    Array<Bool> flags(shape_p);
+    toArray (flags);
+    return flags;
+}
+
+void FlagArray::fromBits (const uChar* bits)
+{
+    uInt nbytes = (nelements() + 7) / 8;
+    uInt* words = bits_p.storage();
+#if defined(AIPS_LITTLE_ENDIAN)
+    memcpy (words, bits, nbytes);
+#else
+    uInt nwords = (nelements() + WORDSIZE - 1) / WORDSIZE;
+    for (uInt i=0; i<nwords; i++) {
+        words[i] = 0;
+    }
+    for (uInt i=0; i<nbytes; i++) {
+        words[i/4] |= uInt(bits[i]) << (8 * (i%4));
+    }
+#endif
+}
+
+void FlagArray::toBits (uChar* bits) const
+{
+    uInt nbytes = (nelements() + 7) / 8;
+    const uInt* words = bits_p.storage();
+#if defined(AIPS_LITTLE_ENDIAN)
+    memcpy (bits, words, nbytes);
+#else
+    for (uInt i=0; i<nbytes; i++) {
+        bits[i] = (words[i/4] >> (8 * (i%4))) & 255;
+    }
+#endif
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,207 @@
+//# FlagArray.h: Packed N-dimensional array of flags
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_FLAGARRAY_H
+#define CASA_FLAGARRAY_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Utilities/BitVector.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Packed N-dimensional array of flags
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tFlagArray">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=BitVector>BitVector</linkto>
+//   <li> <linkto class=IPosition>IPosition</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A FlagArray holds an N-dimensional array of flags (or any boolean mask)
+// using one bit per element instead of the byte used by an
+// <src>Array<Bool></src>. The elements are stored in Fortran order in a
+// <linkto class=BitVector>BitVector</linkto>, so the logical operations
+// on whole arrays work on words of 32 flags at a time. Also counting the
+// number of flags set is done per word.
+// <p>
+// Conversion from and to an <src>Array<Bool></src> is possible, as well
+// as from and to the packed bits format used by the tables system
+// (see <src>Conversion::boolToBit</src>). Class
+// <linkto class=FlagColumn>FlagColumn</linkto> can be used to get or
+// put a FlagArray from or into a table column.
+// <p>
+// Note that a FlagArray has copy semantics (unlike Array).
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   FlagArray flags (IPosition(2,4,64));     // all False
+//   FlagArray rfi (IPosition(2,4,64));
+//   rfi.setFlag (IPosition(2,0,10), True);
+//   flags |= rfi;                           // merge the flags
+//   cout << flags.nflagged() << endl;
+// </srcblock>
+// </example>
+
+// <motivation>
+// Flags are read, combined and written in each calibration and flagging
+// step. Keeping them packed saves a factor 8 in memory and makes the
+// logical operations much faster.
+// </motivation>
+
+class FlagArray
+{
+public:
+    // Create an empty flag array.
+    FlagArray();
+
+    // Create a flag array with the given shape and set all flags to
+    // the given state.
+    explicit FlagArray (const IPosition& shape, Bool state=False);
+
+    // Create a flag array from an array of Bools.
+    explicit FlagArray (const Array<Bool>& flags);
+
+    // Get the shape.
+    const IPosition& shape() const
+      { return shape_p; }
+
+    // Get the number of dimensions.
+    uInt ndim() const
+      { return shape_p.nelements(); }
+
+    // Get the number of elements.
+    uInt nelements() const
+      { return bits_p.nbits(); }
+
+    // Resize the flag array; all flags are set to the given state.
+    void resize (const IPosition& shape, Bool state=False);
+
+    // Set all flags to the given state.
+    void set (Bool state)
+      { bits_p.set (state); }
+
+    // Get or set a flag given its index in the (Fortran ordered) array.
+    // <group>
+    Bool getFlag (uInt index) const
+      { return bits_p.getBit (index); }
+    void putFlag (uInt index, Bool state)
+      { bits_p.putBit (index, state); }
+    // </group>
+
+    // Get or set a flag given its position in the array.
+    // <group>
+    Bool getFlag (const IPosition& position) const
+      { return bits_p.getBit (toIndex (position)); }
+    void putFlag (const IPosition& position, Bool state)
+      { bits_p.putBit (toIndex (position), state); }
+    // </group>
+
+    // Get access to the underlying bits.
+    // <group>
+    const BitVector& bits() const
+      { return bits_p; }
+    BitVector& bits()
+      { return bits_p; }
+    // </group>
+
+    // Get the number of flags set.
+    uInt nflagged() const
+      { return bits_p.count(); }
+
+    // Are all or any flags set?
+    // <group>
+    Bool allFlagged() const
+      { return nflagged() == nelements(); }
+    Bool anyFlagged() const;
+    // </group>
+
+    // Logical operations on whole flag arrays working word by word.
+    // An exception is thrown if the shapes differ.
+    // <group>
+    FlagArray& operator&= (const FlagArray& that);
+    FlagArray& operator|= (const FlagArray& that);
+    FlagArray& operator^= (const FlagArray& that);
+    FlagArray operator& (const FlagArray& that) const;
+    FlagArray operator| (const FlagArray& that) const;
+    FlagArray operator^ (const FlagArray& that) const;
+    FlagArray operator~ () const;
+    void reverse()
+      { bits_p.reverse(); }
+    // </group>
+
+    // Are the shapes and all flags equal?
+    Bool operator== (const FlagArray& that) const;
+
+    // Set the flags from an array of Bools.
+    // The flag array is resized if needed.
+    void fromArray (const Array<Bool>& flags);
+
+    // Copy the flags into an array of Bools.
+    // The array is resized if needed.
+    void toArray (Array<Bool>& flags) const;
+
+    // Get the flags as an array of Bools.
+    Array<Bool> array() const;
+
+    // Set or get the flags from or into a buffer in the packed format of
+    // <src>Conversion::boolToBit</src> (bit i is bit i%8 of byte i/8).
+    // The buffer must have (nelements()+7)/8 bytes.
+    // <group>
+    void fromBits (const uChar* bits);
+    void toBits (uChar* bits) const;
+    // </group>
+
+private:
+    // Check if the shapes are equal; throw an exception if not.
+    void checkShape (const FlagArray& that) const;
+
+    // Get the index of a position.
+    uInt toIndex (const IPosition& position) const;
+
+    //# Data members.
+    IPosition shape_p;
+    BitVector bits_p;
+};
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -0,0 +1,118 @@
+//# tFlagArray.cc: Test program for class FlagArray
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/Arrays/FlagArray.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayError.h>
+#include <casacore/casa/OS/Conversion.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// Make a flag array with a pattern.
+Array<Bool> makeFlags (const IPosition& shape, uInt step)
+{
+  Array<Bool> arr(shape);
+  uInt i = 0;
+  for (Array<Bool>::iterator iter=arr.begin(); iter!=arr.end(); ++iter, ++i) {
+    *iter = (i%step == 0);
+  }
+  return arr;
+}
+
+void doIt()
+{
+  IPosition shape(3,4,13,5);
+  Array<Bool> arr1 = makeFlags (shape, 3);
+  Array<Bool> arr2 = makeFlags (shape, 5);
+  FlagArray f1(arr1);
+  FlagArray f2(arr2);
+  AlwaysAssertExit (f1.shape() == shape  &&  f1.nelements() == 260);
+  AlwaysAssertExit (allEQ (f1.array(), arr1));
+  AlwaysAssertExit (f1.nflagged() == ntrue(arr1));
+  AlwaysAssertExit (f1.getFlag (IPosition(3,3,0,0)) == arr1(IPosition(3,3,0,0)));
+  AlwaysAssertExit (f1.getFlag (IPosition(3,1,2,4)) == arr1(IPosition(3,1,2,4)));
+  // Logical operations.
+  AlwaysAssertExit (allEQ ((f1 & f2).array(), arr1 && arr2));
+  AlwaysAssertExit (allEQ ((f1 | f2).array(), arr1 || arr2));
+  AlwaysAssertExit (allEQ ((f1 ^ f2).array(), arr1 != arr2));
+  AlwaysAssertExit (allEQ ((~f1).array(), !arr1));
+  AlwaysAssertExit ((~f1).nflagged() == 260 - f1.nflagged());
+  FlagArray f3(f1);
+  f3 |= f2;
+  AlwaysAssertExit (f3 == (f1 | f2));
+  AlwaysAssertExit (! (f3 == f1));
+  // Set and test.
+  FlagArray f4(shape);
+  AlwaysAssertExit (! f4.anyFlagged()  &&  ! f4.allFlagged());
+  f4.putFlag (IPosition(3,3,12,4), True);
+  AlwaysAssertExit (f4.anyFlagged()  &&  f4.nflagged() == 1);
+  AlwaysAssertExit (f4.getFlag (259));
+  f4.set (True);
+  AlwaysAssertExit (f4.allFlagged());
+  f4.resize (IPosition(1,3), False);
+  AlwaysAssertExit (f4.nelements() == 3  &&  ! f4.anyFlagged());
+  // Packed bits.
+  std::vector<uChar> bits((f1.nelements() + 7) / 8);
+  f1.toBits (&(bits[0]));
+  std::vector<uChar> bits2(bits.size());
+  Bool deleteIt;
+  const Bool* data = arr1.getStorage (deleteIt);
+  Conversion::boolToBit (&(bits2[0]), data, arr1.size());
+  arr1.freeStorage (data, deleteIt);
+  AlwaysAssertExit (bits == bits2);
+  FlagArray f5(shape);
+  f5.fromBits (&(bits[0]));
+  AlwaysAssertExit (f5 == f1);
+  // Errors.
+  try {
+    f1 &= f4;
+    AlwaysAssertExit (False);
+  } catch (const ArrayConformanceError&) {
+  }
+  try {
+    f1.getFlag (IPosition(3,4,0,0));
+    AlwaysAssertExit (False);
+  } catch (const ArrayIndexError&) {
+  }
+}
+
+int main()
+{
+  try {
+    doIt();
+  } catch (const AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,308 @@
+//# BucketAsyncIO.cc: Background read-ahead and write-behind for BucketCache
+//# Copyright (C) 2018
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/casa/IO/BucketAsyncIO.h>
+#include <casacore/casa/IO/BucketFile.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <exception>
+#include <string.h>
+#ifdef USE_THREADS
+#include <pthread.h>
+#endif
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+BucketAsyncIO::BucketAsyncIO (BucketFile* file, Int64 startOffset,
+                              uInt bucketSize, uInt maxRead, uInt maxWrite)
+: itsFile        (file),
+  itsStartOffset (startOffset),
+  itsBucketSize  (bucketSize),
+  itsMaxRead     (maxRead),
+  itsMaxWrite    (maxWrite == 0  ?  1 : maxWrite),
+  itsNrPendRead  (0),
+  itsNrPendWrite (0),
+  itsNRead       (0),
+  itsNWrite      (0),
+  itsStop        (False),
+  itsThread      (0)
+{
+#ifdef USE_THREADS
+  pthread_t* thread = new pthread_t;
+  int error = pthread_create (thread, 0, &BucketAsyncIO::startThread, this);
+  if (error != 0) {
+    delete thread;
+    throw SystemCallError ("pthread_create", error);
+  }
+  itsThread = thread;
+#else
+  throw AipsError ("BucketAsyncIO: casacore is built without thread support");
+#endif
+}
+
+BucketAsyncIO::~BucketAsyncIO()
+{
+  {
+    ScopedMutexLock lock(itsMutex);
+    // Reads not started yet are not needed anymore.
+    for (JobMap::iterator iter=itsJobs.begin(); iter!=itsJobs.end();) {
+      JobMap::iterator cur = iter++;
+      if (!cur->second.isWrite  &&  cur->second.state == Queued) {
+        removeRead (cur);
+      }
+    }
+    itsStop = True;
+    itsWorkCond.broadcast();
+  }
+  // The thread ends when all remaining jobs are done.
+#ifdef USE_THREADS
+  pthread_t* thread = static_cast<pthread_t*>(itsThread);
+  pthread_join (*thread, 0);
+  delete thread;
+#endif
+  for (JobMap::iterator iter=itsJobs.begin(); iter!=itsJobs.end(); ++iter) {
+    delete [] iter->second.data;
+  }
+}
+
+Bool BucketAsyncIO::prefetch (uInt bucketNr)
+{
+  ScopedMutexLock lock(itsMutex);
+  if (itsJobs.find(bucketNr) != itsJobs.end()) {
+    return False;
+  }
+  // Make room by discarding the oldest unused bucket read ahead.
+  while (itsNrPendRead >= itsMaxRead) {
+    if (itsReadOrder.empty()) {
+      return False;
+    }
+    JobMap::iterator iter = itsJobs.find (itsReadOrder.front());
+    if (iter != itsJobs.end()  &&  !iter->second.isWrite) {
+      if (iter->second.state != Done) {
+        return False;
+      }
+      removeRead (iter);
+    }
+    itsReadOrder.pop_front();
+  }
+  Job job = {0, False, Queued};
+  itsJobs[bucketNr] = job;
+  itsQueue.push_back (bucketNr);
+  itsReadOrder.push_back (bucketNr);
+  itsNrPendRead++;
+  itsWorkCond.broadcast();
+  return True;
+}
+
+char* BucketAsyncIO::take (uInt bucketNr)
+{
+  ScopedMutexLock lock(itsMutex);
+  while (True) {
+    JobMap::iterator iter = itsJobs.find (bucketNr);
+    if (iter == itsJobs.end()) {
+      return 0;
+    }
+    if (iter->second.isWrite) {
+      // The data to be written are the most recent ones.
+      char* data = new char[itsBucketSize];
+      memcpy (data, iter->second.data, itsBucketSize);
+      return data;
+    }
+    if (iter->second.state == Done) {
+      char* data = iter->second.data;
+      itsJobs.erase (iter);
+      itsNrPendRead--;
+      // Remove the buckets taken from the front of the read order.
+      while (!itsReadOrder.empty()) {
+        iter = itsJobs.find (itsReadOrder.front());
+        if (iter != itsJobs.end()  &&  !iter->second.isWrite) {
+          break;
+        }
+        itsReadOrder.pop_front();
+      }
+      return data;
+    }
+    itsDoneCond.wait (itsMutex);
+  }
+}
+
+void BucketAsyncIO::write (uInt bucketNr, char* data)
+{
+  ScopedMutexLock lock(itsMutex);
+  while (True) {
+    JobMap::iterator iter = itsJobs.find (bucketNr);
+    if (iter != itsJobs.end()) {
+      Job& job = iter->second;
+      if (job.state == Busy) {
+        // Wait until the bucket has been read or written.
+      } else if (job.isWrite) {
+        // Not written yet, so replace the data.
+        delete [] job.data;
+        job.data = data;
+        return;
+      } else if (itsNrPendWrite < itsMaxWrite) {
+        // Data read ahead are outdated, so turn it into a write.
+        delete [] job.data;
+        job.data    = data;
+        job.isWrite = True;
+        itsNrPendRead--;
+        itsNrPendWrite++;
+        if (job.state == Done) {
+          job.state = Queued;
+          itsQueue.push_back (bucketNr);
+          itsWorkCond.broadcast();
+        }
+        return;
+      }
+    } else if (itsNrPendWrite < itsMaxWrite) {
+      Job job = {data, True, Queued};
+      itsJobs[bucketNr] = job;
+      itsQueue.push_back (bucketNr);
+      itsNrPendWrite++;
+      itsWorkCond.broadcast();
+      return;
+    }
+    itsDoneCond.wait (itsMutex);
+  }
+}
+
+void BucketAsyncIO::flush()
+{
+  ScopedMutexLock lock(itsMutex);
+  while (itsNrPendWrite > 0) {
+    itsDoneCond.wait (itsMutex);
+  }
+  if (! itsError.empty()) {
+    String msg (itsError);
+    itsError = String();
+    throw AipsError ("BucketCache: asynchronous write in file " +
+                     itsFile->name() + " failed: " + msg);
+  }
+}
+
+void BucketAsyncIO::discardReads()
+{
+  ScopedMutexLock lock(itsMutex);
+  while (True) {
+    Bool busy = False;
+    for (JobMap::iterator iter=itsJobs.begin(); iter!=itsJobs.end();) {
+      JobMap::iterator cur = iter++;
+      if (!cur->second.isWrite) {
+        if (cur->second.state == Busy) {
+          busy = True;
+        } else {
+          removeRead (cur);
+        }
+      }
+    }
+    if (!busy) {
+      break;
+    }
+    itsDoneCond.wait (itsMutex);
+  }
+  itsReadOrder.clear();
+}
+
+void BucketAsyncIO::removeRead (JobMap::iterator iter)
+{
+  delete [] iter->second.data;
+  itsJobs.erase (iter);
+  itsNrPendRead--;
+}
+
+void* BucketAsyncIO::startThread (void* arg)
+{
+  static_cast<BucketAsyncIO*>(arg)->run();
+  return 0;
+}
+
+void BucketAsyncIO::run()
+{
+  while (True) {
+    uInt  bucketNr;
+    Bool  isWrite;
+    char* data;
+    {
+      ScopedMutexLock lock(itsMutex);
+      while (!itsStop  &&  itsQueue.empty()) {
+        itsWorkCond.wait (itsMutex);
+      }
+      if (itsQueue.empty()) {
+        break;
+      }
+      bucketNr = itsQueue.front();
+      itsQueue.pop_front();
+      JobMap::iterator iter = itsJobs.find (bucketNr);
+      // Skip a job that has been discarded.
+      if (iter == itsJobs.end()  ||  iter->second.state != Queued) {
+        continue;
+      }
+      Job& job = iter->second;
+      job.state = Busy;
+      if (! job.isWrite) {
+        job.data = new char[itsBucketSize];
+      }
+      isWrite = job.isWrite;
+      data    = job.data;
+    }
+    // Do the IO without holding the lock.
+    // A busy job is not altered by other threads.
+    Int64 offset = itsStartOffset + Int64(bucketNr) * itsBucketSize;
+    String error;
+    try {
+      if (isWrite) {
+        itsFile->pwrite (data, itsBucketSize, offset);
+      } else {
+        itsFile->pread (data, itsBucketSize, offset);
+      }
+    } catch (std::exception& x) {
+      error = x.what();
+    }
+    ScopedMutexLock lock(itsMutex);
+    JobMap::iterator iter = itsJobs.find (bucketNr);
+    if (isWrite) {
+      delete [] data;
+      itsJobs.erase (iter);
+      itsNrPendWrite--;
+      if (error.empty()) {
+        itsNWrite++;
+      } else {
+        itsError = error;
+      }
+    } else if (error.empty()) {
+      iter->second.state = Done;
+      itsNRead++;
+    } else {
+      removeRead (iter);
+    }
+    itsDoneCond.broadcast();
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
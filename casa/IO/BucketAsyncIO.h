@@ -0,0 +1,187 @@
+//# BucketAsyncIO.h: Background read-ahead and write-behind for BucketCache
+//# Copyright (C) 2018
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_BUCKETASYNCIO_H
+#define CASA_BUCKETASYNCIO_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/OS/Mutex.h>
+#include <map>
+#include <deque>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class BucketFile;
+
+// <summary>
+// Background read-ahead and write-behind for BucketCache.
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tBucketCache" demos="">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=BucketCache>BucketCache</linkto>
+// </prerequisite>
+
+// <synopsis>
+// BucketAsyncIO holds a thread doing the file IO for a
+// <linkto class=BucketCache>BucketCache</linkto> in the background.
+// It only handles the buckets in canonical (file) format; the conversion
+// to and from local format is done by the BucketCache in the calling
+// thread, so the BucketCache callback functions need not be thread-safe.
+// <ul>
+//  <li> <src>prefetch</src> schedules the read of a bucket. Its data is
+//       kept until it is taken by <src>take</src>. The number of buckets
+//       read ahead is limited; the oldest unused one is discarded
+//       when the limit is reached.
+//  <li> <src>write</src> schedules the write of a bucket. Until it is
+//       written, <src>take</src> gives a copy of its data, so a bucket
+//       is never read from the file before its pending write is done.
+//       A bucket written again before the previous write started, is
+//       written only once. The number of pending writes is limited;
+//       <src>write</src> waits if the limit is reached.
+// </ul>
+// The IO is done using the positional functions of
+// <linkto class=BucketFile>BucketFile</linkto>, so it does not interfere
+// with the file pointer used by the ordinary (synchronous) IO.
+// <br>An error in a background read is ignored; the BucketCache will
+// read the bucket again and get the error in the usual way. An error in
+// a background write is remembered and thrown by <src>flush</src>.
+// <br>The IO thread is a pthread; the class can only be used if casacore
+// is built with thread support (USE_THREADS).
+// </synopsis>
+
+// <motivation>
+// Synchronous IO on a cache miss makes sequential scans of a storage
+// manager latency-bound, especially on network file systems.
+// </motivation>
+
+class BucketAsyncIO
+{
+public:
+    // Create the object for buckets of the given size in the file part
+    // starting at startOffset. At most maxRead buckets are read ahead
+    // and at most maxWrite writes can be pending.
+    // The IO thread is started.
+    // An exception is thrown if casacore is built without thread support.
+    BucketAsyncIO (BucketFile* file, Int64 startOffset, uInt bucketSize,
+                   uInt maxRead, uInt maxWrite);
+
+    // Finish the pending writes and stop the IO thread.
+    ~BucketAsyncIO();
+
+    // Schedule the read of the given bucket. It returns False if a read
+    // or write is already pending for the bucket or if too many unused
+    // reads are still pending.
+    Bool prefetch (uInt bucketNr);
+
+    // Take the data of the given bucket. If a write is pending, a copy of
+    // its data is returned. If a read is pending, it waits until the read
+    // is done and returns its data.
+    // A null pointer is returned if the bucket is not pending or if the
+    // read failed.
+    // <br>The caller has to delete the buffer (using <src>delete []</src>).
+    char* take (uInt bucketNr);
+
+    // Schedule the write of the given bucket. The object takes over the
+    // buffer, which must have been allocated with <src>new char[]</src>.
+    void write (uInt bucketNr, char* data);
+
+    // Wait until all pending writes are done.
+    // An exception is thrown if a write failed.
+    void flush();
+
+    // Discard all buckets read ahead, for example because the file
+    // has been changed by another process.
+    void discardReads();
+
+    // Get the number of buckets read or written in the background.
+    // <group>
+    uInt nread() const
+      { return itsNRead; }
+    uInt nwrite() const
+      { return itsNWrite; }
+    // </group>
+
+private:
+    // Define the state of a pending bucket.
+    enum State {Queued, Busy, Done};
+    // Define a pending bucket.
+    struct Job {
+        char* data;
+        Bool  isWrite;
+        State state;
+    };
+    typedef std::map<uInt,Job> JobMap;
+
+    // Forbid copy constructor and assignment.
+    BucketAsyncIO (const BucketAsyncIO&);
+    BucketAsyncIO& operator= (const BucketAsyncIO&);
+
+    // The function run by the IO thread.
+    void run();
+
+    // The start function of the IO thread calling <src>run</src>.
+    static void* startThread (void* arg);
+
+    // Remove a read job and delete its data.
+    void removeRead (JobMap::iterator iter);
+
+    //# Data members
+    BucketFile* itsFile;
+    Int64       itsStartOffset;
+    uInt        itsBucketSize;
+    uInt        itsMaxRead;
+    uInt        itsMaxWrite;
+    uInt        itsNrPendRead;     //# nr of reads queued, busy or done
+    uInt        itsNrPendWrite;    //# nr of writes queued or busy
+    uInt        itsNRead;
+    uInt        itsNWrite;
+    Bool        itsStop;
+    String      itsError;          //# message of a failed write
+    JobMap      itsJobs;
+    std::deque<uInt> itsQueue;     //# order in which jobs are executed
+    std::deque<uInt> itsReadOrder; //# order in which reads were scheduled
+    Mutex       itsMutex;
+    Condition   itsWorkCond;       //# signalled when a job is queued
+    Condition   itsDoneCond;       //# signalled when a job is done
+    //# Use void*, because we cannot forward declare pthread_t.
+    void*       itsThread;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
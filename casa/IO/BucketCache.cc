@@ -28,8 +28,12 @@
 
 //# Includes
 #include <casacore/casa/IO/BucketCache.h>
+#include <casacore/casa/IO/BucketAsyncIO.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <casacore/casa/string.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -62,7 +66,10 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
   its_LRUCounter    (0),
   its_Buffer        (0),
   its_NrOfFree      (0),
-  its_FirstFree     (-1)
+  its_FirstFree     (-1),
+  its_AsyncIO       (0),
+  its_ReadAhead     (0),
+  its_WriteBehind   (False)
 {
     initStatistics();
     // The bucketsize must be set.
@@ -89,6 +96,12 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
 	    its_CurNrOfBuckets = its_NewNrOfBuckets;
 	}
     }
+    // Use asynchronous IO if defined in the aipsrc variables.
+    Int readAhead;
+    Bool writeBehind;
+    AipsrcValue<Int>::find  (readAhead, "bucketcache.readahead", 0);
+    AipsrcValue<Bool>::find (writeBehind, "bucketcache.writebehind", False);
+    setAsyncIO (readAhead > 0  ?  readAhead : 0, writeBehind);
 }
 
 BucketCache::~BucketCache()
@@ -97,14 +110,44 @@ BucketCache::~BucketCache()
     // It is not flushed (that should have been done before).
     // In that way no needless flushes are done for a temporary table.
     clear (0, False);
+    // Pending writes are done before the IO thread stops.
+    delete its_AsyncIO;
     delete [] its_Buffer;
 }
 
+void BucketCache::setAsyncIO (uInt readAhead, Bool writeBehind)
+{
+    if (its_AsyncIO) {
+	its_AsyncIO->flush();
+	delete its_AsyncIO;
+	its_AsyncIO = 0;
+    }
+    its_ReadAhead   = 0;
+    its_WriteBehind = False;
+#ifdef USE_THREADS
+    if ((readAhead > 0  ||  writeBehind)  &&  its_file->hasPositionalIO()) {
+	// Keep at most 2 times the read-ahead and 8 writes pending.
+	its_AsyncIO = new BucketAsyncIO (its_file, its_StartOffset,
+					 its_BucketSize, 2*readAhead, 8);
+	its_ReadAhead   = readAhead;
+	its_WriteBehind = writeBehind;
+    }
+#endif
+    for (uInt i=0; i<4; i++) {
+	its_Stream[i]    = -2;
+	its_StreamUse[i] = 0;
+    }
+}
+
 void BucketCache::clear (uInt fromSlot, Bool doFlush)
 {
     if (doFlush) {
         flush (fromSlot);
     }
+    // Buckets read ahead might be outdated when the cache is refilled.
+    if (its_AsyncIO  &&  fromSlot == 0) {
+	its_AsyncIO->discardReads();
+    }
     for (uInt i=fromSlot; i<its_CacheSizeUsed; i++) {
 	its_DeleteCallBack (its_Owner, its_Cache[i]);
 	its_Cache[i] = 0;
@@ -128,10 +171,19 @@ Bool BucketCache::flush (uInt fromSlot)
     Bool hasWritten = False;
     for (uInt i=fromSlot; i<its_CacheSizeUsed; i++) {
 	if (its_Dirty[i]) {
-	    writeBucket (i);
+	    // Use the IO thread if possible to keep the order of the writes.
+	    if (its_WriteBehind) {
+		writeBucketAsync (i);
+	    } else {
+		writeBucket (i);
+	    }
 	    hasWritten = True;
 	}
     }
+    // Wait until all pending writes are done.
+    if (its_AsyncIO) {
+	its_AsyncIO->flush();
+    }
     return hasWritten;
 }
 
@@ -211,6 +263,9 @@ char* BucketCache::getBucket (uInt bucketNr)
 	throw (indexError<Int> (bucketNr));
     }
     naccess_p++;
+    if (its_ReadAhead > 0) {
+	readAhead (bucketNr);
+    }
     // Test if it is already in the cache.
     if (its_SlotNr[bucketNr] >= 0) {
 	its_ActualSlot = its_SlotNr[bucketNr];
@@ -234,6 +289,75 @@ char* BucketCache::getBucket (uInt bucketNr)
     return its_Cache[its_ActualSlot];
 }
 
+uInt BucketCache::readBuckets (const Block<uInt>& bucketNrs, uInt nthreads)
+{
+    uInt nr = bucketNrs.nelements();
+    if (nr > its_CacheSize) {
+	return 0;
+    }
+    // Mark the buckets in the cache as most recently used, so they are
+    // not removed when getting slots for the others.
+    Block<uInt> toRead(nr);
+    uInt nread = 0;
+    for (uInt i=0; i<nr; i++) {
+	uInt bucketNr = bucketNrs[i];
+	if (bucketNr >= its_NewNrOfBuckets) {
+	    throw (indexError<Int> (bucketNr));
+	}
+	if (its_SlotNr[bucketNr] >= 0) {
+	    its_ActualSlot = its_SlotNr[bucketNr];
+	    setLRU();
+	} else if (bucketNr < its_CurNrOfBuckets) {
+	    toRead[nread++] = bucketNr;
+	}
+    }
+    if (nread == 0) {
+	return 0;
+    }
+    // Read and convert the buckets without touching the cache.
+    // Use the data of a pending asynchronous read or write if possible.
+    PtrBlock<char*> data(nread, static_cast<char*>(0));
+    String error;
+    if (nthreads == 0) {
+	nthreads = OMP::maxThreads();
+    }
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (Int i=0; i<Int(nread); i++) {
+	char* buf = 0;
+	try {
+	    if (its_AsyncIO) {
+		buf = its_AsyncIO->take (toRead[i]);
+	    }
+	    if (buf == 0) {
+		buf = new char[its_BucketSize];
+		its_file->pread (buf, its_BucketSize, its_StartOffset +
+				 Int64(toRead[i]) * its_BucketSize);
+	    }
+	    data[i] = its_ReadCallBack (its_Owner, buf);
+	} catch (std::exception& x) {
+#pragma omp critical(BucketCache_readBuckets)
+	    error = x.what();
+	}
+	delete [] buf;
+    }
+    // Put the buckets into the cache; the slots are not used in parallel.
+    for (uInt i=0; i<nread; i++) {
+	if (data[i] != 0) {
+	    if (error.empty()) {
+		getSlot (toRead[i]);
+		its_Cache[its_ActualSlot] = data[i];
+		nread_p++;
+	    } else {
+		its_DeleteCallBack (its_Owner, data[i]);
+	    }
+	}
+    }
+    if (! error.empty()) {
+	throw AipsError ("BucketCache::readBuckets: " + error);
+    }
+    return nread;
+}
+
 void BucketCache::extend (uInt nrBucket)
 {
     its_NewNrOfBuckets += nrBucket;
@@ -261,6 +385,10 @@ uInt BucketCache::addBucket (char* data)
 		   CanonicalConversion::canonicalSize (static_cast<Int*>(0)));
 	CanonicalConversion::toLocal (its_FirstFree, its_Buffer);
 	its_NrOfFree--;
+	// Discard the old contents if read ahead.
+	if (its_AsyncIO) {
+	    delete [] its_AsyncIO->take (bucketNr);
+	}
     }else{
 	// No free buckets, so extend the file.
 	// Initialize all uninitialized buckets before the newly added bucket.
@@ -283,6 +411,10 @@ void BucketCache::removeBucket()
     // Thus store the bucket nr of the first free in this bucket
     // and make this bucket the first free.
     uInt bucketNr = its_BucketNr[its_ActualSlot];
+    // A pending write of the bucket must not overwrite the free list info.
+    if (its_AsyncIO) {
+	its_AsyncIO->flush();
+    }
     CanonicalConversion::fromLocal (its_Buffer, its_FirstFree);
     its_file->seek (its_StartOffset + Int64(bucketNr) * its_BucketSize);
     its_file->write (its_Buffer, its_BucketSize);
@@ -335,7 +467,11 @@ void BucketCache::getSlot (uInt bucketNr)
 	    }
 	}
 	if (its_Dirty[its_ActualSlot]) {
-	    writeBucket (its_ActualSlot);
+	    if (its_WriteBehind) {
+		writeBucketAsync (its_ActualSlot);
+	    } else {
+		writeBucket (its_ActualSlot);
+	    }
 	}
 	if (its_Cache[its_ActualSlot] != 0) {
 	    its_DeleteCallBack (its_Owner, its_Cache[its_ActualSlot]);
@@ -359,15 +495,66 @@ void BucketCache::writeBucket (uInt slotNr)
     its_Dirty[slotNr] = 0;
     nwrite_p++;
 }
+void BucketCache::writeBucketAsync (uInt slotNr)
+{
+    // Convert in this thread, so the callback need not be thread-safe.
+    char* data = new char[its_BucketSize];
+    memset (data, 0, its_BucketSize);
+    its_WriteCallBack (its_Owner, data, its_Cache[slotNr]);
+    its_AsyncIO->write (its_BucketNr[slotNr], data);
+    its_Dirty[slotNr] = 0;
+    nwrite_p++;
+    nasyncwrite_p++;
+}
 void BucketCache::readBucket (uInt slotNr)
 {
 ///    cout << "read " << its_BucketNr[slotNr] << " " << slotNr;
-    its_file->seek (its_StartOffset +
-		    Int64(its_BucketNr[slotNr]) * its_BucketSize);
-    its_file->read (its_Buffer, its_BucketSize);
-    its_Cache[slotNr] = its_ReadCallBack (its_Owner, its_Buffer);
+    // Use the data if read ahead or still to be written.
+    char* data = 0;
+    if (its_AsyncIO) {
+	data = its_AsyncIO->take (its_BucketNr[slotNr]);
+    }
+    if (data) {
+	its_Cache[slotNr] = its_ReadCallBack (its_Owner, data);
+	delete [] data;
+	nasyncread_p++;
+    } else {
+	its_file->seek (its_StartOffset +
+			Int64(its_BucketNr[slotNr]) * its_BucketSize);
+	its_file->read (its_Buffer, its_BucketSize);
+	its_Cache[slotNr] = its_ReadCallBack (its_Owner, its_Buffer);
+    }
     nread_p++;
 }
+void BucketCache::readAhead (uInt bucketNr)
+{
+    // Find the stream continued by this access.
+    // If none, replace the least recently used stream.
+    uInt stream = 0;
+    for (uInt i=0; i<4; i++) {
+	if (its_Stream[i] == bucketNr) {
+	    return;
+	}
+	if (its_Stream[i] + 1 == bucketNr) {
+	    stream = i;
+	    break;
+	}
+	if (its_StreamUse[i] < its_StreamUse[stream]) {
+	    stream = i;
+	}
+    }
+    Bool sequential = (its_Stream[stream] + 1 == bucketNr);
+    its_Stream[stream]    = bucketNr;
+    its_StreamUse[stream] = naccess_p;
+    if (sequential) {
+	for (uInt i=bucketNr+1;
+	     i<its_CurNrOfBuckets  &&  i<=bucketNr+its_ReadAhead; i++) {
+	    if (its_SlotNr[i] < 0  &&  its_AsyncIO->prefetch (i)) {
+		nprefetch_p++;
+	    }
+	}
+    }
+}
 void BucketCache::initializeBuckets (uInt bucketNr)
 {
     // Initialize this bucket and all uninitialized ones before it.
@@ -401,7 +588,16 @@ void BucketCache::showStatistics (ostream& os) const
 	os << "#inits:    " << ninit_p << endl;
     }
     if (nwrite_p > 0) {
-	os << "#writes:   " << nwrite_p << endl;
+	os << "#writes:   " << nwrite_p;
+	if (nasyncwrite_p > 0) {
+	    os << "         (" << nasyncwrite_p << " in background)";
+	}
+	os << endl;
+    }
+    if (its_AsyncIO) {
+	os << "#prefetch: " << nprefetch_p << endl;
+	os << "#asyncrd:  " << nasyncread_p
+	   << "         (reads served by read-ahead or pending write)" << endl;
     }
     os << "#accesses: " << naccess_p;
     if (naccess_p > 0) {
@@ -409,7 +605,7 @@ void BucketCache::showStatistics (ostream& os) const
 	   << 100 * float(naccess_p - nread_p - ninit_p) /
 	                               float(naccess_p) << "%";
     }
-    cout << endl;
+    os << endl;
 }
 
 void BucketCache::initStatistics()
@@ -418,6 +614,9 @@ void BucketCache::initStatistics()
     nread_p   = 0;
     ninit_p   = 0;
     nwrite_p  = 0;
+    nprefetch_p   = 0;
+    nasyncread_p  = 0;
+    nasyncwrite_p = 0;
 }
 
 } //# NAMESPACE CASACORE - END
@@ -40,6 +40,9 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# Forward Declarations
+class BucketAsyncIO;
+
 // <summary>
 // Define the type of the static read and write function.
 // </summary>
@@ -141,6 +144,26 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 // for example, be used to have tiled arrays with different tile shapes
 // in the same file.
 // <p>
+// Optionally the file IO can be done asynchronously by a background thread
+// (see <linkto class=BucketAsyncIO>BucketAsyncIO</linkto>):
+// <ul>
+//  <li> Read-ahead: when the buckets are accessed sequentially, the next
+//       buckets are read in the background, so they are (usually) present
+//       when needed. Up to 4 interleaved sequential streams are detected,
+//       so scanning several columns in parallel is also recognized.
+//  <li> Write-behind: a dirty bucket removed from the cache is written
+//       in the background, so the slot can be reused at once.
+//       Function <src>flush</src> waits until all pending writes are done.
+// </ul>
+// The conversion to and from local format is still done in the calling
+// thread, so the callback functions need not be thread-safe.
+// Asynchronous IO is only possible if the file supports positional IO,
+// thus not for a file in a MultiFile, and if casacore is built with
+// thread support (USE_THREADS). It can be enabled using function
+// <src>setAsyncIO</src>; its default is given by the aipsrc variables
+// <src>bucketcache.readahead</src> (number of buckets to read ahead,
+// default 0) and <src>bucketcache.writebehind</src> (default False).
+// <p>
 // Statistics are kept to know how efficient the cache is working.
 // It is possible to initialize and show the statistics.
 // </synopsis> 
@@ -264,6 +287,18 @@ public:
     // Get the current cache size (in buckets).
     uInt cacheSize() const;
 
+    // Enable asynchronous IO. If accessing buckets sequentially, the next
+    // <src>readAhead</src> buckets are read in the background. If
+    // <src>writeBehind</src> is True, dirty buckets removed from the cache
+    // are written in the background.
+    // <src>setAsyncIO(0, False)</src> disables asynchronous IO.
+    // It is ignored if the file does not support positional IO or if
+    // casacore is built without thread support.
+    void setAsyncIO (uInt readAhead, Bool writeBehind);
+
+    // Tell if asynchronous IO is used.
+    Bool hasAsyncIO() const;
+
     // Set the dirty bit for the current bucket.
     void setDirty();
 
@@ -276,6 +311,18 @@ public:
     // A pointer to the data in converted format is returned.
     char* getBucket (uInt bucketNr);
 
+    // Make sure the given buckets are in the cache.
+    // The buckets not in the cache are read and converted to local format
+    // in parallel using at most <src>nthreads</src> threads
+    // (0 means the OpenMP maximum). Thus the ToLocal callback function
+    // has to be thread-safe.
+    // Buckets not in the file yet are ignored.
+    // Nothing is done if more buckets are given than fit in the cache.
+    // It returns the number of buckets read.
+    // <br>Thereafter <src>getBucket</src> can be used to get each bucket
+    // without reading it.
+    uInt readBuckets (const Block<uInt>& bucketNrs, uInt nthreads=0);
+
     // Extend the file with the given number of buckets.
     // The buckets get initialized when they are acquired
     // (using getBucket) for the first time.
@@ -364,11 +411,24 @@ private:
     uInt its_NrOfFree;
     // The first free bucket (-1 = no free buckets).
     Int  its_FirstFree;
+    // The optional object doing the asynchronous IO.
+    BucketAsyncIO* its_AsyncIO;
+    // The number of buckets to read ahead.
+    uInt its_ReadAhead;
+    // Write dirty buckets in the background?
+    Bool its_WriteBehind;
+    // The last bucket accessed in the sequential streams being detected
+    // and the access number telling when the stream was used last.
+    Int64 its_Stream[4];
+    uInt  its_StreamUse[4];
     // The statistics.
     uInt naccess_p;
     uInt nread_p;
     uInt ninit_p;
     uInt nwrite_p;
+    uInt nprefetch_p;
+    uInt nasyncread_p;
+    uInt nasyncwrite_p;
 
 
     // Copy constructor is not possible.
@@ -386,9 +446,15 @@ private:
     // Write a bucket.
     void writeBucket (uInt slotNr);
 
+    // Write a bucket in the background.
+    void writeBucketAsync (uInt slotNr);
+
     // Read a bucket.
     void readBucket (uInt slotNr);
 
+    // Detect sequential access and read the next buckets in the background.
+    void readAhead (uInt bucketNr);
+
     // Initialize the bucket buffer.
     // The uninitialized buckets before this bucket are also initialized.
     // It returns a pointer to the buffer.
@@ -403,6 +469,9 @@ private:
 inline uInt BucketCache::cacheSize() const
     { return its_CacheSize; }
 
+inline Bool BucketCache::hasAsyncIO() const
+    { return its_AsyncIO != 0; }
+
 inline Int BucketCache::firstFreeBucket() const
     { return its_FirstFree; }
 
@@ -65,7 +65,8 @@ BucketFile::BucketFile (const String& fileName,
   file_p         (),
   mappedFile_p   (0),
   bufferedFile_p (0),
-  mfile_p        (mfile)
+  mfile_p        (mfile),
+  nposio_p       (0)
 {
     // Create the file.
     if (mfile_p) {
@@ -90,7 +91,8 @@ BucketFile::BucketFile (const String& fileName, Bool isWritable,
   file_p         (),
   mappedFile_p   (0),
   bufferedFile_p (0),
-  mfile_p        (mfile)
+  mfile_p        (mfile),
+  nposio_p       (0)
 {
   if (mfile_p) {
     isMapped_p = False;
@@ -114,17 +116,23 @@ CountedPtr<ByteIO> BucketFile::makeFilebufIO (uInt bufferSize)
 
 void BucketFile::close()
 {
+    ScopedMutexLock lock(mutex_p);
+    // Wait until positional IO done by other threads has finished.
+    while (nposio_p > 0) {
+        posioDone_p.wait (mutex_p);
+    }
     if (file_p) {
         deleteMapBuf();
-	file_p = CountedPtr<ByteIO>();
+        file_p = CountedPtr<ByteIO>();
         FiledesIO::close (fd_p);
-	fd_p   = -1;
+        fd_p   = -1;
     }
 }
 
 
 void BucketFile::open()
 {
+    ScopedMutexLock lock(mutex_p);
     if (! file_p) {
       if (mfile_p) {
         file_p = new MFFileIO (*mfile_p, name_p,
@@ -211,6 +219,62 @@ uInt BucketFile::write (const void* buffer, uInt length)
     return length;
 }
 
+uInt BucketFile::pread (void* buffer, uInt length, Int64 offset)
+{
+    // Note that MFFileIO is positional and MultiFileBase is thread-safe,
+    // so a file in a MultiFileBase need not be serialized either.
+    ByteIO* file = startPosIO ("pread");
+    uInt n;
+    try {
+        n = file->pread (length, offset, buffer);
+    } catch (...) {
+        endPosIO();
+        throw;
+    }
+    endPosIO();
+    return n;
+}
+
+uInt BucketFile::pwrite (const void* buffer, uInt length, Int64 offset)
+{
+    ByteIO* file = startPosIO ("pwrite");
+    try {
+        file->pwrite (length, offset, buffer);
+    } catch (...) {
+        endPosIO();
+        throw;
+    }
+    endPosIO();
+    return length;
+}
+
+void BucketFile::checkOpen (const char* func) const
+{
+    if (! file_p) {
+        throw AipsError ("BucketFile::" + String(func) + ": file " +
+                         name_p + " is not open");
+    }
+}
+
+ByteIO* BucketFile::startPosIO (const char* func)
+{
+    // Register the IO, so close waits until it is done.
+    // Thus the IO itself can be done without holding the lock.
+    ScopedMutexLock lock(mutex_p);
+    checkOpen (func);
+    nposio_p++;
+    return file_p.get();
+}
+
+void BucketFile::endPosIO()
+{
+    ScopedMutexLock lock(mutex_p);
+    nposio_p--;
+    if (nposio_p == 0) {
+        posioDone_p.broadcast();
+    }
+}
+
 void BucketFile::seek (Int64 offset)
 {
     AlwaysAssert (bufferedFile_p == 0, AipsError);
@@ -35,6 +35,7 @@
 #include <casacore/casa/IO/FilebufIO.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Utilities/CountedPtr.h>
+#include <casacore/casa/OS/Mutex.h>
 #include <unistd.h>
 
 
@@ -170,6 +171,21 @@ public:
     // Write bytes into the file.
     virtual uInt write (const void* buffer, uInt length);
 
+    // Read or write bytes at the given offset without using (or changing)
+    // the file pointer. It can be used by another thread than the one
+    // doing the ordinary reads and writes if <src>hasPositionalIO()</src>
+    // is True. Multiple threads can do so concurrently. Closing the file
+    // waits until they are done.
+    // <group>
+    virtual uInt pread (void* buffer, uInt length, Int64 offset);
+    virtual uInt pwrite (const void* buffer, uInt length, Int64 offset);
+    // </group>
+
+    // Tell if pread and pwrite can be done asynchronously by a background
+    // IO thread. This is not done for a file in a MultiFileBase, because
+    // its blocks are buffered by the MultiFileBase itself.
+    Bool hasPositionalIO() const;
+
     // Seek in the file.
     // <group>
     virtual void seek (Int64 offset);
@@ -203,8 +219,23 @@ private:
     FilebufIO* bufferedFile_p;
     // The possibly used MultiFileBase.
     MultiFileBase* mfile_p;
+    // Mutex to synchronize positional IO with opening/closing the file.
+    Mutex mutex_p;
+    // The number of positional IOs in progress.
+    uInt  nposio_p;
+    // Signalled when the last positional IO in progress has finished.
+    Condition posioDone_p;
 	    
 
+    // Check if the file is open.
+    void checkOpen (const char* func) const;
+
+    // Register the start and end of a positional IO.
+    // <group>
+    ByteIO* startPosIO (const char* func);
+    void endPosIO();
+    // </group>
+
     // Forbid copy constructor.
     BucketFile (const BucketFile&);
 
@@ -228,6 +259,8 @@ inline Bool BucketFile::isWritable() const
 inline void BucketFile::seek (Int offset)
     { seek (Int64(offset)); }
 
+inline Bool BucketFile::hasPositionalIO() const
+    { return mfile_p == 0; }
 inline Bool BucketFile::isCached() const
     { return !isMapped_p && bufSize_p==0; }
 inline Bool BucketFile::isMapped() const
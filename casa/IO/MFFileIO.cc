@@ -85,6 +85,27 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  Int64 MFFileIO::pread (Int64 size, Int64 offset, void* buffer,
+                         Bool throwException)
+  {
+    Int64 n = itsFile.read (itsId, buffer, size, offset);
+    if (throwException  &&  n < size) {
+      throw AipsError ("MFFileIO::pread - incorrect number of bytes ("
+                       + String::toString(n) + " out of "
+                       + String::toString(size) + ") read for file "
+                       + itsName + " in MultiFileBase " + itsFile.fileName());
+    }
+    return n;
+  }
+
+  void MFFileIO::pwrite (Int64 size, Int64 offset, const void* buffer)
+  {
+    Int64 n = itsFile.write (itsId, buffer, size, offset);
+    if (n != size) {
+      throw AipsError ("MFFileIO: pwrite error in " + itsName);
+    }
+  }
+
   void MFFileIO::reopenRW()
   {
     itsFile.reopenRW();
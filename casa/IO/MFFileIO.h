@@ -95,6 +95,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Write a block at the given offset.
     virtual void write (Int64 size, const void* buffer);
 
+    // Read or write a block at the given offset without using or changing
+    // the file position. They can be used concurrently by multiple threads.
+    // <group>
+    virtual Int64 pread (Int64 size, Int64 offset, void* buffer,
+                         Bool throwException=True);
+    virtual void pwrite (Int64 size, Int64 offset, const void* buffer);
+    // </group>
+
     // Reopen the file (and possibly underlying MultiFileBase) for read/write access.
     // Nothing will be done if the stream is writable already.
     // An exception will be thrown if it is not possible to reopen it for
@@ -163,13 +163,6 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     AlwaysAssert (version==1, AipsError);
     aio >> itsNrBlock >> itsInfo >> itsFreeBlocks;
     aio.getend();
-    // Initialize remaining info fields.
-    for (vector<MultiFileInfo>::iterator iter=itsInfo.begin();
-         iter!=itsInfo.end(); ++iter) {
-      iter->curBlock = -1;
-      iter->dirty    = False;
-      iter->buffer.resize (itsBlockSize);
-    }
   }
 
   void MultiFile::doAddFile (MultiFileInfo&)
@@ -206,14 +199,28 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   void MultiFile::readBlock (MultiFileInfo& info, Int64 blknr,
                              void* buffer)
   {
-    itsIO.pread (itsBlockSize, info.blockNrs[blknr] *
-                 itsBlockSize, buffer);
+    readBlockAt (info.blockNrs[blknr], buffer);
   }
 
   void MultiFile::writeBlock (MultiFileInfo& info, Int64 blknr,
                               const void* buffer)
   {
-    itsIO.pwrite (itsBlockSize, info.blockNrs[blknr] * itsBlockSize, buffer);
+    writeBlockAt (info.blockNrs[blknr], buffer);
+  }
+
+  Bool MultiFile::concurrentIO() const
+  {
+    return True;
+  }
+
+  void MultiFile::readBlockAt (Int64 physnr, void* buffer)
+  {
+    itsIO.pread (itsBlockSize, physnr * itsBlockSize, buffer);
+  }
+
+  void MultiFile::writeBlockAt (Int64 physnr, const void* buffer)
+  {
+    itsIO.pwrite (itsBlockSize, physnr * itsBlockSize, buffer);
   }
 
 
@@ -147,6 +147,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Read a data block.
     virtual void readBlock (MultiFileInfo& info, Int64 blknr,
                             void* buffer);
+    // Blocks are read and written using pread and pwrite, which do not
+    // use the file pointer, so they can be done concurrently.
+    virtual Bool concurrentIO() const;
+    // Read or write a data block given its physical block number.
+    // <group>
+    virtual void readBlockAt (Int64 physnr, void* buffer);
+    virtual void writeBlockAt (Int64 physnr, const void* buffer);
+    // </group>
 
   private:
     //# Data members
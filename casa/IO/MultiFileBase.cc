@@ -32,14 +32,16 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/OS/File.h>     // for fileFSTAT
+#include <casacore/casa/OS/OMP.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <sys/stat.h>                  // needed for stat or stat64
+#include <exception>
 #include <string.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
   void operator<< (ostream& ios, const MultiFileInfo& info)
-    { ios << info.name << ' ' << info.blockNrs << ' ' << info.fsize << ' '
-          << info.curBlock << ' ' << info.dirty << endl; }
+    { ios << info.name << ' ' << info.blockNrs << ' ' << info.fsize << endl; }
   void operator<< (AipsIO& ios, const MultiFileInfo& info)
     { ios << info.name << info.blockNrs << info.fsize; }
   void operator>> (AipsIO& ios, MultiFileInfo& info)
@@ -50,9 +52,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     : itsBlockSize  (blockSize),
       itsNrBlock    (0),
       itsHdrCounter (0),
-      itsChanged    (False)
+      itsChanged    (False),
+      itsUseCounter (0),
+      itsNrDirectWrite (0)
   {
     itsName = Path(name).expandedName();
+    Int nbuf;
+    AipsrcValue<Int>::find (nbuf, "multifile.nbufferperfile", 2);
+    setBuffersPerFile (std::max (nbuf, 1));
   }
 
   void MultiFileBase::setNewFile()
@@ -74,6 +81,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsInfo.clear();
   }
 
+  void MultiFileBase::setBuffersPerFile (uInt nbuf)
+  {
+    itsBufPerFile = std::max (nbuf, 1u);
+  }
+
   uInt MultiFileBase::nfile() const
   {
     Int nf = 0;
@@ -88,13 +100,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
   void MultiFileBase::flush()
   {
+    ScopedMutexLock lock(itsMutex);
     // Flush all buffers if needed.
-    for (vector<MultiFileInfo>::iterator iter=itsInfo.begin();
-         iter!=itsInfo.end(); ++iter) {
-      if (iter->dirty) {
-        writeDirty (*iter);
-      }
-    }
+    flushBuffers();
     // Header only needs to be written if blocks were added since last flush.
     if (itsChanged) {
       writeHeader();
@@ -103,41 +111,76 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     flushFile();
   }
 
+  void MultiFileBase::flushBuffers()
+  {
+    vector<MultiFileBuffer*> dirty;
+    for (vector<MultiFileBuffer>::iterator iter=itsBuffers.begin();
+         iter!=itsBuffers.end(); ++iter) {
+      if (iter->dirty) {
+        dirty.push_back (&(*iter));
+      }
+    }
+    if (dirty.size() > 1  &&  concurrentIO()) {
+      // Write the blocks in parallel.
+      vector<Int64> physnrs(dirty.size());
+      for (size_t i=0; i<dirty.size(); ++i) {
+        physnrs[i] = itsInfo[dirty[i]->fileId].blockNrs[dirty[i]->blknr];
+      }
+      uInt nthreads = std::min (size_t(OMP::maxThreads()), dirty.size());
+      String error;
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+      for (Int i=0; i<Int(dirty.size()); ++i) {
+        try {
+          writeBlockAt (physnrs[i], &(dirty[i]->data[0]));
+        } catch (std::exception& x) {
+#pragma omp critical(MultiFileBase_flushBuffers)
+          error = x.what();
+        }
+      }
+      if (! error.empty()) {
+        throw AipsError ("MultiFileBase::flush - write error in " +
+                         itsName + ": " + error);
+      }
+      for (size_t i=0; i<dirty.size(); ++i) {
+        dirty[i]->dirty = False;
+      }
+    } else {
+      for (size_t i=0; i<dirty.size(); ++i) {
+        writeDirty (*dirty[i]);
+      }
+    }
+  }
+
+  MultiFileInfo& MultiFileBase::getInfo (Int fileId, const char* func)
+  {
+    if (fileId < 0  ||  fileId >= Int(itsInfo.size())  ||
+        itsInfo[fileId].name.empty()) {
+      throw AipsError ("MultiFileBase::" + String(func) +
+                       " - invalid fileId given");
+    }
+    return itsInfo[fileId];
+  }
+
   Int64 MultiFileBase::read (Int fileId, void* buf,
                              Int64 size, Int64 offset)
   {
-    if (fileId >= Int(itsInfo.size())  ||  itsInfo[fileId].name.empty()) {
-      throw AipsError ("MultiFileBase::read - invalid fileId given");
-    }
     char* buffer = static_cast<char*>(buf);
-    MultiFileInfo& info = itsInfo[fileId];
+    Int64 nrblk, szdo;
+    {
+      ScopedMutexLock lock(itsMutex);
+      const MultiFileInfo& info = getInfo (fileId, "read");
+      nrblk = (info.fsize + itsBlockSize - 1) / itsBlockSize;
+      szdo  = std::min(size, info.fsize - offset);  // not past EOF
+    }
     // Determine the logical block to read and the start offset in that block.
-    Int64 nrblk = (info.fsize + itsBlockSize - 1) / itsBlockSize;
     Int64 blknr = offset/itsBlockSize;
     Int64 start = offset - blknr*itsBlockSize;
     Int64 done  = 0;
-    Int64 szdo  = std::min(size, info.fsize - offset);  // not past EOF
     // Read until done.
     while (done < szdo) {
       AlwaysAssert (blknr < nrblk, AipsError);
       Int64 todo = std::min(szdo-done, itsBlockSize-start);
-      // If already in buffer, copy from there.
-      if (blknr == info.curBlock) {
-        memcpy (buffer, &(info.buffer[start]), todo);
-      } else {
-        // Read directly into buffer if it fits exactly.
-        if (todo == itsBlockSize) {
-          readBlock (info, blknr, buffer);
-        } else {
-          if (info.dirty) {
-            writeDirty (info);
-          }
-          // Read into file buffer and copy correct part.
-          readBlock (info, blknr, &(info.buffer[0]));
-          info.curBlock = blknr;
-          memcpy (buffer, &(info.buffer[start]), todo);
-        }
-      }
+      readPart (fileId, blknr, start, todo, buffer);
       // Increment counters.
       done += todo;
       buffer += todo;
@@ -147,74 +190,196 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return done;
   }
 
+  void MultiFileBase::readPart (Int fileId, Int64 blknr, Int64 start,
+                                Int64 todo, char* buffer)
+  {
+    Int64 physnr;
+    uInt64 nrDirectWrite;
+    {
+      ScopedMutexLock lock(itsMutex);
+      // If already in a buffer, copy from there.
+      Int inx = findBuffer (fileId, blknr);
+      if (inx >= 0) {
+        memcpy (buffer, &(itsBuffers[inx].data[start]), todo);
+        return;
+      }
+      MultiFileInfo& info = itsInfo[fileId];
+      if (! concurrentIO()) {
+        if (todo == itsBlockSize) {
+          // Read directly into buffer if it fits exactly.
+          readBlock (info, blknr, buffer);
+        } else {
+          // Read into a pool buffer and copy correct part.
+          inx = newBuffer();
+          MultiFileBuffer& mbuf = itsBuffers[inx];
+          readBlock (info, blknr, &(mbuf.data[0]));
+          mbuf.fileId = fileId;
+          mbuf.blknr  = blknr;
+          memcpy (buffer, &(mbuf.data[start]), todo);
+        }
+        return;
+      }
+      physnr = info.blockNrs[blknr];
+      nrDirectWrite = itsNrDirectWrite;
+    }
+    // Do the IO without holding the lock, so different blocks can be
+    // read concurrently.
+    if (todo == itsBlockSize) {
+      readBlockAt (physnr, buffer);
+    } else {
+      vector<char> data(itsBlockSize);
+      readBlockAt (physnr, &(data[0]));
+      ScopedMutexLock lock(itsMutex);
+      // Another thread might have read or written the block meanwhile.
+      Int inx = findBuffer (fileId, blknr);
+      if (inx >= 0) {
+        memcpy (buffer, &(itsBuffers[inx].data[start]), todo);
+      } else {
+        memcpy (buffer, &(data[start]), todo);
+        // Only keep the data if no block has been written directly since,
+        // because the data might be outdated.
+        if (nrDirectWrite == itsNrDirectWrite) {
+          inx = newBuffer();
+          MultiFileBuffer& mbuf = itsBuffers[inx];
+          mbuf.data.swap (data);
+          mbuf.fileId = fileId;
+          mbuf.blknr  = blknr;
+        }
+      }
+    }
+  }
+
   Int64 MultiFileBase::write (Int fileId, const void* buf,
                               Int64 size, Int64 offset)
   {
-    if (fileId >= Int(itsInfo.size())  ||  itsInfo[fileId].name.empty()) {
-      throw AipsError ("MultiFileBase::write - invalid fileId given");
-    }
     const char* buffer = static_cast<const char*>(buf);
-    AlwaysAssert (itsWritable, AipsError);
-    MultiFileInfo& info = itsInfo[fileId];
     // Determine the logical block to write and the start offset in that block.
     Int64 blknr = offset/itsBlockSize;
     Int64 start = offset - blknr*itsBlockSize;
     Int64 done  = 0;
-    // If beyond EOF, add blocks as needed.
-    Int64 lastblk = blknr + (start+size+itsBlockSize-1) / itsBlockSize;
-    Int64 curnrb = (info.fsize+itsBlockSize-1) / itsBlockSize;
-    if (lastblk >= curnrb) {
-      extend (info, lastblk);
-      itsChanged = True;
+    Int64 curnrb;
+    {
+      ScopedMutexLock lock(itsMutex);
+      MultiFileInfo& info = getInfo (fileId, "write");
+      AlwaysAssert (itsWritable, AipsError);
+      // If beyond EOF, add blocks as needed.
+      Int64 lastblk = blknr + (start+size+itsBlockSize-1) / itsBlockSize;
+      curnrb = (info.fsize+itsBlockSize-1) / itsBlockSize;
+      if (lastblk >= curnrb) {
+        extend (info, lastblk);
+        itsChanged = True;
+      }
     }
     // Write until all done.
     while (done < size) {
       Int64 todo = std::min(size-done, itsBlockSize-start);
-      // Favor sequential writing, thus write current buffer first.
-      if (blknr == info.curBlock) {
-        memcpy (&(info.buffer[start]), buffer, todo);
-        info.dirty = True;
-        if (done+todo > size) {
-          writeDirty (info);
-        }
-      } else if (todo == itsBlockSize) {
-        // Write directly from buffer if it fits exactly.
-        writeBlock (info, blknr, buffer);
-      } else {
-        // Write into temporary buffer and copy correct part.
-        // First write possibly dirty buffer.
-        if (info.dirty) {
-          writeDirty (info);
-        }
-        if (blknr >= curnrb) {
-          memset (&(info.buffer[0]), 0, itsBlockSize);
-        } else {
-          readBlock (info, blknr, &(info.buffer[0]));
-        }
-        info.curBlock = blknr;
-        memcpy (&(info.buffer[start]), buffer, todo);
-        info.dirty = True;
-      }
+      writePart (fileId, blknr, start, todo, buffer, curnrb);
       done += todo;
       buffer += todo;
       blknr++;
       start = 0;
     }
+    ScopedMutexLock lock(itsMutex);
+    MultiFileInfo& info = itsInfo[fileId];
     if (offset+size > info.fsize) {
       info.fsize = offset+size;
     }
     return done;
   }
 
+  void MultiFileBase::writePart (Int fileId, Int64 blknr, Int64 start,
+                                 Int64 todo, const char* buffer,
+                                 Int64 curnrb)
+  {
+    Int64 physnr;
+    {
+      ScopedMutexLock lock(itsMutex);
+      // Favor sequential writing, thus write into a buffer if it holds
+      // the block.
+      Int inx = findBuffer (fileId, blknr);
+      if (inx >= 0) {
+        memcpy (&(itsBuffers[inx].data[start]), buffer, todo);
+        itsBuffers[inx].dirty = True;
+        return;
+      }
+      MultiFileInfo& info = itsInfo[fileId];
+      if (todo < itsBlockSize) {
+        // Read the block into a pool buffer and copy correct part.
+        inx = newBuffer();
+        MultiFileBuffer& mbuf = itsBuffers[inx];
+        if (blknr >= curnrb) {
+          memset (&(mbuf.data[0]), 0, itsBlockSize);
+        } else {
+          readBlock (info, blknr, &(mbuf.data[0]));
+        }
+        mbuf.fileId = fileId;
+        mbuf.blknr  = blknr;
+        memcpy (&(mbuf.data[start]), buffer, todo);
+        mbuf.dirty = True;
+        return;
+      }
+      // Write directly from buffer if it fits exactly.
+      if (! concurrentIO()) {
+        writeBlock (info, blknr, buffer);
+        return;
+      }
+      physnr = info.blockNrs[blknr];
+      itsNrDirectWrite++;
+    }
+    // Do the IO without holding the lock.
+    writeBlockAt (physnr, buffer);
+  }
+
+  Int MultiFileBase::findBuffer (Int fileId, Int64 blknr)
+  {
+    for (size_t i=0; i<itsBuffers.size(); ++i) {
+      MultiFileBuffer& mbuf = itsBuffers[i];
+      if (mbuf.blknr == blknr  &&  mbuf.fileId == fileId) {
+        mbuf.lastUse = ++itsUseCounter;
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  Int MultiFileBase::newBuffer()
+  {
+    Int inx;
+    size_t maxnbuf = size_t(itsBufPerFile) * std::max (nfile(), 1u);
+    if (itsBuffers.size() < maxnbuf) {
+      inx = itsBuffers.size();
+      itsBuffers.push_back (MultiFileBuffer());
+    } else {
+      // Reuse the least recently used buffer.
+      inx = 0;
+      for (size_t i=1; i<itsBuffers.size(); ++i) {
+        if (itsBuffers[i].lastUse < itsBuffers[inx].lastUse) {
+          inx = i;
+        }
+      }
+      if (itsBuffers[inx].dirty) {
+        writeDirty (itsBuffers[inx]);
+      }
+    }
+    MultiFileBuffer& mbuf = itsBuffers[inx];
+    mbuf.data.resize (itsBlockSize);
+    mbuf.fileId  = -1;
+    mbuf.blknr   = -1;
+    mbuf.dirty   = False;
+    mbuf.lastUse = ++itsUseCounter;
+    return inx;
+  }
+
   void MultiFileBase::resync()
   {
+    ScopedMutexLock lock(itsMutex);
     AlwaysAssert (!itsChanged, AipsError);
-    // Clear all blocknrs.
-    for (vector<MultiFileInfo>::iterator iter=itsInfo.begin();
-         iter!=itsInfo.end(); ++iter) {
+    // Clear all buffers.
+    for (vector<MultiFileBuffer>::iterator iter=itsBuffers.begin();
+         iter!=itsBuffers.end(); ++iter) {
       AlwaysAssert (!iter->dirty, AipsError);
-      iter->curBlock = -1;
     }
+    itsBuffers.clear();
     readHeader();
   }
 
@@ -223,6 +388,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     if (fname.empty()) {
       throw AipsError("MultiFileBase::addFile - empty file name given");
     }
+    ScopedMutexLock lock(itsMutex);
     // Only use the basename part (to avoid directory rename problems).
     String bname = Path(fname).baseName();
     // Check that file name is not used yet.
@@ -242,7 +408,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     if (inx == itsInfo.size()) {
       itsInfo.resize (inx+1);
     }
-    itsInfo[inx] = MultiFileInfo(itsBlockSize);
+    itsInfo[inx] = MultiFileInfo();
     itsInfo[inx].name = bname;
     doAddFile (itsInfo[inx]);
     itsChanged = True;
@@ -267,25 +433,51 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
   void MultiFileBase::deleteFile (Int fileId)
   {
-    if (fileId >= Int(itsInfo.size())  ||  itsInfo[fileId].name.empty()) {
-      throw AipsError ("MultiFileBase::deleteFile - invalid fileId given");
+    ScopedMutexLock lock(itsMutex);
+    MultiFileInfo& info = getInfo (fileId, "deleteFile");
+    // Discard the buffers of the file.
+    for (vector<MultiFileBuffer>::iterator iter=itsBuffers.begin();
+         iter!=itsBuffers.end(); ++iter) {
+      if (iter->fileId == fileId) {
+        iter->fileId  = -1;
+        iter->blknr   = -1;
+        iter->dirty   = False;
+        iter->lastUse = 0;
+      }
     }
-    MultiFileInfo& info = itsInfo[fileId];
     doDeleteFile (info);
     // Clear this slot.
     info = MultiFileInfo();
     itsChanged = True;
   }
 
+  Bool MultiFileBase::concurrentIO() const
+  {
+    return False;
+  }
 
+  void MultiFileBase::readBlockAt (Int64, void*)
+  {
+    throw AipsError ("MultiFileBase::readBlockAt not implemented");
+  }
 
-  MultiFileInfo::MultiFileInfo (Int64 bufSize)
-    : curBlock (-1),
-      fsize    (0),
-      dirty    (False)
+  void MultiFileBase::writeBlockAt (Int64, const void*)
   {
-    buffer.resize (bufSize);
+    throw AipsError ("MultiFileBase::writeBlockAt not implemented");
   }
 
 
+
+  MultiFileInfo::MultiFileInfo()
+    : fsize (0)
+  {}
+
+  MultiFileBuffer::MultiFileBuffer()
+    : fileId  (-1),
+      blknr   (-1),
+      lastUse (0),
+      dirty   (False)
+  {}
+
+
 } //# NAMESPACE CASACORE - END
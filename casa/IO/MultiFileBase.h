@@ -33,6 +33,7 @@
 #include <casacore/casa/IO/ByteIO.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Utilities/CountedPtr.h>
+#include <casacore/casa/OS/Mutex.h>
 #include <casacore/casa/vector.h>
 #include <casacore/casa/ostream.h>
 
@@ -50,13 +51,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // </summary>
   // <use visibility=local>
   struct MultiFileInfo {
-    explicit MultiFileInfo (Int64 bufSize=0);
+    MultiFileInfo();
     vector<Int64> blockNrs;     // physical blocknrs for this logical file
-    vector<char>  buffer;       // buffer holding a data block
-    Int64         curBlock;     // the data block held in buffer (<0 is none)
     Int64         fsize;        // file size (in bytes)
     String        name;         // the virtual file name
-    Bool          dirty;        // has data in buffer been changed?
     CountedPtr<HDF5Group> group;
     CountedPtr<HDF5DataSet> dataSet;
   };
@@ -65,6 +63,20 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   void operator>> (AipsIO&, MultiFileInfo&);
 
 
+  // <summary>
+  // Helper class for MultiFileBase holding a data block in the buffer pool
+  // </summary>
+  // <use visibility=local>
+  struct MultiFileBuffer {
+    MultiFileBuffer();
+    vector<char> data;          // the data block
+    Int          fileId;        // the virtual file (<0 is none)
+    Int64        blknr;         // the logical block in the file
+    uInt64       lastUse;       // last time the buffer was used (for LRU)
+    Bool         dirty;         // has data in buffer been changed?
+  };
+
+
   // <summary> 
   // Abstract base class to combine multiple files in a single one.
   // </summary>
@@ -101,6 +113,21 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   //
   // It is possible to delete a virtual file. Its blocks will be added to
   // the free block list (which is also stored in the meta info).
+  //
+  // Data blocks partially read or written are kept in a pool of buffers
+  // shared by all virtual files. Its size is a number of buffers per
+  // virtual file, which can be set using <src>setBuffersPerFile</src> and
+  // defaults to the aipsrc variable <src>multifile.nbufferperfile</src>
+  // (default 2). If the pool is full, the least recently used buffer is
+  // reused (after writing it if changed). Whole data blocks are read and
+  // written directly without using the pool.
+  //
+  // The read, write and flush functions can be used by multiple threads.
+  // For a MultiFile the block IO is done without holding the internal lock,
+  // so different blocks can be read or written concurrently. The dirty
+  // buffers are written in parallel on flush.
+  // MultiHDF5 does the IO while holding the lock, because HDF5 itself is
+  // not thread-safe.
   // </synopsis>
 
   // <example>
@@ -177,6 +204,18 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Fsync the file (i.e., force the data to be physically written).
     virtual void fsync() = 0;
 
+    // Set the number of buffers per virtual file in the buffer pool.
+    // It is at least 1.
+    void setBuffersPerFile (uInt nbuf);
+
+    // Get the number of buffers per virtual file in the buffer pool.
+    uInt buffersPerFile() const
+      { return itsBufPerFile; }
+
+    // Get the number of buffers currently in the buffer pool.
+    uInt nbuffer() const
+      { return itsBuffers.size(); }
+
     // Get the file name of the MultiFileBase.
     String fileName() const
       { return itsName; }
@@ -205,12 +244,47 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       { return itsFreeBlocks; }
 
   private:
-    void writeDirty (MultiFileInfo& info)
+    // Get the info of a file after checking the file id.
+    MultiFileInfo& getInfo (Int fileId, const char* func);
+
+    // Read or write the part of a data block. The lock is acquired.
+    // <group>
+    void readPart (Int fileId, Int64 blknr, Int64 start, Int64 todo,
+                   char* buffer);
+    void writePart (Int fileId, Int64 blknr, Int64 start, Int64 todo,
+                    const char* buffer, Int64 curnrb);
+    // </group>
+
+    // Find the buffer holding the given block. -1 is returned if not found.
+    Int findBuffer (Int fileId, Int64 blknr);
+
+    // Get a free buffer from the pool. If needed, the least recently
+    // used one is reused (after writing it if dirty).
+    // Its file id is not set; that should be done once its data are valid.
+    Int newBuffer();
+
+    // Write the buffer and clear its dirty flag.
+    void writeDirty (MultiFileBuffer& buf)
     {
-      writeBlock (info, info.curBlock, &(info.buffer[0]));
-      info.dirty = False;
+      writeBlock (itsInfo[buf.fileId], buf.blknr, &(buf.data[0]));
+      buf.dirty = False;
     }
 
+    // Write all dirty buffers.
+    void flushBuffers();
+
+    // Can blocks be read and written without holding the lock?
+    // If so, the functions readBlockAt and writeBlockAt are used for it.
+    // The default implementation returns False.
+    virtual Bool concurrentIO() const;
+    // Read or write a data block given its physical block number.
+    // They are only used if <src>concurrentIO</src> returns True, so they
+    // have to be thread-safe. The default implementations throw an exception.
+    // <group>
+    virtual void readBlockAt (Int64 physnr, void* buffer);
+    virtual void writeBlockAt (Int64 physnr, const void* buffer);
+    // </group>
+
     // Do the class-specific actions on adding a file.
     virtual void doAddFile (MultiFileInfo&) = 0;
     // Do the class-specific actions on deleting a file.
@@ -246,6 +320,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool                  itsWritable; // Is the file writable?
     Bool                  itsChanged; // Has header info changed since last flush?
     vector<Int64>         itsFreeBlocks;
+  private:
+    vector<MultiFileBuffer> itsBuffers;  // buffer pool
+    uInt                  itsBufPerFile; // nr of pool buffers per file
+    uInt64                itsUseCounter; // counter for LRU of buffers
+    uInt64                itsNrDirectWrite; // nr of blocks written unlocked
+    Mutex                 itsMutex;     // lock for the info and buffers
   };
 
 
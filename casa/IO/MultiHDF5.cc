@@ -109,7 +109,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Set info fields.
     itsInfo.reserve (names.size());
     for (uInt i=0; i<names.size(); ++i) {
-      MultiFileInfo info(itsBlockSize);
+      MultiFileInfo info;
       info.name  = names[i];
       info.fsize = sizes[i];
       if (! info.name.empty()) {
@@ -35,32 +35,33 @@
 #include <errno.h>                    // needed for errno
 #include <casacore/casa/string.h>               // needed for strerror
 
-/*Headers for parallel read*/
-#include<iostream>
-#include <fstream>
-#include <omp.h>
-#include <string>
-#include<cstdlib>
-#include <boost/algorithm/string.hpp>
-
-/* Required for mmap*/
-#include <sys/mman.h>
-#include <fcntl.h>
-
+//# Large read-only files can be staged in shared memory by StageCache.
+#if (defined(PARIO) || defined(PARIO_DEBUG)) && defined(HAVE_BOOST) && defined(USE_THREADS)
+#define CASA_STAGEFILES
+#include <casacore/casa/IO/StageCache.h>
+#include <unistd.h>
+#endif
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
-
-
 RegularFileIO::RegularFileIO (const RegularFile& regularFile,
                               ByteIO::OpenOption option,
                               uInt bufferSize)
 : itsOption      (option),
-  itsRegularFile (regularFile)
+  itsRegularFile (regularFile),
+  itsStaged      (0)
 {
-    int file = openCreate (regularFile, option);
+    // Do not use openCreate, because the staged copy is used while it is
+    // being staged instead of waiting until it is complete.
+    int file = openFile (regularFile, option);
     attach (file, (bufferSize == 0 ? 16384 : bufferSize));
+#ifdef CASA_STAGEFILES
+    // Use a staged copy in shared memory for large read-only files.
+    if (option == ByteIO::Old) {
+        itsStaged = StageCache::open (regularFile.path().expandedName());
+    }
+#endif
     // If appending, set the stream offset to the file length.
     if (option == ByteIO::Append) {
         seek (length());
@@ -70,139 +71,33 @@ RegularFileIO::RegularFileIO (const RegularFile& regularFile,
 RegularFileIO::~RegularFileIO()
 {
     detach (True);
+#ifdef CASA_STAGEFILES
+    delete itsStaged;
+#endif
     if (itsOption == ByteIO::Scratch  ||  itsOption == ByteIO::Delete) {
 	itsRegularFile.remove();
     }
 }
 
-std::string RegularFileIO::replace(std::string inp)
-{
-boost::replace_all(inp,"/","_");
-return inp;
-}
-
-long RegularFileIO::get_file_size(std::string filename)
-{
-        std::ifstream In;
-        In.open(filename.c_str());
-        In.seekg(0,In.end);
-        return In.tellg();
-
-}
-
-void RegularFileIO::threadedRead(std::string filename,char *buff,int threads,int fd)
+int RegularFileIO::openCreate (const RegularFile& file,
+                               ByteIO::OpenOption option)
 {
-        long file_size,priv_size,priv_fseek_start;//Size : total file size, priv* variables are thread specific
-        int threadId,tot_thread; //tot_thread : total threads participating
-        std::ifstream *inFile,In;
-        std::string newFilePath=replace(filename);
-
-        omp_set_num_threads(threads); //How many threads?
-        inFile=new std::ifstream[threads];
-
-        //Is there a better way to compute the file size?
-        In.open(filename.c_str());
-        In.seekg(0,In.end);
-        file_size=In.tellg();
-        fd=shm_open(newFilePath.c_str(),O_CREAT |O_RDWR,0777);
-
-        buff=(char*)mmap(NULL, file_size, PROT_WRITE, MAP_SHARED, fd, 0);
-        ftruncate(fd,file_size);
-
-        #pragma omp parallel private(priv_size,threadId,priv_fseek_start,tot_thread)
-        {
-                tot_thread=omp_get_num_threads();
-                threadId=omp_get_thread_num();
-                priv_size=file_size/tot_thread+1; //indices are aligned for parallel read
-                priv_fseek_start=(threadId*file_size/tot_thread)+1;
-                if(!threadId){priv_fseek_start-=-1;}
-                inFile[threadId].open(filename.c_str());
-                inFile[threadId].seekg(priv_fseek_start,inFile[threadId].beg);
-                inFile[threadId].read(&buff[priv_fseek_start],priv_size);
-                inFile[threadId].close();
+    int fd = openFile (file, option);
+#ifdef CASA_STAGEFILES
+    // Use the staged copy of a large read-only file (e.g. for MMapIO).
+    if (option == ByteIO::Old) {
+        int sfd = StageCache::openFD (file.path().expandedName());
+        if (sfd >= 0) {
+            traceCLOSE (fd);
+            fd = sfd;
         }
-
-}
-
-int RegularFileIO::omp_file_dump(std::string filename,char *buff,int threads)
-{
-        int fd;
-        std::string newFilePath=replace(filename);
-        fd=shm_open(newFilePath.c_str(),O_CREAT |O_RDWR,0777);
-        //boost::thread(threadedRead,filename,buff,threads,fd);
-        threadedRead(filename,buff,threads,fd);
-        //boost::this_thread::sleep(boost::posix_time::seconds(30) );
-        return fd;
-}
-
-void RegularFileIO::insertHash(std::string str,int myval,charAllocator chralloc,shmHashMap *map)
-{
-        shmKey mystr(chralloc);
-        mystr=str.c_str();
-        shmPair K(mystr,myval);
-        map->insert(K);
-}
-
-int RegularFileIO::shmInsert(std::string db,std::string table,std::string filePath,int value)
-{
-
-    std::string newFilePath=replace(filePath);
-
-    ipc::managed_shared_memory shm(ipc::open_or_create,db.c_str(),100000);
-    int returnVal=0;
-    charAllocator charalloc(shm.get_segment_manager());
-    shmKey path(charalloc);
-    path=newFilePath.c_str();
-
-    char *buff;
-
-    shmHashMap *readMap=shm.find<shmHashMap>(table.c_str()).first;
-    if(readMap==0)
-    {
-       readMap=shm.construct<shmHashMap>(table.c_str())(300,boost::hash<shmKey>(),
-                std::equal_to<shmKey>(), shm.get_allocator<shmPair>());
     }
-    shmHashMap::iterator it=readMap->find(path);
-
-    if(it==readMap->end())
-    {
-        returnVal=omp_file_dump(filePath,buff,28);
-        insertHash(newFilePath,returnVal,charalloc,readMap);
-        #ifdef PARIO_DEBUG
-        std::cout<<"not found. fd"<<returnVal<<" "<<std::endl;
-        #endif
-   }
-   else
-   {
-        //readMap->at(path)=value; 
-        #ifdef PARIO_DEBUG
-        std::cout<<"record:"<<readMap->at(path)<<std::endl;
-        #endif
-        //returnVal=readMap->at(path);
-        returnVal=open((std::string("/dev/shm/")+newFilePath).c_str(),O_RDONLY);
-  }
-
-   return returnVal;
-
-
-}
-
-
-
-
-void RegularFileIO::removeShm(std::string inp)
-{
-        ipc::shared_memory_object::remove(inp.c_str());
+#endif
+    return fd;
 }
 
-
-
-
-
-
-
-int RegularFileIO::openCreate (const RegularFile& file,
-                               ByteIO::OpenOption option)
+int RegularFileIO::openFile (const RegularFile& file,
+                             ByteIO::OpenOption option)
 {
     const String& name = file.path().expandedName();
     Bool create = False;
@@ -237,20 +132,6 @@ int RegularFileIO::openCreate (const RegularFile& file,
       fd = trace3OPEN ((char*)name.chars(), stropt, 0666);
     } else {
       fd = trace2OPEN ((char*)name.chars(), stropt);
-     #if defined(PARIO) || defined(PARIO_DEBUG)
-     if(get_file_size(name.chars())/1E9>4)
-     {
-	char *buff;
-	close(fd);
-        fd=shmInsert("wsclean","parallel_read",std::string(name.chars()),1);
-	#ifdef PARIO_DEBUG
-	std::cout<<"Current fd:"<<fd<<std::endl;
-	#endif
-        //std::cout<<name.chars()<<" fd:"<<fd<<"  size:"<<
-	//	get_file_size(name.chars())/1E9<<endl;
-    }
-    #endif
-  
     }
     if (fd < 0) {
 	throw (AipsError ("RegularFileIO: error in open or create of file " +
@@ -275,10 +156,35 @@ void RegularFileIO::reopenRW()
     uInt bufsize = bufferSize();
     detach (True);
     attach (file, bufsize);
+#ifdef CASA_STAGEFILES
+    // The staged copy is not used anymore.
+    delete itsStaged;
+    itsStaged = 0;
+#endif
     // It can be reopened, so close and reopen.
     itsOption = ByteIO::Update;
 }
 
+Int64 RegularFileIO::read (Int64 size, void* buf, Bool throwException)
+{
+#ifdef CASA_STAGEFILES
+    if (itsStaged) {
+        Int64 offset = seek (Int64(0), ByteIO::Current);
+        Int64 nread = itsStaged->read (offset, size, buf);
+        if (nread >= 0) {
+            seek (offset + nread);
+            if (nread < size  &&  throwException) {
+                throw AipsError ("RegularFileIO::read - incorrect number of"
+                                 " bytes (" + String::toString(nread) +
+                                 " out of " + String::toString(size) +
+                                 ") read for file " + fileName());
+            }
+            return nread;
+        }
+    }
+#endif
+    return FilebufIO::read (size, buf, throwException);
+}
 
 String RegularFileIO::fileName() const
 {
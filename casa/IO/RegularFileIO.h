@@ -34,45 +34,11 @@
 #include <casacore/casa/OS/RegularFile.h>
 
 
-
-//Parallel IO
-#if defined(PARIO) || defined(PARIO_DEBUG)
-#include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string/replace.hpp>
-#include <boost/functional/hash.hpp>
-#include <boost/interprocess/allocators/allocator.hpp>
-#include <boost/interprocess/containers/string.hpp>
-#include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/thread/thread.hpp>
-//#include <boost/regex.hpp> 
-#include <boost/unordered_map.hpp>
-#include <iostream>
-#include <string>
-#include <thread>
-#include <chrono>        
-#include <omp.h>
-#include <fstream>
-#include <unistd.h>
-#include <fcntl.h>
-#include <sys/types.h>
-namespace ipc=boost::interprocess;
-typedef ipc::allocator<char, ipc::managed_shared_memory::segment_manager>
-   charAllocator;
-typedef ipc::basic_string<char, std::char_traits<char>, charAllocator>
-   shmString;
-typedef shmString shmKey;
-typedef int shmValue;
-typedef std::pair<shmKey,shmValue> shmPair;
-typedef ipc::allocator<shmPair,ipc::managed_shared_memory::segment_manager> shmPairAllocator;
-
-typedef boost::unordered_map<shmKey, shmValue,
-           boost::hash<shmKey>, std::equal_to<shmKey>,
-           shmPairAllocator> shmHashMap;
-
-#endif
-
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# Forward Declarations
+class StagedFile;
+
 // <summary> 
 // Class for IO on a regular file.
 // </summary>
@@ -95,6 +61,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // which contains all functions to access the file. The description of
 // this class explains the use of the <src>filebufSize</src> argument
 // in the constructor.
+// <p>
+// When casacore is built with <src>PARIO</src> (and with Boost and thread
+// support), a large file opened
+// read-only (i.e. with option <src>ByteIO::Old</src>) is read from a copy in
+// shared memory managed by class <linkto class=StageCache>StageCache</linkto>.
+// The file is staged in the background; reads of ranges already staged are
+// served from the copy, other reads from the file itself.
+// The copy is released when the object is destructed or reopened for
+// read/write access.
 // </synopsis>
 
 // <example>
@@ -137,38 +112,36 @@ public:
     // if it is not possible to reopen it for read/write access.
     virtual void reopenRW();
 
+    // Read <src>size</src> bytes from the file.
+    // If the file is staged and the range is available in the staged copy,
+    // it is read from there. Otherwise it is read from the file.
+    virtual Int64 read (Int64 size, void* buf, Bool throwException=True);
+
     // Get the file name of the file attached.
     virtual String fileName() const;
 
     // Convenience function to open or create a file.
     // Optionally it is checked if the file does not exist yet.
     // It returns the file descriptor.
+    // <br>When casacore is built with <src>PARIO</src>, the file descriptor
+    // of the staged copy is returned for a large file opened read-only
+    // (see <linkto class=StageCache>StageCache</linkto>). In that case it
+    // waits until the file is fully staged.
     static int openCreate (const RegularFile& file, ByteIO::OpenOption);
 
 private:
+    // Open or create the file without using a staged copy.
+    static int openFile (const RegularFile& file, ByteIO::OpenOption);
+
     OpenOption  itsOption;
     RegularFile itsRegularFile;
+    StagedFile* itsStaged;
 
     // Copy constructor, should not be used.
     RegularFileIO (const RegularFileIO& that);
 
     // Assignment, should not be used.
     RegularFileIO& operator= (const RegularFileIO& that);
-
-#if defined(PARIO) || defined(PARIO_DEBUG)
-        static int omp_file_dump(std::string filename,char *buff,int threads);
-        static void insertHash(std::string str,int myval,charAllocator chralloc,shmHashMap *map);
-        static void threadedRead(std::string filename,char *buff,int threads,int fd);
-
-        static int shmInsert(std::string db,std::string table,std::string filePath,int value);
-
-        static void removeShm(std::string inp);
-        static std::string replace(std::string inp);
-        static long get_file_size(std::string filename);
-#endif
-
-
-
 };
 } //# NAMESPACE CASACORE - END
 
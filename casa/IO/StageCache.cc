@@ -0,0 +1,672 @@
+//# StageCache.cc: Shared-memory staging cache for large read-only files
+//# Copyright (C) 2018
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/IO/StageCache.h>
+
+#if defined(HAVE_BOOST) && defined(USE_THREADS)
+
+#include <casacore/casa/OS/Path.h>
+#include <casacore/casa/OS/Mutex.h>
+#include <casacore/casa/OS/OMP.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/containers/map.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace ipc = boost::interprocess;
+
+namespace {
+
+  typedef ipc::managed_shared_memory::segment_manager SegmentManager;
+  typedef ipc::allocator<char, SegmentManager> CharAllocator;
+  typedef ipc::basic_string<char, std::char_traits<char>,
+                            CharAllocator> ShmString;
+
+  // The bookkeeping of a staged file.
+  // The fields nready and valid are accessed atomically, because they are
+  // read without holding the bookkeeping lock.
+  struct StageEntry
+  {
+    Int64  size;
+    Int64  mtimeSec;
+    Int64  mtimeNsec;
+    Int64  chunkSize;
+    Int64  nchunk;
+    Int64  nready;
+    uInt64 lastUse;
+    Int    refCount;
+    Int    valid;
+    Bool   loading;
+    pid_t  stager;
+  };
+
+  typedef std::pair<const ShmString, StageEntry> EntryPair;
+  typedef ipc::allocator<EntryPair, SegmentManager> EntryAllocator;
+  typedef ipc::map<ShmString, StageEntry, std::less<ShmString>,
+                   EntryAllocator> EntryMap;
+
+  // The global info of the cache.
+  struct StageHeader
+  {
+    StageHeader()
+      : totalSize(0), useCounter(0), nhit(0), nmiss(0), nevict(0), nstale(0)
+    {}
+    ipc::interprocess_mutex mutex;
+    Int64  totalSize;
+    uInt64 useCounter;
+    uInt64 nhit;
+    uInt64 nmiss;
+    uInt64 nevict;
+    uInt64 nstale;
+  };
+
+  typedef ipc::scoped_lock<ipc::interprocess_mutex> StageLock;
+
+  const char*  theSegmentName = "casacore_stagecache";
+  const size_t theSegmentSize = 4*1024*1024;
+
+  // The process-wide objects.
+  Mutex                       theirMutex;
+  ipc::managed_shared_memory* theirSegment = 0;
+  StageHeader*                theirHeader  = 0;
+  EntryMap*                   theirEntries = 0;
+  Bool                        theirOptionsSet = False;
+  StageCache::Options         theirOptions;
+
+  // Open (or create) the shared bookkeeping segment.
+  void openRegistry()
+  {
+    ScopedMutexLock locker(theirMutex);
+    if (theirSegment == 0) {
+      ipc::managed_shared_memory* segment = new ipc::managed_shared_memory
+        (ipc::open_or_create, theSegmentName, theSegmentSize);
+      theirHeader  = segment->find_or_construct<StageHeader>("header")();
+      theirEntries = segment->find_or_construct<EntryMap>("entries")
+        (std::less<ShmString>(),
+         EntryAllocator(segment->get_segment_manager()));
+      theirSegment = segment;
+    }
+  }
+
+  ShmString makeKey (const String& name)
+  {
+    return ShmString (name.chars(),
+                      CharAllocator(theirSegment->get_segment_manager()));
+  }
+
+  // The readiness bitmap of a file is a separate object in the segment.
+  String bitsName (const String& shmName)
+  {
+    return "bits" + shmName;
+  }
+
+  Int64* findBits (const String& shmName)
+  {
+    return theirSegment->find<Int64>(bitsName(shmName).chars()).first;
+  }
+
+  Bool processAlive (pid_t pid)
+  {
+    return (::kill (pid, 0) == 0  ||  errno != ESRCH);
+  }
+
+  Bool sameFile (const StageEntry& entry, const struct stat& st)
+  {
+    return (entry.size      == Int64(st.st_size)      &&
+            entry.mtimeSec  == Int64(st.st_mtim.tv_sec)  &&
+            entry.mtimeNsec == Int64(st.st_mtim.tv_nsec));
+  }
+
+  Bool isValid (const StageEntry& entry)
+  {
+    return __atomic_load_n (&entry.valid, __ATOMIC_ACQUIRE) != 0;
+  }
+
+  void invalidate (StageEntry& entry)
+  {
+    __atomic_store_n (&entry.valid, 0, __ATOMIC_RELEASE);
+  }
+
+  Bool isComplete (const StageEntry& entry)
+  {
+    return __atomic_load_n (&entry.nready, __ATOMIC_ACQUIRE) == entry.nchunk;
+  }
+
+  // Remove a staged copy and its entry.
+  // The bookkeeping lock must have been acquired.
+  void removeEntry (const String& shmName, EntryMap::iterator iter)
+  {
+    theirSegment->destroy<Int64> (bitsName(shmName).chars());
+    ::shm_unlink (("/" + shmName).chars());
+    theirHeader->totalSize -= iter->second.size;
+    theirEntries->erase (iter);
+  }
+
+  // Evict unused copies in LRU order until the given size fits in the
+  // budget. It returns False if that is not possible.
+  // The bookkeeping lock must have been acquired.
+  Bool makeRoom (Int64 size, Int64 budget)
+  {
+    if (size > budget) {
+      return False;
+    }
+    while (theirHeader->totalSize + size > budget) {
+      EntryMap::iterator lru = theirEntries->end();
+      for (EntryMap::iterator iter = theirEntries->begin();
+           iter != theirEntries->end(); ++iter) {
+        if (iter->second.refCount == 0  &&
+            (lru == theirEntries->end()  ||
+             iter->second.lastUse < lru->second.lastUse)) {
+          lru = iter;
+        }
+      }
+      if (lru == theirEntries->end()) {
+        return False;
+      }
+      removeEntry (StageCache::shmName(String(lru->first.c_str())), lru);
+      theirHeader->nevict++;
+    }
+    return True;
+  }
+
+  // Release a reference to a staged copy and remove it if no longer used
+  // and not to be kept (or stale).
+  void releaseEntry (const String& fileName, Bool keep)
+  {
+    try {
+      openRegistry();
+      StageLock lock(theirHeader->mutex);
+      EntryMap::iterator iter = theirEntries->find (makeKey(fileName));
+      if (iter != theirEntries->end()  &&  iter->second.refCount > 0) {
+        StageEntry& entry = iter->second;
+        entry.refCount--;
+        if (entry.refCount == 0) {
+          struct stat st;
+          if (!keep  ||  !isValid(entry)  ||
+              ::stat (fileName.chars(), &st) != 0  ||
+              !sameFile (entry, st)) {
+            removeEntry (StageCache::shmName(fileName), iter);
+          }
+        }
+      }
+    } catch (const ipc::interprocess_exception&) {
+    }
+  }
+
+  // Read the given number of bytes at the given offset.
+  Bool readFully (int fd, char* buf, Int64 size, Int64 offset)
+  {
+    while (size > 0) {
+      ssize_t n = ::pread (fd, buf, size, offset);
+      if (n < 0  &&  errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return False;
+      }
+      buf    += n;
+      size   -= n;
+      offset += n;
+    }
+    return True;
+  }
+
+
+  // The loader copying a file into shared memory.
+  // The chunks are handed out to the threads in file order, so the start
+  // of the file becomes available first.
+  struct StageLoader
+  {
+    String      fileName;
+    StageEntry* entry;
+    Int64*      bits;
+    uInt        nthreads;
+    int         inFd;
+    int         outFd;
+    char*       data;
+    Int64       next;
+    Int         nfail;
+  };
+
+  // Copy chunks until all chunks are handed out.
+  void loadChunks (StageLoader* loader)
+  {
+    StageEntry& entry = *loader->entry;
+    while (__atomic_load_n (&loader->nfail, __ATOMIC_RELAXED) == 0) {
+      Int64 chunk = __atomic_fetch_add (&loader->next, 1, __ATOMIC_RELAXED);
+      if (chunk >= entry.nchunk) {
+        break;
+      }
+      Int64 offset = chunk * entry.chunkSize;
+      Int64 size   = std::min (entry.chunkSize, entry.size - offset);
+      // Reserve the space first, so running out of shared memory gives an
+      // error instead of a SIGBUS when writing into the mapped region.
+      if (::posix_fallocate (loader->outFd, offset, size) != 0  ||
+          !readFully (loader->inFd, loader->data + offset, size, offset)) {
+        __atomic_fetch_add (&loader->nfail, 1, __ATOMIC_RELAXED);
+        break;
+      }
+      __atomic_fetch_or (loader->bits + chunk/64, Int64(1) << (chunk%64),
+                         __ATOMIC_RELEASE);
+      __atomic_fetch_add (&entry.nready, 1, __ATOMIC_RELEASE);
+    }
+  }
+
+  // Run the loader threads and finish the staging.
+  // It releases the reference held by the loader and deletes the loader.
+  void runLoader (StageLoader* loader)
+  {
+    StageEntry& entry = *loader->entry;
+    loader->inFd = ::open (loader->fileName.chars(), O_RDONLY);
+    void* ptr = MAP_FAILED;
+    if (loader->inFd >= 0) {
+      ptr = ::mmap (0, entry.size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                    loader->outFd, 0);
+    }
+    if (ptr == MAP_FAILED) {
+      loader->nfail = 1;
+    } else {
+      loader->data = static_cast<char*>(ptr);
+      std::vector<std::thread> threads;
+      for (uInt i=1; i<loader->nthreads; ++i) {
+        threads.push_back (std::thread(loadChunks, loader));
+      }
+      loadChunks (loader);
+      for (uInt i=0; i<threads.size(); ++i) {
+        threads[i].join();
+      }
+      ::munmap (ptr, entry.size);
+    }
+    if (loader->inFd >= 0) {
+      ::close (loader->inFd);
+    }
+    ::close (loader->outFd);
+    // Invalidate the copy if the file changed while being copied.
+    struct stat st;
+    if (loader->nfail > 0  ||  ::stat (loader->fileName.chars(), &st) != 0
+    ||  !sameFile (entry, st)) {
+      invalidate (entry);
+    }
+    {
+      StageLock lock(theirHeader->mutex);
+      entry.loading = False;
+    }
+    releaseEntry (loader->fileName, StageCache::options().keep);
+    delete loader;
+  }
+
+} // end anonymous namespace
+
+
+
+StagedFile::StagedFile (const String& fileName, void* entry, Int64* bits,
+                        Int64 size, Int64 chunkSize, const char* data)
+: itsFileName  (fileName),
+  itsEntry     (entry),
+  itsBits      (bits),
+  itsSize      (size),
+  itsChunkSize (chunkSize),
+  itsData      (data)
+{}
+
+StagedFile::~StagedFile()
+{
+  ::munmap (const_cast<char*>(itsData), itsSize);
+  StageCache::release (itsFileName);
+}
+
+Bool StagedFile::isValid() const
+{
+  return casacore::isValid (*static_cast<StageEntry*>(itsEntry));
+}
+
+Bool StagedFile::isComplete() const
+{
+  return casacore::isComplete (*static_cast<StageEntry*>(itsEntry));
+}
+
+Int64 StagedFile::nchunkStaged() const
+{
+  return __atomic_load_n (&static_cast<StageEntry*>(itsEntry)->nready,
+                          __ATOMIC_ACQUIRE);
+}
+
+Bool StagedFile::isStaged (Int64 offset, Int64 size) const
+{
+  if (size <= 0) {
+    return True;
+  }
+  Int64 last = std::min (offset + size, itsSize) - 1;
+  for (Int64 chunk = offset / itsChunkSize; chunk <= last / itsChunkSize;
+       ++chunk) {
+    Int64 word = __atomic_load_n (itsBits + chunk/64, __ATOMIC_ACQUIRE);
+    if ((word & (Int64(1) << (chunk%64))) == 0) {
+      return False;
+    }
+  }
+  return True;
+}
+
+Int64 StagedFile::read (Int64 offset, Int64 size, void* buf) const
+{
+  if (! isValid()) {
+    return -1;
+  }
+  Int64 nread = std::max (Int64(0), std::min (size, itsSize - offset));
+  if (! isStaged (offset, nread)) {
+    return -1;
+  }
+  if (nread > 0) {
+    memcpy (buf, itsData + offset, nread);
+  }
+  return nread;
+}
+
+Bool StagedFile::waitComplete() const
+{
+  while (isValid()  &&  !isComplete()) {
+    ::usleep (1000);
+  }
+  return isValid();
+}
+
+
+
+StageCache::Options StageCache::options()
+{
+  ScopedMutexLock locker(theirMutex);
+  if (! theirOptionsSet) {
+    Int threshold, budget, chunkSize, nthreads;
+    Bool keep;
+    AipsrcValue<Int>::find (threshold, "stagecache.thresholdmb", 4000);
+    AipsrcValue<Int>::find (budget, "stagecache.budgetmb", 0);
+    AipsrcValue<Int>::find (chunkSize, "stagecache.chunkmb", 4);
+    AipsrcValue<Int>::find (nthreads, "stagecache.nthreads", 0);
+    AipsrcValue<Bool>::find (keep, "stagecache.keep", True);
+    theirOptions.threshold = Int64(threshold) * 1024*1024;
+    theirOptions.budget    = Int64(budget) * 1024*1024;
+    if (budget <= 0) {
+      // Default is half the size of the shared memory file system.
+      struct statvfs buf;
+      theirOptions.budget = 0;
+      if (::statvfs ("/dev/shm", &buf) == 0) {
+        theirOptions.budget = Int64(buf.f_blocks) * buf.f_frsize / 2;
+      }
+    }
+    theirOptions.chunkSize = Int64(std::max (chunkSize, 1)) * 1024*1024;
+    theirOptions.nthreads  = (nthreads > 0  ?  nthreads : OMP::maxThreads());
+    theirOptions.keep      = keep;
+    theirOptionsSet = True;
+  }
+  return theirOptions;
+}
+
+void StageCache::setOptions (const Options& options)
+{
+  ScopedMutexLock locker(theirMutex);
+  theirOptions = options;
+  if (theirOptions.nthreads == 0) {
+    theirOptions.nthreads = OMP::maxThreads();
+  }
+  if (theirOptions.chunkSize <= 0) {
+    theirOptions.chunkSize = 4*1024*1024;
+  }
+  theirOptionsSet = True;
+}
+
+String StageCache::shmName (const String& fileName)
+{
+  String name(fileName);
+  name.gsub ("/", "_");
+  // Shared memory names are limited in length; keep the tail of a long
+  // name and add a hash of the full name to make it unique.
+  if (name.size() > 200) {
+    uInt64 hash = 14695981039346656037ULL;
+    for (String::size_type i=0; i<name.size(); ++i) {
+      hash = (hash ^ (unsigned char)(name[i])) * 1099511628211ULL;
+    }
+    char buf[24];
+    snprintf (buf, sizeof(buf), "%016llx", (unsigned long long)hash);
+    name = String(buf) + name.from(Int(name.size()) - 160);
+  }
+  return "casacore_stage" + name;
+}
+
+StagedFile* StageCache::open (const String& fileName)
+{
+  Options opt = options();
+  String name = Path(fileName).absoluteName();
+  struct stat st;
+  if (::stat (name.chars(), &st) != 0  ||  !S_ISREG(st.st_mode)  ||
+      st.st_size == 0  ||  Int64(st.st_size) < opt.threshold) {
+    return 0;
+  }
+  Int64 size = st.st_size;
+  String shmnm = shmName(name);
+  try {
+    openRegistry();
+    StageLock lock(theirHeader->mutex);
+    ShmString key = makeKey(name);
+    EntryMap::iterator iter = theirEntries->find (key);
+    if (iter != theirEntries->end()) {
+      StageEntry& entry = iter->second;
+      if (entry.loading  &&  !processAlive(entry.stager)) {
+        // The staging process died; drop the reference of its loader.
+        entry.loading = False;
+        entry.refCount--;
+        invalidate (entry);
+      }
+      if (!isValid(entry)  ||  !sameFile(entry, st)) {
+        // The file changed after it was staged.
+        theirHeader->nstale++;
+        if (entry.refCount > 0) {
+          theirHeader->nmiss++;
+          return 0;
+        }
+        removeEntry (shmnm, iter);
+        iter = theirEntries->end();
+      }
+    }
+    int fd;
+    if (iter != theirEntries->end()) {
+      fd = ::shm_open (("/" + shmnm).chars(), O_RDONLY, 0);
+    } else {
+      theirHeader->nmiss++;
+      if (! makeRoom (size, opt.budget)) {
+        return 0;
+      }
+      // Remove a possible leftover of a crashed cache.
+      ::shm_unlink (("/" + shmnm).chars());
+      fd = ::shm_open (("/" + shmnm).chars(), O_CREAT | O_EXCL | O_RDWR,
+                       0644);
+      if (fd < 0) {
+        return 0;
+      }
+      if (::ftruncate (fd, size) != 0) {
+        ::close (fd);
+        ::shm_unlink (("/" + shmnm).chars());
+        return 0;
+      }
+      StageEntry entry;
+      entry.size      = size;
+      entry.mtimeSec  = st.st_mtim.tv_sec;
+      entry.mtimeNsec = st.st_mtim.tv_nsec;
+      entry.chunkSize = opt.chunkSize;
+      entry.nchunk    = (size + opt.chunkSize - 1) / opt.chunkSize;
+      entry.nready    = 0;
+      entry.lastUse   = 0;
+      entry.refCount  = 1;            // the reference of the loader
+      entry.valid     = 1;
+      entry.loading   = True;
+      entry.stager    = ::getpid();
+      theirSegment->construct<Int64> (bitsName(shmnm).chars())
+        [(entry.nchunk + 63) / 64] (0);
+      iter = theirEntries->insert (EntryPair(key, entry)).first;
+      theirHeader->totalSize += size;
+      // Start the loader in the background.
+      StageLoader* loader = new StageLoader;
+      loader->fileName = name;
+      loader->entry    = &(iter->second);
+      loader->bits     = findBits (shmnm);
+      loader->nthreads = std::max (opt.nthreads, 1u);
+      loader->inFd     = -1;
+      loader->outFd    = ::dup (fd);
+      loader->data     = 0;
+      loader->next     = 0;
+      loader->nfail    = 0;
+      std::thread(runLoader, loader).detach();
+    }
+    StageEntry& entry = iter->second;
+    void* ptr = MAP_FAILED;
+    if (fd >= 0) {
+      ptr = ::mmap (0, size, PROT_READ, MAP_SHARED, fd, 0);
+      ::close (fd);
+    }
+    if (ptr == MAP_FAILED) {
+      // The copy is not usable.
+      invalidate (entry);
+      if (entry.refCount == 0) {
+        removeEntry (shmnm, iter);
+      }
+      return 0;
+    }
+    entry.refCount++;
+    entry.lastUse = ++theirHeader->useCounter;
+    theirHeader->nhit++;
+    return new StagedFile (name, &entry, findBits(shmnm), size,
+                           entry.chunkSize, static_cast<char*>(ptr));
+  } catch (const ipc::interprocess_exception&) {
+    return 0;
+  }
+}
+
+int StageCache::openFD (const String& fileName)
+{
+  int fd = -1;
+  StagedFile* sfile = open (fileName);
+  if (sfile) {
+    // The reference held by sfile prevents the copy from being evicted.
+    if (sfile->waitComplete()) {
+      fd = ::shm_open (("/" + shmName(sfile->fileName())).chars(),
+                       O_RDONLY, 0);
+      // The file might have changed while waiting.
+      if (fd >= 0  &&  !sfile->isValid()) {
+        ::close (fd);
+        fd = -1;
+      }
+    }
+    delete sfile;
+  }
+  return fd;
+}
+
+void StageCache::release (const String& fileName)
+{
+  releaseEntry (fileName, options().keep);
+}
+
+void StageCache::clear()
+{
+  openRegistry();
+  StageLock lock(theirHeader->mutex);
+  EntryMap::iterator iter = theirEntries->begin();
+  while (iter != theirEntries->end()) {
+    EntryMap::iterator cur = iter++;
+    if (cur->second.refCount == 0) {
+      removeEntry (shmName(String(cur->first.c_str())), cur);
+    }
+  }
+}
+
+Int64 StageCache::stagedSize()
+{
+  openRegistry();
+  StageLock lock(theirHeader->mutex);
+  return theirHeader->totalSize;
+}
+
+Int StageCache::refCount (const String& fileName)
+{
+  String name = Path(fileName).absoluteName();
+  openRegistry();
+  StageLock lock(theirHeader->mutex);
+  EntryMap::const_iterator iter = theirEntries->find (makeKey(name));
+  if (iter == theirEntries->end()) {
+    return -1;
+  }
+  return iter->second.refCount;
+}
+
+void StageCache::showStatistics (ostream& os)
+{
+  Options opt = options();
+  openRegistry();
+  StageLock lock(theirHeader->mutex);
+  os << "StageCache statistics" << endl;
+  os << "  budget:     " << opt.budget << " bytes" << endl;
+  os << "  staged:     " << theirHeader->totalSize << " bytes in "
+     << theirEntries->size() << " files" << endl;
+  os << "  hits:       " << theirHeader->nhit << endl;
+  os << "  misses:     " << theirHeader->nmiss << endl;
+  os << "  evictions:  " << theirHeader->nevict << endl;
+  os << "  stale:      " << theirHeader->nstale << endl;
+  for (EntryMap::const_iterator iter = theirEntries->begin();
+       iter != theirEntries->end(); ++iter) {
+    const StageEntry& entry = iter->second;
+    os << "  " << iter->first.c_str() << "  size=" << entry.size
+       << " refcount=" << entry.refCount
+       << " chunks=" << __atomic_load_n (&entry.nready, __ATOMIC_ACQUIRE)
+       << '/' << entry.nchunk
+       << (isValid(entry) ? "" : " (invalid)") << endl;
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -0,0 +1,273 @@
+//# StageCache.h: Shared-memory staging cache for large read-only files
+//# Copyright (C) 2018
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_STAGECACHE_H
+#define CASA_STAGECACHE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/iosfwd.h>
+
+//# The StageCache needs Boost.Interprocess and thread support.
+#if defined(HAVE_BOOST) && defined(USE_THREADS)
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Handle to a file staged by the StageCache.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tStageCache" demos="">
+// </reviewed>
+
+// <synopsis>
+// A StagedFile object is returned by <src>StageCache::open</src>.
+// It gives access to the copy of a file in shared memory, which may still
+// be in the process of being staged. The copy is staged in chunks; the
+// <src>read</src> function serves a byte range as soon as all chunks
+// covering it are staged. Otherwise it returns -1 telling the caller to
+// read the range from the original file.
+// <br>The destructor releases the reference to the staged copy.
+// </synopsis>
+
+class StagedFile
+{
+public:
+  // Release the staged copy.
+  ~StagedFile();
+
+  // Read <src>size</src> bytes at the given offset into the buffer.
+  // It returns the number of bytes read (which is less than
+  // <src>size</src> when reading past the end of the file).
+  // -1 is returned if (part of) the range is not staged yet or if the
+  // copy has become invalid.
+  Int64 read (Int64 offset, Int64 size, void* buf) const;
+
+  // Tell if the range is fully staged.
+  Bool isStaged (Int64 offset, Int64 size) const;
+
+  // Tell if all chunks are staged.
+  Bool isComplete() const;
+
+  // Tell if the copy can still be used. It becomes invalid if staging
+  // failed or if the original file changed while it was staged.
+  Bool isValid() const;
+
+  // Wait until the file is completely staged (or became invalid).
+  // It returns <src>isValid()</src>.
+  Bool waitComplete() const;
+
+  // Get the number of staged chunks.
+  Int64 nchunkStaged() const;
+
+  // Get the size of the file.
+  Int64 size() const
+    { return itsSize; }
+
+  // Get the (absolute) name of the original file.
+  const String& fileName() const
+    { return itsFileName; }
+
+private:
+  friend class StageCache;
+
+  // Construct from the info set by StageCache::open.
+  StagedFile (const String& fileName, void* entry, Int64* bits,
+              Int64 size, Int64 chunkSize, const char* data);
+
+  // Forbid copy constructor and assignment.
+  StagedFile (const StagedFile&);
+  StagedFile& operator= (const StagedFile&);
+
+  //# Data members
+  String      itsFileName;
+  void*       itsEntry;       //# StageEntry in shared memory
+  Int64*      itsBits;        //# chunk readiness bitmap in shared memory
+  Int64       itsSize;
+  Int64       itsChunkSize;
+  const char* itsData;        //# copy mapped read-only
+};
+
+
+// <summary>
+// Shared-memory staging cache for large read-only files.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tStageCache" demos="">
+// </reviewed>
+
+// <synopsis>
+// StageCache keeps copies of large files in POSIX shared memory
+// (usually <src>/dev/shm</src>), so processes on the same node reading the
+// same file (e.g. several imagers reading one MeasurementSet) share a
+// single in-memory copy instead of each going to the (network) file system.
+// It is used by <linkto class=RegularFileIO>RegularFileIO</linkto> when
+// casacore is built with <src>PARIO</src> and a file is opened read-only.
+// The class is only available if casacore is built with Boost
+// (<src>HAVE_BOOST</src>) and thread support (<src>USE_THREADS</src>).
+//
+// The first process opening a file starts a background loader copying the
+// file in fixed-size chunks using <src>pread</src> from a few threads.
+// Each staged chunk is marked in a readiness bitmap, so
+// <linkto class=StagedFile>StagedFile</linkto> can serve a range
+// immediately once its chunks are staged, while the rest of the file is
+// still being copied. Unstaged ranges have to be read from the original
+// file.
+//
+// The cache bookkeeping is kept in a small shared memory segment, so it is
+// shared by all processes on the node. For each staged file it holds:
+// <ul>
+//  <li> The size and modification time of the original file at the time
+//       it was staged. When opening a file they are compared with the
+//       current values, so a stale copy is never handed out. The loader
+//       checks them again after the copy and invalidates the copy if the
+//       file changed meanwhile. A stale copy is removed as soon as nobody
+//       uses it anymore.
+//  <li> A reference count telling how many StagedFile objects (and
+//       loaders) use the copy.
+//       When the last user releases it, the copy is removed unless the
+//       <src>keep</src> option is set, in which case it is retained
+//       for future users until evicted.
+//  <li> A last-use stamp used for LRU eviction. The total size of all
+//       copies is limited by a byte budget; if a new file does not fit,
+//       the least recently used unreferenced copies are evicted. If that
+//       does not give enough room, the file is not staged at all and the
+//       caller reads the original file.
+// </ul>
+// If the staging process dies, its partial copy is invalidated and
+// removed by the next process opening the file.
+//
+// The behaviour can be tuned with the following aipsrc variables:
+// <ul>
+//  <li> <src>stagecache.thresholdmb</src> gives the minimum size (in MB)
+//       of a file to be staged. Default is 4000 MB.
+//  <li> <src>stagecache.budgetmb</src> gives the maximum total size (in MB)
+//       of the staged copies. Default is 0, meaning half the size of the
+//       shared memory file system.
+//  <li> <src>stagecache.nthreads</src> gives the number of threads used to
+//       copy a file. Default is 0, meaning the OpenMP maximum.
+//  <li> <src>stagecache.chunkmb</src> gives the size (in MB) of the chunks
+//       in which a file is staged. Default is 4 MB.
+//  <li> <src>stagecache.keep</src> tells if a copy is retained after its
+//       last user released it. Default is True.
+// </ul>
+// Programs can also set the options explicitly using function
+// <src>setOptions</src>.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//    StagedFile* sfile = StageCache::open ("my.ms/table.f1");
+//    if (sfile) {
+//      if (sfile->read (offset, size, buf) < 0) {
+//        // ... not staged yet; read from the original file ...
+//      }
+//      delete sfile;
+//    }
+// </srcblock>
+// </example>
+
+// <motivation>
+// The original ad-hoc staging in RegularFileIO had no limit on the amount
+// of shared memory used, never removed a copy and could serve stale data.
+// Furthermore, a reader had to wait until the entire file was copied.
+// </motivation>
+
+class StageCache
+{
+public:
+  // Define the tuning parameters of the cache.
+  struct Options {
+    // Minimum file size (in bytes) to be staged.
+    Int64 threshold;
+    // Maximum total size (in bytes) of all staged copies.
+    Int64 budget;
+    // Size (in bytes) of the chunks in which a file is staged.
+    Int64 chunkSize;
+    // Number of threads to use for staging a file.
+    uInt  nthreads;
+    // Keep a copy after its last user released it?
+    Bool  keep;
+  };
+
+  // Get the current options.
+  // On first use they are filled from the aipsrc variables.
+  static Options options();
+
+  // Set the options for this process.
+  static void setOptions (const Options& options);
+
+  // Get access to the staged copy of the given file. If it is not staged
+  // yet, a background loader is started to stage it.
+  // A null pointer is returned if the file is not staged, because it is
+  // too small, does not fit in the budget, or a stale copy is still in use.
+  // <br>The caller has to delete the returned object.
+  static StagedFile* open (const String& fileName);
+
+  // Get a read-only file descriptor of the staged copy of the given file.
+  // It is meant for users needing a file descriptor (e.g. for mmap) rather
+  // than reading through a StagedFile. It waits until the file is fully
+  // staged. The copy remains accessible while the file descriptor (or a
+  // mapping of it) is open, even if the cache evicts it meanwhile.
+  // -1 is returned if the file is not staged (see <src>open</src>).
+  // <br>The caller has to close the returned file descriptor.
+  static int openFD (const String& fileName);
+
+  // Remove all staged copies that are not in use.
+  static void clear();
+
+  // Get the total size (in bytes) of the staged copies.
+  static Int64 stagedSize();
+
+  // Get the reference count of the staged copy of the given file.
+  // -1 is returned if the file is not staged.
+  static Int refCount (const String& fileName);
+
+  // Show the staged files and the cache statistics.
+  static void showStatistics (ostream&);
+
+  // Get the name of the shared memory object used for the given file.
+  static String shmName (const String& fileName);
+
+private:
+  friend class StagedFile;
+
+  // Release a reference to the staged copy of the given file.
+  static void release (const String& fileName);
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
+
+#endif
@@ -29,6 +29,7 @@
 #include <casacore/casa/IO/BucketFile.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
 
 #include <casacore/casa/namespace.h>
@@ -40,6 +41,7 @@ void a (Bool);
 void b (Bool);
 void c (uInt bufSize);
 void d (uInt bufSize);
+void e();
 
 int main (int argc, const char*[])
 {
@@ -54,6 +56,7 @@ int main (int argc, const char*[])
 //	d (1024);
 //	d (32768);
 //	d (327680);
+	e();
     } catch (AipsError x) {
 	cout << "Caught an exception: " << x.getMesg() << endl;
 	return 1;
@@ -256,3 +259,80 @@ void d (uInt)
     timer.show();
     cout << "<<<" << endl;
 }
+
+// Check the contents of a bucket written by e.
+Bool checkBucket (const char* buf, Int value)
+{
+    return *(const Int*)buf == value  &&  *(const Int*)(buf+32760) == value;
+}
+
+// Test asynchronous read-ahead and write-behind.
+void e()
+{
+    {
+	// Create the file using write-behind in a small cache, so most
+	// buckets are written in the background.
+	BucketFile file ("tBucketCache_tmp.data2");
+	file.open();
+	BucketCache cache (&file, 512, 32768, 0, 3, 0, bToLocal, bFromLocal,
+			   aInitBuffer, aDeleteBuffer);
+	cache.setAsyncIO (4, True);
+	AlwaysAssertExit (cache.hasAsyncIO());
+	for (Int i=0; i<50; i++) {
+	    char* ptr = new char[32768];
+	    memset (ptr, 0, 32768);
+	    *(Int*)ptr = i;
+	    *(Int*)(ptr+32760) = i;
+	    cache.addBucket (ptr);
+	}
+	// Update buckets that might still have to be written.
+	for (Int i=40; i<50; i++) {
+	    char* buf = cache.getBucket (i);
+	    AlwaysAssertExit (checkBucket (buf, i));
+	    *(Int*)buf = i+100;
+	    *(Int*)(buf+32760) = i+100;
+	    cache.setDirty();
+	}
+	for (Int i=40; i<50; i++) {
+	    AlwaysAssertExit (checkBucket (cache.getBucket(i), i+100));
+	}
+	// Remove a bucket and add it again.
+	cache.getBucket (10);
+	cache.removeBucket();
+	char* ptr = new char[32768];
+	memset (ptr, 0, 32768);
+	*(Int*)ptr = 10;
+	*(Int*)(ptr+32760) = 10;
+	AlwaysAssertExit (cache.addBucket(ptr) == 10);
+	cache.flush();
+	AlwaysAssertExit (cache.nBucket() == 50);
+	AlwaysAssertExit (cache.nFreeBucket() == 0);
+    }
+    {
+	// Read back sequentially and as two interleaved streams.
+	BucketFile file ("tBucketCache_tmp.data2", False);
+	file.open();
+	BucketCache cache (&file, 512, 32768, 50, 3, 0, bToLocal, bFromLocal,
+			   aInitBuffer, aDeleteBuffer);
+	cache.setAsyncIO (4, False);
+	for (Int i=0; i<50; i++) {
+	    AlwaysAssertExit (checkBucket (cache.getBucket(i),
+					   i<40 ? i : i+100));
+	}
+	cache.clear();
+	for (Int i=0; i<25; i++) {
+	    AlwaysAssertExit (checkBucket (cache.getBucket(i), i));
+	    AlwaysAssertExit (checkBucket (cache.getBucket(i+25),
+					   i<15 ? i+25 : i+125));
+	}
+	// Random access only reads synchronously.
+	for (Int i=0; i<50; i++) {
+	    Int bucketNr = (i*17) % 50;
+	    AlwaysAssertExit (checkBucket (cache.getBucket(bucketNr),
+				   bucketNr<40 ? bucketNr : bucketNr+100));
+	}
+	cache.setAsyncIO (0, False);
+	AlwaysAssertExit (! cache.hasAsyncIO());
+    }
+    cout << "checked asynchronous IO" << endl;
+}
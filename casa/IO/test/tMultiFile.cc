@@ -170,6 +170,55 @@ void checkFiles2()
   AlwaysAssertExit (allEQ(buf, buf1));
 }
 
+void testConcurrent()
+{
+  cout << "test concurrent IO" << endl;
+  const Int nfile = 4;
+  const Int nval  = 1000;
+  {
+    MultiFile mfile("tMultiFile_tmp.dat", ByteIO::New, 1024);
+    mfile.setBuffersPerFile (1);
+    for (Int i=0; i<nfile; ++i) {
+      mfile.addFile ("file" + String::toString(i));
+    }
+    // Write the files in parallel, each in parts not fitting a block.
+#pragma omp parallel for schedule(dynamic)
+    for (Int i=0; i<nfile; ++i) {
+      Vector<Int> buf(nval);
+      indgen (buf, i*nval);
+      for (Int j=0; j<nval; j+=100) {
+        mfile.write (i, buf.data()+j, 100*sizeof(Int), j*sizeof(Int));
+      }
+    }
+    // The pool has at most one buffer per file.
+    AlwaysAssertExit (mfile.nbuffer() <= uInt(nfile));
+    mfile.flush();
+  }
+  MultiFile mfile("tMultiFile_tmp.dat", ByteIO::Old);
+  AlwaysAssertExit (mfile.buffersPerFile() >= 1);
+  // Read the files in parallel, both whole blocks and parts.
+  Bool ok = True;
+#pragma omp parallel for schedule(dynamic)
+  for (Int i=0; i<2*nfile; ++i) {
+    Int fid = i%nfile;
+    Vector<Int> buf(nval), exp(nval);
+    indgen (exp, fid*nval);
+    if (i < nfile) {
+      mfile.read (fid, buf.data(), nval*sizeof(Int), 0);
+    } else {
+      for (Int j=0; j<nval; j+=75) {
+        Int n = std::min(75, nval-j);
+        mfile.read (fid, buf.data()+j, n*sizeof(Int), j*sizeof(Int));
+      }
+    }
+    if (! allEQ(buf, exp)) {
+#pragma omp critical(tMultiFile_testConcurrent)
+      ok = False;
+    }
+  }
+  AlwaysAssertExit (ok);
+}
+
 void timeExact()
 {
   MultiFile mfile("tMultiFile_tmp.dat", ByteIO::New, 32768);
@@ -276,6 +325,7 @@ int main()
   try {
     doTest (128);     // requires extra header file
     doTest (1024);    // no extra header file
+    testConcurrent();
     timeExact();
     timeDouble();
     timePartly();
@@ -0,0 +1,224 @@
+//# tStageCache.cc: Test program for class StageCache
+//# Copyright (C) 2018
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/IO/StageCache.h>
+#include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/IO/MMapIO.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <unistd.h>
+
+using namespace casacore;
+
+#if defined(HAVE_BOOST) && defined(USE_THREADS)
+
+// Write a file with the given size and fill value.
+void makeFile (const String& name, Int size, Int fill)
+{
+  char* buf = new char[size];
+  for (Int i=0; i<size; ++i) {
+    buf[i] = char(i + fill);
+  }
+  RegularFileIO file (RegularFile(name), ByteIO::New);
+  file.write (size, buf);
+  delete [] buf;
+}
+
+// Check that the staged copy gives the expected contents.
+void checkFile (StagedFile* sfile, Int size, Int fill)
+{
+  AlwaysAssertExit (sfile != 0);
+  AlwaysAssertExit (sfile->waitComplete());
+  AlwaysAssertExit (sfile->isComplete());
+  AlwaysAssertExit (sfile->size() == size);
+  char* buf = new char[size+1];
+  AlwaysAssertExit (sfile->read (0, size+1, buf) == size);
+  for (Int i=0; i<size; ++i) {
+    AlwaysAssertExit (buf[i] == char(i + fill));
+  }
+  // Read a part in the middle and past the end.
+  AlwaysAssertExit (sfile->read (size-10, 20, buf) == 10);
+  for (Int i=0; i<10; ++i) {
+    AlwaysAssertExit (buf[i] == char(size-10+i + fill));
+  }
+  AlwaysAssertExit (sfile->read (size+10, 20, buf) == 0);
+  delete [] buf;
+}
+
+// Wait until the loader released its reference to the staged copy.
+void waitRefCount (const String& name, Int refCount)
+{
+  for (Int i=0; i<5000  &&  StageCache::refCount(name) != refCount; ++i) {
+    usleep (1000);
+  }
+  AlwaysAssertExit (StageCache::refCount(name) == refCount);
+}
+
+void setOptions (Int64 threshold, Int64 budget, Bool keep)
+{
+  StageCache::Options opt;
+  opt.threshold = threshold;
+  opt.budget    = budget;
+  opt.chunkSize = 1000;
+  opt.nthreads  = 3;
+  opt.keep      = keep;
+  StageCache::setOptions (opt);
+}
+
+void testBasic()
+{
+  setOptions (1000, 100000, False);
+  makeFile ("tStageCache_tmp.small", 999, 0);
+  makeFile ("tStageCache_tmp.dat1", 20001, 1);
+  // A file smaller than the threshold is not staged.
+  AlwaysAssertExit (StageCache::open ("tStageCache_tmp.small") == 0);
+  // Stage and use the file twice.
+  StagedFile* sf1 = StageCache::open ("tStageCache_tmp.dat1");
+  checkFile (sf1, 20001, 1);
+  AlwaysAssertExit (sf1->nchunkStaged() == 21);
+  waitRefCount ("tStageCache_tmp.dat1", 1);
+  StagedFile* sf2 = StageCache::open ("tStageCache_tmp.dat1");
+  checkFile (sf2, 20001, 1);
+  AlwaysAssertExit (StageCache::refCount ("tStageCache_tmp.dat1") == 2);
+  delete sf1;
+  AlwaysAssertExit (StageCache::refCount ("tStageCache_tmp.dat1") == 1);
+  // The last release removes the copy if not kept.
+  delete sf2;
+  AlwaysAssertExit (StageCache::refCount ("tStageCache_tmp.dat1") == -1);
+}
+
+void testStale()
+{
+  setOptions (1000, 100000, True);
+  makeFile ("tStageCache_tmp.dat1", 20001, 1);
+  StagedFile* sf1 = StageCache::open ("tStageCache_tmp.dat1");
+  checkFile (sf1, 20001, 1);
+  // Rewrite the file while the copy is in use; the stale copy
+  // must not be given out.
+  sleep (1);
+  makeFile ("tStageCache_tmp.dat1", 30001, 2);
+  AlwaysAssertExit (StageCache::open ("tStageCache_tmp.dat1") == 0);
+  delete sf1;
+  // The stale copy has been removed on release, so it is staged again.
+  AlwaysAssertExit (StageCache::refCount ("tStageCache_tmp.dat1") == -1);
+  sf1 = StageCache::open ("tStageCache_tmp.dat1");
+  checkFile (sf1, 30001, 2);
+  waitRefCount ("tStageCache_tmp.dat1", 1);
+  delete sf1;
+  // It is kept after the last release.
+  AlwaysAssertExit (StageCache::refCount ("tStageCache_tmp.dat1") == 0);
+  StageCache::clear();
+  AlwaysAssertExit (StageCache::refCount ("tStageCache_tmp.dat1") == -1);
+}
+
+void testEvict()
+{
+  setOptions (1000, 50000, True);
+  makeFile ("tStageCache_tmp.dat1", 20000, 1);
+  makeFile ("tStageCache_tmp.dat2", 20000, 2);
+  makeFile ("tStageCache_tmp.dat3", 20000, 3);
+  Int64 staged = StageCache::stagedSize();
+  StagedFile* sf1 = StageCache::open ("tStageCache_tmp.dat1");
+  StagedFile* sf2 = StageCache::open ("tStageCache_tmp.dat2");
+  checkFile (sf1, 20000, 1);
+  checkFile (sf2, 20000, 2);
+  waitRefCount ("tStageCache_tmp.dat1", 1);
+  waitRefCount ("tStageCache_tmp.dat2", 1);
+  AlwaysAssertExit (StageCache::stagedSize() == staged + 40000);
+  // Both copies are in use, so the third file does not fit.
+  AlwaysAssertExit (StageCache::open ("tStageCache_tmp.dat3") == 0);
+  delete sf1;
+  delete sf2;
+  // Use dat2 again, so dat1 is the least recently used one.
+  delete StageCache::open ("tStageCache_tmp.dat2");
+  StagedFile* sf3 = StageCache::open ("tStageCache_tmp.dat3");
+  checkFile (sf3, 20000, 3);
+  waitRefCount ("tStageCache_tmp.dat3", 1);
+  AlwaysAssertExit (StageCache::refCount ("tStageCache_tmp.dat1") == -1);
+  AlwaysAssertExit (StageCache::refCount ("tStageCache_tmp.dat2") == 0);
+  delete sf3;
+  StageCache::clear();
+  AlwaysAssertExit (StageCache::stagedSize() == staged);
+}
+
+void testRegularFileIO()
+{
+#if defined(PARIO) || defined(PARIO_DEBUG)
+  // RegularFileIO reads from the copy while it is being staged.
+  setOptions (1000, 100000, False);
+  makeFile ("tStageCache_tmp.dat1", 20001, 1);
+  {
+    RegularFileIO file (RegularFile("tStageCache_tmp.dat1"));
+    char buf[20001];
+    AlwaysAssertExit (file.read (10001, buf) == 10001);
+    AlwaysAssertExit (file.read (10001, buf+10001, False) == 10000);
+    for (Int i=0; i<20001; ++i) {
+      AlwaysAssertExit (buf[i] == char(i + 1));
+    }
+    file.seek (20000);
+    AlwaysAssertExit (file.read (1, buf) == 1);
+    AlwaysAssertExit (buf[0] == char(20001));
+    waitRefCount ("tStageCache_tmp.dat1", 1);
+  }
+  AlwaysAssertExit (StageCache::refCount ("tStageCache_tmp.dat1") == -1);
+  // MMapIO gets the fully staged copy from openCreate. The copy can be
+  // removed from the cache, but remains mapped.
+  {
+    MMapIO file (RegularFile("tStageCache_tmp.dat1"));
+    waitRefCount ("tStageCache_tmp.dat1", -1);
+    AlwaysAssertExit (file.length() == 20001);
+    const char* buf = static_cast<const char*>(file.getReadPointer (0));
+    for (Int i=0; i<20001; ++i) {
+      AlwaysAssertExit (buf[i] == char(i + 1));
+    }
+  }
+#endif
+}
+
+#endif
+
+int main()
+{
+#if !defined(HAVE_BOOST) || !defined(USE_THREADS)
+  // Exit with untested if StageCache is not available.
+  return 3;
+#else
+  try {
+    testBasic();
+    testStale();
+    testEvict();
+    testRegularFileIO();
+  } catch (AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+#endif
+}
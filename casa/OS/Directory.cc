@@ -62,6 +62,7 @@
 #include <casacore/casa/Exceptions/Error.h>
 
 #include <casacore/casa/stdexcept.h>
+#include <vector>
 #include <unistd.h>                 // needed for rmdir, unlink
 #include <sys/stat.h>               // needed for mkdir
 #include <errno.h>                  // needed for errno
@@ -293,10 +294,10 @@ void Directory::copy (const Path& target, Bool overwrite,
 	SymLink(targetFile).remove();
     }
     // Copy the entire directory recursively using the system function cp.
-#if defined(AIPS_CRAY_PGI)
+#if defined(AIPS_CRAY_PGI) || defined(AIPS_LINUX)
     // On the Cray XT3 the system call is not supported, so we have to
-    // do it ourselves.
-    copyRecursive (targetName.expandedName());
+    // do it ourselves. On Linux it is done to use fast file copies.
+    copyRecursive (targetName.expandedName(), setUserWritePermission);
 #else
     String command("cp -r '");
     command += itsFile.path().expandedName() + "' '" +
@@ -315,23 +316,56 @@ void Directory::copy (const Path& target, Bool overwrite,
 #endif
 }
 
-void Directory::copyRecursive (const String& target) const
+void Directory::copyRecursive (const String& target,
+                               Bool setUserWritePermission) const
 {
     // First create the directory.
     Directory dir(target);
     dir.create (True);
-    // Now loop over all files and copy.
+    // Now loop over all files and copy. Subdirectories and symlinks are
+    // done directly; the regular files are copied afterwards.
+    std::vector<String> fileNames;
+    std::vector<String> outNames;
     DirectoryIterator iter(*this);
     while (! iter.pastEnd()) {
         File file = iter.file();
 	String outName = target + '/' + file.path().baseName();
-	if (file.isDirectory (False)) {
-	    Directory(file).copyRecursive (outName);
+	if (file.isSymLink()) {
+	    SymLink(outName).create (SymLink(file).readSymLink());
+	} else if (file.isDirectory (False)) {
+	    Directory(file).copyRecursive (outName, setUserWritePermission);
 	} else {
-	    RegularFile::manualCopy (file.path().originalName(), outName);
+	    fileNames.push_back (file.path().originalName());
+	    outNames.push_back (outName);
 	}
 	iter++;
     }
+    // Copy the files in parallel, because copying (large) files in parallel
+    // is faster on most file systems.
+    String errMsg;
+#pragma omp parallel for schedule(dynamic)
+    for (Int i=0; i<Int(fileNames.size()); ++i) {
+        try {
+	    RegularFile::manualCopy (fileNames[i], outNames[i]);
+	    if (setUserWritePermission) {
+	        File result(outNames[i]);
+		if (! result.isWritable()) {
+		    result.setPermissions (result.readPermissions() | 0200);
+		}
+	    }
+	} catch (const std::exception& x) {
+#pragma omp critical(Directory_copyRecursive)
+	    {
+	        if (errMsg.empty()) {
+		    errMsg = x.what();
+		}
+	    }
+	}
+    }
+    if (! errMsg.empty()) {
+        throw AipsError ("Directory::copy of " + itsFile.path().originalName()
+			 + " failed: " + errMsg);
+    }
 }
 
 void Directory::move (const Path& target, Bool overwrite)
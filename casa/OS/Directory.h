@@ -179,8 +179,13 @@ public:
 
     // Copy a directory recursively in a manual way.
     // This is used in a copy using the system command is not possible
-    // (like on the Cray XT3).
-    void copyRecursive (const String& target) const;
+    // (like on the Cray XT3). On Linux it is used instead of cp, because
+    // it copies the files in a directory in parallel (if OpenMP is used)
+    // using <src>RegularFile::manualCopy</src>, which clones a file or
+    // lets the kernel copy it if possible. Symbolic links are copied as
+    // such.
+    void copyRecursive (const String& target,
+                        Bool setUserWritePermission = False) const;
 
     // Move the directory to the target path using the system command mv.
     // If the target already exists (as a file, directory or symlink),
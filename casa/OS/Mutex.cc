@@ -32,6 +32,8 @@
 //# Define a macro to cast the void* to pthread_mutex_t*.
 #define ITSMUTEX \
   (static_cast<pthread_mutex_t*>(itsMutex))
+#define ITSCOND \
+  (static_cast<pthread_cond_t*>(itsCond))
 
 namespace casacore {
 
@@ -113,6 +115,39 @@ namespace casacore {
     }
   }
 
+  Condition::Condition()
+  {
+    itsCond = new pthread_cond_t;
+    int error = pthread_cond_init (ITSCOND, 0);
+    if (error != 0) throw SystemCallError ("pthread_cond_init", error);
+  }
+
+  Condition::~Condition()
+  {
+    int error = pthread_cond_destroy (ITSCOND);
+    if (error != 0) throw SystemCallError ("pthread_cond_destroy", error);
+    delete ITSCOND;
+  }
+
+  void Condition::wait (Mutex& mutex)
+  {
+    int error = pthread_cond_wait (ITSCOND,
+                                   static_cast<pthread_mutex_t*>(mutex.itsMutex));
+    if (error != 0) throw SystemCallError ("pthread_cond_wait", error);
+  }
+
+  void Condition::signal()
+  {
+    int error = pthread_cond_signal (ITSCOND);
+    if (error != 0) throw SystemCallError ("pthread_cond_signal", error);
+  }
+
+  void Condition::broadcast()
+  {
+    int error = pthread_cond_broadcast (ITSCOND);
+    if (error != 0) throw SystemCallError ("pthread_cond_broadcast", error);
+  }
+
 #else
 
   Mutex::Mutex (Mutex::Type)
@@ -126,6 +161,17 @@ namespace casacore {
   Bool Mutex::trylock()
   { return True; }
 
+  Condition::Condition()
+    : itsCond(0) {}
+  Condition::~Condition()
+  {}
+  void Condition::wait (Mutex&)
+  {}
+  void Condition::signal()
+  {}
+  void Condition::broadcast()
+  {}
+
 #endif
 
 
@@ -48,6 +48,7 @@ namespace casacore {
 
   class Mutex
   {
+    friend class Condition;
   public:
     // Define the type of mutex.
     // (see phtread_mutexattr_settype for their meaning).
@@ -116,6 +117,62 @@ namespace casacore {
   };
 
 
+  // <summary>Wrapper around a pthreads condition variable</summary>
+  // <use visibility=export>
+  //
+  // <reviewed reviewer="" date="" tests="tMutex" demos="">
+  // </reviewed>
+  //
+  // <synopsis>
+  // This class is a wrapper around a pthreads condition variable.
+  // A thread can wait on it until another thread signals that the state
+  // guarded by the associated mutex has changed. Because a wait can end
+  // spuriously, it should be done in a loop testing the state.
+  // <br>If casacore is built without thread support (USE_THREADS), all
+  // functions are no-ops, thus a wait returns immediately.
+  // </synopsis>
+  //
+  // <example>
+  // <srcblock>
+  // ScopedMutexLock lock(mutex);
+  // while (nbusy > 0) {
+  //   cond.wait (mutex);
+  // }
+  // </srcblock>
+  // </example>
+
+  class Condition
+  {
+  public:
+    // Create the condition variable.
+    Condition();
+
+    // Destroy the condition variable.
+    ~Condition();
+
+    // Wait until the condition is signalled. The mutex has to be locked
+    // by the caller. It is unlocked while waiting and locked again
+    // before the function returns.
+    void wait (Mutex& mutex);
+
+    // Wake up one of the waiting threads.
+    void signal();
+
+    // Wake up all waiting threads.
+    void broadcast();
+
+  private:
+    // Forbid copy constructor.
+    Condition (const Condition&);
+    // Forbid assignment.
+    Condition& operator= (const Condition&);
+
+    //# Data members
+    //# Use void*, because we cannot forward declare pthread_cond_t.
+    void* itsCond;
+  };
+
+
   // <summary>Thread-safe initialization of global variables</summary>
   // <use visibility=export>
   //
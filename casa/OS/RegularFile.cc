@@ -35,9 +35,16 @@
 
 #include <fcntl.h>                // needed for creat
 #include <unistd.h>               // needed for unlink, etc.
+#include <sys/stat.h>             // needed for fstat, fchmod
+#if defined(AIPS_LINUX)
+#include <sys/ioctl.h>            // needed for ioctl
+#include <sys/syscall.h>          // needed for copy_file_range
+#include <linux/fs.h>             // needed for FICLONE
+#endif
 #include <errno.h>                // needed for errno
 #include <casacore/casa/string.h>          // needed for strerror
 #include <casacore/casa/stdlib.h>          // needed for system
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -147,8 +154,14 @@ void RegularFile::copy (const Path& target, Bool overwrite,
 {
     Path targetName(target);
     checkTarget (targetName, overwrite);
-#if defined(AIPS_CRAY_PGI)
+#if defined(AIPS_CRAY_PGI) || defined(AIPS_LINUX)
     manualCopy (itsFile.path().expandedName(), targetName.expandedName());
+    if (setUserWritePermission) {
+	File result(targetName.expandedName());
+	if (! result.isWritable()) {
+	    result.setPermissions (result.readPermissions() | 0200);
+	}
+    }
 #else
     // This function uses the system function cp.	    
     String call("cp '");
@@ -170,15 +183,41 @@ void RegularFile::manualCopy (const String& source, const String& target)
     int outfd (FiledesIO::create (target.chars()));
     FiledesIO in (infd, source);
     FiledesIO out (outfd, target);
-    char buf[32768];
-    int nrc = in.read (sizeof(buf), buf, False);
-    while (true) {
-        AlwaysAssert (nrc >= 0, AipsError);
-	out.write (nrc, buf);
-	if (nrc != sizeof(buf)) {
-	    break;
-	}
-	nrc = in.read (sizeof(buf), buf, False);
+    struct stat sbuf;
+    if (fstat (infd, &sbuf) == 0) {
+        fchmod (outfd, sbuf.st_mode & 07777);
+    }
+    Bool done = False;
+#if defined(AIPS_LINUX)
+# if defined(FICLONE)
+    // Clone the file if the file system supports it.
+    done = (ioctl (outfd, FICLONE, infd) == 0);
+# endif
+# if defined(SYS_copy_file_range)
+    // Let the kernel copy the data. It fails if not supported (e.g. when
+    // copying between file systems on older kernels); the remaining data
+    // are copied in the normal way.
+    while (!done) {
+        ssize_t nrc = syscall (SYS_copy_file_range, infd, (loff_t*)0,
+                               outfd, (loff_t*)0, size_t(1) << 30, 0u);
+        if (nrc <= 0) {
+            done = (nrc == 0);
+            break;
+        }
+    }
+# endif
+#endif
+    if (!done) {
+        std::vector<char> buf(1048576);
+        Int64 nrc = in.read (buf.size(), &(buf[0]), False);
+        while (true) {
+            AlwaysAssert (nrc >= 0, AipsError);
+            out.write (nrc, &(buf[0]));
+            if (nrc != Int64(buf.size())) {
+                break;
+            }
+            nrc = in.read (buf.size(), &(buf[0]), False);
+        }
     }
     FiledesIO::close (infd);
     FiledesIO::close (outfd);
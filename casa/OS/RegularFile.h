@@ -153,8 +153,12 @@ public:
 	       Bool setUserWritePermission = True) const;
     // </group>
 
-    // Copy the file manually in case the cp command cannot be used.
-    // (like on the Cray XT3).
+    // Copy the file manually in case the cp command cannot be used
+    // (like on the Cray XT3). On Linux it is used instead of cp.
+    // It first tries to clone the file (reflink) which shares the data
+    // blocks on file systems like Btrfs and XFS. Otherwise the kernel copies
+    // the data using <src>copy_file_range</src> (without copying to user
+    // space) if possible. The target gets the permissions of the source.
     static void manualCopy (const String& source, const String& target);
 
     // Move the file to the target path using the system command mv.
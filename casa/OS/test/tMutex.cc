@@ -30,6 +30,9 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions.h>
 #include <casacore/casa/iostream.h>
+#ifdef USE_THREADS
+#include <pthread.h>
+#endif
 
 using namespace casacore;
 
@@ -183,6 +186,47 @@ void testMutexedInitParallel()
   AlwaysAssertExit (count==1);
 }
 
+#ifdef USE_THREADS
+// State shared by the threads testing a Condition.
+struct CondState
+{
+  Mutex     mutex;
+  Condition cond;
+  int       value;
+};
+
+void* testConditionFunc (void* arg)
+{
+  CondState* state = static_cast<CondState*>(arg);
+  for (int i=0; i<3; ++i) {
+    ScopedMutexLock lock(state->mutex);
+    state->value++;
+    state->cond.broadcast();
+  }
+  return 0;
+}
+
+void testCondition()
+{
+  cout << "Test Condition ..." << endl;
+  CondState state;
+  state.value = 0;
+  pthread_t thread;
+  AlwaysAssertExit (pthread_create (&thread, 0, testConditionFunc,
+                                    &state) == 0);
+  {
+    ScopedMutexLock lock(state.mutex);
+    while (state.value < 3) {
+      state.cond.wait (state.mutex);
+    }
+    AlwaysAssertExit (state.value == 3);
+  }
+  AlwaysAssertExit (pthread_join (thread, 0) == 0);
+  // A signal without waiting threads has no effect.
+  state.cond.signal();
+}
+#endif
+
 
 int main()
 {
@@ -193,6 +237,7 @@ int main()
     testRecursive();
     testNormal();
     testMutexedInitParallel();
+    testCondition();
 #endif
   } catch (AipsError& x) {
     cout << "Caught an exception: " << x.getMesg() << endl;
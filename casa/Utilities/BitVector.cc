@@ -27,6 +27,7 @@
 
 #include <casacore/casa/Utilities/BitVector.h>
 #include <casacore/casa/iostream.h>
+#include <bitset>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -250,6 +251,21 @@ Bool BitVector::operator== (const BitVector& that) const
     return True;
 }
 
+uInt BitVector::count() const
+{
+    uInt nfull = size_p / WORDSIZE;
+    uInt n = 0;
+    for (uInt i=0; i<nfull; i++) {
+	n += std::bitset<WORDSIZE>(bits_p[i]).count();
+    }
+    //# Ignore the unused bits in the last word.
+    uInt nrem = size_p - nfull*WORDSIZE;
+    if (nrem > 0) {
+	n += std::bitset<WORDSIZE>(bits_p[nfull] & ((1u << nrem) - 1)).count();
+    }
+    return n;
+}
+
 Bool BitVector::operator!= (const BitVector& that) const
 {
     if (*this == that) {
@@ -193,6 +193,11 @@ public:
     // An exception is thrown if the lengths of the vectors differ.
     Bool operator== (const BitVector& that) const;
 
+    // Return the number of bits set.
+    // It counts the bits per word, so it is much faster than testing
+    // each bit.
+    uInt count() const;
+
     // Returns True if a bit differs.
     // An exception is thrown if the lengths of the vectors differ.
     Bool operator!= (const BitVector& that) const;
@@ -217,6 +222,19 @@ public:
     void copy (uInt thisStart, uInt length, const BitVector& that,
 	       uInt thatStart);
 
+    // Get a pointer to the words holding the bits.
+    // Bit <src>i</src> is bit <src>i%WORDSIZE</src> of word
+    // <src>i/WORDSIZE</src>. The unused bits in the last word can have
+    // any value.
+    // <br>It can be used for fast bulk operations; the pointer is
+    // invalidated by a resize.
+    // <group>
+    uInt* storage()
+      { return bits_p.storage(); }
+    const uInt* storage() const
+      { return bits_p.storage(); }
+    // </group>
+
     // Write a representation of the bit vector (a list of
     // <em>zeros</em> and <em>ones</em> enclosed in square
     // parentheses) to ostream.
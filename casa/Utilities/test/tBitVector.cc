@@ -89,6 +89,9 @@ void doIt()
     cout << "b1 = " << b1;
     b1.resize (35, True, False);             // resize without copy
     cout << "b1 = " << b1;
+    cout << "count b1 = " << b1.count() << endl;
+    cout << "count ~b1 = " << (~b1).count() << endl;
+    cout << "count c = " << c.count() << endl;
 
     b1.resize (70, True, False);             // resize without copy
     b1.copy (30, 23, c, 8);
@@ -38,6 +38,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 typedef long long Int64;
 typedef unsigned long long uInt64;
 
+// The type used for row numbers and row counts in tables.
+typedef uInt64 rownr_t;
+
 //# All FITS code seems to assume longs are 4 bytes. Currently
 //# this corresponds to an "int" on all useful platforms.
 typedef int FitsLong;
@@ -110,5 +110,17 @@ namespace casacore {
   {
     itsEngine->getNewUVW (False, rowNr, data);
   }
+  void UVWJ2000Column::getArrayColumn (Array<Double>& data)
+  {
+    uInt nrow = data.shape()[data.ndim() - 1];
+    if (nrow > 0) {
+      itsEngine->getNewUVW (False, RefRows(0, nrow-1), data);
+    }
+  }
+  void UVWJ2000Column::getArrayColumnCells (const RefRows& rownrs,
+                                            Array<Double>& data)
+  {
+    itsEngine->getNewUVW (False, rownrs, data);
+  }
 
 } //# end namespace
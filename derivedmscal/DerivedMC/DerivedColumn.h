@@ -158,6 +158,13 @@ namespace casacore {
     virtual IPosition shape (uInt rownr);
     virtual Bool isShapeDefined (uInt rownr);
     virtual void getArray (uInt rowNr, Array<Double>& data);
+    // Get the UVW of all or some rows in one call, so they are calculated
+    // per time slot instead of per row.
+    // <group>
+    virtual void getArrayColumn (Array<Double>& data);
+    virtual void getArrayColumnCells (const RefRows& rownrs,
+                                      Array<Double>& data);
+    // </group>
   private:
     MSCalEngine* itsEngine;
   };
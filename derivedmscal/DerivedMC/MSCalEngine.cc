@@ -35,12 +35,16 @@
 #include <casacore/measures/Measures/MCBaseline.h>
 #include <casacore/measures/Measures/Muvw.h>
 #include <casacore/measures/Measures/MCuvw.h>
+#include <casacore/measures/Measures/MeasEngine.h>
 #include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
 #include <casacore/measures/TableMeasures/ArrayMeasColumn.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/OS/Path.h>
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <casacore/casa/OS/OMP.h>
+#include <algorithm>
 
 
 namespace casacore {
@@ -145,6 +149,160 @@ void MSCalEngine::getNewUVW (Bool asApp, uInt rownr, Array<double>& data)
   }
 }
 
+namespace {
+  // The rows of a time slot (with equal time, field and CAL_DESC_ID)
+  // and the data needed to calculate their UVW.
+  struct UvwSlot
+  {
+    uInt       start;      //# first row (index in the row vector)
+    uInt       end;        //# last row + 1
+    Int        calInx;
+    MEpoch     epoch;
+    MDirection dirJ2000;
+  };
+
+  // The buffers used by a thread to calculate the UVW of the antennas
+  // in a time slot.
+  struct UvwBuffer
+  {
+    vector<Double> itsAntUvw;     //# UVW per antenna
+    vector<Bool>   itsAntUsed;    //# is antenna used in the time slot?
+  };
+
+  // Calculate the UVW of the rows in a time slot using the given frame
+  // and converters of a thread. The APP converter is only used if asApp.
+  // First the UVW of the antennas used in the slot are calculated.
+  // The UVW of a baseline is the difference of its antenna UVWs.
+  void fillSlotUvw (MeasFrame& frame, MBaseline::Convert& blToJ2000,
+                    Muvw::Convert& j2000ToApp, UvwBuffer& buf,
+                    Bool asApp, const UvwSlot& slot,
+                    const vector<MBaseline>& antMB,
+                    const Int* ant1, const Int* ant2, Double* uvw)
+  {
+    frame.resetEpoch (slot.epoch);
+    frame.resetDirection (slot.dirJ2000);
+    uInt nant = antMB.size();
+    buf.itsAntUvw.resize (3*nant);
+    buf.itsAntUsed.assign (nant, False);
+    for (uInt i=slot.start; i<slot.end; ++i) {
+      buf.itsAntUsed[ant1[i]] = True;
+      buf.itsAntUsed[ant2[i]] = True;
+    }
+    const MVDirection& dir = slot.dirJ2000.getValue();
+    for (uInt ant=0; ant<nant; ++ant) {
+      if (buf.itsAntUsed[ant]) {
+        blToJ2000.setModel (antMB[ant]);
+        MVuvw auvw (blToJ2000().getValue(), dir);
+        if (asApp) {
+          auvw = j2000ToApp(auvw).getValue();
+        }
+        const Vector<Double>& vec = auvw.getValue();
+        std::copy (vec.data(), vec.data()+3, &(buf.itsAntUvw[3*ant]));
+      }
+    }
+    const Double* antUvw = &(buf.itsAntUvw[0]);
+    for (uInt i=slot.start; i<slot.end; ++i) {
+      const Double* u1 = antUvw + 3*ant1[i];
+      const Double* u2 = antUvw + 3*ant2[i];
+      Double* d = uvw + 3*i;
+      d[0] = u2[0] - u1[0];
+      d[1] = u2[1] - u1[1];
+      d[2] = u2[2] - u1[2];
+    }
+  }
+}
+
+void MSCalEngine::getNewUVW (Bool asApp, const RefRows& rownrs,
+                             Array<Double>& data, uInt nthreads)
+{
+  Vector<uInt> rows (rownrs.convert());
+  uInt nrow = rows.size();
+  IPosition shape(2, 3, nrow);
+  if (! data.shape().isEqual (shape)) {
+    data.resize (shape);
+  }
+  if (nrow == 0) {
+    return;
+  }
+  // Initialize if not done yet, so the columns can be read.
+  setData (-1, rows[0], True);
+  Vector<Int> ant1 (itsAntCol[0].getColumnCells (rownrs));
+  Vector<Int> ant2 (itsAntCol[1].getColumnCells (rownrs));
+  Vector<Double> times (itsTimeCol.getColumnCells (rownrs));
+  Vector<Int> fieldIds (nrow, 0);
+  if (itsReadFieldDir) {
+    fieldIds = itsFieldCol.getColumnCells (rownrs);
+  }
+  Vector<Int> calIds (nrow, 0);
+  if (! itsCalCol.isNull()) {
+    calIds = itsCalCol.getColumnCells (rownrs);
+  }
+  // Divide the rows into time slots. Set the data of the first row of a
+  // slot to get its epoch and field direction in J2000.
+  vector<UvwSlot> slots;
+  uInt start = 0;
+  for (uInt i=1; i<=nrow; ++i) {
+    if (i == nrow  ||  times[i] != times[start]  ||
+        fieldIds[i] != fieldIds[start]  ||  calIds[i] != calIds[start]) {
+      setData (-1, rows[start], True);
+      Int nant = itsAntMB[itsLastCalInx].size();
+      for (uInt j=start; j<i; ++j) {
+        AlwaysAssert (ant1[j] >= 0  &&  ant1[j] < nant  &&
+                      ant2[j] >= 0  &&  ant2[j] < nant, AipsError);
+      }
+      UvwSlot slot;
+      slot.start    = start;
+      slot.end      = i;
+      slot.calInx   = itsLastCalInx;
+      slot.epoch    = itsTimeMeasCol(rows[start]);
+      slot.dirJ2000 = itsLastDirJ2000;
+      slots.push_back (slot);
+      start = i;
+    }
+  }
+  if (nthreads == 0) {
+    nthreads = OMP::maxThreads();
+  }
+  nthreads = std::max (1u, std::min (nthreads, uInt(slots.size())));
+  // Each thread uses its own copy of the frame and its own converters,
+  // because they keep state. The APP converter uses the frame of the
+  // baseline converter of its thread.
+  MeasFrame frame (MEpoch(), itsArrayPos, MDirection());
+  MeasEngine<MBaseline> blEngine (MBaseline::ITRF, MBaseline::J2000,
+                                  frame, nthreads);
+  vector<CountedPtr<Muvw::Convert> > appConvs(nthreads);
+  vector<UvwBuffer> bufs(nthreads);
+  for (uInt i=0; i<nthreads; ++i) {
+    appConvs[i] = new Muvw::Convert (Muvw(MVuvw(), Muvw::J2000),
+                                     Muvw::Ref(Muvw::APP, blEngine.frame(i)));
+  }
+  Bool deleteIt;
+  Double* uvw = data.getStorage (deleteIt);
+  String error;
+  Bool failed = False;
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+  for (Int64 i=0; i<Int64(slots.size()); ++i) {
+    try {
+      uInt thread = OMP::threadNum();
+      fillSlotUvw (blEngine.frame(thread), blEngine.converter(thread),
+                   *appConvs[thread], bufs[thread], asApp, slots[i],
+                   itsAntMB[slots[i].calInx], ant1.data(), ant2.data(), uvw);
+    } catch (std::exception& x) {
+#pragma omp critical(MSCalEngine_getNewUVW)
+      {
+        if (!failed) {
+          error  = x.what();
+          failed = True;
+        }
+      }
+    }
+  }
+  data.putStorage (uvw, deleteIt);
+  if (failed) {
+    throw AipsError ("MSCalEngine::getNewUVW: " + error);
+  }
+}
+
 double MSCalEngine::getDelay (Int antnr, uInt rownr)
 {
   setData (-1, rownr, True);
@@ -32,6 +32,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/measures/Measures/MDirection.h>
 #include <casacore/measures/Measures/MPosition.h>
 #include <casacore/measures/Measures/MEpoch.h>
@@ -158,6 +159,20 @@ public:
   // Get the UVW in J2000 or APP for the given row.
   void getNewUVW (Bool asApp, uInt rownr, Array<Double>&);
 
+  // Get the UVW in J2000 or APP for the given rows as an array
+  // with shape [3,nrow].
+  // <br>The rows are divided in time slots (consecutive rows with the same
+  // time and field). The UVW of each antenna is calculated once per time
+  // slot, whereafter the UVW of all baselines in the slot are formed in a
+  // single loop. Thus the rows should be in time order (as in an MS)
+  // to benefit from it.
+  // <br>By default the time slots are processed serially. They can be
+  // processed in parallel by <src>nthreads</src> threads (0 means the
+  // maximum number of OpenMP threads). Each thread uses its own frame
+  // and converters (see <linkto class=MeasEngine>MeasEngine</linkto>).
+  void getNewUVW (Bool asApp, const RefRows& rownrs, Array<Double>&,
+                  uInt nthreads=1);
+
   // Get the delay for the given row.
   double getDelay (Int antnr, uInt rownr);
 
@@ -37,6 +37,7 @@
 #include <casacore/tables/Tables/ArrColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
 #include <casacore/casa/OS/Timer.h>
@@ -201,7 +202,7 @@ int main(int argc, char* argv[])
     mdv.setObservatoryPosition (arrayPos);
     // Now loop through quite some rows and compare result of DerivedMSCal
     // with MSDerivedValues.
-    uInt nr = std::max(tab.nrow(), 1000u);
+    uInt nr = std::max(tab.nrow(), rownr_t(1000));
     Int lastFldId = -1;
     for (uInt i=0; i<nr; ++i) {
       Int fldId = fld(i);
@@ -245,6 +246,17 @@ int main(int argc, char* argv[])
       uvwJ2000(i);
     }
     timer.show ("DataMan uvw");
+    // Getting the UVW of all or some rows at once must give the same result.
+    timer.mark();
+    Array<Double> uvwAll = uvwJ2000.getColumn();
+    timer.show ("DataMan uvw column");
+    Array<Double> uvwSome = uvwJ2000.getColumnCells (RefRows(0, tab.nrow()-1, 3));
+    for (uInt i=0; i<tab.nrow(); ++i) {
+      AlwaysAssertExit (allNearAbs (uvwAll[i], uvwJ2000(i), 1e-6));
+      if (i%3 == 0) {
+        AlwaysAssertExit (allNearAbs (uvwSome[i/3], uvwJ2000(i), 1e-6));
+      }
+    }
     if (! uvw.isNull()) {
       timer.mark();
       for (uInt i=0; i<tab.nrow(); ++i) {
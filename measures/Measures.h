@@ -775,6 +775,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //	(static) class to converse with the IERS database(s)
 //  <li> <linkto class=MeasJPL>MeasJPL</linkto>:
 //	(static) class to converse with the JPL DE database(s)
+//  <li> <linkto class=MeasPrecomputed>MeasPrecomputed</linkto>:
+//	tables of time dependent quantities precomputed for a time range
 //  <li> <linkto class=Precession>Precession</linkto>:
 //	 all precession related calculations
 //  <li> <linkto class=Nutation>Nutation</linkto>
@@ -786,6 +788,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //  <li> <linkto class=RotMatrix>RotMatrix</linkto>: a 3-D rotation matrix
 // </ul>
 // <p>
+//
+// <h4>Thread safety</h4>
+// The static tables used in the conversions (e.g. in MeasTable, MeasIERS
+// and MeasJPL) are initialized once in a thread-safe way. However,
+// converters, frames and references keep mutable caches, so they
+// cannot be used by multiple threads at the same time. The class
+// <linkto class=MeasEngine>MeasEngine</linkto> holds a converter and a
+// copy of the frame per thread, sharing the precomputed tables of the frame.
 
 // </synopsis> 
 //
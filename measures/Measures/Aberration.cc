@@ -30,6 +30,7 @@
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/measures/Measures/MeasTable.h>
+#include <casacore/measures/Measures/MeasPrecomputed.h>
 #include <casacore/casa/System/AipsrcValue.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -38,8 +39,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 const Double Aberration::INTV = 0.04;
 
 //# Static data
-uInt Aberration::interval_reg = 0;
-uInt Aberration::usejpl_reg = 0;
+Double Aberration::theirInterval = Aberration::INTV;
+Bool Aberration::theirUsejpl = False;
+MutexedInit Aberration::theirMutexedInit (Aberration::doInit);
 
 //# Constructors
 Aberration::Aberration() : method(Aberration::STANDARD), lres(0) {
@@ -83,6 +85,7 @@ void Aberration::copy(const Aberration &other) {
     for (Int j=0; j<4; j++) {
 	result[j] = other.result[j];
     }
+    precomputed = other.precomputed;
 }
 
 //# Destructor
@@ -94,7 +97,7 @@ const MVPosition &Aberration::operator()(Double epoch) {
     calcAber(epoch);
     Double dt = epoch - checkEpoch;
     Double fac = 1;
-    if (AipsrcValue<Bool>::get(Aberration::usejpl_reg) && method != B1950) {
+    if (Aberration::theirUsejpl && method != B1950) {
       fac /= MeasTable::Planetary(MeasTable::CAU);
     }
     lres++; lres %= 4;
@@ -110,7 +113,7 @@ const MVPosition &Aberration::derivative(Double epoch) {
     calcAber(epoch);
     lres++; lres %= 4;
     Double fac = 1;
-    if (AipsrcValue<Bool>::get(Aberration::usejpl_reg) && method != B1950) {
+    if (Aberration::theirUsejpl && method != B1950) {
       fac /=  MeasTable::Planetary(MeasTable::CAU);
     }
     for (Int i=0; i<3; i++) {
@@ -121,30 +124,42 @@ const MVPosition &Aberration::derivative(Double epoch) {
 
 void Aberration::fill() {
   // Get the interpolation interval
-  if (!Aberration::interval_reg) {
-    interval_reg = 
-      AipsrcValue<Double>::registerRC(String("measures.aberration.d_interval"),
-				      Unit("d"), Unit("d"),
-				      Aberration::INTV);
-  }
-  if (!Aberration::usejpl_reg) {
-    usejpl_reg =
-      AipsrcValue<Bool>::registerRC(String("measures.aberration.b_usejpl"),
-				    False);
-  }
+  theirMutexedInit.exec();
   checkEpoch = 1e30;
 }
 
+void Aberration::doInit(void*) {
+  theirInterval = AipsrcValue<Double>::get
+    (AipsrcValue<Double>::registerRC(String("measures.aberration.d_interval"),
+				     Unit("d"), Unit("d"),
+				     Aberration::INTV));
+  theirUsejpl = AipsrcValue<Bool>::get
+    (AipsrcValue<Bool>::registerRC(String("measures.aberration.b_usejpl"),
+				   False));
+}
+
 void Aberration::refresh() {
     checkEpoch = 1e30;
 }
 
+void Aberration::setPrecomputed(const CountedPtr<MeasPrecomputed> &tables) {
+    if (tables.get() != precomputed.get()) {
+	precomputed = tables;
+	refresh();
+    }
+}
+
 void Aberration::calcAber(Double t) {
   if (!nearAbs(t, checkEpoch,
-	       AipsrcValue<Double>::get(Aberration::interval_reg)) ||
-      (AipsrcValue<Bool>::get(Aberration::usejpl_reg) &&
+	       Aberration::theirInterval) ||
+      (Aberration::theirUsejpl &&
        method != B1950) ) {
     checkEpoch = t;
+    // Use the precomputed values and derivatives if available
+    if (!precomputed.null() &&
+	precomputed->aberration(method, t, aval, dval)) {
+      return;
+    }
     switch (method) {
     case B1950:
       // Yes, this really should be the time in Julian centuries since January 	 
@@ -203,7 +218,7 @@ void Aberration::calcAber(Double t) {
       break;
       
     default:
-      if (AipsrcValue<Bool>::get(Aberration::usejpl_reg)) {
+      if (Aberration::theirUsejpl) {
 	Vector<Double> mypl =
 	  MeasTable::Planetary(MeasTable::EARTH, checkEpoch);
 	for (i=0; i<3; i++) {
@@ -32,10 +32,15 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Quanta/MVPosition.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <casacore/casa/OS/Mutex.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# Forward Declarations
+class MeasPrecomputed;
+
 // <summary>
 // Aberration class and calculations
 // </summary>
@@ -91,6 +96,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //		or DE405). If using the JPL database, the d_interval (and the
 //		output of derivative()) are irrelevant.
 // </ul>
+// The values are read once, when the first Aberration object is created.
 // </synopsis>
 //
 // <example>
@@ -109,6 +115,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 class Aberration
 {
 public:
+//# Friends
+// The precomputed tables are made from the calculated values
+    friend class MeasPrecomputed;
+
 //# Constants
 // Interval to be used for linear approximation (in days)
     static const Double INTV;
@@ -147,6 +157,10 @@ public:
 // Refresh calculations
     void refresh();
 
+// Use the precomputed tables (if they cover the epoch) instead of
+// calculating the series. An empty pointer means no tables.
+    void setPrecomputed(const CountedPtr<MeasPrecomputed> &tables);
+
 private:
 //# Data menbers
 // Method to be used
@@ -163,16 +177,22 @@ private:
     Int lres;
 // Last calculation
     MVPosition result[4];
+// Precomputed tables (if any)
+    CountedPtr<MeasPrecomputed> precomputed;
 // Interpolation interval
-    static uInt interval_reg;
+    static Double theirInterval;
 // JPL use
-    static uInt usejpl_reg;
+    static Bool theirUsejpl;
+// Read the Aipsrc variables once (thread-safe)
+    static MutexedInit theirMutexedInit;
 
 //# Member functions
 // Copy
     void copy(const Aberration &other);
 // Fill an empty copy
     void fill();
+// Register the Aipsrc variables and read their values
+    static void doInit(void*);
 // Calculate Aberration angles for time t
     void calcAber(Double t);
 };
@@ -31,6 +31,7 @@
 #include <casacore/measures/Measures/MeasFrame.h>
 #include <casacore/measures/Measures/Nutation.h>
 #include <casacore/measures/Measures/MeasTable.h>
+#include <casacore/measures/Measures/MeasPrecomputed.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -132,6 +133,26 @@ void MCEpoch::initConvert(uInt which, MConvertBase &mc) {
   }
 }
 
+// Get the precomputed tables of the frame used in a conversion (if any)
+static CountedPtr<MeasPrecomputed> getPrecomputed(MRBase &inref,
+						  MRBase &outref) {
+  if (!inref.empty() && !inref.getFrame().precomputed().null()) {
+    return inref.getFrame().precomputed();
+  } else if (!outref.empty()) {
+    return outref.getFrame().precomputed();
+  }
+  return CountedPtr<MeasPrecomputed>();
+}
+
+// Get dUT1 from the precomputed tables if possible
+static Double getDUT1(const CountedPtr<MeasPrecomputed> &tables, Double utc) {
+  Double res;
+  if (tables.null() || !tables->dUT1(utc, res)) {
+    res = MeasTable::dUT1(utc);
+  }
+  return res;
+}
+
 void MCEpoch::doConvert(MeasValue &in,
 			MRBase &inref,
 			MRBase &outref,
@@ -146,6 +167,7 @@ void MCEpoch::doConvert(MVEpoch &in,
 			const MConvertBase &mc) {
   static MVEpoch mve6713(6713.);
   Double locLong, eqox, ut, tt, xx;
+  CountedPtr<MeasPrecomputed> tables(getPrecomputed(inref, outref));
   
   for (Int i=0; i<mc.nMethod(); i++) {
     
@@ -188,7 +210,7 @@ void MCEpoch::doConvert(MVEpoch &in,
 	do {
 	  MVEpoch xe(in);
 	  ut = xe.get();
-	  xe -= MeasTable::dUT1(xe.get())/MeasData::SECinDAY;
+	  xe -= getDUT1(tables, xe.get())/MeasData::SECinDAY;
 	  xe += MeasTable::dUTC(xe.get())/MeasData::SECinDAY;
 	  xe += MeasTable::dTAI(xe.get())/MeasData::SECinDAY;
 	  xe += MeasTable::GMST00(ut, xe.get())/C::_2pi;
@@ -204,7 +226,7 @@ void MCEpoch::doConvert(MVEpoch &in,
     case UT1_GMST1: {
       ut = in.get();
       if (MeasTable::useIAU2000()) {
-	in -= MeasTable::dUT1(in.get())/MeasData::SECinDAY;
+	in -= getDUT1(tables, in.get())/MeasData::SECinDAY;
 	in += MeasTable::dUTC(in.get())/MeasData::SECinDAY;
 	in += MeasTable::dTAI(in.get())/MeasData::SECinDAY;
 	in += MeasTable::GMST00(ut, in.get())/C::_2pi;
@@ -221,6 +243,7 @@ void MCEpoch::doConvert(MVEpoch &in,
       ut += MeasTable::GMUT0(ut)*MeasData::JDCEN/MeasData::SECinDAY;
       ut -= 6713.;
       // Equation of equinoxes
+      NUTATTO->setPrecomputed(tables);
       eqox = NUTATTO->eqox(ut);
       in -= eqox/C::circle;
       // GMST1 to UT1
@@ -236,17 +259,18 @@ void MCEpoch::doConvert(MVEpoch &in,
       in += MeasTable::GMST0(ut)/MeasData::SECinDAY;
       in += mve6713;
       // Equation of equinoxes
+      NUTATFROM->setPrecomputed(tables);
       eqox = NUTATFROM->eqox(ut);
       in += eqox/C::circle;
     }
       break;
       
     case UT1_UTC:
-      in -= MeasTable::dUT1(in.get())/MeasData::SECinDAY;
+      in -= getDUT1(tables, in.get())/MeasData::SECinDAY;
       break;
       
     case UTC_UT1:
-      in += MeasTable::dUT1(in.get())/MeasData::SECinDAY;
+      in += getDUT1(tables, in.get())/MeasData::SECinDAY;
       break;
       
     case UT1_UT2:
@@ -482,13 +482,10 @@ Bool MCFrame::getComet(MVPosition &tdb) {
 
 void MCFrame::makeEpoch() {
   static const MEpoch::Ref REFTDB = MEpoch::Ref(MEpoch::TDB);
-  static const MEpoch::Ref REFUT1 = MEpoch::Ref(MEpoch::UT1);
   static const MEpoch::Ref REFTT  = MEpoch::Ref(MEpoch::TT);
   delete static_cast<MEpoch::Convert *>(epConvTDB);
-  delete static_cast<MEpoch::Convert *>(epConvUT1);
   delete static_cast<MEpoch::Convert *>(epConvTT);
   epConvTDB = new MEpoch::Convert(*(myf.epoch()), REFTDB);
-  epConvUT1 = new MEpoch::Convert(*(myf.epoch()), REFUT1);
   epConvTT  = new MEpoch::Convert(*(myf.epoch()), REFTT);
   uInt locker = 0;			// locking assurance
   if (epTDBp) {
@@ -501,6 +498,10 @@ void MCFrame::makeEpoch() {
     delete epTTp; epTTp = 0;
   }
   myf.lock(locker);
+  // UT1 and LAST use the frame (for its precomputed tables and position)
+  delete static_cast<MEpoch::Convert *>(epConvUT1);
+  epConvUT1 = new MEpoch::Convert(*(myf.epoch()),
+				  MEpoch::Ref(MEpoch::UT1, this->myf));
   if (epConvLAST) {
     delete static_cast<MEpoch::Convert *>(epConvLAST);
     epConvLAST = 0;
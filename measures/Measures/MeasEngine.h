@@ -0,0 +1,156 @@
+//# MeasEngine.h: Per-thread conversion engines for Measures
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef MEASURES_MEASENGINE_H
+#define MEASURES_MEASENGINE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/measures/Measures/MeasConvert.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/OS/OMP.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Per-thread conversion engines for Measures
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tMeasEngine">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=MeasConvert>MeasConvert</linkto>
+//   <li> <linkto class=MeasFrame>MeasFrame</linkto>
+//   <li> <linkto class=MeasPrecomputed>MeasPrecomputed</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A <linkto class=MeasConvert>MeasConvert</linkto> object and the
+// <linkto class=MeasFrame>MeasFrame</linkto> it uses cache the state of
+// the last conversion (e.g., the nutation and the sidereal time of the
+// frame epoch). Hence they cannot be used by multiple threads at the same
+// time. The static tables used by the conversions (in
+// <linkto class=MeasTable>MeasTable</linkto>,
+// <linkto class=MeasIERS>MeasIERS</linkto>, and
+// <linkto class=MeasJPL>MeasJPL</linkto>) are initialized once in a
+// thread-safe way and are not changed thereafter. Note that this requires
+// casacore to be built with thread support (USE_THREADS, which is implied
+// by USE_OPENMP), otherwise its mutexes are no-ops.
+// <p>
+// MeasEngine holds a converter per thread. Each converter uses its own
+// deep copy (see <src>MeasFrame::copy</src>) of the frame given at
+// construction, so the threads do not share any mutable state.
+// The precomputed tables of the frame (see <src>MeasFrame::precompute</src>)
+// are immutable and shared by all copies, so the expensive time dependent
+// quantities are calculated only once. It is advised to precompute them,
+// because it also avoids that the threads serialize on the global lock
+// guarding the cached IERS dUT1 value.
+// <p>
+// The engines have to be created before the parallel section. Thereafter
+// thread <src>i</src> can reset the values of <src>frame(i)</src> and
+// use <src>converter(i)</src>. The thread number is usually given by
+// <src>OMP::threadNum()</src>, which is used by <src>operator()</src>.
+// Note that the frame measures must not be shared by the threads, thus
+// should not have a frame themselves.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   MeasFrame frame(MEpoch(Quantity(55000., "d"), MEpoch::UTC), obsPos);
+//   frame.precompute (MVEpoch(55000.), MVEpoch(55001.));
+//   MeasEngine<MDirection> engine(MDirection::J2000, MDirection::AZEL, frame);
+//   #pragma omp parallel for
+//   for (Int i=0; i<nrow; ++i) {
+//     uInt thread = OMP::threadNum();
+//     engine.frame(thread).resetEpoch (times[i]);
+//     azel[i] = engine.converter(thread)(dirs[i]).getValue();
+//   }
+// </srcblock>
+// </example>
+
+// <motivation>
+// Derived columns, UVW calculation and flagging on elevation loop over
+// many rows and can be done in parallel, but the conversions could only
+// be used by a single thread at a time.
+// </motivation>
+
+// <templating arg=M>
+//  <li> a Measure class (e.g. MDirection)
+// </templating>
+
+template<class M> class MeasEngine
+{
+public:
+  // Create the engines converting from the input to the output type
+  // for the given number of threads (0 means <src>OMP::maxThreads()</src>).
+  // Each engine gets its own copy of the frame.
+  MeasEngine (typename M::Types inType, typename M::Types outType,
+              const MeasFrame& frame, uInt nthread=0);
+
+  // Get the number of engines.
+  uInt nthread() const
+    { return itsFrames.size(); }
+
+  // Get the frame of the given thread (e.g., to reset its epoch).
+  MeasFrame& frame (uInt thread)
+    { DebugAssert (thread < itsFrames.size(), AipsError);
+      return itsFrames[thread]; }
+
+  // Get the converter of the given thread.
+  typename M::Convert& converter (uInt thread)
+    { DebugAssert (thread < itsConverters.size(), AipsError);
+      return *itsConverters[thread]; }
+
+  // Convert a value using the engine of the calling OpenMP thread.
+  const M& operator() (const typename M::MVType& value)
+    { return converter(OMP::threadNum()) (value); }
+
+private:
+  // Forbid copy constructor and assignment.
+  // <group>
+  MeasEngine (const MeasEngine<M>&);
+  MeasEngine<M>& operator= (const MeasEngine<M>&);
+  // </group>
+
+  //# Data members
+  std::vector<MeasFrame> itsFrames;
+  std::vector<CountedPtr<typename M::Convert> > itsConverters;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#ifndef CASACORE_NO_AUTO_TEMPLATES
+#include <casacore/measures/Measures/MeasEngine.tcc>
+#endif //# CASACORE_NO_AUTO_TEMPLATES
+#endif
@@ -0,0 +1,58 @@
+//# MeasEngine.tcc: Per-thread conversion engines for Measures
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef MEASURES_MEASENGINE_TCC
+#define MEASURES_MEASENGINE_TCC
+
+//# Includes
+#include <casacore/measures/Measures/MeasEngine.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+template<class M>
+MeasEngine<M>::MeasEngine (typename M::Types inType,
+                           typename M::Types outType,
+                           const MeasFrame& frame, uInt nthread)
+{
+  if (nthread == 0) {
+    nthread = OMP::maxThreads();
+  }
+  itsFrames.reserve (nthread);
+  itsConverters.reserve (nthread);
+  for (uInt i=0; i<nthread; ++i) {
+    itsFrames.push_back (frame.copy());
+    itsConverters.push_back (CountedPtr<typename M::Convert>
+                             (new typename M::Convert
+                              (typename M::Ref(inType, itsFrames[i]),
+                               typename M::Ref(outType, itsFrames[i]))));
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -37,6 +37,8 @@
 #include <casacore/measures/Measures/MDirection.h>
 #include <casacore/measures/Measures/MRadialVelocity.h>
 #include <casacore/measures/Measures/MeasComet.h>
+#include <casacore/measures/Measures/MeasPrecomputed.h>
+#include <casacore/casa/Quanta/MVEpoch.h>
 #include <casacore/casa/iostream.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -72,6 +74,8 @@ public:
   MeasComet *comval;
   // Pointer to belonging conversion frame
   MCFrame *mymcf;
+  // Precomputed tables (if any)
+  CountedPtr<MeasPrecomputed> precomp;
   // Usage count
   Int cnt;
 };
@@ -112,6 +116,19 @@ MeasFrame::~MeasFrame() {
   if (rep && rep->cnt && --rep->cnt == 0) delete rep;
 }
 
+MeasFrame MeasFrame::copy() const {
+  MeasFrame frame;
+  if (rep) {
+    frame.rep->precomp = rep->precomp;
+    frame.fill(rep->epval);
+    frame.fill(rep->posval);
+    frame.fill(rep->dirval);
+    frame.fill(rep->radval);
+    frame.fill(rep->comval);
+  }
+  return frame;
+}
+
 // Operators
 MeasFrame &MeasFrame::operator=(const MeasFrame &other) {
   if (this != &other) {
@@ -317,6 +334,25 @@ const MeasComet* MeasFrame::comet() const{
   return 0;
 }
 
+void MeasFrame::precompute(const MVEpoch &start, const MVEpoch &end,
+			   Double tolerance) {
+  setPrecomputed(CountedPtr<MeasPrecomputed>
+		 (new MeasPrecomputed(start.get(), end.get(), tolerance)));
+}
+
+void MeasFrame::setPrecomputed(const CountedPtr<MeasPrecomputed> &tables) {
+  create();
+  rep->precomp = tables;
+  // Make sure the cached frame values are calculated with the tables
+  if (rep->mymcf) rep->mymcf->resetEpoch();
+}
+
+const CountedPtr<MeasPrecomputed> &MeasFrame::precomputed() const {
+  static const CountedPtr<MeasPrecomputed> noTables;
+  if (rep) return rep->precomp;
+  return noTables;
+}
+
 void MeasFrame::lock(uInt &locker) {
   locker = 1;
   if (rep) locker = rep->cnt++;
@@ -32,6 +32,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/measures/Measures/Measure.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
 #include <casacore/casa/iosfwd.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -44,6 +45,7 @@ class MVRadialVelocity;
 class MeasComet;
 class FrameRep;
 class MCFrame;
+class MeasPrecomputed;
 template <class T> class Vector;
 template <class Qtype> class Quantum;
 
@@ -181,6 +183,11 @@ class MeasFrame {
   MeasFrame &operator=(const MeasFrame &other);
   // Destructor
   ~MeasFrame();
+
+  // Make a deep copy of the frame. The copy has its own measures and
+  // calculation caches, so it can be used (e.g., in another thread)
+  // independently of this frame. The precomputed tables (if any) are shared.
+  MeasFrame copy() const;
   
   //# Operators
   // Comparisons
@@ -241,6 +248,32 @@ class MeasFrame {
   const Measure* radialVelocity() const;
   // Get the comet pointer (0 if not present)
   const MeasComet* comet() const;
+
+  // Precompute the time dependent quantities (nutation, aberration, solar
+  // position, IERS earth orientation) for the given range of epochs (in
+  // the time scale of the frame epoch), so conversions using this frame
+  // and an epoch in the range use table lookups (see
+  // <linkto class=MeasPrecomputed>MeasPrecomputed</linkto>).
+  // The tolerance is the maximum absolute error of the tables (in rad, v/c
+  // and AU).
+  // <note role=caution>
+  // The IERS dUT1 value is interpolated at the exact epoch, while
+  // MeasTable keeps its value for 0.04 day. So if IERS data are used,
+  // conversions involving the sidereal time (e.g. to HADEC or AZEL) differ
+  // by up to about 1e-7 rad from those without precomputed tables,
+  // regardless of the tolerance.
+  // </note>
+  // <thrown>
+  //   <li> AipsError if the range is invalid or the tolerance cannot be met
+  // </thrown>
+  void precompute(const MVEpoch &start, const MVEpoch &end,
+		  Double tolerance = 1e-12);
+  // Set or get the precomputed tables. They can be shared by frames.
+  // An empty pointer means that no tables are used.
+  // <group>
+  void setPrecomputed(const CountedPtr<MeasPrecomputed> &tables);
+  const CountedPtr<MeasPrecomputed> &precomputed() const;
+  // </group>
   // Get data from frame. Only available if appropriate measures are set,
   // and the frame is in a calculating state.
   // <group>
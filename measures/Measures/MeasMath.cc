@@ -32,6 +32,7 @@
 #include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/measures/Measures/Aberration.h>
 #include <casacore/measures/Measures/MeasData.h>
+#include <casacore/measures/Measures/MeasPrecomputed.h>
 #include <casacore/measures/Measures/MeasTable.h>
 #include <casacore/measures/Measures/MRBase.h>
 #include <casacore/measures/Measures/Nutation.h>
@@ -41,9 +42,8 @@
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Static data
-// Note: this static is not mutexed, because it does not harm if accidently
-// two threads fill it at the same time.
 uInt MeasMath::b1950_reg_p = 0;
+MutexedInit MeasMath::theirMutexedInit (MeasMath::doInit);
 
 //# Constructors
 MeasMath::MeasMath() :
@@ -94,6 +94,12 @@ void MeasMath::initFrame(MRBase &outref, MRBase &inref) {
   } else outOK_p = False;
 }
 
+void MeasMath::doInit(void*) {
+  b1950_reg_p = 
+    AipsrcValue<Double>::registerRC(String("measures.b1950.d_epoch"),
+				    Unit("a"), Unit("a"), 2000.0);
+}
+
 void MeasMath::getFrame(FrameType i) {
   // Frame information group methods
   static FRFCT frameInfo[N_FrameType] = {
@@ -447,11 +453,7 @@ void MeasMath::deapplyHADECtoAZELGEO(MVPosition &in) {
 }
 
 void MeasMath::applyJ2000toB1950(MVPosition &in, Bool doin) {
-  if (!MeasMath::b1950_reg_p) {
-    b1950_reg_p = 
-      AipsrcValue<Double>::registerRC(String("measures.b1950.d_epoch"),
-				      Unit("a"), Unit("a"), 2000.0);
-  }
+  theirMutexedInit.exec();
   Double epo;
   if (getInfo(UT1, True)) {
     epo = (info_p[UT1]-MeasData::MJD2000)/MeasData::JDCEN;
@@ -482,11 +484,7 @@ void MeasMath::applyJ2000toB1950(MVPosition &in, Double epo, Bool doin) {
 }
 
 void MeasMath::deapplyJ2000toB1950(MVPosition &in, Bool doin) {
-  if (!MeasMath::b1950_reg_p) {
-    b1950_reg_p = 
-      AipsrcValue<Double>::registerRC(String("measures.b1950.d_epoch"),
-				      Unit("a"), Unit("a"), 2000.0);
-  }
+  theirMutexedInit.exec();
   Double epo;
   if (getInfo(UT1, True)) {
     epo = (info_p[UT1]-MeasData::MJD2000)/MeasData::JDCEN;
@@ -608,7 +606,7 @@ void MeasMath::applyPolarMotion(MVPosition &in) {
   getInfo(TDB);
   getInfo(LASTR);
   in(1) = -in(1);
-  Euler EULER1 = MeasTable::polarMotion(info_p[TDB]);
+  Euler EULER1 = getPolarMotion();
   EULER1(2) = info_p[LASTR];
   in = RotMatrix(EULER1) * in;
 }
@@ -616,7 +614,7 @@ void MeasMath::applyPolarMotion(MVPosition &in) {
 void MeasMath::deapplyPolarMotion(MVPosition &in) {
   getInfo(TDB);
   getInfo(LASTR);
-  Euler EULER1 = MeasTable::polarMotion(info_p[TDB]);
+  Euler EULER1 = getPolarMotion();
   EULER1(2) = info_p[LASTR];
   in *= RotMatrix(EULER1);
   in(1) = -in(1);
@@ -694,6 +692,23 @@ void MeasMath::deapplyAPPtoTOPO(MVPosition &in, const Double len,
 }
 
 // General support
+void MeasMath::setPrecomputed(const CountedPtr<MeasPrecomputed> &tables) {
+  if (tables.get() != precomputed_p.get()) precomputed_p = tables;
+  if (SOLPOSIAU) SOLPOSIAU->setPrecomputed(tables);
+  if (ABERIAU) ABERIAU->setPrecomputed(tables);
+  if (ABERB1950) ABERB1950->setPrecomputed(tables);
+  if (NUTATIAU) NUTATIAU->setPrecomputed(tables);
+  if (NUTATB1950) NUTATB1950->setPrecomputed(tables);
+}
+
+Euler MeasMath::getPolarMotion() {
+  Euler res;
+  if (precomputed_p.null() || !precomputed_p->polarMotion(info_p[TDB], res)) {
+    res = MeasTable::polarMotion(info_p[TDB]);
+  }
+  return res;
+}
+
 Bool MeasMath::getInfo(FrameInfo i, Bool ret) {
   // Frame information groups
   static FrameType InfoType[N_FrameInfo] = {
@@ -732,6 +747,9 @@ Bool MeasMath::getInfo(FrameInfo i, Bool ret) {
 	(applyFrame_p[InfoType[i]]->*InfoMVDFrame[i-N_FrameDInfo])
 	  (infomvd_p[i-N_FrameDInfo]);
       }
+      if (InfoType[i] == EPOCH) {
+	setPrecomputed(applyFrame_p[EPOCH]->precomputed());
+      }
     } else {
       if (ret) return False;
       throw(AipsError(String("Missing information in Frame ") +
@@ -36,6 +36,7 @@
 #include <casacore/casa/Quanta/MVPosition.h>
 #include <casacore/casa/Quanta/MVDirection.h>
 #include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/casa/OS/Mutex.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -46,6 +47,7 @@ class Precession;
 class Nutation;
 class SolarPos;
 class Aberration;
+class MeasPrecomputed;
 
 //# Typedefs
 
@@ -271,6 +273,8 @@ private:
   Aberration *ABERIAU, *ABERB1950;
   Nutation *NUTATIAU, *NUTATB1950;
   Precession *PRECESIAU, *PRECESB1950;
+  // Precomputed tables of the epoch frame (if any)
+  CountedPtr<MeasPrecomputed> precomputed_p;
   // </group>
   // Workspace
   // <group>
@@ -283,6 +287,8 @@ private:
   // </group>
   // Aipsrc definition for B1950 epoch (in years)
   static uInt b1950_reg_p;
+  // Register the Aipsrc variable once (thread-safe)
+  static MutexedInit theirMutexedInit;
  
   // </group>
 
@@ -293,6 +299,9 @@ private:
   MeasMath &operator=(const MeasMath &other);
   
   //# Member functions
+  // Register the Aipsrc variable
+  static void doInit(void*);
+
   // Get proper frame information
   void getFrame(FrameType i);
 
@@ -305,6 +314,12 @@ private:
   Bool getInfo(FrameInfo i, Bool ret=False);
   // </group>
 
+  // Use the precomputed tables of the epoch frame in the calculations
+  void setPrecomputed(const CountedPtr<MeasPrecomputed> &tables);
+
+  // Get the polar motion rotation for the current epoch
+  Euler getPolarMotion();
+
   // Make a shift of coordinate into a rotation and apply it when doin is
   // False. Else apply a shift.
   // Given are the longitude and latitude codes of the direction to be used,
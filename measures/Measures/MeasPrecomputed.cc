@@ -0,0 +1,363 @@
+//# MeasPrecomputed.cc: Precomputed tables of time dependent Measures quantities
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/measures/Measures/MeasPrecomputed.h>
+#include <casacore/measures/Measures/MeasIERS.h>
+#include <casacore/measures/Measures/MeasTable.h>
+#include <casacore/casa/Quanta/Euler.h>
+#include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// Sum a Chebyshev series using Clenshaw's recurrence.
+static Double sumChebyshev (const Double* coeff, uInt ncoeff, Double x)
+{
+  Double b1 = 0;
+  Double b2 = 0;
+  for (uInt j=ncoeff-1; j>0; --j) {
+    Double tmp = 2*x*b1 - b2 + coeff[j];
+    b2 = b1;
+    b1 = tmp;
+  }
+  return x*b1 - b2 + coeff[0];
+}
+
+
+MeasChebyshev::MeasChebyshev()
+  : itsStart  (0),
+    itsEnd    (-1),
+    itsFirst  (0),
+    itsStep   (1),
+    itsNseg   (0),
+    itsNval   (0),
+    itsNcoeff (0)
+{}
+
+void MeasChebyshev::fit (SampleFunc* func, void* object, uInt nval,
+                         Double start, Double end, Double tolerance,
+                         uInt ncoeff)
+{
+  AlwaysAssert (nval > 0  &&  ncoeff > 1  &&  end >= start, AipsError);
+  itsStart  = start;
+  itsEnd    = end;
+  itsFirst  = floor(start);
+  itsNval   = nval;
+  itsNcoeff = ncoeff;
+  // Start with segments of 2 days; halve until the tolerance is reached.
+  for (itsStep = 2; itsStep >= 1./256; itsStep /= 2) {
+    itsNseg = uInt((end - itsFirst) / itsStep) + 1;
+    if (fitSegments (func, object, tolerance)) {
+      return;
+    }
+  }
+  itsNval = 0;
+  itsCoeff.clear();
+  itsDCoeff.clear();
+  throw AipsError ("MeasChebyshev: tolerance " + String::toString(tolerance) +
+                   " cannot be reached");
+}
+
+Bool MeasChebyshev::fitSegments (SampleFunc* func, void* object,
+                                 Double tolerance)
+{
+  const uInt n = itsNcoeff;
+  itsCoeff.resize  (itsNseg * itsNval * n);
+  itsDCoeff.resize (itsNseg * itsNval * n);
+  std::vector<Double> samples(n * itsNval);
+  std::vector<Double> exact(itsNval);
+  for (uInt seg=0; seg<itsNseg; ++seg) {
+    Double segStart = itsFirst + seg*itsStep;
+    // Sample at the Chebyshev nodes.
+    for (uInt k=0; k<n; ++k) {
+      Double x = cos(C::pi * (k+0.5) / n);
+      func (object, segStart + 0.5*(x+1)*itsStep, &(samples[k*itsNval]));
+    }
+    for (uInt i=0; i<itsNval; ++i) {
+      Double* coeff  = &(itsCoeff[(seg*itsNval + i) * n]);
+      Double* dcoeff = &(itsDCoeff[(seg*itsNval + i) * n]);
+      for (uInt j=0; j<n; ++j) {
+        Double sum = 0;
+        for (uInt k=0; k<n; ++k) {
+          sum += samples[k*itsNval + i] * cos(C::pi * j * (k+0.5) / n);
+        }
+        coeff[j] = 2*sum / n;
+      }
+      // Derivative coefficients (before halving the first coefficient).
+      dcoeff[n-1] = 0;
+      dcoeff[n-2] = 2*(n-1) * coeff[n-1];
+      for (Int j=n-3; j>=0; --j) {
+        dcoeff[j] = dcoeff[j+2] + 2*(j+1) * coeff[j+1];
+      }
+      coeff[0]  *= 0.5;
+      dcoeff[0] *= 0.5;
+      // Scale from [-1,1] to days.
+      for (uInt j=0; j<n; ++j) {
+        dcoeff[j] *= 2 / itsStep;
+      }
+    }
+    // Check the fit at the extrema (including the segment ends).
+    for (uInt k=0; k<=n; ++k) {
+      Double epoch = segStart + 0.5*(cos(C::pi * k / n) + 1) * itsStep;
+      func (object, epoch, &(exact[0]));
+      for (uInt i=0; i<itsNval; ++i) {
+        Double x = 2*(epoch - segStart) / itsStep - 1;
+        if (abs(sumChebyshev (&(itsCoeff[(seg*itsNval + i) * n]), n, x) -
+                exact[i]) > tolerance) {
+          return False;
+        }
+      }
+    }
+  }
+  return True;
+}
+
+void MeasChebyshev::get (Double epoch, Double* values, Double* derivs) const
+{
+  Int seg = Int((epoch - itsFirst) / itsStep);
+  if (seg < 0) {
+    seg = 0;
+  } else if (seg >= Int(itsNseg)) {
+    seg = itsNseg - 1;
+  }
+  Double x = 2*(epoch - itsFirst - seg*itsStep) / itsStep - 1;
+  for (uInt i=0; i<itsNval; ++i) {
+    uInt offset = (seg*itsNval + i) * itsNcoeff;
+    values[i] = sumChebyshev (&(itsCoeff[offset]), itsNcoeff, x);
+    derivs[i] = sumChebyshev (&(itsDCoeff[offset]), itsNcoeff-1, x);
+  }
+}
+
+
+
+MeasPrecomputed::MeasPrecomputed (Double startMJD, Double endMJD,
+                                  Double tolerance)
+  : itsStart       (startMJD - 0.01),
+    itsEnd         (endMJD + 0.01),
+    itsTolerance   (tolerance),
+    itsIAU2000Type (Nutation::NONE),
+    itsEOPStart    (0)
+{
+  if (!(endMJD >= startMJD)  ||  !(tolerance > 0)) {
+    throw AipsError ("MeasPrecomputed: invalid time range or tolerance");
+  }
+  if (MeasTable::useIAU2000()) {
+    itsIAU2000Type = (MeasTable::useIAU2000A() ?
+                      Nutation::IAU2000A : Nutation::IAU2000B);
+  }
+  Nutation::NutationTypes nutTypes[3] = {Nutation::IAU1980, Nutation::B1950,
+                                         itsIAU2000Type};
+  for (uInt i=0; i<3; ++i) {
+    if (nutTypes[i] != Nutation::NONE) {
+      Nutation nut(nutTypes[i]);
+      itsNutation[i].fit (&sampleNutation, &nut, 5,
+                          itsStart, itsEnd, tolerance);
+    }
+  }
+  Aberration::AberrationTypes aberTypes[2] = {Aberration::STANDARD,
+                                              Aberration::B1950};
+  for (uInt i=0; i<2; ++i) {
+    Aberration aber(aberTypes[i]);
+    itsAberration[i].fit (&sampleAberration, &aber, 3,
+                          itsStart, itsEnd, tolerance);
+  }
+  // The position series have jumps of about 1e-10 AU (caused by the cached
+  // time dependent coefficients), so a tolerance of 1e-9 AU is the minimum.
+  Double posTolerance = max(tolerance, 1e-9);
+  SolarPos solpos(SolarPos::STANDARD);
+  itsEarth.fit (&sampleEarth, &solpos, 3, itsStart, itsEnd, posTolerance);
+  itsSun.fit (&sampleSun, &solpos, 3, itsStart, itsEnd, posTolerance);
+  fillEOP();
+}
+
+void MeasPrecomputed::fillEOP()
+{
+  // Get the daily values for all days in the range and the next day.
+  // The tables are left empty if the IERS data do not cover the range.
+  Int first = ifloor(itsStart);
+  Int last  = ifloor(itsEnd) + 1;
+  std::vector<Double> dut1, x, y;
+  for (Int day=first; day<=last; ++day) {
+    Double vdut1, vx, vy;
+    if (!MeasIERS::get (vdut1, MeasIERS::MEASURED, MeasIERS::dUT1, day)  ||
+        !MeasIERS::get (vx, MeasIERS::MEASURED, MeasIERS::X, day)  ||
+        !MeasIERS::get (vy, MeasIERS::MEASURED, MeasIERS::Y, day)) {
+      return;
+    }
+    dut1.push_back (vdut1);
+    x.push_back (vx);
+    y.push_back (vy);
+  }
+  itsEOPStart = first;
+  itsDUT1.swap (dut1);
+  itsPolarX.swap (x);
+  itsPolarY.swap (y);
+}
+
+Int MeasPrecomputed::nutationIndex (Nutation::NutationTypes type) const
+{
+  if (type == Nutation::IAU1980) {
+    return 0;
+  } else if (type == Nutation::B1950) {
+    return 1;
+  } else if (type == itsIAU2000Type) {
+    return 2;
+  }
+  return -1;
+}
+
+Bool MeasPrecomputed::nutation (Nutation::NutationTypes type, Double epoch,
+                                Double* values, Double* derivs) const
+{
+  Int inx = nutationIndex (type);
+  if (inx < 0  ||  !itsNutation[inx].contains (epoch)) {
+    return False;
+  }
+  itsNutation[inx].get (epoch, values, derivs);
+  return True;
+}
+
+Bool MeasPrecomputed::aberration (Aberration::AberrationTypes type,
+                                  Double epoch,
+                                  Double* values, Double* derivs) const
+{
+  const MeasChebyshev& table = itsAberration[type==Aberration::B1950 ? 1:0];
+  if (type == Aberration::NONE  ||  !table.contains (epoch)) {
+    return False;
+  }
+  table.get (epoch, values, derivs);
+  return True;
+}
+
+Bool MeasPrecomputed::earthPosition (Double epoch,
+                                     Double* values, Double* derivs) const
+{
+  if (!itsEarth.contains (epoch)) {
+    return False;
+  }
+  itsEarth.get (epoch, values, derivs);
+  return True;
+}
+
+Bool MeasPrecomputed::sunPosition (Double epoch,
+                                   Double* values, Double* derivs) const
+{
+  if (!itsSun.contains (epoch)) {
+    return False;
+  }
+  itsSun.get (epoch, values, derivs);
+  return True;
+}
+
+Bool MeasPrecomputed::interpolateEOP (const std::vector<Double>& table,
+                                      Double epoch, Double& value) const
+{
+  Int day = ifloor(epoch);
+  Int inx = day - itsEOPStart;
+  if (inx < 0  ||  inx+1 >= Int(table.size())) {
+    return False;
+  }
+  // Interpolate as done in MeasIERS::get.
+  Double f   = epoch - day;
+  Double vlo = table[inx];
+  Double vhi = table[inx+1];
+  if (abs(vhi-vlo) > 0.5) {
+    vhi -= sign(vhi-vlo);
+  }
+  value = vhi*f - vlo*(f-1.0);
+  return True;
+}
+
+Bool MeasPrecomputed::dUT1 (Double utc, Double& value) const
+{
+  return interpolateEOP (itsDUT1, utc, value);
+}
+
+Bool MeasPrecomputed::polarMotion (Double epoch, Euler& value) const
+{
+  Double x, y;
+  if (!interpolateEOP (itsPolarX, epoch, x)  ||
+      !interpolateEOP (itsPolarY, epoch, y)) {
+    return False;
+  }
+  value = Euler(-x*C::arcsec, 2, -y*C::arcsec, 1, 0.0, 3);
+  return True;
+}
+
+void MeasPrecomputed::sampleNutation (void* object, Double epoch,
+                                      Double* values)
+{
+  Nutation& nut = *static_cast<Nutation*>(object);
+  nut.refresh();
+  nut.calcNut (epoch);
+  for (uInt i=0; i<3; ++i) {
+    values[i] = nut.nval_p[i];
+  }
+  values[3] = nut.eqeq_p;
+  values[4] = nut.neval_p;
+}
+
+void MeasPrecomputed::sampleAberration (void* object, Double epoch,
+                                        Double* values)
+{
+  Aberration& aber = *static_cast<Aberration*>(object);
+  aber.refresh();
+  aber.calcAber (epoch);
+  for (uInt i=0; i<3; ++i) {
+    values[i] = aber.aval[i];
+  }
+}
+
+void MeasPrecomputed::sampleEarth (void* object, Double epoch,
+                                   Double* values)
+{
+  SolarPos& solpos = *static_cast<SolarPos*>(object);
+  solpos.refresh();
+  solpos.calcEarth (epoch);
+  for (uInt i=0; i<3; ++i) {
+    values[i] = solpos.eval[i];
+  }
+}
+
+void MeasPrecomputed::sampleSun (void* object, Double epoch,
+                                 Double* values)
+{
+  SolarPos& solpos = *static_cast<SolarPos*>(object);
+  // The JPL Sun position is obtained for the epoch of the Earth position.
+  solpos.refresh();
+  solpos.calcEarth (epoch);
+  solpos.calcSun (epoch);
+  for (uInt i=0; i<3; ++i) {
+    values[i] = solpos.sval[i];
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
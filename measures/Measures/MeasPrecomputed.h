@@ -0,0 +1,304 @@
+//# MeasPrecomputed.h: Precomputed tables of time dependent Measures quantities
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef MEASURES_MEASPRECOMPUTED_H
+#define MEASURES_MEASPRECOMPUTED_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/measures/Measures/Nutation.h>
+#include <casacore/measures/Measures/Aberration.h>
+#include <casacore/measures/Measures/SolarPos.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class Euler;
+
+
+// <summary>
+// Piecewise Chebyshev approximation of a vector function of time
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tMeasPrecomputed">
+// </reviewed>
+
+// <synopsis>
+// MeasChebyshev approximates a function giving a fixed number of values
+// for an epoch (MJD) by Chebyshev polynomials in segments of equal length.
+// The segment boundaries are aligned on integer days, so a function
+// interpolated linearly in daily values (like the IERS corrections)
+// can be approximated as well.
+// <br>The function is fitted by sampling it at the Chebyshev nodes of each
+// segment. The fit is checked at points between the nodes; if the
+// error exceeds the given tolerance, the segment length is halved and the
+// function is fitted again.
+// <p>
+// Once filled, the object is not changed anymore, so it can be used
+// by multiple threads at the same time.
+// </synopsis>
+
+class MeasChebyshev
+{
+public:
+  // The type of the function to approximate. It has to fill the
+  // values for the given epoch. The object is passed as given to
+  // <src>fit</src>.
+  typedef void SampleFunc (void* object, Double epoch, Double* values);
+
+  // Create an empty object.
+  MeasChebyshev();
+
+  // Is the object empty?
+  Bool empty() const
+    { return itsNval == 0; }
+
+  // Get the number of values and the segment length (in days).
+  // <group>
+  uInt nvalues() const
+    { return itsNval; }
+  Double segmentLength() const
+    { return itsStep; }
+  // </group>
+
+  // Does the approximation cover the epoch?
+  Bool contains (Double epoch) const
+    { return itsNval > 0  &&  epoch >= itsStart  &&  epoch <= itsEnd; }
+
+  // Fit the function over the range [start,end] using polynomials with
+  // <src>ncoeff</src> coefficients.
+  // <thrown>
+  //  <li> AipsError if the tolerance cannot be reached with segments
+  //       of 1/256 day.
+  // </thrown>
+  void fit (SampleFunc* func, void* object, uInt nval,
+            Double start, Double end, Double tolerance, uInt ncoeff=16);
+
+  // Get the values and their derivatives (per day) at the epoch,
+  // which must be contained in the approximation range.
+  void get (Double epoch, Double* values, Double* derivs) const;
+
+private:
+  // Fit all segments using the current step. False is returned if
+  // the tolerance is not reached.
+  Bool fitSegments (SampleFunc* func, void* object, Double tolerance);
+
+  //# Data members.
+  Double itsStart;
+  Double itsEnd;
+  Double itsFirst;
+  Double itsStep;
+  uInt   itsNseg;
+  uInt   itsNval;
+  uInt   itsNcoeff;
+  // The coefficients per segment per value.
+  std::vector<Double> itsCoeff;
+  // The coefficients of the derivative (scaled to days).
+  std::vector<Double> itsDCoeff;
+};
+
+
+
+// <summary>
+// Precomputed tables of time dependent Measures quantities
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tMeasPrecomputed">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=MeasFrame>MeasFrame</linkto>
+//   <li> <linkto class=Nutation>Nutation</linkto>
+//   <li> <linkto class=Aberration>Aberration</linkto>
+//   <li> <linkto class=SolarPos>SolarPos</linkto>
+// </prerequisite>
+
+// <synopsis>
+// The nutation, aberration and solar position used in many Measures
+// conversions are calculated from long series (or the JPL ephemeris).
+// Although the conversions use a linear approximation over a short time
+// interval, they are expensive when converting many values spread over
+// time, or when many converters are made.
+// <p>
+// MeasPrecomputed evaluates these quantities once for a time range and
+// approximates them by Chebyshev polynomials (see
+// <linkto class=MeasChebyshev>MeasChebyshev</linkto>) with a given
+// absolute tolerance. The units of the tolerance are those of the
+// internal values, thus radians for nutation and v/c for aberration.
+// The default of 1e-12 gives errors well below a microarcsec.
+// The solar positions (in AU) are approximated with a tolerance of at
+// least 1e-9 AU, because the series themselves are not smoother than that.
+// <br>Tables are made for:
+// <ul>
+//  <li> the IAU1980 (used for sidereal time), B1950 and, if IAU2000
+//       is used, IAU2000A or IAU2000B nutation (angles, equation of
+//       equinoxes and its complementary terms).
+//  <li> the STANDARD and B1950 aberration.
+//  <li> the barycentric position of the Earth and the Sun.
+// </ul>
+// The quantities are calculated as set by the Aipsrc variables
+// (e.g., <src>measures.nutation.b_usejpl</src>) at the time the tables
+// are made, which should not be changed afterwards.
+// Precession is not tabulated, because it is a short polynomial.
+// <p>
+// Furthermore the IERS dUT1 and polar motion values (if available for the
+// entire range) are copied in daily tables. They are interpolated
+// in the same way as done by <linkto class=MeasIERS>MeasIERS</linkto>,
+// but at the exact epoch instead of keeping a value for 0.04 day
+// as done by <linkto class=MeasTable>MeasTable</linkto>. Hence directions
+// depending on the sidereal time can differ by up to about 1e-7 rad from
+// those calculated without the tables.
+// <p>
+// The tables are usually made with <src>MeasFrame::precompute</src>.
+// All conversions using that frame (and epochs within the range) use the
+// tables instead of evaluating the series. A Nutation, Aberration or
+// SolarPos object can also use them directly.
+// The tables cannot be changed after construction, so they can be
+// shared by frames and converters in different threads.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   MEpoch epoch(Quantity(55000., "d"), MEpoch::UTC);
+//   MeasFrame frame(epoch, obsPosition);
+//   frame.precompute (MVEpoch(55000.), MVEpoch(55001.));
+//   MDirection::Convert conv(MDirection::J2000,
+//                            MDirection::Ref(MDirection::AZEL, frame));
+//   for (uInt i=0; i<ntime; ++i) {
+//     frame.resetEpoch (55000. + i*step);
+//     MDirection azel = conv(dir);
+//   }
+// </srcblock>
+// </example>
+
+// <motivation>
+// Converting the directions or UVW coordinates of a long observation
+// spent most of its time in evaluating the nutation and aberration series.
+// </motivation>
+
+class MeasPrecomputed
+{
+public:
+  // Make the tables for the range of epochs (MJD in days).
+  // The range is slightly extended to cover the differences between the
+  // time scales (UTC, TT, TDB).
+  // <thrown>
+  //  <li> AipsError if the range is invalid or the tolerance cannot be met
+  // </thrown>
+  MeasPrecomputed (Double startMJD, Double endMJD, Double tolerance=1e-12);
+
+  // Get the range and tolerance.
+  // <group>
+  Double start() const
+    { return itsStart; }
+  Double end() const
+    { return itsEnd; }
+  Double tolerance() const
+    { return itsTolerance; }
+  // </group>
+
+  // Get the values and derivatives (per day) of the given nutation type
+  // in the form used internally by class Nutation:
+  // the 3 Euler angles, the equation of equinoxes and its complementary
+  // terms. False is returned if the epoch is not covered.
+  Bool nutation (Nutation::NutationTypes type, Double epoch,
+                 Double* values, Double* derivs) const;
+
+  // Get the values and derivatives of the aberration (as v/c, not yet
+  // scaled for JPL) as used by class Aberration.
+  Bool aberration (Aberration::AberrationTypes type, Double epoch,
+                   Double* values, Double* derivs) const;
+
+  // Get the values and derivatives of the heliocentric Earth position
+  // and the barycentric Sun position as used internally by class SolarPos.
+  // <group>
+  Bool earthPosition (Double epoch, Double* values, Double* derivs) const;
+  Bool sunPosition (Double epoch, Double* values, Double* derivs) const;
+  // </group>
+
+  // Are the IERS earth orientation tables available?
+  Bool hasEOP() const
+    { return !itsDUT1.empty(); }
+
+  // Get dUT1 (in s) at the UTC epoch.
+  Bool dUT1 (Double utc, Double& value) const;
+
+  // Get the polar motion rotation as done by
+  // <src>MeasTable::polarMotion</src>.
+  Bool polarMotion (Double epoch, Euler& value) const;
+
+private:
+  // Forbid copy constructor and assignment.
+  // <group>
+  MeasPrecomputed (const MeasPrecomputed&);
+  MeasPrecomputed& operator= (const MeasPrecomputed&);
+  // </group>
+
+  // Fill the daily IERS tables.
+  void fillEOP();
+
+  // Get the index of a nutation type in the tables (-1 if not tabulated).
+  Int nutationIndex (Nutation::NutationTypes type) const;
+
+  // Interpolate in a daily table.
+  Bool interpolateEOP (const std::vector<Double>& table, Double epoch,
+                       Double& value) const;
+
+  // Sample the exact values.
+  // <group>
+  static void sampleNutation (void* object, Double epoch, Double* values);
+  static void sampleAberration (void* object, Double epoch, Double* values);
+  static void sampleEarth (void* object, Double epoch, Double* values);
+  static void sampleSun (void* object, Double epoch, Double* values);
+  // </group>
+
+  //# Data members.
+  Double        itsStart;
+  Double        itsEnd;
+  Double        itsTolerance;
+  // The nutation tables for IAU1980, B1950 and the IAU2000 type used.
+  MeasChebyshev itsNutation[3];
+  Nutation::NutationTypes itsIAU2000Type;
+  MeasChebyshev itsAberration[2];
+  MeasChebyshev itsEarth;
+  MeasChebyshev itsSun;
+  // The daily IERS values starting at itsEOPStart.
+  Int                 itsEOPStart;
+  std::vector<Double> itsDUT1;
+  std::vector<Double> itsPolarX;
+  std::vector<Double> itsPolarY;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -88,29 +88,31 @@ Double MeasTable::dtimeIGRF = 0;
 Double MeasTable::firstIGRF = 0;
 std::vector<Vector<Double> > MeasTable::coefIGRF;
 std::vector<Vector<Double> > MeasTable::dIGRF;
+MutexedInit MeasTable::iau2000MutexedInit (MeasTable::doInitIAU2000);
 uInt MeasTable::iau2000_reg = 0;
 uInt MeasTable::iau2000a_reg = 0;
 Mutex MeasTable::theirMutex;
 
 //# Member functions
 Bool MeasTable::useIAU2000() {
-  if (!MeasTable::iau2000_reg) {
-    iau2000_reg =
-      AipsrcValue<Bool>::registerRC(String("measures.iau2000.b_use"),
-                                    False);
-  }
+  iau2000MutexedInit.exec();
   return AipsrcValue<Bool>::get(MeasTable::iau2000_reg);
 }
 
 Bool MeasTable::useIAU2000A() {
-  if (!MeasTable::iau2000a_reg) {
-    iau2000a_reg =
-      AipsrcValue<Bool>::registerRC(String("measures.iau2000.b_use2000a"),
-                                    False);
-  }
+  iau2000MutexedInit.exec();
   return AipsrcValue<Bool>::get(MeasTable::iau2000a_reg);
 }
 
+void MeasTable::doInitIAU2000 (void*) {
+  iau2000_reg =
+    AipsrcValue<Bool>::registerRC(String("measures.iau2000.b_use"),
+                                  False);
+  iau2000a_reg =
+    AipsrcValue<Bool>::registerRC(String("measures.iau2000.b_use2000a"),
+                                  False);
+}
+
 Double MeasTable::
 precRate00(const uInt which) {
   static Double preoblcor[3] = { -0.29965*C::arcsec,
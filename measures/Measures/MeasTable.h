@@ -437,6 +437,7 @@ private:
   static void doInitLines (void*);
   static void doInitSources (void*);
   static void doInitIGRF (void*);
+  static void doInitIAU2000 (void*);
 
   // Calculate precessionCoef
   // <group>
@@ -505,6 +506,7 @@ private:
   // Aipsrc registration (for speed) of use of iau2000 and if so
   // the 2000a version
   // <group>
+  static MutexedInit iau2000MutexedInit;
   static uInt iau2000_reg;
   static uInt iau2000a_reg;
   // </group>
@@ -32,6 +32,7 @@
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/measures/Measures/MeasIERS.h>
+#include <casacore/measures/Measures/MeasPrecomputed.h>
 #include <casacore/measures/Measures/MeasTable.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -40,9 +41,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 const Double Nutation::INTV = 0.04;
 
 //# Static data
-uInt Nutation::myInterval_reg = 0;
-uInt Nutation::myUseiers_reg = 0;
-uInt Nutation::myUsejpl_reg = 0;
+Double Nutation::theirInterval = Nutation::INTV;
+Bool Nutation::theirUseiers = False;
+Bool Nutation::theirUsejpl = False;
+MutexedInit Nutation::theirMutexedInit (Nutation::doInit);
 
 //# Constructors
 Nutation::Nutation() :
@@ -89,6 +91,7 @@ void Nutation::copy(const Nutation &other) {
   for (Int j=0; j<4; j++) {
     result_p[j] = other.result_p[j];
   }
+  precomputed_p = other.precomputed_p;
 }
 
 //# Destructor
@@ -121,22 +124,20 @@ void Nutation::fill() {
   checkDerEpoch_p = 1e30;
   for (uInt i=0; i<4; i++) result_p[i].set(1,3,1);
   // Get interval and other switches
-  if (!Nutation::myInterval_reg) {
-    myInterval_reg = 
-      AipsrcValue<Double>::registerRC(String("measures.nutation.d_interval"),
-				      Unit("d"), Unit("d"),
-				      Nutation::INTV);
-  }
-  if (!Nutation::myUseiers_reg) {
-    myUseiers_reg =
-      AipsrcValue<Bool>::registerRC(String("measures.nutation.b_useiers"),
-				    False);
-  }
-  if (!Nutation::myUsejpl_reg) {
-    myUsejpl_reg =
-      AipsrcValue<Bool>::registerRC(String("measures.nutation.b_usejpl"),
-				    False);
-  }
+  theirMutexedInit.exec();
+}
+
+void Nutation::doInit(void*) {
+  theirInterval = AipsrcValue<Double>::get
+    (AipsrcValue<Double>::registerRC(String("measures.nutation.d_interval"),
+				     Unit("d"), Unit("d"),
+				     Nutation::INTV));
+  theirUseiers = AipsrcValue<Bool>::get
+    (AipsrcValue<Bool>::registerRC(String("measures.nutation.b_useiers"),
+				   False));
+  theirUsejpl = AipsrcValue<Bool>::get
+    (AipsrcValue<Bool>::registerRC(String("measures.nutation.b_usejpl"),
+				   False));
 }
 
 void Nutation::refresh() {
@@ -144,6 +145,13 @@ void Nutation::refresh() {
   checkDerEpoch_p = 1e30;
 }
 
+void Nutation::setPrecomputed(const CountedPtr<MeasPrecomputed> &tables) {
+  if (tables.get() != precomputed_p.get()) {
+    precomputed_p = tables;
+    refresh();
+  }
+}
+
 Double Nutation::eqox(Double epoch) {
   calcNut(epoch);
   Double dt = epoch - checkEpoch_p;
@@ -181,12 +189,28 @@ void Nutation::calcNut(Double time, Bool calcDer) {
   Double t = time;
   Double epsilon = 1e-6;
   if (!calcDer) {
-    epsilon = AipsrcValue<Double>::get(Nutation::myInterval_reg);
+    epsilon = Nutation::theirInterval;
   }
   Bool renew = False;
   if (!nearAbs(time, checkEpoch_p, epsilon)) {
     checkEpoch_p = time;
     renew = True;
+    // Use the precomputed values and derivatives if available
+    if (!precomputed_p.null()) {
+      Double val[5], der[5];
+      if (precomputed_p->nutation(method_p, time, val, der)) {
+	for (uInt i=0; i<3; i++) {
+	  nval_p[i] = val[i];
+	  dval_p[i] = der[i];
+	}
+	eqeq_p = val[3];
+	deqeq_p = der[3];
+	neval_p = val[4];
+	deval_p = der[4];
+	checkDerEpoch_p = time;
+	return;
+      }
+    }
     Double dEps = 0;
     Double dPsi = 0;
     switch (method_p) {
@@ -198,7 +222,7 @@ void Nutation::calcNut(Double time, Bool calcDer) {
       t = (t - MeasData::MJD2000)/MeasData::JDCEN;
       break;
     default:
-      if (AipsrcValue<Bool>::get(Nutation::myUseiers_reg)) {
+      if (Nutation::theirUseiers) {
 	dPsi = MeasTable::dPsiEps(0, t);
 	dEps = MeasTable::dPsiEps(1, t);
       }
@@ -287,7 +311,7 @@ void Nutation::calcNut(Double time, Bool calcDer) {
       break;
     default:
       nval_p[0] = MeasTable::fundArg(0)(t); 	//eps0
-      if (AipsrcValue<Bool>::get(Nutation::myUsejpl_reg)) {
+      if (Nutation::theirUsejpl) {
 	Vector<Double> mypl =
 	  MeasTable::Planetary(MeasTable::NUTATION, checkEpoch_p);
 	nval_p[1] = mypl[0];
@@ -445,7 +469,7 @@ void Nutation::calcNut(Double time, Bool calcDer) {
       break;
     default:
       dval_p[0] = (MeasTable::fundArg(0).derivative())(t)/MeasData::JDCEN;
-      if (AipsrcValue<Bool>::get(Nutation::myUsejpl_reg)) {
+      if (Nutation::theirUsejpl) {
 	Vector<Double> mypl =
 	  MeasTable::Planetary(MeasTable::NUTATION, checkEpoch_p);
 	dval_p[1] = mypl[2]*MeasData::JDCEN;
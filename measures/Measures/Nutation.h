@@ -33,10 +33,13 @@
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Quanta/Quantum.h>
 #include <casacore/casa/Quanta/Euler.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <casacore/casa/OS/Mutex.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward Declarations
+class MeasPrecomputed;
 
 // <summary> Nutation class and calculations </summary>
 
@@ -108,6 +111,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //  <li> measures.nutation.b_useiers: use the IERS Database nutation
 //		 corrections for IAU1980 (default False)
 // </ul>
+// The values are read once, when the first Nutation object is created.
 // </synopsis>
 //
 // <example>
@@ -138,6 +142,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 class Nutation {
  public:
+  //# Friends
+  // The precomputed tables are made from the calculated values
+  friend class MeasPrecomputed;
+
   //# Constants
   // Interval to be used for linear approximation (in days)
   static const Double INTV;
@@ -179,7 +187,11 @@ class Nutation {
   
   // Refresh calculations
   void refresh();
-  
+
+  // Use the precomputed tables (if they cover the epoch) instead of
+  // calculating the series. An empty pointer means no tables.
+  void setPrecomputed(const CountedPtr<MeasPrecomputed> &tables);
+
   // Get the equation of equinox
   // <group>
   Double eqox(Double epoch) ;
@@ -220,17 +232,23 @@ class Nutation {
   Int lres_p;
   // Last calculation
   Euler result_p[4];
+  // Precomputed tables (if any)
+  CountedPtr<MeasPrecomputed> precomputed_p;
   // Interpolation interval
-  static uInt myInterval_reg;
+  static Double theirInterval;
   // IERS use
-  static uInt myUseiers_reg;
+  static Bool theirUseiers;
   // JPL use
-  static uInt myUsejpl_reg;
+  static Bool theirUsejpl;
+  // Read the Aipsrc variables once (thread-safe)
+  static MutexedInit theirMutexedInit;
   //# Member functions
   // Make a copy
   void copy(const Nutation &other);
   // Fill an empty copy
   void fill();
+  // Register the Aipsrc variables and read their values
+  static void doInit(void*);
   // Calculate Nutation angles for time t; also derivatives if True given
   void calcNut(Double t, Bool calcDer = False);
 };
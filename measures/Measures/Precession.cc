@@ -37,7 +37,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 const Double Precession::INTV = 0.1;
 
 //# Static data
-uInt Precession::myInterval_reg = 0;
+Double Precession::theirInterval = Precession::INTV;
+MutexedInit Precession::theirMutexedInit (Precession::doInit);
 
 //# Constructors
 Precession::Precession() :
@@ -112,14 +113,16 @@ void Precession::copy(const Precession &other) {
   for (uInt i=0; i<4; ++i) result_p[i] = other.result_p[i];
 }
 
+void Precession::doInit(void*) {
+  theirInterval = AipsrcValue<Double>::get
+    (AipsrcValue<Double>::registerRC(String("measures.precession.d_interval"),
+				     Unit("d"), Unit("d"),
+				     Precession::INTV));
+}
+
 void Precession::fillEpoch() {
   // Get the interpolation interval
-  if (!Precession::myInterval_reg) {
-    myInterval_reg = 
-      AipsrcValue<Double>::registerRC(String("measures.precession.d_interval"),
-				      Unit("d"), Unit("d"),
-				      Precession::INTV);
-  }
+  theirMutexedInit.exec();
   
   checkEpoch_p = 1e30;
   switch (method_p) {
@@ -172,7 +175,7 @@ void Precession::refresh() {
 
 void Precession::calcPrec(Double t) {
   if (!nearAbs(t, checkEpoch_p,
-	       AipsrcValue<Double>::get(Precession::myInterval_reg))) {
+	       Precession::theirInterval)) {
     checkEpoch_p = t;
     switch (method_p) {
     case B1950:
@@ -33,6 +33,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Quanta/Euler.h>
 #include <casacore/scimath/Functionals/Polynomial.h>
+#include <casacore/casa/OS/Mutex.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -101,6 +102,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //	(fraction of days is default unit) over which linear approximation
 //	is used (default is 0.1 day).
 // </ul>
+// The value is read once, when the first Precession object is created.
 // </synopsis>
 //
 // <example>
@@ -197,14 +199,18 @@ class Precession {
   Int lres_p;
   // Last calculation
   Euler result_p[4];
-  // Interpolation interval aipsrc registration
-  static uInt myInterval_reg;
+  // Interpolation interval
+  static Double theirInterval;
+  // Read the Aipsrc variable once (thread-safe)
+  static MutexedInit theirMutexedInit;
 
   //# Member functions
   // Make a copy
   void copy(const Precession &other);
   // Create correct default fixedEpoch and catalogue epoch data
   void fillEpoch();
+  // Register the Aipsrc variable and read its value
+  static void doInit(void*);
   // Calculate precession angles for time t
   void calcPrec(Double t);
 };
@@ -30,6 +30,7 @@
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/measures/Measures/MeasTable.h>
+#include <casacore/measures/Measures/MeasPrecomputed.h>
 #include <casacore/casa/System/AipsrcValue.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -38,8 +39,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 const Double SolarPos::INTV = 0.04;
 
 //# Static data
-uInt SolarPos::interval_reg = 0;
-uInt SolarPos::usejpl_reg = 0;
+Double SolarPos::theirInterval = SolarPos::INTV;
+Bool SolarPos::theirUsejpl = False;
+MutexedInit SolarPos::theirMutexedInit (SolarPos::doInit);
 
 //# Constructors
 SolarPos::SolarPos() : method(SolarPos::STANDARD), lres(0) {
@@ -75,6 +77,7 @@ void SolarPos::copy(const SolarPos &other) {
     for (Int j=0; j<6; j++) {
 	result[j] = other.result[j];
     }
+    precomputed = other.precomputed;
 }
 
 //# Destructor
@@ -90,7 +93,7 @@ const MVPosition &SolarPos::operator()(Double epoch) {
 	result[lres](i) = (-eval[i] - dt*deval[i]);
     }
     // Convert to rectangular
-    if (!AipsrcValue<Bool>::get(SolarPos::usejpl_reg)) {
+    if (!SolarPos::theirUsejpl) {
       result[lres] = MeasTable::posToRect() * result[lres];
     }
     return result[lres];
@@ -111,7 +114,7 @@ const MVPosition &SolarPos::baryEarth(Double epoch) {
 	result[lres](i) -= (sval[i] + dt*dsval[i]);
     }
     // Convert to rectangular
-    if (!AipsrcValue<Bool>::get(SolarPos::usejpl_reg)) {
+    if (!SolarPos::theirUsejpl) {
       result[lres] = MeasTable::posToRect() * result[lres];
     }
     return result[lres];
@@ -125,7 +128,7 @@ const MVPosition &SolarPos::barySun(Double epoch) {
 	result[lres](i) = (-sval[i] - dt*dsval[i]);
     }
     // Convert to rectangular
-    if (!AipsrcValue<Bool>::get(SolarPos::usejpl_reg)) {
+    if (!SolarPos::theirUsejpl) {
       result[lres] = MeasTable::posToRect() * result[lres];
     }
     return result[lres];
@@ -138,7 +141,7 @@ const MVPosition &SolarPos::derivative(Double epoch) {
 	result[lres](i) = (-deval[i]);
     }
     // Convert to rectangular
-    if (!AipsrcValue<Bool>::get(SolarPos::usejpl_reg)) {
+    if (!SolarPos::theirUsejpl) {
       result[lres] = MeasTable::posToRect() * result[lres];
     }
     return result[lres];
@@ -152,7 +155,7 @@ const MVPosition &SolarPos::baryEarthDerivative(Double epoch) {
 	result[lres](i) = (deval[i] - dsval[i]);
     }
     // Convert to rectangular
-    if (!AipsrcValue<Bool>::get(SolarPos::usejpl_reg)) {
+    if (!SolarPos::theirUsejpl) {
       result[lres] = MeasTable::posToRect() * result[lres];
     }
     return result[lres];
@@ -165,7 +168,7 @@ const MVPosition &SolarPos::barySunDerivative(Double epoch) {
 	result[lres](i) = (-dsval[i]);
     }
     // Convert to rectangular
-    if (!AipsrcValue<Bool>::get(SolarPos::usejpl_reg)) {
+    if (!SolarPos::theirUsejpl) {
       result[lres] = MeasTable::posToRect() * result[lres];
     }
     return result[lres];
@@ -173,30 +176,42 @@ const MVPosition &SolarPos::barySunDerivative(Double epoch) {
 
 void SolarPos::fill() {
   // Get the interpolation interval
-  if (!SolarPos::interval_reg) {
-    interval_reg = 
-      AipsrcValue<Double>::registerRC(String("measures.solarpos.d_interval"),
-				      Unit("d"), Unit("d"),
-				      SolarPos::INTV);
-  }
-  if (!SolarPos::usejpl_reg) {
-    usejpl_reg =
-      AipsrcValue<Bool>::registerRC(String("measures.solarpos.b_usejpl"),
-				    False);
-  }
+  theirMutexedInit.exec();
   checkEpoch = 1e30;
   checkSunEpoch = 1e30;
 }
 
+void SolarPos::doInit(void*) {
+  theirInterval = AipsrcValue<Double>::get
+    (AipsrcValue<Double>::registerRC(String("measures.solarpos.d_interval"),
+				     Unit("d"), Unit("d"),
+				     SolarPos::INTV));
+  theirUsejpl = AipsrcValue<Bool>::get
+    (AipsrcValue<Bool>::registerRC(String("measures.solarpos.b_usejpl"),
+				   False));
+}
+
 void SolarPos::refresh() {
     checkEpoch = 1e30;
     checkSunEpoch = 1e30;
 }
 
+void SolarPos::setPrecomputed(const CountedPtr<MeasPrecomputed> &tables) {
+    if (tables.get() != precomputed.get()) {
+	precomputed = tables;
+	refresh();
+    }
+}
+
 void SolarPos::calcEarth(Double t) {
     if (!nearAbs(t, checkEpoch,
-		 AipsrcValue<Double>::get(SolarPos::interval_reg))) {
+		 SolarPos::theirInterval)) {
 	checkEpoch = t;
+	// Use the precomputed values and derivatives if available
+	if (!precomputed.null() &&
+	    precomputed->earthPosition(t, eval, deval)) {
+	    return;
+	}
 	switch (method) {
 	    default:
 	    t = (t - MeasData::MJD2000)/MeasData::JDCEN;
@@ -210,7 +225,7 @@ void SolarPos::calcEarth(Double t) {
 	Double dtmp, ddtmp;
 	switch (method) {
 	    default:
-	      if (AipsrcValue<Bool>::get(SolarPos::usejpl_reg)) {
+	      if (SolarPos::theirUsejpl) {
 		Vector<Double> mypl =
 		  MeasTable::Planetary(MeasTable::EARTH, checkEpoch);
 		for (i=0; i<3; i++) {
@@ -276,8 +291,13 @@ void SolarPos::calcEarth(Double t) {
     
 void SolarPos::calcSun(Double t) {
     if (!nearAbs(t, checkSunEpoch,
-		 AipsrcValue<Double>::get(SolarPos::interval_reg))) {
+		 SolarPos::theirInterval)) {
 	checkSunEpoch = t;
+	// Use the precomputed values and derivatives if available
+	if (!precomputed.null() &&
+	    precomputed->sunPosition(t, sval, dsval)) {
+	    return;
+	}
 	switch (method) {
 	    default:
 	    t = (t - MeasData::MJD2000)/MeasData::JDCEN;
@@ -291,7 +311,7 @@ void SolarPos::calcSun(Double t) {
 	Double dtmp, ddtmp;
 	switch (method) {
 	    default:
-              if (AipsrcValue<Bool>::get(SolarPos::usejpl_reg)) {
+              if (SolarPos::theirUsejpl) {
                 Vector<Double> mypl =
                   MeasTable::Planetary(MeasTable::SUN, checkEpoch);
                 for (i=0; i<3; i++) {
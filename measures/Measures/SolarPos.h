@@ -32,10 +32,15 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Quanta/MVPosition.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <casacore/casa/OS/Mutex.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# Forward Declarations
+class MeasPrecomputed;
+
 // <summary> Solar position class and calculations </summary>
 
 // <use visibility=export>
@@ -90,6 +95,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //		measures.jpl.ephemeris (at the moment of writing DE200 (default),
 //		or DE405)
 // </ul>
+// The values are read once, when the first SolarPos object is created.
 // Reference: M. Soma et al., Cel. Mech. 41 (1988), 389;
 // E.M. Standish, Astron. Astroph. 114 (1982), 297.
 // </synopsis>
@@ -110,6 +116,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 class SolarPos {
 public:
+//# Friends
+// The precomputed tables are made from the calculated values
+    friend class MeasPrecomputed;
+
 //# Constants
 // Interval to be used for linear approximation (in days)
     static const Double INTV;
@@ -156,6 +166,10 @@ public:
 // Refresh calculations
     void refresh();
 
+// Use the precomputed tables (if they cover the epoch) instead of
+// calculating the series. An empty pointer means no tables.
+    void setPrecomputed(const CountedPtr<MeasPrecomputed> &tables);
+
 private:
 //# Data menbers
 // Method to be used
@@ -177,16 +191,22 @@ private:
     Int lres;
 // Last calculation
     MVPosition result[6];
+// Precomputed tables (if any)
+    CountedPtr<MeasPrecomputed> precomputed;
 // Interpolation interval
-    static uInt interval_reg;
+    static Double theirInterval;
 // JPL use
-    static uInt usejpl_reg;
+    static Bool theirUsejpl;
+// Read the Aipsrc variables once (thread-safe)
+    static MutexedInit theirMutexedInit;
 
 //# Member functions
 // Copy
     void copy(const SolarPos &other);
 // Fill an empty copy
     void fill();
+// Register the Aipsrc variables and read their values
+    static void doInit(void*);
 // Calculate heliocentric Earth position for time t
     void calcEarth(Double t);
 // Calculate heliocentric barycentre position
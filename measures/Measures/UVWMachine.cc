@@ -28,6 +28,8 @@
 //# Includes
 #include <casacore/measures/Measures/UVWMachine.h>
 #include <casacore/casa/Quanta/Euler.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Exceptions/Error.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -168,6 +170,13 @@ void UVWMachine::convertUVW(Vector<MVPosition > &uv) const {
   }
 }
 
+void UVWMachine::convertUVW(Matrix<Double> &uv) const {
+  Bool deleteIt;
+  Double *data = getUVWStorage(uv, deleteIt);
+  if (!nop_p) rotateUVW(uvproj_p, data, uv.ncolumn());
+  uv.putStorage(data, deleteIt);
+}
+
 void UVWMachine::convertUVW(Double &phase, Vector<Double> &uv) const {
   phase = 0;
   if (!nop_p) {
@@ -217,6 +226,30 @@ void UVWMachine::convertUVW(Vector<Double> &phase,
   }
 }
 
+void UVWMachine::convertUVW(Vector<Double> &phase,
+			    Matrix<Double> &uv) const {
+  Bool deleteIt;
+  Double *data = getUVWStorage(uv, deleteIt);
+  uInt n = uv.ncolumn();
+  phase.resize(n);
+  phase = 0;
+  if (!nop_p) {
+    rotateUVW(uvrot_p, data, n);
+    const Double p0 = phrot_p(0);
+    const Double p1 = phrot_p(1);
+    const Double p2 = phrot_p(2);
+    Bool deletePhase;
+    Double *ph = phase.getStorage(deletePhase);
+    for (uInt i=0; i<n; i++) {
+      const Double *d = data + 3*i;
+      ph[i] = d[0]*p0 + d[1]*p1 + d[2]*p2;
+    }
+    phase.putStorage(ph, deletePhase);
+    if (proj_p) rotateUVW(rot4_p, data, n);
+  }
+  uv.putStorage(data, deleteIt);
+}
+
 Double UVWMachine::getPhase(Vector<Double> &uv) const {
   Double phase;
   convertUVW(phase, uv);
@@ -323,5 +356,30 @@ void UVWMachine::copy(const UVWMachine &other) {
   rot4_p = other.rot4_p;
 }
 
+Double *UVWMachine::getUVWStorage(Matrix<Double> &uv, Bool &deleteIt) {
+  if (uv.nrow() != 3 && uv.nelements() > 0) {
+    throw(AipsError("UVWMachine: matrix of UVW coordinates must have"
+		    " shape [3,n]"));
+  }
+  return uv.getStorage(deleteIt);
+}
+
+void UVWMachine::rotateUVW(const RotMatrix &rot, Double *uv, uInt n) {
+  // Use local copies of the matrix elements, so the loop can be vectorized.
+  // The same order of operations as in MVPosition::operator*= is used.
+  const Double r00 = rot(0,0), r01 = rot(0,1), r02 = rot(0,2);
+  const Double r10 = rot(1,0), r11 = rot(1,1), r12 = rot(1,2);
+  const Double r20 = rot(2,0), r21 = rot(2,1), r22 = rot(2,2);
+  for (uInt i=0; i<n; i++) {
+    Double *d = uv + 3*i;
+    const Double x = d[0];
+    const Double y = d[1];
+    const Double z = d[2];
+    d[0] = x*r00 + y*r10 + z*r20;
+    d[1] = x*r01 + y*r11 + z*r21;
+    d[2] = x*r02 + y*r12 + z*r22;
+  }
+}
+
 } //# NAMESPACE CASACORE - END
 
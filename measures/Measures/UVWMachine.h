@@ -39,6 +39,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //# Forward Declarations
 class MeasFrame;
 template <class T> class Vector;
+template <class T> class Matrix;
 
 // <summary> Converts UVW coordinates between coordinate systems  </summary>
 
@@ -94,6 +95,14 @@ template <class T> class Vector;
 // latter case can hence be time consuming.
 // </note>
 // <note role=tip>
+// Many UVW coordinates can be converted at once by giving them as the
+// columns of a <src>Matrix</src> with shape [3,n] (as returned by, e.g.,
+// <src>ArrayColumn<Double>::getColumn</src> for a UVW column).
+// The rotation is applied in a single loop over the contiguous values,
+// which the compiler can vectorize. It is much faster than converting
+// the UVWs one by one.
+// </note>
+// <note role=tip>
 // If either the input or output direction/reference specifies a planet, action
 // is special. Planets are assumed to be in J2000 positions, since that is
 // the only way to carry them from conversion to conversion (and also have a
@@ -216,6 +225,7 @@ class UVWMachine {
   void convertUVW(Vector<Vector<Double> > &uv) const;
   void convertUVW(MVPosition &uv) const;
   void convertUVW(Vector<MVPosition > &uv) const;
+  void convertUVW(Matrix<Double> &uv) const;
   // </group>
   // Get phase shift (in implied units of UVW), and change input uvw as well
   // <group>
@@ -230,6 +240,7 @@ class UVWMachine {
   void convertUVW(Vector<Double> &phase, Vector<Vector<Double> > &uv) const;
   void convertUVW(Double &phase, MVPosition &uv) const;
   void convertUVW(Vector<Double> &phase, Vector<MVPosition> &uv) const;
+  void convertUVW(Vector<Double> &phase, Matrix<Double> &uv) const;
   // </group>
 
   // Recalculate the parameters for the machine after e.g. a frame change
@@ -278,6 +289,10 @@ class UVWMachine {
   //# Private Member Functions
   // Initialise machinery
   void init();
+  // Check if the matrix has shape [3,n] and get a pointer to its values
+  static Double *getUVWStorage(Matrix<Double> &uv, Bool &deleteIt);
+  // Apply a rotation matrix to n contiguous UVW coordinates
+  static void rotateUVW(const RotMatrix &rot, Double *uv, uInt n);
   // Planet handling
   void planetinit();
   // Copy data members
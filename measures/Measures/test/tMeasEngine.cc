@@ -0,0 +1,156 @@
+//# tMeasEngine.cc: Test program for per-thread Measures conversion engines
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/measures/Measures/MeasEngine.h>
+#include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/measures/Measures/MCDirection.h>
+#include <casacore/measures/Measures/MCEpoch.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MPosition.h>
+#include <casacore/casa/Quanta/MVEpoch.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+// <summary>
+// Test program for class MeasEngine.
+// </summary>
+
+
+void checkNear (Double v1, Double v2, Double tol)
+{
+  if (abs(v1-v2) > tol) {
+    cout << "Mismatch: " << v1 << ' ' << v2 << " diff=" << v1-v2 << endl;
+  }
+  AlwaysAssertExit (abs(v1-v2) <= tol);
+}
+
+MeasFrame makeFrame()
+{
+  MPosition pos(MVPosition(Quantity(10, "m"), Quantity(6.6, "deg"),
+                           Quantity(52.8, "deg")), MPosition::WGS84);
+  MEpoch epoch(Quantity(55000, "d"), MEpoch::UTC);
+  return MeasFrame(epoch, pos);
+}
+
+void testCopy()
+{
+  MeasFrame frame = makeFrame();
+  frame.precompute (MVEpoch(55000.), MVEpoch(55001.));
+  MeasFrame frameCopy = frame.copy();
+  AlwaysAssertExit (frameCopy != frame);
+  AlwaysAssertExit (frameCopy.precomputed().get() ==
+                    frame.precomputed().get());
+  AlwaysAssertExit (frameCopy.epoch()  &&  frameCopy.position());
+  AlwaysAssertExit (!frameCopy.direction()  &&  !frameCopy.comet());
+  // Resetting the copy does not change the original.
+  frameCopy.resetEpoch (55000.5);
+  checkNear (static_cast<const MEpoch*>(frameCopy.epoch())->getValue().get(),
+             55000.5, 1e-10);
+  checkNear (static_cast<const MEpoch*>(frame.epoch())->getValue().get(),
+             55000, 1e-10);
+  AlwaysAssertExit (MeasFrame().copy().empty());
+}
+
+void testDirection (Bool precompute)
+{
+  const Int nrow = 400;
+  const uInt nthread = 4;
+  MeasFrame frame = makeFrame();
+  if (precompute) {
+    frame.precompute (MVEpoch(55000.), MVEpoch(55001.));
+  }
+  MeasEngine<MDirection> engine(MDirection::J2000, MDirection::AZEL,
+                                frame, nthread);
+  AlwaysAssertExit (engine.nthread() == nthread);
+  std::vector<Double> times(nrow);
+  std::vector<MVDirection> dirs(nrow);
+  for (Int i=0; i<nrow; ++i) {
+    times[i] = 55000 + (i%100) * 0.01;
+    dirs[i]  = MVDirection(Quantity(i*0.9, "deg"), Quantity(60-i*0.3, "deg"));
+  }
+  // Convert in parallel (if possible).
+  std::vector<MVDirection> result(nrow);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthread)
+#endif
+  for (Int i=0; i<nrow; ++i) {
+    uInt thread = OMP::threadNum();
+    engine.frame(thread).resetEpoch (times[i]);
+    result[i] = engine(dirs[i]).getValue();
+  }
+  // Compare with a serial conversion (which cannot use the engine frames).
+  MDirection::Convert conv(MDirection::J2000,
+                           MDirection::Ref(MDirection::AZEL, frame));
+  for (Int i=0; i<nrow; ++i) {
+    frame.resetEpoch (times[i]);
+    checkNear (result[i].separation (conv(dirs[i]).getValue()), 0, 1e-8);
+  }
+}
+
+void testEpoch()
+{
+  const Int nrow = 200;
+  const uInt nthread = 3;
+  MeasFrame frame = makeFrame();
+  frame.precompute (MVEpoch(55000.), MVEpoch(55002.));
+  MeasEngine<MEpoch> engine(MEpoch::UTC, MEpoch::LAST, frame, nthread);
+  std::vector<Double> result(nrow);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthread)
+#endif
+  for (Int i=0; i<nrow; ++i) {
+    uInt thread = OMP::threadNum();
+    result[i] = engine.converter(thread)(MVEpoch(55000 + i*0.01)).
+      getValue().get();
+  }
+  MEpoch::Convert conv(MEpoch::UTC, MEpoch::Ref(MEpoch::LAST, frame));
+  for (Int i=0; i<nrow; ++i) {
+    checkNear (result[i], conv(MVEpoch(55000 + i*0.01)).getValue().get(),
+               1e-9);
+  }
+}
+
+int main()
+{
+  try {
+    testCopy();
+    testDirection (False);
+    testDirection (True);
+    testEpoch();
+  } catch (const AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
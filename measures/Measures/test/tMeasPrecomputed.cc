@@ -0,0 +1,193 @@
+//# tMeasPrecomputed.cc: Test program for precomputed Measures tables
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/measures/Measures/MeasPrecomputed.h>
+#include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/measures/Measures/MeasIERS.h>
+#include <casacore/measures/Measures/MCDirection.h>
+#include <casacore/measures/Measures/MCEpoch.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MPosition.h>
+#include <casacore/measures/Measures/MeasConvert.h>
+#include <casacore/casa/Quanta/MVEpoch.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+// <summary>
+// Test program for class MeasPrecomputed.
+// </summary>
+
+
+void checkNear (Double v1, Double v2, Double tol)
+{
+  if (abs(v1-v2) > tol) {
+    cout << "Mismatch: " << v1 << ' ' << v2 << " diff=" << v1-v2 << endl;
+  }
+  AlwaysAssertExit (abs(v1-v2) <= tol);
+}
+
+void checkNear (const MVPosition& v1, const MVPosition& v2, Double tol)
+{
+  for (uInt i=0; i<3; ++i) {
+    checkNear (v1(i), v2(i), tol);
+  }
+}
+
+void testTables (const CountedPtr<MeasPrecomputed>& tables)
+{
+  AlwaysAssertExit (tables->start() < 55000  &&  tables->end() > 55002.5);
+  Nutation::NutationTypes nutTypes[2] = {Nutation::IAU1980, Nutation::B1950};
+  Double vals[5], ders[5];
+  AlwaysAssertExit (!tables->nutation (Nutation::IAU1980, 54999, vals, ders));
+  AlwaysAssertExit (!tables->nutation (Nutation::NONE, 55001, vals, ders));
+  AlwaysAssertExit (!tables->earthPosition (55004, vals, ders));
+  for (uInt i=0; i<301; ++i) {
+    // Use epochs in and between the segments.
+    Double epoch = 55000 + i/120.1;
+    for (uInt j=0; j<2; ++j) {
+      Nutation nut(nutTypes[j]);
+      Nutation nutTab(nutTypes[j]);
+      nutTab.setPrecomputed (tables);
+      const Euler& eul = nut(epoch);
+      const Euler& eulTab = nutTab(epoch);
+      for (uInt k=0; k<3; ++k) {
+        checkNear (eulTab(k), eul(k), 1e-11);
+      }
+      checkNear (nutTab.eqox(epoch), nut.eqox(epoch), 1e-11);
+      // Check the derivatives using the exact values around the epoch.
+      nut.refresh();
+      Euler eul1 = nut(epoch - 0.01);
+      nut.refresh();
+      Euler eul2 = nut(epoch + 0.01);
+      const Euler& derTab = nutTab.derivative(epoch);
+      for (uInt k=0; k<3; ++k) {
+        checkNear (derTab(k), (eul2(k) - eul1(k)) / 0.02, 1e-10);
+      }
+    }
+    Aberration aber;
+    Aberration aberTab;
+    aberTab.setPrecomputed (tables);
+    checkNear (aberTab(epoch), aber(epoch), 1e-11);
+    aber.refresh();
+    MVPosition aber1 = aber(epoch - 0.01);
+    aber.refresh();
+    MVPosition aber2 = aber(epoch + 0.01);
+    checkNear (aberTab.derivative(epoch), (aber2 - aber1) * 50., 1e-10);
+    SolarPos solpos;
+    SolarPos solposTab;
+    solposTab.setPrecomputed (tables);
+    checkNear (solposTab(epoch), solpos(epoch), 2e-9);
+    checkNear (solposTab.barySun(epoch), solpos.barySun(epoch), 2e-9);
+    checkNear (solposTab.baryEarth(epoch), solpos.baryEarth(epoch), 2e-9);
+  }
+  // The EOP tables must match the interpolation of MeasIERS.
+  if (tables->hasEOP()) {
+    for (uInt i=0; i<48; ++i) {
+      Double epoch = 55000 + i/16.;
+      Double dut1, exact;
+      AlwaysAssertExit (tables->dUT1 (epoch, dut1));
+      MeasIERS::get (exact, MeasIERS::MEASURED, MeasIERS::dUT1, epoch);
+      checkNear (dut1, exact, 1e-12);
+    }
+  }
+}
+
+void testFrame()
+{
+  MPosition pos(MVPosition(Quantity(10, "m"), Quantity(6.6, "deg"),
+                           Quantity(52.8, "deg")), MPosition::WGS84);
+  MEpoch epoch(Quantity(55000, "d"), MEpoch::UTC);
+  MeasFrame frame(epoch, pos);
+  MeasFrame frameTab(epoch, pos);
+  frameTab.precompute (MVEpoch(55000.), MVEpoch(55002.5));
+  AlwaysAssertExit (!frameTab.precomputed().null());
+  AlwaysAssertExit (frame.precomputed().null());
+  MDirection dir(Quantity(30, "deg"), Quantity(40, "deg"), MDirection::J2000);
+  MDirection::Types types[3] = {MDirection::APP, MDirection::HADEC,
+                                MDirection::AZEL};
+  for (uInt j=0; j<3; ++j) {
+    MDirection::Convert conv(dir, MDirection::Ref(types[j], frame));
+    MDirection::Convert convTab(dir, MDirection::Ref(types[j], frameTab));
+    MEpoch::Convert convLast(epoch, MEpoch::Ref(MEpoch::LAST, frame));
+    MEpoch::Convert convLastTab(epoch, MEpoch::Ref(MEpoch::LAST, frameTab));
+    for (uInt i=0; i<50; ++i) {
+      Double mjd = 55000 + i*0.05;
+      frame.resetEpoch (mjd);
+      frameTab.resetEpoch (mjd);
+      // Without IERS data dUT1 is the same; otherwise the tables interpolate
+      // at the exact epoch, while MeasTable keeps a value for 0.04 day.
+      Double tol = (frameTab.precomputed()->hasEOP()  &&  j > 0) ? 1e-7 : 1e-10;
+      checkNear (convTab().getValue(), conv().getValue(), tol);
+      checkNear (convLastTab(mjd).getValue().get(),
+                 convLast(mjd).getValue().get(), 1e-8);
+    }
+  }
+  // The tables can be shared.
+  frame.setPrecomputed (frameTab.precomputed());
+  AlwaysAssertExit (frame.precomputed().get() ==
+                    frameTab.precomputed().get());
+  frame.setPrecomputed (CountedPtr<MeasPrecomputed>());
+  AlwaysAssertExit (frame.precomputed().null());
+}
+
+void testErrors()
+{
+  Bool failed = False;
+  try {
+    MeasPrecomputed tables(55001, 55000);
+  } catch (const AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  failed = False;
+  try {
+    MeasPrecomputed tables(55000, 55001, 0);
+  } catch (const AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+int main()
+{
+  try {
+    CountedPtr<MeasPrecomputed> tables(new MeasPrecomputed(55000, 55002.5));
+    testTables (tables);
+    testFrame();
+    testErrors();
+  } catch (const AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -30,11 +30,14 @@
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/measures/Measures/UVWMachine.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
 #include <casacore/measures/Measures/MPosition.h>
 #include <casacore/measures/Measures/MEpoch.h>
 #include <casacore/casa/Quanta/RotMatrix.h>
 #include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
 
 #include <casacore/casa/namespace.h>
@@ -300,6 +303,32 @@ int main() {
     vmvo = um(vmv);
     cout << "Corrected UVW:        " << vmvo(0) << endl;
 
+    // Converting the columns of a matrix gives the same as one by one.
+    Matrix<Double> muvw(3, 7);
+    for (uInt i=0; i<muvw.ncolumn(); i++) {
+      for (uInt j=0; j<3; j++) {
+	muvw(j,i) = uvw(j) * (Double(i) - 2.5) + 10*j;
+      }
+    }
+    Matrix<Double> mout(muvw.copy());
+    Vector<Double> mph;
+    ump.convertUVW(mph, mout);
+    AlwaysAssertExit (mph.size() == muvw.ncolumn());
+    for (uInt i=0; i<muvw.ncolumn(); i++) {
+      Vector<Double> col(muvw.column(i).copy());
+      Double ph;
+      ump.convertUVW(ph, col);
+      AlwaysAssertExit (nearAbs(ph, mph(i), 1e-9));
+      AlwaysAssertExit (allNearAbs(col, mout.column(i), 1e-9));
+    }
+    mout = muvw;
+    um.convertUVW(mout);
+    for (uInt i=0; i<muvw.ncolumn(); i++) {
+      Vector<Double> col(muvw.column(i).copy());
+      um.convertUVW(col);
+      AlwaysAssertExit (allNearAbs(col, mout.column(i), 1e-9));
+    }
+
     cout << "---------------------------------------" << endl;
 
   } catch (AipsError x) {
@@ -1091,8 +1091,8 @@ IPosition MSConcat::isFixedShape(const TableDesc& td) {
   MSMainColumns destMainCols(*destMS);
   
   // I need to check that the Measures and units are the same.
-  const uInt newRows = otherMS.nrow();
-  uInt curRow = destMS->nrow();
+  const rownr_t newRows = otherMS.nrow();
+  rownr_t curRow = destMS->nrow();
   
   if (!destMS->canAddRow()) {
     log << LogIO::WARN << "Can't add rows to this ms!  Something is seriously wrong with " 
@@ -1301,7 +1301,7 @@ IPosition MSConcat::isFixedShape(const TableDesc& td) {
     sScale = 1/sqrt(itsWeightScale);
   }
 
-  for (uInt r = 0; r < newRows; r++, curRow++) {
+  for (rownr_t r = 0; r < newRows; r++, curRow++) {
     
     Int newA1 = newAntIndices[otherAnt1(r)];
     Int newA2 = newAntIndices[otherAnt2(r)];
@@ -28,8 +28,10 @@
 #include <casacore/ms/MSOper/MSMetaData.h>
 
 #include <casacore/casa/Arrays/MaskArrMath.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/VectorSTLIterator.h>
 #include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/System/ProgressMeter.h>
 #include <casacore/measures/Measures/MeasTable.h>
 #include <casacore/measures/TableMeasures/ArrayQuantColumn.h>
@@ -38,7 +40,12 @@
 #include <casacore/ms/MeasurementSets/MSSpWindowColumns.h>
 #include <casacore/scimath/StatsFramework/ClassicalStatistics.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/tables/TaQL/TableParse.h>
 #include <casacore/casa/Containers/ValueHolder.h>
 
@@ -91,6 +98,7 @@ MSMetaData::MSMetaData(const MeasurementSet *const &ms, const Float maxCacheSize
         File(ms->tableName()).exists() ? 0 : 1, ms
       ),
        _spwInfoStored(False), _forceSubScanPropsToCache(False),
+       _persistentCache(False),
        _sourceTimes() {}
 
 MSMetaData::~MSMetaData() {}
@@ -3560,7 +3568,10 @@ void MSMetaData::_getScalarQuantDoubleColumn(
 void MSMetaData::_computeScanAndSubScanProperties(
     SHARED_PTR<std::map<ScanKey, MSMetaData::ScanProperties> >& scanProps,
     SHARED_PTR<std::map<SubScanKey, MSMetaData::SubScanProperties> >& subScanProps,
-    Bool showProgress
+    Bool showProgress, uInt beginRow,
+    const std::vector<
+        pair<map<ScanKey, ScanProperties>, map<SubScanKey, SubScanProperties> >
+    >& previous
 ) const {
     SHARED_PTR<ProgressMeter> pm;
     if (showProgress || _showProgress) {
@@ -3568,7 +3579,7 @@ void MSMetaData::_computeScanAndSubScanProperties(
         const static String title = "Computing scan and subscan properties...";
         log << LogOrigin("MSMetaData", __func__, WHERE)
             << LogIO::NORMAL << title << LogIO::POST;
-        pm.reset(new ProgressMeter(0, _ms->nrow(), title));
+        pm.reset(new ProgressMeter(beginRow, _ms->nrow(), title));
     }
     const static String scanName = MeasurementSet::columnName(MSMainEnums::SCAN_NUMBER);
     const static String fieldName = MeasurementSet::columnName(MSMainEnums::FIELD_ID);
@@ -3582,9 +3593,10 @@ void MSMetaData::_computeScanAndSubScanProperties(
     const static String exposureName = MeasurementSet::columnName(MSMainEnums::EXPOSURE);
     const static String intervalName = MeasurementSet::columnName(MSMainEnums::INTERVAL);
     TableProxy tp(*_ms);
+    // the previous properties are merged as if they were a chunk
     std::vector<
         pair<map<ScanKey, ScanProperties>, map<SubScanKey, SubScanProperties> >
-    >  props;
+    >  props(previous);
     std::vector<uInt> ddIDToSpw = getDataDescIDToSpwMap();
     scanProps.reset(
         new std::map<ScanKey, ScanProperties>()
@@ -3592,10 +3604,10 @@ void MSMetaData::_computeScanAndSubScanProperties(
     subScanProps.reset(
         new std::map<SubScanKey, SubScanProperties>()
     );
-    Int doneRows = 0;
+    Int doneRows = beginRow;
     uInt msRows = _ms->nrow();
     static const uInt rowsInChunk = 10000000;
-    for (uInt row=0; row<msRows; row += rowsInChunk) {
+    for (uInt row=beginRow; row<msRows; row += rowsInChunk) {
         uInt nrows = min(rowsInChunk, msRows - row);
         Vector<Int> scans, fields, ddIDs, states,
             arrays, observations, ant1, ant2;
@@ -3709,16 +3721,21 @@ void MSMetaData::_mergeScanProps(
             }
             else {
                 SubScanProperties& fp = (*subScanProps)[ssKey];
-                // the rows increment must come before the mean exposure time
-                // computation
+                // the mean exposure time is weighted by the number of rows
+                // so the result does not depend on how the rows are chunked
+                uInt prevRows = fp.acRows + fp.xcRows;
+                uInt valRows = val.acRows + val.xcRows;
                 fp.acRows += val.acRows;
                 fp.xcRows += val.xcRows;
                 fp.antennas.insert(val.antennas.begin(), val.antennas.end());
                 fp.beginTime = min(fp.beginTime, val.beginTime);
                 fp.ddIDs.insert(val.ddIDs.begin(), val.ddIDs.end());
                 fp.endTime = max(fp.endTime, val.endTime);
-                uInt nrows = fp.acRows + fp.xcRows;
-                fp.meanExposureTime = (fp.meanExposureTime*Quantity(nrows - 1) + val.meanExposureTime)/nrows;
+                uInt nrows = prevRows + valRows;
+                fp.meanExposureTime = (
+                    fp.meanExposureTime*Quantity(prevRows)
+                    + val.meanExposureTime*Quantity(valRows)
+                )/nrows;
                 fp.stateIDs.insert(val.stateIDs.begin(), val.stateIDs.end());
                 fp.spws.insert(val.spws.begin(), val.spws.end());
 
@@ -4038,9 +4055,32 @@ void MSMetaData::_getScanAndSubScanProperties(
     }
     SHARED_PTR<std::map<SubScanKey, SubScanProperties> > myssprops;
     SHARED_PTR<std::map<ScanKey, ScanProperties> > myscanprops;
-    _computeScanAndSubScanProperties(
-        myscanprops, myssprops, showProgress
-    );
+    std::vector<
+        pair<map<ScanKey, ScanProperties>, map<SubScanKey, SubScanProperties> >
+    > previous;
+    uInt beginRow = 0;
+    Bool upToDate = False;
+    Bool persist = _persistentCache && _canUsePersistentCache();
+    if (persist) {
+        previous.resize(1);
+        beginRow = _readPersistentCache(previous[0], upToDate);
+        if (beginRow == 0) {
+            previous.clear();
+        }
+    }
+    if (beginRow > 0 && beginRow == _ms->nrow()) {
+        // all rows are in the persistent cache
+        _mergeScanProps(myscanprops, myssprops, previous);
+    }
+    else {
+        // only the rows not in the persistent cache need to be scanned
+        _computeScanAndSubScanProperties(
+            myscanprops, myssprops, showProgress, beginRow, previous
+        );
+    }
+    if (persist && ! upToDate) {
+        _writePersistentCache(*myscanprops, *myssprops);
+    }
     scanProps = myscanprops;
     subScanProps = myssprops;
 
@@ -4095,6 +4135,431 @@ void MSMetaData::_getScanAndSubScanProperties(
     }
 }
 
+String MSMetaData::persistentCacheName(const MeasurementSet& ms) {
+    return ms.tableName() + "/METADATA_CACHE";
+}
+
+void MSMetaData::removePersistentCache(const MeasurementSet& ms) {
+    String name = persistentCacheName(ms);
+    if (Table::isReadable(name)) {
+        Table::deleteTable(name);
+    }
+}
+
+Bool MSMetaData::_canUsePersistentCache() const {
+    // a reference or memory MS has no directory of its own
+    return _ms->tableType() == Table::Plain
+        && _ms->isRootTable()
+        && File(_ms->tableName()).isDirectory();
+}
+
+String MSMetaData::_metadataFingerprint(uInt nrow) const {
+    const static String intNames[] = {
+        MeasurementSet::columnName(MSMainEnums::SCAN_NUMBER),
+        MeasurementSet::columnName(MSMainEnums::FIELD_ID),
+        MeasurementSet::columnName(MSMainEnums::DATA_DESC_ID),
+        MeasurementSet::columnName(MSMainEnums::STATE_ID),
+        MeasurementSet::columnName(MSMainEnums::ARRAY_ID),
+        MeasurementSet::columnName(MSMainEnums::OBSERVATION_ID),
+        MeasurementSet::columnName(MSMainEnums::ANTENNA1),
+        MeasurementSet::columnName(MSMainEnums::ANTENNA2)
+    };
+    const static String doubleNames[] = {
+        MeasurementSet::columnName(MSMainEnums::TIME),
+        MeasurementSet::columnName(MSMainEnums::EXPOSURE),
+        MeasurementSet::columnName(MSMainEnums::INTERVAL)
+    };
+    vector<ScalarColumn<Int> > intCols;
+    for (uInt i=0; i<8; ++i) {
+        intCols.push_back(ScalarColumn<Int>(*_ms, intNames[i]));
+    }
+    vector<ScalarColumn<Double> > doubleCols;
+    for (uInt i=0; i<3; ++i) {
+        doubleCols.push_back(ScalarColumn<Double>(*_ms, doubleNames[i]));
+    }
+    // FNV-1a hash of the values in all rows, read in chunks
+    uInt64 hash = 14695981039346656037ULL;
+    const uInt chunk = 10000;
+    for (uInt start=0; start<nrow; start+=chunk) {
+        Slicer rows(IPosition(1, start), IPosition(1, min(chunk, nrow-start)));
+        for (uInt j=0; j<8; ++j) {
+            Vector<Int> vals = intCols[j].getColumnRange(rows);
+            Bool deleteIt;
+            const Int* data = vals.getStorage(deleteIt);
+            const uChar* bytes = reinterpret_cast<const uChar*>(data);
+            for (uInt k=0; k<vals.size()*sizeof(Int); ++k) {
+                hash = (hash ^ bytes[k]) * 1099511628211ULL;
+            }
+            vals.freeStorage(data, deleteIt);
+        }
+        for (uInt j=0; j<3; ++j) {
+            Vector<Double> vals = doubleCols[j].getColumnRange(rows);
+            Bool deleteIt;
+            const Double* data = vals.getStorage(deleteIt);
+            const uChar* bytes = reinterpret_cast<const uChar*>(data);
+            for (uInt k=0; k<vals.size()*sizeof(Double); ++k) {
+                hash = (hash ^ bytes[k]) * 1099511628211ULL;
+            }
+            vals.freeStorage(data, deleteIt);
+        }
+    }
+    ostringstream os;
+    os << std::hex << hash;
+    return os.str();
+}
+
+Bool MSMetaData::_hasUnflushedChanges() const {
+    if (_ms->isWritable()) {
+        Vector<String> names = _ms->tableDesc().columnNames();
+        for (uInt i=0; i<names.size(); ++i) {
+            TableColumn col(*_ms, names[i]);
+            if (col.changeGeneration() != col.flushedGeneration()) {
+                return True;
+            }
+        }
+    }
+    return False;
+}
+
+uInt MSMetaData::_readPersistentCache(
+    pair<map<ScanKey, ScanProperties>, map<SubScanKey, SubScanProperties> >& props,
+    Bool& upToDate
+) const {
+    upToDate = False;
+    String name = persistentCacheName(*_ms);
+    if (! Table::isReadable(name)) {
+        return 0;
+    }
+    try {
+        Table tab(name);
+        const TableRecord& keys = tab.keywordSet();
+        if (
+            ! keys.isDefined("VERSION") || keys.asInt("VERSION") != 2
+        ) {
+            return 0;
+        }
+        uInt nrow = keys.asuInt("NROW");
+        uInt msRows = _ms->nrow();
+        if (nrow == 0 || nrow > msRows) {
+            return 0;
+        }
+        // the spws of the data descriptions must not have changed
+        std::vector<uInt> ddIDToSpw = getDataDescIDToSpwMap();
+        Vector<Int> storedSpws = keys.asArrayInt("DDID_SPW");
+        if (storedSpws.size() != ddIDToSpw.size()) {
+            return 0;
+        }
+        for (uInt i=0; i<ddIDToSpw.size(); ++i) {
+            if ((uInt)storedSpws[i] != ddIDToSpw[i]) {
+                return 0;
+            }
+        }
+        // if the main table has not been modified, the cache is up to date.
+        // Changes made in this process are only counted when flushed, so
+        // unflushed changes of the columns count as a modification as well.
+        Bool modified = keys.asuInt("MODIFY_COUNTER") != _ms->getModifyCounter()
+            || _hasUnflushedChanges();
+        if (nrow == msRows && ! modified) {
+            upToDate = True;
+        }
+        else if (
+            // otherwise only appending rows is allowed, thus the metadata
+            // of all cached rows must be the same
+            nrow == msRows
+            || keys.asString("FINGERPRINT") != _metadataFingerprint(nrow)
+        ) {
+            return 0;
+        }
+        map<ScanKey, ScanProperties>& scanProps = props.first;
+        map<SubScanKey, SubScanProperties>& subScanProps = props.second;
+        Matrix<Int> scanKeys = keys.asArrayInt("SCAN_KEYS");
+        Matrix<Double> timeRanges = keys.asArrayDouble("SCAN_TIME_RANGE");
+        ScanKey scanKey;
+        for (uInt i=0; i<scanKeys.ncolumn(); ++i) {
+            scanKey.obsID = scanKeys(0, i);
+            scanKey.arrayID = scanKeys(1, i);
+            scanKey.scan = scanKeys(2, i);
+            scanProps[scanKey].timeRange = std::make_pair(
+                timeRanges(0, i), timeRanges(1, i)
+            );
+        }
+        ScalarColumn<Int> obsCol(tab, "OBSERVATION_ID");
+        ScalarColumn<Int> arrayCol(tab, "ARRAY_ID");
+        ScalarColumn<Int> scanCol(tab, "SCAN_NUMBER");
+        ScalarColumn<Int> fieldCol(tab, "FIELD_ID");
+        ScalarColumn<uInt> acCol(tab, "AC_ROWS");
+        ScalarColumn<uInt> xcCol(tab, "XC_ROWS");
+        ArrayColumn<Int> antCol(tab, "ANTENNAS");
+        ArrayColumn<Int> ddidCol(tab, "DATA_DESC_IDS");
+        ArrayColumn<Int> stateCol(tab, "STATE_IDS");
+        ScalarColumn<Double> beginCol(tab, "BEGIN_TIME");
+        ScalarColumn<Double> endCol(tab, "END_TIME");
+        ScalarColumn<Double> meanExpCol(tab, "MEAN_EXPOSURE");
+        ScalarColumn<String> expUnitCol(tab, "EXPOSURE_UNIT");
+        ArrayColumn<Int> spwCol(tab, "SPWS");
+        ArrayColumn<uInt> spwNRowsCol(tab, "SPW_NROWS");
+        ArrayColumn<Double> meanIntCol(tab, "MEAN_INTERVAL");
+        ScalarColumn<String> intUnitCol(tab, "INTERVAL_UNIT");
+        ArrayColumn<Int> feDDIDCol(tab, "FIRST_EXPOSURE_DDID");
+        ArrayColumn<Double> feTimeCol(tab, "FIRST_EXPOSURE_TIME");
+        ArrayColumn<Double> feCol(tab, "FIRST_EXPOSURE");
+        ArrayColumn<Double> timesCol(tab, "TIMES");
+        ArrayColumn<uInt> timeNRowsCol(tab, "TIME_NROWS");
+        ArrayColumn<uInt> timeNDDIDCol(tab, "TIME_NDDIDS");
+        ArrayColumn<Int> timeDDIDCol(tab, "TIME_DDIDS");
+        SubScanKey ssKey;
+        for (uInt row=0; row<tab.nrow(); ++row) {
+            ssKey.obsID = obsCol(row);
+            ssKey.arrayID = arrayCol(row);
+            ssKey.scan = scanCol(row);
+            ssKey.fieldID = fieldCol(row);
+            SubScanProperties& ssProps = subScanProps[ssKey];
+            ssProps.acRows = acCol(row);
+            ssProps.xcRows = xcCol(row);
+            Vector<Int> ants = antCol(row);
+            ssProps.antennas.insert(ants.begin(), ants.end());
+            Vector<Int> ddIDs = ddidCol(row);
+            ssProps.ddIDs.insert(ddIDs.begin(), ddIDs.end());
+            Vector<Int> states = stateCol(row);
+            ssProps.stateIDs.insert(states.begin(), states.end());
+            ssProps.beginTime = beginCol(row);
+            ssProps.endTime = endCol(row);
+            Unit eunit(expUnitCol(row));
+            ssProps.meanExposureTime = Quantity(meanExpCol(row), eunit);
+            Vector<Int> spws = spwCol(row);
+            Vector<uInt> spwNRows = spwNRowsCol(row);
+            Vector<Double> meanInts = meanIntCol(row);
+            Unit iunit(intUnitCol(row));
+            for (uInt i=0; i<spws.size(); ++i) {
+                ssProps.spws.insert(spws[i]);
+                ssProps.spwNRows[spws[i]] = spwNRows[i];
+                ssProps.meanInterval[spws[i]] = Quantity(meanInts[i], iunit);
+            }
+            Vector<Int> feDDIDs = feDDIDCol(row);
+            Vector<Double> feTimes = feTimeCol(row);
+            Vector<Double> fes = feCol(row);
+            for (uInt i=0; i<feDDIDs.size(); ++i) {
+                ssProps.firstExposureTime[feDDIDs[i]] = std::make_pair(
+                    feTimes[i], Quantity(fes[i], eunit)
+                );
+            }
+            // the scan times and rows per spw are derived from the subscans
+            ScanProperties& sProps = scanProps[casacore::scanKey(ssKey)];
+            for (uInt i=0; i<spws.size(); ++i) {
+                sProps.spwNRows[spws[i]] += spwNRows[i];
+            }
+            Vector<Double> times = timesCol(row);
+            Vector<uInt> timeNRows = timeNRowsCol(row);
+            Vector<uInt> timeNDDIDs = timeNDDIDCol(row);
+            Vector<Int> timeDDIDs = timeDDIDCol(row);
+            uInt k = 0;
+            for (uInt i=0; i<times.size(); ++i) {
+                TimeStampProperties& tProps = ssProps.timeProps[times[i]];
+                tProps.nrows = timeNRows[i];
+                for (uInt j=0; j<timeNDDIDs[i]; ++j, ++k) {
+                    tProps.ddIDs.insert(timeDDIDs[k]);
+                    sProps.times[ddIDToSpw[timeDDIDs[k]]].insert(times[i]);
+                }
+            }
+        }
+        return nrow;
+    }
+    catch (const AipsError& x) {
+        LogIO log;
+        log << LogOrigin("MSMetaData", __func__, WHERE) << LogIO::DEBUG1
+            << "Cannot use persistent cache " << name << ": "
+            << x.getMesg() << LogIO::POST;
+    }
+    upToDate = False;
+    props.first.clear();
+    props.second.clear();
+    return 0;
+}
+
+void MSMetaData::_writePersistentCache(
+    const std::map<ScanKey, ScanProperties>& scanProps,
+    const std::map<SubScanKey, SubScanProperties>& subScanProps
+) const {
+    uInt msRows = _ms->nrow();
+    if (msRows == 0 || ! File(_ms->tableName()).isWritable()) {
+        return;
+    }
+    String name = persistentCacheName(*_ms);
+    // write it under another name first, so other processes never see
+    // a partially written cache
+    String tmpName = name + "_tmp" + String::toString(HostInfo::processID());
+    try {
+        TableDesc td;
+        td.addColumn(ScalarColumnDesc<Int>("OBSERVATION_ID"));
+        td.addColumn(ScalarColumnDesc<Int>("ARRAY_ID"));
+        td.addColumn(ScalarColumnDesc<Int>("SCAN_NUMBER"));
+        td.addColumn(ScalarColumnDesc<Int>("FIELD_ID"));
+        td.addColumn(ScalarColumnDesc<uInt>("AC_ROWS"));
+        td.addColumn(ScalarColumnDesc<uInt>("XC_ROWS"));
+        td.addColumn(ArrayColumnDesc<Int>("ANTENNAS", 1));
+        td.addColumn(ArrayColumnDesc<Int>("DATA_DESC_IDS", 1));
+        td.addColumn(ArrayColumnDesc<Int>("STATE_IDS", 1));
+        td.addColumn(ScalarColumnDesc<Double>("BEGIN_TIME"));
+        td.addColumn(ScalarColumnDesc<Double>("END_TIME"));
+        td.addColumn(ScalarColumnDesc<Double>("MEAN_EXPOSURE"));
+        td.addColumn(ScalarColumnDesc<String>("EXPOSURE_UNIT"));
+        td.addColumn(ArrayColumnDesc<Int>("SPWS", 1));
+        td.addColumn(ArrayColumnDesc<uInt>("SPW_NROWS", 1));
+        td.addColumn(ArrayColumnDesc<Double>("MEAN_INTERVAL", 1));
+        td.addColumn(ScalarColumnDesc<String>("INTERVAL_UNIT"));
+        td.addColumn(ArrayColumnDesc<Int>("FIRST_EXPOSURE_DDID", 1));
+        td.addColumn(ArrayColumnDesc<Double>("FIRST_EXPOSURE_TIME", 1));
+        td.addColumn(ArrayColumnDesc<Double>("FIRST_EXPOSURE", 1));
+        td.addColumn(ArrayColumnDesc<Double>("TIMES", 1));
+        td.addColumn(ArrayColumnDesc<uInt>("TIME_NROWS", 1));
+        td.addColumn(ArrayColumnDesc<uInt>("TIME_NDDIDS", 1));
+        td.addColumn(ArrayColumnDesc<Int>("TIME_DDIDS", 1));
+        SetupNewTable newtab(tmpName, td, Table::New);
+        Table tab(newtab, subScanProps.size());
+        ScalarColumn<Int> obsCol(tab, "OBSERVATION_ID");
+        ScalarColumn<Int> arrayCol(tab, "ARRAY_ID");
+        ScalarColumn<Int> scanCol(tab, "SCAN_NUMBER");
+        ScalarColumn<Int> fieldCol(tab, "FIELD_ID");
+        ScalarColumn<uInt> acCol(tab, "AC_ROWS");
+        ScalarColumn<uInt> xcCol(tab, "XC_ROWS");
+        ArrayColumn<Int> antCol(tab, "ANTENNAS");
+        ArrayColumn<Int> ddidCol(tab, "DATA_DESC_IDS");
+        ArrayColumn<Int> stateCol(tab, "STATE_IDS");
+        ScalarColumn<Double> beginCol(tab, "BEGIN_TIME");
+        ScalarColumn<Double> endCol(tab, "END_TIME");
+        ScalarColumn<Double> meanExpCol(tab, "MEAN_EXPOSURE");
+        ScalarColumn<String> expUnitCol(tab, "EXPOSURE_UNIT");
+        ArrayColumn<Int> spwCol(tab, "SPWS");
+        ArrayColumn<uInt> spwNRowsCol(tab, "SPW_NROWS");
+        ArrayColumn<Double> meanIntCol(tab, "MEAN_INTERVAL");
+        ScalarColumn<String> intUnitCol(tab, "INTERVAL_UNIT");
+        ArrayColumn<Int> feDDIDCol(tab, "FIRST_EXPOSURE_DDID");
+        ArrayColumn<Double> feTimeCol(tab, "FIRST_EXPOSURE_TIME");
+        ArrayColumn<Double> feCol(tab, "FIRST_EXPOSURE");
+        ArrayColumn<Double> timesCol(tab, "TIMES");
+        ArrayColumn<uInt> timeNRowsCol(tab, "TIME_NROWS");
+        ArrayColumn<uInt> timeNDDIDCol(tab, "TIME_NDDIDS");
+        ArrayColumn<Int> timeDDIDCol(tab, "TIME_DDIDS");
+        uInt row = 0;
+        std::map<SubScanKey, SubScanProperties>::const_iterator ssIter = subScanProps.begin();
+        std::map<SubScanKey, SubScanProperties>::const_iterator ssEnd = subScanProps.end();
+        for (; ssIter!=ssEnd; ++ssIter, ++row) {
+            const SubScanKey& ssKey = ssIter->first;
+            const SubScanProperties& ssProps = ssIter->second;
+            obsCol.put(row, ssKey.obsID);
+            arrayCol.put(row, ssKey.arrayID);
+            scanCol.put(row, ssKey.scan);
+            fieldCol.put(row, ssKey.fieldID);
+            acCol.put(row, ssProps.acRows);
+            xcCol.put(row, ssProps.xcRows);
+            antCol.put(row, Vector<Int>(
+                std::vector<Int>(ssProps.antennas.begin(), ssProps.antennas.end())
+            ));
+            ddidCol.put(row, Vector<Int>(
+                std::vector<Int>(ssProps.ddIDs.begin(), ssProps.ddIDs.end())
+            ));
+            stateCol.put(row, Vector<Int>(
+                std::vector<Int>(ssProps.stateIDs.begin(), ssProps.stateIDs.end())
+            ));
+            beginCol.put(row, ssProps.beginTime);
+            endCol.put(row, ssProps.endTime);
+            const Unit& eunit = ssProps.meanExposureTime.getFullUnit();
+            meanExpCol.put(row, ssProps.meanExposureTime.getValue());
+            expUnitCol.put(row, eunit.getName());
+            uInt nspw = ssProps.spws.size();
+            Vector<Int> spws(nspw);
+            Vector<uInt> spwNRows(nspw);
+            Vector<Double> meanInts(nspw);
+            String iunit;
+            uInt i = 0;
+            std::set<uInt>::const_iterator spwIter = ssProps.spws.begin();
+            std::set<uInt>::const_iterator spwEnd = ssProps.spws.end();
+            for (; spwIter!=spwEnd; ++spwIter, ++i) {
+                const Quantity& meanInt = ssProps.meanInterval.find(*spwIter)->second;
+                spws[i] = *spwIter;
+                spwNRows[i] = ssProps.spwNRows.find(*spwIter)->second;
+                iunit = meanInt.getUnit();
+                meanInts[i] = meanInt.getValue();
+            }
+            spwCol.put(row, spws);
+            spwNRowsCol.put(row, spwNRows);
+            meanIntCol.put(row, meanInts);
+            intUnitCol.put(row, iunit);
+            uInt nfe = ssProps.firstExposureTime.size();
+            Vector<Int> feDDIDs(nfe);
+            Vector<Double> feTimes(nfe);
+            Vector<Double> fes(nfe);
+            i = 0;
+            FirstExposureTimeMap::const_iterator feIter = ssProps.firstExposureTime.begin();
+            FirstExposureTimeMap::const_iterator feEnd = ssProps.firstExposureTime.end();
+            for (; feIter!=feEnd; ++feIter, ++i) {
+                feDDIDs[i] = feIter->first;
+                feTimes[i] = feIter->second.first;
+                fes[i] = feIter->second.second.getValue(eunit);
+            }
+            feDDIDCol.put(row, feDDIDs);
+            feTimeCol.put(row, feTimes);
+            feCol.put(row, fes);
+            uInt ntimes = ssProps.timeProps.size();
+            Vector<Double> times(ntimes);
+            Vector<uInt> timeNRows(ntimes);
+            Vector<uInt> timeNDDIDs(ntimes);
+            std::vector<Int> timeDDIDs;
+            i = 0;
+            std::map<Double, TimeStampProperties>::const_iterator tIter = ssProps.timeProps.begin();
+            std::map<Double, TimeStampProperties>::const_iterator tEnd = ssProps.timeProps.end();
+            for (; tIter!=tEnd; ++tIter, ++i) {
+                times[i] = tIter->first;
+                timeNRows[i] = tIter->second.nrows;
+                timeNDDIDs[i] = tIter->second.ddIDs.size();
+                timeDDIDs.insert(
+                    timeDDIDs.end(), tIter->second.ddIDs.begin(),
+                    tIter->second.ddIDs.end()
+                );
+            }
+            timesCol.put(row, times);
+            timeNRowsCol.put(row, timeNRows);
+            timeNDDIDCol.put(row, timeNDDIDs);
+            timeDDIDCol.put(row, Vector<Int>(timeDDIDs));
+        }
+        uInt nscans = scanProps.size();
+        Matrix<Int> scanKeys(3, nscans);
+        Matrix<Double> timeRanges(2, nscans);
+        uInt col = 0;
+        std::map<ScanKey, ScanProperties>::const_iterator sIter = scanProps.begin();
+        std::map<ScanKey, ScanProperties>::const_iterator sEnd = scanProps.end();
+        for (; sIter!=sEnd; ++sIter, ++col) {
+            scanKeys(0, col) = sIter->first.obsID;
+            scanKeys(1, col) = sIter->first.arrayID;
+            scanKeys(2, col) = sIter->first.scan;
+            timeRanges(0, col) = sIter->second.timeRange.first;
+            timeRanges(1, col) = sIter->second.timeRange.second;
+        }
+        std::vector<uInt> ddIDToSpw = getDataDescIDToSpwMap();
+        TableRecord& keys = tab.rwKeywordSet();
+        keys.define("VERSION", Int(2));
+        keys.define("NROW", msRows);
+        keys.define("MODIFY_COUNTER", _ms->getModifyCounter());
+        keys.define("FINGERPRINT", _metadataFingerprint(msRows));
+        keys.define(
+            "DDID_SPW", Vector<Int>(std::vector<Int>(ddIDToSpw.begin(), ddIDToSpw.end()))
+        );
+        keys.define("SCAN_KEYS", scanKeys);
+        keys.define("SCAN_TIME_RANGE", timeRanges);
+        tab.flush();
+        tab.rename(name, Table::New);
+    }
+    catch (const AipsError& x) {
+        LogIO log;
+        log << LogOrigin("MSMetaData", __func__, WHERE) << LogIO::DEBUG1
+            << "Cannot write persistent cache " << name << ": "
+            << x.getMesg() << LogIO::POST;
+        if (Table::isReadable(tmpName)) {
+            Table::deleteTable(tmpName);
+        }
+    }
+}
+
 std::map<Double, Double> MSMetaData::_getTimeToTotalBWMap(
     const Vector<Double>& times, const Vector<Int>& ddIDs
 ) {
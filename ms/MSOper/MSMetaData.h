@@ -511,6 +511,28 @@ public:
     // is often a good idea to cache it if it will be accessed many times.
     void setForceSubScanPropsToCache(Bool b) { _forceSubScanPropsToCache = b; }
 
+    // If True, the scan and subscan properties are also kept in the table
+    // METADATA_CACHE inside the MS directory, so that other processes (e.g.,
+    // later stages of a pipeline) do not need to scan the main table again.
+    // The stored properties are only used if the main table has not been
+    // modified since they were stored (as told by its modify counter).
+    // The only exception is appending rows to the MS, which is verified by
+    // a fingerprint of the metadata columns in all previously stored rows.
+    // In that case only the new rows are scanned and merged with the
+    // stored properties.
+    // <br>Nothing is stored if the MS is not a plain table on disk or
+    // if its directory is not writable. The default is False.
+    // <group>
+    void setPersistentCache(Bool b) { _persistentCache = b; }
+    Bool getPersistentCache() const { return _persistentCache; }
+    // </group>
+
+    // Get the name of the table containing the persistent cache of an MS.
+    static String persistentCacheName(const MeasurementSet& ms);
+
+    // Remove the persistent cache of an MS (if existing).
+    static void removePersistentCache(const MeasurementSet& ms);
+
     // get a data structure, consumable by users, representing a summary of the dataset
     Record getSummary() const;
 
@@ -773,6 +795,7 @@ private:
     const vector<const Table*> _taqlTempTable;
 
     mutable Bool _spwInfoStored, _forceSubScanPropsToCache;
+    Bool _persistentCache;
     vector<std::map<Int, Quantity> > _firstExposureTimeMap;
     mutable vector<Int> _numCorrs, _source_sourceIDs, _field_sourceIDs;
 
@@ -822,10 +845,18 @@ private:
 
     static void _checkTolerance(const Double tol);
 
+    // compute the properties of the rows starting at <src>beginRow</src>
+    // and merge them with the <src>previous</src> properties (of the rows
+    // before <src>beginRow</src>).
     void _computeScanAndSubScanProperties(
         SHARED_PTR<std::map<ScanKey, MSMetaData::ScanProperties> >& scanProps,
         SHARED_PTR<std::map<SubScanKey, MSMetaData::SubScanProperties> >& subScanProps,
-        Bool showProgress
+        Bool showProgress, uInt beginRow=0,
+        const std::vector<
+            std::pair<std::map<ScanKey, ScanProperties>, std::map<SubScanKey, SubScanProperties> >
+        >& previous=std::vector<
+            std::pair<std::map<ScanKey, ScanProperties>, std::map<SubScanKey, SubScanProperties> >
+        >()
     ) const;
 
     static void _getScalarIntColumn(
@@ -1074,6 +1105,30 @@ private:
         Bool showProgress
     ) const;
 
+    // can the persistent cache be used for this MS?
+    Bool _canUsePersistentCache() const;
+
+    // get a fingerprint of the metadata columns in the first nrow rows
+    // of the main table.
+    String _metadataFingerprint(uInt nrow) const;
+
+    // does a column of the main table have unflushed changes?
+    Bool _hasUnflushedChanges() const;
+
+    // read the properties from the persistent cache. It returns the number
+    // of main table rows covered by them; 0 means no (valid) cache.
+    // <src>upToDate</src> tells if the cache matches the MS exactly.
+    uInt _readPersistentCache(
+        std::pair<std::map<ScanKey, ScanProperties>, std::map<SubScanKey, SubScanProperties> >& props,
+        Bool& upToDate
+    ) const;
+
+    // write the properties to the persistent cache.
+    void _writePersistentCache(
+        const std::map<ScanKey, ScanProperties>& scanProps,
+        const std::map<SubScanKey, SubScanProperties>& subScanProps
+    ) const;
+
     std::set<SubScanKey> _getSubScanKeys() const;
 
     // get subscans related to the given scan
@@ -37,6 +37,8 @@
 #include <casacore/casa/Quanta/QLogical.h>
 #include <casacore/ms/MSOper/MSKeys.h>
 #include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableCopy.h>
 #include <casacore/measures/Measures/MDirection.h>
 
 #include <casacore/casa/BasicSL/STLIO.h>
@@ -2585,6 +2587,91 @@ void testIt(MSMetaData& md) {
     }
 }
 
+void compareProps(const MSMetaData& md1, const MSMetaData& md2) {
+    SHARED_PTR<const std::map<SubScanKey, MSMetaData::SubScanProperties> > p1
+        = md1.getSubScanProperties();
+    SHARED_PTR<const std::map<SubScanKey, MSMetaData::SubScanProperties> > p2
+        = md2.getSubScanProperties();
+    AlwaysAssert(p1->size() == p2->size(), AipsError);
+    std::map<SubScanKey, MSMetaData::SubScanProperties>::const_iterator i1 = p1->begin();
+    std::map<SubScanKey, MSMetaData::SubScanProperties>::const_iterator i2 = p2->begin();
+    for (; i1!=p1->end(); ++i1, ++i2) {
+        AlwaysAssert(! (i1->first < i2->first || i2->first < i1->first), AipsError);
+        const MSMetaData::SubScanProperties& s1 = i1->second;
+        const MSMetaData::SubScanProperties& s2 = i2->second;
+        AlwaysAssert(s1.acRows == s2.acRows && s1.xcRows == s2.xcRows, AipsError);
+        AlwaysAssert(s1.antennas == s2.antennas && s1.ddIDs == s2.ddIDs, AipsError);
+        AlwaysAssert(s1.spws == s2.spws && s1.stateIDs == s2.stateIDs, AipsError);
+        AlwaysAssert(s1.spwNRows == s2.spwNRows, AipsError);
+        AlwaysAssert(s1.beginTime == s2.beginTime && s1.endTime == s2.endTime, AipsError);
+        AlwaysAssert(near(s1.meanExposureTime, s2.meanExposureTime), AipsError);
+        AlwaysAssert(s1.timeProps.size() == s2.timeProps.size(), AipsError);
+        std::map<uInt, Quantity>::const_iterator m1 = s1.meanInterval.begin();
+        std::map<uInt, Quantity>::const_iterator m2 = s2.meanInterval.begin();
+        for (; m1!=s1.meanInterval.end(); ++m1, ++m2) {
+            AlwaysAssert(m1->first == m2->first && near(m1->second, m2->second), AipsError);
+        }
+    }
+    AlwaysAssert(md1.getTimesForSpws() == md2.getTimesForSpws(), AipsError);
+    AlwaysAssert(*md1.getScanToTimeRangeMap() == *md2.getScanToTimeRangeMap(), AipsError);
+    AlwaysAssert(
+        md1.getScanToFirstExposureTimeMap(False).size()
+        == md2.getScanToFirstExposureTimeMap(False).size(), AipsError
+    );
+}
+
+void testPersistentCache(const MeasurementSet& ms) {
+    cout << "*** test persistent cache" << endl;
+    ms.deepCopy("tMSMetaData_tmp.ms", Table::New);
+    MeasurementSet mscopy("tMSMetaData_tmp.ms", Table::Update);
+    String cacheName = MSMetaData::persistentCacheName(mscopy);
+    MSMetaData md(&mscopy, 0);
+    {
+        // the first time the cache is created
+        MSMetaData md1(&mscopy, 0);
+        md1.setPersistentCache(True);
+        compareProps(md, md1);
+        AlwaysAssert(Table::isReadable(cacheName), AipsError);
+        // the next time it is used
+        MSMetaData md2(&mscopy, 0);
+        md2.setPersistentCache(True);
+        compareProps(md, md2);
+    }
+    {
+        // append rows; the cache is updated with the new rows only
+        uInt nrow = mscopy.nrow();
+        uInt nadd = min(nrow, (uInt)100);
+        mscopy.addRow(nadd);
+        TableCopy::copyRows(mscopy, ms, nrow, 0, nadd);
+        MSMetaData md1(&mscopy, 0);
+        md1.setPersistentCache(True);
+        MSMetaData md2(&mscopy, 0);
+        compareProps(md1, md2);
+        AlwaysAssert(
+            Table(cacheName).keywordSet().asuInt("NROW") == nrow + nadd, AipsError
+        );
+    }
+    {
+        // change the metadata of an existing row; the cache is invalid
+        ScalarColumn<Int> scanCol(
+            mscopy, MeasurementSet::columnName(MSMainEnums::SCAN_NUMBER)
+        );
+        uInt nscans = MSMetaData(&mscopy, 0).getScanToTimeRangeMap()->size();
+        uInt row = mscopy.nrow() / 2;
+        scanCol.put(row, scanCol(row) + 1000);
+        mscopy.flush();
+        MSMetaData md1(&mscopy, 0);
+        md1.setPersistentCache(True);
+        MSMetaData md2(&mscopy, 0);
+        compareProps(md1, md2);
+        AlwaysAssert(
+            md1.getScanToTimeRangeMap()->size() == nscans + 1, AipsError
+        );
+    }
+    MSMetaData::removePersistentCache(mscopy);
+    AlwaysAssert(! Table::isReadable(cacheName), AipsError);
+}
+
 int main() {
     try {
         String *parts = new String[2];
@@ -2608,6 +2695,7 @@ int main() {
         MSMetaData md2(&ms, 0);
         testIt(md2);
         AlwaysAssert(md2.getCache() == 0, AipsError);
+        testPersistentCache(ms);
 
         cout << "OK" << endl;
     } 
@@ -265,6 +265,9 @@ public:
 		          bool doNotLockSubtables, TableOption = Table::Old);
       // Allows keeping subtables unlocked/read-locked independent of lock
       // mode of main table.
+      // For a finished MS it is safer to seal it (see
+      // <src>Table::seal</src>); a sealed MS and its subtables are
+      // opened without any locking.
 
   MeasurementSet (const String &tableName, const String &tableDescName,
 		  TableOption = Table::Old);
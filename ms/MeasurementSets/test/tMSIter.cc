@@ -37,11 +37,14 @@
 #include <casacore/ms/MeasurementSets/MSAntennaColumns.h>
 #include <casacore/ms/MeasurementSets/MSFeedColumns.h>
 #include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ParTableIter.h>
+#include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 using namespace casacore;
 using namespace std;
@@ -226,6 +229,54 @@ void iter2MSMemory (double binwidth)
   }
 }
 
+// Worker summing the DATA per iteration step.
+class DataSumWorker : public TableGroupWorker
+{
+public:
+  explicit DataSumWorker (std::vector<Complex>* sums)
+    : itsSums (sums)
+  {}
+  virtual TableGroupWorker* clone() const
+    { return new DataSumWorker(itsSums); }
+  virtual void attach (const Table& tab)
+    { itsCol.attach (tab, "DATA"); }
+  virtual void read (uInt, rownr_t startRow, rownr_t nrow)
+    { itsCol.getColumnRange (Slicer(IPosition(1,startRow),
+                                    IPosition(1,nrow)), itsData, True); }
+  virtual void process (uInt groupnr)
+    { (*itsSums)[groupnr] = sum(itsData); }
+private:
+  std::vector<Complex>* itsSums;
+  ArrayColumn<Complex>  itsCol;
+  Array<Complex>        itsData;
+};
+
+// Process the iteration steps in parallel and check them against MSIter.
+void parIterMS (double binwidth)
+{
+  MeasurementSet ms("tMSIter_tmp.ms");
+  Block<int> sort(2);
+  sort[0] = MS::ANTENNA1;
+  sort[1] = MS::ANTENNA2;
+  MSIter msIter(ms, sort, binwidth, False);
+  AlwaysAssertExit (msIter.numMS() == 1);
+  ParallelTableIterator piter(msIter.tableIterator(0));
+  std::vector<Complex> sums(piter.ngroup());
+  DataSumWorker worker(&sums);
+  piter.run (worker, 3);
+  const std::vector<rownr_t>& groups = piter.groupBoundaries();
+  uInt nr = 0;
+  for (msIter.origin(); msIter.more(); msIter++) {
+    AlwaysAssertExit (nr < piter.ngroup());
+    AlwaysAssertExit (msIter.table().nrow() == groups[nr+1] - groups[nr]);
+    Array<Complex> data = ArrayColumn<Complex>(msIter.table(),
+                                               "DATA").getColumn();
+    AlwaysAssertExit (sums[nr] == sum(data));
+    nr++;
+  }
+  AlwaysAssertExit (nr == piter.ngroup());
+}
+
 
 int main (int argc, char* argv[])
 {
@@ -258,6 +309,7 @@ int main (int argc, char* argv[])
     iter2MS(binwidth);
     cout << "########" << endl;
     iter2MSMemory(binwidth);
+    parIterMS(binwidth);
   } catch (std::exception& x) {
     cerr << "Unexpected exception: " << x.what() << endl;
     return 1;
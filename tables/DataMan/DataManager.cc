@@ -35,6 +35,7 @@
 #include <casacore/tables/DataMan/TiledCellStMan.h>
 #include <casacore/tables/DataMan/TiledColumnStMan.h>
 #include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/tables/DataMan/TiledCompressStMan.h>
 #include <casacore/tables/DataMan/MemoryStMan.h>
 #include <casacore/tables/DataMan/CompressFloat.h>
 #include <casacore/tables/DataMan/CompressComplex.h>
@@ -434,6 +435,12 @@ Bool DataManagerColumn::canAccessColumnSlice (Bool& reask) const
     return False;
 }
 
+Bool DataManagerColumn::getZoneMap (Vector<uInt>&, Vector<Double>&,
+                                    Vector<Double>&, Bool)
+{
+    return False;
+}
+
 
 String DataManagerColumn::dataTypeId() const
     { return String(); }
@@ -589,6 +596,8 @@ void DataManager::doRegisterMainCtor (void*)
   unlockedRegisterCtor ("TiledCellStMan", TiledCellStMan::makeObject);
   unlockedRegisterCtor ("TiledColumnStMan", TiledColumnStMan::makeObject);
   unlockedRegisterCtor ("TiledShapeStMan", TiledShapeStMan::makeObject);
+  unlockedRegisterCtor ("TiledCompressStMan",
+                        TiledCompressStMan::makeObject);
   unlockedRegisterCtor ("MemoryStMan", MemoryStMan::makeObject);
   unlockedRegisterCtor (CompressFloat::className(),
                         CompressFloat::makeObject);
@@ -53,6 +53,7 @@ class IPosition;
 class Slicer;
 class RefRows;
 template<class T> class Array;
+template<class T> class Vector;
 class AipsIO;
 
 
@@ -759,6 +760,22 @@ public:
     // By default reask is set to False.
     virtual Bool canAccessColumnSlice (Bool& reask) const;
 
+    // Get the zone map of a scalar numeric column, i.e. the minimum and
+    // maximum value of consecutive row ranges (zones). Zone <src>i</src>
+    // contains the rows from <src>startRows(i)</src> till the start row of
+    // the next zone (or till the end of the column for the last zone).
+    // A selection of a range of values only needs to look at the rows of
+    // the zones overlapping that range.
+    // It returns False if the column has no zone map, which is the default.
+    // <br>A zone map is only created if <src>create=True</src>. Note that
+    // a created zone map is stored in the data manager at the next flush,
+    // which makes the table unreadable for casacore versions not knowing
+    // zone maps. Therefore only an explicit request should create it.
+    virtual Bool getZoneMap (Vector<uInt>& startRows,
+                             Vector<Double>& minValues,
+                             Vector<Double>& maxValues,
+                             Bool create);
+
     // Get access to the ColumnCache object.
     // <group>
     ColumnCache& columnCache()
@@ -422,6 +422,21 @@ ISMBucket* ISMBase::nextBucket (uInt& cursor, uInt& bucketStartRow,
     return 0;
 }
 
+StManZoneMap* ISMBase::getZoneMap (uInt colnr, Bool create)
+{
+    return getIndex().getZoneMap (colnr, create);
+}
+
+void ISMBase::getZoneRows (uInt zone, uInt& startRow, uInt& nrrow)
+{
+    getIndex().getZoneRows (zone, startRow, nrrow);
+}
+
+void ISMBase::zoneChanged (uInt colnr, uInt rownr, Bool fromRow)
+{
+    getIndex().zoneChanged (colnr, rownr, fromRow);
+}
+
 void ISMBase::setBucketDirty()
 {
     cache_p->setDirty();
@@ -572,6 +587,12 @@ Bool ISMBase::flush (AipsIO& ios, Bool fsync)
 	    changed = True;
 	}
     }
+    // Recalculate the zones of changed buckets before writing the index.
+    if (dataChanged_p) {
+	for (uInt i=0; i<nrcol; i++) {
+	    colSet_p[i]->updateZoneMap();
+	}
+    }
     if (cache_p != 0) {
 	cache_p->flush();
     }
@@ -44,6 +44,7 @@ class ISMBucket;
 class ISMIndex;
 class ISMColumn;
 class StManArrayFile;
+class StManZoneMap;
 
 // <summary>
 // Base class of the Incremental Storage Manager
@@ -181,6 +182,19 @@ public:
     ISMBucket* nextBucket (uInt& cursor, uInt& bucketStartRow,
 			   uInt& bucketNrrow);
 
+    // Get the zone map of the given column from the index.
+    // It is created if not existing yet and <src>create</src> is True,
+    // otherwise a null pointer is returned if not existing.
+    StManZoneMap* getZoneMap (uInt colnr, Bool create);
+
+    // Get the start row and number of rows of the given zone (bucket).
+    void getZoneRows (uInt zone, uInt& startRow, uInt& nrrow);
+
+    // Tell the index that the value of the given column in the given row
+    // has changed. If <src>fromRow</src> is True, all further rows can
+    // have changed as well.
+    void zoneChanged (uInt colnr, uInt rownr, Bool fromRow);
+
     // Get access to the temporary buffer.
     char* tempBuffer() const;
 
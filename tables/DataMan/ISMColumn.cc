@@ -28,6 +28,7 @@
 #include <casacore/tables/DataMan/ISMColumn.h>
 #include <casacore/tables/DataMan/ISMBase.h>
 #include <casacore/tables/DataMan/ISMBucket.h>
+#include <casacore/tables/DataMan/StManZoneMap.h>
 #include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/Vector.h>
@@ -37,6 +38,7 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/LECanonicalConversion.h>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -754,6 +756,69 @@ void ISMColumn::putArrayStringV (uInt rownr, const Array<String>* value)
 }
 
 
+Bool ISMColumn::getZoneMap (Vector<uInt>& startRows,
+                            Vector<Double>& minValues,
+                            Vector<Double>& maxValues,
+                            Bool create)
+{
+    DataType dtype = static_cast<DataType>(dataType());
+    if (nrelem_p != 1  ||  !StManZoneMap::canHaveZoneMap (dtype)) {
+	return False;
+    }
+    StManZoneMap* zoneMap = stmanPtr_p->getZoneMap (colnr_p, create);
+    if (zoneMap == 0) {
+	return False;
+    }
+    fillZoneMap (*zoneMap);
+    uInt nzone = zoneMap->nzone();
+    startRows.resize (nzone);
+    minValues.resize (nzone);
+    maxValues.resize (nzone);
+    for (uInt i=0; i<nzone; i++) {
+	uInt nrrow;
+	stmanPtr_p->getZoneRows (i, startRows[i], nrrow);
+	minValues[i] = zoneMap->minValue(i);
+	maxValues[i] = zoneMap->maxValue(i);
+    }
+    return True;
+}
+
+void ISMColumn::updateZoneMap()
+{
+    StManZoneMap* zoneMap = stmanPtr_p->getZoneMap (colnr_p, False);
+    if (zoneMap != 0) {
+	fillZoneMap (*zoneMap);
+    }
+}
+
+void ISMColumn::fillZoneMap (StManZoneMap& zoneMap)
+{
+    DataType dtype = static_cast<DataType>(dataType());
+    // Buffer for a single value (the largest type is a Double).
+    Double value;
+    for (uInt i=0; i<zoneMap.nzone(); i++) {
+	if (zoneMap.isStale(i)) {
+	    Double minValue =  std::numeric_limits<Double>::infinity();
+	    Double maxValue = -std::numeric_limits<Double>::infinity();
+	    uInt bucketStartRow, bucketNrrow;
+	    stmanPtr_p->getZoneRows (i, bucketStartRow, bucketNrrow);
+	    if (bucketNrrow > 0) {
+		ISMBucket* bucket = stmanPtr_p->getBucket (bucketStartRow,
+							   bucketStartRow,
+							   bucketNrrow);
+		const Block<uInt>& offIndex = bucket->offIndex (colnr_p);
+		uInt nused = bucket->indexUsed (colnr_p);
+		for (uInt j=0; j<nused; j++) {
+		    readFunc_p (&value, bucket->get (offIndex[j]), nrcopy_p);
+		    StManZoneMap::getMinMax (dtype, &value, 1,
+					     minValue, maxValue);
+		}
+	    }
+	    zoneMap.setZone (i, minValue, maxValue);
+	}
+    }
+}
+
 void ISMColumn::putValue (uInt rownr, const void* value)
 {
     // Get the bucket and interval to which the row belongs.
@@ -806,6 +871,9 @@ void ISMColumn::putValue (uInt rownr, const void* value)
     // We have to write the value, so let the cache set the dirty flag
     // for this bucket.
     stmanPtr_p->setBucketDirty();
+    // The zone of the bucket changes (and of all further buckets if the
+    // value is put in them as well).
+    stmanPtr_p->zoneChanged (colnr_p, rownr, afterLastRowPut);
     // Get the temporary buffer from the storage manager.
     uInt lenData;
     char* buffer = stmanPtr_p->tempBuffer();
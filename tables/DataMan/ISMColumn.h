@@ -305,6 +305,20 @@ public:
     // Get the nr of elements in this data value.
     uInt nelements() const;
 
+    // Get the zone map (minimum and maximum per bucket) of the column.
+    // If not existing yet, it is created if <src>create=True</src>, which
+    // requires reading all data.
+    // It returns False if the column is not numeric or not scalar, or if
+    // it has no zone map.
+    virtual Bool getZoneMap (Vector<uInt>& startRows,
+                             Vector<Double>& minValues,
+                             Vector<Double>& maxValues,
+                             Bool create);
+
+    // Recalculate the stale zones if the column has a zone map.
+    // It is called before the index is written.
+    void updateZoneMap();
+
 
 protected:
     // Test if the last value is invalid for this row.
@@ -317,6 +331,9 @@ protected:
     // Put the value for this row.
     void putValue (uInt rownr, const void* value);
 
+    // Recalculate the stale zones in the zone map of the column.
+    void fillZoneMap (StManZoneMap& zoneMap);
+
     //# Declare member variables.
     // Pointer to the parent storage manager.
     ISMBase*          stmanPtr_p;
@@ -102,6 +102,12 @@ void ISMIndColumn::reopenRW()
     iosfile_p->reopenRW();
 }
 
+Bool ISMIndColumn::getZoneMap (Vector<uInt>&, Vector<Double>&,
+                               Vector<Double>&, Bool)
+{
+    return False;
+}
+
 void ISMIndColumn::addRow (uInt, uInt oldNrrow)
 {
     // If the shape is fixed and if the first row is added, define
@@ -33,6 +33,7 @@
 #include <casacore/casa/Containers/BlockIO.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -49,19 +50,39 @@ ISMIndex::~ISMIndex()
 
 void ISMIndex::get (AipsIO& os)
 {
-    os.getstart ("ISMIndex");
+    uInt version = os.getstart ("ISMIndex");
     os >> nused_p;
     getBlock (os, rows_p);
     getBlock (os, bucketNr_p);
+    zoneMaps_p.clear();
+    if (version >= 2) {
+	uInt nmap;
+	os >> nmap;
+	for (uInt i=0; i<nmap; i++) {
+	    uInt colnr;
+	    os >> colnr;
+	    zoneMaps_p[colnr].get (os);
+	}
+    }
     os.getend();
 }
 
 void ISMIndex::put (AipsIO& os)
 {
-    os.putstart ("ISMIndex", 1);
+    // Only use the new version if zone maps are used, so older software
+    // can still read the index.
+    os.putstart ("ISMIndex", zoneMaps_p.empty() ? 1 : 2);
     os << nused_p;
     putBlock (os, rows_p, nused_p + 1);
     putBlock (os, bucketNr_p, nused_p);
+    if (! zoneMaps_p.empty()) {
+	os << uInt(zoneMaps_p.size());
+	for (std::map<uInt,StManZoneMap>::const_iterator iter =
+	       zoneMaps_p.begin(); iter != zoneMaps_p.end(); ++iter) {
+	    os << iter->first;
+	    iter->second.put (os);
+	}
+    }
     os.putend();
 }
 
@@ -81,6 +102,10 @@ void ISMIndex::addBucketNr (uInt rownr, uInt bucketNr)
     rows_p[index] = rownr;
     bucketNr_p[index] = bucketNr;
     nused_p++;
+    for (std::map<uInt,StManZoneMap>::iterator iter = zoneMaps_p.begin();
+	 iter != zoneMaps_p.end(); ++iter) {
+	iter->second.insertZone (index);
+    }
 }
 
 void ISMIndex::addRow (uInt nrrow)
@@ -109,8 +134,18 @@ Int ISMIndex::removeRow (uInt rownr)
 	// There should always be one interval.
 	if (nused_p > 1) {
 	    nused_p--;
+	    for (std::map<uInt,StManZoneMap>::iterator iter =
+		   zoneMaps_p.begin(); iter != zoneMaps_p.end(); ++iter) {
+		iter->second.removeZone (index);
+	    }
+	    return emptyBucket;
 	}
     }
+    // The values in the bucket might have changed.
+    for (std::map<uInt,StManZoneMap>::iterator iter = zoneMaps_p.begin();
+	 iter != zoneMaps_p.end(); ++iter) {
+	iter->second.setStale (std::min (index, nused_p-1));
+    }
     return emptyBucket;
 }
 
@@ -158,6 +193,33 @@ Bool ISMIndex::nextBucketNr (uInt& cursor, uInt& bucketStartRow,
     return True;
 }
 
+StManZoneMap* ISMIndex::getZoneMap (uInt colnr, Bool create)
+{
+    std::map<uInt,StManZoneMap>::iterator iter = zoneMaps_p.find (colnr);
+    if (iter == zoneMaps_p.end()) {
+	if (!create) {
+	    return 0;
+	}
+	iter = zoneMaps_p.insert (std::make_pair (colnr,
+						  StManZoneMap(nused_p))).first;
+    }
+    return &(iter->second);
+}
+
+void ISMIndex::zoneChanged (uInt colnr, uInt rownr, Bool fromRow)
+{
+    if (! zoneMaps_p.empty()) {
+	std::map<uInt,StManZoneMap>::iterator iter = zoneMaps_p.find (colnr);
+	if (iter != zoneMaps_p.end()) {
+	    if (fromRow) {
+		iter->second.setStaleFrom (getIndex (rownr));
+	    } else {
+		iter->second.setStale (getIndex (rownr));
+	    }
+	}
+    }
+}
+
 void ISMIndex::show (ostream& os) const
 {
     os << "ISMIndex " << nused_p << " strow:bucket";
@@ -31,6 +31,8 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Containers/Block.h>
+#include <casacore/tables/DataMan/StManZoneMap.h>
+#include <map>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -65,6 +67,9 @@ class AipsIO;
 // When the ISM is closed or flushed, the index is written back after
 // all buckets in the file. A little header at the beginning of the file
 // indicates the starting offset of the index.
+// <br>The index also contains the zone maps (the minimum and maximum value
+// per bucket, see <linkto class=StManZoneMap>StManZoneMap</linkto>)
+// of the columns having one.
 // </synopsis> 
 
 // <motivation>
@@ -127,6 +132,20 @@ public:
     // Show the index.
     void show (std::ostream&) const;
 
+    // Get the zone map of the given column.
+    // If it does not exist yet, it is created (with all zones stale) if
+    // <src>create</src> is True, otherwise a null pointer is returned.
+    StManZoneMap* getZoneMap (uInt colnr, Bool create);
+
+    // Mark the zone containing the given row as stale for the given
+    // column (if it has a zone map). If <src>fromRow</src> is True,
+    // all zones from that row on are marked as stale.
+    void zoneChanged (uInt colnr, uInt rownr, Bool fromRow);
+
+    // Get the start row and number of rows of the given zone (i.e. bucket).
+    void getZoneRows (uInt zone, uInt& startRow, uInt& nrrow) const
+        { startRow = rows_p[zone]; nrrow = rows_p[zone+1] - startRow; }
+
 private:
     // Forbid copy constructor.
     ISMIndex (const ISMIndex&);
@@ -147,6 +166,8 @@ private:
     Block<uInt>       rows_p;
     // Corresponding bucket number.
     Block<uInt>       bucketNr_p;
+    // Zone maps of the columns keyed on column number.
+    std::map<uInt,StManZoneMap> zoneMaps_p;
 };
 
 
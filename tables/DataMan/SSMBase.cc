@@ -919,6 +919,20 @@ char* SSMBase::find(uInt aRowNr,     uInt aColNr,
 
 
 
+SSMIndex& SSMBase::getColumnIndex (uInt aColNr, Int& anOffset)
+{
+  // Make sure that cache is available and filled.
+  getCache();
+  anOffset = itsColumnOffset[aColNr];
+  return *(itsPtrIndex[itsColIndexMap[aColNr]]);
+}
+
+void SSMBase::zoneChanged (uInt aColNr, uInt aRowNr)
+{
+  itsPtrIndex[itsColIndexMap[aColNr]]->zoneChanged (itsColumnOffset[aColNr],
+                                                    aRowNr);
+}
+
 void SSMBase::recreate()
 {
   delete itsCache;
@@ -960,6 +974,13 @@ Bool SSMBase::flush (AipsIO& ios, Bool doFsync)
   //# Check if anything has changed.
   Bool changed = False;
 
+  // Recalculate the zones of changed buckets before writing the index.
+  if (isDataChanged) {
+    for (uInt i=0; i<ncolumn(); i++) {
+      itsPtrColumn[i]->updateZoneMap();
+    }
+  }
+
   if (itsStringHandler) {
     itsStringHandler->flush();
   }
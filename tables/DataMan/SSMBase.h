@@ -255,6 +255,14 @@ public:
   // Get access to the given Index.
   SSMIndex& getIndex (uInt anIdxNr);
   
+  // Get the index used by the given column and the offset of the column
+  // in the buckets of that index.
+  SSMIndex& getColumnIndex (uInt aColNr, Int& anOffset);
+
+  // Tell the index of the given column that its data in the given row
+  // has changed, so the zone containing it has to be recalculated.
+  void zoneChanged (uInt aColNr, uInt aRowNr);
+
   // Make the current bucket in the cache dirty (i.e. something has been
   // changed in it and it needs to be written when removed from the cache).
   // (used by SSMColumn::putValue).
@@ -27,6 +27,7 @@
 
 #include <casacore/tables/DataMan/SSMColumn.h>
 #include <casacore/tables/DataMan/SSMBase.h>
+#include <casacore/tables/DataMan/SSMIndex.h>
 #include <casacore/tables/DataMan/SSMStringHandler.h>
 #include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Arrays/Array.h>
@@ -37,6 +38,7 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/LECanonicalConversion.h>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -460,6 +462,7 @@ void SSMColumn::putValue(uInt aRowNr, const void* aValue)
   itsWriteFunc (aDummy+(aRowNr-aStartRow)*itsExternalSizeBytes,
   		aValue, itsNrCopy);
   itsSSMPtr->setBucketDirty();
+  itsSSMPtr->zoneChanged (itsColNr, aRowNr);
 }
 
 void SSMColumn::putValueShortString(uInt aRowNr, const void* aValue,
@@ -692,12 +695,125 @@ void SSMColumn::putColumnValue(const void* anArray,uInt aNrRows)
     itsWriteFunc (aValPtr, aDataPtr, aNr * itsNrCopy);
     aDataPtr += aNr * itsLocalSize;
     itsSSMPtr->setBucketDirty();
+    itsSSMPtr->zoneChanged (itsColNr, aStartRow);
   }
 
   // Be sure cache will be emptied
   columnCache().invalidate();
 }
 
+#define SSMCOLUMN_GETPUTCELLS(T,NM) \
+void SSMColumn::aips_name2(getScalarColumnCells,NM) (const RefRows& aRowNrs, \
+                                                     Vector<T>* aDataPtr) \
+{ \
+  Bool deleteIt; \
+  T* anArray = aDataPtr->getStorage (deleteIt); \
+  getColumnCellsValue (aRowNrs, anArray); \
+  aDataPtr->putStorage (anArray, deleteIt); \
+} \
+void SSMColumn::aips_name2(putScalarColumnCells,NM) (const RefRows& aRowNrs, \
+                                                     const Vector<T>* aDataPtr) \
+{ \
+  Bool deleteIt; \
+  const T* anArray = aDataPtr->getStorage (deleteIt); \
+  putColumnCellsValue (aRowNrs, anArray); \
+  aDataPtr->freeStorage (anArray, deleteIt); \
+}
+
+SSMCOLUMN_GETPUTCELLS(Bool,BoolV)
+SSMCOLUMN_GETPUTCELLS(uChar,uCharV)
+SSMCOLUMN_GETPUTCELLS(Short,ShortV)
+SSMCOLUMN_GETPUTCELLS(uShort,uShortV)
+SSMCOLUMN_GETPUTCELLS(Int,IntV)
+SSMCOLUMN_GETPUTCELLS(uInt,uIntV)
+SSMCOLUMN_GETPUTCELLS(float,floatV)
+SSMCOLUMN_GETPUTCELLS(double,doubleV)
+SSMCOLUMN_GETPUTCELLS(Complex,ComplexV)
+SSMCOLUMN_GETPUTCELLS(DComplex,DComplexV)
+
+void SSMColumn::getColumnCellsValue (const RefRows& aRowNrs, void* anArray)
+{
+  char* aDataPtr = static_cast<char*>(anArray);
+  Bool isBool = (dataType() == TpBool);
+  uInt aLocalSize = (isBool  ?  itsNrCopy*sizeof(Bool) : itsLocalSize);
+  // The bucket found last is kept, so rows in an unsorted row vector
+  // only cause a lookup when they are in another bucket.
+  uInt  aStartRow = 1;
+  uInt  anEndRow  = 0;
+  char* aValue    = 0;
+  RefRowsSliceIter iter(aRowNrs);
+  while (! iter.pastEnd()) {
+    uInt aRowNr = iter.sliceStart();
+    uInt anEnd  = iter.sliceEnd();
+    uInt anIncr = iter.sliceIncr();
+    while (aRowNr <= anEnd) {
+      if (aRowNr < aStartRow  ||  aRowNr > anEndRow) {
+        aValue = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
+                                  columnName());
+      }
+      uInt aLast = min (anEnd, anEndRow);
+      // Rows of a slice in the bucket; consecutive rows in one go.
+      uInt aNr = (anIncr == 1  ?  aLast-aRowNr+1 : 1);
+      while (aRowNr <= aLast) {
+        if (isBool) {
+          uInt anOff = (aRowNr-aStartRow) * itsNrCopy;
+          Conversion::bitToBool (aDataPtr, aValue + anOff/8, anOff%8,
+                                 aNr * itsNrCopy);
+        } else {
+          itsReadFunc (aDataPtr,
+                       aValue + (aRowNr-aStartRow)*itsExternalSizeBytes,
+                       aNr * itsNrCopy);
+        }
+        aDataPtr += aNr * aLocalSize;
+        aRowNr   += aNr * anIncr;
+      }
+    }
+    iter++;
+  }
+}
+
+void SSMColumn::putColumnCellsValue (const RefRows& aRowNrs,
+                                     const void* anArray)
+{
+  const char* aDataPtr = static_cast<const char*>(anArray);
+  Bool isBool = (dataType() == TpBool);
+  uInt aLocalSize = (isBool  ?  itsNrCopy*sizeof(Bool) : itsLocalSize);
+  uInt  aStartRow = 1;
+  uInt  anEndRow  = 0;
+  char* aValPtr   = 0;
+  RefRowsSliceIter iter(aRowNrs);
+  while (! iter.pastEnd()) {
+    uInt aRowNr = iter.sliceStart();
+    uInt anEnd  = iter.sliceEnd();
+    uInt anIncr = iter.sliceIncr();
+    while (aRowNr <= anEnd) {
+      if (aRowNr < aStartRow  ||  aRowNr > anEndRow) {
+        aValPtr = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
+                                   columnName());
+        itsSSMPtr->setBucketDirty();
+        itsSSMPtr->zoneChanged (itsColNr, aRowNr);
+      }
+      uInt aLast = min (anEnd, anEndRow);
+      uInt aNr = (anIncr == 1  ?  aLast-aRowNr+1 : 1);
+      while (aRowNr <= aLast) {
+        if (isBool) {
+          uInt anOff = (aRowNr-aStartRow) * itsNrCopy;
+          Conversion::boolToBit (aValPtr + anOff/8, aDataPtr, anOff%8,
+                                 aNr * itsNrCopy);
+        } else {
+          itsWriteFunc (aValPtr + (aRowNr-aStartRow)*itsExternalSizeBytes,
+                        aDataPtr, aNr * itsNrCopy);
+        }
+        aDataPtr += aNr * aLocalSize;
+        aRowNr   += aNr * anIncr;
+      }
+    }
+    iter++;
+  }
+  // Be sure cache will be emptied
+  columnCache().invalidate();
+}
+
 void SSMColumn::removeColumn()
 {
   if (dataType() == TpString  &&  itsMaxLen == 0) {
@@ -710,6 +826,66 @@ void SSMColumn::removeColumn()
     }
   }
 }
+
+Bool SSMColumn::getZoneMap (Vector<uInt>& startRows,
+                            Vector<Double>& minValues,
+                            Vector<Double>& maxValues,
+                            Bool create)
+{
+  DataType aDT = static_cast<DataType>(dataType());
+  if (itsNrCopy != 1  ||  !StManZoneMap::canHaveZoneMap (aDT)) {
+    return False;
+  }
+  Int anOffset;
+  SSMIndex& anIndex = itsSSMPtr->getColumnIndex (itsColNr, anOffset);
+  StManZoneMap* aZoneMap = anIndex.getZoneMap (anOffset, create);
+  if (aZoneMap == 0) {
+    return False;
+  }
+  fillZoneMap (anIndex, *aZoneMap);
+  uInt aNrZone = aZoneMap->nzone();
+  startRows.resize (aNrZone);
+  minValues.resize (aNrZone);
+  maxValues.resize (aNrZone);
+  for (uInt i=0; i<aNrZone; i++) {
+    uInt anEndRow;
+    anIndex.getZoneRows (i, startRows[i], anEndRow);
+    minValues[i] = aZoneMap->minValue(i);
+    maxValues[i] = aZoneMap->maxValue(i);
+  }
+  return True;
+}
+
+void SSMColumn::updateZoneMap()
+{
+  Int anOffset;
+  SSMIndex& anIndex = itsSSMPtr->getColumnIndex (itsColNr, anOffset);
+  StManZoneMap* aZoneMap = anIndex.getZoneMap (anOffset, False);
+  if (aZoneMap != 0) {
+    fillZoneMap (anIndex, *aZoneMap);
+  }
+}
+
+void SSMColumn::fillZoneMap (SSMIndex& anIndex, StManZoneMap& aZoneMap)
+{
+  DataType aDT = static_cast<DataType>(dataType());
+  Block<char> aBuffer;
+  for (uInt i=0; i<aZoneMap.nzone(); i++) {
+    if (aZoneMap.isStale(i)) {
+      uInt aStartRow, anEndRow;
+      anIndex.getZoneRows (i, aStartRow, anEndRow);
+      uInt aNr = anEndRow - aStartRow + 1;
+      char* aValPtr = itsSSMPtr->find (aStartRow, itsColNr,
+                                       aStartRow, anEndRow, columnName());
+      aBuffer.resize (aNr * itsLocalSize, False, False);
+      itsReadFunc (aBuffer.storage(), aValPtr, aNr);
+      Double aMin =  std::numeric_limits<Double>::infinity();
+      Double aMax = -std::numeric_limits<Double>::infinity();
+      StManZoneMap::getMinMax (aDT, aBuffer.storage(), aNr, aMin, aMax);
+      aZoneMap.setZone (i, aMin, aMax);
+    }
+  }
+}
   
 void SSMColumn::init()
 {
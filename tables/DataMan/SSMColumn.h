@@ -36,6 +36,7 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/OS/Conversion.h>
+#include <casacore/tables/DataMan/StManZoneMap.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -194,6 +195,59 @@ public:
   virtual void putScalarColumnDComplexV (const Vector<DComplex>* aDataPtr);
   virtual void putScalarColumnStringV   (const Vector<String>* aDataPtr);
   // </group>
+
+  // Get the scalar values in some cells of the column.
+  // The cells are gathered per data bucket, so each bucket containing
+  // requested rows is located and converted only once per row range.
+  // Strings are read using the default implementation.
+  // <group>
+  virtual void getScalarColumnCellsBoolV     (const RefRows& aRowNrs,
+                                              Vector<Bool>* aDataPtr);
+  virtual void getScalarColumnCellsuCharV    (const RefRows& aRowNrs,
+                                              Vector<uChar>* aDataPtr);
+  virtual void getScalarColumnCellsShortV    (const RefRows& aRowNrs,
+                                              Vector<Short>* aDataPtr);
+  virtual void getScalarColumnCellsuShortV   (const RefRows& aRowNrs,
+                                              Vector<uShort>* aDataPtr);
+  virtual void getScalarColumnCellsIntV      (const RefRows& aRowNrs,
+                                              Vector<Int>* aDataPtr);
+  virtual void getScalarColumnCellsuIntV     (const RefRows& aRowNrs,
+                                              Vector<uInt>* aDataPtr);
+  virtual void getScalarColumnCellsfloatV    (const RefRows& aRowNrs,
+                                              Vector<float>* aDataPtr);
+  virtual void getScalarColumnCellsdoubleV   (const RefRows& aRowNrs,
+                                              Vector<double>* aDataPtr);
+  virtual void getScalarColumnCellsComplexV  (const RefRows& aRowNrs,
+                                              Vector<Complex>* aDataPtr);
+  virtual void getScalarColumnCellsDComplexV (const RefRows& aRowNrs,
+                                              Vector<DComplex>* aDataPtr);
+  // </group>
+
+  // Put the scalar values into some cells of the column.
+  // The cells are scattered per data bucket.
+  // It invalidates the cache.
+  // <group>
+  virtual void putScalarColumnCellsBoolV     (const RefRows& aRowNrs,
+                                              const Vector<Bool>* aDataPtr);
+  virtual void putScalarColumnCellsuCharV    (const RefRows& aRowNrs,
+                                              const Vector<uChar>* aDataPtr);
+  virtual void putScalarColumnCellsShortV    (const RefRows& aRowNrs,
+                                              const Vector<Short>* aDataPtr);
+  virtual void putScalarColumnCellsuShortV   (const RefRows& aRowNrs,
+                                              const Vector<uShort>* aDataPtr);
+  virtual void putScalarColumnCellsIntV      (const RefRows& aRowNrs,
+                                              const Vector<Int>* aDataPtr);
+  virtual void putScalarColumnCellsuIntV     (const RefRows& aRowNrs,
+                                              const Vector<uInt>* aDataPtr);
+  virtual void putScalarColumnCellsfloatV    (const RefRows& aRowNrs,
+                                              const Vector<float>* aDataPtr);
+  virtual void putScalarColumnCellsdoubleV   (const RefRows& aRowNrs,
+                                              const Vector<double>* aDataPtr);
+  virtual void putScalarColumnCellsComplexV  (const RefRows& aRowNrs,
+                                              const Vector<Complex>* aDataPtr);
+  virtual void putScalarColumnCellsDComplexV (const RefRows& aRowNrs,
+                                              const Vector<DComplex>* aDataPtr);
+  // </group>
   
   // Add (NewNrRows-OldNrRows) rows to the Column and initialize
   // the new rows when needed.
@@ -219,12 +273,29 @@ public:
   // as is the case with Strings, it can be done here.
   void removeColumn();
 
+  // Get the zone map (minimum and maximum per bucket) of the column.
+  // If not existing yet, it is created if <src>create=True</src>, which
+  // requires reading all data.
+  // It returns False if the column is not numeric or not scalar, or if
+  // it has no zone map.
+  virtual Bool getZoneMap (Vector<uInt>& startRows,
+                           Vector<Double>& minValues,
+                           Vector<Double>& maxValues,
+                           Bool create);
+
+  // Recalculate the stale zones if the column has a zone map.
+  // It is called before the index is written.
+  void updateZoneMap();
+
 protected:
   // Shift the rows in the bucket one to the left when removing the given row.
   void shiftRows (char* aValue, uInt rowNr, uInt startRow, uInt endRow);
 
   // Fill the cache with data of the bucket containing the given row.
   void getValue (uInt aRowNr);
+
+  // Recalculate the stale zones in the zone map of the column.
+  void fillZoneMap (SSMIndex& anIndex, StManZoneMap& aZoneMap);
   
   // Get the bucketnr, offset, and length of a variable length string.
   // <src>data</src> must have 3 Ints to hold the values.
@@ -249,6 +320,17 @@ protected:
   // Each data bucket is filled with the the appropriate part of the array.
   void putColumnValue (const void* anArray, uInt aNrRows);
 
+  // Get the values for the given rows.
+  // Consecutive rows in the same data bucket are converted in one go.
+  // It can also be used for direct arrays (in which case each row
+  // contains an entire array).
+  void getColumnCellsValue (const RefRows& aRowNrs, void* anArray);
+
+  // Put the values for the given rows.
+  // Consecutive rows in the same data bucket are converted in one go.
+  // It can also be used for direct arrays.
+  void putColumnCellsValue (const RefRows& aRowNrs, const void* anArray);
+
 
   // Pointer to the parent storage manager.
   SSMBase*          itsSSMPtr;
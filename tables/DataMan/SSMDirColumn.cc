@@ -27,6 +27,7 @@
 
 #include <casacore/tables/DataMan/SSMDirColumn.h>
 #include <casacore/tables/DataMan/SSMStringHandler.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Utilities/ValType.h>
 
@@ -182,6 +183,35 @@ void SSMDirColumn::getArrayStringV (uInt aRowNr,
   itsSSMPtr->getStringHandler()->get(*aDataPtr, buf[0], buf[1], buf[2],False);
 }
 
+#define SSMDIRCOLUMN_GETPUTCELLS(T,NM) \
+void SSMDirColumn::aips_name2(getArrayColumnCells,NM) (const RefRows& rownrs, \
+                                                       Array<T>* aDataPtr) \
+{ \
+  Bool deleteIt; \
+  T* data = aDataPtr->getStorage (deleteIt); \
+  getColumnCellsValue (rownrs, data); \
+  aDataPtr->putStorage (data, deleteIt); \
+} \
+void SSMDirColumn::aips_name2(putArrayColumnCells,NM) (const RefRows& rownrs, \
+                                                       const Array<T>* aDataPtr) \
+{ \
+  Bool deleteIt; \
+  const T* data = aDataPtr->getStorage (deleteIt); \
+  putColumnCellsValue (rownrs, data); \
+  aDataPtr->freeStorage (data, deleteIt); \
+}
+
+SSMDIRCOLUMN_GETPUTCELLS(Bool,BoolV)
+SSMDIRCOLUMN_GETPUTCELLS(uChar,uCharV)
+SSMDIRCOLUMN_GETPUTCELLS(Short,ShortV)
+SSMDIRCOLUMN_GETPUTCELLS(uShort,uShortV)
+SSMDIRCOLUMN_GETPUTCELLS(Int,IntV)
+SSMDIRCOLUMN_GETPUTCELLS(uInt,uIntV)
+SSMDIRCOLUMN_GETPUTCELLS(float,floatV)
+SSMDIRCOLUMN_GETPUTCELLS(double,doubleV)
+SSMDIRCOLUMN_GETPUTCELLS(Complex,ComplexV)
+SSMDIRCOLUMN_GETPUTCELLS(DComplex,DComplexV)
+
 void SSMDirColumn::getValue(uInt aRowNr, void* data)
 {
   uInt  aStartRow;
@@ -120,6 +120,56 @@ public:
   virtual void putArrayStringV   (uInt rownr, const Array<String>* dataPtr);
   // </group>
 
+  // Get the arrays in some cells of the column.
+  // The cells are gathered per data bucket.
+  // <group>
+  virtual void getArrayColumnCellsBoolV     (const RefRows& rownrs,
+                                             Array<Bool>* dataPtr);
+  virtual void getArrayColumnCellsuCharV    (const RefRows& rownrs,
+                                             Array<uChar>* dataPtr);
+  virtual void getArrayColumnCellsShortV    (const RefRows& rownrs,
+                                             Array<Short>* dataPtr);
+  virtual void getArrayColumnCellsuShortV   (const RefRows& rownrs,
+                                             Array<uShort>* dataPtr);
+  virtual void getArrayColumnCellsIntV      (const RefRows& rownrs,
+                                             Array<Int>* dataPtr);
+  virtual void getArrayColumnCellsuIntV     (const RefRows& rownrs,
+                                             Array<uInt>* dataPtr);
+  virtual void getArrayColumnCellsfloatV    (const RefRows& rownrs,
+                                             Array<float>* dataPtr);
+  virtual void getArrayColumnCellsdoubleV   (const RefRows& rownrs,
+                                             Array<double>* dataPtr);
+  virtual void getArrayColumnCellsComplexV  (const RefRows& rownrs,
+                                             Array<Complex>* dataPtr);
+  virtual void getArrayColumnCellsDComplexV (const RefRows& rownrs,
+                                             Array<DComplex>* dataPtr);
+  // </group>
+
+  // Put the arrays into some cells of the column.
+  // The cells are scattered per data bucket.
+  // <group>
+  virtual void putArrayColumnCellsBoolV     (const RefRows& rownrs,
+                                             const Array<Bool>* dataPtr);
+  virtual void putArrayColumnCellsuCharV    (const RefRows& rownrs,
+                                             const Array<uChar>* dataPtr);
+  virtual void putArrayColumnCellsShortV    (const RefRows& rownrs,
+                                             const Array<Short>* dataPtr);
+  virtual void putArrayColumnCellsuShortV   (const RefRows& rownrs,
+                                             const Array<uShort>* dataPtr);
+  virtual void putArrayColumnCellsIntV      (const RefRows& rownrs,
+                                             const Array<Int>* dataPtr);
+  virtual void putArrayColumnCellsuIntV     (const RefRows& rownrs,
+                                             const Array<uInt>* dataPtr);
+  virtual void putArrayColumnCellsfloatV    (const RefRows& rownrs,
+                                             const Array<float>* dataPtr);
+  virtual void putArrayColumnCellsdoubleV   (const RefRows& rownrs,
+                                             const Array<double>* dataPtr);
+  virtual void putArrayColumnCellsComplexV  (const RefRows& rownrs,
+                                             const Array<Complex>* dataPtr);
+  virtual void putArrayColumnCellsDComplexV (const RefRows& rownrs,
+                                             const Array<DComplex>* dataPtr);
+  // </group>
+
   // Remove the given row from the data bucket and possibly string bucket.
   virtual void deleteRow(uInt aRowNr);
 
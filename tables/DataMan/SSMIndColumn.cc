@@ -100,6 +100,12 @@ void SSMIndColumn::addRow (uInt aNewNrRows, uInt anOldNrRows, Bool doInit)
   }
 }
 
+Bool SSMIndColumn::getZoneMap (Vector<uInt>&, Vector<Double>&,
+                               Vector<Double>&, Bool)
+{
+  return False;
+}
+
 void SSMIndColumn::setShapeColumn (const IPosition& aShape)
 {
     itsFixedShape  = aShape;
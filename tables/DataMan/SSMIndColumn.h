@@ -110,6 +110,12 @@ public:
   
   // Add (newNrrow-oldNrrow) rows to the column.
   virtual void addRow (uInt aNewNrRows, uInt anOldNrRows, Bool doInit);
+
+  // An indirect array column has no zone map.
+  virtual Bool getZoneMap (Vector<uInt>& startRows,
+                           Vector<Double>& minValues,
+                           Vector<Double>& maxValues,
+                           Bool create);
   
   // Set the (fixed) shape of the arrays in the entire column.
   virtual void setShapeColumn (const IPosition& aShape);
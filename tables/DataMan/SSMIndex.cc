@@ -55,25 +55,45 @@ SSMIndex::~SSMIndex()
 
 void SSMIndex::get (AipsIO& anOs)
 {
-  anOs.getstart("SSMIndex");
+  uInt version = anOs.getstart("SSMIndex");
   anOs >> itsNUsed;
   anOs >> itsRowsPerBucket;
   anOs >> itsNrColumns;
   anOs >> itsFreeSpace;
   getBlock (anOs, itsLastRow);
   getBlock (anOs, itsBucketNumber);
+  itsZoneMaps.clear();
+  if (version >= 2) {
+    uInt aNrMaps;
+    anOs >> aNrMaps;
+    for (uInt i=0; i<aNrMaps; i++) {
+      Int anOffset;
+      anOs >> anOffset;
+      itsZoneMaps[anOffset].get (anOs);
+    }
+  }
   anOs.getend();
 }
 
 void SSMIndex::put (AipsIO& anOs) const
 {
-  anOs.putstart("SSMIndex", 1);
+  // Only use the new version if zone maps are used, so older software
+  // can still read the index.
+  anOs.putstart("SSMIndex", itsZoneMaps.empty() ? 1 : 2);
   anOs << itsNUsed;
   anOs << itsRowsPerBucket;
   anOs << itsNrColumns;
   anOs << itsFreeSpace;
   putBlock (anOs, itsLastRow, itsNUsed);
   putBlock (anOs, itsBucketNumber, itsNUsed);
+  if (! itsZoneMaps.empty()) {
+    anOs << uInt(itsZoneMaps.size());
+    for (std::map<Int,StManZoneMap>::const_iterator iter=itsZoneMaps.begin();
+         iter!=itsZoneMaps.end(); ++iter) {
+      anOs << iter->first;
+      iter->second.put (anOs);
+    }
+  }
   anOs.putend();
 }
 
@@ -127,6 +147,12 @@ void SSMIndex::addRow (uInt aNrRows)
     itsLastRow[itsNUsed-1] += toAdd;
     aNrRows -= toAdd;
     lastRow += toAdd;
+    if (toAdd > 0) {
+      for (std::map<Int,StManZoneMap>::iterator iter=itsZoneMaps.begin();
+           iter!=itsZoneMaps.end(); ++iter) {
+        iter->second.setStale (itsNUsed-1);
+      }
+    }
   }
  
   if (aNrRows == 0) {
@@ -160,6 +186,10 @@ void SSMIndex::addRow (uInt aNrRows)
     aNrRows -= toAdd;
     itsLastRow[itsNUsed] = lastRow-1;
     itsNUsed += 1;
+    for (std::map<Int,StManZoneMap>::iterator iter=itsZoneMaps.begin();
+         iter!=itsZoneMaps.end(); ++iter) {
+      iter->second.addZones (1);
+    }
   }
 }
 
@@ -199,6 +229,10 @@ Int SSMIndex::deleteRow (uInt aRowNr)
     itsNUsed--;
     itsLastRow[itsNUsed]=0;
     itsBucketNumber[itsNUsed]=0;
+    for (std::map<Int,StManZoneMap>::iterator iter=itsZoneMaps.begin();
+         iter!=itsZoneMaps.end(); ++iter) {
+      iter->second.removeZone (anIndex);
+    }
   }
   return anEmptyBucket;
 }
@@ -207,6 +241,10 @@ Int SSMIndex::deleteRow (uInt aRowNr)
 void SSMIndex::recreate()
 {
   itsNUsed=0;
+  for (std::map<Int,StManZoneMap>::iterator iter=itsZoneMaps.begin();
+       iter!=itsZoneMaps.end(); ++iter) {
+    iter->second = StManZoneMap();
+  }
 }
 
 
@@ -229,6 +267,7 @@ Int SSMIndex::removeColumn (Int anOffset, uInt nbits)
   // set freespace (total in bytes).
   uInt aLength = (itsRowsPerBucket * nbits + 7) / 8;
   itsFreeSpace.define(anOffset,aLength);
+  itsZoneMaps.erase (anOffset);
  
   itsNrColumns--;
   AlwaysAssert (itsNrColumns > -1, AipsError);
@@ -294,6 +333,7 @@ void SSMIndex::addColumn (Int anOffset, uInt nbits)
   Int aLength = (itsRowsPerBucket * nbits + 7) / 8;
   Int aV = itsFreeSpace(anOffset);
   itsNrColumns++;
+  itsZoneMaps.erase (anOffset);
   itsFreeSpace.remove(anOffset);
   if (aLength != aV) {
     DebugAssert (aLength < aV, AipsError);
@@ -317,5 +357,38 @@ void SSMIndex::find (uInt aRowNumber, uInt& aBucketNr,
   }
 }
 
+StManZoneMap* SSMIndex::getZoneMap (Int anOffset, Bool create)
+{
+  std::map<Int,StManZoneMap>::iterator iter = itsZoneMaps.find (anOffset);
+  if (iter == itsZoneMaps.end()) {
+    if (!create) {
+      return 0;
+    }
+    iter = itsZoneMaps.insert (std::make_pair (anOffset,
+                                               StManZoneMap(itsNUsed))).first;
+  }
+  return &(iter->second);
+}
+
+void SSMIndex::zoneChanged (Int anOffset, uInt aRowNr)
+{
+  if (! itsZoneMaps.empty()) {
+    std::map<Int,StManZoneMap>::iterator iter = itsZoneMaps.find (anOffset);
+    if (iter != itsZoneMaps.end()) {
+      iter->second.setStale (getIndex (aRowNr, String()));
+    }
+  }
+}
+
+void SSMIndex::getZoneRows (uInt aZone, uInt& aStartRow,
+                            uInt& anEndRow) const
+{
+  anEndRow = itsLastRow[aZone];
+  aStartRow = 0;
+  if (aZone > 0) {
+    aStartRow = itsLastRow[aZone-1]+1;
+  }
+}
+
 } //# NAMESPACE CASACORE - END
 
@@ -32,6 +32,8 @@
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Containers/SimOrdMap.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/tables/DataMan/StManZoneMap.h>
+#include <map>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -74,6 +76,10 @@ class SSMBase;
 //       When a new column is added <linkto class=SSMBase>SSMBase</linkto>
 //       will scan the SSMIndex objects to find the hole fitting best.
 // </ol>
+// It also keeps the zone maps (the minimum and maximum value per bucket,
+// see <linkto class=StManZoneMap>StManZoneMap</linkto>) of the columns
+// using this index. They are keyed on the offset of the column in the
+// bucket and written as part of the index.
 // </synopsis>
   
 // <todo asof="$DATE:$">
@@ -143,6 +149,18 @@ public:
   void find (uInt aRowNumber, uInt& aBucketNr, uInt& aStartRow,
 	     uInt& anEndRow, const String& colName) const;
 
+  // Get the zone map of the column at the given offset in the buckets.
+  // If it does not exist yet, it is created (with all zones stale) if
+  // <src>create</src> is True, otherwise a null pointer is returned.
+  StManZoneMap* getZoneMap (Int anOffset, Bool create);
+
+  // Mark the zone containing the given row as stale for the column
+  // at the given offset (if that column has a zone map).
+  void zoneChanged (Int anOffset, uInt aRowNr);
+
+  // Get the first and last row number of the given zone (i.e. bucket).
+  void getZoneRows (uInt aZone, uInt& aStartRow, uInt& anEndRow) const;
+
 private:
   // Get the index of the bucket containing the given row.
   uInt getIndex (uInt aRowNr, const String& colName) const;
@@ -170,6 +188,9 @@ private:
 
   //# Nr of columns using this index.
   Int itsNrColumns;
+
+  //# Zone maps of the columns keyed on their offset in the buckets.
+  std::map<Int,StManZoneMap> itsZoneMaps;
 };
 
 
@@ -0,0 +1,196 @@
+//# StManZoneMap.cc: Minimum and maximum value per bucket of a column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/DataMan/StManZoneMap.h>
+#include <casacore/casa/Containers/BlockIO.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Copy.h>
+#include <casacore/casa/Exceptions/Error.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+StManZoneMap::StManZoneMap (uInt nzone)
+: nzone_p (nzone),
+  min_p   (nzone, 0.),
+  max_p   (nzone, 0.),
+  valid_p (nzone, False)
+{}
+
+void StManZoneMap::insertZone (uInt zone)
+{
+    addZones (1);
+    if (zone < nzone_p-1) {
+        objmove (&min_p[zone+1], &min_p[zone], nzone_p-1-zone);
+        objmove (&max_p[zone+1], &max_p[zone], nzone_p-1-zone);
+        objmove (&valid_p[zone+1], &valid_p[zone], nzone_p-1-zone);
+    }
+    valid_p[zone] = False;
+}
+
+void StManZoneMap::removeZone (uInt zone)
+{
+    if (zone+1 < nzone_p) {
+        objmove (&min_p[zone], &min_p[zone+1], nzone_p-1-zone);
+        objmove (&max_p[zone], &max_p[zone+1], nzone_p-1-zone);
+        objmove (&valid_p[zone], &valid_p[zone+1], nzone_p-1-zone);
+    }
+    nzone_p--;
+}
+
+void StManZoneMap::addZones (uInt nzone)
+{
+    uInt newSize = nzone_p + nzone;
+    if (newSize > valid_p.nelements()) {
+        // Grow at least by a factor 2 to avoid many small resizes.
+        newSize = max (newSize, 2*nzone_p);
+        min_p.resize (newSize);
+        max_p.resize (newSize);
+        valid_p.resize (newSize);
+    }
+    for (uInt i=0; i<nzone; ++i) {
+        valid_p[nzone_p++] = False;
+    }
+}
+
+void StManZoneMap::setStaleFrom (uInt zone)
+{
+    for (uInt i=zone; i<nzone_p; ++i) {
+        valid_p[i] = False;
+    }
+}
+
+Bool StManZoneMap::hasStale() const
+{
+    for (uInt i=0; i<nzone_p; ++i) {
+        if (!valid_p[i]) {
+            return True;
+        }
+    }
+    return False;
+}
+
+void StManZoneMap::setZone (uInt zone, Double minValue, Double maxValue)
+{
+    min_p[zone]   = minValue;
+    max_p[zone]   = maxValue;
+    valid_p[zone] = True;
+}
+
+void StManZoneMap::get (AipsIO& os)
+{
+    os.getstart ("StManZoneMap");
+    os >> nzone_p;
+    getBlock (os, min_p);
+    getBlock (os, max_p);
+    getBlock (os, valid_p);
+    os.getend();
+}
+
+void StManZoneMap::put (AipsIO& os) const
+{
+    os.putstart ("StManZoneMap", 1);
+    os << nzone_p;
+    putBlock (os, min_p, nzone_p);
+    putBlock (os, max_p, nzone_p);
+    putBlock (os, valid_p, nzone_p);
+    os.putend();
+}
+
+Bool StManZoneMap::canHaveZoneMap (DataType dtype)
+{
+    switch (dtype) {
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpFloat:
+    case TpDouble:
+        return True;
+    default:
+        return False;
+    }
+}
+
+template<typename T>
+static void zoneMinMax (const T* values, uInt nvalues,
+                        Double& minValue, Double& maxValue)
+{
+    for (uInt i=0; i<nvalues; ++i) {
+        Double value = values[i];
+        // NaN values fail both tests, so they are ignored.
+        if (value < minValue) {
+            minValue = value;
+        }
+        if (value > maxValue) {
+            maxValue = value;
+        }
+    }
+}
+
+void StManZoneMap::getMinMax (DataType dtype, const void* values,
+                              uInt nvalues,
+                              Double& minValue, Double& maxValue)
+{
+    switch (dtype) {
+    case TpUChar:
+        zoneMinMax (static_cast<const uChar*>(values), nvalues,
+                    minValue, maxValue);
+        break;
+    case TpShort:
+        zoneMinMax (static_cast<const Short*>(values), nvalues,
+                    minValue, maxValue);
+        break;
+    case TpUShort:
+        zoneMinMax (static_cast<const uShort*>(values), nvalues,
+                    minValue, maxValue);
+        break;
+    case TpInt:
+        zoneMinMax (static_cast<const Int*>(values), nvalues,
+                    minValue, maxValue);
+        break;
+    case TpUInt:
+        zoneMinMax (static_cast<const uInt*>(values), nvalues,
+                    minValue, maxValue);
+        break;
+    case TpFloat:
+        zoneMinMax (static_cast<const Float*>(values), nvalues,
+                    minValue, maxValue);
+        break;
+    case TpDouble:
+        zoneMinMax (static_cast<const Double*>(values), nvalues,
+                    minValue, maxValue);
+        break;
+    default:
+        throw AipsError ("StManZoneMap::getMinMax - invalid data type");
+    }
+}
+
+} //# NAMESPACE CASACORE - END
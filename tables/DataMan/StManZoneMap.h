@@ -0,0 +1,150 @@
+//# StManZoneMap.h: Minimum and maximum value per bucket of a column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_STMANZONEMAP_H
+#define TABLES_STMANZONEMAP_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Utilities/DataType.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+class AipsIO;
+
+
+// <summary>
+// Minimum and maximum value per bucket of a column
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tStManZoneMap.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=SSMIndex>SSMIndex</linkto>
+//   <li> <linkto class=ISMIndex>ISMIndex</linkto>
+// </prerequisite>
+
+// <synopsis>
+// StManZoneMap holds for a scalar numeric column in a bucket-based storage
+// manager the minimum and maximum value of each bucket (a zone).
+// The zones are in the same order as the entries in the storage manager
+// index, so a selection on a range of values can skip all buckets
+// whose zone does not overlap the range.
+// <p>
+// A zone is stale if its bucket has changed since its minimum and maximum
+// were determined. The storage manager recalculates stale zones from the
+// bucket data before the zone map is used or written.
+// The zone map is kept in the storage manager index and written with it.
+// <br>A zone map is only created on explicit request (using
+// <src>TableColumn::getZoneMap</src> with <src>create=True</src>), because
+// an index containing zone maps cannot be read by older casacore versions.
+// Selections only use the zone maps that already exist.
+// </synopsis>
+
+// <motivation>
+// Time selections on a time-ordered table should not need to read all
+// buckets.
+// </motivation>
+
+
+class StManZoneMap
+{
+public:
+    // Create a zone map with the given number of (stale) zones.
+    explicit StManZoneMap (uInt nzone=0);
+
+    // Get the number of zones.
+    uInt nzone() const
+        { return nzone_p; }
+
+    // Insert a stale zone before the given zone.
+    void insertZone (uInt zone);
+
+    // Remove the given zone.
+    void removeZone (uInt zone);
+
+    // Add stale zones at the end.
+    void addZones (uInt nzone);
+
+    // Mark the given zone as stale.
+    void setStale (uInt zone)
+        { valid_p[zone] = False; }
+
+    // Mark all zones from the given zone on as stale.
+    void setStaleFrom (uInt zone);
+
+    // Is the given zone stale?
+    Bool isStale (uInt zone) const
+        { return !valid_p[zone]; }
+
+    // Is any zone stale?
+    Bool hasStale() const;
+
+    // Set the minimum and maximum of a zone and mark it as valid.
+    // A zone without values (or only NaN values) has minimum > maximum.
+    void setZone (uInt zone, Double minValue, Double maxValue);
+
+    // Get the minimum or maximum value of a zone.
+    // <group>
+    Double minValue (uInt zone) const
+        { return min_p[zone]; }
+    Double maxValue (uInt zone) const
+        { return max_p[zone]; }
+    // </group>
+
+    // Read or write the zone map.
+    // <group>
+    void get (AipsIO& os);
+    void put (AipsIO& os) const;
+    // </group>
+
+    // Can a column with the given data type have a zone map?
+    static Bool canHaveZoneMap (DataType dtype);
+
+    // Extend <src>minValue</src> and <src>maxValue</src> with the given
+    // values of the given data type. NaN values are ignored.
+    static void getMinMax (DataType dtype, const void* values, uInt nvalues,
+                           Double& minValue, Double& maxValue);
+
+private:
+    uInt          nzone_p;
+    Block<Double> min_p;
+    Block<Double> max_p;
+    Block<Bool>   valid_p;
+};
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
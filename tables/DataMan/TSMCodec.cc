@@ -0,0 +1,544 @@
+//# TSMCodec.cc: Compression and preconditioning of tiles
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/DataMan/TSMCodec.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <casacore/casa/string.h>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The parameters of the LZ codec.
+//# A match has at least 4 bytes and the last 12 bytes are not searched
+//# for a match (so the match extension need not check the end).
+static const uInt theMinMatch   = 4;
+static const uInt theEndLiteral = 12;
+static const uInt theMaxOffset  = 65535;
+static const uInt theHashLog    = 13;
+
+static inline uInt readUInt32 (const char* p)
+{
+    uInt v;
+    memcpy (&v, p, 4);
+    return v;
+}
+
+static inline uInt64 readUInt64 (const char* p)
+{
+    uInt64 v;
+    memcpy (&v, p, 8);
+    return v;
+}
+
+static inline uInt hashUInt32 (uInt v)
+{
+    return (v * 2654435761u) >> (32 - theHashLog);
+}
+
+//# Write a length that did not fit in the token (as 255s plus remainder).
+static inline char* putLength (char* op, uInt len)
+{
+    while (len >= 255) {
+        *op++ = char(255);
+        len -= 255;
+    }
+    *op++ = char(len);
+    return op;
+}
+
+//# Write a sequence of literals followed by a match (if mlen > 0).
+static inline char* putSequence (char* op, const char* literals, uInt nlit,
+                                 uInt offset, uInt mlen)
+{
+    char* token = op++;
+    uInt tok = (nlit < 15  ?  nlit : 15) << 4;
+    if (nlit >= 15) {
+        op = putLength (op, nlit - 15);
+    }
+    memcpy (op, literals, nlit);
+    op += nlit;
+    if (mlen > 0) {
+        *op++ = char(offset & 255);
+        *op++ = char(offset >> 8);
+        uInt mcode = mlen - theMinMatch;
+        tok |= (mcode < 15  ?  mcode : 15);
+        if (mcode >= 15) {
+            op = putLength (op, mcode - 15);
+        }
+    }
+    *token = char(tok);
+    return op;
+}
+
+uInt TSMCodec::maxCompressedLength (uInt length)
+{
+    return length + length/255 + 16;
+}
+
+uInt TSMCodec::compress (char* out, const char* in, uInt length,
+                         Codec codec)
+{
+    switch (codec) {
+    case LZ:
+        return compressLZ (out, in, length);
+    case RunLength:
+        return compressRunLength (out, in, length);
+    default:
+        break;
+    }
+    memcpy (out, in, length);
+    return length;
+}
+
+void TSMCodec::decompress (char* out, uInt length,
+                           const char* in, uInt inLength, Codec codec)
+{
+    switch (codec) {
+    case LZ:
+        decompressLZ (out, length, in, inLength);
+        break;
+    case RunLength:
+        decompressRunLength (out, length, in, inLength);
+        break;
+    default:
+        if (inLength != length) {
+            throw DataManError ("TSMCodec: invalid uncompressed length");
+        }
+        memcpy (out, in, length);
+        break;
+    }
+}
+
+uInt TSMCodec::compressLZ (char* out, const char* in, uInt length)
+{
+    char* op = out;
+    uInt anchor = 0;
+    if (length > theEndLiteral) {
+        // The hash table contains the position+1 of the last occurrence
+        // of a 4-byte sequence (0 means none).
+        std::vector<uInt> table (1u << theHashLog, 0);
+        uInt limit = length - theEndLiteral;
+        uInt ip = 0;
+        while (ip < limit) {
+            uInt seq = readUInt32 (in + ip);
+            uInt h = hashUInt32 (seq);
+            uInt ref = table[h];
+            table[h] = ip + 1;
+            if (ref > 0  &&  ip - (ref-1) <= theMaxOffset  &&
+                readUInt32 (in + ref - 1) == seq) {
+                ref--;
+                uInt mlen = theMinMatch;
+                while (ip + mlen < limit  &&  in[ref+mlen] == in[ip+mlen]) {
+                    mlen++;
+                }
+                op = putSequence (op, in + anchor, ip - anchor,
+                                  ip - ref, mlen);
+                ip += mlen;
+                anchor = ip;
+            } else {
+                // Skip faster through data without matches.
+                ip += 1 + ((ip - anchor) >> 6);
+            }
+        }
+    }
+    // The last sequence only has literals.
+    op = putSequence (op, in + anchor, length - anchor, 0, 0);
+    return op - out;
+}
+
+void TSMCodec::decompressLZ (char* out, uInt length,
+                             const char* in, uInt inLength)
+{
+    const unsigned char* ip = reinterpret_cast<const unsigned char*>(in);
+    const unsigned char* iend = ip + inLength;
+    uInt op = 0;
+    while (True) {
+        if (ip >= iend) {
+            throw DataManError ("TSMCodec: compressed data are truncated");
+        }
+        uInt tok  = *ip++;
+        uInt nlit = tok >> 4;
+        if (nlit == 15) {
+            uInt v;
+            do {
+                if (ip >= iend) {
+                    throw DataManError ("TSMCodec: invalid literal length");
+                }
+                v = *ip++;
+                nlit += v;
+            } while (v == 255);
+        }
+        if (nlit > uInt(iend - ip)  ||  nlit > length - op) {
+            throw DataManError ("TSMCodec: literals exceed the buffer");
+        }
+        memcpy (out + op, ip, nlit);
+        ip += nlit;
+        op += nlit;
+        if (ip == iend) {
+            break;
+        }
+        // A match follows.
+        if (iend - ip < 2) {
+            throw DataManError ("TSMCodec: compressed data are truncated");
+        }
+        uInt offset = ip[0] + (uInt(ip[1]) << 8);
+        ip += 2;
+        uInt mlen = (tok & 15) + theMinMatch;
+        if ((tok & 15) == 15) {
+            uInt v;
+            do {
+                if (ip >= iend) {
+                    throw DataManError ("TSMCodec: invalid match length");
+                }
+                v = *ip++;
+                mlen += v;
+            } while (v == 255);
+        }
+        if (offset == 0  ||  offset > op  ||  mlen > length - op) {
+            throw DataManError ("TSMCodec: invalid match");
+        }
+        char* dst = out + op;
+        const char* src = dst - offset;
+        if (offset >= mlen) {
+            memcpy (dst, src, mlen);
+        } else {
+            // Overlapping copy (a repeating pattern).
+            for (uInt i=0; i<mlen; i++) {
+                dst[i] = src[i];
+            }
+        }
+        op += mlen;
+    }
+    if (op != length) {
+        throw DataManError ("TSMCodec: decompressed length " +
+                            String::toString(op) + " mismatches " +
+                            String::toString(length));
+    }
+}
+
+//# Write the type and number of words of a run.
+static inline char* putRun (char* op, uInt type, uInt nwords)
+{
+    *op++ = char(type);
+    while (nwords >= 128) {
+        *op++ = char(128 | (nwords & 127));
+        nwords >>= 7;
+    }
+    *op++ = char(nwords);
+    return op;
+}
+
+uInt TSMCodec::compressRunLength (char* out, const char* in, uInt length)
+{
+    static const uInt64 allOnes = ~uInt64(0);
+    char* op = out;
+    uInt nwords = length / 8;
+    uInt i = 0;
+    while (i < nwords) {
+        uInt64 w = readUInt64 (in + 8*i);
+        uInt j = i+1;
+        if (w == 0  ||  w == allOnes) {
+            // A run of equal fill words.
+            while (j < nwords  &&  readUInt64 (in + 8*j) == w) {
+                j++;
+            }
+            op = putRun (op, (w == 0 ? 0 : 1), j-i);
+        } else {
+            // A run of literal words (ended by a fill word).
+            while (j < nwords) {
+                uInt64 v = readUInt64 (in + 8*j);
+                if (v == 0  ||  v == allOnes) {
+                    break;
+                }
+                j++;
+            }
+            op = putRun (op, 2, j-i);
+            memcpy (op, in + 8*i, 8*(j-i));
+            op += 8*(j-i);
+        }
+        i = j;
+    }
+    // Store the remaining bytes.
+    uInt nrem = length - 8*nwords;
+    memcpy (op, in + 8*nwords, nrem);
+    return op + nrem - out;
+}
+
+void TSMCodec::decompressRunLength (char* out, uInt length,
+                                    const char* in, uInt inLength)
+{
+    const unsigned char* ip = reinterpret_cast<const unsigned char*>(in);
+    const unsigned char* iend = ip + inLength;
+    uInt nwords = length / 8;
+    uInt nrem = length - 8*nwords;
+    if (inLength < nrem) {
+        throw DataManError ("TSMCodec: compressed data are truncated");
+    }
+    iend -= nrem;
+    uInt op = 0;
+    while (ip < iend) {
+        uInt type = *ip++;
+        uInt64 n = 0;
+        uInt shift = 0;
+        uInt v;
+        do {
+            if (ip >= iend  ||  shift > 28) {
+                throw DataManError ("TSMCodec: invalid run length");
+            }
+            v = *ip++;
+            n |= uInt64(v & 127) << shift;
+            shift += 7;
+        } while (v & 128);
+        if (type > 2  ||  n > nwords - op/8) {
+            throw DataManError ("TSMCodec: invalid run");
+        }
+        uInt nbytes = 8*n;
+        if (type == 2) {
+            if (nbytes > uInt(iend - ip)) {
+                throw DataManError ("TSMCodec: compressed data are truncated");
+            }
+            memcpy (out + op, ip, nbytes);
+            ip += nbytes;
+        } else {
+            memset (out + op, (type == 0 ? 0 : 255), nbytes);
+        }
+        op += nbytes;
+    }
+    if (op != 8*nwords) {
+        throw DataManError ("TSMCodec: decompressed length " +
+                            String::toString(op+nrem) + " mismatches " +
+                            String::toString(length));
+    }
+    memcpy (out + op, iend, nrem);
+}
+
+void TSMCodec::transposeBits (char* out, const char* in, uInt length)
+{
+    // Each bit plane of 8 consecutive bytes gets its own byte in the
+    // output; the bytes of bit plane j are stored together.
+    // The remaining bytes are copied as such.
+    uInt ngroup = length / 8;
+    for (uInt k=0; k<ngroup; k++) {
+        uInt64 x = 0;
+        for (uInt i=0; i<8; i++) {
+            x |= uInt64(static_cast<unsigned char>(in[8*k+i])) << (8*i);
+        }
+        // Transpose the 8x8 bit matrix (from Hacker's Delight).
+        uInt64 t;
+        t = (x ^ (x >> 7))  & 0x00AA00AA00AA00AAULL;
+        x = x ^ t ^ (t << 7);
+        t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+        x = x ^ t ^ (t << 14);
+        t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+        x = x ^ t ^ (t << 28);
+        for (uInt j=0; j<8; j++) {
+            out[j*ngroup + k] = char(x >> (8*j));
+        }
+    }
+    memcpy (out + 8*ngroup, in + 8*ngroup, length - 8*ngroup);
+}
+
+void TSMCodec::shuffle (char* out, const char* in, uInt nvalues,
+                        uInt valueSize, Shuffle type)
+{
+    uInt length = nvalues * valueSize;
+    if (type == NoShuffle  ||  valueSize == 0) {
+        memcpy (out, in, length);
+        return;
+    }
+    char* to = out;
+    std::vector<char> tmp;
+    if (type == BitShuffle) {
+        tmp.resize (length);
+        to = &(tmp[0]);
+    }
+    if (valueSize == 1) {
+        memcpy (to, in, length);
+    } else {
+        for (uInt j=0; j<valueSize; j++) {
+            char* plane = to + j*nvalues;
+            const char* from = in + j;
+            for (uInt i=0; i<nvalues; i++) {
+                plane[i] = *from;
+                from += valueSize;
+            }
+        }
+    }
+    if (type == BitShuffle) {
+        for (uInt j=0; j<valueSize; j++) {
+            transposeBits (out + j*nvalues, to + j*nvalues, nvalues);
+        }
+    }
+}
+
+void TSMCodec::unshuffle (char* out, const char* in, uInt nvalues,
+                          uInt valueSize, Shuffle type)
+{
+    uInt length = nvalues * valueSize;
+    if (type == NoShuffle  ||  valueSize == 0) {
+        memcpy (out, in, length);
+        return;
+    }
+    const char* from = in;
+    std::vector<char> tmp;
+    if (type == BitShuffle) {
+        // Undo the bit transposition of each byte plane.
+        tmp.resize (length);
+        uInt ngroup = nvalues / 8;
+        for (uInt j=0; j<valueSize; j++) {
+            const char* plane = in + j*nvalues;
+            char* to = &(tmp[j*nvalues]);
+            char group[8];
+            for (uInt k=0; k<ngroup; k++) {
+                for (uInt b=0; b<8; b++) {
+                    group[b] = plane[b*ngroup + k];
+                }
+                // The transposition is its own inverse.
+                transposeBits (to + 8*k, group, 8);
+            }
+            memcpy (to + 8*ngroup, plane + 8*ngroup, nvalues - 8*ngroup);
+        }
+        from = &(tmp[0]);
+    }
+    if (valueSize == 1) {
+        memcpy (out, from, length);
+    } else {
+        for (uInt j=0; j<valueSize; j++) {
+            const char* plane = from + j*nvalues;
+            char* to = out + j;
+            for (uInt i=0; i<nvalues; i++) {
+                *to = plane[i];
+                to += valueSize;
+            }
+        }
+    }
+}
+
+void TSMCodec::truncateMantissa (Float* values, size_t nvalues, uInt nbits)
+{
+    if (nbits == 0  ||  nbits >= 23) {
+        return;
+    }
+    uInt drop = 23 - nbits;
+    uInt half = 1u << (drop - 1);
+    uInt mask = ~((1u << drop) - 1);
+    for (size_t i=0; i<nvalues; i++) {
+        uInt v;
+        memcpy (&v, values+i, 4);
+        if ((v & 0x7f800000u) != 0x7f800000u) {
+            uInt r = (v + half) & mask;
+            // Do not round to infinity.
+            if ((r & 0x7f800000u) == 0x7f800000u) {
+                r = v & mask;
+            }
+            memcpy (values+i, &r, 4);
+        }
+    }
+}
+
+void TSMCodec::truncateMantissa (Double* values, size_t nvalues, uInt nbits)
+{
+    if (nbits == 0  ||  nbits >= 52) {
+        return;
+    }
+    const uInt64 expMask = 0x7ff0000000000000ULL;
+    uInt drop = 52 - nbits;
+    uInt64 half = uInt64(1) << (drop - 1);
+    uInt64 mask = ~((uInt64(1) << drop) - 1);
+    for (size_t i=0; i<nvalues; i++) {
+        uInt64 v;
+        memcpy (&v, values+i, 8);
+        if ((v & expMask) != expMask) {
+            uInt64 r = (v + half) & mask;
+            if ((r & expMask) == expMask) {
+                r = v & mask;
+            }
+            memcpy (values+i, &r, 8);
+        }
+    }
+}
+
+TSMCodec::Shuffle TSMCodec::shuffleType (const String& type)
+{
+    String str(type);
+    str.downcase();
+    if (str == "none") {
+        return NoShuffle;
+    } else if (str == "byte") {
+        return ByteShuffle;
+    } else if (str == "bit") {
+        return BitShuffle;
+    }
+    throw DataManError ("TSMCodec: unknown shuffle type " + type +
+                        " (valid are none, byte, bit)");
+}
+
+String TSMCodec::shuffleName (Shuffle type)
+{
+    switch (type) {
+    case ByteShuffle:
+        return "byte";
+    case BitShuffle:
+        return "bit";
+    default:
+        break;
+    }
+    return "none";
+}
+
+TSMCodec::Codec TSMCodec::codecType (const String& type)
+{
+    String str(type);
+    str.downcase();
+    if (str == "none") {
+        return NoCodec;
+    } else if (str == "lz") {
+        return LZ;
+    } else if (str == "rle") {
+        return RunLength;
+    }
+    throw DataManError ("TSMCodec: unknown codec " + type +
+                        " (valid are none, lz, rle)");
+}
+
+String TSMCodec::codecName (Codec codec)
+{
+    switch (codec) {
+    case LZ:
+        return "lz";
+    case RunLength:
+        return "rle";
+    default:
+        break;
+    }
+    return "none";
+}
+
+} //# NAMESPACE CASACORE - END
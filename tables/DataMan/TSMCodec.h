@@ -0,0 +1,187 @@
+//# TSMCodec.h: Compression and preconditioning of tiles
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TSMCODEC_H
+#define TABLES_TSMCODEC_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/String.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Compression and preconditioning of tiles
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTiledCompressStMan.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TiledCompressStMan>TiledCompressStMan</linkto>
+//   <li> <linkto class=TSMCompressFile>TSMCompressFile</linkto>
+// </prerequisite>
+
+// <synopsis>
+// TSMCodec contains the functions used by the TiledCompressStMan
+// to make tiles smaller.
+// <ul>
+//  <li> A fast lossless LZ77 codec in the style of LZ4. A compressed
+//       block consists of sequences of literal bytes followed by a match
+//       (a copy of earlier output). Each sequence starts with a token byte
+//       holding the literal length and match length in 4 bits each,
+//       followed by extra length bytes (for lengths of 15 or more),
+//       the literals, and the 2-byte little-endian match offset.
+//       The last sequence only has literals.
+//  <li> A lossless run-length codec working on words of 8 bytes.
+//       Runs of words with all bits 0 or all bits 1 take only a few bytes,
+//       while other words are stored as such. It is meant for flags
+//       (stored as bits), which usually come in long runs, because it is
+//       faster than the LZ codec and often gives a smaller result.
+//       A compressed block consists of runs, each starting with a byte
+//       giving the type (0=zeroes, 1=ones, 2=literal words) followed by
+//       the number of words as a variable length integer (7 bits per byte).
+//       The literal words follow that count. The last length%8 bytes
+//       are stored as such at the end.
+//  <li> Byte shuffling puts the first bytes of all values together,
+//       thereafter the second bytes, etc. Because the high order bytes
+//       of nearby numbers are often the same, it makes the codec much more
+//       effective for float and complex data.
+//       Bit shuffling does the same for each bit of the values,
+//       which is better for data with noisy low order bits.
+//  <li> Mantissa truncation keeps only the given number of mantissa bits
+//       (rounded) of float and double values. It is lossy, but the
+//       zeroed bits compress very well after shuffling.
+// </ul>
+// </synopsis>
+
+// <motivation>
+// Reading visibility data is often disk bandwidth bound, so smaller
+// tiles make reading faster. The codec is bundled to avoid an
+// external dependency.
+// </motivation>
+
+
+class TSMCodec
+{
+public:
+    // Define the possible preconditioning of a tile.
+    enum Shuffle {
+        // Do not shuffle.
+        NoShuffle,
+        // Shuffle the bytes of the values.
+        ByteShuffle,
+        // Shuffle the bits of the values.
+        BitShuffle
+    };
+
+    // Define the possible compression codecs.
+    enum Codec {
+        // No compression.
+        NoCodec,
+        // The LZ77 codec.
+        LZ,
+        // The run-length codec for words of 8 bytes.
+        RunLength
+    };
+
+    // Get the maximum length of a compressed buffer.
+    static uInt maxCompressedLength (uInt length);
+
+    // Compress the input buffer into the output buffer which must have
+    // a length of at least <src>maxCompressedLength(length)</src>.
+    // It returns the length of the compressed data.
+    static uInt compress (char* out, const char* in, uInt length,
+                          Codec codec = LZ);
+
+    // Decompress the input buffer into the output buffer which must
+    // have the (original) length given.
+    // An exception is thrown if the compressed data are invalid.
+    static void decompress (char* out, uInt length,
+                            const char* in, uInt inLength,
+                            Codec codec = LZ);
+
+    // Shuffle the bytes or bits of the values in the input buffer
+    // and store them in the output buffer. The buffers must not overlap.
+    // <src>valueSize</src> is the size of a value in bytes.
+    static void shuffle (char* out, const char* in, uInt nvalues,
+                         uInt valueSize, Shuffle type);
+
+    // Undo the shuffling.
+    static void unshuffle (char* out, const char* in, uInt nvalues,
+                           uInt valueSize, Shuffle type);
+
+    // Keep the given number of mantissa bits of the values (rounded to
+    // the nearest value). Infinities and NaNs are not changed.
+    // Nothing is done if <src>nbits</src> is 0 or at least the number of
+    // mantissa bits.
+    // <group>
+    static void truncateMantissa (Float* values, size_t nvalues, uInt nbits);
+    static void truncateMantissa (Double* values, size_t nvalues, uInt nbits);
+    // </group>
+
+    // Convert a shuffle type to or from a string (none, byte or bit).
+    // The string is case-insensitive.
+    // <group>
+    static Shuffle shuffleType (const String& type);
+    static String shuffleName (Shuffle type);
+    // </group>
+
+    // Convert a codec to or from a string (none, lz or rle).
+    // The string is case-insensitive.
+    // <group>
+    static Codec codecType (const String& type);
+    static String codecName (Codec codec);
+    // </group>
+
+private:
+    // Compress or decompress using the LZ codec.
+    // <group>
+    static uInt compressLZ (char* out, const char* in, uInt length);
+    static void decompressLZ (char* out, uInt length,
+                              const char* in, uInt inLength);
+    // </group>
+
+    // Compress or decompress using the run-length codec.
+    // <group>
+    static uInt compressRunLength (char* out, const char* in, uInt length);
+    static void decompressRunLength (char* out, uInt length,
+                                     const char* in, uInt inLength);
+    // </group>
+
+    // Transpose the bits in blocks of 8 bytes.
+    static void transposeBits (char* out, const char* in, uInt length);
+};
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
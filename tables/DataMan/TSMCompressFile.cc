@@ -0,0 +1,299 @@
+//# TSMCompressFile.cc: Bucket file storing compressed buckets
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/DataMan/TSMCompressFile.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Containers/BlockIO.h>
+#include <casacore/casa/string.h>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+TSMCompressFile::TSMCompressFile (const String& fileName,
+                                  TSMCodec::Codec codec,
+                                  MultiFileBase* mfile)
+: BucketFile   (fileName, 0, False, mfile),
+  codec_p      (codec),
+  position_p   (0),
+  physLength_p (0)
+{}
+
+TSMCompressFile::TSMCompressFile (const String& fileName, Bool writable,
+                                  MultiFileBase* mfile)
+: BucketFile   (fileName, writable, 0, False, mfile),
+  codec_p      (TSMCodec::LZ),
+  position_p   (0),
+  physLength_p (0)
+{}
+
+TSMCompressFile::~TSMCompressFile()
+{}
+
+void TSMCompressFile::seek (Int64 offset)
+{
+    position_p = offset;
+}
+
+uInt TSMCompressFile::read (void* buffer, uInt length)
+{
+    uInt n = pread (buffer, length, position_p);
+    position_p += length;
+    return n;
+}
+
+uInt TSMCompressFile::write (const void* buffer, uInt length)
+{
+    uInt n = pwrite (buffer, length, position_p);
+    position_p += length;
+    return n;
+}
+
+uInt TSMCompressFile::pread (void* buffer, uInt length, Int64 offset)
+{
+    BlockInfo info;
+    {
+        ScopedMutexLock lock(mutex_p);
+        std::map<Int64,BlockInfo>::const_iterator iter = index_p.find (offset);
+        if (iter == index_p.end()) {
+            // Not written yet.
+            memset (buffer, 0, length);
+            return length;
+        }
+        info = iter->second;
+    }
+    if (info.length != length) {
+        throw DataManError ("TSMCompressFile: block at offset " +
+                            String::toString(offset) + " in " + name() +
+                            " has length " + String::toString(info.length) +
+                            ", not " + String::toString(length));
+    }
+    if (info.compLength == length) {
+        // Stored uncompressed.
+        BucketFile::pread (buffer, length, info.offset);
+    } else {
+        std::vector<char> comp(info.compLength);
+        BucketFile::pread (&(comp[0]), info.compLength, info.offset);
+        TSMCodec::decompress (static_cast<char*>(buffer), length,
+                              &(comp[0]), info.compLength, codec_p);
+    }
+    return length;
+}
+
+uInt TSMCompressFile::pwrite (const void* buffer, uInt length, Int64 offset)
+{
+    // Compress outside the lock, so it can be done in parallel.
+    std::vector<char> comp(TSMCodec::maxCompressedLength (length));
+    uInt compLength = TSMCodec::compress (&(comp[0]),
+                                          static_cast<const char*>(buffer),
+                                          length, codec_p);
+    const char* data = &(comp[0]);
+    // Store it uncompressed if compression does not help.
+    if (compLength >= length) {
+        compLength = length;
+        data = static_cast<const char*>(buffer);
+    }
+    Int64 physOffset;
+    {
+        ScopedMutexLock lock(mutex_p);
+        std::map<Int64,BlockInfo>::iterator iter = index_p.find (offset);
+        if (iter != index_p.end()  &&  compLength <= iter->second.capacity) {
+            // Rewrite in place and release the remaining space.
+            BlockInfo& info = iter->second;
+            release (info.offset + compLength, info.capacity - compLength);
+            info.capacity = compLength;
+        } else {
+            if (iter != index_p.end()) {
+                release (iter->second.offset, iter->second.capacity);
+            }
+            BlockInfo info;
+            info.offset   = allocate (compLength);
+            info.capacity = compLength;
+            index_p[offset] = info;
+        }
+        BlockInfo& info = index_p[offset];
+        info.length     = length;
+        info.compLength = compLength;
+        physOffset = info.offset;
+    }
+    BucketFile::pwrite (data, compLength, physOffset);
+    return length;
+}
+
+Int64 TSMCompressFile::allocate (uInt length)
+{
+    // Use the first free space fitting the block.
+    for (std::map<Int64,Int64>::iterator iter = free_p.begin();
+         iter != free_p.end(); ++iter) {
+        if (iter->second >= length) {
+            Int64 offset = iter->first;
+            Int64 rest   = iter->second - length;
+            free_p.erase (iter);
+            if (rest > 0) {
+                free_p[offset + length] = rest;
+            }
+            return offset;
+        }
+    }
+    Int64 offset = physLength_p;
+    physLength_p += length;
+    return offset;
+}
+
+void TSMCompressFile::release (Int64 offset, uInt length)
+{
+    if (length == 0) {
+        return;
+    }
+    Int64 end = offset + length;
+    // Merge with the next free space.
+    std::map<Int64,Int64>::iterator next = free_p.find (end);
+    if (next != free_p.end()) {
+        end += next->second;
+        free_p.erase (next);
+    }
+    // Merge with the previous free space.
+    std::map<Int64,Int64>::iterator prev = free_p.lower_bound (offset);
+    if (prev != free_p.begin()) {
+        --prev;
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            free_p.erase (prev);
+        }
+    }
+    if (end == physLength_p) {
+        physLength_p = offset;
+    } else {
+        free_p[offset] = end - offset;
+    }
+}
+
+Int64 TSMCompressFile::fileSize() const
+{
+    ScopedMutexLock lock(mutex_p);
+    if (index_p.empty()) {
+        return 0;
+    }
+    std::map<Int64,BlockInfo>::const_reverse_iterator last = index_p.rbegin();
+    return last->first + last->second.length;
+}
+
+Int64 TSMCompressFile::physicalSize() const
+{
+    ScopedMutexLock lock(mutex_p);
+    return physLength_p;
+}
+
+Int64 TSMCompressFile::compressedSize() const
+{
+    ScopedMutexLock lock(mutex_p);
+    Int64 size = 0;
+    for (std::map<Int64,BlockInfo>::const_iterator iter = index_p.begin();
+         iter != index_p.end(); ++iter) {
+        size += iter->second.compLength;
+    }
+    return size;
+}
+
+void TSMCompressFile::putIndex (AipsIO& ios) const
+{
+    ScopedMutexLock lock(mutex_p);
+    uInt nr = index_p.size();
+    Block<Int64> logOffsets(nr);
+    Block<Int64> physOffsets(nr);
+    Block<uInt>  lengths(nr);
+    Block<uInt>  compLengths(nr);
+    uInt i = 0;
+    for (std::map<Int64,BlockInfo>::const_iterator iter = index_p.begin();
+         iter != index_p.end(); ++iter, ++i) {
+        logOffsets[i]  = iter->first;
+        physOffsets[i] = iter->second.offset;
+        lengths[i]     = iter->second.length;
+        compLengths[i] = iter->second.compLength;
+    }
+    ios.putstart ("TSMCompressFile", 2);
+    ios << Int(codec_p);
+    ios << physLength_p;
+    putBlock (ios, logOffsets, nr);
+    putBlock (ios, physOffsets, nr);
+    putBlock (ios, lengths, nr);
+    putBlock (ios, compLengths, nr);
+    ios.putend();
+}
+
+void TSMCompressFile::getIndex (AipsIO& ios)
+{
+    Block<Int64> logOffsets;
+    Block<Int64> physOffsets;
+    Block<uInt>  lengths;
+    Block<uInt>  compLengths;
+    ScopedMutexLock lock(mutex_p);
+    uInt version = ios.getstart ("TSMCompressFile");
+    // Version 1 always used the LZ codec.
+    codec_p = TSMCodec::LZ;
+    if (version > 1) {
+        Int codec;
+        ios >> codec;
+        codec_p = TSMCodec::Codec (codec);
+    }
+    ios >> physLength_p;
+    getBlock (ios, logOffsets);
+    getBlock (ios, physOffsets);
+    getBlock (ios, lengths);
+    getBlock (ios, compLengths);
+    ios.getend();
+    index_p.clear();
+    free_p.clear();
+    std::map<Int64,Int64> used;
+    for (uInt i=0; i<logOffsets.nelements(); i++) {
+        BlockInfo info;
+        info.offset     = physOffsets[i];
+        info.length     = lengths[i];
+        info.compLength = compLengths[i];
+        info.capacity   = compLengths[i];
+        index_p[logOffsets[i]] = info;
+        used[info.offset] = info.compLength;
+    }
+    // The gaps between the blocks are free space.
+    Int64 end = 0;
+    for (std::map<Int64,Int64>::const_iterator iter = used.begin();
+         iter != used.end(); ++iter) {
+        if (iter->first > end) {
+            free_p[end] = iter->first - end;
+        }
+        end = iter->first + iter->second;
+    }
+    if (end < physLength_p) {
+        free_p[end] = physLength_p - end;
+    }
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,188 @@
+//# TSMCompressFile.h: Bucket file storing compressed buckets
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TSMCOMPRESSFILE_H
+#define TABLES_TSMCOMPRESSFILE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/IO/BucketFile.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
+#include <casacore/casa/OS/Mutex.h>
+#include <map>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+class AipsIO;
+
+
+// <summary>
+// Bucket file storing compressed buckets
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTiledCompressStMan.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=BucketFile>BucketFile</linkto>
+//   <li> <linkto class=BucketCache>BucketCache</linkto>
+//   <li> <linkto class=TSMCodec>TSMCodec</linkto>
+// </prerequisite>
+
+// <synopsis>
+// TSMCompressFile is a BucketFile which compresses each block written
+// into it using a codec in <linkto class=TSMCodec>TSMCodec</linkto>. In this way
+// a BucketCache (and thus a TSMCube) can use it as an ordinary file of
+// fixed size buckets, while on disk each bucket only takes the space
+// of its compressed data.
+// <p>
+// The logical offset and length of each block have to be the same when
+// reading it back, which is the case for the buckets of a BucketCache.
+// A block not written yet reads as zeroes.
+// An index maps the logical offset of a block to its physical offset and
+// compressed length. It has to be written with <src>putIndex</src> after
+// the blocks have been written (it is part of the TSM header).
+// A block is rewritten in place if it still fits; otherwise it is
+// written in free space (left by other blocks) or at the end of the file.
+// <p>
+// The positional IO functions can be used by multiple threads
+// concurrently, so the decompression of the buckets read by
+// <src>BucketCache::readBuckets</src> is done in parallel.
+// </synopsis>
+
+// <motivation>
+// Compressing buckets below the BucketCache keeps all logic of the
+// tiled storage managers (cache sizing, parallel reading) intact.
+// </motivation>
+
+
+class TSMCompressFile : public BucketFile
+{
+public:
+    // Create the object for a new file using the given codec.
+    TSMCompressFile (const String& fileName, TSMCodec::Codec codec,
+                     MultiFileBase* mfile=0);
+
+    // Create the object for an existing file.
+    // Its index (which also defines the codec) has to be read with
+    // <src>getIndex</src>.
+    TSMCompressFile (const String& fileName, Bool writable,
+                     MultiFileBase* mfile=0);
+
+    virtual ~TSMCompressFile();
+
+    // Read or write (the compressed data of) a block at the current
+    // logical position.
+    // <group>
+    virtual uInt read (void* buffer, uInt length);
+    virtual uInt write (const void* buffer, uInt length);
+    // </group>
+
+    // Read or write (the compressed data of) a block at the given
+    // logical offset.
+    // <group>
+    virtual uInt pread (void* buffer, uInt length, Int64 offset);
+    virtual uInt pwrite (const void* buffer, uInt length, Int64 offset);
+    // </group>
+
+    // Set the logical position.
+    // <group>
+    using BucketFile::seek;
+    virtual void seek (Int64 offset);
+    // </group>
+
+    // Get the logical size of the file (i.e. the end of the last block).
+    virtual Int64 fileSize() const;
+
+    // Get the codec used.
+    TSMCodec::Codec codec() const
+      { return codec_p; }
+
+    // Get the physical size of the file.
+    Int64 physicalSize() const;
+
+    // Get the total length of the compressed blocks.
+    Int64 compressedSize() const;
+
+    // Write or read the index.
+    // <group>
+    void putIndex (AipsIO& ios) const;
+    void getIndex (AipsIO& ios);
+    // </group>
+
+private:
+    // Define the location of a block in the file.
+    struct BlockInfo {
+        // The physical offset.
+        Int64 offset;
+        // The logical length.
+        uInt  length;
+        // The compressed length (equal to length if stored uncompressed).
+        uInt  compLength;
+        // The space available for the block.
+        uInt  capacity;
+    };
+
+    // Forbid copy constructor.
+    TSMCompressFile (const TSMCompressFile&);
+
+    // Forbid assignment.
+    TSMCompressFile& operator= (const TSMCompressFile&);
+
+    // Get space for a block of the given length.
+    // It must be called with the mutex locked.
+    Int64 allocate (uInt length);
+
+    // Make space of a block available for other blocks.
+    // It must be called with the mutex locked.
+    void release (Int64 offset, uInt length);
+
+
+    //# Declare member variables.
+    // The codec used.
+    TSMCodec::Codec codec_p;
+    // The logical position.
+    Int64 position_p;
+    // The physical end of the file.
+    Int64 physLength_p;
+    // The blocks in the file (keyed by logical offset).
+    std::map<Int64,BlockInfo> index_p;
+    // The free space in the file (physical offset and length).
+    std::map<Int64,Int64> free_p;
+    // Mutex to synchronize the use of the index.
+    mutable Mutex mutex_p;
+};
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
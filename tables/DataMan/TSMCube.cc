@@ -44,6 +44,7 @@
 #include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/string.h>                           // for memcpy
 #include <casacore/casa/iostream.h>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -93,7 +94,9 @@ TSMCube::TSMCube (TiledStMan* stman, TSMFile* file,
   fileOffset_p   (0),
   cache_p        (0),
   userSetCache_p (False),
-  lastColAccess_p(NoAccess)
+  lastColAccess_p(NoAccess),
+  budgetBytes_p  (0),
+  nrHist_p       (0)
 {
     if (fileOffset < 0) {
         // TiledCellStMan uses an empty shape; setShape is called later. 
@@ -120,7 +123,9 @@ TSMCube::TSMCube (TiledStMan* stman, AipsIO& ios,
   filePtr_p      (0),
   cache_p        (0),
   userSetCache_p (False),
-  lastColAccess_p(NoAccess)
+  lastColAccess_p(NoAccess),
+  budgetBytes_p  (0),
+  nrHist_p       (0)
 {
     Int fileSeqnr = getObject (ios);
     if (fileSeqnr >= 0) {
@@ -132,6 +137,7 @@ TSMCube::TSMCube (TiledStMan* stman, AipsIO& ios,
 
 TSMCube::~TSMCube()
 {
+    releaseCacheBudget();
     delete cache_p;
     delete [] cachedTile_p;
 }
@@ -151,6 +157,7 @@ void TSMCube::emptyCache()
     if (cache_p != 0) {
         cache_p->resize (0);
     }
+    releaseCacheBudget();
     userSetCache_p = False;
     lastColAccess_p = NoAccess;
 }
@@ -397,6 +404,7 @@ void TSMCube::resyncCache()
 
 void TSMCube::deleteCache()
 {
+    releaseCacheBudget();
     delete cache_p;
     cache_p = 0;
 }
@@ -668,11 +676,12 @@ char* TSMCube::readCallBack (void* owner, const char* external)
 char* TSMCube::readTile (const char* external)
 {
     char* local = 0;
-
-    if (cachedTile_p != 0){
+    {
+        ScopedMutexLock lock(cachedTileMutex_p);
         local = cachedTile_p;
         cachedTile_p = 0;
-    } else {
+    }
+    if (local == 0) {
         local = new char[localTileLength_p];
     }
 
@@ -692,6 +701,7 @@ void TSMCube::writeTile (char* external, const char* local)
 void TSMCube::deleteCallBack (void* owner, char* buffer)
 {
     TSMCube * tsmCube = ((TSMCube*)owner);
+    ScopedMutexLock lock(tsmCube->cachedTileMutex_p);
     if (tsmCube->cachedTile_p == 0){
         tsmCube->cachedTile_p = buffer;
     } else {
@@ -741,13 +751,78 @@ void TSMCube::setCacheSize (uInt cacheSize, Bool forceSmaller, Bool userSet)
     // unless it is only 10% more.
     BucketCache* cachePtr = getCache();
     cacheSize = validateCacheSize (cacheSize);
-    if (forceSmaller  ||  cacheSize > cachePtr->cacheSize()) {
+    if (!forceSmaller  &&  cacheSize < cachePtr->cacheSize()) {
+        cacheSize = cachePtr->cacheSize();
+    }
+    if (userSet) {
+        // A cache sized by the user is not part of the budget.
+        releaseCacheBudget();
+    } else {
+        // Limit the cache to what is left of the budget.
+        budgetBytes_p = TiledStMan::claimCacheBudget
+                          (budgetBytes_p, Int64(cacheSize) * bucketSize_p,
+                           bucketSize_p);
+        if (cacheSize > 0  &&  bucketSize_p > 0) {
+            cacheSize = budgetBytes_p / bucketSize_p;
+        }
+    }
+    if (cacheSize != cachePtr->cacheSize()) {
         cachePtr->resize (cacheSize);
     }
 ////    cout << "cachesize=" << cacheSize << endl;
     userSetCache_p = userSet;
 }
 
+uInt TSMCube::adaptCacheSize (const IPosition& sliceShape,
+                              const IPosition& axisPath, uInt cacheSize)
+{
+    const uInt maxHist = 4;
+    if (histSize_p.nelements() == 0) {
+        histSlice_p.resize (maxHist);
+        histPath_p.resize (maxHist);
+        histSize_p.resize (maxHist);
+    }
+    // Find the pattern in the history; otherwise the oldest is replaced.
+    uInt inx = 0;
+    while (inx < nrHist_p  &&  !(sliceShape.isEqual (histSlice_p[inx])
+                                 &&  axisPath.isEqual (histPath_p[inx]))) {
+        inx++;
+    }
+    if (inx == nrHist_p) {
+        if (nrHist_p < maxHist) {
+            nrHist_p++;
+        } else {
+            inx--;
+        }
+    }
+    // Move it to the front.
+    for (uInt i=inx; i>0; i--) {
+        histSlice_p[i].resize (histSlice_p[i-1].nelements());
+        histSlice_p[i] = histSlice_p[i-1];
+        histPath_p[i].resize (histPath_p[i-1].nelements());
+        histPath_p[i] = histPath_p[i-1];
+        histSize_p[i] = histSize_p[i-1];
+    }
+    histSlice_p[0].resize (sliceShape.nelements());
+    histSlice_p[0] = sliceShape;
+    histPath_p[0].resize (axisPath.nelements());
+    histPath_p[0] = axisPath;
+    histSize_p[0] = cacheSize;
+    for (uInt i=1; i<nrHist_p; i++) {
+        cacheSize = std::max (cacheSize, histSize_p[i]);
+    }
+    return cacheSize;
+}
+
+void TSMCube::releaseCacheBudget()
+{
+    if (budgetBytes_p != 0) {
+        TiledStMan::claimCacheBudget (budgetBytes_p, 0, 1);
+        budgetBytes_p = 0;
+    }
+    nrHist_p = 0;
+}
+
 // Set the cache size for the given slice and access path.
 void TSMCube::setCacheSize (const IPosition& sliceShape,
                             const IPosition& windowStart,
@@ -765,6 +840,9 @@ void TSMCube::setCacheSize (const IPosition& sliceShape,
 	cacheSize = 1;
       }
     }
+    if (!userSet) {
+      cacheSize = adaptCacheSize (sliceShape, axisPath, cacheSize);
+    }
     setCacheSize (cacheSize, forceSmaller, userSet);
 }
 
@@ -946,6 +1024,10 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     }
     // Get the cache.
     BucketCache* cachePtr = getCache();
+    // When reading multiple tiles, they can be read in parallel beforehand.
+    if (!writeFlag  &&  !oneEntireTile) {
+        readTiles (start, end, IPosition(nrdim_p, 1), cachePtr);
+    }
     
 //    cout << "nrTileSection_p=" << nrTileSection_p << endl;
 //    cout << "startTile_p=" << startTile_p << endl;
@@ -1098,6 +1180,53 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     }
 }
 
+void TSMCube::readTiles (const IPosition& start, const IPosition& end,
+                         const IPosition& stride, BucketCache* cachePtr)
+{
+    uInt nthreads = stmanPtr_p->decodeThreads();
+    if (nthreads == 1) {
+        return;
+    }
+    // Determine per axis the tiles containing a pixel of the section.
+    std::vector<std::vector<uInt> > axisTiles(nrdim_p);
+    uInt ntiles = 1;
+    for (uInt i=0; i<nrdim_p; i++) {
+        Int pixel = start(i);
+        while (pixel <= end(i)) {
+            uInt tile = pixel / tileShape_p(i);
+            axisTiles[i].push_back (tile);
+            // Skip to the first pixel in the next tile.
+            Int nextTile = (tile+1) * tileShape_p(i);
+            pixel += stride(i) * ((nextTile - pixel + stride(i) - 1) /
+                                  stride(i));
+        }
+        ntiles *= axisTiles[i].size();
+        if (ntiles > cachePtr->cacheSize()) {
+            return;
+        }
+    }
+    if (ntiles < 2) {
+        return;
+    }
+    // Make the tile numbers by iterating over all tile positions.
+    Block<uInt> tileNrs(ntiles);
+    IPosition index(nrdim_p, 0);
+    IPosition tilePos(nrdim_p);
+    for (uInt n=0; n<ntiles; n++) {
+        for (uInt i=0; i<nrdim_p; i++) {
+            tilePos(i) = axisTiles[i][index(i)];
+        }
+        tileNrs[n] = expandedTilesPerDim_p.offset (tilePos);
+        for (uInt i=0; i<nrdim_p; i++) {
+            if (++index(i) < Int(axisTiles[i].size())) {
+                break;
+            }
+            index(i) = 0;
+        }
+    }
+    cachePtr->readBuckets (tileNrs, nthreads);
+}
+
 void TSMCube::accessLine (char* section, uInt pixelOffset,
                           uInt localPixelSize,
                           Bool writeFlag, BucketCache* cachePtr,
@@ -1315,6 +1444,9 @@ void TSMCube::accessStrided (const IPosition& start, const IPosition& end,
     uInt i, j;
     // Get the cache (if needed).
     BucketCache* cachePtr = getCache();
+    if (!writeFlag) {
+        readTiles (start, end, stride, cachePtr);
+    }
 
     // A tile can contain more than one data array.
     // Each array is contiguous, so the first pixel of an array
@@ -35,6 +35,7 @@
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/OS/Conversion.h>
+#include <casacore/casa/OS/Mutex.h>
 #include <casacore/casa/iosfwd.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -248,6 +249,13 @@ public:
     // </group>
 
     // Set the cache size for the given slice and access path.
+    // <br>If not set by the user, the size is adapted to the recent
+    // access patterns. The slice shapes and access paths of the last few
+    // automatic sizings are kept with the cache sizes they need, and the
+    // cache is sized to the largest of them. In this way the cache does
+    // not shrink (and lose its tiles) when alternating between, say,
+    // row-wise and channel-wise passes. A pattern not used anymore ages
+    // out of the history, after which the cache can shrink again.
     virtual void setCacheSize (const IPosition& sliceShape,
                                const IPosition& windowStart,
                                const IPosition& windowLength,
@@ -261,6 +269,8 @@ public:
     // The cacheSize has to be given in buckets.
     // <br>The flag <src>userSet</src> inidicates if the cache size is set by
     // the user (by an Accessor object) or automatically (by TSMDataColumn).
+    // An automatically set cache size is limited by the process-wide
+    // cache budget (see <src>TiledStMan::setCacheBudget</src>).
     virtual void setCacheSize (uInt cacheSize, Bool forceSmaller, Bool userSet);
 
     // Validate the cache size (in buckets).
@@ -292,6 +302,14 @@ protected:
     void setupNrTiles();
     // </group>
 
+    // Add the cache size needed for a slice shape and access path to
+    // the access history and return the largest cache size in it.
+    uInt adaptCacheSize (const IPosition& sliceShape,
+                         const IPosition& axisPath, uInt cacheSize);
+
+    // Return the bytes claimed from the cache budget and clear the history.
+    void releaseCacheBudget();
+
     // Adjust the tile shape to the hypercube shape.
     // A size of 0 gets set to 1.
     // A tile size > cube size gets set to the cube size.
@@ -322,6 +340,12 @@ private:
     // Delete the cache object.
     virtual void deleteCache();
 
+    // Read the tiles containing the pixels of a section (with the given
+    // stride) into the cache using the decode threads of the storage
+    // manager. Nothing is done if they do not fit in the cache.
+    void readTiles (const IPosition& start, const IPosition& end,
+                    const IPosition& stride, BucketCache* cachePtr);
+
     // Access a line in a more optimized way.
     void accessLine (char* section, uInt pixelOffset,
 		     uInt localPixelSize,
@@ -351,6 +375,8 @@ protected:
     //# Declare member variables.
 
     char * cachedTile_p; // optimization to hold one tile chunk
+    // Tiles can be read in parallel, so guard the use of cachedTile_p.
+    Mutex  cachedTileMutex_p;
 
     // Pointer to the parent storage manager.
     TiledStMan*     stmanPtr_p;
@@ -398,6 +424,13 @@ protected:
     AccessType      lastColAccess_p;
     // The slice shape of the last column access to a slice.
     IPosition       lastColSlice_p;
+    // The number of bytes claimed from the cache budget.
+    Int64           budgetBytes_p;
+    // The history of automatic cache sizings (most recent first).
+    Block<IPosition> histSlice_p;
+    Block<IPosition> histPath_p;
+    Block<uInt>     histSize_p;
+    uInt            nrHist_p;
 
     // IPosition variables used in accessSection(); declared here
     // as member variables to avoid significant construction and
@@ -29,6 +29,7 @@
 //# Includes
 #include <casacore/tables/DataMan/TSMFile.h>
 #include <casacore/tables/DataMan/TSMOption.h>
+#include <casacore/tables/DataMan/TSMCompressFile.h>
 #include <casacore/tables/DataMan/TiledStMan.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/DataMan/DataManError.h>
@@ -41,12 +42,18 @@ TSMFile::TSMFile (const TiledStMan* stman, uInt fileSequenceNr,
                   const TSMOption& tsmOpt, MultiFileBase* mfile)
 : fileSeqnr_p (fileSequenceNr),
   file_p      (0),
+  compFile_p  (0),
   length_p    (0)
 {
     // Create the file.
     char strc[8];
     sprintf (strc, "_TSM%i", fileSeqnr_p);
     String fileName = stman->fileName() + strc;
+    if (stman->tileCodec() != TSMCodec::NoCodec) {
+      compFile_p = new TSMCompressFile (fileName, stman->tileCodec(), mfile);
+      file_p = compFile_p;
+      return;
+    }
     Bool mapOpt = tsmOpt.option() == TSMOption::MMap;
     uInt bufSize = 0;
     if (tsmOpt.option() == TSMOption::Buffer) {
@@ -59,6 +66,7 @@ TSMFile::TSMFile (const String& fileName, Bool writable,
                   const TSMOption& tsmOpt, MultiFileBase* mfile)
 : fileSeqnr_p (0),
   file_p      (0),
+  compFile_p  (0),
   length_p    (0)
 {
     // Create the file.
@@ -72,9 +80,10 @@ TSMFile::TSMFile (const String& fileName, Bool writable,
 
 TSMFile::TSMFile (const TiledStMan* stman, AipsIO& ios, uInt seqnr,
                   const TSMOption& tsmOpt, MultiFileBase* mfile)
-: file_p (0)
+: file_p     (0),
+  compFile_p (0)
 {
-    getObject (ios);
+    uInt version = getHeader (ios);
     if (seqnr != fileSeqnr_p) {
       throw DataManInternalError ("TSMFile::TSMFile " + 
                                   stman->dataManagerName());
@@ -82,6 +91,14 @@ TSMFile::TSMFile (const TiledStMan* stman, AipsIO& ios, uInt seqnr,
     char strc[8];
     sprintf (strc, "_TSM%i", fileSeqnr_p);
     String fileName = stman->fileName() + strc;
+    // Version 3 means that the file contains compressed tiles.
+    if (version >= 3) {
+      compFile_p = new TSMCompressFile (fileName, stman->table().isWritable(),
+                                        mfile);
+      compFile_p->getIndex (ios);
+      file_p = compFile_p;
+      return;
+    }
     Bool mapOpt = tsmOpt.option() == TSMOption::MMap;
     uInt bufSize = 0;
     if (tsmOpt.option() == TSMOption::Buffer) {
@@ -99,7 +116,11 @@ TSMFile::~TSMFile()
 void TSMFile::putObject (AipsIO& ios) const
 {
     // Take care of forward compatibility (for small enough files).
+    // Version 3 is used for a compressed file.
     uInt version = (length_p < 2u*1024u*1024u*1024u  ?  1 : 2);
+    if (compFile_p) {
+        version = 3;
+    }
     ios << version;
     ios << fileSeqnr_p;
     if (version == 1) {
@@ -108,9 +129,25 @@ void TSMFile::putObject (AipsIO& ios) const
     } else {
         ios << length_p;
     }
+    if (compFile_p) {
+        compFile_p->putIndex (ios);
+    }
 }
 
 void TSMFile::getObject (AipsIO& ios)
+{
+    uInt version = getHeader (ios);
+    if (version >= 3) {
+        if (compFile_p == 0) {
+            throw DataManInternalError ("TSMFile::getObject: file " +
+                                        file_p->name() +
+                                        " is not compressed");
+        }
+        compFile_p->getIndex (ios);
+    }
+}
+
+uInt TSMFile::getHeader (AipsIO& ios)
 {
     uInt version;
     ios >> version;
@@ -122,6 +159,7 @@ void TSMFile::getObject (AipsIO& ios)
     } else {
         ios >> length_p;
     }
+    return version;
 }
 
 } //# NAMESPACE CASACORE - END
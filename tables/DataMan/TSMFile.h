@@ -37,6 +37,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //# Forward Declarations
 class TSMOption;
 class TiledStMan;
+class TSMCompressFile;
 class MultiFileBase;
 class AipsIO;
 
@@ -68,6 +69,9 @@ class AipsIO;
 // <p>
 // Underneath it uses a BucketFile to access the file.
 // In this way the IO details are well encapsulated.
+// If the storage manager compresses its tiles, a
+// <linkto class=TSMCompressFile>TSMCompressFile</linkto> is used
+// whose index is written with the TSMFile object.
 // </synopsis> 
 
 // <motivation>
@@ -112,6 +116,10 @@ public:
     // Return the BucketFile object (to be used in the BucketCache).
     BucketFile* bucketFile();
 
+    // Return the TSMCompressFile object if the tiles are compressed.
+    // Otherwise return 0.
+    TSMCompressFile* compressFile();
+
     // Return the logical file length.
     Int64 length() const;
 
@@ -123,10 +131,16 @@ public:
 
 
 private:
+    // Read the version, sequence number and length.
+    // It returns the version.
+    uInt getHeader (AipsIO& ios);
+
     // The file sequence number.
     uInt fileSeqnr_p;
     // The file object.
     BucketFile* file_p;
+    // The file object if compressed.
+    TSMCompressFile* compFile_p;
     // The (logical) length of the file.
     Int64 length_p;
 	    
@@ -151,6 +165,9 @@ inline void TSMFile::extend (Int64 increment)
 inline BucketFile* TSMFile::bucketFile()
     { return file_p; }
 
+inline TSMCompressFile* TSMFile::compressFile()
+    { return compFile_p; }
+
 inline void TSMFile::open()
     { file_p->open(); }
 
@@ -0,0 +1,264 @@
+//# TiledCompressStMan.cc: Tiled Storage Manager compressing its tiles
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/DataMan/TiledCompressStMan.h>
+#include <casacore/tables/DataMan/TSMDataColumn.h>
+#include <casacore/tables/DataMan/TSMFile.h>
+#include <casacore/tables/DataMan/TSMCompressFile.h>
+#include <casacore/tables/DataMan/TSMOption.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+TiledCompressStMan::TiledCompressStMan (const String& hypercolumnName,
+                                        const IPosition& defaultTileShape,
+                                        TSMCodec::Codec codec,
+                                        TSMCodec::Shuffle shuffle,
+                                        uInt mantissaBits,
+                                        uInt maximumCacheSize)
+: TiledShapeStMan (hypercolumnName, defaultTileShape, maximumCacheSize),
+  codec_p         (codec),
+  shuffle_p       (shuffle),
+  mantissaBits_p  (mantissaBits)
+{
+    setDefaultDecodeThreads();
+}
+
+TiledCompressStMan::TiledCompressStMan (const String& hypercolumnName,
+                                        const Record& spec)
+: TiledShapeStMan (hypercolumnName, spec),
+  codec_p         (TSMCodec::LZ),
+  shuffle_p       (TSMCodec::ByteShuffle),
+  mantissaBits_p  (0)
+{
+    if (spec.isDefined ("CODEC")) {
+        codec_p = TSMCodec::codecType (spec.asString ("CODEC"));
+    }
+    if (spec.isDefined ("SHUFFLE")) {
+        shuffle_p = TSMCodec::shuffleType (spec.asString ("SHUFFLE"));
+    }
+    if (spec.isDefined ("MANTISSABITS")) {
+        mantissaBits_p = spec.asInt ("MANTISSABITS");
+    }
+    setDefaultDecodeThreads();
+}
+
+TiledCompressStMan::~TiledCompressStMan()
+{}
+
+DataManager* TiledCompressStMan::clone() const
+{
+    TiledCompressStMan* smp = new TiledCompressStMan (hypercolumnName_p,
+                                                      defaultTileShape(),
+                                                      codec_p,
+                                                      shuffle_p,
+                                                      mantissaBits_p,
+                                                      maximumCacheSize());
+    return smp;
+}
+
+DataManager* TiledCompressStMan::makeObject (const String& group,
+                                             const Record& spec)
+{
+    TiledCompressStMan* smp = new TiledCompressStMan (group, spec);
+    return smp;
+}
+
+String TiledCompressStMan::dataManagerType() const
+    { return "TiledCompressStMan"; }
+
+Record TiledCompressStMan::dataManagerSpec() const
+{
+    Record rec = TiledShapeStMan::dataManagerSpec();
+    rec.define ("CODEC", TSMCodec::codecName (codec_p));
+    rec.define ("SHUFFLE", TSMCodec::shuffleName (shuffle_p));
+    rec.define ("MANTISSABITS", Int(mantissaBits_p));
+    Int64 compSize   = 0;
+    Int64 uncompSize = 0;
+    for (uInt i=0; i<fileSet_p.nelements(); i++) {
+        if (fileSet_p[i] != 0  &&  fileSet_p[i]->compressFile() != 0) {
+            compSize   += fileSet_p[i]->compressFile()->compressedSize();
+            uncompSize += fileSet_p[i]->compressFile()->fileSize();
+        }
+    }
+    rec.define ("CompressedSize", compSize);
+    rec.define ("UncompressedSize", uncompSize);
+    return rec;
+}
+
+TSMCodec::Codec TiledCompressStMan::tileCodec() const
+{
+    return codec_p;
+}
+
+void TiledCompressStMan::setDefaultDecodeThreads()
+{
+    // Decompress in parallel unless the user defined otherwise.
+    Int nthreads;
+    if (! AipsrcValue<Int>::find (nthreads, "table.tsm.decodethreads")) {
+        setDecodeThreads (0);
+    }
+}
+
+void TiledCompressStMan::useCacheOption()
+{
+    // A MultiFile already forces the cache option.
+    if (multiFile() == 0  &&  tsmOption().option() != TSMOption::Cache) {
+        setTsmOption (TSMOption (TSMOption::Cache, 0,
+                                 tsmOption().maxCacheSizeMB()));
+    }
+}
+
+Bool TiledCompressStMan::shuffleValues (uInt colnr, uInt nrPixels,
+                                        uInt& valueSize, uInt& nvalues) const
+{
+    if (shuffle_p == TSMCodec::NoShuffle) {
+        return False;
+    }
+    // Shuffle the parts of a complex value separately.
+    valueSize = dataCols_p[colnr]->tilePixelSize();
+    nvalues   = nrPixels;
+    switch (dataCols_p[colnr]->dataType()) {
+    case TpComplex:
+    case TpDComplex:
+        valueSize /= 2;
+        nvalues   *= 2;
+        break;
+    default:
+        break;
+    }
+    // Bools (stored as bits) and bytes need not be shuffled.
+    return valueSize > 1;
+}
+
+void TiledCompressStMan::readTile (char* local,
+                                   const Block<uInt>& localOffset,
+                                   const char* external,
+                                   const Block<uInt>& externalOffset,
+                                   uInt nrPixels)
+{
+    std::vector<char> buf;
+    uInt nr = dataCols_p.nelements();
+    for (uInt i=0; i<nr; i++) {
+        uInt valueSize, nvalues;
+        if (shuffleValues (i, nrPixels, valueSize, nvalues)) {
+            buf.resize (valueSize * nvalues);
+            TSMCodec::unshuffle (&(buf[0]), external + externalOffset[i],
+                                 nvalues, valueSize, shuffle_p);
+            dataCols_p[i]->readTile (local + localOffset[i], &(buf[0]),
+                                     nrPixels);
+        } else {
+            dataCols_p[i]->readTile (local + localOffset[i],
+                                     external + externalOffset[i],
+                                     nrPixels);
+        }
+    }
+}
+
+void TiledCompressStMan::writeTile (char* external,
+                                    const Block<uInt>& externalOffset,
+                                    const char* local,
+                                    const Block<uInt>& localOffset,
+                                    uInt nrPixels)
+{
+    std::vector<char> values;
+    std::vector<char> buf;
+    uInt nr = dataCols_p.nelements();
+    for (uInt i=0; i<nr; i++) {
+        const char* data = local + localOffset[i];
+        // Truncate the mantissas in a copy of the data.
+        if (mantissaBits_p > 0) {
+            int dtype = dataCols_p[i]->dataType();
+            if (dtype == TpFloat  ||  dtype == TpComplex  ||
+                dtype == TpDouble  ||  dtype == TpDComplex) {
+                uInt length = nrPixels * dataCols_p[i]->localPixelSize();
+                values.assign (data, data + length);
+                if (dtype == TpFloat  ||  dtype == TpComplex) {
+                    TSMCodec::truncateMantissa
+                      (reinterpret_cast<Float*>(&(values[0])),
+                       length / sizeof(Float), mantissaBits_p);
+                } else {
+                    TSMCodec::truncateMantissa
+                      (reinterpret_cast<Double*>(&(values[0])),
+                       length / sizeof(Double), mantissaBits_p);
+                }
+                data = &(values[0]);
+            }
+        }
+        uInt valueSize, nvalues;
+        if (shuffleValues (i, nrPixels, valueSize, nvalues)) {
+            buf.resize (valueSize * nvalues);
+            dataCols_p[i]->writeTile (&(buf[0]), data, nrPixels);
+            TSMCodec::shuffle (external + externalOffset[i], &(buf[0]),
+                               nvalues, valueSize, shuffle_p);
+        } else {
+            dataCols_p[i]->writeTile (external + externalOffset[i], data,
+                                      nrPixels);
+        }
+    }
+}
+
+Bool TiledCompressStMan::flush (AipsIO& ios, Bool fsync)
+{
+    ios.putstart ("TiledCompressStMan", 2);
+    ios << Int(codec_p);
+    ios << Int(shuffle_p);
+    ios << mantissaBits_p;
+    ios.putend();
+    return TiledShapeStMan::flush (ios, fsync);
+}
+
+void TiledCompressStMan::create (uInt nrrow)
+{
+    useCacheOption();
+    TiledShapeStMan::create (nrrow);
+}
+
+void TiledCompressStMan::open (uInt nrrow, AipsIO& ios)
+{
+    Int codec = TSMCodec::LZ;
+    Int shuffle;
+    uInt version = ios.getstart ("TiledCompressStMan");
+    if (version > 1) {
+        ios >> codec;
+    }
+    ios >> shuffle;
+    ios >> mantissaBits_p;
+    ios.getend();
+    codec_p   = TSMCodec::Codec (codec);
+    shuffle_p = TSMCodec::Shuffle (shuffle);
+    useCacheOption();
+    TiledShapeStMan::open (nrrow, ios);
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,233 @@
+//# TiledCompressStMan.h: Tiled Storage Manager compressing its tiles
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TILEDCOMPRESSSTMAN_H
+#define TABLES_TILEDCOMPRESSSTMAN_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Tiled Storage Manager compressing its tiles.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTiledCompressStMan.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TiledShapeStMan>TiledShapeStMan</linkto>
+//   <li> <linkto class=TSMCodec>TSMCodec</linkto>
+// </prerequisite>
+
+// <etymology>
+// TiledCompressStMan is the Tiled Storage Manager compressing the tiles.
+// </etymology>
+
+// <synopsis>
+// TiledCompressStMan is a TiledShapeStMan storing each tile compressed
+// with a fast lossless codec in <linkto class=TSMCodec>TSMCodec</linkto>.
+// The default LZ codec is the best choice for numeric data. The run-length
+// codec is meant for Bool columns (like FLAG), because flags are stored
+// as bits and usually come in long runs. Note that the codec is used for
+// all columns in the hypercolumn, so FLAG should be stored in its own
+// hypercolumn to use the run-length codec.
+// Like TiledShapeStMan it creates a hypercube for each different shape of
+// the data arrays.
+// <p>
+// Before compression the numeric data in a tile can be preconditioned:
+// <ul>
+//  <li> The bytes (or bits) of the values can be shuffled, so the
+//       slowly varying high order bytes of numeric data are stored
+//       together. It makes the compression of float and complex data
+//       much more effective. The default is byte shuffling.
+//  <li> Optionally the mantissa of float and double values (also in
+//       complex values) can be truncated to a given number of bits.
+//       Note this is lossy; for float a value of 10 bits gives a
+//       relative precision of about 0.05%.
+// </ul>
+// The settings are persistent and cannot be changed thereafter.
+// <p>
+// The tiles needed for a slice are read and decompressed in parallel.
+// The number of threads used is given by the aipsrc variable
+// <src>table.tsm.decodethreads</src>. If not defined, it is the
+// OpenMP maximum number of threads (for the other tiled storage
+// managers the default is 1).
+// <p>
+// Because a compressed tile cannot be accessed directly in the file,
+// the TSM option is always <src>TSMOption::Cache</src>.
+// A tile is rewritten in place if its compressed data still fit.
+// Otherwise it is written in free space or at the end of the file,
+// so a file can contain unused space if tiles are often rewritten.
+// </synopsis>
+
+// <motivation>
+// Reading large data columns (such as DATA and WEIGHT_SPECTRUM in a
+// MeasurementSet) is often limited by the disk bandwidth. Compressing
+// the data makes reading faster.
+// </motivation>
+
+// <example>
+// <srcblock>
+//  // Define the table description and the columns in it.
+//  TableDesc td ("", "1", TableDesc::Scratch);
+//  td.addColumn (ArrayColumnDesc<Complex> ("DATA", 2));
+//  td.addColumn (ArrayColumnDesc<Bool> ("FLAG", 2));
+//  td.defineHypercolumn ("TSMData", 3, stringToVector("DATA"));
+//  td.defineHypercolumn ("TSMFlag", 3, stringToVector("FLAG"));
+//  // Create a new table using the table description.
+//  SetupNewTable newtab (td, "tab.data", Table::New);
+//  // Create a storage manager with byte shuffling and keeping
+//  // 16 mantissa bits for the data.
+//  TiledCompressStMan sm1 ("TSMData", IPosition(3,4,64,32),
+//                          TSMCodec::LZ, TSMCodec::ByteShuffle, 16);
+//  newtab.bindColumn ("DATA", sm1);
+//  // Use run-length compression for the flags.
+//  TiledCompressStMan sm2 ("TSMFlag", IPosition(3,4,64,256),
+//                          TSMCodec::RunLength);
+//  newtab.bindColumn ("FLAG", sm2);
+// </srcblock>
+// </example>
+
+
+class TiledCompressStMan : public TiledShapeStMan
+{
+public:
+    // Create a TiledCompressStMan storage manager for the hypercolumn
+    // with the given name.
+    // The hypercolumn name is also the name of the storage manager.
+    // <src>mantissaBits</src> gives the number of mantissa bits to keep
+    // for float and double data; 0 means lossless.
+    // <br>The constructor taking a Record expects fields in the record with
+    // the name of the arguments in uppercase. The CODEC field is a string
+    // (lz or rle) and the SHUFFLE field is a string (none, byte or bit).
+    // If not defined, their default value is used.
+    // <group>
+    TiledCompressStMan (const String& hypercolumnName,
+                        const IPosition& defaultTileShape,
+                        TSMCodec::Codec codec = TSMCodec::LZ,
+                        TSMCodec::Shuffle shuffle = TSMCodec::ByteShuffle,
+                        uInt mantissaBits = 0,
+                        uInt maximumCacheSize = 0);
+    TiledCompressStMan (const String& hypercolumnName,
+                        const Record& spec);
+    // </group>
+
+    ~TiledCompressStMan();
+
+    // Clone this object.
+    // It does not clone TSMColumn objects possibly used.
+    virtual DataManager* clone() const;
+
+    // Get the type name of the data manager (i.e. TiledCompressStMan).
+    virtual String dataManagerType() const;
+
+    // Return a record containing data manager specifications and info.
+    // Besides the TiledShapeStMan fields it contains the CODEC, SHUFFLE and
+    // MANTISSABITS settings and the total CompressedSize and
+    // UncompressedSize of the tiles written.
+    virtual Record dataManagerSpec() const;
+
+    // Get the codec used to compress the tiles.
+    virtual TSMCodec::Codec tileCodec() const;
+
+    // Get the settings.
+    // <group>
+    TSMCodec::Shuffle shuffle() const
+      { return shuffle_p; }
+    uInt mantissaBits() const
+      { return mantissaBits_p; }
+    // </group>
+
+    // Make the object from the type name string.
+    // This function gets registered in the DataManager "constructor" map.
+    static DataManager* makeObject (const String& dataManagerType,
+                                    const Record& spec);
+
+private:
+    // Forbid copy constructor.
+    TiledCompressStMan (const TiledCompressStMan&);
+
+    // Forbid assignment.
+    TiledCompressStMan& operator= (const TiledCompressStMan&);
+
+    // Set the decode threads to the default for this storage manager.
+    void setDefaultDecodeThreads();
+
+    // Use the cache access method for the tiles.
+    void useCacheOption();
+
+    // Get the size and number of the values to shuffle for the given
+    // data column. It returns False if they need not be shuffled.
+    Bool shuffleValues (uInt colnr, uInt nrPixels,
+                        uInt& valueSize, uInt& nvalues) const;
+
+    // Read a tile, unshuffle and convert the data to local format.
+    virtual void readTile (char* local, const Block<uInt>& localOffset,
+                           const char* external,
+                           const Block<uInt>& externalOffset,
+                           uInt nrpixels);
+
+    // Write a tile after truncating, converting and shuffling the data.
+    virtual void writeTile (char* external, const Block<uInt>& externalOffset,
+                            const char* local, const Block<uInt>& localOffset,
+                            uInt nrpixels);
+
+    // Flush and optionally fsync the data.
+    // The settings are written in the AipsIO object.
+    virtual Bool flush (AipsIO&, Bool fsync);
+
+    // Let the storage manager create files as needed for a new table.
+    virtual void create (uInt nrrow);
+
+    // Open the storage manager for an existing table.
+    // The settings are read from the AipsIO object.
+    virtual void open (uInt nrrow, AipsIO&);
+
+
+    //# Declare the data members.
+    // The codec used.
+    TSMCodec::Codec codec_p;
+    // The preconditioning of the tiles.
+    TSMCodec::Shuffle shuffle_p;
+    // The number of mantissa bits to keep (0 is all).
+    uInt mantissaBits_p;
+};
+
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
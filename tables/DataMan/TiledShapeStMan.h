@@ -236,6 +236,18 @@ public:
     static DataManager* makeObject (const String& dataManagerType,
 				    const Record& spec);
 
+protected:
+    // Get the default tile shape.
+    virtual IPosition defaultTileShape() const;
+
+    // Flush and optionally fsync the data.
+    // It returns a True status if it had to flush (i.e. if data have changed).
+    virtual Bool flush (AipsIO&, Bool fsync);
+
+    // Let the storage manager create files as needed for a new table.
+    // This allows a column with an indirect array to create its file.
+    virtual void create (uInt nrrow);
+
 private:
     // Create a TiledShapeStMan.
     // This constructor is private, because it should only be used
@@ -248,9 +260,6 @@ private:
     // Forbid assignment.
     TiledShapeStMan& operator= (const TiledShapeStMan&);
 
-    // Get the default tile shape.
-    virtual IPosition defaultTileShape() const;
-
     // Add rows to the storage manager.
     void addRow (uInt nrrow);
 
@@ -287,14 +296,6 @@ private:
     virtual void setupCheck (const TableDesc& tableDesc,
 			     const Vector<String>& dataNames) const;
 
-    // Flush and optionally fsync the data.
-    // It returns a True status if it had to flush (i.e. if data have changed).
-    virtual Bool flush (AipsIO&, Bool fsync);
-
-    // Let the storage manager create files as needed for a new table.
-    // This allows a column with an indirect array to create its file.
-    virtual void create (uInt nrrow);
-
     // Read the header info.
     virtual void readHeader (uInt nrrow, Bool firstTime);
 
@@ -46,18 +46,26 @@
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/OS/DOos.h>
 #include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/tables/DataMan/DataManError.h>
 
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+Mutex TiledStMan::theirBudgetMutex;
+Bool  TiledStMan::theirBudgetInit = False;
+Int64 TiledStMan::theirBudget     = 0;
+Int64 TiledStMan::theirBudgetUsed = 0;
+
+
 TiledStMan::TiledStMan ()
 : DataManager       (),
   nrrow_p           (0),
   fileSet_p         (1, static_cast<TSMFile*>(0)),
   persMaxCacheSize_p(0),
   maxCacheSize_p    (0),
+  decodeThreads_p   (defaultDecodeThreads()),
   nrdim_p           (0),
   nrCoordVector_p   (0),
   dataChanged_p     (False)
@@ -70,6 +78,7 @@ TiledStMan::TiledStMan (const String& hypercolumnName, uInt maximumCacheSize)
   fileSet_p         (1, static_cast<TSMFile*>(0)),
   persMaxCacheSize_p(maximumCacheSize),
   maxCacheSize_p    (maximumCacheSize),
+  decodeThreads_p   (defaultDecodeThreads()),
   nrdim_p           (0),
   nrCoordVector_p   (0),
   dataChanged_p     (False)
@@ -356,6 +365,67 @@ void TiledStMan::deleteManager()
 void TiledStMan::setMaximumCacheSize (uInt nbytes)
     { maxCacheSize_p = nbytes; }
 
+TSMCodec::Codec TiledStMan::tileCodec() const
+{
+    return TSMCodec::NoCodec;
+}
+
+uInt TiledStMan::defaultDecodeThreads()
+{
+    Int nthreads;
+    AipsrcValue<Int>::find (nthreads, "table.tsm.decodethreads", 1);
+    return (nthreads < 0  ?  1 : nthreads);
+}
+
+void TiledStMan::initCacheBudget()
+{
+    if (! theirBudgetInit) {
+        Int budgetMB;
+        AipsrcValue<Int>::find (budgetMB, "table.tsm.cachebudgetmb", 0);
+        theirBudget     = Int64(budgetMB) * 1024 * 1024;
+        theirBudgetInit = True;
+    }
+}
+
+void TiledStMan::setCacheBudget (Int64 nbytes)
+{
+    ScopedMutexLock lock(theirBudgetMutex);
+    theirBudget     = nbytes;
+    theirBudgetInit = True;
+}
+
+Int64 TiledStMan::cacheBudget()
+{
+    ScopedMutexLock lock(theirBudgetMutex);
+    initCacheBudget();
+    return theirBudget;
+}
+
+Int64 TiledStMan::cacheBudgetUsed()
+{
+    ScopedMutexLock lock(theirBudgetMutex);
+    return theirBudgetUsed;
+}
+
+Int64 TiledStMan::claimCacheBudget (Int64 current, Int64 wanted, Int64 unit)
+{
+    ScopedMutexLock lock(theirBudgetMutex);
+    initCacheBudget();
+    Int64 granted = wanted;
+    if (theirBudget > 0) {
+        // The bytes held by this cache are available to it.
+        Int64 avail = theirBudget - theirBudgetUsed + current;
+        if (granted > avail) {
+            granted = (avail / unit) * unit;
+            if (granted < unit  &&  wanted > 0) {
+                granted = unit;
+            }
+        }
+    }
+    theirBudgetUsed += granted - current;
+    return granted;
+}
+
 
 Bool TiledStMan::canChangeShape() const
 {
@@ -32,10 +32,12 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/DataManager.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/OS/Conversion.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/OS/Mutex.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -173,10 +175,47 @@ public:
     // Get the current maximum cache size (in bytes).
     uInt maximumCacheSize() const;
 
+    // Set the number of threads used to read and convert the tiles
+    // needed for a slice in parallel. 1 means serial reading,
+    // 0 means the OpenMP maximum. It is only used for the cache access
+    // method (TSMOption::Cache).
+    // The default is given by aipsrc variable <src>table.tsm.decodethreads</src>
+    // (default 1).
+    void setDecodeThreads (uInt nthreads);
+
+    // Get the number of threads used to read the tiles of a slice.
+    uInt decodeThreads() const;
+
+    // Get the codec used to store the tiles compressed.
+    // The default implementation returns TSMCodec::NoCodec.
+    virtual TSMCodec::Codec tileCodec() const;
+
     // Get the current cache size (in buckets) for the hypercube in
     // the given row.
     uInt cacheSize (uInt rownr) const;
 
+    // Set the process-wide budget (in bytes) for the caches sized
+    // automatically by the tiled storage managers of all open tables.
+    // A value <= 0 means no budget. The default is given by aipsrc variable
+    // <src>table.tsm.cachebudgetmb</src> (in MB; default 0).
+    // <br>Caches sized explicitly (using an accessor object) are not
+    // part of the budget.
+    static void setCacheBudget (Int64 nbytes);
+
+    // Get the process-wide cache budget (in bytes).
+    static Int64 cacheBudget();
+
+    // Get the number of bytes of the budget in use by automatically
+    // sized caches.
+    static Int64 cacheBudgetUsed();
+
+    // Change the number of bytes claimed from the budget by a cache from
+    // <src>current</src> to (at most) <src>wanted</src>.
+    // The number granted is a multiple of <src>unit</src> and at least
+    // one unit (if <src>wanted>0</src>), so a cache can always hold a tile.
+    // It is used by TSMCube.
+    static Int64 claimCacheBudget (Int64 current, Int64 wanted, Int64 unit);
+
     // Get the hypercube shape of the data in the given row.
     const IPosition& hypercubeShape (uInt rownr) const;
 
@@ -308,14 +347,16 @@ public:
                           const Record& values, Int64 fileOffset=-1);
 
     // Read a tile and convert the data to local format.
-    void readTile (char* local, const Block<uInt>& localOffset,
-		   const char* external, const Block<uInt>& externalOffset,
-		   uInt nrpixels);
+    // It can be called by multiple threads concurrently.
+    virtual void readTile (char* local, const Block<uInt>& localOffset,
+                           const char* external,
+                           const Block<uInt>& externalOffset,
+                           uInt nrpixels);
 
     // Write a tile after converting the data to external format.
-    void writeTile (char* external, const Block<uInt>& externalOffset,
-		    const char* local, const Block<uInt>& localOffset,
-		    uInt nrpixels);
+    virtual void writeTile (char* external, const Block<uInt>& externalOffset,
+                            const char* local, const Block<uInt>& localOffset,
+                            uInt nrpixels);
 
     // Get the TSMFile object with the given sequence number.
     TSMFile* getFile (uInt sequenceNumber);
@@ -512,6 +553,8 @@ protected:
     uInt      persMaxCacheSize_p;
     // The actual maximum cache size for a hypercube.
     uInt      maxCacheSize_p;
+    // The number of threads to read the tiles of a slice.
+    uInt      decodeThreads_p;
     // The dimensionality of the hypercolumn.
     uInt      nrdim_p;
     // The number of vector coordinates.
@@ -522,17 +565,36 @@ protected:
     Bool      dataChanged_p;
 
 private:
+    // Get the default number of decode threads from the aipsrc variable.
+    static uInt defaultDecodeThreads();
+
+    // Initialize the cache budget from the aipsrc variable if not done yet.
+    // It must be called with the mutex locked.
+    static void initCacheBudget();
+
     // Forbid copy constructor.
     TiledStMan (const TiledStMan&);
 
     // Forbid assignment.
     TiledStMan& operator= (const TiledStMan&);
+
+    //# The process-wide cache budget.
+    static Mutex theirBudgetMutex;
+    static Bool  theirBudgetInit;
+    static Int64 theirBudget;
+    static Int64 theirBudgetUsed;
 };
 
 
 inline uInt TiledStMan::maximumCacheSize() const
     { return maxCacheSize_p; }
 
+inline void TiledStMan::setDecodeThreads (uInt nthreads)
+    { decodeThreads_p = nthreads; }
+
+inline uInt TiledStMan::decodeThreads() const
+    { return decodeThreads_p; }
+
 inline uInt TiledStMan::nrCoordVector() const
     { return nrCoordVector_p; }
 
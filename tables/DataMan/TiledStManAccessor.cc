@@ -88,6 +88,28 @@ uInt ROTiledStManAccessor::maximumCacheSize() const
     return dataManPtr_p->maximumCacheSize();
 }
 
+void ROTiledStManAccessor::setDecodeThreads (uInt nthreads)
+{
+    dataManPtr_p->setDecodeThreads (nthreads);
+}
+uInt ROTiledStManAccessor::decodeThreads() const
+{
+    return dataManPtr_p->decodeThreads();
+}
+
+void ROTiledStManAccessor::setCacheBudget (Int64 nbytes)
+{
+    TiledStMan::setCacheBudget (nbytes);
+}
+Int64 ROTiledStManAccessor::cacheBudget()
+{
+    return TiledStMan::cacheBudget();
+}
+Int64 ROTiledStManAccessor::cacheBudgetUsed()
+{
+    return TiledStMan::cacheBudgetUsed();
+}
+
 uInt ROTiledStManAccessor::cacheSize (uInt rownr) const
 {
     return dataManPtr_p->cacheSize (rownr);
@@ -188,6 +188,29 @@ public:
     // Get the maximum cache size (in bytes).
     uInt maximumCacheSize() const;
 
+    // Set the number of threads used to read and convert the tiles needed
+    // for a slice in parallel (1 = serial, 0 = OpenMP maximum).
+    // It is only used if the storage manager uses its own cache.
+    // The initial value is given by the aipsrc variable
+    // <src>table.tsm.decodethreads</src> (default 1).
+    void setDecodeThreads (uInt nthreads);
+
+    // Get the number of threads used to read the tiles of a slice.
+    uInt decodeThreads() const;
+
+    // Set the process-wide budget (in bytes) for the automatically sized
+    // caches of the tiled storage managers of all open tables.
+    // A value <= 0 means no budget. The initial value is given by the aipsrc
+    // variable <src>table.tsm.cachebudgetmb</src> (in MB; default 0).
+    // Caches sized using <src>setCacheSize</src> are not part of the budget.
+    static void setCacheBudget (Int64 nbytes);
+
+    // Get the process-wide cache budget (in bytes).
+    static Int64 cacheBudget();
+
+    // Get the number of bytes of the budget in use.
+    static Int64 cacheBudgetUsed();
+
     // Get the current cache size (in buckets) for the hypercube in
     // the given row.
     uInt cacheSize (uInt rownr) const;
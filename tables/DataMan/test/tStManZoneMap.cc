@@ -0,0 +1,191 @@
+//# tStManZoneMap.cc: Test program for the zone maps in SSM and ISM
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// This program tests the zone maps (minimum and maximum per bucket)
+// of scalar numeric columns in the StandardStMan and IncrementalStMan,
+// and their use in a table selection.
+
+// Check that all values in a zone are within its minimum and maximum.
+// Return the number of zones.
+uInt checkZones (const Table& tab, const String& colName,
+                 Bool create=False)
+{
+  ScalarColumn<Double> col(tab, colName);
+  Vector<uInt> startRows;
+  Vector<Double> minValues, maxValues;
+  AlwaysAssertExit (col.getZoneMap (startRows, minValues, maxValues,
+                                    create));
+  AlwaysAssertExit (startRows.size() > 0  &&  startRows[0] == 0);
+  for (uInt i=0; i<startRows.size(); ++i) {
+    uInt endRow = (i+1 < startRows.size()  ?  startRows[i+1] : tab.nrow());
+    AlwaysAssertExit (startRows[i] < endRow);
+    for (uInt row=startRows[i]; row<endRow; ++row) {
+      AlwaysAssertExit (col(row) >= minValues[i]  &&
+                        col(row) <= maxValues[i]);
+    }
+  }
+  return startRows.size();
+}
+
+// Check that a selection on a range gives the same rows as a brute
+// force selection.
+void checkSelect (const Table& tab, const String& colName,
+                  Double lower, Double upper)
+{
+  Table sel = tab(tab.col(colName) >= lower  &&  tab.col(colName) < upper);
+  ScalarColumn<Double> col(tab, colName);
+  Vector<uInt> rows(tab.nrow());
+  uInt nr = 0;
+  for (uInt row=0; row<tab.nrow(); ++row) {
+    if (col(row) >= lower  &&  col(row) < upper) {
+      rows[nr++] = row;
+    }
+  }
+  rows.resize (nr, True);
+  AlwaysAssertExit (sel.nrow() == nr);
+  AlwaysAssertExit (allEQ (sel.rowNumbers(), rows));
+  cout << colName << " in [" << lower << ',' << upper << "): "
+       << nr << " rows" << endl;
+}
+
+void createTable()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Double>("TIME"));
+  td.addColumn (ScalarColumnDesc<Double>("ITIME"));
+  td.addColumn (ScalarColumnDesc<Int>("ANT"));
+  td.addColumn (ScalarColumnDesc<Complex>("DATA"));
+  SetupNewTable newtab("tStManZoneMap_tmp.tab", td, Table::New);
+  // Use small buckets to get many zones.
+  StandardStMan ssm ("SSM", 256);
+  IncrementalStMan ism ("ISM", 512);
+  newtab.bindColumn ("TIME", ssm);
+  newtab.bindColumn ("ANT", ssm);
+  newtab.bindColumn ("DATA", ssm);
+  newtab.bindColumn ("ITIME", ism);
+  Table tab(newtab, 1000);
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Double> itime(tab, "ITIME");
+  ScalarColumn<Int> ant(tab, "ANT");
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    time.put (i, 1000 + i/10);
+    itime.put (i, 1000 + i/10);
+    ant.put (i, i%10);
+  }
+  // Columns without a zone map.
+  Vector<uInt> startRows;
+  Vector<Double> minValues, maxValues;
+  AlwaysAssertExit (! TableColumn(tab, "DATA").getZoneMap
+                    (startRows, minValues, maxValues, True));
+  // A selection does not create a zone map.
+  checkSelect (tab, "TIME", 1020, 1030);
+  checkSelect (tab, "ITIME", 1020, 1030);
+  AlwaysAssertExit (! TableColumn(tab, "TIME").getZoneMap
+                    (startRows, minValues, maxValues));
+  AlwaysAssertExit (! TableColumn(tab, "ITIME").getZoneMap
+                    (startRows, minValues, maxValues));
+  // Create the zone maps explicitly and use them.
+  cout << "TIME has " << checkZones (tab, "TIME", True) << " zones" << endl;
+  cout << "ITIME has " << checkZones (tab, "ITIME", True) << " zones" << endl;
+  checkSelect (tab, "TIME", 1020, 1030);
+  checkSelect (tab, "ITIME", 1020, 1030);
+  checkSelect (tab, "TIME", 0, 1000);
+}
+
+void changeTable()
+{
+  Table tab("tStManZoneMap_tmp.tab", Table::Update);
+  // The zone maps have been written, so they are found again.
+  AlwaysAssertExit (checkZones (tab, "TIME") > 10);
+  AlwaysAssertExit (checkZones (tab, "ITIME") > 1);
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Double> itime(tab, "ITIME");
+  // Change values in the middle and check they are found.
+  time.put (5, 2000);
+  itime.put (5, 2000);
+  checkSelect (tab, "TIME", 1999, 2001);
+  checkSelect (tab, "ITIME", 1999, 2001);
+  // Remove some rows and add rows (with new values).
+  Vector<uInt> rows(150);
+  indgen (rows, 100u);
+  tab.removeRow (rows);
+  tab.addRow (200);
+  for (uInt i=850; i<tab.nrow(); ++i) {
+    time.put (i, 3000 + i/10);
+    itime.put (i, 3000 + i/10);
+  }
+  AlwaysAssertExit (checkZones (tab, "TIME") > 10);
+  AlwaysAssertExit (checkZones (tab, "ITIME") > 1);
+  checkSelect (tab, "TIME", 1005, 1015);
+  checkSelect (tab, "ITIME", 1005, 1015);
+  checkSelect (tab, "TIME", 3090, 3095);
+  checkSelect (tab, "ITIME", 3090, 3095);
+  // Change a value in the ISM column before the last row put.
+  itime.put (900, -1);
+  checkSelect (tab, "ITIME", -2, 0);
+  checkSelect (tab, "ITIME", 3090, 3091);
+}
+
+void checkTable()
+{
+  // The changed zone maps have been written at the flush.
+  Table tab("tStManZoneMap_tmp.tab");
+  AlwaysAssertExit (checkZones (tab, "TIME") > 10);
+  AlwaysAssertExit (checkZones (tab, "ITIME") > 1);
+  checkSelect (tab, "TIME", 1999, 2001);
+  checkSelect (tab, "ITIME", -2, 0);
+  checkSelect (tab, "ITIME", 3090, 3091);
+}
+
+int main()
+{
+  try {
+    createTable();
+    changeTable();
+    checkTable();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
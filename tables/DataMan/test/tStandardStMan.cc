@@ -32,12 +32,14 @@
 #include <casacore/tables/Tables/ArrColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/DataMan/StandardStMan.h>
 #include <casacore/tables/DataMan/StandardStManAccessor.h>
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
 #include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/ArrayIter.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
@@ -92,6 +94,9 @@ void info(const Table aTable);
 // put/putColumn cache test
 void putColumnTest();
 
+// getColumnCells/putColumnCells test
+void columnCellsTest (uInt aBucketSize);
+
 int main (int argc, const char* argv[])
 {
     uInt aNr = 250;
@@ -134,7 +139,8 @@ int main (int argc, const char* argv[])
 	  aNewNrRows(i) = i;
 	}
 	deleteRows      (aNewNrRows);
-
+	// test getColumnCells and putColumnCells
+	columnCellsTest (aNr);
 
     } catch (AipsError x) {
 	cout << "Caught an exception: " << x.getMesg() << endl;
@@ -613,3 +619,134 @@ void putColumnTest()
 
 
 
+
+// Check that getColumnCells gives the same values as get per row and
+// that putColumnCells puts the values in the correct rows.
+template<typename T>
+void checkScalarCells (ScalarColumn<T>& col, const RefRows& rows,
+                       const Vector<uInt>& rownrs)
+{
+  Vector<T> vals = col.getColumnCells (rows);
+  AlwaysAssertExit (vals.nelements() == rownrs.nelements());
+  for (uInt i=0; i<rownrs.nelements(); i++) {
+    AlwaysAssertExit (vals(i) == col(rownrs(i)));
+  }
+  // Put the values reversed and put the original values back.
+  Vector<T> rev(vals.nelements());
+  for (uInt i=0; i<vals.nelements(); i++) {
+    rev(i) = vals(vals.nelements()-1-i);
+  }
+  col.putColumnCells (rows, rev);
+  for (uInt i=0; i<rownrs.nelements(); i++) {
+    AlwaysAssertExit (col(rownrs(i)) == rev(i));
+  }
+  col.putColumnCells (rows, vals);
+  AlwaysAssertExit (allEQ (col.getColumnCells(rows), vals));
+}
+
+template<typename T>
+void checkArrayCells (ArrayColumn<T>& col, const RefRows& rows,
+                      const Vector<uInt>& rownrs)
+{
+  Array<T> vals = col.getColumnCells (rows);
+  ArrayIterator<T> iter(vals, vals.ndim()-1);
+  for (uInt i=0; i<rownrs.nelements(); i++) {
+    AlwaysAssertExit (allEQ (iter.array(), col(rownrs(i))));
+    iter.next();
+  }
+  // Put the value of the first row in all rows and put the originals back.
+  Array<T> same(vals.shape());
+  ArrayIterator<T> siter(same, same.ndim()-1);
+  while (! siter.pastEnd()) {
+    siter.array() = col(rownrs(0));
+    siter.next();
+  }
+  col.putColumnCells (rows, same);
+  for (uInt i=0; i<rownrs.nelements(); i++) {
+    AlwaysAssertExit (allEQ (col(rownrs(i)), col(rownrs(0))));
+  }
+  col.putColumnCells (rows, vals);
+  AlwaysAssertExit (allEQ (col.getColumnCells(rows), vals));
+}
+
+template<typename T>
+void checkCells (ScalarColumn<T>& col, const Vector<uInt>& rownrs,
+                 const Vector<uInt>& slices, const Vector<uInt>& slrownrs)
+{
+  checkScalarCells (col, RefRows(rownrs), rownrs);
+  checkScalarCells (col, RefRows(slices, True), slrownrs);
+}
+
+template<typename T>
+void checkCells (ArrayColumn<T>& col, const Vector<uInt>& rownrs,
+                 const Vector<uInt>& slices, const Vector<uInt>& slrownrs)
+{
+  checkArrayCells (col, RefRows(rownrs), rownrs);
+  checkArrayCells (col, RefRows(slices, True), slrownrs);
+}
+
+void columnCellsTest (uInt aBucketSize)
+{
+  // Use a separate table, so the layout of the main test table (shown
+  // in the output) is not changed by the puts.
+  TableDesc td("", "1", TableDesc::Scratch);
+  td.addColumn (ScalarColumnDesc<Bool>("Col-4"));
+  td.addColumn (ScalarColumnDesc<DComplex>("Col-5"));
+  td.addColumn (ArrayColumnDesc<float>("Col-6", IPosition(3,2,3,1),
+                                       ColumnDesc::Direct));
+  td.addColumn (ArrayColumnDesc<DComplex>("Col-7", IPosition(1,2),
+                                          ColumnDesc::Direct));
+  td.addColumn (ArrayColumnDesc<Bool>("Col-8", IPosition(3,5,7,1),
+                                      ColumnDesc::Direct));
+  SetupNewTable aNewTab("tStandardStMan_tmp.cells", td, Table::New);
+  StandardStMan aSm1 ("SSM", aBucketSize);
+  aNewTab.bindAll (aSm1);
+  uInt nrow = 25;
+  Table aTable (aNewTab, nrow);
+  ScalarColumn<Bool> ad(aTable,"Col-4");
+  ScalarColumn<DComplex> ae(aTable,"Col-5");
+  ArrayColumn<float> af(aTable,"Col-6");
+  ArrayColumn<DComplex> ag(aTable,"Col-7");
+  ArrayColumn<Bool> ah(aTable,"Col-8");
+  Cube<float> arrf(IPosition(3,2,3,1));
+  Vector<DComplex> arrdc(2);
+  Cube<Bool> arrb(IPosition(3,5,7,1));
+  initArrays (arrf, arrdc, arrb);
+  for (uInt i=0; i<nrow; i++) {
+    ad.put (i, i%3 == 0);
+    ae.put (i, DComplex(i, 2*i));
+    af.put (i, arrf);
+    ag.put (i, arrdc);
+    arrb(0,0,0) = (i%2 == 0);
+    ah.put (i, arrb);
+    arrf += (float)(arrf.nelements());
+    arrdc += DComplex(2, 3);
+  }
+  // An unsorted row vector (crossing buckets back and forth).
+  Vector<uInt> rownrs(nrow);
+  for (uInt i=0; i<nrow; i++) {
+    rownrs(i) = (i%2 == 0  ?  i/2 : nrow-1-i/2);
+  }
+  // Slices: rows 1..nrow-1 with step 2 and rows 2..6 with step 2.
+  // The rows should not overlap, otherwise a put is ambiguous.
+  Vector<uInt> slices(6);
+  slices(0) = 1;
+  slices(1) = nrow-1;
+  slices(2) = 2;
+  slices(3) = 2;
+  slices(4) = 6;
+  slices(5) = 2;
+  Vector<uInt> slrownrs(nrow/2 + 3);
+  uInt nr = 0;
+  for (uInt i=1; i<nrow; i+=2) {
+    slrownrs(nr++) = i;
+  }
+  for (uInt i=2; i<=6; i+=2) {
+    slrownrs(nr++) = i;
+  }
+  checkCells (ad, rownrs, slices, slrownrs);
+  checkCells (ae, rownrs, slices, slrownrs);
+  checkCells (af, rownrs, slices, slrownrs);
+  checkCells (ag, rownrs, slices, slrownrs);
+  checkCells (ah, rownrs, slices, slrownrs);
+}
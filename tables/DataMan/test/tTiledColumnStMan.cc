@@ -59,6 +59,8 @@
 void writeFixed(const TSMOption&);
 void readTable(const TSMOption&, Bool readKeys);
 void writeNoHyper(const TSMOption&);
+void readParallel();
+void checkBudget();
 
 int main () {
     try {
@@ -68,6 +70,8 @@ int main () {
 	readTable(TSMOption::Buffer, False);
         writeFixed(TSMOption::Buffer);
 	readTable(TSMOption::Cache, False);
+	readParallel();
+	checkBudget();
     } catch (AipsError x) {
 	cout << "Caught an exception: " << x.getMesg() << endl;
 	return 1;
@@ -356,6 +360,71 @@ void readTable (const TSMOption& tsmOpt, Bool readKeys)
     }
 }
 
+// Read slices spanning multiple tiles with parallel tile decoding
+// and check them against the serial results.
+void readParallel()
+{
+    Table table("tTiledColumnStMan_tmp.data", Table::Old, TSMOption::Cache);
+    ROTiledStManAccessor accessor (table, "TSMExample");
+    ArrayColumn<float> data (table, "Data");
+    Slicer slicer (IPosition(2,1,2), IPosition(2,12,15));
+    Slicer strided (IPosition(2,0,1), IPosition(2,8,5), IPosition(2,2,4));
+    Array<float> serial = data.getSlice (7, slicer);
+    Array<float> serialStrided = data.getSlice (7, strided);
+    accessor.clearCaches();
+    accessor.setDecodeThreads (4);
+    AlwaysAssertExit (accessor.decodeThreads() == 4);
+    for (uInt i=0; i<table.nrow(); i++) {
+        accessor.setCacheSize (i, 20, False);
+        Array<float> result = data.getSlice (i, slicer);
+        AlwaysAssertExit (allEQ (result, serial + float(200*(Int(i)-7))));
+        Array<float> resultStrided = data.getSlice (i, strided);
+        AlwaysAssertExit (allEQ (resultStrided,
+                                 serialStrided + float(200*(Int(i)-7))));
+        accessor.clearCaches();
+    }
+    cout << "parallel getSlice's have been done" << endl;
+}
+
+// Check the automatic cache sizing for alternating access patterns
+// and the process-wide cache budget.
+void checkBudget()
+{
+    Table table("tTiledColumnStMan_tmp.data", Table::Old, TSMOption::Cache);
+    ROTiledStManAccessor accessor (table, "TSMExample");
+    ArrayColumn<float> data (table, "Data");
+    Cube<float> expected(1,1,51);
+    for (uInt i=0; i<51; i++) {
+        expected(0,0,i) = 200*i + 16*3 + 2;
+    }
+    Slicer slicer (IPosition(2,2,3));
+    // A channel-wise pass needs a large cache; a row-wise pass
+    // in between must not shrink it.
+    AlwaysAssertExit (allEQ (data.getColumn(slicer), expected));
+    uInt colSize = accessor.cacheSize(0);
+    AlwaysAssertExit (colSize > 5);
+    data.get (0);
+    AlwaysAssertExit (accessor.cacheSize(0) == colSize);
+    AlwaysAssertExit (allEQ (data.getColumn(slicer), expected));
+    AlwaysAssertExit (accessor.cacheSize(0) == colSize);
+    AlwaysAssertExit (ROTiledStManAccessor::cacheBudgetUsed() ==
+                      Int64(colSize) * accessor.bucketSize(0));
+    // Limit the cache using the budget.
+    accessor.clearCaches();
+    AlwaysAssertExit (ROTiledStManAccessor::cacheBudgetUsed() == 0);
+    ROTiledStManAccessor::setCacheBudget (5 * accessor.bucketSize(0));
+    AlwaysAssertExit (allEQ (data.getColumn(slicer), expected));
+    AlwaysAssertExit (accessor.cacheSize(0) == 5);
+    AlwaysAssertExit (ROTiledStManAccessor::cacheBudgetUsed() ==
+                      5 * accessor.bucketSize(0));
+    // A user-set cache is not part of the budget.
+    accessor.setCacheSize (0, 10, False);
+    AlwaysAssertExit (accessor.cacheSize(0) == 10);
+    AlwaysAssertExit (ROTiledStManAccessor::cacheBudgetUsed() == 0);
+    ROTiledStManAccessor::setCacheBudget (0);
+    cout << "cache budget has been checked" << endl;
+}
+
 // First build a description.
 void writeNoHyper(const TSMOption& tsmOpt)
 {
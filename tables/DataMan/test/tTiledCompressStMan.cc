@@ -0,0 +1,391 @@
+//# tTiledCompressStMan.cc: Test program for the TiledCompressStMan class
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/TiledCompressStMan.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <vector>
+
+using namespace casacore;
+
+// This program tests the class TiledCompressStMan and the codec
+// functions in TSMCodec.
+
+// Compress, decompress and compare a buffer.
+// Return the compressed length.
+uInt checkCodec (const std::vector<char>& data,
+                 TSMCodec::Codec codec = TSMCodec::LZ)
+{
+  uInt length = data.size();
+  std::vector<char> comp(TSMCodec::maxCompressedLength(length));
+  uInt compLength = TSMCodec::compress (&(comp[0]), &(data[0]), length,
+                                        codec);
+  AlwaysAssertExit (compLength <= comp.size());
+  std::vector<char> result(length + 1);
+  TSMCodec::decompress (&(result[0]), length, &(comp[0]), compLength,
+                        codec);
+  AlwaysAssertExit (std::equal (data.begin(), data.end(), result.begin()));
+  return compLength;
+}
+
+void testCodec()
+{
+  // Random data does not compress.
+  std::vector<char> data(100000);
+  uInt seed = 1;
+  for (uInt i=0; i<data.size(); i++) {
+    seed = seed*1103515245 + 12345;
+    data[i] = char(seed >> 16);
+  }
+  AlwaysAssertExit (checkCodec(data) > data.size());
+  // Constant data compresses very well.
+  std::fill (data.begin(), data.end(), char(7));
+  AlwaysAssertExit (checkCodec(data) < data.size()/100);
+  // A repeating pattern and some short buffers.
+  for (uInt i=0; i<data.size(); i++) {
+    data[i] = char(i%13 + i/1000);
+  }
+  AlwaysAssertExit (checkCodec(data) < data.size()/10);
+  for (uInt n=0; n<40; n++) {
+    std::vector<char> small(data.begin(), data.begin()+n);
+    if (n > 0) {
+      checkCodec (small);
+    }
+  }
+  // Invalid data must be detected.
+  std::vector<char> comp(TSMCodec::maxCompressedLength(data.size()));
+  uInt compLength = TSMCodec::compress (&(comp[0]), &(data[0]), data.size());
+  std::vector<char> result(data.size());
+  try {
+    TSMCodec::decompress (&(result[0]), data.size(), &(comp[0]),
+                          compLength/2);
+    AlwaysAssertExit (False);
+  } catch (const DataManError&) {
+  }
+  try {
+    TSMCodec::decompress (&(result[0]), data.size()-1, &(comp[0]),
+                          compLength);
+    AlwaysAssertExit (False);
+  } catch (const DataManError&) {
+  }
+  cout << "codec tests ok" << endl;
+}
+
+void testRunLength()
+{
+  // Flags with long runs.
+  std::vector<char> data(100003, 0);
+  for (uInt i=1000; i<30000; i++) {
+    data[i] = char(255);
+  }
+  for (uInt i=50000; i<50100; i++) {
+    data[i] = char(i);
+  }
+  data[100002] = 3;
+  AlwaysAssertExit (checkCodec(data, TSMCodec::RunLength) < 150);
+  // Random data take only a bit more space.
+  uInt seed = 1;
+  for (uInt i=0; i<data.size(); i++) {
+    seed = seed*1103515245 + 12345;
+    data[i] = char(seed >> 16);
+  }
+  AlwaysAssertExit (checkCodec(data, TSMCodec::RunLength) < data.size()+10);
+  for (uInt n=1; n<40; n++) {
+    std::vector<char> small(data.begin(), data.begin()+n);
+    checkCodec (small, TSMCodec::RunLength);
+  }
+  // Invalid data must be detected.
+  std::fill (data.begin(), data.end(), char(0));
+  std::vector<char> comp(TSMCodec::maxCompressedLength(data.size()));
+  uInt compLength = TSMCodec::compress (&(comp[0]), &(data[0]), data.size(),
+                                        TSMCodec::RunLength);
+  std::vector<char> result(data.size());
+  try {
+    TSMCodec::decompress (&(result[0]), data.size()-8, &(comp[0]),
+                          compLength, TSMCodec::RunLength);
+    AlwaysAssertExit (False);
+  } catch (const DataManError&) {
+  }
+  AlwaysAssertExit (TSMCodec::codecType("RLE") == TSMCodec::RunLength);
+  AlwaysAssertExit (TSMCodec::codecName(TSMCodec::LZ) == "lz");
+  cout << "run-length tests ok" << endl;
+}
+
+void testShuffle()
+{
+  // Check that unshuffling undoes shuffling for all types and sizes.
+  for (uInt type=0; type<3; type++) {
+    TSMCodec::Shuffle shuffle = TSMCodec::Shuffle(type);
+    for (uInt valueSize=1; valueSize<=8; valueSize*=2) {
+      for (uInt nvalues=0; nvalues<50; nvalues+=7) {
+        uInt length = valueSize*nvalues;
+        std::vector<char> data(length+1), shuf(length+1), res(length+1);
+        for (uInt i=0; i<length; i++) {
+          data[i] = char(i*i + 3*i);
+        }
+        TSMCodec::shuffle (&(shuf[0]), &(data[0]), nvalues, valueSize,
+                           shuffle);
+        TSMCodec::unshuffle (&(res[0]), &(shuf[0]), nvalues, valueSize,
+                             shuffle);
+        AlwaysAssertExit (std::equal (data.begin(), data.begin()+length,
+                                      res.begin()));
+      }
+    }
+  }
+  // Byte shuffling puts the bytes of the values together.
+  Int values[3] = {1, 2, 3};
+  char shuf[12];
+  TSMCodec::shuffle (shuf, reinterpret_cast<char*>(values), 3, 4,
+                     TSMCodec::ByteShuffle);
+  // Depending on the endianness the low order bytes are first or last.
+  uInt nzero = 0;
+  for (uInt i=0; i<12; i++) {
+    if (shuf[i] == 0) nzero++;
+  }
+  AlwaysAssertExit (nzero == 9);
+  AlwaysAssertExit ((shuf[0] == 1  &&  shuf[2] == 3)  ||
+                    (shuf[9] == 1  &&  shuf[11] == 3));
+  AlwaysAssertExit (TSMCodec::shuffleType("BYTE") == TSMCodec::ByteShuffle);
+  AlwaysAssertExit (TSMCodec::shuffleName(TSMCodec::BitShuffle) == "bit");
+  cout << "shuffle tests ok" << endl;
+}
+
+void testTruncate()
+{
+  Float fvalues[5] = {1.2345678f, -3.1415927f, 1e-30f, 0.f, 1e30f};
+  Float forig[5];
+  std::copy (fvalues, fvalues+5, forig);
+  TSMCodec::truncateMantissa (fvalues, 5, 10);
+  for (uInt i=0; i<5; i++) {
+    AlwaysAssertExit (std::abs(fvalues[i] - forig[i]) <=
+                      std::abs(forig[i]) / 1024);
+  }
+  Double dvalues[3] = {1.2345678901234, -2.5e100, 7.};
+  Double dorig[3];
+  std::copy (dvalues, dvalues+3, dorig);
+  TSMCodec::truncateMantissa (dvalues, 3, 20);
+  for (uInt i=0; i<3; i++) {
+    AlwaysAssertExit (std::abs(dvalues[i] - dorig[i]) <=
+                      std::abs(dorig[i]) / (1024*1024));
+  }
+  AlwaysAssertExit (dvalues[2] == 7.);
+  cout << "truncate tests ok" << endl;
+}
+
+// Make the data of a row.
+void makeData (uInt row, Array<Complex>& data, Array<Float>& weight,
+               Array<Bool>& flag)
+{
+  Array<Complex>::iterator diter = data.begin();
+  Array<Float>::iterator witer = weight.begin();
+  Array<Bool>::iterator fiter = flag.begin();
+  for (uInt i=0; i<data.size(); i++) {
+    *diter++ = Complex (100 + row%7 + 0.01*i, Float(i%4) - 0.5*row);
+    *witer++ = 1 + (i/64)%2;
+    *fiter++ = (i+row)%17 == 0;
+  }
+}
+
+void createTable (const IPosition& shape, uInt nrow,
+                  TSMCodec::Codec codec, TSMCodec::Shuffle shuffle,
+                  uInt mantissaBits)
+{
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Complex>("DATA", 2));
+  td.addColumn (ArrayColumnDesc<Float>("WEIGHT", 2));
+  td.addColumn (ArrayColumnDesc<Bool>("FLAG", 2));
+  td.defineHypercolumn ("TSMData", 3,
+                        stringToVector("DATA,WEIGHT,FLAG"));
+  SetupNewTable newtab("tTiledCompressStMan_tmp.data", td, Table::New);
+  TiledCompressStMan stman ("TSMData", IPosition(3,4,32,8),
+                            codec, shuffle, mantissaBits);
+  newtab.bindAll (stman);
+  Table tab(newtab, nrow);
+  ArrayColumn<Complex> data(tab, "DATA");
+  ArrayColumn<Float> weight(tab, "WEIGHT");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  Array<Complex> darr(shape);
+  Array<Float> warr(shape);
+  Array<Bool> farr(shape);
+  for (uInt i=0; i<nrow; i++) {
+    makeData (i, darr, warr, farr);
+    data.put (i, darr);
+    weight.put (i, warr);
+    flag.put (i, farr);
+  }
+}
+
+void checkTable (const IPosition& shape, uInt nrow, uInt mantissaBits,
+                 const TSMOption& tsmOpt)
+{
+  Table tab("tTiledCompressStMan_tmp.data", Table::Old, tsmOpt);
+  AlwaysAssertExit (tab.nrow() == nrow);
+  ArrayColumn<Complex> data(tab, "DATA");
+  ArrayColumn<Float> weight(tab, "WEIGHT");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  Array<Complex> darr(shape);
+  Array<Float> warr(shape);
+  Array<Bool> farr(shape);
+  // The tolerance for the truncated mantissas.
+  Float tol = (mantissaBits == 0  ?  0 : 1. / (1 << mantissaBits));
+  for (uInt i=0; i<nrow; i++) {
+    makeData (i, darr, warr, farr);
+    if (tol == 0) {
+      AlwaysAssertExit (allEQ (data(i), darr));
+    } else {
+      AlwaysAssertExit (allNearAbs (data(i), darr, 110*tol));
+    }
+    AlwaysAssertExit (allEQ (weight(i), warr));
+    AlwaysAssertExit (allEQ (flag(i), farr));
+  }
+  // Read a slice of all rows using multiple threads.
+  ROTiledStManAccessor acc(tab, "TSMData");
+  acc.setDecodeThreads (4);
+  Slicer slicer(IPosition(2,1,10), IPosition(2,2,20));
+  Array<Complex> slice = data.getColumn (slicer);
+  for (uInt i=0; i<nrow; i++) {
+    makeData (i, darr, warr, farr);
+    Array<Complex> sl = slice[i];
+    AlwaysAssertExit (allNearAbs (sl, darr(slicer), 110*tol));
+  }
+  Record spec = tab.dataManagerInfo().subRecord(0).subRecord("SPEC");
+  cout << "CODEC=" << spec.asString("CODEC")
+       << " SHUFFLE=" << spec.asString("SHUFFLE")
+       << " MANTISSABITS=" << spec.asInt("MANTISSABITS") << endl;
+  Int64 compSize = spec.asInt64 ("CompressedSize");
+  Int64 uncompSize = spec.asInt64 ("UncompressedSize");
+  cout << "compressed " << (compSize > 0  &&  compSize < uncompSize/2)
+       << endl;
+}
+
+void updateTable (const IPosition& shape, uInt nrow)
+{
+  Table tab("tTiledCompressStMan_tmp.data", Table::Update);
+  ArrayColumn<Complex> data(tab, "DATA");
+  ArrayColumn<Float> weight(tab, "WEIGHT");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  Array<Complex> darr(shape);
+  Array<Float> warr(shape);
+  Array<Bool> farr(shape);
+  // Rewrite some rows with random data (which compresses worse),
+  // so their tiles have to be moved.
+  uInt seed = 1;
+  for (uInt i=0; i<nrow; i+=3) {
+    for (Array<Complex>::iterator iter=darr.begin(); iter!=darr.end();
+         ++iter) {
+      seed = seed*1103515245 + 12345;
+      *iter = Complex(seed>>8, seed&255);
+    }
+    data.put (i, darr);
+  }
+  tab.flush();
+  // Write them back (which compresses better again).
+  for (uInt i=0; i<nrow; i+=3) {
+    makeData (i, darr, warr, farr);
+    data.put (i, darr);
+  }
+  // Add rows with another shape (thus another hypercube).
+  IPosition shape2(2, 2, 16);
+  Array<Complex> darr2(shape2);
+  Array<Float> warr2(shape2);
+  Array<Bool> farr2(shape2);
+  tab.addRow (5);
+  for (uInt i=nrow; i<nrow+5; i++) {
+    makeData (i, darr2, warr2, farr2);
+    data.put (i, darr2);
+    weight.put (i, warr2);
+    flag.put (i, farr2);
+  }
+}
+
+void checkUpdated (const IPosition& shape, uInt nrow)
+{
+  Table tab("tTiledCompressStMan_tmp.data");
+  AlwaysAssertExit (tab.nrow() == nrow+5);
+  ArrayColumn<Complex> data(tab, "DATA");
+  Array<Complex> darr(shape);
+  Array<Float> warr(shape);
+  Array<Bool> farr(shape);
+  for (uInt i=0; i<nrow; i++) {
+    makeData (i, darr, warr, farr);
+    AlwaysAssertExit (allEQ (data(i), darr));
+  }
+  IPosition shape2(2, 2, 16);
+  Array<Complex> darr2(shape2);
+  Array<Float> warr2(shape2);
+  Array<Bool> farr2(shape2);
+  for (uInt i=nrow; i<nrow+5; i++) {
+    makeData (i, darr2, warr2, farr2);
+    AlwaysAssertExit (allEQ (data(i), darr2));
+  }
+  cout << "updated table ok" << endl;
+}
+
+int main()
+{
+  try {
+    testCodec();
+    testShuffle();
+    testTruncate();
+    testRunLength();
+    IPosition shape(2, 4, 256);
+    uInt nrow = 50;
+    // Lossless with byte and bit shuffling.
+    createTable (shape, nrow, TSMCodec::LZ, TSMCodec::ByteShuffle, 0);
+    checkTable (shape, nrow, 0, TSMOption());
+    createTable (shape, nrow, TSMCodec::LZ, TSMCodec::BitShuffle, 0);
+    checkTable (shape, nrow, 0, TSMOption());
+    // Lossy; the table can also be opened asking for mmap.
+    createTable (shape, nrow, TSMCodec::LZ, TSMCodec::ByteShuffle, 12);
+    checkTable (shape, nrow, 12, TSMOption(TSMOption::MMap, 0, 0));
+    // The run-length codec works for all data types.
+    createTable (shape, nrow, TSMCodec::RunLength, TSMCodec::ByteShuffle, 0);
+    checkTable (shape, nrow, 0, TSMOption());
+    // Update a lossless table.
+    createTable (shape, nrow, TSMCodec::LZ, TSMCodec::NoShuffle, 0);
+    checkTable (shape, nrow, 0, TSMOption(TSMOption::Buffer, 0, 0));
+    updateTable (shape, nrow);
+    checkUpdated (shape, nrow);
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -34,6 +34,7 @@
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/TaQL/TaQLStatement.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
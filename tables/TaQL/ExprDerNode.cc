@@ -32,6 +32,7 @@
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/BasicMath/Math.h>
@@ -39,6 +40,7 @@
 #include <casacore/casa/OS/Time.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
 
 
 
@@ -54,6 +56,10 @@ TableExprNodeConstBool::~TableExprNodeConstBool()
 {}
 Bool TableExprNodeConstBool::getBool (const TableExprId&)
     { return value_p; }
+Bool TableExprNodeConstBool::canGetBlock() const
+    { return True; }
+void TableExprNodeConstBool::getBoolBlock (rownr_t, uInt nrow, Bool* result)
+    { std::fill (result, result+nrow, value_p); }
 
 TableExprNodeConstInt::TableExprNodeConstInt (const Int64& val)
 : TableExprNodeBinary (NTInt, VTScalar, OtLiteral, Table()),
@@ -67,6 +73,12 @@ Double TableExprNodeConstInt::getDouble (const TableExprId&)
     { return value_p; }
 DComplex TableExprNodeConstInt::getDComplex (const TableExprId&)
     { return double(value_p); }
+Bool TableExprNodeConstInt::canGetBlock() const
+    { return True; }
+void TableExprNodeConstInt::getIntBlock (rownr_t, uInt nrow, Int64* result)
+    { std::fill (result, result+nrow, value_p); }
+void TableExprNodeConstInt::getDoubleBlock (rownr_t, uInt nrow, Double* result)
+    { std::fill (result, result+nrow, Double(value_p)); }
 
 TableExprNodeConstDouble::TableExprNodeConstDouble (const Double& val)
 : TableExprNodeBinary (NTDouble, VTScalar, OtLiteral, Table()),
@@ -78,6 +90,11 @@ Double TableExprNodeConstDouble::getDouble (const TableExprId&)
     { return value_p; }
 DComplex TableExprNodeConstDouble::getDComplex (const TableExprId&)
     { return value_p; }
+Bool TableExprNodeConstDouble::canGetBlock() const
+    { return True; }
+void TableExprNodeConstDouble::getDoubleBlock (rownr_t, uInt nrow,
+                                               Double* result)
+    { std::fill (result, result+nrow, value_p); }
 
 TableExprNodeConstDComplex::TableExprNodeConstDComplex (const DComplex& val)
 : TableExprNodeBinary (NTComplex, VTScalar, OtLiteral, Table()),
@@ -235,6 +252,90 @@ String TableExprNodeColumn::getString (const TableExprId& id)
     return val;
 }
 
+// Read a block of rows from a column with data type T and convert the
+// values to the result type U.
+template<typename T, typename U>
+void getColumnBlock (const TableColumn& tabcol, rownr_t startRow, uInt nrow,
+                     U* result)
+{
+    Vector<T> vec(nrow);
+    {
+        ScopedMutexLock lock(TableExprNodeRep::getMutex());
+        ScalarColumn<T>(tabcol).getColumnRange
+                     (Slicer(IPosition(1,startRow), IPosition(1,nrow)), vec);
+    }
+    const T* data = vec.data();
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = data[i];
+    }
+}
+
+// Read a block from a real numeric column.
+template<typename U>
+void getNumericColumnBlock (const TableColumn& tabcol, rownr_t startRow,
+                            uInt nrow, U* result)
+{
+    switch (tabcol.columnDesc().dataType()) {
+    case TpUChar:
+        getColumnBlock<uChar>  (tabcol, startRow, nrow, result);
+        break;
+    case TpShort:
+        getColumnBlock<Short>  (tabcol, startRow, nrow, result);
+        break;
+    case TpUShort:
+        getColumnBlock<uShort> (tabcol, startRow, nrow, result);
+        break;
+    case TpInt:
+        getColumnBlock<Int>    (tabcol, startRow, nrow, result);
+        break;
+    case TpUInt:
+        getColumnBlock<uInt>   (tabcol, startRow, nrow, result);
+        break;
+    case TpFloat:
+        getColumnBlock<Float>  (tabcol, startRow, nrow, result);
+        break;
+    case TpDouble:
+        getColumnBlock<Double> (tabcol, startRow, nrow, result);
+        break;
+    default:
+        throw TableInvExpr ("TableExprNodeColumn: invalid data type for a "
+                            "block get of column " +
+                            tabcol.columnDesc().name());
+    }
+}
+
+Bool TableExprNodeColumn::canGetBlock() const
+{
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpBool:
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpFloat:
+    case TpDouble:
+        return True;
+    default:
+        return False;
+    }
+}
+void TableExprNodeColumn::getBoolBlock (rownr_t startRow, uInt nrow,
+                                        Bool* result)
+{
+    getColumnBlock<Bool> (tabCol_p, startRow, nrow, result);
+}
+void TableExprNodeColumn::getIntBlock (rownr_t startRow, uInt nrow,
+                                       Int64* result)
+{
+    getNumericColumnBlock (tabCol_p, startRow, nrow, result);
+}
+void TableExprNodeColumn::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                          Double* result)
+{
+    getNumericColumnBlock (tabCol_p, startRow, nrow, result);
+}
+
 Bool TableExprNodeColumn::getColumnDataType (DataType& dt) const
 {
     dt = tabCol_p.columnDesc().dataType();
@@ -310,6 +411,24 @@ Int64 TableExprNodeRownr::getInt (const TableExprId& id)
     AlwaysAssert (id.byRow(), AipsError);
     return id.rownr() + origin_p;
 }
+Bool TableExprNodeRownr::canGetBlock() const
+{
+    return True;
+}
+void TableExprNodeRownr::getIntBlock (rownr_t startRow, uInt nrow,
+                                      Int64* result)
+{
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = startRow + i + origin_p;
+    }
+}
+void TableExprNodeRownr::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                         Double* result)
+{
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = startRow + i + origin_p;
+    }
+}
 
 
 
@@ -78,6 +78,8 @@ public:
     TableExprNodeConstBool (const Bool& value);
     ~TableExprNodeConstBool();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
 private:
     Bool value_p;
 };
@@ -111,6 +113,9 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getIntBlock    (rownr_t startRow, uInt nrow, Int64* result);
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
 private:
     Int64 value_p;
 };
@@ -143,6 +148,8 @@ public:
     ~TableExprNodeConstDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
 private:
     Double value_p;
 };
@@ -322,6 +329,15 @@ public:
     String   getString   (const TableExprId& id);
     const TableColumn& getColumn() const;
 
+    // Get the data for a block of rows using a single getColumnRange.
+    // It can be done for Bool and real numeric columns.
+    // <group>
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock   (rownr_t startRow, uInt nrow, Bool* result);
+    virtual void getIntBlock    (rownr_t startRow, uInt nrow, Int64* result);
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
+    // </group>
+
     // Get the data for the given rows.
     Array<Bool>     getColumnBool (const Vector<uInt>& rownrs);
     Array<uChar>    getColumnuChar (const Vector<uInt>& rownrs);
@@ -373,6 +389,9 @@ public:
     TableExprNodeRownr (const Table&, uInt origin);
     ~TableExprNodeRownr();
     Int64  getInt (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getIntBlock    (rownr_t startRow, uInt nrow, Int64* result);
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
 private:
     uInt origin_p;
 };
@@ -34,6 +34,8 @@
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Containers/Block.h>
 #include <casacore/tables/TaQL/MArrayMath.h>
 #include <casacore/tables/TaQL/MArrayLogical.h>
 #include <casacore/casa/Quanta/MVTime.h>
@@ -56,7 +58,13 @@ TableExprFuncNode::TableExprFuncNode (FunctionType ftype, NodeDataType dtype,
   funcType_p         (ftype),
   argDataType_p      (dtype),
   scale_p            (1),
-  table_p            (table)
+  table_p            (table),
+  pairNode1_p        (0),
+  pairNode2_p        (0),
+  pairStart1_p       (0),
+  pairStart2_p       (0),
+  pairSize1_p        (0),
+  pairSize2_p        (0)
 {}
 
 TableExprFuncNode::~TableExprFuncNode()
@@ -79,6 +87,10 @@ TableExprNodeRep* TableExprFuncNode::fillNode
     thisNode->setScale (scale);
     // Some functions on a variable can already give a constant result.
     thisNode->tryToConst();
+    // Prepare the fast evaluation of any(col1==arr1 && col2==arr2).
+    if (thisNode->funcType() == anyFUNC) {
+        thisNode->makePairLookup();
+    }
     if (thisNode->operands_p.nelements() > 0) {
 	return convertNode (thisNode, True);
     }
@@ -348,6 +360,177 @@ void TableExprFuncNode::tryToConst()
     }
 }
 
+// Get the scalar and constant array operand of an array comparison
+// scalar==array of integers.
+static Bool getPairOperands (const TableExprNodeRep* node,
+                             TableExprNodeRep*& scalar, Array<Int64>& values)
+{
+    const TableExprNodeBinary* eqNode =
+        dynamic_cast<const TableExprNodeBinary*>(node);
+    if (eqNode == 0  ||  node->operType() != TableExprNodeRep::OtEQ  ||
+        node->valueType() != TableExprNodeRep::VTArray) {
+        return False;
+    }
+    //# The children are part of the tree, so they can be used non-const.
+    TableExprNodeRep* left  =
+        const_cast<TableExprNodeRep*>(eqNode->getLeftChild());
+    TableExprNodeRep* right =
+        const_cast<TableExprNodeRep*>(eqNode->getRightChild());
+    if (left == 0  ||  right == 0) {
+        return False;
+    }
+    if (left->valueType() == TableExprNodeRep::VTArray) {
+        std::swap (left, right);
+    }
+    if (left->valueType() != TableExprNodeRep::VTScalar  ||
+        left->dataType()  != TableExprNodeRep::NTInt  ||
+        !left->canGetBlock()  ||
+        right->valueType() != TableExprNodeRep::VTArray  ||
+        right->dataType()  != TableExprNodeRep::NTInt  ||
+        !right->isConstant()) {
+        return False;
+    }
+    MArray<Int64> arr = right->getArrayInt (0);
+    if (arr.hasMask()  ||  arr.ndim() != 1) {
+        return False;
+    }
+    scalar = left;
+    values.reference (arr.array());
+    return True;
+}
+
+void TableExprFuncNode::makePairLookup()
+{
+    pairLookup_p.clear();
+    if (operands_p.nelements() != 1  ||
+        operands_p[0]->operType() != OtAND  ||
+        operands_p[0]->valueType() != VTArray) {
+        return;
+    }
+    const TableExprNodeBinary* andNode =
+        dynamic_cast<const TableExprNodeBinary*>(operands_p[0]);
+    if (andNode == 0) {
+        return;
+    }
+    TableExprNodeRep* node1;
+    TableExprNodeRep* node2;
+    Array<Int64> values1, values2;
+    if (!getPairOperands (andNode->getLeftChild(), node1, values1)  ||
+        !getPairOperands (andNode->getRightChild(), node2, values2)  ||
+        values1.size() != values2.size()  ||  values1.empty()) {
+        return;
+    }
+    Vector<Int64> vec1(values1);
+    Vector<Int64> vec2(values2);
+    Int64 min1, max1, min2, max2;
+    minMax (min1, max1, vec1);
+    minMax (min2, max2, vec2);
+    // Only make a lookup table if not too large (as for antenna IDs).
+    Int64 size1 = max1 - min1 + 1;
+    Int64 size2 = max2 - min2 + 1;
+    if (size1 <= 0  ||  size2 <= 0  ||  size1 > 65536  ||  size2 > 65536  ||
+        size1 * size2 > 16*1024*1024) {
+        return;
+    }
+    pairNode1_p  = node1;
+    pairNode2_p  = node2;
+    pairStart1_p = min1;
+    pairStart2_p = min2;
+    pairSize1_p  = size1;
+    pairSize2_p  = size2;
+    pairLookup_p.resize (size1*size2, False);
+    for (uInt i=0; i<vec1.size(); ++i) {
+        pairLookup_p[(vec1[i] - min1) * size2 + vec2[i] - min2] = True;
+    }
+}
+
+Bool TableExprFuncNode::canGetBlock() const
+{
+    switch (funcType_p) {
+    case anyFUNC:
+        return pairLookup_p.size() > 0;
+    case absFUNC:
+    case squareFUNC:
+    case sqrtFUNC:
+        return operands_p.nelements() == 1  &&
+               operands_p[0]->valueType() == VTScalar  &&
+               (operands_p[0]->dataType() == NTInt  ||
+                operands_p[0]->dataType() == NTDouble)  &&
+               operands_p[0]->canGetBlock();
+    default:
+        return False;
+    }
+}
+
+void TableExprFuncNode::getBoolBlock (rownr_t startRow, uInt nrow,
+                                      Bool* result)
+{
+    if (pairLookup_p.empty()) {
+        TableExprNodeRep::getBoolBlock (startRow, nrow, result);
+        return;
+    }
+    Block<Int64> vals1(nrow), vals2(nrow);
+    pairNode1_p->getIntBlock (startRow, nrow, vals1.storage());
+    pairNode2_p->getIntBlock (startRow, nrow, vals2.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = inPairLookup (vals1[i], vals2[i]);
+    }
+}
+
+void TableExprFuncNode::getIntBlock (rownr_t startRow, uInt nrow,
+                                     Int64* result)
+{
+    if (dataType() != NTInt  ||  !canGetBlock()) {
+        TableExprNodeRep::getIntBlock (startRow, nrow, result);
+        return;
+    }
+    operands_p[0]->getIntBlock (startRow, nrow, result);
+    if (funcType_p == absFUNC) {
+        for (uInt i=0; i<nrow; ++i) {
+            result[i] = abs(result[i]);
+        }
+    } else {
+        for (uInt i=0; i<nrow; ++i) {
+            result[i] *= result[i];
+        }
+    }
+}
+
+void TableExprFuncNode::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                        Double* result)
+{
+    if (!canGetBlock()  ||  funcType_p == anyFUNC) {
+        TableExprNodeRep::getDoubleBlock (startRow, nrow, result);
+        return;
+    }
+    if (dataType() == NTInt) {
+        Block<Int64> vals(nrow);
+        getIntBlock (startRow, nrow, vals.storage());
+        for (uInt i=0; i<nrow; ++i) {
+            result[i] = vals[i];
+        }
+        return;
+    }
+    operands_p[0]->getDoubleBlock (startRow, nrow, result);
+    switch (funcType_p) {
+    case absFUNC:
+        for (uInt i=0; i<nrow; ++i) {
+            result[i] = abs(result[i]);
+        }
+        break;
+    case squareFUNC:
+        for (uInt i=0; i<nrow; ++i) {
+            result[i] *= result[i];
+        }
+        break;
+    default:
+        for (uInt i=0; i<nrow; ++i) {
+            result[i] = sqrt(result[i]) * scale_p;
+        }
+        break;
+    }
+}
+
 Bool TableExprFuncNode::getBool (const TableExprId& id)
 {
     switch (funcType_p) {
@@ -365,6 +548,10 @@ Bool TableExprFuncNode::getBool (const TableExprId& id)
       }
       return string2Bool (operands_p[0]->getString(id));
     case anyFUNC:
+        if (! pairLookup_p.empty()) {
+            return inPairLookup (pairNode1_p->getInt(id),
+                                 pairNode2_p->getInt(id));
+        }
         if (operands_p[0]->valueType() == VTArray) {
             return anyTrue (operands_p[0]->getArrayBool(id));
 	}
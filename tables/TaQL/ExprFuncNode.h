@@ -32,6 +32,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/TaQL/ExprNodeRep.h>
 #include <casacore/casa/Quanta/MVAngle.h>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -334,6 +335,21 @@ public:
     MVTime    getDate     (const TableExprId& id);
     // </group>
 
+    // Block evaluation is supported for the functions abs, square and sqrt
+    // of a scalar Int or Double operand supporting it.
+    // It is also supported for <src>any(col1==arr1 && col2==arr2)</src>
+    // where col1 and col2 are scalar integer expressions and arr1 and arr2
+    // constant integer vectors, as generated by MSSelection for a list of
+    // baselines. For it, a lookup table of all (arr1[i],arr2[i]) pairs is
+    // made when the node is filled, so a row is tested by a single lookup
+    // instead of comparing the arrays.
+    // <group>
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock   (rownr_t startRow, uInt nrow, Bool* result);
+    virtual void getIntBlock    (rownr_t startRow, uInt nrow, Int64* result);
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
+    // </group>
+
     // Check the data and value types of the operands.
     // It sets the exptected data and value types of the operands.
     // Set the value type of the function result and returns
@@ -443,6 +459,20 @@ private:
     // If so, set the expression type to Constant.
     void tryToConst();
 
+    // Make the pair lookup table for any(col1==arr1 && col2==arr2)
+    // if the operand has that form.
+    void makePairLookup();
+
+    // Test if a pair of values is in the pair lookup table.
+    Bool inPairLookup (Int64 val1, Int64 val2) const
+    {
+        val1 -= pairStart1_p;
+        val2 -= pairStart2_p;
+        return val1 >= 0  &&  val1 < pairSize1_p  &&
+               val2 >= 0  &&  val2 < pairSize2_p  &&
+               pairLookup_p[val1*pairSize2_p + val2];
+    }
+
     // Make the units of nodes from <src>starg</src> till <src>endarg</src>
     // equal. Return the unit found.
     static const Unit& makeEqualUnits (PtrBlock<TableExprNodeRep*>& nodes,
@@ -454,6 +484,15 @@ private:
     Double       scale_p;           // possible scaling for unit conversion
                                     // (needed for sqrt)
     Table        table_p;           // table (for iscolumn and iskeyword)
+    //# The pair lookup table for any(col1==arr1 && col2==arr2).
+    //# It is empty if not used.
+    TableExprNodeRep*  pairNode1_p;
+    TableExprNodeRep*  pairNode2_p;
+    Int64              pairStart1_p;
+    Int64              pairStart2_p;
+    Int64              pairSize1_p;
+    Int64              pairSize2_p;
+    std::vector<Bool>  pairLookup_p;
 };
 
 
@@ -189,6 +189,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     { return False; }
   void TableExprGroupFuncBase::finish()
   {}
+  Bool TableExprGroupFuncBase::canMerge() const
+    { return False; }
+  TableExprNodeRep::NodeDataType TableExprGroupFuncBase::applyDataType() const
+    { return TableExprNodeRep::NTAny; }
+  void TableExprGroupFuncBase::applyInt (const TableExprId& id, Int64)
+    { apply (id); }
+  void TableExprGroupFuncBase::applyDouble (const TableExprId& id, Double)
+    { apply (id); }
+  void TableExprGroupFuncBase::merge (const TableExprGroupFuncBase&)
+  { throw TableInvExpr ("TableExprGroupFuncBase::merge not implemented"); }
   CountedPtr<vector<TableExprId> > TableExprGroupFuncBase::getIds() const
   { throw TableInvExpr ("TableExprGroupFuncBase::getIds not implemented"); }
   Bool TableExprGroupFuncBase::getBool (const vector<TableExprId>&)
@@ -292,6 +302,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsIds->push_back (id);
   }
+  Bool TableExprGroupExprId::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupExprId::merge (const TableExprGroupFuncBase& other)
+  {
+    const vector<TableExprId>& ids = *other.getIds();
+    itsIds->insert (itsIds->end(), ids.begin(), ids.end());
+  }
   CountedPtr<vector<TableExprId> > TableExprGroupExprId::getIds() const
   {
     return itsIds;
@@ -515,5 +534,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  void TableExprGroupFuncSet::merge (const TableExprGroupFuncSet& other)
+  {
+    itsId = other.itsId;
+    for (uInt i=0; i<itsFuncs.size(); ++i) {
+      itsFuncs[i]->merge (*other.itsFuncs[i]);
+    }
+  }
+
 
 } //# NAMESPACE CASACORE - END
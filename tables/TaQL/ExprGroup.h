@@ -121,6 +121,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     bool operator== (const TableExprGroupKeySet&) const;
     bool operator<  (const TableExprGroupKeySet&) const;
 
+    // Get access to the i-th key, e.g. to set its value.
+    TableExprGroupKey& operator[] (uInt i)
+      { return itsKeys[i]; }
+
   private:
     vector<TableExprGroupKey> itsKeys;
   };
@@ -217,6 +221,32 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Get the operand's value for the given row and apply it to the aggregation.
     // This function should not be called for lazy classes.
     virtual void apply (const TableExprId& id) = 0;
+    // Can the function be used in a parallel GROUPBY?
+    // It means that the operand's values can be evaluated beforehand
+    // in blocks of rows (see <src>TableExprNodeRep::canGetBlock</src>)
+    // without accessing the table row by row, and that the aggregations
+    // of parts of the rows can be merged.
+    // The default implementation returns False.
+    virtual Bool canMerge() const;
+    // Get the data type (NTInt or NTDouble) of the operand's value to be
+    // given to applyInt or applyDouble. NTAny means that no value is needed.
+    // The default implementation returns NTAny.
+    virtual TableExprNodeRep::NodeDataType applyDataType() const;
+    // Apply the operand's value evaluated beforehand for the given row
+    // to the aggregation. It is only used if canMerge is True.
+    // The default implementation ignores the value and calls apply.
+    // <group>
+    virtual void applyInt (const TableExprId& id, Int64 value);
+    virtual void applyDouble (const TableExprId& id, Double value);
+    // </group>
+    // Merge the aggregation of another part of the rows of the group
+    // into this one. The other object must be of the same type.
+    // It is only used if canMerge is True.
+    // The default implementation throws an exception.
+    virtual void merge (const TableExprGroupFuncBase& other);
+    // Get the operand of the aggregate function (null if none).
+    TableExprNodeRep* operand() const
+      { return itsOperand; }
     // If needed, finish the aggregation.
     // By default nothing is done.
     virtual void finish();
@@ -341,6 +371,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     virtual ~TableExprGroupExprId();
     virtual Bool isLazy() const;
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& other);
     virtual CountedPtr<vector<TableExprId> > getIds() const;
   private:
     CountedPtr<vector<TableExprId> > itsIds;
@@ -814,6 +846,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Apply the functions to the given row.
     void apply (const TableExprId& id);
 
+    // Set the TableExprId of the row containing the non-aggregate variables.
+    // It is used instead of apply in a parallel GROUPBY.
+    void setId (const TableExprId& id)
+      { itsId = id; }
+
+    // Merge the functions of the same group in another part of the rows.
+    // The TableExprId of the other set is used, because its part follows
+    // the part of this set.
+    void merge (const TableExprGroupFuncSet& other);
+
     // Get the vector of functions.
     const vector<CountedPtr<TableExprGroupFuncBase> >& getFuncs() const
       { return itsFuncs; }
@@ -48,6 +48,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue++;
   }
+  Bool TableExprGroupCountAll::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupCountAll::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupCountAll&>(other).itsValue;
+  }
 
   TableExprGroupCount::TableExprGroupCount (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node),
@@ -72,6 +80,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       itsValue++;
     }
   }
+  Bool TableExprGroupCount::canMerge() const
+  {
+    // Testing if an array is defined needs table access.
+    return !itsColumn;
+  }
+  void TableExprGroupCount::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupCount&>(other).itsValue;
+  }
 
   TableExprGroupAny::TableExprGroupAny (TableExprNodeRep* node)
     : TableExprGroupFuncBool (node, False)
@@ -127,6 +144,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     if (v<itsValue) itsValue = v;
   }
+  Bool TableExprGroupMinInt::canMerge() const
+  {
+    return itsOperand->canGetBlock();
+  }
+  TableExprNodeRep::NodeDataType TableExprGroupMinInt::applyDataType() const
+  {
+    return TableExprNodeRep::NTInt;
+  }
+  void TableExprGroupMinInt::applyInt (const TableExprId&, Int64 v)
+  {
+    if (v<itsValue) itsValue = v;
+  }
+  void TableExprGroupMinInt::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMinInt& that =
+      dynamic_cast<const TableExprGroupMinInt&>(other);
+    if (that.itsValue<itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupMaxInt::TableExprGroupMaxInt (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, std::numeric_limits<Int64>::min())
@@ -138,6 +173,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     if (v>itsValue) itsValue = v;
   }
+  Bool TableExprGroupMaxInt::canMerge() const
+  {
+    return itsOperand->canGetBlock();
+  }
+  TableExprNodeRep::NodeDataType TableExprGroupMaxInt::applyDataType() const
+  {
+    return TableExprNodeRep::NTInt;
+  }
+  void TableExprGroupMaxInt::applyInt (const TableExprId&, Int64 v)
+  {
+    if (v>itsValue) itsValue = v;
+  }
+  void TableExprGroupMaxInt::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMaxInt& that =
+      dynamic_cast<const TableExprGroupMaxInt&>(other);
+    if (that.itsValue>itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupSumInt::TableExprGroupSumInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -148,6 +201,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getInt(id);
   }
+  Bool TableExprGroupSumInt::canMerge() const
+  {
+    return itsOperand->canGetBlock();
+  }
+  TableExprNodeRep::NodeDataType TableExprGroupSumInt::applyDataType() const
+  {
+    return TableExprNodeRep::NTInt;
+  }
+  void TableExprGroupSumInt::applyInt (const TableExprId&, Int64 v)
+  {
+    itsValue += v;
+  }
+  void TableExprGroupSumInt::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupSumInt& that =
+      dynamic_cast<const TableExprGroupSumInt&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupProductInt::TableExprGroupProductInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, 1)
@@ -181,6 +252,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     if (v<itsValue) itsValue = v;
   }
+  Bool TableExprGroupMinDouble::canMerge() const
+  {
+    return itsOperand->canGetBlock();
+  }
+  TableExprNodeRep::NodeDataType TableExprGroupMinDouble::applyDataType() const
+  {
+    return TableExprNodeRep::NTDouble;
+  }
+  void TableExprGroupMinDouble::applyDouble (const TableExprId&, Double v)
+  {
+    if (v<itsValue) itsValue = v;
+  }
+  void TableExprGroupMinDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMinDouble& that =
+      dynamic_cast<const TableExprGroupMinDouble&>(other);
+    if (that.itsValue<itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupMaxDouble::TableExprGroupMaxDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node, std::numeric_limits<Double>::min())
@@ -192,6 +281,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     if (v>itsValue) itsValue = v;
   }
+  Bool TableExprGroupMaxDouble::canMerge() const
+  {
+    return itsOperand->canGetBlock();
+  }
+  TableExprNodeRep::NodeDataType TableExprGroupMaxDouble::applyDataType() const
+  {
+    return TableExprNodeRep::NTDouble;
+  }
+  void TableExprGroupMaxDouble::applyDouble (const TableExprId&, Double v)
+  {
+    if (v>itsValue) itsValue = v;
+  }
+  void TableExprGroupMaxDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMaxDouble& that =
+      dynamic_cast<const TableExprGroupMaxDouble&>(other);
+    if (that.itsValue>itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupSumDouble::TableExprGroupSumDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node)
@@ -202,6 +309,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getDouble(id);
   }
+  Bool TableExprGroupSumDouble::canMerge() const
+  {
+    return itsOperand->canGetBlock();
+  }
+  TableExprNodeRep::NodeDataType TableExprGroupSumDouble::applyDataType() const
+  {
+    return TableExprNodeRep::NTDouble;
+  }
+  void TableExprGroupSumDouble::applyDouble (const TableExprId&, Double v)
+  {
+    itsValue += v;
+  }
+  void TableExprGroupSumDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupSumDouble& that =
+      dynamic_cast<const TableExprGroupSumDouble&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupProductDouble::TableExprGroupProductDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node, 1)
@@ -235,6 +360,26 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += itsOperand->getDouble(id);
     itsNr++;
   }
+  Bool TableExprGroupMeanDouble::canMerge() const
+  {
+    return itsOperand->canGetBlock();
+  }
+  TableExprNodeRep::NodeDataType TableExprGroupMeanDouble::applyDataType() const
+  {
+    return TableExprNodeRep::NTDouble;
+  }
+  void TableExprGroupMeanDouble::applyDouble (const TableExprId&, Double v)
+  {
+    itsValue += v;
+    itsNr++;
+  }
+  void TableExprGroupMeanDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMeanDouble& that =
+      dynamic_cast<const TableExprGroupMeanDouble&>(other);
+    itsValue += that.itsValue;
+    itsNr    += that.itsNr;
+  }
   void TableExprGroupMeanDouble::finish()
   {
     if (itsNr > 0) {
@@ -260,6 +405,34 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += delta/itsNr;
     itsM2    += delta*(v-itsValue);
   }
+  Bool TableExprGroupVarianceDouble::canMerge() const
+  {
+    return itsOperand->canGetBlock();
+  }
+  TableExprNodeRep::NodeDataType TableExprGroupVarianceDouble::applyDataType() const
+  {
+    return TableExprNodeRep::NTDouble;
+  }
+  void TableExprGroupVarianceDouble::applyDouble (const TableExprId&, Double v)
+  {
+    itsNr++;
+    Double delta = v - itsValue;
+    itsValue += delta/itsNr;
+    itsM2    += delta*(v-itsValue);
+  }
+  void TableExprGroupVarianceDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupVarianceDouble& that =
+      dynamic_cast<const TableExprGroupVarianceDouble&>(other);
+    // Combine the means and M2 of both parts (Chan et al.).
+    if (that.itsNr > 0) {
+      Int64  nr    = itsNr + that.itsNr;
+      Double delta = that.itsValue - itsValue;
+      itsValue += delta * that.itsNr / nr;
+      itsM2    += that.itsM2 + delta*delta * itsNr * that.itsNr / nr;
+      itsNr     = nr;
+    }
+  }
   void TableExprGroupVarianceDouble::finish()
   {
     if (itsNr > 1) {
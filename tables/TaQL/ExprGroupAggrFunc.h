@@ -55,6 +55,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupCountAll (TableExprNodeRep* node);
     virtual ~TableExprGroupCountAll();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& other);
     // Set result in case it is known directly.
     void setResult (Int64 cnt)
       { itsValue = cnt; }
@@ -75,6 +77,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupCount (TableExprNodeRep* node);
     virtual ~TableExprGroupCount();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& other);
   private:
     TableExprNodeArrayColumn* itsColumn;
   };
@@ -162,6 +166,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMinInt (TableExprNodeRep* node);
     virtual ~TableExprGroupMinInt();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual TableExprNodeRep::NodeDataType applyDataType() const;
+    virtual void applyInt (const TableExprId& id, Int64 value);
+    virtual void merge (const TableExprGroupFuncBase& other);
   };
 
   // <summary>
@@ -179,6 +187,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMaxInt (TableExprNodeRep* node);
     virtual ~TableExprGroupMaxInt();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual TableExprNodeRep::NodeDataType applyDataType() const;
+    virtual void applyInt (const TableExprId& id, Int64 value);
+    virtual void merge (const TableExprGroupFuncBase& other);
   };
 
   // <summary>
@@ -196,6 +208,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupSumInt (TableExprNodeRep* node);
     virtual ~TableExprGroupSumInt();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual TableExprNodeRep::NodeDataType applyDataType() const;
+    virtual void applyInt (const TableExprId& id, Int64 value);
+    virtual void merge (const TableExprGroupFuncBase& other);
   };
 
   // <summary>
@@ -248,6 +264,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMinDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupMinDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual TableExprNodeRep::NodeDataType applyDataType() const;
+    virtual void applyDouble (const TableExprId& id, Double value);
+    virtual void merge (const TableExprGroupFuncBase& other);
   };
 
   // <summary>
@@ -265,6 +285,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMaxDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupMaxDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual TableExprNodeRep::NodeDataType applyDataType() const;
+    virtual void applyDouble (const TableExprId& id, Double value);
+    virtual void merge (const TableExprGroupFuncBase& other);
   };
 
   // <summary>
@@ -282,6 +306,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupSumDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupSumDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual TableExprNodeRep::NodeDataType applyDataType() const;
+    virtual void applyDouble (const TableExprId& id, Double value);
+    virtual void merge (const TableExprGroupFuncBase& other);
   };
 
   // <summary>
@@ -333,6 +361,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMeanDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupMeanDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual TableExprNodeRep::NodeDataType applyDataType() const;
+    virtual void applyDouble (const TableExprId& id, Double value);
+    virtual void merge (const TableExprGroupFuncBase& other);
     virtual void finish();
   private:
     Int64 itsNr;
@@ -348,6 +380,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // Aggregate class determining the variance of values in a group.
   // It uses a running algorithm
   // (see en.wikipedia.org/wiki/Algorithms_for_calculating_variance)
+  // <br>The results of parts of a group are merged using the pairwise
+  // algorithm of Chan et al. described on the same page.
   // </synopsis>
   class TableExprGroupVarianceDouble: public TableExprGroupFuncDouble
   {
@@ -355,6 +389,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupVarianceDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupVarianceDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual TableExprNodeRep::NodeDataType applyDataType() const;
+    virtual void applyDouble (const TableExprId& id, Double value);
+    virtual void merge (const TableExprGroupFuncBase& other);
     virtual void finish();
   protected:
     Int64  itsNr;
@@ -371,6 +409,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // Aggregate class determining the standard deviation of values in a group.
   // It uses a running algorithm
   // (see en.wikipedia.org/wiki/Algorithms_for_calculating_variance)
+  // <br>The results of parts of a group are merged using the pairwise
+  // algorithm of Chan et al. described on the same page.
   // </synopsis>
   class TableExprGroupStdDevDouble: public TableExprGroupVarianceDouble
   {
@@ -30,6 +30,7 @@
 #include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/casa/Quanta/MVTime.h>
+#include <casacore/casa/Containers/Block.h>
 #include <float.h>                     // for DBL_MAX
 #include <limits.h>                     // for DBL_MAX
 
@@ -47,6 +48,20 @@ Bool TableExprNodeEQBool::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) == rnode_p->getBool(id);
 }
+Bool TableExprNodeEQBool::canGetBlock() const
+{
+    return childrenCanGetBlock();
+}
+void TableExprNodeEQBool::getBoolBlock (rownr_t startRow, uInt nrow,
+                                        Bool* result)
+{
+    Block<Bool> left(nrow), right(nrow);
+    lnode_p->getBoolBlock (startRow, nrow, left.storage());
+    rnode_p->getBoolBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] == right[i];
+    }
+}
 
 TableExprNodeEQInt::TableExprNodeEQInt (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -57,6 +72,20 @@ Bool TableExprNodeEQInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) == rnode_p->getInt(id);
 }
+Bool TableExprNodeEQInt::canGetBlock() const
+{
+    return childrenCanGetBlock();
+}
+void TableExprNodeEQInt::getBoolBlock (rownr_t startRow, uInt nrow,
+                                       Bool* result)
+{
+    Block<Int64> left(nrow), right(nrow);
+    lnode_p->getIntBlock (startRow, nrow, left.storage());
+    rnode_p->getIntBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] == right[i];
+    }
+}
 
 TableExprNodeEQDouble::TableExprNodeEQDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -67,6 +96,20 @@ Bool TableExprNodeEQDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) == rnode_p->getDouble(id);
 }
+Bool TableExprNodeEQDouble::canGetBlock() const
+{
+    return childrenCanGetBlock();
+}
+void TableExprNodeEQDouble::getBoolBlock (rownr_t startRow, uInt nrow,
+                                          Bool* result)
+{
+    Block<Double> left(nrow), right(nrow);
+    lnode_p->getDoubleBlock (startRow, nrow, left.storage());
+    rnode_p->getDoubleBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] == right[i];
+    }
+}
 
 TableExprNodeEQDComplex::TableExprNodeEQDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -118,6 +161,20 @@ Bool TableExprNodeNEBool::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) != rnode_p->getBool(id);
 }
+Bool TableExprNodeNEBool::canGetBlock() const
+{
+    return childrenCanGetBlock();
+}
+void TableExprNodeNEBool::getBoolBlock (rownr_t startRow, uInt nrow,
+                                        Bool* result)
+{
+    Block<Bool> left(nrow), right(nrow);
+    lnode_p->getBoolBlock (startRow, nrow, left.storage());
+    rnode_p->getBoolBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] != right[i];
+    }
+}
 
 TableExprNodeNEInt::TableExprNodeNEInt (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -128,6 +185,20 @@ Bool TableExprNodeNEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) != rnode_p->getInt(id);
 }
+Bool TableExprNodeNEInt::canGetBlock() const
+{
+    return childrenCanGetBlock();
+}
+void TableExprNodeNEInt::getBoolBlock (rownr_t startRow, uInt nrow,
+                                       Bool* result)
+{
+    Block<Int64> left(nrow), right(nrow);
+    lnode_p->getIntBlock (startRow, nrow, left.storage());
+    rnode_p->getIntBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] != right[i];
+    }
+}
 
 TableExprNodeNEDouble::TableExprNodeNEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -138,6 +209,20 @@ Bool TableExprNodeNEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) != rnode_p->getDouble(id);
 }
+Bool TableExprNodeNEDouble::canGetBlock() const
+{
+    return childrenCanGetBlock();
+}
+void TableExprNodeNEDouble::getBoolBlock (rownr_t startRow, uInt nrow,
+                                          Bool* result)
+{
+    Block<Double> left(nrow), right(nrow);
+    lnode_p->getDoubleBlock (startRow, nrow, left.storage());
+    rnode_p->getDoubleBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] != right[i];
+    }
+}
 
 TableExprNodeNEDComplex::TableExprNodeNEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -189,6 +274,20 @@ Bool TableExprNodeGTInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) > rnode_p->getInt(id);
 }
+Bool TableExprNodeGTInt::canGetBlock() const
+{
+    return childrenCanGetBlock();
+}
+void TableExprNodeGTInt::getBoolBlock (rownr_t startRow, uInt nrow,
+                                       Bool* result)
+{
+    Block<Int64> left(nrow), right(nrow);
+    lnode_p->getIntBlock (startRow, nrow, left.storage());
+    rnode_p->getIntBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] > right[i];
+    }
+}
 
 TableExprNodeGTDouble::TableExprNodeGTDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -199,6 +298,20 @@ Bool TableExprNodeGTDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) > rnode_p->getDouble(id);
 }
+Bool TableExprNodeGTDouble::canGetBlock() const
+{
+    return childrenCanGetBlock();
+}
+void TableExprNodeGTDouble::getBoolBlock (rownr_t startRow, uInt nrow,
+                                          Bool* result)
+{
+    Block<Double> left(nrow), right(nrow);
+    lnode_p->getDoubleBlock (startRow, nrow, left.storage());
+    rnode_p->getDoubleBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] > right[i];
+    }
+}
 
 TableExprNodeGTDComplex::TableExprNodeGTDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -240,6 +353,20 @@ Bool TableExprNodeGEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) >= rnode_p->getInt(id);
 }
+Bool TableExprNodeGEInt::canGetBlock() const
+{
+    return childrenCanGetBlock();
+}
+void TableExprNodeGEInt::getBoolBlock (rownr_t startRow, uInt nrow,
+                                       Bool* result)
+{
+    Block<Int64> left(nrow), right(nrow);
+    lnode_p->getIntBlock (startRow, nrow, left.storage());
+    rnode_p->getIntBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] >= right[i];
+    }
+}
 
 TableExprNodeGEDouble::TableExprNodeGEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -250,6 +377,20 @@ Bool TableExprNodeGEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) >= rnode_p->getDouble(id);
 }
+Bool TableExprNodeGEDouble::canGetBlock() const
+{
+    return childrenCanGetBlock();
+}
+void TableExprNodeGEDouble::getBoolBlock (rownr_t startRow, uInt nrow,
+                                          Bool* result)
+{
+    Block<Double> left(nrow), right(nrow);
+    lnode_p->getDoubleBlock (startRow, nrow, left.storage());
+    rnode_p->getDoubleBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] >= right[i];
+    }
+}
 
 TableExprNodeGEDComplex::TableExprNodeGEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -285,7 +426,8 @@ Bool TableExprNodeGEDate::getBool (const TableExprId& id)
 TableExprNodeINInt::TableExprNodeINInt (const TableExprNodeRep& node,
                                         Bool doTracing)
 : TableExprNodeBinary (NTBool, node, OtIN),
-  itsDoTracing (doTracing)
+  itsDoTracing   (doTracing),
+  itsBitmapStart (0)
 {}
 void TableExprNodeINInt::convertConstChild()
 {
@@ -300,6 +442,20 @@ void TableExprNodeINInt::convertConstChild()
     if (! arr.empty()) {
       itsIndexSet.clear();
       itsIndexSet.insert(arr.begin(), arr.end());
+      // Make a bitmap if the range of values is limited (at most 1M
+      // or 64 per value), which is normally the case for IDs.
+      itsBitmap.clear();
+      Int64 start = *itsIndexSet.begin();
+      uInt64 range = uInt64(*itsIndexSet.rbegin() - start) + 1;
+      if (range > 0  &&
+          (range <= 1024*1024  ||  range <= 64*itsIndexSet.size())) {
+        itsBitmapStart = start;
+        itsBitmap.resize (range, False);
+        for (std::set<Int64>::const_iterator iter=itsIndexSet.begin();
+             iter!=itsIndexSet.end(); ++iter) {
+          itsBitmap[*iter - start] = True;
+        }
+      }
     }
   }
 }
@@ -309,10 +465,27 @@ Bool TableExprNodeINInt::getBool (const TableExprId& id)
 {
     Int64 val = lnode_p->getInt (id);
     if (itsIndexSet.size() > 0) {
-      return itsIndexSet.find(val) != itsIndexSet.end();
+      return inSet (val);
     }
     return rnode_p->hasInt (id, val);
 }
+Bool TableExprNodeINInt::canGetBlock() const
+{
+    return itsIndexSet.size() > 0  &&  lnode_p->canGetBlock();
+}
+void TableExprNodeINInt::getBoolBlock (rownr_t startRow, uInt nrow,
+                                       Bool* result)
+{
+    if (! canGetBlock()) {
+        TableExprNodeRep::getBoolBlock (startRow, nrow, result);
+        return;
+    }
+    Block<Int64> left(nrow);
+    lnode_p->getIntBlock (startRow, nrow, left.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = inSet (left[i]);
+    }
+}
 
 TableExprNodeINDouble::TableExprNodeINDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtIN)
@@ -355,6 +528,57 @@ Bool TableExprNodeINDate::getBool (const TableExprId& id)
 }
 
 
+// Combine the result of the left operand of an AND (OR) with the right
+// operand, which is only evaluated for the rows where the left one is
+// True (False), thus as getBool does. If the right operand supports it,
+// it is evaluated as a block for the span of these rows. If they are
+// sparse in the span (or if the right operand does not support blocks),
+// it is evaluated row by row, because that is faster for expensive
+// operands like an element of an array column.
+static void getRightBlock (TableExprNodeRep* rnode, Bool isAnd,
+                           rownr_t startRow, uInt nrow, Bool* result)
+{
+    uInt first = nrow;
+    uInt last  = 0;
+    uInt nr    = 0;
+    for (uInt i=0; i<nrow; ++i) {
+        if (result[i] == isAnd) {
+            if (nr == 0) {
+                first = i;
+            }
+            last = i;
+            nr++;
+        }
+    }
+    if (nr == 0) {
+        return;
+    }
+    uInt span = last - first + 1;
+    if (rnode->canGetBlock()  &&  nr >= span/8) {
+        Block<Bool> right(span);
+        rnode->getBoolBlock (startRow+first, span, right.storage());
+        Bool* res = result + first;
+        if (isAnd) {
+            for (uInt i=0; i<span; ++i) {
+                res[i] = res[i] && right[i];
+            }
+        } else {
+            for (uInt i=0; i<span; ++i) {
+                res[i] = res[i] || right[i];
+            }
+        }
+    } else {
+        ScopedMutexLock lock(TableExprNodeRep::getMutex());
+        TableExprId id;
+        for (uInt i=first; i<=last; ++i) {
+            if (result[i] == isAnd) {
+                id.setRownr (startRow+i);
+                result[i] = rnode->getBool(id);
+            }
+        }
+    }
+}
+
 TableExprNodeOR::TableExprNodeOR (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtOR)
 {}
@@ -364,6 +588,18 @@ Bool TableExprNodeOR::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) || rnode_p->getBool(id);
 }
+// Only the left operand needs to support block evaluation.
+// If the right operand does not, it is evaluated row by row and, as in
+// getBool, only for the rows where needed.
+Bool TableExprNodeOR::canGetBlock() const
+{
+    return lnode_p->canGetBlock();
+}
+void TableExprNodeOR::getBoolBlock (rownr_t startRow, uInt nrow, Bool* result)
+{
+    lnode_p->getBoolBlock (startRow, nrow, result);
+    getRightBlock (rnode_p, False, startRow, nrow, result);
+}
 
 
 TableExprNodeAND::TableExprNodeAND (const TableExprNodeRep& node)
@@ -375,6 +611,18 @@ Bool TableExprNodeAND::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) && rnode_p->getBool(id);
 }
+// Only the left operand needs to support block evaluation.
+// If the right operand does not, it is evaluated row by row and, as in
+// getBool, only for the rows where needed.
+Bool TableExprNodeAND::canGetBlock() const
+{
+    return lnode_p->canGetBlock();
+}
+void TableExprNodeAND::getBoolBlock (rownr_t startRow, uInt nrow, Bool* result)
+{
+    lnode_p->getBoolBlock (startRow, nrow, result);
+    getRightBlock (rnode_p, True, startRow, nrow, result);
+}
 
 
 TableExprNodeNOT::TableExprNodeNOT (const TableExprNodeRep& node)
@@ -386,6 +634,17 @@ Bool TableExprNodeNOT::getBool (const TableExprId& id)
 {
   return ! lnode_p->getBool(id);
 }
+Bool TableExprNodeNOT::canGetBlock() const
+{
+    return lnode_p->canGetBlock();
+}
+void TableExprNodeNOT::getBoolBlock (rownr_t startRow, uInt nrow, Bool* result)
+{
+    lnode_p->getBoolBlock (startRow, nrow, result);
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = !result[i];
+    }
+}
 
 
 
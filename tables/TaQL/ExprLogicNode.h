@@ -32,6 +32,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/TaQL/ExprNodeRep.h>
 #include <set>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -74,6 +75,8 @@ public:
     TableExprNodeEQBool (const TableExprNodeRep&);
     ~TableExprNodeEQBool();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
 };
 
 
@@ -104,6 +107,8 @@ public:
     TableExprNodeEQInt (const TableExprNodeRep&);
     ~TableExprNodeEQInt();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
 };
 
 
@@ -134,6 +139,8 @@ public:
     TableExprNodeEQDouble (const TableExprNodeRep&);
     ~TableExprNodeEQDouble();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -286,6 +293,8 @@ public:
     TableExprNodeNEBool (const TableExprNodeRep&);
     ~TableExprNodeNEBool();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
 };
 
 
@@ -316,6 +325,8 @@ public:
     TableExprNodeNEInt (const TableExprNodeRep&);
     ~TableExprNodeNEInt();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
 };
 
 
@@ -346,6 +357,8 @@ public:
     TableExprNodeNEDouble (const TableExprNodeRep&);
     ~TableExprNodeNEDouble();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
 };
 
 
@@ -497,6 +510,8 @@ public:
     TableExprNodeGTInt (const TableExprNodeRep&);
     ~TableExprNodeGTInt();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
 };
 
 
@@ -527,6 +542,8 @@ public:
     TableExprNodeGTDouble (const TableExprNodeRep&);
     ~TableExprNodeGTDouble();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -649,6 +666,8 @@ public:
     TableExprNodeGEInt (const TableExprNodeRep&);
     ~TableExprNodeGEInt();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
 };
 
 
@@ -679,6 +698,8 @@ public:
     TableExprNodeGEDouble (const TableExprNodeRep&);
     ~TableExprNodeGEDouble();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -793,6 +814,11 @@ public:
 // This is defined for all data types.
 // Only the Bool get function is defined, because the result of a
 // compare is always a Bool.
+// <br>If the right operand is a constant array, its values are put in a set.
+// If their range is not too large, a bitmap is made as well, so
+// a lookup of a value is a single test. A block of rows can be
+// evaluated at once if the set exists and the left operand supports it.
+// This is typically used for the ID columns in an MS selection.
 // </synopsis> 
 
 class TableExprNodeINInt : public TableExprNodeBinary
@@ -802,10 +828,26 @@ public:
     virtual ~TableExprNodeINInt();
     virtual void convertConstChild();
     virtual Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
 private:
+    // Test if the value is in the set.
+    Bool inSet (Int64 val) const
+    {
+      if (itsBitmap.size() > 0) {
+        return val >= itsBitmapStart  &&
+               val - itsBitmapStart < Int64(itsBitmap.size())  &&
+               itsBitmap[val - itsBitmapStart];
+      }
+      return itsIndexSet.find(val) != itsIndexSet.end();
+    }
+
     Bool        itsDoTracing;
     // If the right node is constant it is converted to a set
     std::set<Int64> itsIndexSet;
+    // The set as a bitmap starting at the lowest value.
+    std::vector<Bool> itsBitmap;
+    Int64             itsBitmapStart;
 };
 
 
@@ -955,6 +997,8 @@ public:
     TableExprNodeOR (const TableExprNodeRep&);
     ~TableExprNodeOR();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -984,6 +1028,8 @@ public:
     TableExprNodeAND (const TableExprNodeRep&);
     ~TableExprNodeAND();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -1013,6 +1059,8 @@ public:
     TableExprNodeNOT (const TableExprNodeRep&);
     ~TableExprNodeNOT();
     Bool getBool (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result);
 };
 
 
@@ -29,6 +29,7 @@
 #include <casacore/tables/TaQL/ExprUnitNode.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Quanta/MVTime.h>
+#include <casacore/casa/Containers/Block.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -53,6 +54,28 @@ Double TableExprNodePlusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) + rnode_p->getInt(id); }
 DComplex TableExprNodePlusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) + rnode_p->getInt(id)); }
+Bool TableExprNodePlusInt::canGetBlock() const
+    { return childrenCanGetBlock(); }
+void TableExprNodePlusInt::getIntBlock (rownr_t startRow, uInt nrow,
+                                        Int64* result)
+{
+    Block<Int64> right(nrow);
+    lnode_p->getIntBlock (startRow, nrow, result);
+    rnode_p->getIntBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] += right[i];
+    }
+}
+void TableExprNodePlusInt::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                           Double* result)
+{
+    Block<Int64> left(nrow), right(nrow);
+    lnode_p->getIntBlock (startRow, nrow, left.storage());
+    rnode_p->getIntBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] + right[i];
+    }
+}
 
 TableExprNodePlusDouble::TableExprNodePlusDouble (const TableExprNodeRep& node)
 : TableExprNodePlus (NTDouble, node)
@@ -63,6 +86,18 @@ Double TableExprNodePlusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
 DComplex TableExprNodePlusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
+Bool TableExprNodePlusDouble::canGetBlock() const
+    { return childrenCanGetBlock(); }
+void TableExprNodePlusDouble::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                              Double* result)
+{
+    Block<Double> right(nrow);
+    lnode_p->getDoubleBlock (startRow, nrow, result);
+    rnode_p->getDoubleBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] += right[i];
+    }
+}
 
 TableExprNodePlusDComplex::TableExprNodePlusDComplex (const TableExprNodeRep& node)
 : TableExprNodePlus (NTComplex, node)
@@ -125,6 +160,28 @@ Double TableExprNodeMinusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) - rnode_p->getInt(id); }
 DComplex TableExprNodeMinusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) - rnode_p->getInt(id)); }
+Bool TableExprNodeMinusInt::canGetBlock() const
+    { return childrenCanGetBlock(); }
+void TableExprNodeMinusInt::getIntBlock (rownr_t startRow, uInt nrow,
+                                         Int64* result)
+{
+    Block<Int64> right(nrow);
+    lnode_p->getIntBlock (startRow, nrow, result);
+    rnode_p->getIntBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] -= right[i];
+    }
+}
+void TableExprNodeMinusInt::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                            Double* result)
+{
+    Block<Int64> left(nrow), right(nrow);
+    lnode_p->getIntBlock (startRow, nrow, left.storage());
+    rnode_p->getIntBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] - right[i];
+    }
+}
 
 TableExprNodeMinusDouble::TableExprNodeMinusDouble (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTDouble, node)
@@ -143,6 +200,18 @@ Double TableExprNodeMinusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
 DComplex TableExprNodeMinusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
+Bool TableExprNodeMinusDouble::canGetBlock() const
+    { return childrenCanGetBlock(); }
+void TableExprNodeMinusDouble::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                               Double* result)
+{
+    Block<Double> right(nrow);
+    lnode_p->getDoubleBlock (startRow, nrow, result);
+    rnode_p->getDoubleBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] -= right[i];
+    }
+}
 
 TableExprNodeMinusDComplex::TableExprNodeMinusDComplex (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTComplex, node)
@@ -198,6 +267,28 @@ Double TableExprNodeTimesInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) * rnode_p->getInt(id); }
 DComplex TableExprNodeTimesInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) * rnode_p->getInt(id)); }
+Bool TableExprNodeTimesInt::canGetBlock() const
+    { return childrenCanGetBlock(); }
+void TableExprNodeTimesInt::getIntBlock (rownr_t startRow, uInt nrow,
+                                         Int64* result)
+{
+    Block<Int64> right(nrow);
+    lnode_p->getIntBlock (startRow, nrow, result);
+    rnode_p->getIntBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] *= right[i];
+    }
+}
+void TableExprNodeTimesInt::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                            Double* result)
+{
+    Block<Int64> left(nrow), right(nrow);
+    lnode_p->getIntBlock (startRow, nrow, left.storage());
+    rnode_p->getIntBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = left[i] * right[i];
+    }
+}
 
 TableExprNodeTimesDouble::TableExprNodeTimesDouble (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTDouble, node)
@@ -208,6 +299,18 @@ Double TableExprNodeTimesDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
 DComplex TableExprNodeTimesDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
+Bool TableExprNodeTimesDouble::canGetBlock() const
+    { return childrenCanGetBlock(); }
+void TableExprNodeTimesDouble::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                               Double* result)
+{
+    Block<Double> right(nrow);
+    lnode_p->getDoubleBlock (startRow, nrow, result);
+    rnode_p->getDoubleBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] *= right[i];
+    }
+}
 
 TableExprNodeTimesDComplex::TableExprNodeTimesDComplex (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTComplex, node)
@@ -264,6 +367,18 @@ Double TableExprNodeDivideDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
 DComplex TableExprNodeDivideDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
+Bool TableExprNodeDivideDouble::canGetBlock() const
+    { return childrenCanGetBlock(); }
+void TableExprNodeDivideDouble::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                                Double* result)
+{
+    Block<Double> right(nrow);
+    lnode_p->getDoubleBlock (startRow, nrow, result);
+    rnode_p->getDoubleBlock (startRow, nrow, right.storage());
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] /= right[i];
+    }
+}
 
 TableExprNodeDivideDComplex::TableExprNodeDivideDComplex (const TableExprNodeRep& node)
 : TableExprNodeDivide (NTComplex, node)
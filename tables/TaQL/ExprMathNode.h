@@ -103,6 +103,9 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getIntBlock    (rownr_t startRow, uInt nrow, Int64* result);
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
 };
 
 
@@ -135,6 +138,8 @@ public:
     ~TableExprNodePlusDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
 };
 
 
@@ -291,6 +296,9 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getIntBlock    (rownr_t startRow, uInt nrow, Int64* result);
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
 };
 
 
@@ -323,6 +331,8 @@ public:
     virtual void handleUnits();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
 };
 
 
@@ -446,6 +456,9 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getIntBlock    (rownr_t startRow, uInt nrow, Int64* result);
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
 };
 
 
@@ -477,6 +490,8 @@ public:
     ~TableExprNodeTimesDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
 };
 
 
@@ -567,6 +582,8 @@ public:
     ~TableExprNodeDivideDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    virtual Bool canGetBlock() const;
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
 };
 
 
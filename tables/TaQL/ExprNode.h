@@ -1027,6 +1027,23 @@ public:
 
     // </group>
 
+    // Can the expression be evaluated column-at-a-time?
+    Bool canGetBlock() const
+      { return node_p->canGetBlock(); }
+
+    // Get the values for the rows <src>startRow</src> till
+    // <src>startRow+nrow</src> into the buffer (of length <src>nrow</src>).
+    // Evaluation is column-at-a-time if <src>canGetBlock()</src> is True,
+    // otherwise row by row.
+    // <group>
+    void getBoolBlock (rownr_t startRow, uInt nrow, Bool* result) const
+      { node_p->getBoolBlock (startRow, nrow, result); }
+    void getIntBlock (rownr_t startRow, uInt nrow, Int64* result) const
+      { node_p->getIntBlock (startRow, nrow, result); }
+    void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result) const
+      { node_p->getDoubleBlock (startRow, nrow, result); }
+    // </group>
+
     // Get the data type for doing a getColumn on the expression.
     // This is the data type of the column if the expression
     // consists of a single column only.
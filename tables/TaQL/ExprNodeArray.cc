@@ -30,11 +30,14 @@
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/ExprDerNode.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/tables/TaQL/MArrayMath.h>
 #include <casacore/tables/TaQL/MArrayLogical.h>
 #include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -1418,6 +1421,136 @@ void TableExprNodeArrayPart::show (ostream& os, uInt indent) const
     indexNode_p->show (os, indent+2);
 }
 
+// Read an element of an array column with data type T in a block of rows
+// and convert the values to the result type U.
+// The entire arrays are read, because that is much faster than reading
+// a slice of them. The offset of the element in an array is given.
+template<typename T, typename U>
+void getElemBlock (const TableColumn& tabcol, uInt offset,
+                   rownr_t startRow, uInt nrow, U* result)
+{
+    Array<T> arr;
+    {
+        ScopedMutexLock lock(TableExprNodeRep::getMutex());
+        arr.reference (ArrayColumn<T>(tabcol).getColumnRange
+                       (Slicer(IPosition(1,startRow), IPosition(1,nrow))));
+    }
+    Bool deleteIt;
+    const T* data = arr.getStorage (deleteIt);
+    size_t ncell = arr.size() / std::max(nrow, 1u);
+    const T* ptr = data + offset;
+    for (uInt i=0; i<nrow; ++i) {
+        result[i] = ptr[i*ncell];
+    }
+    arr.freeStorage (data, deleteIt);
+}
+
+// Read an element of a real numeric array column in a block of rows.
+template<typename U>
+void getNumericElemBlock (const TableColumn& tabcol, uInt offset,
+                          rownr_t startRow, uInt nrow, U* result)
+{
+    switch (tabcol.columnDesc().dataType()) {
+    case TpUChar:
+        getElemBlock<uChar>  (tabcol, offset, startRow, nrow, result);
+        break;
+    case TpShort:
+        getElemBlock<Short>  (tabcol, offset, startRow, nrow, result);
+        break;
+    case TpUShort:
+        getElemBlock<uShort> (tabcol, offset, startRow, nrow, result);
+        break;
+    case TpInt:
+        getElemBlock<Int>    (tabcol, offset, startRow, nrow, result);
+        break;
+    case TpUInt:
+        getElemBlock<uInt>   (tabcol, offset, startRow, nrow, result);
+        break;
+    case TpFloat:
+        getElemBlock<Float>  (tabcol, offset, startRow, nrow, result);
+        break;
+    case TpDouble:
+        getElemBlock<Double> (tabcol, offset, startRow, nrow, result);
+        break;
+    default:
+        throw TableInvExpr ("TableExprNodeArrayPart: invalid data type for a "
+                            "block get of column " +
+                            tabcol.columnDesc().name());
+    }
+}
+
+Bool TableExprNodeArrayPart::canGetBlock() const
+{
+    Int64 offset;
+    return getElemOffset (offset);
+}
+Bool TableExprNodeArrayPart::getElemOffset (Int64& offset) const
+{
+    if (colNode_p == 0  ||  valueType() != VTScalar  ||
+        !indexNode_p->isConstant()) {
+        return False;
+    }
+    const ColumnDesc& cd = colNode_p->getColumn().columnDesc();
+    if ((cd.options() & ColumnDesc::FixedShape) != ColumnDesc::FixedShape) {
+        return False;
+    }
+    switch (cd.dataType()) {
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpFloat:
+    case TpDouble:
+        break;
+    default:
+        return False;
+    }
+    // Get the offset of the element in the array.
+    // A negative index counts from the end.
+    const IPosition& shape = cd.shape();
+    IPosition index = indexNode_p->getConstantSlicer().start();
+    if (index.size() != shape.size()) {
+        return False;
+    }
+    offset = 0;
+    Int64 step = 1;
+    for (uInt i=0; i<shape.size(); ++i) {
+        Int64 inx = index[i];
+        if (inx < 0) {
+            inx += shape[i];
+        }
+        if (inx < 0  ||  inx >= shape[i]) {
+            return False;
+        }
+        offset += inx * step;
+        step   *= shape[i];
+    }
+    return True;
+}
+void TableExprNodeArrayPart::getIntBlock (rownr_t startRow, uInt nrow,
+                                          Int64* result)
+{
+    Int64 offset;
+    if (! getElemOffset (offset)) {
+        TableExprNodeRep::getIntBlock (startRow, nrow, result);
+        return;
+    }
+    getNumericElemBlock (colNode_p->getColumn(), offset,
+                         startRow, nrow, result);
+}
+void TableExprNodeArrayPart::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                             Double* result)
+{
+    Int64 offset;
+    if (! getElemOffset (offset)) {
+        TableExprNodeRep::getDoubleBlock (startRow, nrow, result);
+        return;
+    }
+    getNumericElemBlock (colNode_p->getColumn(), offset,
+                         startRow, nrow, result);
+}
+
 Bool TableExprNodeArrayPart::getColumnDataType (DataType& dt) const
 {
     //# Return data type of column if constant index.
@@ -806,6 +806,15 @@ public:
     MArray<String>   getArrayString   (const TableExprId& id);
     MArray<MVTime>   getArrayDate     (const TableExprId& id);
 
+    // Block evaluation is supported for a single element with a constant
+    // index in a numeric array column with a fixed shape (e.g., UVW[1]).
+    // The arrays are read for the rows in one getColumnRange call.
+    // <group>
+    virtual Bool canGetBlock() const;
+    virtual void getIntBlock    (rownr_t startRow, uInt nrow, Int64* result);
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
+    // </group>
+
     // Get the data type of this column (if possible).
     // It returns with a False status when the index is not constant
     // (that means that the index can vary with row number).
@@ -831,6 +840,10 @@ public:
     const TableExprNodeArrayColumn* getColumnNode() const;
 
 private:
+    // Get the offset of the element in the arrays if block evaluation
+    // can be done.
+    Bool getElemOffset (Int64& offset) const;
+
     TableExprNodeIndex*       indexNode_p;
     TableExprNodeArray*       arrNode_p;
     TableExprNodeArrayColumn* colNode_p;   //# 0 if arrNode is no arraycolumn
@@ -44,6 +44,8 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+Mutex TableExprNodeRep::theirGetMutex(Mutex::Recursive);
+
 // The constructor to be used by the derived classes.
 TableExprNodeRep::TableExprNodeRep (NodeDataType dtype, ValueType vtype,
 				    OperType optype,
@@ -307,6 +309,42 @@ MArray<MVTime> TableExprNodeRep::getArrayDate (const TableExprId&)
     return MArray<MVTime>();
 }
 
+//# Supply the default functions for the block get functions.
+Bool TableExprNodeRep::canGetBlock() const
+{
+    return False;
+}
+void TableExprNodeRep::getBoolBlock (rownr_t startRow, uInt nrow,
+                                     Bool* result)
+{
+    ScopedMutexLock lock(theirGetMutex);
+    TableExprId id;
+    for (uInt i=0; i<nrow; ++i) {
+        id.setRownr (startRow+i);
+        result[i] = getBool (id);
+    }
+}
+void TableExprNodeRep::getIntBlock (rownr_t startRow, uInt nrow,
+                                    Int64* result)
+{
+    ScopedMutexLock lock(theirGetMutex);
+    TableExprId id;
+    for (uInt i=0; i<nrow; ++i) {
+        id.setRownr (startRow+i);
+        result[i] = getInt (id);
+    }
+}
+void TableExprNodeRep::getDoubleBlock (rownr_t startRow, uInt nrow,
+                                       Double* result)
+{
+    ScopedMutexLock lock(theirGetMutex);
+    TableExprId id;
+    for (uInt i=0; i<nrow; ++i) {
+        id.setRownr (startRow+i);
+        result[i] = getDouble (id);
+    }
+}
+
 MArray<Bool> TableExprNodeRep::getBoolAS (const TableExprId& id)
 {
   if (valueType() == VTArray) {
@@ -737,6 +775,12 @@ void TableExprNodeBinary::getColumnNodes (vector<TableExprNodeRep*>& cols)
   }
 }
 
+Bool TableExprNodeBinary::childrenCanGetBlock() const
+{
+  return (lnode_p == 0  ||  lnode_p->canGetBlock())  &&
+         (rnode_p == 0  ||  rnode_p->canGetBlock());
+}
+
 // Check the datatypes and get the common one.
 // For use with operands.
 TableExprNodeRep::NodeDataType TableExprNodeBinary::getDT
@@ -40,6 +40,7 @@
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/Utilities/Regex.h>
 #include <casacore/casa/Utilities/StringDistance.h>
+#include <casacore/casa/OS/Mutex.h>
 #include <casacore/casa/iosfwd.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -282,6 +283,37 @@ public:
     virtual MArray<MVTime> getArrayDate       (const TableExprId& id);
     // </group>
 
+    // Can this node (including its children) be evaluated column-at-a-time
+    // by the block get functions below?
+    // The default implementation returns False.
+    virtual Bool canGetBlock() const;
+
+    // Get the scalar values for this node in the rows
+    // <src>startRow</src> till <src>startRow+nrow</src> and store them
+    // in <src>result</src>, which must have room for <src>nrow</src> values.
+    // Nodes for which <src>canGetBlock</src> is True evaluate the entire
+    // block at once (columns are read using getColumnRange, operators are
+    // applied in a loop over the block), thus avoiding a virtual call and
+    // a column access per node per row.
+    // The default implementation calls the scalar get function for each row.
+    // <group>
+    virtual void getBoolBlock   (rownr_t startRow, uInt nrow, Bool* result);
+    virtual void getIntBlock    (rownr_t startRow, uInt nrow, Int64* result);
+    virtual void getDoubleBlock (rownr_t startRow, uInt nrow, Double* result);
+    // </group>
+
+    // Get the mutex serializing the evaluation of expressions in multiple
+    // threads (e.g. by a TaQL command using multiple threads).
+    // Table access is not thread-safe, so block get functions accessing
+    // a table and the default row-wise block get functions lock it.
+    // Block get functions of the other nodes do not need it, so
+    // expressions for which <src>canGetBlock</src> is True can largely
+    // be evaluated in parallel.
+    // <br>The mutex is recursive. Note that it is a no-op if casacore is
+    // built without USE_THREADS, but USE_OPENMP implies USE_THREADS.
+    static Mutex& getMutex()
+      { return theirGetMutex; }
+
     // General get functions for template purposes.
     // <group>
     void get (const TableExprId& id, Bool& value)
@@ -508,6 +540,8 @@ protected:
 private:
     // A copy of a TableExprNodeRep cannot be made.
     TableExprNodeRep& operator= (const TableExprNodeRep&);
+
+    static Mutex theirGetMutex;
 };
 
 
@@ -613,6 +647,10 @@ protected:
     static const Unit& makeEqualUnits (TableExprNodeRep* left,
 				       TableExprNodeRep*& right);
 
+    // Tell if all children can be evaluated by the block get functions.
+    // It can be used by derived classes implementing those functions.
+    Bool childrenCanGetBlock() const;
+
     TableExprNodeRep* lnode_p;     //# left operand
     TableExprNodeRep* rnode_p;     //# right operand
 };
@@ -212,6 +212,11 @@ void TaQLConstNode::setIsTableName()
   itsNRep->setIsTableName();
 }
 
+void TaQLConstNode::setIsParameter()
+{
+  itsNRep->setIsParameter();
+}
+
 const String& TaQLConstNode::getString() const
 {
   return itsNRep->getString();
@@ -180,6 +180,7 @@ class TaQLConstNode: public TaQLNode
 public:
   explicit TaQLConstNode (TaQLConstNodeRep* rep);
   void setIsTableName();
+  void setIsParameter();
   const String& getString() const;
 private:
   TaQLConstNodeRep* itsNRep;
@@ -109,6 +109,14 @@ TaQLConstNodeRep::TaQLConstNodeRep (Int64 value, const String& subTableName)
 {}
 TaQLConstNodeRep::~TaQLConstNodeRep()
 {}
+void TaQLConstNodeRep::setIsParameter()
+{
+  if (itsSValue.find_first_of (".:") != String::npos) {
+    throw TableInvExpr ("Invalid parameter " + itsSValue + " in expression");
+  }
+  itsType        = CTParam;
+  itsIsTableName = False;
+}
 const String& TaQLConstNodeRep::getString() const
 {
   AlwaysAssert (itsType == CTString, AipsError);
@@ -161,6 +169,9 @@ void TaQLConstNodeRep::show (std::ostream& os) const
     // 10 digits precision in the time
     os << MVTime::Format(MVTime::YMD, 10) << itsTValue;
     break;
+  case CTParam:
+    os << '$' << itsIValue;
+    break;
   }
   if (! itsUnit.empty()) {
     os << ")'" << itsUnit << "'";
@@ -191,6 +202,9 @@ void TaQLConstNodeRep::save (AipsIO& aio) const
   case CTTime:
     aio << (double)itsTValue;
     break;
+  case CTParam:
+    aio << itsIValue;
+    break;
   }
 }
 TaQLConstNodeRep* TaQLConstNodeRep::restore (AipsIO& aio)
@@ -242,6 +256,15 @@ TaQLConstNodeRep* TaQLConstNodeRep::restore (AipsIO& aio)
       aio >> v;
       return new TaQLConstNodeRep (MVTime(v));
     }
+  case CTParam:
+    {
+      Int64 value;
+      aio >> value;
+      TaQLConstNodeRep* rep = new TaQLConstNodeRep
+        (value, '$' + String::toString(value));
+      rep->setIsParameter();
+      return rep;
+    }
   }
   return 0;
 }
@@ -56,6 +56,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // This class is a TaQLNodeRep holding a constant expression or a table name.
 // The types supported are Bool, Int, Double, DComplex, String, and MVTime.
 // Note that a keyword or column name is represented by TaQLKeyColNodeRep.
+// <br>It can also hold a parameter $i used in an expression, whose value
+// is bound when executing a prepared statement (see class TaQLStatement).
+// The parameter number is kept in itsIValue.
 // </synopsis> 
 
 class TaQLConstNodeRep: public TaQLNodeRep
@@ -67,7 +70,8 @@ public:
 	     CTReal   =2,
 	     CTComplex=3,
 	     CTString =4,
-	     CTTime   =5};
+	     CTTime   =5,
+	     CTParam  =6};
   explicit TaQLConstNodeRep (Bool value);
   explicit TaQLConstNodeRep (Int64 value);
   explicit TaQLConstNodeRep (Double value);
@@ -79,6 +83,9 @@ public:
   virtual ~TaQLConstNodeRep();
   void setIsTableName()
     { itsIsTableName = True; }
+  // Turn a temporary table number $i into a parameter.
+  // An exception is thrown if a subtable name is given.
+  void setIsParameter();
   const String& getString() const;
   const String& getUnit() const
     { return itsUnit; }
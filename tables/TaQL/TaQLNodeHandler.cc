@@ -52,10 +52,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
   TaQLNodeResult TaQLNodeHandler::handleTree (const TaQLNode& node,
-				  const std::vector<const Table*>& tempTables)
+				  const std::vector<const Table*>& tempTables,
+                                  const std::vector<TableExprNode>& parameters)
   {
     clearStack();
     itsTempTables = tempTables;
+    itsParameters = parameters;
     return node.visit (*this);
   }
     
@@ -109,6 +111,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       expr = TableExprNode(node.itsTValue);
       expr.useUnit ("d");
       break;
+    case TaQLConstNodeRep::CTParam:
+      if (node.itsIValue < 1  ||  node.itsIValue > Int64(itsParameters.size())
+      ||  itsParameters[node.itsIValue-1].isNull()) {
+        throw TableInvExpr ("No value bound to parameter $" +
+                            String::toString(node.itsIValue));
+      }
+      expr = itsParameters[node.itsIValue-1];
+      break;
     }
     if (! node.getUnit().empty()) {
       expr = expr.useUnit (node.getUnit());
@@ -503,6 +513,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Add an entry to the stack.
     Bool outer = itsStack.empty();
     TableParseSelect* curSel = pushStack (TableParseSelect::PSELECT);
+    curSel->setNThreads (node.style().nthreads());
     // First handle LIMIT/OFFSET, because limit is needed when creating
     // a temp table for a select without a FROM.
     // In its turn limit/offset might use WITH tables, so do them very first.
@@ -551,6 +562,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   TaQLNodeResult TaQLNodeHandler::visitUpdateNode (const TaQLUpdateNodeRep& node)
   {
     TableParseSelect* curSel = pushStack (TableParseSelect::PUPDATE);
+    curSel->setNThreads (node.style().nthreads());
     // First handle LIMIT/OFFSET, because limit is needed when creating
     // a temp table for a select without a FROM.
     // In its turn limit/offset might use WITH tables, so do them very first.
@@ -609,6 +621,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   TaQLNodeResult TaQLNodeHandler::visitDeleteNode (const TaQLDeleteNodeRep& node)
   {
     TableParseSelect* curSel = pushStack (TableParseSelect::PDELETE);
+    curSel->setNThreads (node.style().nthreads());
     handleTables  (node.itsWith, False);
     handleTables  (node.itsTables);
     handleWhere   (node.itsWhere);
@@ -627,6 +640,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     Bool outer = itsStack.empty();
     TableParseSelect* curSel = pushStack (TableParseSelect::PCOUNT);
+    curSel->setNThreads (node.style().nthreads());
     handleTables  (node.itsWith, False);
     handleTables  (node.itsTables);
     visitNode     (node.itsColumns);
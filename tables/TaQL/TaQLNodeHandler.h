@@ -99,8 +99,12 @@ public:
 
   // Handle and process the raw parse tree.
   // The result contains a Table or TableExprNode object.
+  // The optional parameters give the values of the parameters $i
+  // used in expressions.
   TaQLNodeResult handleTree (const TaQLNode& tree,
-			     const std::vector<const Table*>&);
+			     const std::vector<const Table*>&,
+                             const std::vector<TableExprNode>& parameters =
+                               std::vector<TableExprNode>());
 
   // Define the functions to visit each node type.
   // <group>
@@ -199,6 +203,8 @@ private:
   std::vector<TableParseSelect*> itsStack;
   //# The temporary tables referred to by $i in the TaQL string.
   std::vector<const Table*> itsTempTables;
+  //# The values of the parameters $i in expressions in the TaQL string.
+  std::vector<TableExprNode> itsParameters;
 };
 
 
@@ -0,0 +1,215 @@
+//# TaQLStatement.cc: Prepared TaQL statement using a cache of parse trees
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/TaQL/TaQLStatement.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/TaQL/ExprNodeRep.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+std::map<String,TaQLStatement::CacheEntry> TaQLStatement::theirCache;
+std::list<String> TaQLStatement::theirLRU;
+uInt   TaQLStatement::theirMaxSize = 256;
+uInt64 TaQLStatement::theirNHits   = 0;
+uInt64 TaQLStatement::theirNMisses = 0;
+Mutex  TaQLStatement::theirMutex;
+
+
+TaQLStatement::TaQLStatement (const String& command)
+  : itsCommand (command)
+{
+  prepare();
+}
+
+TaQLStatement::TaQLStatement (const TaQLStatement& that)
+  : itsCommand    (that.itsCommand),
+    itsTables     (that.itsTables),
+    itsParameters (that.itsParameters)
+{
+  //# The tree can be shared with the cache, so link it while locked.
+  ScopedMutexLock lock(theirMutex);
+  itsTree = that.itsTree;
+}
+
+TaQLStatement& TaQLStatement::operator= (const TaQLStatement& that)
+{
+  if (this != &that) {
+    itsCommand    = that.itsCommand;
+    itsTables     = that.itsTables;
+    itsParameters = that.itsParameters;
+    ScopedMutexLock lock(theirMutex);
+    itsTree = that.itsTree;
+  }
+  return *this;
+}
+
+TaQLStatement::~TaQLStatement()
+{
+  ScopedMutexLock lock(theirMutex);
+  itsTree = TaQLNode();
+}
+
+void TaQLStatement::prepare()
+{
+  {
+    ScopedMutexLock lock(theirMutex);
+    std::map<String,CacheEntry>::iterator iter = theirCache.find (itsCommand);
+    if (iter != theirCache.end()) {
+      // Make it the most recently used one.
+      theirLRU.splice (theirLRU.begin(), theirLRU, iter->second.lruPos);
+      itsTree = iter->second.tree;
+      theirNHits++;
+      return;
+    }
+    theirNMisses++;
+  }
+  // Parse outside the lock, so other statements can be prepared meanwhile.
+  // The tree is not shared yet.
+  TaQLNode tree = TaQLNode::parse (itsCommand);
+  ScopedMutexLock lock(theirMutex);
+  std::map<String,CacheEntry>::iterator iter = theirCache.find (itsCommand);
+  if (iter != theirCache.end()) {
+    // Another thread has added it in the mean time.
+    itsTree = iter->second.tree;
+  } else if (theirMaxSize > 0) {
+    shrinkCache (theirMaxSize - 1);
+    theirLRU.push_front (itsCommand);
+    CacheEntry& entry = theirCache[itsCommand];
+    entry.tree   = tree;
+    entry.lruPos = theirLRU.begin();
+    itsTree = tree;
+  } else {
+    itsTree = tree;
+  }
+  tree = TaQLNode();
+}
+
+void TaQLStatement::shrinkCache (uInt size)
+{
+  while (theirCache.size() > size) {
+    theirCache.erase (theirLRU.back());
+    theirLRU.pop_back();
+  }
+}
+
+void TaQLStatement::bindTable (uInt i, const Table& table)
+{
+  if (i == 0) {
+    throw TableInvExpr ("TaQLStatement: table numbers start at $1");
+  }
+  if (i > itsTables.size()) {
+    itsTables.resize (i);
+  }
+  itsTables[i-1] = table;
+}
+
+void TaQLStatement::bind (uInt i, const TableExprNode& value)
+{
+  if (i == 0) {
+    throw TableInvExpr ("TaQLStatement: parameter numbers start at $1");
+  }
+  if (value.isNull()  ||  ! value.getNodeRep()->isConstant()) {
+    throw TableInvExpr ("TaQLStatement: value bound to parameter $" +
+                        String::toString(i) + " must be a constant");
+  }
+  if (i > itsParameters.size()) {
+    itsParameters.resize (i);
+  }
+  itsParameters[i-1] = value;
+}
+
+void TaQLStatement::clearBindings()
+{
+  itsTables.clear();
+  itsParameters.clear();
+}
+
+TaQLResult TaQLStatement::execute() const
+{
+  Vector<String> columnNames;
+  String commandType;
+  return execute (columnNames, commandType);
+}
+
+TaQLResult TaQLStatement::execute (Vector<String>& columnNames,
+                                   String& commandType) const
+{
+  std::vector<const Table*> tables(itsTables.size(), 0);
+  for (uInt i=0; i<itsTables.size(); ++i) {
+    if (! itsTables[i].isNull()) {
+      tables[i] = &(itsTables[i]);
+    }
+  }
+  return tableCommand (itsCommand, itsTree, tables, itsParameters,
+                       columnNames, commandType);
+}
+
+void TaQLStatement::setCacheSize (uInt maxSize)
+{
+  ScopedMutexLock lock(theirMutex);
+  theirMaxSize = maxSize;
+  shrinkCache (maxSize);
+}
+
+uInt TaQLStatement::maxCacheSize()
+{
+  ScopedMutexLock lock(theirMutex);
+  return theirMaxSize;
+}
+
+uInt TaQLStatement::cacheSize()
+{
+  ScopedMutexLock lock(theirMutex);
+  return theirCache.size();
+}
+
+uInt64 TaQLStatement::nCacheHits()
+{
+  ScopedMutexLock lock(theirMutex);
+  return theirNHits;
+}
+
+uInt64 TaQLStatement::nCacheMisses()
+{
+  ScopedMutexLock lock(theirMutex);
+  return theirNMisses;
+}
+
+void TaQLStatement::clearCache()
+{
+  ScopedMutexLock lock(theirMutex);
+  theirCache.clear();
+  theirLRU.clear();
+  theirNHits   = 0;
+  theirNMisses = 0;
+}
+
+
+} //# NAMESPACE CASACORE - END
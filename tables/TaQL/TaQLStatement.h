@@ -0,0 +1,205 @@
+//# TaQLStatement.h: Prepared TaQL statement using a cache of parse trees
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TAQLSTATEMENT_H
+#define TABLES_TAQLSTATEMENT_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/TaQL/TaQLNode.h>
+#include <casacore/tables/TaQL/TaQLResult.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/OS/Mutex.h>
+#include <vector>
+#include <list>
+#include <map>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+template<class T> class Vector;
+
+
+// <summary>
+// Prepared TaQL statement using a cache of parse trees
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTaQLStatement">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto group=TableParse.h#tableCommand>tableCommand</linkto>
+//   <li> <linkto class=TaQLNode>TaQLNode</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A TaQLStatement is a TaQL command that is parsed once and can be
+// executed many times, possibly with different parameter values.
+// The raw parse tree of a command is kept in a process-wide cache
+// keyed by the command string, so preparing the same command again
+// (e.g., in another function or thread) does not parse it again.
+// The cache holds the most recently used trees; its size can be set
+// with <src>setCacheSize</src>.
+// <p>
+// Placeholders <src>$i</src> (i starting at 1) can be used in the command.
+// As a table name, $i refers to the i-th table bound with
+// <src>bindTable</src> (as the temporary tables in
+// <src>tableCommand</src>). In an expression, $i refers to the i-th
+// value bound with <src>bind</src>. The value can be a scalar or an array.
+// The parameters must be bound before executing; they keep their values
+// until rebound or cleared.
+// <p>
+// Executing a statement processes the cached parse tree for the bound
+// tables and values, which is the same as done by
+// <src>tableCommand</src> after parsing. Thus tables are opened and
+// expression nodes are created at each execution, so a statement
+// always sees the current contents of the tables.
+// <p>
+// Different TaQLStatement objects can be used in parallel in different
+// threads, even if they share a cached parse tree. A single object must
+// not be used by multiple threads at the same time.
+// Note that an ALTER TABLE command cannot be executed in parallel with
+// other statements using the same command string.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   TaQLStatement stmt ("select from $1 where ANTENNA1==$1 && ANTENNA2==$2");
+//   stmt.bindTable (1, Table("my.ms"));
+//   for (Int i=0; i<nant; ++i) {
+//     stmt.bind (1, i);
+//     stmt.bind (2, i+1);
+//     Table result = stmt.execute().table();
+//     ...
+//   }
+// </srcblock>
+// </example>
+
+// <motivation>
+// Services doing many small TaQL lookups spend most of the time in parsing
+// the commands. Parsing only once and binding the varying values
+// avoids that overhead and the need to build command strings.
+// </motivation>
+
+class TaQLStatement
+{
+public:
+  // Prepare the given TaQL command.
+  // It is taken from the cache if present, otherwise it is parsed
+  // (and added to the cache). An exception is thrown in case of
+  // parse errors.
+  explicit TaQLStatement (const String& command);
+
+  // Copy constructor and assignment (copy semantics for the bindings).
+  // <group>
+  TaQLStatement (const TaQLStatement&);
+  TaQLStatement& operator= (const TaQLStatement&);
+  // </group>
+
+  ~TaQLStatement();
+
+  // Get the command.
+  const String& command() const
+    { return itsCommand; }
+
+  // Bind a table to $i (i>=1) used as a table name.
+  void bindTable (uInt i, const Table& table);
+
+  // Bind a value to parameter $i (i>=1) used in an expression.
+  // The value must be a constant (scalar or array) expression.
+  void bind (uInt i, const TableExprNode& value);
+
+  // Clear all bound tables and values.
+  void clearBindings();
+
+  // Execute the statement. It returns the resulting table or, for a CALC
+  // command, the resulting expression. The command type
+  // (select, update, etc.) and selected column names can be returned.
+  // <group>
+  TaQLResult execute() const;
+  TaQLResult execute (Vector<String>& columnNames,
+                      String& commandType) const;
+  // </group>
+
+  // Set the maximum number of parse trees in the cache (default 256).
+  // The least recently used trees are removed if needed.
+  static void setCacheSize (uInt maxSize);
+
+  // Get the maximum and actual number of parse trees in the cache.
+  // <group>
+  static uInt maxCacheSize();
+  static uInt cacheSize();
+  // </group>
+
+  // Get the number of times a command was found or not found in the cache.
+  // <group>
+  static uInt64 nCacheHits();
+  static uInt64 nCacheMisses();
+  // </group>
+
+  // Remove all parse trees from the cache and reset the statistics.
+  static void clearCache();
+
+private:
+  // Get the parse tree from the cache or parse the command.
+  void prepare();
+
+  // Remove least recently used entries until the cache has the given size.
+  // The cache must be locked.
+  static void shrinkCache (uInt size);
+
+  // An entry in the cache holds the tree and its position in the LRU list.
+  struct CacheEntry {
+    TaQLNode tree;
+    std::list<String>::iterator lruPos;
+  };
+
+  //# Data members.
+  String                     itsCommand;
+  TaQLNode                   itsTree;
+  std::vector<Table>         itsTables;
+  std::vector<TableExprNode> itsParameters;
+
+  //# The cache (and the shared trees) are guarded by the mutex.
+  //# The LRU list contains the commands, the most recently used first.
+  static std::map<String,CacheEntry> theirCache;
+  static std::list<String>           theirLRU;
+  static uInt                        theirMaxSize;
+  static uInt64                      theirNHits;
+  static uInt64                      theirNMisses;
+  static Mutex                       theirMutex;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -37,7 +37,8 @@ TaQLStyle::TaQLStyle (uInt origin)
     itsEndExcl   (False),
     itsCOrder    (False),
     itsDoTiming  (False),
-    itsDoTracing (False)
+    itsDoTracing (False),
+    itsNThreads  (1)
 {
   // Define mscal as a synonym for derivedmscal.
   defineSynonym ("mscal", "derivedmscal");
@@ -85,6 +86,7 @@ void TaQLStyle::reset()
   set ("GLISH"); 
   itsDoTiming  = False;
   itsDoTracing = False;
+  itsNThreads  = 1;
 }
 
 void TaQLStyle::defineSynonym (const String& synonym, const String& udfLibName)
@@ -101,6 +103,20 @@ void TaQLStyle::defineSynonym (const String& command)
                  trim(String(cmd.after(pos))));
 }
 
+void TaQLStyle::setOption (const String& command)
+{
+  String cmd(command);  // to make it non-const
+  String::size_type pos = cmd.find ('=');
+  AlwaysAssert (pos != String::npos, AipsError);
+  String name = upcase(trim(String(cmd.before(pos))));
+  String value = trim(String(cmd.after(pos)));
+  if (name == "THREADS") {
+    itsNThreads = String::toInt (value, True);
+  } else {
+    throw TableError(name + " is an invalid TaQL STYLE option");
+  }
+}
+
 String TaQLStyle::findSynonym (const String& synonym) const
 {
   map<String,String>::const_iterator it = itsUDFLibNameMap.find (synonym);
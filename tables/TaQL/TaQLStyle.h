@@ -56,6 +56,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // The class is also used to tell the TaQL execution engine if timings
 // or tracing of the various parts of the TaQL command need to be done.
 //
+// Furthermore it tells the number of threads to use when executing
+// the WHERE and GROUPBY parts of a command. It can be set using the
+// option 'threads=n' in the style, where 0 means that
+// <src>OMP::maxThreads()</src> is used. The default is 1, thus a
+// command is only executed multi-threaded if explicitly asked for.
+//
 // Finally it is possible to define synonyms for UDF library names.
 // For example, 'derivedmscal' is a lot to type, so a synonym 'mscal'
 // (or even 'mc') can be defined for it.
@@ -64,10 +70,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 class TaQLStyle
 {
 public:
-  // Default style is Glish and no timing/tracing.
+  // Default style is Glish, no timing/tracing, and default nr of threads.
   explicit TaQLStyle (uInt origin=1);
 
-  // Reset to the default Glish style and no timing/tracing.
+  // Reset to the default Glish style, no timing/tracing, and default
+  // nr of threads.
   void reset();
 
   // Set the style according to the (case-insensitive) value.
@@ -85,6 +92,10 @@ public:
   // Set a synonym using a command like 'synonym = udflibname'.
   void defineSynonym (const String& command);
 
+  // Set an option using a command like 'name = value'.
+  // The only option is 'threads' defining the number of threads to use.
+  void setOption (const String& command);
+
   // Find the UDF library name belonging to a synonym.
   // If undefined, the synonym itself is returned.
   String findSynonym (const String& synonym) const;
@@ -115,12 +126,22 @@ public:
   Bool doTracing() const
     { return itsDoTracing; }
 
+  // Set the number of threads to use (0 means OMP::maxThreads()).
+  // The default is 1.
+  void setNThreads (uInt nthreads)
+    { itsNThreads = nthreads; }
+
+  // Get the number of threads to use (0 means OMP::maxThreads()).
+  uInt nthreads() const
+    { return itsNThreads; }
+
 private:
   uInt itsOrigin;
   Bool itsEndExcl;
   Bool itsCOrder;
   Bool itsDoTiming;
   Bool itsDoTracing;
+  uInt itsNThreads;
   std::map<String,String> itsUDFLibNameMap;
 };
 
@@ -187,6 +187,8 @@ TEMPTAB   [$]{INT}(("."{NAME})?"::"{NAME}("."{NAME})*)?
 NAMETAB   ([A-Za-z0-9_./+\-~$@:]|(\\.))+
 /* A UDFlib synonym */
 UDFLIBSYN {NAME}{WHITE}"="{WHITE}{NAME}
+/* A style option */
+STYLEOPT  {NAME}{WHITE}"="{WHITE}{INT}
 /* A regular expression can be delimited by / % or @ optionall=y followed by i
    to indicate case-insensitive matching.
      m is a partial match (match if part of string matches the regex)
@@ -497,6 +499,15 @@ PATTREX   {OPERREX}{WHITE}({PATTEX}|{DISTEX})
             return SEMICOL;
           }
 
+ /* style option definition (e.g. threads=4) */
+<STYLEstate>{STYLEOPT} {
+            tableGramPosition() += yyleng;
+            lvalp->val = new TaQLConstNode(
+                new TaQLConstNodeRep (String(TableGramtext,yyleng)));
+            TaQLNode::theirNodesCreated.push_back (lvalp->val);
+	    return STYLEOPT;
+	  }
+
  /* UDF libname synonym definition */
 <STYLEstate>{UDFLIBSYN} {
             tableGramPosition() += yyleng;
@@ -85,6 +85,7 @@ Expect them, so bison does not generate an error message.
 %token ALL                  /* ALL (in SELECT ALL) */
 %token <val> NAME           /* name of function, field, table, or alias */
 %token <val> UDFLIBSYN      /* UDF library name synonym definition */
+%token <val> STYLEOPT       /* style option definition */
 %token <val> FLDNAME        /* name of field or table */
 %token <val> TABNAME        /* table name */
 %token <val> LITERAL
@@ -291,7 +292,7 @@ stylecoms: stylecoms stylecomm
 stylecomm: STYLE stylelist
          ;
 
-/* A style can consist of multiple keywords and UDFLIB synonyms */
+/* A style can consist of multiple keywords, UDFLIB synonyms and options */
 stylelist: stylelist COMMA NAME
              { TaQLNode::theirStyle.set ($3->getString()); }
          | NAME
@@ -300,6 +301,10 @@ stylelist: stylelist COMMA NAME
              { TaQLNode::theirStyle.defineSynonym ($3->getString()); }
          | UDFLIBSYN
              { TaQLNode::theirStyle.defineSynonym ($1->getString()); }
+         | stylelist COMMA STYLEOPT
+             { TaQLNode::theirStyle.setOption ($3->getString()); }
+         | STYLEOPT
+             { TaQLNode::theirStyle.setOption ($1->getString()); }
          ;
 
 /* The possible TaQL commands; nestedcomm can be used in a nested FROM */
@@ -1735,13 +1740,19 @@ unit:      namefld {
            }
          ;
 
-/* A numeric or boolean literal or a string literal (in quotes) */
+/* A numeric or boolean literal or a string literal (in quotes).
+   A temporary table number $i in an expression is a parameter whose
+   value is bound when executing a prepared statement. */
 literal:   LITERAL {
 	       $$ = $1;
 	   }
          | STRINGLITERAL {
 	       $$ = $1;
 	   }
+         | TABNAME {
+	       $1->setIsParameter();
+	       $$ = $1;
+	   }
          ;
 
 /* A set is is a series of values enclosed in brackets or parentheses.
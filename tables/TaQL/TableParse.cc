@@ -64,6 +64,7 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/casa/ostream.h>
 
 #include <casacore/casa/Containers/BlockIO.h>
@@ -227,6 +228,7 @@ TableParseSelect::TableParseSelect (CommandType commandType)
     offset_p        (0),
     stride_p        (1),
     insSel_p        (0),
+    nthreads_p      (1),
     noDupl_p        (False),
     order_p         (Sort::Ascending)
 {}
@@ -2689,7 +2691,7 @@ Table TableParseSelect::doInsert (Bool showTimings, Table& table)
       nrow = table.nrow() + limit_p;
     }
     Vector<uInt> newRownrs(nrow);
-    indgen (newRownrs, table.nrow());
+    indgen (newRownrs, uInt(table.nrow()));
     Vector<uInt> selRownrs(1, table.nrow() + nrow);
     // Add new rows to TableExprNodeRowid.
     // It works because NodeRowid does not obey disableApplySelection.
@@ -2935,6 +2937,215 @@ TableParseSelect::doGroupByAggrMultipleKeys
   return funcSets;
 }
 
+//# The number of selected rows per block evaluated in a parallel groupby.
+static const uInt groupByBlockSize = 4096;
+
+//# The groups and aggregation results of a part of the rows in a
+//# parallel groupby. The keys are kept in order of first appearance.
+struct TableParseGroupByPart
+{
+  std::map<TableExprGroupKeySet, int>        keyFuncMap;
+  vector<TableExprGroupKeySet>               keys;
+  vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
+};
+
+//# Do the groupby/aggregation for the selected rows st till end.
+//# The keys and aggregate operands are evaluated in blocks of rows, thus
+//# not per row, so it can be done in parallel for different parts.
+//# The values are evaluated for all rows spanned by a block, so the
+//# selected rows must be in ascending order.
+//# The data type of the value needed per aggregate function is given
+//# in valueTypes (NTAny means no value needed).
+void doGroupByAggrPart
+(const vector<TableExprNode>& groupbyNodes,
+ const vector<TableExprNodeRep*>& aggrNodes,
+ const vector<TableExprNodeRep::NodeDataType>& valueTypes,
+ const vector<TableExprNodeRep*>& operands,
+ const Vector<uInt>& rownrs, uInt st, uInt end,
+ TableParseGroupByPart& part)
+{
+  uInt nkey  = groupbyNodes.size();
+  uInt nfunc = valueTypes.size();
+  TableExprGroupKeySet keySet(groupbyNodes);
+  vector<Block<Bool> >   keyBool(nkey);
+  vector<Block<Int64> >  keyInt(nkey);
+  vector<Block<Double> > keyDouble(nkey);
+  vector<Block<Int64> >  valInt(nfunc);
+  vector<Block<Double> > valDouble(nfunc);
+  TableExprId rowid(0);
+  for (uInt i=st; i<end; i+=groupByBlockSize) {
+    uInt nr = std::min (groupByBlockSize, end-i);
+    rownr_t startRow = rownrs[i];
+    uInt nspan = rownrs[i+nr-1] - startRow + 1;
+    for (uInt k=0; k<nkey; ++k) {
+      switch (groupbyNodes[k].getNodeRep()->dataType()) {
+      case TableExprNodeRep::NTBool:
+        keyBool[k].resize (nspan, False, False);
+        groupbyNodes[k].getBoolBlock (startRow, nspan, keyBool[k].storage());
+        break;
+      case TableExprNodeRep::NTInt:
+        keyInt[k].resize (nspan, False, False);
+        groupbyNodes[k].getIntBlock (startRow, nspan, keyInt[k].storage());
+        break;
+      default:
+        keyDouble[k].resize (nspan, False, False);
+        groupbyNodes[k].getDoubleBlock (startRow, nspan,
+                                        keyDouble[k].storage());
+        break;
+      }
+    }
+    for (uInt f=0; f<nfunc; ++f) {
+      if (valueTypes[f] == TableExprNodeRep::NTInt) {
+        valInt[f].resize (nspan, False, False);
+        operands[f]->getIntBlock (startRow, nspan, valInt[f].storage());
+      } else if (valueTypes[f] == TableExprNodeRep::NTDouble) {
+        valDouble[f].resize (nspan, False, False);
+        operands[f]->getDoubleBlock (startRow, nspan, valDouble[f].storage());
+      }
+    }
+    for (uInt j=i; j<i+nr; ++j) {
+      uInt inx = rownrs[j] - startRow;
+      for (uInt k=0; k<nkey; ++k) {
+        switch (groupbyNodes[k].getNodeRep()->dataType()) {
+        case TableExprNodeRep::NTBool:
+          keySet[k].set (keyBool[k][inx]);
+          break;
+        case TableExprNodeRep::NTInt:
+          keySet[k].set (keyInt[k][inx]);
+          break;
+        default:
+          keySet[k].set (keyDouble[k][inx]);
+          break;
+        }
+      }
+      int groupnr = part.funcSets.size();
+      std::map<TableExprGroupKeySet, int>::iterator iter =
+        part.keyFuncMap.find (keySet);
+      if (iter == part.keyFuncMap.end()) {
+        part.keyFuncMap.insert (std::make_pair (keySet, groupnr));
+        part.keys.push_back (keySet);
+        // Making the function objects changes the aggregate nodes.
+        ScopedMutexLock lock(TableExprNodeRep::getMutex());
+        part.funcSets.push_back (new TableExprGroupFuncSet (aggrNodes));
+      } else {
+        groupnr = iter->second;
+      }
+      rowid.setRownr (rownrs[j]);
+      TableExprGroupFuncSet& funcSet = *part.funcSets[groupnr];
+      funcSet.setId (rowid);
+      const vector<CountedPtr<TableExprGroupFuncBase> >& funcs =
+        funcSet.getFuncs();
+      for (uInt f=0; f<nfunc; ++f) {
+        if (valueTypes[f] == TableExprNodeRep::NTDouble) {
+          funcs[f]->applyDouble (rowid, valDouble[f][inx]);
+        } else if (valueTypes[f] == TableExprNodeRep::NTInt) {
+          funcs[f]->applyInt (rowid, valInt[f][inx]);
+        } else {
+          funcs[f]->applyInt (rowid, 0);
+        }
+      }
+    }
+  }
+}
+
+uInt TableParseSelect::groupByThreads
+(const vector<TableExprNodeRep*>& aggrNodes) const
+{
+  uInt nthreads = (nthreads_p == 0  ?  OMP::maxThreads() : nthreads_p);
+  uInt nrow = rownrs_p.size();
+  if (nthreads <= 1  ||  nrow < 2*groupByBlockSize) {
+    return 1;
+  }
+  // The rows must be ascending and not too sparse, because the
+  // expressions are evaluated for all rows spanned by a block.
+  for (uInt i=1; i<nrow; ++i) {
+    if (rownrs_p[i] <= rownrs_p[i-1]) {
+      return 1;
+    }
+  }
+  if (rownrs_p[nrow-1] - rownrs_p[0] >= 2*nrow) {
+    return 1;
+  }
+  for (uInt i=0; i<groupbyNodes_p.size(); ++i) {
+    const TableExprNode& node = groupbyNodes_p[i];
+    DataType dtype = node.dataType();
+    if (!node.isScalar()  ||  !node.canGetBlock()  ||
+        (dtype != TpBool  &&  dtype != TpInt  &&  dtype != TpDouble)) {
+      return 1;
+    }
+  }
+  TableExprGroupFuncSet funcSet (aggrNodes);
+  const vector<CountedPtr<TableExprGroupFuncBase> >& funcs =
+    funcSet.getFuncs();
+  for (uInt i=0; i<funcs.size(); ++i) {
+    if (! funcs[i]->canMerge()) {
+      return 1;
+    }
+  }
+  return std::min (nthreads, nrow/groupByBlockSize);
+}
+
+vector<CountedPtr<TableExprGroupFuncSet> >
+TableParseSelect::doGroupByAggrParallel
+(const vector<TableExprNodeRep*>& aggrNodes, uInt nthreads)
+{
+  // Get the operand values needed by the aggregate functions.
+  vector<TableExprNodeRep::NodeDataType> valueTypes;
+  vector<TableExprNodeRep*> operands;
+  {
+    TableExprGroupFuncSet funcSet (aggrNodes);
+    const vector<CountedPtr<TableExprGroupFuncBase> >& funcs =
+      funcSet.getFuncs();
+    for (uInt i=0; i<funcs.size(); ++i) {
+      valueTypes.push_back (funcs[i]->applyDataType());
+      operands.push_back (funcs[i]->operand());
+    }
+  }
+  // Each thread does a consecutive part of the rows.
+  vector<TableParseGroupByPart> parts(nthreads);
+  uInt nrow = rownrs_p.size();
+  String error;
+  Bool failed = False;
+#pragma omp parallel for num_threads(nthreads) schedule(static,1)
+  for (Int p=0; p<Int(nthreads); ++p) {
+    uInt st  = uInt(Int64(nrow) * p / nthreads);
+    uInt end = uInt(Int64(nrow) * (p+1) / nthreads);
+    try {
+      doGroupByAggrPart (groupbyNodes_p, aggrNodes, valueTypes, operands,
+                         rownrs_p, st, end, parts[p]);
+    } catch (std::exception& x) {
+#pragma omp critical(TableParseSelect_groupby)
+      {
+        if (!failed) {
+          error  = x.what();
+          failed = True;
+        }
+      }
+    }
+  }
+  if (failed) {
+    throw TableInvExpr ("GROUPBY failed: " + error);
+  }
+  // Merge the parts in row order, so groups are ordered as in a serial run.
+  vector<CountedPtr<TableExprGroupFuncSet> > funcSets (parts[0].funcSets);
+  std::map<TableExprGroupKeySet, int> keyFuncMap (parts[0].keyFuncMap);
+  for (uInt p=1; p<nthreads; ++p) {
+    const TableParseGroupByPart& part = parts[p];
+    for (uInt i=0; i<part.keys.size(); ++i) {
+      std::map<TableExprGroupKeySet, int>::iterator iter =
+        keyFuncMap.find (part.keys[i]);
+      if (iter == keyFuncMap.end()) {
+        keyFuncMap.insert (std::make_pair (part.keys[i],
+                                           int(funcSets.size())));
+        funcSets.push_back (part.funcSets[i]);
+      } else {
+        funcSets[iter->second]->merge (*part.funcSets[i]);
+      }
+    }
+  }
+  return funcSets;
+}
+
 CountedPtr<TableExprGroupResult> TableParseSelect::doGroupByAggr
 (const vector<TableExprNodeRep*>& aggrNodes)
 {
@@ -2961,8 +3172,11 @@ CountedPtr<TableExprGroupResult> TableParseSelect::doGroupByAggr
     immediateNodes.push_back (&expridNode);
   }
   vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
+  uInt nthreads = groupByThreads (immediateNodes);
+  if (nthreads > 1) {
+    funcSets = doGroupByAggrParallel (immediateNodes, nthreads);
   // Use a faster way for a single groupby key.
-  if (groupbyNodes_p.size() == 1  &&
+  } else if (groupbyNodes_p.size() == 1  &&
       groupbyNodes_p[0].dataType() == TpDouble) {
     funcSets = doGroupByAggrSingleKey<Double> (immediateNodes);
   } else if (groupbyNodes_p.size() == 1  &&
@@ -3844,7 +4058,7 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
 //#//		 << rang[i].end() << endl;
 //#//	}
     Timer timer;
-    resultTable = table(node_p, nrmax);
+    resultTable = table(node_p, nrmax, 0, nthreads_p);
     if (showTimings) {
       timer.show ("  Where       ");
     }
@@ -4115,21 +4329,20 @@ TaQLResult tableCommand (const String& str,
   return tableCommand (str, tempTables, cols, commandType);
 }
 
-//# Do the actual parsing of a command and execute it.
-TaQLResult tableCommand (const String& str,
-			 const std::vector<const Table*>& tempTables,
-			 Vector<String>& cols,
-			 String& commandType)
+//# Process the raw parse tree of a command and execute it.
+static TaQLResult executeTree (const String& str,
+                               const TaQLNode& tree,
+                               const std::vector<const Table*>& tempTables,
+                               const std::vector<TableExprNode>& parameters,
+                               Vector<String>& cols,
+                               String& commandType,
+                               Timer& timer)
 {
-  commandType = "error";
-  // Do the first parse step. It returns a raw parse tree
-  // (or throws an exception).
-  Timer timer;
-  TaQLNode tree = TaQLNode::parse(str);
-  // Now process the raw tree and get the final ParseSelect object.
+  // Process the raw tree and get the final ParseSelect object.
   try {
     TaQLNodeHandler treeHandler;
-    TaQLNodeResult res = treeHandler.handleTree (tree, tempTables);
+    TaQLNodeResult res = treeHandler.handleTree (tree, tempTables,
+                                                 parameters);
     const TaQLNodeHRValue& hrval = TaQLNodeHandler::getHR(res);
     commandType = hrval.getString();
     TableExprNode expr = hrval.getExpr();
@@ -4152,4 +4365,33 @@ TaQLResult tableCommand (const String& str,
   } 
 }
 
+//# Do the actual parsing of a command and execute it.
+TaQLResult tableCommand (const String& str,
+			 const std::vector<const Table*>& tempTables,
+			 Vector<String>& cols,
+			 String& commandType)
+{
+  commandType = "error";
+  // Do the first parse step. It returns a raw parse tree
+  // (or throws an exception).
+  Timer timer;
+  TaQLNode tree = TaQLNode::parse(str);
+  return executeTree (str, tree, tempTables, std::vector<TableExprNode>(),
+                      cols, commandType, timer);
+}
+
+//# Execute an already parsed command.
+TaQLResult tableCommand (const String& str,
+                         const TaQLNode& tree,
+			 const std::vector<const Table*>& tempTables,
+                         const std::vector<TableExprNode>& parameters,
+			 Vector<String>& cols,
+			 String& commandType)
+{
+  commandType = "error";
+  Timer timer;
+  return executeTree (str, tree, tempTables, parameters,
+                      cols, commandType, timer);
+}
+
 } //# NAMESPACE CASACORE - END
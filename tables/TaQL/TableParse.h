@@ -51,6 +51,7 @@ class TableExprNodeSetElem;
 class TableExprNodeIndex;
 class TableColumn;
 class AipsIO;
+class TaQLNode;
 template<class T> class Vector;
 
 
@@ -167,6 +168,20 @@ TaQLResult tableCommand (const String& command,
 			 String& commandType);
 // </group>
 
+// <synopsis>
+// Execute a command that has already been parsed into the given tree
+// (see <linkto class=TaQLStatement>TaQLStatement</linkto>).
+// The command string is only used in error messages.
+// The parameters give the values of the parameters $i used in
+// expressions in the command.
+// </synopsis>
+TaQLResult tableCommand (const String& command,
+                         const TaQLNode& tree,
+			 const std::vector<const Table*>& tempTables,
+                         const std::vector<TableExprNode>& parameters,
+			 Vector<String>& columnNames,
+			 String& commandType);
+
 
 
 
@@ -593,6 +608,11 @@ public:
   void setDMInfo (const Record& dminfo)
     { dminfo_p = dminfo;}
 
+  // Set the number of threads to use in the WHERE and GROUPBY steps.
+  // 0 means OMP::maxThreads(); the default is 1.
+  void setNThreads (uInt nthreads)
+    { nthreads_p = nthreads; }
+
   // Handle the name and type given in a GIVING clause.
   void handleGiving (const String& name, const Record& type);
 
@@ -869,6 +889,20 @@ private:
   vector<CountedPtr<TableExprGroupFuncSet> > doGroupByAggrMultipleKeys
   (const vector<TableExprNodeRep*>& aggrNodes);
 
+  // Determine the number of threads to use in a groupby/aggregate step.
+  // It returns 1 if it cannot be done in parallel, thus if the groupby keys
+  // and aggregate operands cannot be evaluated in blocks of rows, if an
+  // aggregate function cannot be merged, or if the selected rows are too
+  // few, unordered, or too sparse.
+  uInt groupByThreads (const vector<TableExprNodeRep*>& aggrNodes) const;
+
+  // Create the set of aggregate functions and groupby keys using
+  // multiple threads, each doing a consecutive part of the rows.
+  // The results of the parts are merged in row order, so the groups are
+  // in the same order as in the other doGroupByAggr functions.
+  vector<CountedPtr<TableExprGroupFuncSet> > doGroupByAggrParallel
+  (const vector<TableExprNodeRep*>& aggrNodes, uInt nthreads);
+
   //# Command type.
   CommandType commandType_p;
   //# Table description for a series of column descriptions.
@@ -926,6 +960,8 @@ private:
   std::vector<TableExprNode> insertExprs_p;
   //# The table selection to be inserted.
   TableParseSelect* insSel_p;
+  //# The number of threads to use (0 means OMP::maxThreads()).
+  uInt nthreads_p;
   //# The sort list.
   std::vector<TableParseSort> sort_p;
   //# The noDuplicates sort switch.
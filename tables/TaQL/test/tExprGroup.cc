@@ -29,12 +29,21 @@
 #include <casacore/tables/TaQL/ExprAggrNode.h>
 #include <casacore/tables/TaQL/ExprGroupAggrFunc.h>
 #include <casacore/tables/TaQL/RecordExpr.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/math.h>
 #include <casacore/casa/stdvector.h>
 #include <casacore/casa/iostream.h>
 
@@ -60,6 +69,19 @@ Bool foundError = False;
   }\
 }
 
+// Create a scratch table with a column containing the given values.
+template<typename T>
+Table makeTable (const String& name, const Vector<T>& vec)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<T>("fld"));
+  SetupNewTable newtab(name, td, Table::Scratch);
+  Table tab(newtab, vec.size());
+  ScalarColumn<T> col(tab, "fld");
+  col.putColumn (vec);
+  return tab;
+}
+
 void check (const TableExprNode& expr,
             const vector<Record>& recs,
             Bool expVal, const String& str)
@@ -148,6 +170,51 @@ void check (const TableExprNode& expr,
   }
 }
 
+// Check that applying the values to two functions, each doing a part of
+// the rows, and merging them gives the same result as a single function.
+// The operand is a table column, so its values can be evaluated in blocks
+// of rows as done in a parallel GROUPBY.
+void checkMerge (const TableExprNode& expr, uInt nrow,
+                 Double expVal, const String& str)
+{
+  cout << "Test merge " << str << endl;
+  // Get the aggregation node.
+  TableExprAggrNode& aggr = const_cast<TableExprAggrNode&>
+    (dynamic_cast<const TableExprAggrNode&>(*expr.getNodeRep()));
+  CountedPtr<TableExprGroupFuncBase> func1 = aggr.makeGroupAggrFunc();
+  CountedPtr<TableExprGroupFuncBase> func2 = aggr.makeGroupAggrFunc();
+  AlwaysAssertExit (func1->canMerge()  &&  func2->canMerge());
+  TableExprNodeRep* operand = func1->operand();
+  uInt nr1 = nrow/3;
+  Block<Int64>  valInt(nrow);
+  Block<Double> valDouble(nrow);
+  if (func1->applyDataType() == TableExprNodeRep::NTInt) {
+    operand->getIntBlock (0, nr1, valInt.storage());
+    operand->getIntBlock (nr1, nrow-nr1, valInt.storage() + nr1);
+  } else {
+    AlwaysAssertExit (func1->applyDataType() == TableExprNodeRep::NTDouble);
+    operand->getDoubleBlock (0, nr1, valDouble.storage());
+    operand->getDoubleBlock (nr1, nrow-nr1, valDouble.storage() + nr1);
+  }
+  for (uInt i=0; i<nrow; ++i) {
+    TableExprId id(i);
+    TableExprGroupFuncBase& func = (i < nr1 ? *func1 : *func2);
+    if (func.applyDataType() == TableExprNodeRep::NTInt) {
+      func.applyInt (id, valInt[i]);
+    } else {
+      func.applyDouble (id, valDouble[i]);
+    }
+  }
+  func1->merge (*func2);
+  func1->finish();
+  Double val = func1->getDouble();
+  if (!near (val, expVal, 1.e-10)) {
+    foundError = True;
+    cout << str << ": found value " << val << "; expected "
+         << expVal << endl;
+  }
+}
+
 void checkLazy (const TableExprNode& expr,
                 const vector<Record>& recs,
                 Double expVal, const String& str)
@@ -230,6 +297,29 @@ void doInt()
          recs, stddev(vecd), "stddevInt");
   check (TableExprNode::newFunctionNode(TableExprFuncNode::grmsFUNC, expr),
          recs, rms(vecd), "rmsInt");
+  // Record fields cannot be evaluated in blocks of rows, so their
+  // aggregations cannot be merged. Use a table column instead.
+  TableExprNode recSum = TableExprNode::newFunctionNode
+    (TableExprFuncNode::gsumFUNC, expr);
+  AlwaysAssertExit (! const_cast<TableExprNodeRep*>(recSum.getNodeRep())->
+                    makeGroupAggrFunc()->canMerge());
+  Table tab = makeTable ("tExprGroup_tmp.int", veci);
+  TableExprNode colExpr = tab.col("fld");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gminFUNC,
+                                             colExpr),
+              tab.nrow(), min(vecd), "minInt");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gmaxFUNC,
+                                             colExpr),
+              tab.nrow(), max(vecd), "maxInt");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gsumFUNC,
+                                             colExpr),
+              tab.nrow(), sum(vecd), "sumInt");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gmeanFUNC,
+                                             colExpr),
+              tab.nrow(), mean(vecd), "meanInt");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gvarianceFUNC,
+                                             colExpr),
+              tab.nrow(), variance(vecd), "varianceInt");
   checkLazy (TableExprNode::newFunctionNode(TableExprFuncNode::gmedianFUNC,
                                             expr),
              recs, median(vecd), "medianInt");
@@ -269,6 +359,32 @@ void doDouble()
          recs, stddev(vecd), "stddevDouble");
   check (TableExprNode::newFunctionNode(TableExprFuncNode::grmsFUNC, expr),
          recs, rms(vecd), "rmsDouble");
+  // Record fields cannot be evaluated in blocks of rows, so their
+  // aggregations cannot be merged. Use a table column instead.
+  TableExprNode recSum = TableExprNode::newFunctionNode
+    (TableExprFuncNode::gsumFUNC, expr);
+  AlwaysAssertExit (! const_cast<TableExprNodeRep*>(recSum.getNodeRep())->
+                    makeGroupAggrFunc()->canMerge());
+  Table tab = makeTable ("tExprGroup_tmp.dbl", vecd);
+  TableExprNode colExpr = tab.col("fld");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gminFUNC,
+                                             colExpr),
+              tab.nrow(), min(vecd), "minDouble");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gmaxFUNC,
+                                             colExpr),
+              tab.nrow(), max(vecd), "maxDouble");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gsumFUNC,
+                                             colExpr),
+              tab.nrow(), sum(vecd), "sumDouble");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gmeanFUNC,
+                                             colExpr),
+              tab.nrow(), mean(vecd), "meanDouble");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gvarianceFUNC,
+                                             colExpr),
+              tab.nrow(), variance(vecd), "varianceDouble");
+  checkMerge (TableExprNode::newFunctionNode(TableExprFuncNode::gstddevFUNC,
+                                             colExpr),
+              tab.nrow(), stddev(vecd), "stddevDouble");
   checkLazy (TableExprNode::newFunctionNode(TableExprFuncNode::gmedianFUNC,
                                             expr),
              recs, median(vecd), "medianDouble");
@@ -445,6 +561,50 @@ void doDComplexArr()
 }
 
 
+// Check that a GROUPBY using multiple threads gives the same result
+// as a serial one. The table must be large enough to use multiple
+// blocks of rows per thread.
+void doGroupByAggrParallel()
+{
+  const uInt nrow = 30000;
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("key"));
+  td.addColumn (ScalarColumnDesc<Int>("ival"));
+  td.addColumn (ScalarColumnDesc<Double>("dval"));
+  SetupNewTable newtab("tExprGroup_tmp.grp", td, Table::Scratch);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> keyCol(tab, "key");
+  ScalarColumn<Int> ivalCol(tab, "ival");
+  ScalarColumn<Double> dvalCol(tab, "dval");
+  for (uInt i=0; i<nrow; ++i) {
+    keyCol.put (i, (i*7)%13);
+    ivalCol.put (i, Int(i%101) - 50);
+    dvalCol.put (i, sin(Double(i)) * 1000.);
+  }
+  String command ("select key, gmin(ival) as mini, gmax(ival) as maxi,"
+                  " gsum(ival) as sumi, gmean(dval) as meand,"
+                  " gvariance(dval) as vard, gcount() as cnt"
+                  " from $1 where ival != 3 groupby key");
+  Table serTab = tableCommand ("using style threads=1 " + command, tab).table();
+  Table parTab = tableCommand ("using style threads=4 " + command, tab).table();
+  AlwaysAssertExit (serTab.nrow() == 13  &&  parTab.nrow() == serTab.nrow());
+  const char* names[] = {"key", "mini", "maxi", "sumi", "meand", "vard",
+                         "cnt"};
+  for (uInt j=0; j<7; ++j) {
+    TableColumn serCol(serTab, names[j]);
+    TableColumn parCol(parTab, names[j]);
+    for (uInt i=0; i<serTab.nrow(); ++i) {
+      // Merging changes the summation order, so allow for rounding.
+      if (!near (parCol.asdouble(i), serCol.asdouble(i), 1.e-10)) {
+        foundError = True;
+        cout << "parallel groupby " << names[j] << " differs in row " << i
+             << ": " << parCol.asdouble(i) << ' ' << serCol.asdouble(i)
+             << endl;
+      }
+    }
+  }
+}
+
 int main()
 {
   try {
@@ -458,6 +618,8 @@ int main()
     doIntArr();
     doDoubleArr();
     doDComplexArr();
+    cout << "test parallel groupby ..." << endl;
+    doGroupByAggrParallel();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
     return 1;
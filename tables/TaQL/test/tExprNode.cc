@@ -29,6 +29,14 @@
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/RecordExpr.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
@@ -38,6 +46,7 @@
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
+#include <algorithm>
 
 #include <casacore/casa/namespace.h>
 // <summary>
@@ -1100,6 +1109,128 @@ void doIt()
   checkFailure ("min sz", min(esz1));
 }
 
+// Check that the evaluation of blocks of rows gives the same results
+// as the evaluation per row.
+void checkBlock (const String& str, const Table& tab,
+                 const TableExprNode& expr, Bool canBlock)
+{
+  cout << "checkBlock " << str << endl;
+  AlwaysAssertExit (expr.canGetBlock() == canBlock);
+  uInt nrow = tab.nrow();
+  Block<Bool> vals(nrow);
+  // Use a block size not dividing nrow to test a partial block.
+  for (uInt st=0; st<nrow; st+=1000) {
+    expr.getBoolBlock (st, std::min(1000u, nrow-st), vals.storage()+st);
+  }
+  uInt nsel = 0;
+  for (uInt i=0; i<nrow; ++i) {
+    if (vals[i] != expr.getBool(i)) {
+      foundError = True;
+      cout << str << ": block value differs in row " << i << endl;
+    }
+    if (vals[i]) {
+      nsel++;
+    }
+  }
+  if (tab(expr).nrow() != nsel) {
+    foundError = True;
+    cout << str << ": found " << tab(expr).nrow() << " rows; expected "
+         << nsel << endl;
+  }
+  // A selection using multiple threads must give the same rows.
+  if (! allEQ (tab(expr, 0, 0, 3).rowNumbers(), tab(expr).rowNumbers())) {
+    foundError = True;
+    cout << str << ": selection using 3 threads differs" << endl;
+  }
+}
+
+void doBlock()
+{
+  // Create a table with some MS-like columns.
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ANTENNA1"));
+  td.addColumn (ScalarColumnDesc<Int>("ANTENNA2"));
+  td.addColumn (ScalarColumnDesc<uShort>("SCAN"));
+  td.addColumn (ScalarColumnDesc<Double>("TIME"));
+  td.addColumn (ScalarColumnDesc<Float>("WEIGHT"));
+  td.addColumn (ScalarColumnDesc<Bool>("FLAG_ROW"));
+  td.addColumn (ScalarColumnDesc<String>("NAME"));
+  td.addColumn (ArrayColumnDesc<Double>("UVW", IPosition(1,3),
+                                        ColumnDesc::FixedShape));
+  SetupNewTable newtab("tExprNode_tmp.tab", td, Table::Scratch);
+  Table tab(newtab, 10500);
+  ScalarColumn<Int> ant1(tab, "ANTENNA1");
+  ScalarColumn<Int> ant2(tab, "ANTENNA2");
+  ScalarColumn<uShort> scan(tab, "SCAN");
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Float> weight(tab, "WEIGHT");
+  ScalarColumn<Bool> flag(tab, "FLAG_ROW");
+  ScalarColumn<String> name(tab, "NAME");
+  ArrayColumn<Double> uvw(tab, "UVW");
+  Vector<Double> uvwval(3);
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    uvwval[0] = i%11;
+    uvwval[1] = Int(i%13) - 6;
+    uvwval[2] = i%17;
+    uvw.put (i, uvwval);
+    ant1.put (i, i%7);
+    ant2.put (i, (i/7)%7);
+    scan.put (i, i/1000);
+    time.put (i, 4.5e9 + (i/49)*10.);
+    weight.put (i, (i%3)*0.5);
+    flag.put (i, i%5 == 0);
+    name.put (i, "ant" + String::toString(i%3));
+  }
+  TableExprNode a1 = tab.col("ANTENNA1");
+  TableExprNode a2 = tab.col("ANTENNA2");
+  TableExprNode tm = tab.col("TIME");
+  checkBlock ("a1!=a2 && tm>t", tab,
+              a1 != a2  &&  tm > 4.5e9+500., True);
+  checkBlock ("a1+a2*2 >= scan-1", tab,
+              a1 + a2*2 >= tab.col("SCAN") - 1, True);
+  checkBlock ("(tm-t)/10 < a1", tab,
+              (tm - 4.5e9) / 10. < a1, True);
+  checkBlock ("weight==1 || flag", tab,
+              tab.col("WEIGHT") == 1  ||  tab.col("FLAG_ROW"), True);
+  checkBlock ("!flag && rownr!=3*(a1/3)", tab,
+              !tab.col("FLAG_ROW")  &&  tab.nodeRownr() != 3*(a1/3), True);
+  checkBlock ("a1==a2 && name==ant1", tab,
+              a1 == a2  &&  tab.col("NAME") == "ant1", True);
+  checkBlock ("name==ant1 && a1==a2", tab,
+              tab.col("NAME") == "ant1"  &&  a1 == a2, False);
+  checkBlock ("a1<3 || name!=ant1", tab,
+              a1 < 3  ||  tab.col("NAME") != "ant1", True);
+  // Expressions as generated by MSSelection.
+  Vector<Int> ids(3);
+  ids[0] = 5; ids[1] = 1; ids[2] = 3;
+  checkBlock ("a1 in [5,1,3] || a2 in [5,1,3]", tab,
+              a1.in(ids)  ||  a2.in(ids), True);
+  Vector<Int> rows(2);
+  rows[0] = 10; rows[1] = 100000000;     // too sparse for a bitmap
+  checkBlock ("rownr in [10,1e8]", tab, tab.nodeRownr().in(rows), True);
+  checkBlock ("a1 in ids+a2", tab, a1.in(ids + a2), False);
+  Vector<Int> bl1(4), bl2(4);
+  bl1[0] = 0; bl1[1] = 1; bl1[2] = 4; bl1[3] = 6;
+  bl2[0] = 1; bl2[1] = 1; bl2[2] = 2; bl2[3] = 3;
+  TableExprNode blnode = any(a1 == bl1  &&  a2 == bl2);
+  checkBlock ("any(a1==bl1 && a2==bl2)", tab, blnode, True);
+  checkBlock ("!any(a1==bl1 && a2==bl2)", tab, !blnode, True);
+  checkBlock ("any(a1==bl1 || a2==bl2)", tab,
+              any(a1 == bl1  ||  a2 == bl2), False);
+  checkBlock ("abs(tm-t) <= dt", tab, abs(tm - (4.5e9+100.)) <= 20., True);
+  checkBlock ("abs(a1-3) < 2", tab, abs(a1-3) < 2, True);
+  TableExprNode uvwnode = tab.col("UVW");
+  TableExprNode uvdist = square(uvwnode(TableExprNodeSet(IPosition(1,0)))) +
+                         square(uvwnode(TableExprNodeSet(IPosition(1,1))));
+  checkBlock ("uvdist in range", tab, uvdist >= 25.  &&  uvdist <= 100.,
+              True);
+  checkBlock ("sqrt(uvdist) > 8", tab, sqrt(uvdist) > 8., True);
+  checkBlock ("uvw[0:1] sum", tab,
+              sum(uvwnode(TableExprNodeSet(Slicer(IPosition(1,0),
+                                                  IPosition(1,2))))) > 6.,
+              False);
+}
+
 void doShow()
 {
   // Make some expressions where constants should have been pre-evaluated.
@@ -1115,6 +1246,7 @@ int main()
 {
   try {
     doIt();
+    doBlock();
     doShow();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
@@ -0,0 +1,191 @@
+//# tTaQLStatement.cc: Test program for prepared TaQL statements
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/TaQL/TaQLStatement.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+// <summary>
+// Test program for class TaQLStatement.
+// </summary>
+
+
+Table makeTable()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ab"));
+  td.addColumn (ScalarColumnDesc<Double> ("ac"));
+  td.addColumn (ScalarColumnDesc<String> ("af"));
+  SetupNewTable newtab("tTaQLStatement_tmp.tab", td, Table::New);
+  Table tab(newtab, 10);
+  ScalarColumn<Int> ab(tab, "ab");
+  ScalarColumn<Double> ac(tab, "ac");
+  ScalarColumn<String> af(tab, "af");
+  for (uInt i=0; i<10; ++i) {
+    ab.put (i, i%4);
+    ac.put (i, i);
+    af.put (i, "V" + String::toString(i%3));
+  }
+  return tab;
+}
+
+void testSelect (const Table& tab)
+{
+  TaQLStatement::clearCache();
+  Bool failed;
+  TaQLStatement stmt("select from $1 where ab==$1");
+  AlwaysAssertExit (TaQLStatement::nCacheMisses() == 1);
+  AlwaysAssertExit (TaQLStatement::cacheSize() == 1);
+  stmt.bindTable (1, tab);
+  for (Int i=0; i<5; ++i) {
+    stmt.bind (1, i);
+    Table sel = stmt.execute().table();
+    AlwaysAssertExit (sel.nrow() == (i<2 ? 3u : i<4 ? 2u : 0u));
+    Vector<uInt> rows = sel.rowNumbers(tab);
+    for (uInt j=0; j<rows.size(); ++j) {
+      AlwaysAssertExit (Int(rows[j]%4) == i);
+    }
+  }
+  // Preparing it again uses the cached tree.
+  TaQLStatement stmt2("select from $1 where ab==$1");
+  AlwaysAssertExit (TaQLStatement::nCacheHits() == 1);
+  AlwaysAssertExit (TaQLStatement::cacheSize() == 1);
+  // It has no bindings, so it fails.
+  failed = False;
+  try {
+    stmt2.execute();
+  } catch (const std::exception&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  stmt2 = stmt;
+  AlwaysAssertExit (stmt2.execute().table().nrow() == 0);
+  // Two parameters of different types and a selected column.
+  TaQLStatement stmt3("select ac from $1 where ac>=$1 && af==$2");
+  stmt3.bindTable (1, tab);
+  stmt3.bind (1, 2.5);
+  stmt3.bind (2, "V1");
+  Vector<String> colNames;
+  String type;
+  Table sel = stmt3.execute(colNames, type).table();
+  AlwaysAssertExit (type == "select");
+  AlwaysAssertExit (colNames.size() == 1  &&  colNames[0] == "ac");
+  AlwaysAssertExit (sel.nrow() == 2);      // rows 4 and 7
+  // An array parameter.
+  TaQLStatement stmt4("select from $1 where ab in $1");
+  stmt4.bindTable (1, tab);
+  Vector<Int> vals(2);
+  vals[0] = 1;
+  vals[1] = 3;
+  stmt4.bind (1, vals);
+  AlwaysAssertExit (stmt4.execute().table().nrow() == 5);
+  // Values must be constants.
+  failed = False;
+  try {
+    stmt4.bind (1, tab.col("ab"));
+  } catch (const std::exception&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  AlwaysAssertExit (TaQLStatement::cacheSize() == 3);
+}
+
+void testCalc()
+{
+  TaQLStatement stmt("calc $1 + $2");
+  stmt.bind (1, 3);
+  stmt.bind (2, 4.5);
+  TableExprNode node = stmt.execute().node();
+  AlwaysAssertExit (node.getDouble(0) == 7.5);
+  stmt.bind (2, -3);
+  AlwaysAssertExit (stmt.execute().node().getInt(0) == 0);
+  // Parameter numbers start at 1.
+  Bool failed = False;
+  try {
+    stmt.bind (0, 1);
+  } catch (const std::exception&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  stmt.clearBindings();
+  failed = False;
+  try {
+    stmt.execute();
+  } catch (const std::exception&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  // A subtable cannot be used as a parameter.
+  failed = False;
+  try {
+    TaQLStatement stmt1("calc $1::SUB + 1");
+  } catch (const std::exception&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+void testCache()
+{
+  TaQLStatement::setCacheSize (2);
+  AlwaysAssertExit (TaQLStatement::cacheSize() == 2);
+  TaQLStatement stmt("calc $1*2");
+  AlwaysAssertExit (TaQLStatement::cacheSize() == 2);
+  TaQLStatement::setCacheSize (0);
+  AlwaysAssertExit (TaQLStatement::cacheSize() == 0);
+  // The statement keeps its parse tree.
+  stmt.bind (1, 21);
+  AlwaysAssertExit (stmt.execute().node().getInt(0) == 42);
+  TaQLStatement::setCacheSize (256);
+  TaQLStatement::clearCache();
+  AlwaysAssertExit (TaQLStatement::nCacheHits() == 0);
+}
+
+int main()
+{
+  try {
+    Table tab = makeTable();
+    testSelect (tab);
+    testCalc();
+    testCache();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  } catch (...) {
+    cout << "Unexpected unknown exception" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -43,6 +43,8 @@
 #include <casacore/tables/Tables/SetupNewTab.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/FlagColumn.h>
+#include <casacore/tables/Tables/ArrowTable.h>
 #include <casacore/tables/Tables/TableRow.h>
 #include <casacore/tables/Tables/TableCopy.h>
 #include <casacore/casa/Arrays/Array.h>
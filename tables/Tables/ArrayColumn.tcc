@@ -165,7 +165,7 @@ void ArrayColumn<T>::checkShape (const IPosition& shp,
 }
 
 template<class T>
-Array<T> ArrayColumn<T>::operator() (uInt rownr) const
+Array<T> ArrayColumn<T>::operator() (rownr_t rownr) const
 {
     Array<T> arr;
     get (rownr, arr);
@@ -173,7 +173,7 @@ Array<T> ArrayColumn<T>::operator() (uInt rownr) const
 }
 
 template<class T>
-Array<T> ArrayColumn<T>::get (uInt rownr) const
+Array<T> ArrayColumn<T>::get (rownr_t rownr) const
 {
     Array<T> arr;
     get (rownr, arr);
@@ -181,7 +181,7 @@ Array<T> ArrayColumn<T>::get (uInt rownr) const
 }
 
 template<class T>
-void ArrayColumn<T>::get (uInt rownr, Array<T>& arr, Bool resize) const
+void ArrayColumn<T>::get (rownr_t rownr, Array<T>& arr, Bool resize) const
 {
     TABLECOLUMNCHECKROW(rownr);
     // Check array conformance and resize if needed and possible.
@@ -191,7 +191,7 @@ void ArrayColumn<T>::get (uInt rownr, Array<T>& arr, Bool resize) const
 
 
 template<class T>
-Array<T> ArrayColumn<T>::getSlice (uInt rownr,
+Array<T> ArrayColumn<T>::getSlice (rownr_t rownr,
                                    const Slicer& arraySection) const
 {
     Array<T> arr;
@@ -200,7 +200,7 @@ Array<T> ArrayColumn<T>::getSlice (uInt rownr,
 }
 
 template<class T>
-void ArrayColumn<T>::getSlice (uInt rownr, const Slicer& arraySection,
+void ArrayColumn<T>::getSlice (rownr_t rownr, const Slicer& arraySection,
                                Array<T>& arr, Bool resize) const
                                {
     TABLECOLUMNCHECKROW(rownr);
@@ -239,7 +239,7 @@ void ArrayColumn<T>::getSlice (uInt rownr, const Slicer& arraySection,
 
 template<class T>
 Array<T> ArrayColumn<T>::getSlice
-(uInt rownr, const Vector<Vector<Slice> >& arraySlices) const
+(rownr_t rownr, const Vector<Vector<Slice> >& arraySlices) const
 {
     Array<T> arr;
     getSlice (rownr, arraySlices, arr);
@@ -247,7 +247,7 @@ Array<T> ArrayColumn<T>::getSlice
 }
 
 template<class T>
-void ArrayColumn<T>::getSlice (uInt rownr,
+void ArrayColumn<T>::getSlice (rownr_t rownr,
                                const Vector<Vector<Slice> >& arraySlices,
                                Array<T>& arr, Bool resize) const
 {
@@ -305,9 +305,9 @@ ArrayColumn<T>::getColumnCells (const RefRows & rows,
    }
 
    uInt nSlicers = dataSlicers.size();
-   uInt nRows = rows.nrows();
+   rownr_t nRows = rows.nrows();
 
-   for (uInt i = 0; i < nRows; i++){
+   for (rownr_t i = 0; i < nRows; i++){
 
        // Create a section of the destination array that will hold the
        // data for this row ([s1, ...,sN, nR] --> [s1,...,sN].
@@ -417,7 +417,7 @@ Array<T> ArrayColumn<T>::getColumn() const
 template<class T>
 void ArrayColumn<T>::getColumn (Array<T>& arr, Bool resize) const
 {
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     //# Take shape of array in first row.
     IPosition shp;
     if (nrrow > 0) {
@@ -439,7 +439,7 @@ void ArrayColumn<T>::getColumn (Array<T>& arr, Bool resize) const
 	baseColPtr_p->getArrayColumn (&arr);
       }else{
         ArrayIterator<T> iter(arr, arr.ndim()-1);
-        for (uInt rownr=0; rownr<nrrow; rownr++) {
+        for (rownr_t rownr=0; rownr<nrrow; rownr++) {
           Array<T>& darr = iter.array();
           if (! darr.shape().isEqual (baseColPtr_p->shape (rownr))) {
             throw TableArrayConformanceError
@@ -467,7 +467,7 @@ template<class T>
 void ArrayColumn<T>::getColumn (const Slicer& arraySection,
                                 Array<T>& arr, Bool resize) const
 {
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     //# Use shape of array in first row.
     IPosition shp, blc,trc,inc;
     if (nrrow > 0) {
@@ -490,7 +490,7 @@ void ArrayColumn<T>::getColumn (const Slicer& arraySection,
         baseColPtr_p->getColumnSlice (defSlicer, &arr);
       }else{
         ArrayIterator<T> iter(arr, arr.ndim()-1);
-        for (uInt rownr=0; rownr<nrrow; rownr++) {
+        for (rownr_t rownr=0; rownr<nrrow; rownr++) {
           getSlice (rownr, defSlicer, iter.array());
           iter.next();
         }
@@ -512,7 +512,7 @@ template<class T>
 void ArrayColumn<T>::getColumn (const Vector<Vector<Slice> >& arraySlices,
                                 Array<T>& arr, Bool resize) const
 {
-  uInt nrrow = nrow();
+  rownr_t nrrow = nrow();
   // Get total shape.
   // Use shape of first row (if there) as overall array shape.
   IPosition colShp;
@@ -546,7 +546,7 @@ template<class T>
 void ArrayColumn<T>::getColumnRange (const Slicer& rowRange,
                                      Array<T>& arr, Bool resize) const
 {
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     IPosition shp, blc, trc, inc;
     shp = rowRange.inferShapeFromSource (IPosition(1,nrrow), blc, trc, inc);
     //# If the entire column is accessed, use that function.
@@ -569,7 +569,7 @@ template<class T>
 void ArrayColumn<T>::getColumnCells (const RefRows& rownrs,
                                      Array<T>& arr, Bool resize) const
 {
-    uInt nrrow = rownrs.nrow();
+    rownr_t nrrow = rownrs.nrow();
      //# Take shape of array in first row.
     IPosition arrshp;
     if (nrrow > 0) {
@@ -597,7 +597,7 @@ void ArrayColumn<T>::getColumnRange (const Slicer& rowRange,
                                      const Slicer& arraySection,
                                      Array<T>& arr, Bool resize) const
 {
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     IPosition shp, blc, trc, inc;
     shp = rowRange.inferShapeFromSource (IPosition(1,nrrow), blc, trc, inc);
     //# If the entire column is accessed, use that function.
@@ -623,7 +623,7 @@ void ArrayColumn<T>::getColumnCells (const RefRows& rownrs,
                                      const Slicer& arraySection,
                                      Array<T>& arr, Bool resize) const
 {
-    uInt nrrow = rownrs.nrow();
+    rownr_t nrrow = rownrs.nrow();
     IPosition arrshp, arrblc, arrtrc, arrinc;
     if (nrrow > 0) {
 	arrshp = arraySection.inferShapeFromSource (shape(rownrs.firstRow()),
@@ -648,7 +648,7 @@ void ArrayColumn<T>::getColumnCells (const RefRows& rownrs,
         ArrayIterator<T> iter(arr, arr.ndim()-1);
         RefRowsSliceIter rowsIter(rownrs);
         while (! rowsIter.pastEnd()) {
-          uInt rownr = rowsIter.sliceStart();
+          rownr_t rownr = rowsIter.sliceStart();
           uInt end   = rowsIter.sliceEnd();
           uInt incr  = rowsIter.sliceIncr();
           while (rownr <= end) {
@@ -664,7 +664,7 @@ void ArrayColumn<T>::getColumnCells (const RefRows& rownrs,
 
 
 template<class T>
-void ArrayColumn<T>::setShape (uInt rownr, const IPosition& shape)
+void ArrayColumn<T>::setShape (rownr_t rownr, const IPosition& shape)
 {
     checkWritable();
     TABLECOLUMNCHECKROW(rownr); 
@@ -683,7 +683,7 @@ void ArrayColumn<T>::setShape (uInt rownr, const IPosition& shape)
 }
 	
 template<class T>
-void ArrayColumn<T>::setShape (uInt rownr, const IPosition& shape,
+void ArrayColumn<T>::setShape (rownr_t rownr, const IPosition& shape,
 			       const IPosition& tileShape)
 {
     checkWritable();
@@ -703,7 +703,7 @@ void ArrayColumn<T>::setShape (uInt rownr, const IPosition& shape,
 }
 	
 template<class T>
-void ArrayColumn<T>::put (uInt rownr, const Array<T>& arr)
+void ArrayColumn<T>::put (rownr_t rownr, const Array<T>& arr)
 {
     checkWritable();
     TABLECOLUMNCHECKROW(rownr); 
@@ -725,7 +725,7 @@ void ArrayColumn<T>::put (uInt rownr, const Array<T>& arr)
 }
 
 template<class T>
-void ArrayColumn<T>::putSlice (uInt rownr, const Slicer& arraySection,
+void ArrayColumn<T>::putSlice (rownr_t rownr, const Slicer& arraySection,
 			       const Array<T>& arr)
 {
     checkWritable();
@@ -756,7 +756,7 @@ void ArrayColumn<T>::putSlice (uInt rownr, const Slicer& arraySection,
 }
 
 template<class T>
-void ArrayColumn<T>::putSlice (uInt rownr,
+void ArrayColumn<T>::putSlice (rownr_t rownr,
                                const Vector<Vector<Slice> >& arraySlices,
 			       const Array<T>& arr)
 {
@@ -863,9 +863,9 @@ ArrayColumn<T>::putColumnCells (const RefRows& rows,
    }
 
    uInt nSlicers = bufferSlicers.size();
-   uInt nRows = rows.nrows();
+   rownr_t nRows = rows.nrows();
 
-   for (uInt i = 0; i < nRows; i++){
+   for (rownr_t i = 0; i < nRows; i++){
 
        // Create a section of the source array that will hold the
        // data for this row ([s1, ...,sN, nR] --> [s1,...,sN].
@@ -885,8 +885,8 @@ ArrayColumn<T>::putColumnCells (const RefRows& rows,
 
 
 template<class T>
-void ArrayColumn<T>::put (uInt thisRownr, const TableColumn& that,
-			  uInt thatRownr, Bool preserveTileShape)
+void ArrayColumn<T>::put (rownr_t thisRownr, const TableColumn& that,
+			  rownr_t thatRownr, Bool preserveTileShape)
 {
   TableColumn::put (thisRownr, that, thatRownr, preserveTileShape);
 }
@@ -896,7 +896,7 @@ void ArrayColumn<T>::putColumn (const Array<T>& arr)
 {
     checkWritable();
     //# First check if number of rows matches.
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     IPosition shp  = arr.shape();
     uInt last = shp.nelements() - 1;
     if (shp(last) != Int(nrrow)) {
@@ -916,7 +916,7 @@ void ArrayColumn<T>::putColumn (const Array<T>& arr)
 	}
     }else{
 	//# Otherwise set the shape of each cell (as far as needed).
-	for (uInt i=0; i<nrrow; i++) {
+	for (rownr_t i=0; i<nrrow; i++) {
 	    setShape (i, shp);
 	}
     }
@@ -932,7 +932,7 @@ void ArrayColumn<T>::putColumn (const Array<T>& arr)
     }else{
         if (arr.nelements() > 0) {
 	    ReadOnlyArrayIterator<T> iter(arr, arr.ndim()-1);
-	    for (uInt rownr=0; rownr<nrrow; rownr++) {
+	    for (rownr_t rownr=0; rownr<nrrow; rownr++) {
 	        baseColPtr_p->put (rownr, &(iter.array()));
 		iter.next();
 	    }
@@ -944,7 +944,7 @@ template<class T>
 void ArrayColumn<T>::putColumn (const Slicer& arraySection, const Array<T>& arr)
 {
     checkWritable();
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     //# First check if number of rows matches.
     IPosition arrshp = arr.shape();
     uInt last = arrshp.nelements() - 1;
@@ -979,7 +979,7 @@ void ArrayColumn<T>::putColumn (const Slicer& arraySection, const Array<T>& arr)
     }else{
         if (arr.nelements() > 0) {
 	    ReadOnlyArrayIterator<T> iter(arr, arr.ndim()-1);
-	    for (uInt rownr=0; rownr<nrrow; rownr++) {
+	    for (rownr_t rownr=0; rownr<nrrow; rownr++) {
 	        putSlice (rownr, arraySection, iter.array());
 		iter.next();
 	    }
@@ -992,7 +992,7 @@ void ArrayColumn<T>::putColumn (const Vector<Vector<Slice> >& arraySlices,
                                 const Array<T>& arr)
 {
   checkWritable();
-  uInt nrrow = nrow();
+  rownr_t nrrow = nrow();
   // Get total shape.
   // Use shape of first row (if there) as overall array shape.
   IPosition colShp;
@@ -1022,7 +1022,7 @@ template<class T>
 void ArrayColumn<T>::putColumnRange (const Slicer& rowRange,
 				     const Array<T>& arr)
 {
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     IPosition shp, blc, trc, inc;
     shp = rowRange.inferShapeFromSource (IPosition(1,nrrow), blc, trc, inc);
     //# If the entire column is accessed, use that function.
@@ -1039,7 +1039,7 @@ void ArrayColumn<T>::putColumnCells (const RefRows& rownrs,
 {
     checkWritable();
     //# First check if number of rows matches.
-    uInt nrrow = rownrs.nrow();
+    rownr_t nrrow = rownrs.nrow();
     IPosition arrshp  = arr.shape();
     uInt last = arrshp.nelements() - 1;
     if (arrshp(last) != Int(nrrow)) {
@@ -1061,7 +1061,7 @@ void ArrayColumn<T>::putColumnCells (const RefRows& rownrs,
 	//# Otherwise set the shape of each cell (as far as needed).
         RefRowsSliceIter iter(rownrs);
         while (! iter.pastEnd()) {
-            uInt rownr = iter.sliceStart();
+            rownr_t rownr = iter.sliceStart();
             uInt end = iter.sliceEnd();
             uInt incr = iter.sliceIncr();
             while (rownr <= end) {
@@ -1080,7 +1080,7 @@ void ArrayColumn<T>::putColumnRange (const Slicer& rowRange,
 				     const Slicer& arraySection,
 				     const Array<T>& arr)
 {
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     IPosition shp, blc, trc, inc;
     shp = rowRange.inferShapeFromSource (IPosition(1,nrrow), blc, trc, inc);
     //# If the entire column is accessed, use that function.
@@ -1098,7 +1098,7 @@ void ArrayColumn<T>::putColumnCells (const RefRows& rownrs,
 {
     checkWritable();
     //# First check if number of rows matches.
-    uInt nrrow = rownrs.nrow();
+    rownr_t nrrow = rownrs.nrow();
     IPosition arrshp = arr.shape();
     uInt last = arrshp.nelements() - 1;
     if (arrshp(last) != Int(nrrow)) {
@@ -1132,8 +1132,8 @@ void ArrayColumn<T>::putColumnCells (const RefRows& rownrs,
 template<class T>
 void ArrayColumn<T>::fillColumn (const Array<T>& value)
 {
-    uInt nrrow = nrow();
-    for (uInt i=0; i<nrrow; i++) {
+    rownr_t nrrow = nrow();
+    for (rownr_t i=0; i<nrrow; i++) {
 	put (i, value);
     }
 }
@@ -1143,13 +1143,13 @@ void ArrayColumn<T>::putColumn (const ArrayColumn<T>& that)
 {
     checkWritable();
     //# Check the column lengths.
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     if (nrrow != that.nrow()) {
       throw (TableConformanceError
              ("Nr of rows differ in ArrayColumn::putColumn for column " +
               baseColPtr_p->columnDesc().name()));
     }
-    for (uInt i=0; i<nrrow; i++) {
+    for (rownr_t i=0; i<nrrow; i++) {
 	put (i, that, i);
     }
 }
@@ -0,0 +1,1290 @@
+//# ArrowTable.cc: Columnar export and import of tables in Arrow IPC format
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables/ArrowTable.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/IO/MMapIO.h>
+#include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/OS/Conversion.h>
+#include <casacore/casa/Utilities/Regex.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/string.h>
+#include <functional>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The Arrow IPC format consists of messages (the schema and the record
+//# batches) and a footer. Their metadata are FlatBuffers (see the
+//# Schema.fbs, Message.fbs and File.fbs files of the Arrow project).
+//# The numbers below are the ids of the FlatBuffer table fields and
+//# the values of the enums used.
+enum ArrowTypeId {
+  ArrowNull=1, ArrowInt=2, ArrowFloatingPoint=3, ArrowBinary=4,
+  ArrowUtf8=5, ArrowBool=6, ArrowDecimal=7, ArrowDate=8, ArrowTime=9,
+  ArrowTimestamp=10, ArrowInterval=11, ArrowList=12, ArrowStruct=13,
+  ArrowUnion=14, ArrowFixedSizeBinary=15, ArrowFixedSizeList=16,
+  ArrowMap=17, ArrowDuration=18, ArrowLargeBinary=19, ArrowLargeUtf8=20,
+  ArrowLargeList=21
+};
+enum ArrowHeaderId {ArrowSchemaHeader=1, ArrowRecordBatchHeader=3};
+static const Int   theArrowVersion = 4;         //# MetadataVersion V5
+static const char  theArrowMagic[8] = {'A','R','R','O','W','1',0,0};
+static const Int64 theArrowAlign = 64;          //# alignment of buffers
+
+
+//# Write little-endian values into a buffer.
+static void arrowPut (std::vector<char>& buf, uInt64 value, uInt size)
+{
+  for (uInt i=0; i<size; i++) {
+    buf.push_back (char(value & 255));
+    value >>= 8;
+  }
+}
+
+//# Read little-endian values from a buffer.
+static uInt64 arrowGet (const char* data, uInt size)
+{
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+  uInt64 value = 0;
+  for (uInt i=size; i>0; i--) {
+    value = (value << 8) | p[i-1];
+  }
+  return value;
+}
+
+static Int64 arrowPadded (Int64 length)
+{
+  return (length + theArrowAlign - 1) / theArrowAlign * theArrowAlign;
+}
+
+
+// Helper class to build a FlatBuffer.
+// Contrary to the FlatBuffers library the buffer is built front to back;
+// a table is followed by the objects it refers to, so all references
+// are positive as required.
+class ArrowFBBuilder
+{
+public:
+  // A function writing an object and returning its position.
+  typedef std::function<uInt(ArrowFBBuilder&)> Writer;
+
+  // A field in a table: a scalar or a reference to another object.
+  struct Field {
+    Field (uInt id, uInt size, uInt64 value)
+      : id_p(id), size_p(size), value_p(value) {}
+    Field (uInt id, const Writer& writer)
+      : id_p(id), size_p(4), value_p(0), writer_p(writer) {}
+    uInt   id_p;
+    uInt   size_p;
+    uInt64 value_p;
+    Writer writer_p;
+  };
+
+  ArrowFBBuilder()
+    { arrowPut (buf_p, 0, 4); }        //# reserve the root offset
+
+  // Finish the buffer given the root table writer and pad to 8 bytes.
+  const std::vector<char>& finish (const Writer& root)
+  {
+    patch (0, root(*this));
+    align (8);
+    return buf_p;
+  }
+
+  uInt align (uInt n)
+  {
+    while (buf_p.size() % n != 0) {
+      buf_p.push_back (0);
+    }
+    return buf_p.size();
+  }
+
+  // Let the reference at the given position refer to the object.
+  void patch (uInt at, uInt object)
+  {
+    uInt value = object - at;
+    for (uInt i=0; i<4; i++) {
+      buf_p[at+i] = char(value & 255);
+      value >>= 8;
+    }
+  }
+
+  // Write a table with the given fields.
+  uInt table (const std::vector<Field>& fields)
+  {
+    // Determine the layout; place the largest fields first.
+    uInt nid = 0;
+    for (uInt i=0; i<fields.size(); i++) {
+      nid = std::max (nid, fields[i].id_p + 1);
+    }
+    std::vector<uInt> offsets(fields.size());
+    uInt tableSize = 4;
+    for (uInt size=8; size>0; size/=2) {
+      for (uInt i=0; i<fields.size(); i++) {
+        if (fields[i].size_p == size) {
+          tableSize = (tableSize + size - 1) / size * size;
+          offsets[i] = tableSize;
+          tableSize += size;
+        }
+      }
+    }
+    // Write the vtable followed by the table.
+    uInt vtable = align (2);
+    arrowPut (buf_p, 4 + 2*nid, 2);
+    arrowPut (buf_p, tableSize, 2);
+    std::vector<uInt> vtOffsets(nid, 0);
+    for (uInt i=0; i<fields.size(); i++) {
+      vtOffsets[fields[i].id_p] = offsets[i];
+    }
+    for (uInt i=0; i<nid; i++) {
+      arrowPut (buf_p, vtOffsets[i], 2);
+    }
+    uInt tab = align (8);
+    arrowPut (buf_p, tab - vtable, 4);
+    buf_p.resize (tab + tableSize, 0);
+    for (uInt i=0; i<fields.size(); i++) {
+      uInt64 value = fields[i].value_p;
+      for (uInt j=0; j<fields[i].size_p; j++) {
+        buf_p[tab + offsets[i] + j] = char(value & 255);
+        value >>= 8;
+      }
+    }
+    // Write the objects referred to.
+    for (uInt i=0; i<fields.size(); i++) {
+      if (fields[i].writer_p) {
+        patch (tab + offsets[i], fields[i].writer_p(*this));
+      }
+    }
+    return tab;
+  }
+
+  uInt string (const String& str)
+  {
+    uInt pos = align (4);
+    arrowPut (buf_p, str.size(), 4);
+    buf_p.insert (buf_p.end(), str.begin(), str.end());
+    buf_p.push_back (0);
+    return pos;
+  }
+
+  // Write a vector of references to objects.
+  uInt vector (const std::vector<Writer>& writers)
+  {
+    uInt pos = align (4);
+    arrowPut (buf_p, writers.size(), 4);
+    buf_p.resize (pos + 4 + 4*writers.size(), 0);
+    for (uInt i=0; i<writers.size(); i++) {
+      patch (pos + 4 + 4*i, writers[i](*this));
+    }
+    return pos;
+  }
+
+  // Write a vector of structs (consisting of 8-byte values).
+  // The given values are the concatenated struct values.
+  uInt structVector (const std::vector<Int64>& values, uInt structSize)
+  {
+    // The elements have to be aligned on 8 bytes.
+    align (8);
+    arrowPut (buf_p, 0, 4);
+    uInt pos = buf_p.size();
+    arrowPut (buf_p, values.size() * 8 / structSize, 4);
+    for (uInt i=0; i<values.size(); i++) {
+      arrowPut (buf_p, values[i], 8);
+    }
+    return pos;
+  }
+
+private:
+  std::vector<char> buf_p;
+};
+
+
+// Helper class to read a FlatBuffer.
+class ArrowFBReader
+{
+public:
+  ArrowFBReader (const char* data, Int64 size)
+    : data_p (data), size_p (size) {}
+
+  uInt root() const
+    { return get (0, 4); }
+
+  // Get the position of a field in a table (0 if not present).
+  uInt field (uInt table, uInt id) const
+  {
+    uInt vtable = table - Int(get (table, 4));
+    uInt vtSize = get (vtable, 2);
+    if (4 + 2*id >= vtSize) {
+      return 0;
+    }
+    uInt offset = get (vtable + 4 + 2*id, 2);
+    return (offset == 0  ?  0 : table + offset);
+  }
+
+  uInt64 scalar (uInt table, uInt id, uInt size, uInt64 defaultValue) const
+  {
+    uInt pos = field (table, id);
+    return (pos == 0  ?  defaultValue : get (pos, size));
+  }
+
+  // Get the position of the object a field refers to (0 if absent).
+  uInt ref (uInt table, uInt id) const
+  {
+    uInt pos = field (table, id);
+    return (pos == 0  ?  0 : pos + get (pos, 4));
+  }
+
+  String string (uInt table, uInt id) const
+  {
+    uInt pos = ref (table, id);
+    if (pos == 0) {
+      return String();
+    }
+    uInt length = get (pos, 4);
+    check (pos + 4, length);
+    return String (data_p + pos + 4, length);
+  }
+
+  // Get the position of the first element of a vector and its length.
+  uInt vector (uInt table, uInt id, uInt& length) const
+  {
+    uInt pos = ref (table, id);
+    length = 0;
+    if (pos == 0) {
+      return 0;
+    }
+    length = get (pos, 4);
+    return pos + 4;
+  }
+
+  // Get the object an element in a vector of references refers to.
+  uInt element (uInt vector, uInt index) const
+  {
+    uInt pos = vector + 4*index;
+    return pos + get (pos, 4);
+  }
+
+  uInt64 get (uInt pos, uInt size) const
+  {
+    check (pos, size);
+    return arrowGet (data_p + pos, size);
+  }
+
+private:
+  void check (uInt pos, uInt size) const
+  {
+    if (Int64(pos) + size > size_p) {
+      throw TableError ("ArrowTableReader: invalid metadata in file");
+    }
+  }
+
+  const char* data_p;
+  Int64       size_p;
+};
+
+
+
+//# Describe a column to write.
+struct ArrowWriteColumn {
+  String    name;
+  DataType  dtype;
+  IPosition shape;
+  uInt      nelem;
+  Bool      isComplex;
+  // The strings of the current batch.
+  Array<String> strings;
+  std::vector<Int> stringOffsets;
+};
+
+//# Get the Arrow type of a (non-complex) data type.
+static ArrowFBBuilder::Writer arrowTypeWriter (DataType dtype, uInt& typeId)
+{
+  typedef ArrowFBBuilder::Field Field;
+  std::vector<Field> fields;
+  switch (dtype) {
+  case TpBool:
+    typeId = ArrowBool;
+    break;
+  case TpString:
+    typeId = ArrowUtf8;
+    break;
+  case TpFloat:
+  case TpComplex:
+    typeId = ArrowFloatingPoint;
+    fields.push_back (Field(0, 2, 1));
+    break;
+  case TpDouble:
+  case TpDComplex:
+    typeId = ArrowFloatingPoint;
+    fields.push_back (Field(0, 2, 2));
+    break;
+  default:
+    {
+      typeId = ArrowInt;
+      uInt nbits = 8 * ValType::getTypeSize (dtype);
+      Bool isSigned = (dtype == TpShort  ||  dtype == TpInt);
+      fields.push_back (Field(0, 4, nbits));
+      fields.push_back (Field(1, 1, isSigned));
+    }
+    break;
+  }
+  return [fields](ArrowFBBuilder& fb) { return fb.table (fields); };
+}
+
+static ArrowFBBuilder::Writer arrowKeyValue (const String& key,
+                                             const String& value)
+{
+  typedef ArrowFBBuilder::Field Field;
+  std::vector<Field> fields;
+  fields.push_back (Field(0, [key](ArrowFBBuilder& fb)
+                                 { return fb.string(key); }));
+  fields.push_back (Field(1, [value](ArrowFBBuilder& fb)
+                                 { return fb.string(value); }));
+  return [fields](ArrowFBBuilder& fb) { return fb.table (fields); };
+}
+
+//# Make the writer of a Field in the schema.
+static ArrowFBBuilder::Writer arrowField (const ArrowWriteColumn& col)
+{
+  typedef ArrowFBBuilder::Field Field;
+  typedef ArrowFBBuilder::Writer Writer;
+  uInt typeId;
+  Writer typeWriter = arrowTypeWriter (col.dtype, typeId);
+  std::vector<Field> fields;
+  String name(col.name);
+  fields.push_back (Field(0, [name](ArrowFBBuilder& fb)
+                                 { return fb.string(name); }));
+  fields.push_back (Field(1, 1, 0));
+  uInt listSize = col.nelem * (col.isComplex ? 2:1);
+  if (col.shape.empty()  &&  !col.isComplex) {
+    fields.push_back (Field(2, 1, typeId));
+    fields.push_back (Field(3, typeWriter));
+  } else {
+    // A fixed size list of the values.
+    std::vector<Field> listFields(1, Field(0, 4, listSize));
+    fields.push_back (Field(2, 1, ArrowFixedSizeList));
+    fields.push_back (Field(3, [listFields](ArrowFBBuilder& fb)
+                                 { return fb.table(listFields); }));
+    std::vector<Field> childFields;
+    childFields.push_back (Field(0, [](ArrowFBBuilder& fb)
+                                      { return fb.string("item"); }));
+    childFields.push_back (Field(1, 1, 0));
+    childFields.push_back (Field(2, 1, typeId));
+    childFields.push_back (Field(3, typeWriter));
+    childFields.push_back (Field(5, [](ArrowFBBuilder& fb)
+                                      { return fb.vector
+                                          (std::vector<Writer>()); }));
+    std::vector<Writer> children(1, [childFields](ArrowFBBuilder& fb)
+                                        { return fb.table(childFields); });
+    fields.push_back (Field(5, [children](ArrowFBBuilder& fb)
+                                 { return fb.vector(children); }));
+    std::vector<Writer> keyValues;
+    if (! col.shape.empty()) {
+      keyValues.push_back (arrowKeyValue ("casacore.shape",
+                                          col.shape.toString()));
+    }
+    if (col.isComplex) {
+      keyValues.push_back (arrowKeyValue ("casacore.type",
+                                          col.dtype == TpComplex  ?
+                                          "Complex" : "DComplex"));
+    }
+    fields.push_back (Field(6, [keyValues](ArrowFBBuilder& fb)
+                                 { return fb.vector(keyValues); }));
+  }
+  if (fields.size() == 4) {
+    fields.push_back (Field(5, [](ArrowFBBuilder& fb)
+                                 { return fb.vector
+                                     (std::vector<Writer>()); }));
+  }
+  return [fields](ArrowFBBuilder& fb) { return fb.table (fields); };
+}
+
+static ArrowFBBuilder::Writer arrowSchema
+                         (const std::vector<ArrowWriteColumn>& columns)
+{
+  typedef ArrowFBBuilder::Field Field;
+  typedef ArrowFBBuilder::Writer Writer;
+  std::vector<Writer> fieldWriters;
+  for (uInt i=0; i<columns.size(); i++) {
+    fieldWriters.push_back (arrowField (columns[i]));
+  }
+  std::vector<Field> fields;
+  fields.push_back (Field(0, 2, 0));                 //# little endian
+  fields.push_back (Field(1, [fieldWriters](ArrowFBBuilder& fb)
+                               { return fb.vector(fieldWriters); }));
+  return [fields](ArrowFBBuilder& fb) { return fb.table (fields); };
+}
+
+//# Write an encapsulated message and return the metadata length.
+static Int64 arrowWriteMessage (ByteIO& file, uInt headerType,
+                                const ArrowFBBuilder::Writer& header,
+                                Int64 bodyLength)
+{
+  typedef ArrowFBBuilder::Field Field;
+  std::vector<Field> fields;
+  fields.push_back (Field(0, 2, theArrowVersion));
+  fields.push_back (Field(1, 1, headerType));
+  fields.push_back (Field(2, header));
+  fields.push_back (Field(3, 8, bodyLength));
+  ArrowFBBuilder fb;
+  const std::vector<char>& meta =
+    fb.finish ([fields](ArrowFBBuilder& fb) { return fb.table (fields); });
+  std::vector<char> prefix;
+  arrowPut (prefix, 0xffffffff, 4);
+  arrowPut (prefix, meta.size(), 4);
+  file.write (prefix.size(), &(prefix[0]));
+  file.write (meta.size(), &(meta[0]));
+  return 8 + meta.size();
+}
+
+static void arrowWritePadding (ByteIO& file, Int64 length)
+{
+  static const char zeroes[theArrowAlign] = {0};
+  Int64 npad = arrowPadded(length) - length;
+  if (npad > 0) {
+    file.write (npad, zeroes);
+  }
+}
+
+//# Write data as little-endian values.
+static void arrowWriteData (ByteIO& file, const void* data, Int64 nvalues,
+                            uInt valueSize)
+{
+#if defined(AIPS_LITTLE_ENDIAN)
+  file.write (nvalues*valueSize, data);
+#else
+  std::vector<char> buf(nvalues*valueSize);
+  const char* in = static_cast<const char*>(data);
+  for (Int64 i=0; i<nvalues; i++) {
+    for (uInt j=0; j<valueSize; j++) {
+      buf[i*valueSize + j] = in[i*valueSize + valueSize-1-j];
+    }
+  }
+  file.write (buf.size(), &(buf[0]));
+#endif
+}
+
+//# Write the values of a column in a range of rows in chunks.
+template<typename T>
+static void arrowWriteValues (ByteIO& file, const Table& table,
+                              const ArrowWriteColumn& col,
+                              rownr_t startRow, rownr_t nrow)
+{
+  // Read about 4 MB at a time (a multiple of 8 rows for bools).
+  rownr_t chunk = std::max (rownr_t(1),
+                            rownr_t(4194304 / (col.nelem * sizeof(T))));
+  chunk = (chunk + 7) / 8 * 8;
+  uInt valueSize = (col.isComplex ? sizeof(T)/2 : sizeof(T));
+  uInt nparts    = sizeof(T) / valueSize;
+  std::vector<uChar> bits;
+  Array<T> arr;
+  for (rownr_t row=startRow; row<startRow+nrow; row+=chunk) {
+    rownr_t nr = std::min (chunk, startRow + nrow - row);
+    Slicer rowRange(IPosition(1,row), IPosition(1,nr));
+    if (col.shape.empty()) {
+      Vector<T> vec;
+      ScalarColumn<T>(table, col.name).getColumnRange (rowRange, vec, True);
+      arr.reference (vec);
+    } else {
+      ArrayColumn<T>(table, col.name).getColumnRange (rowRange, arr, True);
+      if (! arr.shape().getFirst(col.shape.size()).isEqual (col.shape)) {
+        throw TableError ("ArrowTableWriter: column " + col.name +
+                          " has a varying shape");
+      }
+    }
+    Bool deleteIt;
+    const T* data = arr.getStorage (deleteIt);
+    if (col.dtype == TpBool) {
+      bits.resize ((arr.size() + 7) / 8);
+      Conversion::boolToBit (&(bits[0]), data, arr.size());
+      file.write (bits.size(), &(bits[0]));
+    } else {
+      arrowWriteData (file, data, arr.size() * nparts, valueSize);
+    }
+    arr.freeStorage (data, deleteIt);
+  }
+}
+
+static void arrowWriteColumn (ByteIO& file, const Table& table,
+                              const ArrowWriteColumn& col,
+                              rownr_t startRow, rownr_t nrow)
+{
+  switch (col.dtype) {
+  case TpBool:
+    arrowWriteValues<Bool> (file, table, col, startRow, nrow);
+    break;
+  case TpUChar:
+    arrowWriteValues<uChar> (file, table, col, startRow, nrow);
+    break;
+  case TpShort:
+    arrowWriteValues<Short> (file, table, col, startRow, nrow);
+    break;
+  case TpUShort:
+    arrowWriteValues<uShort> (file, table, col, startRow, nrow);
+    break;
+  case TpInt:
+    arrowWriteValues<Int> (file, table, col, startRow, nrow);
+    break;
+  case TpUInt:
+    arrowWriteValues<uInt> (file, table, col, startRow, nrow);
+    break;
+  case TpFloat:
+    arrowWriteValues<Float> (file, table, col, startRow, nrow);
+    break;
+  case TpDouble:
+    arrowWriteValues<Double> (file, table, col, startRow, nrow);
+    break;
+  case TpComplex:
+    arrowWriteValues<Complex> (file, table, col, startRow, nrow);
+    break;
+  case TpDComplex:
+    arrowWriteValues<DComplex> (file, table, col, startRow, nrow);
+    break;
+  default:
+    throw TableError ("ArrowTableWriter: invalid data type");
+  }
+  Int64 nvalues = nrow * col.nelem;
+  Int64 length = (col.dtype == TpBool  ?  (nvalues + 7) / 8 :
+                  nvalues * ValType::getTypeSize(col.dtype));
+  arrowWritePadding (file, length);
+}
+
+Bool ArrowTableWriter::canWrite (const Table& table, const String& columnName)
+{
+  const ColumnDesc& cdesc = table.tableDesc()[columnName];
+  switch (cdesc.dataType()) {
+  case TpBool:
+  case TpUChar:
+  case TpShort:
+  case TpUShort:
+  case TpInt:
+  case TpUInt:
+  case TpFloat:
+  case TpDouble:
+  case TpComplex:
+  case TpDComplex:
+  case TpString:
+    break;
+  default:
+    return False;
+  }
+  if (cdesc.isScalar()) {
+    return True;
+  }
+  if (! cdesc.isArray()) {
+    return False;
+  }
+  // An array must have the same shape in all rows.
+  if (cdesc.isFixedShape()) {
+    return True;
+  }
+  if (table.nrow() == 0) {
+    return False;
+  }
+  TableColumn col(table, columnName);
+  if (! col.isDefined (0)) {
+    return False;
+  }
+  IPosition shape = col.shape (0);
+  for (uInt i=1; i<table.nrow(); i++) {
+    if (! col.isDefined(i)  ||  ! col.shape(i).isEqual (shape)) {
+      return False;
+    }
+  }
+  return True;
+}
+
+void ArrowTableWriter::write (const Table& table, const String& fileName,
+                              const Vector<String>& columnNames,
+                              rownr_t rowsPerBatch)
+{
+  // Determine the columns to write.
+  Vector<String> names(columnNames);
+  Bool skip = names.empty();
+  if (skip) {
+    names.reference (table.tableDesc().columnNames());
+  }
+  std::vector<ArrowWriteColumn> columns;
+  for (uInt i=0; i<names.size(); i++) {
+    if (! canWrite (table, names[i])) {
+      if (skip) {
+        continue;
+      }
+      throw TableError ("ArrowTableWriter: column " + names[i] +
+                        " cannot be written (not a scalar or fixed shape"
+                        " array of a standard type)");
+    }
+    TableColumn tabcol(table, names[i]);
+    ArrowWriteColumn col;
+    col.name      = names[i];
+    col.dtype     = tabcol.columnDesc().dataType();
+    col.isComplex = (col.dtype == TpComplex  ||  col.dtype == TpDComplex);
+    if (tabcol.columnDesc().isArray()) {
+      col.shape = (tabcol.columnDesc().isFixedShape()  ?
+                   tabcol.columnDesc().shape() : tabcol.shape(0));
+    }
+    col.nelem = (col.shape.empty()  ?  1 : col.shape.product());
+    columns.push_back (col);
+  }
+  rownr_t nrow = table.nrow();
+  if (rowsPerBatch == 0  ||  rowsPerBatch > nrow) {
+    rowsPerBatch = std::max (nrow, rownr_t(1));
+  }
+  RegularFileIO file(RegularFile(fileName), ByteIO::New);
+  file.write (8, theArrowMagic);
+  Int64 offset = 8;
+  // Write the schema message.
+  offset += arrowWriteMessage (file, ArrowSchemaHeader,
+                               arrowSchema(columns), 0);
+  // Write the batches; the blocks are written in the footer.
+  std::vector<Int64> blocks;
+  for (rownr_t startRow=0; startRow<nrow  ||  startRow==0;
+       startRow+=rowsPerBatch) {
+    rownr_t nr = std::min (rowsPerBatch, nrow - startRow);
+    // Determine the nodes and buffers.
+    std::vector<Int64> nodes;
+    std::vector<Int64> buffers;
+    Int64 bodyLength = 0;
+    for (uInt i=0; i<columns.size(); i++) {
+      ArrowWriteColumn& col = columns[i];
+      Int64 nvalues = nr * col.nelem;
+      nodes.push_back (nr);
+      nodes.push_back (0);
+      buffers.push_back (bodyLength);            //# no validity buffer
+      buffers.push_back (0);
+      if (!col.shape.empty()  ||  col.isComplex) {
+        // The child node of the fixed size list.
+        nodes.push_back (nvalues * (col.isComplex ? 2:1));
+        nodes.push_back (0);
+        buffers.push_back (bodyLength);
+        buffers.push_back (0);
+      }
+      Int64 length;
+      if (col.dtype == TpString) {
+        // Read the strings to determine their offsets.
+        Slicer rowRange(IPosition(1,startRow), IPosition(1,nr));
+        if (nr == 0) {
+          col.strings.resize();
+        } else if (col.shape.empty()) {
+          Vector<String> vec;
+          ScalarColumn<String>(table, col.name).getColumnRange
+                                                 (rowRange, vec, True);
+          col.strings.reference (vec);
+        } else {
+          ArrayColumn<String>(table, col.name).getColumnRange
+                                                 (rowRange, col.strings, True);
+        }
+        col.stringOffsets.resize (nvalues + 1);
+        Int64 total = 0;
+        col.stringOffsets[0] = 0;
+        Int64 j = 0;
+        for (Array<String>::const_iterator iter=col.strings.begin();
+             iter!=col.strings.end(); ++iter) {
+          total += iter->size();
+          if (total > 2147483647) {
+            throw TableError ("ArrowTableWriter: strings in column " +
+                              col.name + " exceed 2 GB; use smaller batches");
+          }
+          col.stringOffsets[++j] = total;
+        }
+        buffers.push_back (bodyLength);
+        buffers.push_back (4 * (nvalues+1));
+        bodyLength += arrowPadded (4 * (nvalues+1));
+        length = total;
+      } else if (col.dtype == TpBool) {
+        length = (nvalues + 7) / 8;
+      } else {
+        length = nvalues * ValType::getTypeSize(col.dtype);
+      }
+      buffers.push_back (bodyLength);
+      buffers.push_back (length);
+      bodyLength += arrowPadded (length);
+    }
+    // Write the message and the body.
+    typedef ArrowFBBuilder::Field Field;
+    std::vector<Field> fields;
+    fields.push_back (Field(0, 8, nr));
+    fields.push_back (Field(1, [nodes](ArrowFBBuilder& fb)
+                                 { return fb.structVector (nodes, 16); }));
+    fields.push_back (Field(2, [buffers](ArrowFBBuilder& fb)
+                                 { return fb.structVector (buffers, 16); }));
+    Int64 metaLength = arrowWriteMessage
+      (file, ArrowRecordBatchHeader,
+       [fields](ArrowFBBuilder& fb) { return fb.table (fields); },
+       bodyLength);
+    for (uInt i=0; i<columns.size(); i++) {
+      ArrowWriteColumn& col = columns[i];
+      if (col.dtype == TpString) {
+        arrowWriteData (file, &(col.stringOffsets[0]),
+                        col.stringOffsets.size(), 4);
+        arrowWritePadding (file, 4 * col.stringOffsets.size());
+        std::string chars;
+        chars.reserve (col.stringOffsets.back());
+        for (Array<String>::const_iterator iter=col.strings.begin();
+             iter!=col.strings.end(); ++iter) {
+          chars += *iter;
+        }
+        file.write (chars.size(), chars.data());
+        arrowWritePadding (file, chars.size());
+        col.strings.resize();
+        col.stringOffsets.clear();
+      } else {
+        arrowWriteColumn (file, table, col, startRow, nr);
+      }
+    }
+    blocks.push_back (offset);
+    blocks.push_back (metaLength);
+    blocks.push_back (bodyLength);
+    offset += metaLength + bodyLength;
+    if (nr == 0) {
+      break;
+    }
+  }
+  // Write the end-of-stream marker and the footer.
+  std::vector<char> eos;
+  arrowPut (eos, 0xffffffff, 4);
+  arrowPut (eos, 0, 4);
+  file.write (eos.size(), &(eos[0]));
+  typedef ArrowFBBuilder::Field Field;
+  std::vector<Field> fields;
+  fields.push_back (Field(0, 2, theArrowVersion));
+  fields.push_back (Field(1, arrowSchema(columns)));
+  fields.push_back (Field(2, [](ArrowFBBuilder& fb)
+                               { return fb.structVector
+                                   (std::vector<Int64>(), 24); }));
+  fields.push_back (Field(3, [blocks](ArrowFBBuilder& fb)
+                               { return fb.structVector (blocks, 24); }));
+  ArrowFBBuilder fb;
+  const std::vector<char>& footer =
+    fb.finish ([fields](ArrowFBBuilder& fb) { return fb.table (fields); });
+  file.write (footer.size(), &(footer[0]));
+  std::vector<char> trailer;
+  arrowPut (trailer, footer.size(), 4);
+  trailer.insert (trailer.end(), theArrowMagic, theArrowMagic+6);
+  file.write (trailer.size(), &(trailer[0]));
+}
+
+
+
+ArrowTableReader::ArrowTableReader (const String& fileName)
+: fileName_p (fileName),
+  data_p     (0),
+  size_p     (0),
+  nrow_p     (0)
+{
+  file_p = new MMapIO (RegularFile(fileName));
+  size_p = file_p->getFileSize();
+  data_p = static_cast<const char*>(file_p->getReadPointer (0));
+  if (size_p < 20  ||  memcmp (data_p, theArrowMagic, 6) != 0  ||
+      memcmp (data_p + size_p - 6, theArrowMagic, 6) != 0) {
+    throw TableError ("ArrowTableReader: " + fileName +
+                      " is not an Arrow IPC file");
+  }
+  readFooter();
+}
+
+ArrowTableReader::~ArrowTableReader()
+{}
+
+void ArrowTableReader::readFooter()
+{
+  Int64 footerSize = arrowGet (data_p + size_p - 10, 4);
+  Int64 footerStart = size_p - 10 - footerSize;
+  if (footerStart < 8) {
+    throw TableError ("ArrowTableReader: invalid footer in " + fileName_p);
+  }
+  ArrowFBReader fb(data_p + footerStart, footerSize);
+  uInt footer = fb.root();
+  uInt schema = fb.ref (footer, 1);
+  if (schema == 0  ||  fb.scalar (schema, 0, 2, 0) != 0) {
+    throw TableError ("ArrowTableReader: " + fileName_p +
+                      " has no schema or is not little-endian");
+  }
+  // Read the fields.
+  uInt nfield;
+  uInt fields = fb.vector (schema, 1, nfield);
+  uInt nodenr = 0;
+  uInt bufnr  = 0;
+  for (uInt i=0; i<nfield; i++) {
+    // Convert the position to the position in the file.
+    addField (footerStart + fb.element (fields, i), nodenr, bufnr);
+  }
+  // Read the record batches.
+  uInt nblock;
+  uInt blocks = fb.vector (footer, 3, nblock);
+  for (uInt i=0; i<nblock; i++) {
+    uInt pos = blocks + 24*i;
+    readBatch (fb.get (pos, 8), fb.get (pos+8, 4), fb.get (pos+16, 8));
+  }
+}
+
+void ArrowTableReader::countField (uInt field, uInt& nodenr,
+                                   uInt& bufnr) const
+{
+  ArrowFBReader fb(data_p, size_p);
+  uInt typeId = fb.scalar (field, 2, 1, 0);
+  if (fb.field (field, 4) != 0) {
+    throw TableError ("ArrowTableReader: dictionary encoded fields are"
+                      " not supported");
+  }
+  nodenr++;
+  switch (typeId) {
+  case ArrowNull:
+    break;
+  case ArrowInt:
+  case ArrowFloatingPoint:
+  case ArrowBool:
+  case ArrowDecimal:
+  case ArrowDate:
+  case ArrowTime:
+  case ArrowTimestamp:
+  case ArrowInterval:
+  case ArrowFixedSizeBinary:
+  case ArrowDuration:
+    bufnr += 2;
+    break;
+  case ArrowBinary:
+  case ArrowUtf8:
+  case ArrowLargeBinary:
+  case ArrowLargeUtf8:
+    bufnr += 3;
+    break;
+  case ArrowList:
+  case ArrowLargeList:
+  case ArrowMap:
+    bufnr += 2;
+    break;
+  case ArrowStruct:
+  case ArrowFixedSizeList:
+    bufnr += 1;
+    break;
+  default:
+    throw TableError ("ArrowTableReader: Arrow type " +
+                      String::toString(typeId) + " is not supported");
+  }
+  uInt nchild;
+  uInt children = fb.vector (field, 5, nchild);
+  for (uInt i=0; i<nchild; i++) {
+    countField (fb.element (children, i), nodenr, bufnr);
+  }
+}
+
+//# Get the casacore data type of a primitive Arrow type.
+static DataType arrowDataType (const ArrowFBReader& fb, uInt field)
+{
+  uInt typeId = fb.scalar (field, 2, 1, 0);
+  uInt type   = fb.ref (field, 3);
+  switch (typeId) {
+  case ArrowBool:
+    return TpBool;
+  case ArrowUtf8:
+    return TpString;
+  case ArrowFloatingPoint:
+    switch (fb.scalar (type, 0, 2, 0)) {
+    case 1:
+      return TpFloat;
+    case 2:
+      return TpDouble;
+    }
+    break;
+  case ArrowInt:
+    {
+      Int  nbits    = fb.scalar (type, 0, 4, 0);
+      Bool isSigned = fb.scalar (type, 1, 1, 0);
+      if (nbits == 8  &&  !isSigned) {
+        return TpUChar;
+      } else if (nbits == 16) {
+        return (isSigned ? TpShort : TpUShort);
+      } else if (nbits == 32) {
+        return (isSigned ? TpInt : TpUInt);
+      } else if (nbits == 64  &&  isSigned) {
+        return TpInt64;
+      }
+    }
+    break;
+  }
+  return TpOther;
+}
+
+void ArrowTableReader::addField (uInt field, uInt& nodenr, uInt& bufnr)
+{
+  ArrowFBReader fb(data_p, size_p);
+  ColumnInfo col;
+  col.name   = fb.string (field, 0);
+  col.nodenr = nodenr;
+  col.bufnr  = bufnr;
+  col.isList = False;
+  col.dtype  = arrowDataType (fb, field);
+  uInt typeId = fb.scalar (field, 2, 1, 0);
+  if (typeId == ArrowFixedSizeList) {
+    uInt nchild;
+    uInt children = fb.vector (field, 5, nchild);
+    Int listSize = fb.scalar (fb.ref(field, 3), 0, 4, 0);
+    if (nchild == 1  &&  listSize > 0) {
+      col.isList = True;
+      col.dtype = arrowDataType (fb, fb.element (children, 0));
+      // Get the shape and type from the metadata.
+      String shapeStr, typeStr;
+      uInt nkv;
+      uInt kvs = fb.vector (field, 6, nkv);
+      for (uInt i=0; i<nkv; i++) {
+        uInt kv = fb.element (kvs, i);
+        String key = fb.string (kv, 0);
+        if (key == "casacore.shape") {
+          shapeStr = fb.string (kv, 1);
+        } else if (key == "casacore.type") {
+          typeStr = fb.string (kv, 1);
+        }
+      }
+      Int nvalues = listSize;
+      if (typeStr == "Complex"  &&  col.dtype == TpFloat  &&
+          listSize % 2 == 0) {
+        col.dtype = TpComplex;
+        nvalues /= 2;
+      } else if (typeStr == "DComplex"  &&  col.dtype == TpDouble  &&
+                 listSize % 2 == 0) {
+        col.dtype = TpDComplex;
+        nvalues /= 2;
+      }
+      if (! shapeStr.empty()) {
+        shapeStr.gsub (Regex("[][ ]"), "");
+        Vector<String> parts = stringToVector (shapeStr);
+        col.shape.resize (parts.size());
+        for (uInt i=0; i<parts.size(); i++) {
+          col.shape[i] = atoi (parts[i].c_str());
+        }
+      } else if (nvalues > 1  ||  !(col.dtype == TpComplex  ||
+                                    col.dtype == TpDComplex)) {
+        col.shape = IPosition(1, nvalues);
+      }
+      if ((col.shape.empty() ? 1 : col.shape.product()) != nvalues) {
+        col.dtype = TpOther;
+      }
+    } else {
+      col.dtype = TpOther;
+    }
+  }
+  if (col.dtype != TpOther  &&  ! col.name.empty()  &&
+      ! isColumn (col.name)) {
+    col.nvalues = (col.shape.empty()  ?  1 : col.shape.product());
+    columns_p.push_back (col);
+  }
+  countField (field, nodenr, bufnr);
+}
+
+void ArrowTableReader::readBatch (Int64 offset, Int64 metaLength,
+                                  Int64 bodyLength)
+{
+  if (offset + metaLength + bodyLength > size_p  ||  metaLength < 8) {
+    throw TableError ("ArrowTableReader: invalid batch in " + fileName_p);
+  }
+  // Skip the continuation marker and length.
+  Int64 start = offset + 8;
+  if (arrowGet (data_p + offset, 4) != 0xffffffff) {
+    start = offset + 4;
+  }
+  ArrowFBReader fb(data_p + start, offset + metaLength - start);
+  uInt message = fb.root();
+  if (fb.scalar (message, 1, 1, 0) != ArrowRecordBatchHeader) {
+    throw TableError ("ArrowTableReader: invalid batch in " + fileName_p);
+  }
+  uInt batch = fb.ref (message, 2);
+  if (fb.ref (batch, 3) != 0) {
+    throw TableError ("ArrowTableReader: compressed batches are not"
+                      " supported");
+  }
+  BatchInfo info;
+  info.nrow       = fb.scalar (batch, 0, 8, 0);
+  info.bodyOffset = offset + metaLength;
+  info.bodyLength = bodyLength;
+  uInt nnode, nbuf;
+  uInt nodes   = fb.vector (batch, 1, nnode);
+  uInt buffers = fb.vector (batch, 2, nbuf);
+  for (uInt i=0; i<nnode; i++) {
+    info.nullCounts.push_back (fb.get (nodes + 16*i + 8, 8));
+  }
+  for (uInt i=0; i<nbuf; i++) {
+    Int64 bufOffset = fb.get (buffers + 16*i, 8);
+    Int64 bufLength = fb.get (buffers + 16*i + 8, 8);
+    if (bufOffset + bufLength > bodyLength) {
+      throw TableError ("ArrowTableReader: invalid buffer in " + fileName_p);
+    }
+    info.bufOffsets.push_back (bufOffset);
+    info.bufLengths.push_back (bufLength);
+  }
+  batches_p.push_back (info);
+  nrow_p += info.nrow;
+}
+
+rownr_t ArrowTableReader::batchRows (uInt batch) const
+{
+  return batches_p[batch].nrow;
+}
+
+Vector<String> ArrowTableReader::columnNames() const
+{
+  Vector<String> names(columns_p.size());
+  for (uInt i=0; i<columns_p.size(); i++) {
+    names[i] = columns_p[i].name;
+  }
+  return names;
+}
+
+Bool ArrowTableReader::isColumn (const String& name) const
+{
+  for (uInt i=0; i<columns_p.size(); i++) {
+    if (columns_p[i].name == name) {
+      return True;
+    }
+  }
+  return False;
+}
+
+DataType ArrowTableReader::dataType (const String& name) const
+{
+  return columns_p[checkColumn (name, TpOther)].dtype;
+}
+
+const IPosition& ArrowTableReader::shape (const String& name) const
+{
+  return columns_p[checkColumn (name, TpOther)].shape;
+}
+
+uInt ArrowTableReader::checkColumn (const String& name, DataType dtype) const
+{
+  for (uInt i=0; i<columns_p.size(); i++) {
+    if (columns_p[i].name == name) {
+      if (dtype != TpOther  &&  dtype != columns_p[i].dtype) {
+        String colType (ValType::getTypeStr(columns_p[i].dtype));
+        String reqType (ValType::getTypeStr(dtype));
+        colType.trim();
+        reqType.trim();
+        throw TableError ("ArrowTableReader: column " + name + " has type " +
+                          colType + ", not " + reqType);
+      }
+      return i;
+    }
+  }
+  throw TableError ("ArrowTableReader: column " + name +
+                    " does not exist in " + fileName_p);
+}
+
+IPosition ArrowTableReader::columnShape (uInt colnr, Int batch) const
+{
+  rownr_t nr = (batch < 0  ?  nrow_p : batchRows(batch));
+  IPosition shape(columns_p[colnr].shape);
+  shape.append (IPosition(1, nr));
+  return shape;
+}
+
+const char* ArrowTableReader::bufferPointer (uInt colnr, uInt batch,
+                                             uInt bufnr,
+                                             Int64& length) const
+{
+  const ColumnInfo& col = columns_p[colnr];
+  const BatchInfo& info = batches_p[batch];
+  uInt nodenr = col.nodenr;
+  // The child node and its buffers follow the list.
+  if (col.isList) {
+    bufnr++;
+  }
+  if (nodenr + (col.isList ? 1:0) >= info.nullCounts.size()  ||
+      col.bufnr + bufnr >= info.bufOffsets.size()) {
+    throw TableError ("ArrowTableReader: batch " + String::toString(batch) +
+                      " in " + fileName_p + " has too few buffers");
+  }
+  if (info.nullCounts[nodenr] != 0  ||
+      (col.isList  &&  info.nullCounts[nodenr+1] != 0)) {
+    throw TableError ("ArrowTableReader: column " + col.name +
+                      " contains null values");
+  }
+  length = info.bufLengths[col.bufnr + bufnr];
+  return data_p + info.bodyOffset + info.bufOffsets[col.bufnr + bufnr];
+}
+
+const void* ArrowTableReader::dataPointer (uInt colnr, Int batch) const
+{
+#if defined(AIPS_LITTLE_ENDIAN)
+  const ColumnInfo& col = columns_p[colnr];
+  if (col.dtype == TpBool  ||  col.dtype == TpString) {
+    return 0;
+  }
+  if (batch < 0) {
+    if (nbatch() != 1) {
+      return 0;
+    }
+    batch = 0;
+  }
+  Int64 length;
+  const char* ptr = bufferPointer (colnr, batch, 1, length);
+  uInt valueSize = ValType::getTypeSize (col.dtype);
+  if (length < Int64(batchRows(batch) * col.nvalues * valueSize)) {
+    throw TableError ("ArrowTableReader: buffer of column " + col.name +
+                      " is too short");
+  }
+  // The data can only be used directly if properly aligned.
+  if (reinterpret_cast<size_t>(ptr) % std::min(valueSize, 8u) != 0) {
+    return 0;
+  }
+  return ptr;
+#else
+  return 0;
+#endif
+}
+
+void ArrowTableReader::copyColumn (uInt colnr, uInt batch, void* data) const
+{
+  const ColumnInfo& col = columns_p[colnr];
+  Int64 nvalues = batchRows(batch) * col.nvalues;
+  Int64 length;
+  const char* ptr = bufferPointer (colnr, batch, 1, length);
+  if (col.dtype == TpBool) {
+    if (length < (nvalues + 7) / 8) {
+      throw TableError ("ArrowTableReader: buffer of column " + col.name +
+                        " is too short");
+    }
+    Conversion::bitToBool (data, ptr, nvalues);
+  } else if (col.dtype == TpString) {
+    Int64 charLength;
+    const char* chars = bufferPointer (colnr, batch, 2, charLength);
+    if (length < 4 * (nvalues + 1)) {
+      throw TableError ("ArrowTableReader: buffer of column " + col.name +
+                        " is too short");
+    }
+    String* strs = static_cast<String*>(data);
+    Int64 start = arrowGet (ptr, 4);
+    for (Int64 i=0; i<nvalues; i++) {
+      Int64 end = arrowGet (ptr + 4*(i+1), 4);
+      if (end < start  ||  end > charLength) {
+        throw TableError ("ArrowTableReader: invalid string offsets in"
+                          " column " + col.name);
+      }
+      strs[i] = String (chars + start, end - start);
+      start = end;
+    }
+  } else {
+    uInt valueSize = ValType::getTypeSize (col.dtype);
+    if (length < nvalues * valueSize) {
+      throw TableError ("ArrowTableReader: buffer of column " + col.name +
+                        " is too short");
+    }
+#if defined(AIPS_LITTLE_ENDIAN)
+    memcpy (data, ptr, nvalues * valueSize);
+#else
+    // Swap the bytes of the (real and imaginary) values.
+    if (col.dtype == TpComplex  ||  col.dtype == TpDComplex) {
+      valueSize /= 2;
+      nvalues   *= 2;
+    }
+    char* out = static_cast<char*>(data);
+    for (Int64 i=0; i<nvalues; i++) {
+      for (uInt j=0; j<valueSize; j++) {
+        out[i*valueSize + j] = ptr[i*valueSize + valueSize-1-j];
+      }
+    }
+#endif
+  }
+}
+
+
+//# Add a column description for a column in the Arrow file.
+template<typename T>
+static void arrowAddColumn (TableDesc& td, const String& name,
+                            const IPosition& shape)
+{
+  if (shape.empty()) {
+    td.addColumn (ScalarColumnDesc<T> (name));
+  } else {
+    td.addColumn (ArrayColumnDesc<T> (name, shape, ColumnDesc::FixedShape));
+  }
+}
+
+//# Put the data of a column in the Arrow file into the table.
+template<typename T>
+static void arrowPutColumn (Table& table, const ArrowTableReader& reader,
+                            const String& name)
+{
+  rownr_t row = 0;
+  for (uInt i=0; i<reader.nbatch(); i++) {
+    rownr_t nr = reader.batchRows (i);
+    if (nr > 0) {
+      Array<T> arr = reader.getColumn<T> (name, i);
+      Slicer rowRange(IPosition(1,row), IPosition(1,nr));
+      if (reader.shape(name).empty()) {
+        ScalarColumn<T>(table, name).putColumnRange (rowRange, Vector<T>(arr));
+      } else {
+        ArrayColumn<T>(table, name).putColumnRange (rowRange, arr);
+      }
+    }
+    row += nr;
+  }
+}
+
+#define ARROWTABLE_DOTYPE(FUNC,ARGS) \
+  switch (columns_p[i].dtype) { \
+  case TpBool: FUNC<Bool> ARGS; break; \
+  case TpUChar: FUNC<uChar> ARGS; break; \
+  case TpShort: FUNC<Short> ARGS; break; \
+  case TpUShort: FUNC<uShort> ARGS; break; \
+  case TpInt: FUNC<Int> ARGS; break; \
+  case TpUInt: FUNC<uInt> ARGS; break; \
+  case TpFloat: FUNC<Float> ARGS; break; \
+  case TpDouble: FUNC<Double> ARGS; break; \
+  case TpComplex: FUNC<Complex> ARGS; break; \
+  case TpDComplex: FUNC<DComplex> ARGS; break; \
+  case TpString: FUNC<String> ARGS; break; \
+  default: break; \
+  }
+
+Table ArrowTableReader::toTable (const String& tableName,
+                                 Table::TableOption option) const
+{
+  TableDesc td;
+  //# Note that tables do not support Int64 columns, so these are skipped.
+  for (uInt i=0; i<columns_p.size(); i++) {
+    ARROWTABLE_DOTYPE (arrowAddColumn,
+                       (td, columns_p[i].name, columns_p[i].shape))
+  }
+  SetupNewTable newtab(tableName, td, option);
+  Table table(newtab, nrow_p);
+  for (uInt i=0; i<columns_p.size(); i++) {
+    ARROWTABLE_DOTYPE (arrowPutColumn, (table, *this, columns_p[i].name))
+  }
+  return table;
+}
+
+} //# NAMESPACE CASACORE - END
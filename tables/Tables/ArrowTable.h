@@ -0,0 +1,311 @@
+//# ArrowTable.h: Columnar export and import of tables in Arrow IPC format
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_ARROWTABLE_H
+#define TABLES_ARROWTABLE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class MMapIO;
+
+
+// <summary>
+// Write table columns to a file in Arrow IPC format
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tArrowTable.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=Table>Table</linkto>
+// </prerequisite>
+
+// <synopsis>
+// ArrowTableWriter writes columns of a table column by column to a file
+// in the Arrow IPC file format (version 5), so the file can be read by
+// any tool supporting Arrow (pyarrow, pandas, polars, etc.).
+// <p>
+// Scalar columns and array columns with the same shape in all rows can be
+// written. The data types are mapped as follows:
+// <ul>
+//  <li> Bool, uChar, Short, uShort, Int, uInt, Float, Double and
+//       String are mapped to Arrow bool, uint8, int16, uint16, int32,
+//       uint32, float, double and utf8.
+//  <li> Complex and DComplex are written as a fixed size list of
+//       2 floats or doubles.
+//  <li> An array column is written as a fixed size list of the array
+//       values (in Fortran order) per row. Its shape is kept in the
+//       <src>casacore.shape</src> field metadata.
+// </ul>
+// Complex fields have the metadata <src>casacore.type</src> defining the
+// type. The values in a column are contiguous in a record batch (which
+// contains all rows by default), so they can be mapped directly into
+// memory when read back.
+// <br>No null values are written. Other columns (e.g., records or arrays
+// with a varying shape) are skipped if no column names are given;
+// otherwise an exception is thrown.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Table tab("my.ms");
+//   ArrowTableWriter::write (tab, "my.arrow",
+//                            stringToVector("TIME,ANTENNA1,ANTENNA2,UVW"));
+// </srcblock>
+// </example>
+
+// <motivation>
+// Analysis tools outside casacore need fast access to the (metadata)
+// columns of large tables. Row by row conversion is far too slow.
+// </motivation>
+
+class ArrowTableWriter
+{
+public:
+    // Write the given columns of the table into the file.
+    // If no columns are given, all columns that can be written are written.
+    // The rows are split into record batches of <src>rowsPerBatch</src>
+    // rows; 0 means a single batch. Note that the total length of the
+    // strings in a batch has to be less than 2 GB.
+    static void write (const Table& table, const String& fileName,
+                       const Vector<String>& columnNames = Vector<String>(),
+                       rownr_t rowsPerBatch = 0);
+
+    // Can a column in the table be written?
+    static Bool canWrite (const Table& table, const String& columnName);
+};
+
+
+
+// <summary>
+// Read columns from a file in Arrow IPC format
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tArrowTable.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=ArrowTableWriter>ArrowTableWriter</linkto>
+// </prerequisite>
+
+// <synopsis>
+// ArrowTableReader maps a file in Arrow IPC file format into memory
+// and gives access to its columns.
+// Columns with a data type as described in
+// <linkto class=ArrowTableWriter>ArrowTableWriter</linkto> are
+// accessible. Arrow int64 columns can be read as Int64, but are skipped by
+// <src>toTable</src> because tables do not support them. Other columns
+// (e.g., int8, uint64, lists or structs) are ignored.
+// Null values are not supported; an exception is thrown when getting a
+// column containing null values.
+// <p>
+// <src>getColumn</src> returns the values of a column as an Array with
+// the row axis as the last axis. For numeric and complex columns on
+// little-endian hosts, the Array refers directly to the mapped data
+// (no copy is made) if a single batch is accessed. In that case the Array
+// is only valid as long as the reader exists and must not be changed.
+// Bool and String columns are always copied.
+// <p>
+// <src>toTable</src> creates a casacore table from all columns, using
+// the StandardStMan.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   ArrowTableReader reader("my.arrow");
+//   Vector<Double> times = reader.getColumn<Double> ("TIME");
+//   Array<Double> uvw = reader.getColumn<Double> ("UVW");  // shape [3,nrow]
+// </srcblock>
+// </example>
+
+class ArrowTableReader
+{
+public:
+    // Open the file and read its schema and batch info.
+    explicit ArrowTableReader (const String& fileName);
+
+    ~ArrowTableReader();
+
+    // Get the number of rows.
+    rownr_t nrow() const
+      { return nrow_p; }
+
+    // Get the number of record batches and the number of rows in a batch.
+    // <group>
+    uInt nbatch() const
+      { return batches_p.size(); }
+    rownr_t batchRows (uInt batch) const;
+    // </group>
+
+    // Get the names of the columns that can be accessed.
+    Vector<String> columnNames() const;
+
+    // Does the column exist?
+    Bool isColumn (const String& name) const;
+
+    // Get the data type and cell shape of a column.
+    // The cell shape is empty for a scalar column.
+    // <group>
+    DataType dataType (const String& name) const;
+    const IPosition& shape (const String& name) const;
+    // </group>
+
+    // Get all values in a column or in the given batch of a column.
+    // The row axis is the last axis.
+    // The type T must match the data type of the column.
+    // <group>
+    template<typename T> Array<T> getColumn (const String& name) const
+      { return getColumn<T> (name, -1); }
+    template<typename T> Array<T> getColumn (const String& name,
+                                             Int batch) const;
+    // </group>
+
+    // Create a table from all columns (using the StandardStMan).
+    Table toTable (const String& tableName,
+                   Table::TableOption option = Table::New) const;
+
+private:
+    // Forbid copy constructor and assignment.
+    // <group>
+    ArrowTableReader (const ArrowTableReader&);
+    ArrowTableReader& operator= (const ArrowTableReader&);
+    // </group>
+
+    // Get the index of a column with the given data type.
+    // An exception is thrown if not existing or the type mismatches.
+    uInt checkColumn (const String& name, DataType dtype) const;
+
+    // Get the shape of the values of a column in a batch (-1 is all).
+    IPosition columnShape (uInt colnr, Int batch) const;
+
+    // Get a pointer to the data of a column in a batch if they can be
+    // used directly. Otherwise return a null pointer.
+    const void* dataPointer (uInt colnr, Int batch) const;
+
+    // Copy the data of a column in a batch to the given buffer
+    // (with the type of the column).
+    void copyColumn (uInt colnr, uInt batch, void* data) const;
+
+    // Get a pointer to the given data buffer of a column in a batch.
+    const char* bufferPointer (uInt colnr, uInt batch, uInt bufnr,
+                               Int64& length) const;
+
+    // Read the footer and schema.
+    void readFooter();
+
+    // Read the messages of the record batches.
+    void readBatch (Int64 offset, Int64 metaLength, Int64 bodyLength);
+
+    // Add a field from the schema (if it can be accessed).
+    // The number of nodes and buffers used by the field is added.
+    void addField (uInt field, uInt& nodenr, uInt& bufnr);
+
+    // Count the number of nodes and buffers used by a field.
+    void countField (uInt field, uInt& nodenr, uInt& bufnr) const;
+
+    // Describe a column.
+    struct ColumnInfo {
+        String    name;
+        DataType  dtype;
+        IPosition shape;
+        // The number of values per row.
+        uInt      nvalues;
+        // The first node and buffer of the column in a batch.
+        uInt      nodenr;
+        uInt      bufnr;
+        // Is it a fixed size list (i.e., has a child node)?
+        Bool      isList;
+    };
+
+    // Describe a record batch.
+    struct BatchInfo {
+        rownr_t nrow;
+        // The start of the body in the file.
+        Int64   bodyOffset;
+        Int64   bodyLength;
+        // The null count of each node.
+        std::vector<Int64> nullCounts;
+        // The offset and length of each buffer (relative to the body).
+        std::vector<Int64> bufOffsets;
+        std::vector<Int64> bufLengths;
+    };
+
+    //# Data members.
+    String                  fileName_p;
+    CountedPtr<MMapIO>      file_p;
+    const char*             data_p;
+    Int64                   size_p;
+    rownr_t                 nrow_p;
+    std::vector<ColumnInfo> columns_p;
+    std::vector<BatchInfo>  batches_p;
+};
+
+
+template<typename T>
+Array<T> ArrowTableReader::getColumn (const String& name, Int batch) const
+{
+    uInt colnr = checkColumn (name, whatType (static_cast<T*>(0)));
+    IPosition shp = columnShape (colnr, batch);
+    const void* ptr = dataPointer (colnr, batch);
+    if (ptr) {
+        return Array<T> (shp, static_cast<T*>(const_cast<void*>(ptr)),
+                         SHARE);
+    }
+    Array<T> arr(shp);
+    Bool deleteIt;
+    T* data = arr.getStorage (deleteIt);
+    T* ptrb = data;
+    for (uInt i=0; i<nbatch(); i++) {
+        if (batch < 0  ||  uInt(batch) == i) {
+            copyColumn (colnr, i, ptrb);
+            ptrb += batchRows(i) * columns_p[colnr].nvalues;
+        }
+    }
+    arr.putStorage (data, deleteIt);
+    return arr;
+}
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -46,13 +46,13 @@ BaseColumn::~BaseColumn()
 //# By default all functions throw an exception
 //# to ensure they are called correctly.
 
-void BaseColumn::setShape (uInt, const IPosition&)
+void BaseColumn::setShape (rownr_t, const IPosition&)
 {
   throw (TableInvOper ("invalid setShape() for column " + colDesc_p.name() +
                        "; only valid for an array"));
 }
 
-void BaseColumn::setShape (uInt, const IPosition&, const IPosition&)
+void BaseColumn::setShape (rownr_t, const IPosition&, const IPosition&)
 {
   throw (TableInvOper ("invalid setShape() for column " + colDesc_p.name() +
                        "; only valid for an array"));
@@ -72,27 +72,48 @@ IPosition BaseColumn::shapeColumn() const
   return IPosition(0);
 }
 
-uInt BaseColumn::ndim (uInt) const
+uInt BaseColumn::ndim (rownr_t) const
 {
   throw (TableInvOper ("invalid ndim() for column " + colDesc_p.name() +
                        "; only valid for an array"));
   return 0;
 }
 
-IPosition BaseColumn::shape (uInt) const
+IPosition BaseColumn::shape (rownr_t) const
 {
   throw (TableInvOper ("invalid shape() for column " + colDesc_p.name() +
                        "; only valid for an array"));
   return IPosition(0);
 }
 
-IPosition BaseColumn::tileShape (uInt) const
+IPosition BaseColumn::tileShape (rownr_t) const
 {
   throw (TableInvOper ("invalid tileShape() for column " + colDesc_p.name() +
                        "; only valid for an array"));
 }
 
 
+uInt64 BaseColumn::changeGeneration() const
+{
+    return 0;                          // changes are not tracked
+}
+
+rownr_t BaseColumn::lowestRowChanged (uInt64) const
+{
+    return 0;
+}
+
+uInt64 BaseColumn::flushedGeneration() const
+{
+    return 0;
+}
+
+Bool BaseColumn::getZoneMap (Vector<uInt>&, Vector<Double>&,
+                             Vector<Double>&, Bool)
+{
+    return False;
+}
+
 Bool BaseColumn::canChangeShape() const
 {
     return False;                      // can not be changed
@@ -130,7 +151,7 @@ Bool BaseColumn::canAccessColumnSlice (Bool& reask) const
 }
 
 
-void BaseColumn::getSlice (uInt, const Slicer&, void*) const
+void BaseColumn::getSlice (rownr_t, const Slicer&, void*) const
 {
   throw (TableInvOper ("getSlice() not implemented for column " +
                        colDesc_p.name() + "; only valid for an array"));
@@ -173,7 +194,7 @@ void BaseColumn::getColumnSlice (const Slicer&, void*) const
                        colDesc_p.name() + "; only valid for an array"));
 }
 
-void BaseColumn::putSlice (uInt, const Slicer&, const void*)
+void BaseColumn::putSlice (rownr_t, const Slicer&, const void*)
 {
   throw (TableInvOper ("putSlice() not implemented for column " +
                        colDesc_p.name() + "; only valid for an array"));
@@ -246,7 +267,7 @@ void BaseColumn::freeIterBuf (void*&, void*&)
 }
 
 
-void BaseColumn::getScalar (uInt rownr, Bool& value) const
+void BaseColumn::getScalar (rownr_t rownr, Bool& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -260,7 +281,7 @@ void BaseColumn::getScalar (uInt rownr, Bool& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, uChar& value) const
+void BaseColumn::getScalar (rownr_t rownr, uChar& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -274,7 +295,7 @@ void BaseColumn::getScalar (uInt rownr, uChar& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, Short& value) const
+void BaseColumn::getScalar (rownr_t rownr, Short& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -288,7 +309,7 @@ void BaseColumn::getScalar (uInt rownr, Short& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, uShort& value) const
+void BaseColumn::getScalar (rownr_t rownr, uShort& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -307,7 +328,7 @@ void BaseColumn::getScalar (uInt rownr, uShort& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, Int& value) const
+void BaseColumn::getScalar (rownr_t rownr, Int& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -326,7 +347,7 @@ void BaseColumn::getScalar (uInt rownr, Int& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, uInt& value) const
+void BaseColumn::getScalar (rownr_t rownr, uInt& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -350,7 +371,7 @@ void BaseColumn::getScalar (uInt rownr, uInt& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, Int64& value) const
+void BaseColumn::getScalar (rownr_t rownr, Int64& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -386,7 +407,7 @@ void BaseColumn::getScalar (uInt rownr, Int64& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, float& value) const
+void BaseColumn::getScalar (rownr_t rownr, float& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -430,7 +451,7 @@ void BaseColumn::getScalar (uInt rownr, float& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, double& value) const
+void BaseColumn::getScalar (rownr_t rownr, double& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -474,7 +495,7 @@ void BaseColumn::getScalar (uInt rownr, double& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, Complex& value) const
+void BaseColumn::getScalar (rownr_t rownr, Complex& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -529,7 +550,7 @@ void BaseColumn::getScalar (uInt rownr, Complex& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, DComplex& value) const
+void BaseColumn::getScalar (rownr_t rownr, DComplex& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -583,7 +604,7 @@ void BaseColumn::getScalar (uInt rownr, DComplex& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, String& value) const
+void BaseColumn::getScalar (rownr_t rownr, String& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -597,7 +618,7 @@ void BaseColumn::getScalar (uInt rownr, String& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, TableRecord& value) const
+void BaseColumn::getScalar (rownr_t rownr, TableRecord& value) const
 {
     if (!colDescPtr_p->isScalar()) {
         throwGetScalar();
@@ -611,7 +632,7 @@ void BaseColumn::getScalar (uInt rownr, TableRecord& value) const
     }
 }
 
-void BaseColumn::getScalar (uInt rownr, void* value,
+void BaseColumn::getScalar (rownr_t rownr, void* value,
 			    const String& dataTypeId) const
 {
     if (!colDescPtr_p->isScalar()) {
@@ -625,7 +646,7 @@ void BaseColumn::getScalar (uInt rownr, void* value,
 }
 
 
-void BaseColumn::putScalar (uInt rownr, const Bool& value)
+void BaseColumn::putScalar (rownr_t rownr, const Bool& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -639,7 +660,7 @@ void BaseColumn::putScalar (uInt rownr, const Bool& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const uChar& value)
+void BaseColumn::putScalar (rownr_t rownr, const uChar& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -681,7 +702,7 @@ void BaseColumn::putScalar (uInt rownr, const uChar& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const Short& value)
+void BaseColumn::putScalar (rownr_t rownr, const Short& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -718,7 +739,7 @@ void BaseColumn::putScalar (uInt rownr, const Short& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const uShort& value)
+void BaseColumn::putScalar (rownr_t rownr, const uShort& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -755,7 +776,7 @@ void BaseColumn::putScalar (uInt rownr, const uShort& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const Int& value)
+void BaseColumn::putScalar (rownr_t rownr, const Int& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -787,7 +808,7 @@ void BaseColumn::putScalar (uInt rownr, const Int& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const uInt& value)
+void BaseColumn::putScalar (rownr_t rownr, const uInt& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -819,7 +840,7 @@ void BaseColumn::putScalar (uInt rownr, const uInt& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const float& value)
+void BaseColumn::putScalar (rownr_t rownr, const float& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -846,7 +867,7 @@ void BaseColumn::putScalar (uInt rownr, const float& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const double& value)
+void BaseColumn::putScalar (rownr_t rownr, const double& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -873,7 +894,7 @@ void BaseColumn::putScalar (uInt rownr, const double& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const Complex& value)
+void BaseColumn::putScalar (rownr_t rownr, const Complex& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -891,7 +912,7 @@ void BaseColumn::putScalar (uInt rownr, const Complex& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const DComplex& value)
+void BaseColumn::putScalar (rownr_t rownr, const DComplex& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -909,7 +930,7 @@ void BaseColumn::putScalar (uInt rownr, const DComplex& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const String& value)
+void BaseColumn::putScalar (rownr_t rownr, const String& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
@@ -923,7 +944,7 @@ void BaseColumn::putScalar (uInt rownr, const String& value)
     }
 }
 
-void BaseColumn::putScalar (uInt rownr, const TableRecord& value)
+void BaseColumn::putScalar (rownr_t rownr, const TableRecord& value)
 {
     if (!colDescPtr_p->isScalar()) {
         throwPutScalar();
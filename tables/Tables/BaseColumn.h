@@ -121,16 +121,48 @@ public:
 	{ return colDesc_p; }
 
     // Get nr of rows in the column.
-    virtual uInt nrow() const = 0;
+    virtual rownr_t nrow() const = 0;
 
     // Test if the given cell contains a defined value.
-    virtual Bool isDefined (uInt rownr) const = 0;
+    virtual Bool isDefined (rownr_t rownr) const = 0;
+
+    // Get the change generation of the column. It is incremented each
+    // time data in the column are changed (by a put, removal of a row, or
+    // resync with another process), so it can be used to find out if
+    // an index on the column has to be updated.
+    // The default implementation returns 0, meaning that changes are
+    // not tracked.
+    virtual uInt64 changeGeneration() const;
+
+    // Get the lowest row changed since the given change generation.
+    // It returns nrow() if nothing changed. It returns 0 if the changes
+    // are not known (anymore), thus if all rows have to be regarded
+    // as changed. Rows added at the end are not regarded as changed
+    // unless data were put into them.
+    virtual rownr_t lowestRowChanged (uInt64 generation) const;
+
+    // Get the change generation of the column at the last time its data
+    // were written or resynced. If it equals <src>changeGeneration()</src>,
+    // the column has no unflushed changes.
+    // The default implementation returns 0.
+    virtual uInt64 flushedGeneration() const;
+
+    // Get the zone map of the column, i.e. the minimum and maximum value
+    // of consecutive row ranges starting at <src>startRows</src>.
+    // It can be used to skip rows in a selection on a range of values.
+    // It is only created if not existing and <src>create=True</src>.
+    // The default implementation returns False, meaning that the column
+    // has no zone map.
+    virtual Bool getZoneMap (Vector<uInt>& startRows,
+                             Vector<Double>& minValues,
+                             Vector<Double>& maxValues,
+                             Bool create);
 
     // Set the shape of the array in the given row.
-    virtual void setShape (uInt rownr, const IPosition& shape);
+    virtual void setShape (rownr_t rownr, const IPosition& shape);
 
     // Set the shape and tile shape of the array in the given row.
-    virtual void setShape (uInt rownr, const IPosition& shape,
+    virtual void setShape (rownr_t rownr, const IPosition& shape,
 			   const IPosition& tileShape);
 
     // Get the global #dimensions of an array (ie. for all rows).
@@ -140,13 +172,13 @@ public:
     virtual IPosition shapeColumn() const;
 
     // Get the #dimensions of an array in a particular cell.
-    virtual uInt ndim (uInt rownr) const;
+    virtual uInt ndim (rownr_t rownr) const;
 
     // Get the shape of an array in a particular cell.
-    virtual IPosition shape (uInt rownr) const;
+    virtual IPosition shape (rownr_t rownr) const;
 
     // Get the tile shape of an array in a particular cell.
-    virtual IPosition tileShape (uInt rownr) const;
+    virtual IPosition tileShape (rownr_t rownr) const;
 
     // Ask the data manager if the shape of an existing array can be changed.
     // Default is no.
@@ -178,14 +210,14 @@ public:
 
     // Initialize the rows from startRow till endRow (inclusive)
     // with the default value defined in the column description.
-    virtual void initialize (uInt startRownr, uInt endRownr) = 0;
+    virtual void initialize (rownr_t startRownr, rownr_t endRownr) = 0;
 
     // Get the value from a particular cell.
     // This can be a scalar or an array.
-    virtual void get (uInt rownr, void* dataPtr) const = 0;
+    virtual void get (rownr_t rownr, void* dataPtr) const = 0;
 
     // Get a slice of an N-dimensional array in a particular cell.
-    virtual void getSlice (uInt rownr, const Slicer&, void* dataPtr) const;
+    virtual void getSlice (rownr_t rownr, const Slicer&, void* dataPtr) const;
 
     // Get the vector of all scalar values in a column.
     virtual void getScalarColumn (void* dataPtr) const;
@@ -218,10 +250,10 @@ public:
 
     // Put the value in a particular cell.
     // This can be a scalar or an array.
-    virtual void put (uInt rownr, const void* dataPtr) = 0;
+    virtual void put (rownr_t rownr, const void* dataPtr) = 0;
 
     // Put a slice of an N-dimensional array in a particular cell.
-    virtual void putSlice (uInt rownr, const Slicer&, const void* dataPtr);
+    virtual void putSlice (rownr_t rownr, const Slicer&, const void* dataPtr);
 
     // Put the vector of all scalar values in the column.
     virtual void putScalarColumn (const void* dataPtr);
@@ -257,42 +289,42 @@ public:
     // Note that an unsigned integer cannot be converted to a signed integer
     // with the same length. So only Int64 can handle all integer values.
     // <group>
-    void getScalar (uInt rownr, Bool& value) const;
-    void getScalar (uInt rownr, uChar& value) const;
-    void getScalar (uInt rownr, Short& value) const;
-    void getScalar (uInt rownr, uShort& value) const;
-    void getScalar (uInt rownr, Int& value) const;
-    void getScalar (uInt rownr, uInt& value) const;
-    void getScalar (uInt rownr, Int64& value) const;
-    void getScalar (uInt rownr, float& value) const;
-    void getScalar (uInt rownr, double& value) const;
-    void getScalar (uInt rownr, Complex& value) const;
-    void getScalar (uInt rownr, DComplex& value) const;
-    void getScalar (uInt rownr, String& value) const;
-    void getScalar (uInt rownr, TableRecord& value) const;
+    void getScalar (rownr_t rownr, Bool& value) const;
+    void getScalar (rownr_t rownr, uChar& value) const;
+    void getScalar (rownr_t rownr, Short& value) const;
+    void getScalar (rownr_t rownr, uShort& value) const;
+    void getScalar (rownr_t rownr, Int& value) const;
+    void getScalar (rownr_t rownr, uInt& value) const;
+    void getScalar (rownr_t rownr, Int64& value) const;
+    void getScalar (rownr_t rownr, float& value) const;
+    void getScalar (rownr_t rownr, double& value) const;
+    void getScalar (rownr_t rownr, Complex& value) const;
+    void getScalar (rownr_t rownr, DComplex& value) const;
+    void getScalar (rownr_t rownr, String& value) const;
+    void getScalar (rownr_t rownr, TableRecord& value) const;
     // </group>
 
     // Get a scalar for the other data types.
     // The given data type id must match the data type id of this column.
-    void getScalar (uInt rownr, void* value, const String& dataTypeId) const;
+    void getScalar (rownr_t rownr, void* value, const String& dataTypeId) const;
 
     // Put the value into the row and convert it from the given type.
     // This can only be used for scalar columns with a standard data type.
     // <group>
-    void putScalar (uInt rownr, const Bool& value);
-    void putScalar (uInt rownr, const uChar& value);
-    void putScalar (uInt rownr, const Short& value);
-    void putScalar (uInt rownr, const uShort& value);
-    void putScalar (uInt rownr, const Int& value);
-    void putScalar (uInt rownr, const uInt& value);
-    void putScalar (uInt rownr, const float& value);
-    void putScalar (uInt rownr, const double& value);
-    void putScalar (uInt rownr, const Complex& value);
-    void putScalar (uInt rownr, const DComplex& value);
-    void putScalar (uInt rownr, const String& value);
-    void putScalar (uInt rownr, const Char* value)
+    void putScalar (rownr_t rownr, const Bool& value);
+    void putScalar (rownr_t rownr, const uChar& value);
+    void putScalar (rownr_t rownr, const Short& value);
+    void putScalar (rownr_t rownr, const uShort& value);
+    void putScalar (rownr_t rownr, const Int& value);
+    void putScalar (rownr_t rownr, const uInt& value);
+    void putScalar (rownr_t rownr, const float& value);
+    void putScalar (rownr_t rownr, const double& value);
+    void putScalar (rownr_t rownr, const Complex& value);
+    void putScalar (rownr_t rownr, const DComplex& value);
+    void putScalar (rownr_t rownr, const String& value);
+    void putScalar (rownr_t rownr, const Char* value)
         { putScalar (rownr, String(value)); }
-    void putScalar (uInt rownr, const TableRecord& value);
+    void putScalar (rownr_t rownr, const TableRecord& value);
     // </group>
 
     // Get a pointer to the underlying column cache.
@@ -129,44 +129,79 @@ void BaseTableIterator::reset()
 
 BaseTable* BaseTableIterator::next()
 {
-    uInt i;
-    // Allocate a RefTable to represent the rows in the iteration group.
-    RefTable* itp = sortTab_p->makeRefTable (False, 0);
     if (lastRow_p >= sortTab_p->nrow()) {
-	return itp;                              // the end of the table
+	return sortTab_p->makeRefTable (False, 0);   // the end of the table
     }
-    // Add the last found rownr to this iteration group.
-    itp->addRownr (lastRow_p);
+    // Make a RefTable containing the rows in the iteration group.
+    rownr_t endRow = groupEnd (lastRow_p, keyChangeAtLastNext_p);
+    RefTable* itp = makeRefTable (lastRow_p, endRow);
+    lastRow_p = endRow;
+    return itp;
+}
+
+RefTable* BaseTableIterator::makeRefTable (rownr_t startRow, rownr_t endRow)
+{
+    RefTable* itp = sortTab_p->makeRefTable (False, 0);
+    for (rownr_t row=startRow; row<endRow; row++) {
+	itp->addRownr (row);
+    }
+    //# Adjust rownrs in case source table is already a RefTable.
+    Vector<uInt>& rownrs = *(itp->rowStorage());
+    sortTab_p->adjustRownrs (itp->nrow(), rownrs, False);
+    return itp;
+}
+
+BaseTable* BaseTableIterator::group (uInt groupnr)
+{
+    const std::vector<rownr_t>& groups = groupBoundaries();
+    if (groupnr+1 >= groups.size()) {
+	throw TableError ("BaseTableIterator::group - group number " +
+			  String::toString(groupnr) + " exceeds " +
+			  String::toString(groups.size()-1) + " groups");
+    }
+    return makeRefTable (groups[groupnr], groups[groupnr+1]);
+}
+
+BaseTable* BaseTableIterator::sortedTable()
+{
+    return makeRefTable (0, sortTab_p->nrow());
+}
+
+rownr_t BaseTableIterator::groupEnd (rownr_t row, String& keyChange)
+{
+    uInt i;
     for (i=0; i<nrkeys_p; i++) {
-	colPtr_p[i]->get (lastRow_p, lastVal_p[i]);
+	colPtr_p[i]->get (row, lastVal_p[i]);
     }
-    Bool match;
-    uInt nr = sortTab_p->nrow();
-    while (++lastRow_p < nr) {
-	match = True;
+    rownr_t nr = sortTab_p->nrow();
+    while (++row < nr) {
 	for (i=0; i<nrkeys_p; i++) {
-	    colPtr_p[i]->get (lastRow_p, curVal_p[i]);
+	    colPtr_p[i]->get (row, curVal_p[i]);
 	    if (cmpObj_p[i]->comp (curVal_p[i], lastVal_p[i])  != 0) {
-		match = False;
 		// update so users can see which key changed
-		keyChangeAtLastNext_p=colPtr_p[i]->columnDesc().name();   
-		break;
+		keyChange = colPtr_p[i]->columnDesc().name();
+		return row;
 	    }
 	}
-	if (!match) {
-	    break;
-	}
-	itp->addRownr (lastRow_p);
     }
+    // The end of the table has been reached, so clear the key change.
+    keyChange = String();
+    return nr;
+}
 
-    // If we've reached the end of the table, clear the keyCh_p
-    if (lastRow_p==nr)
-      keyChangeAtLastNext_p=String();
-
-    //# Adjust rownrs in case source table is already a RefTable.
-    Vector<uInt>& rownrs = *(itp->rowStorage());
-    sortTab_p->adjustRownrs (itp->nrow(), rownrs, False);
-    return itp;
+const std::vector<rownr_t>& BaseTableIterator::groupBoundaries()
+{
+    if (groups_p.empty()) {
+	rownr_t nr = sortTab_p->nrow();
+	String keyChange;
+	rownr_t row = 0;
+	while (row < nr) {
+	    groups_p.push_back (row);
+	    row = groupEnd (row, keyChange);
+	}
+	groups_p.push_back (nr);
+    }
+    return groups_p;
 }
 
 void
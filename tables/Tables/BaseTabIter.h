@@ -33,6 +33,7 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Utilities/Compare.h>
 #include <casacore/casa/Containers/Block.h>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -73,6 +74,10 @@ class String;
 // order and then creating a RefTable for each step containing the
 // rows for that iteration step. Each iteration step assembles the
 // rows with equal key values.
+// <br>The boundaries of all groups can also be determined in advance
+// (using <src>groupBoundaries</src>), so the groups can be handed out
+// in any order (e.g. to several threads by
+// <linkto class=ParallelTableIterator>ParallelTableIterator</linkto>).
 // </synopsis> 
 
 //# <todo asof="$DATE:$">
@@ -112,9 +117,22 @@ public:
     //  and organize associated iterations
     inline const String& keyChangeAtLastNext() const { return keyChangeAtLastNext_p; };
 
+    // Get the boundaries of all iteration groups.
+    // Element i gives the first row of group i in the sorted table;
+    // the last element gives the number of rows in the sorted table.
+    // They are determined on first use and kept.
+    const std::vector<rownr_t>& groupBoundaries();
+
+    // Make a table containing the rows of the given group.
+    BaseTable* group (uInt groupnr);
+
+    // Make a table containing all rows in iteration order.
+    // Each call gives a new table object.
+    BaseTable* sortedTable();
+
 protected:
     BaseTable*             sortTab_p;     //# Table sorted in iteration order
-    uInt                   lastRow_p;     //# last row used from reftab
+    rownr_t                lastRow_p;     //# last row used from reftab
     uInt                   nrkeys_p;      //# nr of columns in group
     String                 keyChangeAtLastNext_p;  //# name of column that terminated most recent next()
     PtrBlock<BaseColumn*>  colPtr_p;      //# pointer to column objects
@@ -129,6 +147,15 @@ private:
     // Declaring it private, makes it unusable.
     BaseTableIterator& operator= (const BaseTableIterator&);
 
+    // Find the end of the group starting at the given row, thus the first
+    // row with another key value. The name of the (slowest) column
+    // causing the key change is returned in <src>keyChange</src>.
+    rownr_t groupEnd (rownr_t startRow, String& keyChange);
+
+    // Make a RefTable containing the given rows of the sorted table.
+    RefTable* makeRefTable (rownr_t startRow, rownr_t endRow);
+
+    std::vector<rownr_t>   groups_p;      //# group boundaries
     Block<void*>           lastVal_p;     //# last value per column
     Block<void*>           curVal_p;      //# current value per column
 };
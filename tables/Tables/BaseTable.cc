@@ -30,10 +30,14 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/PlainTable.h>
 #include <casacore/tables/Tables/RefTable.h>
+#include <casacore/tables/Tables/ConcatTable.h>
 #include <casacore/tables/Tables/TableCopy.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprNodeRep.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/Tables/ColumnsIndex.h>
 #include <casacore/tables/Tables/BaseTabIter.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/tables/Tables/TableError.h>
@@ -52,14 +56,19 @@
 #include <casacore/casa/OS/File.h>
 #include <casacore/casa/OS/RegularFile.h>
 #include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <limits>
+#include <cmath>
+#include <vector>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 // The constructor of the derived class should call unmarkForDelete
 // when the construction ended succesfully.
-BaseTable::BaseTable (const String& name, int option, uInt nrrow)
+BaseTable::BaseTable (const String& name, int option, rownr_t nrrow)
 : nrlink_p    (0),
   nrrow_p     (nrrow),
   nrrowToAdd_p(0),
@@ -253,6 +262,12 @@ void BaseTable::flushTableInfo()
 
 
 void BaseTable::writeStart (AipsIO& ios, Bool bigEndian)
+{
+    writeStart (ios, bigEndian, False, 0, 0);
+}
+
+void BaseTable::writeStart (AipsIO& ios, Bool bigEndian, Bool sealed,
+                            uInt sealGeneration, uInt sealChecksum)
 {
     //# Check option.
     if (!openedForWrite()) {
@@ -265,20 +280,48 @@ void BaseTable::writeStart (AipsIO& ios, Bool bigEndian)
     ios.open (Table::fileName(name_p), ByteIO::New);
     //# Start the object as Table, so class Table can read it back.
     //# Version 2 (of PlainTable) does not have its own TableRecord anymore.
-    ios.putstart ("Table", 2);
-    ios << nrrow_p;
+    //# Version 3 contains the seal info; it is only used for a sealed
+    //# table, so other tables can be read by older software.
+    ios.putstart ("Table", sealed  ?  3 : 2);
+    //# The #rows is written as a uInt to remain readable by older software.
+    //# Only a ConcatTable can have more rows. It derives its #rows from
+    //# the tables it consists of when opened, so the maximum is written.
+    //# Other tables cannot have more rows, but check it to be sure.
+    if (nrrow_p > rownr_t(std::numeric_limits<uInt>::max())) {
+        if (dynamic_cast<ConcatTable*>(this) == 0) {
+            throw TableError ("Table " + name_p + " has more than 2**32-1"
+                              " rows, so it cannot be written");
+        }
+        ios << std::numeric_limits<uInt>::max();
+    } else {
+        ios << uInt(nrrow_p);
+    }
     //# Write endianity as a uInt, because older tables contain a uInt 0 here.
     uInt endian = 0;
     if (!bigEndian) {
       endian = 1;
     }
     ios << endian;              // 0=bigendian; 1=littleendian
+    if (sealed) {
+        ios << sealed << sealGeneration << sealChecksum;
+    }
     if (made && !isMarkedForDelete()) {
 	scratchCallback (False, name_p);
     }
 }
 
 //# End writing a table file.
+void BaseTable::readSealInfo (AipsIO& ios, uInt version, Bool& sealed,
+                              uInt& sealGeneration, uInt& sealChecksum)
+{
+    sealed = False;
+    sealGeneration = 0;
+    sealChecksum = 0;
+    if (version >= 3) {
+        ios >> sealed >> sealGeneration >> sealChecksum;
+    }
+}
+
 void BaseTable::writeEnd (AipsIO& ios)
 {
     ios.putend ();
@@ -440,11 +483,13 @@ void BaseTable::trueDeepCopy (const String& newName,
     //# Prepare the copy (do some extra checks).
     prepareCopyRename (absNewName, tableOption);
     // Create the new table and copy everything.
+    // The new table is locked permanently while being filled, so its
+    // columns can be filled in parallel.
     Table oldtab(ncThis);
     Table newtab = TableCopy::makeEmptyTable
                         (absNewName, dataManagerInfo, oldtab, Table::New,
 			 Table::EndianFormat(endianFormat), True, noRows,
-                         stopt);
+                         stopt, TableLock(TableLock::PermanentLockingWait));
     if (!noRows) {
       TableCopy::copyRows (newtab, oldtab);
     }
@@ -508,16 +553,23 @@ Bool BaseTable::isColumnStored (uInt columnIndex) const
     return getColumn(columnIndex)->isStored();
 }
 
+//# By default a table cannot be sealed.
+Bool BaseTable::isSealed() const
+    { return False; }
+void BaseTable::setSealed (Bool)
+    { throw (TableInvOper ("Table: cannot seal or unseal table " + name_p +
+                           "; only a plain table can")); }
+
 //# By default adding, etc. of rows and columns is not possible.
 Bool BaseTable::canAddRow() const
     { return False; }
 Bool BaseTable::canRemoveRow() const
     { return False; }
 
-void BaseTable::addRow (uInt, Bool)
+void BaseTable::addRow (rownr_t, Bool)
     { throw (TableInvOper ("Table: cannot add a row to table " + name_p)); }
 
-void BaseTable::removeRow (uInt)
+void BaseTable::removeRow (rownr_t)
     { throw (TableInvOper ("Table: cannot remove a row from table " + name_p)); }
 
 void BaseTable::removeRow (const Vector<uInt>& rownrs)
@@ -573,6 +625,7 @@ void BaseTable::addColumns (const TableDesc& desc, const Record& dmInfo,
 Vector<uInt> BaseTable::rowNumbers() const
 {
     AlwaysAssert (!isNull(), AipsError);
+    RefTable::checkRownr (nrow());          // row numbers are 32-bit
     Vector<uInt> vec(nrow());
     indgen (vec, (uInt)0);                  // store 0,1,... in it
     return vec;
@@ -639,7 +692,7 @@ BaseTable* BaseTable::doSort (PtrBlock<BaseColumn*>& sortCol,
     }
     //# Create a reference table.
     //# This table will NOT be in row order.
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     RefTable* resultTable = makeRefTable (False, nrrow);
     //# Now sort the table storing the row-numbers in the RefTable.
     //# Adjust rownrs in case source table is already a RefTable.
@@ -655,7 +708,7 @@ BaseTable* BaseTable::doSort (PtrBlock<BaseColumn*>& sortCol,
     return resultTable;
 }
 
-RefTable* BaseTable::makeRefTable (Bool rowOrder, uInt initialNrrow)
+RefTable* BaseTable::makeRefTable (Bool rowOrder, rownr_t initialNrrow)
 {
     RefTable* rtp = new RefTable(this, rowOrder, initialNrrow);
     return rtp;
@@ -666,7 +719,7 @@ RefTable* BaseTable::makeRefTable (Bool rowOrder, uInt initialNrrow)
 Bool BaseTable::adjustRownrs (uInt, Vector<uInt>&, Bool) const
     { return True; }
 
-BaseTable* BaseTable::select (uInt maxRow, uInt offset)
+BaseTable* BaseTable::select (rownr_t maxRow, uInt offset)
 {
     if (offset > nrow()) {
         offset = nrow();
@@ -677,6 +730,7 @@ BaseTable* BaseTable::select (uInt maxRow, uInt offset)
     if (offset == 0  &&  maxRow == nrow()) {
         return this;
     }
+    RefTable::checkRownr (offset + maxRow);
     Vector<uInt> rownrs(maxRow);
     indgen(rownrs, offset);
     return select(rownrs);
@@ -684,7 +738,7 @@ BaseTable* BaseTable::select (uInt maxRow, uInt offset)
 
 // Do the row selection.
 BaseTable* BaseTable::select (const TableExprNode& node,
-                              uInt maxRow, uInt offset)
+                              rownr_t maxRow, uInt offset, uInt nthreads)
 {
     // Check we don't deal with a null table.
     AlwaysAssert (!isNull(), AipsError);
@@ -714,27 +768,80 @@ BaseTable* BaseTable::select (const TableExprNode& node,
                            node.table().tableName() +
                            " is used on a differently sized table " + name_p));
     }
+    // Use a persistent index or a zone map if possible.
+    BaseTable* indexTable = selectByIndex (node, maxRow, offset);
+    if (indexTable == 0) {
+      indexTable = selectByZoneMap (node, maxRow, offset);
+    }
+    if (indexTable) {
+      return indexTable;
+    }
     //# Create a reference table, which will be in row order.
     //# Loop through all rows and add to reference table if true.
     //# Add the rownr of the root table (one may search a reference table).
     //# Adjust the row numbers to reflect row numbers in the root table.
+    //# If possible, the expression is evaluated column-at-a-time for
+    //# blocks of rows, otherwise row by row.
     SPtrHolder<RefTable> resultTable (makeRefTable (True, 0));
-    Bool val;
-    uInt nrrow = nrow();
-    TableExprId id;
-    for (uInt i=0; i<nrrow; i++) {
-      id.setRownr (i);
-      node.get (id, val);
-      if (val) {
-        if (offset == 0) {
-          resultTable->addRownr (i);                  // add row
-          // Stop if max #rows reached (note that maxRow==0 means no limit).
-          if (resultTable->nrow() == maxRow) {
-            break;
+    rownr_t nrrow = nrow();
+    uInt blockSize = (node.canGetBlock()  ?  4096 : 1);
+    if (nthreads == 0) {
+      nthreads = OMP::maxThreads();
+    }
+    //# Multiple threads are only used if all matching rows are needed.
+    //# Each thread evaluates a block of rows in a round of blocks, after
+    //# which the matching rows of the round are added in row order.
+    //# So no mask is needed for the entire table.
+    if (blockSize == 1  ||  maxRow != 0  ||  offset != 0) {
+      nthreads = 1;
+    }
+    rownr_t nblock = (nrrow + blockSize - 1) / blockSize;
+    nthreads = std::max (rownr_t(1), std::min (rownr_t(nthreads), nblock));
+    rownr_t roundSize = rownr_t(nthreads) * blockSize;
+    Block<Bool> vals(roundSize);
+    Bool done = False;
+    for (rownr_t first=0; first<nrrow && !done; first+=roundSize) {
+      uInt nrround = std::min (roundSize, nrrow-first);
+      if (nthreads == 1) {
+        node.getBoolBlock (first, nrround, vals.storage());
+      } else {
+        Int nb = (nrround + blockSize - 1) / blockSize;
+        String error;
+        Bool failed = False;
+#pragma omp parallel for num_threads(nthreads)
+        for (Int i=0; i<nb; ++i) {
+          uInt st = i*blockSize;
+          uInt nr = std::min (blockSize, nrround-st);
+          try {
+            node.getBoolBlock (first+st, nr, vals.storage() + st);
+          } catch (std::exception& x) {
+#pragma omp critical(BaseTable_select)
+            {
+              if (!failed) {
+                error  = x.what();
+                failed = True;
+              }
+            }
+          }
+        }
+        if (failed) {
+          throw TableError ("select expression on table " + name_p +
+                            " failed: " + error);
+        }
+      }
+      for (uInt i=0; i<nrround; ++i) {
+        if (vals[i]) {
+          if (offset == 0) {
+            resultTable->addRownr (first+i);          // add row
+            // Stop if max #rows reached (note that maxRow==0 means no limit).
+            if (resultTable->nrow() == maxRow) {
+              done = True;
+              break;
+            }
+          } else {
+            // Skip first offset matching rows.
+            offset--;
           }
-        } else {
-          // Skip first offset matching rows.
-          offset--;
         }
       }
     }
@@ -742,6 +849,272 @@ BaseTable* BaseTable::select (const TableExprNode& node,
     return resultTable.transfer();
 }
 
+// The comparison of a column with a constant usable for an index lookup.
+enum IndexCompare {IndexEQ, IndexGE, IndexGT, IndexLE, IndexLT};
+
+// Get the column compared with a constant in a comparison node.
+// The constant value is returned and the comparison is turned into
+// column OPER value.
+static const TableExprNodeColumn* indexComparison
+(const TableExprNodeRep* node, IndexCompare& oper, Double& value)
+{
+  TableExprNodeRep::OperType operType = node->operType();
+  if (operType != TableExprNodeRep::OtEQ  &&
+      operType != TableExprNodeRep::OtGE  &&
+      operType != TableExprNodeRep::OtGT) {
+    return 0;
+  }
+  const TableExprNodeBinary* binNode =
+    dynamic_cast<const TableExprNodeBinary*>(node);
+  if (binNode == 0) {
+    return 0;
+  }
+  const TableExprNodeRep* left  = binNode->getLeftChild();
+  const TableExprNodeRep* right = binNode->getRightChild();
+  Bool colLeft = (left->operType() == TableExprNodeRep::OtColumn);
+  if (!colLeft) {
+    std::swap (left, right);
+  }
+  const TableExprNodeColumn* colNode =
+    dynamic_cast<const TableExprNodeColumn*>(left);
+  if (colNode == 0  ||  !right->isConstant()  ||
+      right->valueType() != TableExprNodeRep::VTScalar  ||
+      (right->dataType() != TableExprNodeRep::NTInt  &&
+       right->dataType() != TableExprNodeRep::NTDouble)) {
+    return 0;
+  }
+  value = const_cast<TableExprNodeRep*>(right)->getDouble (0);
+  if (operType == TableExprNodeRep::OtEQ) {
+    oper = IndexEQ;
+  } else if (operType == TableExprNodeRep::OtGE) {
+    oper = (colLeft  ?  IndexGE : IndexLE);
+  } else {
+    oper = (colLeft  ?  IndexGT : IndexLT);
+  }
+  return colNode;
+}
+
+// Narrow the range [lower,upper] of a column with a comparison.
+static void combineBounds (IndexCompare oper, Double value,
+                           Double& lower, Bool& lowerIncl,
+                           Double& upper, Bool& upperIncl)
+{
+  if (oper == IndexEQ  ||  oper == IndexGE  ||  oper == IndexGT) {
+    if (value > lower  ||  (value == lower  &&  oper == IndexGT)) {
+      lower = value;
+      lowerIncl = (oper != IndexGT);
+    }
+  }
+  if (oper == IndexEQ  ||  oper == IndexLE  ||  oper == IndexLT) {
+    if (value < upper  ||  (value == upper  &&  oper == IndexLT)) {
+      upper = value;
+      upperIncl = (oper != IndexLT);
+    }
+  }
+}
+
+// Find the comparisons of columns with a constant in the AND-ed terms.
+static void indexComparisons (const TableExprNodeRep* node,
+                              std::vector<const TableExprNodeRep*>& terms)
+{
+  if (node->operType() == TableExprNodeRep::OtAND) {
+    const TableExprNodeBinary* andNode =
+      dynamic_cast<const TableExprNodeBinary*>(node);
+    if (andNode) {
+      indexComparisons (andNode->getLeftChild(), terms);
+      indexComparisons (andNode->getRightChild(), terms);
+    }
+  } else {
+    terms.push_back (node);
+  }
+}
+
+BaseTable* BaseTable::selectByIndex (const TableExprNode& node,
+                                     rownr_t maxRow, uInt offset)
+{
+  if (dynamic_cast<PlainTable*>(this) == 0) {
+    return 0;
+  }
+  std::vector<const TableExprNodeRep*> terms;
+  indexComparisons (node.getNodeRep(), terms);
+  // Use the first column having a valid persistent index; combine all
+  // comparisons of that column into a key range.
+  // The index is only read, never created or stored.
+  CountedPtr<ColumnsIndex> index;
+  String colName;
+  DataType dtype = TpOther;
+  Double lower = -std::numeric_limits<Double>::infinity();
+  Double upper =  std::numeric_limits<Double>::infinity();
+  Bool lowerIncl = True;
+  Bool upperIncl = True;
+  for (uInt i=0; i<terms.size(); ++i) {
+    IndexCompare oper;
+    Double value;
+    const TableExprNodeColumn* colNode =
+      indexComparison (terms[i], oper, value);
+    if (colNode == 0) {
+      continue;
+    }
+    const TableColumn& col = colNode->getColumn();
+    if (colName.empty()) {
+      DataType colType = col.columnDesc().dataType();
+      if (!col.columnDesc().isScalar()  ||  col.table().baseTablePtr() != this
+          ||  (colType != TpInt  &&  colType != TpDouble)) {
+        continue;
+      }
+      index = ColumnsIndex::getPersistent
+        (Table(this, False), Vector<String>(1, col.columnDesc().name()));
+      if (index.null()) {
+        continue;
+      }
+      colName = col.columnDesc().name();
+      dtype = colType;
+    } else if (col.columnDesc().name() != colName  ||
+               col.table().baseTablePtr() != this) {
+      continue;
+    }
+    combineBounds (oper, value, lower, lowerIncl, upper, upperIncl);
+  }
+  if (colName.empty()) {
+    return 0;
+  }
+  // Look up the key range in the index.
+  Record lowerKey, upperKey;
+  if (dtype == TpInt) {
+    // Turn the bounds into an inclusive integer range.
+    Double lowInt = (lowerIncl  ?  ceil(lower) : floor(lower) + 1);
+    Double uppInt = (upperIncl  ?  floor(upper) : ceil(upper) - 1);
+    lowInt = std::max (lowInt, Double(std::numeric_limits<Int>::min()));
+    uppInt = std::min (uppInt, Double(std::numeric_limits<Int>::max()));
+    if (lowInt > uppInt) {
+      return select (Vector<uInt>());
+    }
+    lowerKey.define (colName, Int(lowInt));
+    upperKey.define (colName, Int(uppInt));
+    lowerIncl = upperIncl = True;
+  } else {
+    lowerKey.define (colName, lower);
+    upperKey.define (colName, upper);
+  }
+  Vector<uInt> rows = index->getRowNumbers (lowerKey, upperKey,
+                                            lowerIncl, upperIncl);
+  // A scan is faster if many rows match.
+  if (rows.size() > nrow() / 2) {
+    return 0;
+  }
+  GenSort<uInt>::sort (rows);
+  return selectRows (node, rows, maxRow, offset);
+}
+
+BaseTable* BaseTable::selectByZoneMap (const TableExprNode& node,
+                                       rownr_t maxRow, uInt offset)
+{
+  if (dynamic_cast<PlainTable*>(this) == 0) {
+    return 0;
+  }
+  std::vector<const TableExprNodeRep*> terms;
+  indexComparisons (node.getNodeRep(), terms);
+  // Find the column compared with constants whose zone map leaves the
+  // fewest rows to be evaluated.
+  std::vector<String> colNames;
+  Vector<Bool> bestMask;
+  Vector<uInt> bestStartRows;
+  rownr_t bestCount = nrow() / 2 + 1;
+  for (uInt i=0; i<terms.size(); ++i) {
+    IndexCompare oper;
+    Double value;
+    const TableExprNodeColumn* colNode =
+      indexComparison (terms[i], oper, value);
+    if (colNode == 0  ||  !colNode->getColumn().columnDesc().isScalar()  ||
+        colNode->getColumn().table().baseTablePtr() != this) {
+      continue;
+    }
+    const String& colName = colNode->getColumn().columnDesc().name();
+    if (std::find (colNames.begin(), colNames.end(), colName) !=
+        colNames.end()) {
+      continue;
+    }
+    colNames.push_back (colName);
+    Vector<uInt> startRows;
+    Vector<Double> minValues, maxValues;
+    // Only use an existing zone map; a query must not create it.
+    if (! getColumn(colName)->getZoneMap (startRows, minValues, maxValues,
+                                          False)) {
+      continue;
+    }
+    // Combine all comparisons of this column into a range.
+    Double lower = -std::numeric_limits<Double>::infinity();
+    Double upper =  std::numeric_limits<Double>::infinity();
+    Bool lowerIncl = True;
+    Bool upperIncl = True;
+    for (uInt j=i; j<terms.size(); ++j) {
+      const TableExprNodeColumn* node2 =
+        indexComparison (terms[j], oper, value);
+      if (node2  &&  node2->getColumn().columnDesc().name() == colName  &&
+          node2->getColumn().table().baseTablePtr() == this) {
+        combineBounds (oper, value, lower, lowerIncl, upper, upperIncl);
+      }
+    }
+    // Determine the zones overlapping the range and their nr of rows.
+    uInt nzone = startRows.size();
+    Vector<Bool> mask(nzone);
+    rownr_t count = 0;
+    for (uInt z=0; z<nzone; ++z) {
+      mask[z] = !(maxValues[z] < lower  ||
+                  (maxValues[z] == lower  &&  !lowerIncl)  ||
+                  minValues[z] > upper  ||
+                  (minValues[z] == upper  &&  !upperIncl));
+      if (mask[z]) {
+        count += (z+1 < nzone  ?  startRows[z+1] : nrow()) - startRows[z];
+      }
+    }
+    if (count < bestCount) {
+      bestCount = count;
+      bestMask.reference (mask);
+      bestStartRows.reference (startRows);
+    }
+  }
+  // A scan is faster if many rows have to be evaluated.
+  if (bestMask.empty()) {
+    return 0;
+  }
+  Vector<uInt> rows(bestCount);
+  uInt nr = 0;
+  uInt nzone = bestStartRows.size();
+  for (uInt z=0; z<nzone; ++z) {
+    if (bestMask[z]) {
+      uInt endRow = (z+1 < nzone  ?  bestStartRows[z+1] : nrow());
+      for (uInt row=bestStartRows[z]; row<endRow; ++row) {
+        rows[nr++] = row;
+      }
+    }
+  }
+  return selectRows (node, rows, maxRow, offset);
+}
+
+BaseTable* BaseTable::selectRows (const TableExprNode& node,
+                                  const Vector<uInt>& rows,
+                                  rownr_t maxRow, uInt offset)
+{
+  SPtrHolder<RefTable> resultTable (makeRefTable (True, 0));
+  Bool val;
+  for (uInt i=0; i<rows.size(); ++i) {
+    node.get (TableExprId(rows[i]), val);
+    if (val) {
+      if (offset == 0) {
+        resultTable->addRownr (rows[i]);
+        if (resultTable->nrow() == maxRow) {
+          break;
+        }
+      } else {
+        offset--;
+      }
+    }
+  }
+  adjustRownrs (resultTable->nrow(), *(resultTable->rowStorage()), False);
+  return resultTable.transfer();
+}
+
 BaseTable* BaseTable::select (const Vector<uInt>& rownrs)
 {
     AlwaysAssert (!isNull(), AipsError);
@@ -1000,7 +1373,7 @@ Bool BaseTable::checkRemoveColumn (const Vector<String>& columnNames,
     return True;
 }
 
-void BaseTable::checkRowNumberThrow (uInt rownr) const
+void BaseTable::checkRowNumberThrow (rownr_t rownr) const
 {
     throw (TableError ("TableColumn: row number " + String::toString(rownr) +
 		       " exceeds #rows " +
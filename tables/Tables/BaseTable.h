@@ -101,7 +101,7 @@ class BaseTable
 public:
 
     // Initialize the object.
-    BaseTable (const String& tableName, int tableOption, uInt nrrow);
+    BaseTable (const String& tableName, int tableOption, rownr_t nrrow);
 
     virtual ~BaseTable();
 
@@ -130,6 +130,19 @@ public:
     // a subtable is used in another process.
     virtual Bool isMultiUsed(Bool checkSubTables) const = 0;
 
+    // Is the table sealed (i.e. immutable)?
+    // By default it is not.
+    virtual Bool isSealed() const;
+
+    // Seal or unseal the table.
+    // By default it is not possible (only a PlainTable can be sealed).
+    virtual void setSealed (Bool seal);
+
+    // Read the seal info following the endian format in the table file.
+    // Only version 3 files contain it; otherwise the table is not sealed.
+    static void readSealInfo (AipsIO&, uInt version, Bool& sealed,
+                              uInt& sealGeneration, uInt& sealChecksum);
+
     // Get the locking info.
     virtual const TableLock& lockOptions() const = 0;
 
@@ -294,7 +307,7 @@ public:
     virtual void flushTableInfo();
 
     // Get number of rows.
-    uInt nrow() const
+    rownr_t nrow() const
 	{ return nrrow_p; }
 
     // Get a column object using its index.
@@ -308,7 +321,7 @@ public:
 
     // Add one or more rows and possibly initialize them.
     // This will fail for tables not supporting addition of rows.
-    virtual void addRow (uInt nrrow = 1, Bool initialize = True);
+    virtual void addRow (rownr_t nrrow = 1, Bool initialize = True);
 
     // Test if it is possible to remove a row from this table.
     virtual Bool canRemoveRow() const;
@@ -330,7 +343,7 @@ public:
     // row 21 into row 20.
     // </note>
     // <group>
-    virtual void removeRow (uInt rownr);
+    virtual void removeRow (rownr_t rownr);
     void removeRow (const Vector<uInt>& rownrs);
     // </group>
 
@@ -341,10 +354,14 @@ public:
     // Select rows using the given expression (which can be null).
     // Skip first <src>offset</src> matching rows.
     // Return at most <src>maxRow</src> matching rows.
-    BaseTable* select (const TableExprNode&, uInt maxRow, uInt offset);
+    // The expression is evaluated using <src>nthreads</src> threads
+    // (0 means OMP::maxThreads()) if it can be evaluated in blocks of rows
+    // and if all matching rows are to be returned.
+    BaseTable* select (const TableExprNode&, rownr_t maxRow, uInt offset,
+                       uInt nthreads=1);
 
     // Select maxRow rows and skip first offset rows. maxRow=0 means all.
-    BaseTable* select (uInt maxRow, uInt offset);
+    BaseTable* select (rownr_t maxRow, uInt offset);
 
     // Select rows using a vector of row numbers.
     BaseTable* select (const Vector<uInt>& rownrs);
@@ -463,11 +480,11 @@ public:
 			       int sortOption);
 
     // Create a RefTable object.
-    RefTable* makeRefTable (Bool rowOrder, uInt initialNrrow);
+    RefTable* makeRefTable (Bool rowOrder, rownr_t initialNrrow);
 
     // Check if the row number is valid.
     // It throws an exception if out of range.
-    void checkRowNumber (uInt rownr) const
+    void checkRowNumber (rownr_t rownr) const
         { if (rownr >= nrrow_p + nrrowToAdd_p) checkRowNumberThrow (rownr); }
 
     // Get the table's trace-id.
@@ -477,8 +494,8 @@ public:
 
 protected:
     uInt           nrlink_p;            //# #references to this table
-    uInt           nrrow_p;             //# #rows in this table
-    uInt           nrrowToAdd_p;        //# #rows to be added
+    rownr_t        nrrow_p;             //# #rows in this table
+    rownr_t        nrrowToAdd_p;        //# #rows to be added
     TableDesc*     tdescPtr_p;          //# Pointer to table description
     String         name_p;              //# table name
     int            option_p;            //# Table constructor option
@@ -523,7 +540,14 @@ protected:
 
     // Start writing a table. It does a putstart and writes <src>nrrow_p</src>.
     // It should be ended by calling <src>writeEnd</src>.
+    // If the table is sealed, the seal info is written as well (requiring
+    // version 3). Otherwise version 2 is written, so the table can still
+    // be read by older software.
+    // <group>
     void writeStart (AipsIO&, Bool bigEndian);
+    void writeStart (AipsIO&, Bool bigEndian, Bool sealed,
+                     uInt sealGeneration, uInt sealChecksum);
+    // </group>
 
     // End writing a table.
     void writeEnd (AipsIO&);
@@ -558,7 +582,27 @@ private:
                          Bool cOrder) const;
 
     // Throw an exception for checkRowNumber.
-    void checkRowNumberThrow (uInt rownr) const;
+    void checkRowNumberThrow (rownr_t rownr) const;
+
+    // Select rows using a persistent ColumnsIndex (of a plain table) on a
+    // column compared with constants in the AND-ed terms of the expression.
+    // The expression is evaluated for the rows found in the index.
+    // A null pointer is returned if no such index can be used.
+    BaseTable* selectByIndex (const TableExprNode&, rownr_t maxRow,
+                              uInt offset);
+
+    // Select rows using the zone map (minimum and maximum per bucket) of
+    // a column compared with constants in the AND-ed terms of the
+    // expression. The expression is only evaluated for the rows in the
+    // zones overlapping the range of the comparisons.
+    // A null pointer is returned if no zone map can be used.
+    BaseTable* selectByZoneMap (const TableExprNode&, rownr_t maxRow,
+                                uInt offset);
+
+    // Evaluate the expression for the given (ascending) rows and select
+    // the rows matching it.
+    BaseTable* selectRows (const TableExprNode&, const Vector<uInt>& rows,
+                           rownr_t maxRow, uInt offset);
 
     // Check if the tables combined in a logical operation have the
     // same root.
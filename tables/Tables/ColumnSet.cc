@@ -111,10 +111,11 @@ void ColumnSet::removeLastDataManager()
     seqCount_p--;
 }
 
-void ColumnSet::initDataManagers (uInt nrrow, Bool bigEndian,
+void ColumnSet::initDataManagers (rownr_t nrrow, Bool bigEndian,
                                   const TSMOption& tsmOption,
                                   Table& tab)
 {
+    checkNrrow (nrrow);
     uInt i;
     for (i=0; i<blockDataMan_p.nelements(); i++) {
 	BLOCKDATAMANVAL(i)->setEndian (bigEndian);
@@ -217,6 +218,14 @@ uInt ColumnSet::resync (uInt nrrow, Bool forceSync)
                     nrrow = nrr;
                 }
 		dataManChanged_p[i] = False;
+                // The data of its columns may have been changed by
+                // another process.
+                for (uInt j=0; j<colMap_p.ndefined(); j++) {
+                    if (COLMAPVAL(j)->dataManager() == BLOCKDATAMANVAL(i)) {
+                        COLMAPVAL(j)->columnChanged (0);
+                        COLMAPVAL(j)->columnFlushed();
+                    }
+                }
 	    }
 	}
 	nrrow_p = nrrow;
@@ -276,8 +285,9 @@ Bool ColumnSet::canRenameColumn (const String& columnName) const
 
 
 //# Add rows to all data managers.
-void ColumnSet::addRow (uInt nrrow)
+void ColumnSet::addRow (rownr_t nrrow)
 {
+    checkNrrow (nrrow_p + nrrow);
     // First add row to storage managers, thereafter to virtual engines.
     for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
         if (BLOCKDATAMANVAL(i)->isStorageManager()) {
@@ -291,8 +301,17 @@ void ColumnSet::addRow (uInt nrrow)
     }
     nrrow_p += nrrow;
 }
+void ColumnSet::checkNrrow (rownr_t nrrow) const
+{
+    if (nrrow > std::numeric_limits<uInt>::max()) {
+        throw TableError ("Table " + baseTablePtr_p->tableName() + " cannot"
+                          " have more than 2**32-1 rows; use a ConcatTable"
+                          " to combine tables");
+    }
+}
+
 //# Remove a row from all data managers.
-void ColumnSet::removeRow (uInt rownr)
+void ColumnSet::removeRow (rownr_t rownr)
 {
     if (!canRemoveRow()) {
 	throw (TableInvOper ("Rows cannot be removed from table " +
@@ -308,6 +327,10 @@ void ColumnSet::removeRow (uInt rownr)
 	BLOCKDATAMANVAL(i)->removeRow (rownr);
     }
     nrrow_p--;
+    // The rows after the removed one have shifted.
+    for (uInt i=0; i<colMap_p.ndefined(); i++) {
+	COLMAPVAL(i)->columnChanged (rownr);
+    }
 }
 
 
@@ -714,7 +737,7 @@ Record ColumnSet::dataManagerInfo (Bool virtualOnly) const
 
 
 //# Initialize rows.
-void ColumnSet::initialize (uInt startRow, uInt endRow)
+void ColumnSet::initialize (rownr_t startRow, rownr_t endRow)
 {
     for (uInt i=0; i<colMap_p.ndefined(); i++) {
 	getColumn(i)->initialize (startRow, endRow);
@@ -818,6 +841,10 @@ Bool ColumnSet::putFile (Bool writeTable, AipsIO& ios,
     if (multiFile_p) {
       multiFile_p->flush();
     }
+    //# The columns do not have unflushed changes anymore.
+    for (i=0; i<colMap_p.ndefined(); i++) {
+	COLMAPVAL(i)->columnFlushed();
+    }
     return written;
 }
 
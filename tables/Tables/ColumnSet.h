@@ -128,7 +128,7 @@ public:
     // It creates the data manager column objects for each column
     // and it allows the data managers to link themselves to the
     // Table object and to initialize themselves.
-    void initDataManagers (uInt nrrow, Bool bigEndian,
+    void initDataManagers (rownr_t nrrow, Bool bigEndian,
                            const TSMOption& tsmOption,
                            Table& tab);
 
@@ -171,11 +171,15 @@ public:
     Bool canRenameColumn (const String& columnName) const;
 
     // Add rows to all data managers.
-    void addRow (uInt nrrow);
+    void addRow (rownr_t nrrow);
 
     // Remove a row from all data managers.
     // It will throw an exception if not possible.
-    void removeRow (uInt rownr);
+    void removeRow (rownr_t rownr);
+
+    // Check if the number of rows fits in the data managers, which
+    // use 32-bit row numbers. An exception is thrown if not.
+    void checkNrrow (rownr_t nrrow) const;
 
     // Remove the columns from the map and the data manager.
     void removeColumn (const Vector<String>& columnNames);
@@ -200,7 +204,7 @@ public:
     // </group>
 
     // Get nr of rows.
-    uInt nrow() const;
+    rownr_t nrow() const;
 
     // Get the actual table description.
     TableDesc actualTableDesc() const;
@@ -214,7 +218,7 @@ public:
       { return baseTablePtr_p->traceId(); }
 
     // Initialize rows startRownr till endRownr (inclusive).
-    void initialize (uInt startRownr, uInt endRownr);
+    void initialize (rownr_t startRownr, rownr_t endRownr);
 
     // Write all the data and let the data managers flush their data.
     // This function is called when a table gets written (i.e. flushed).
@@ -329,7 +333,7 @@ private:
 
 
 
-inline uInt ColumnSet::nrow() const
+inline rownr_t ColumnSet::nrow() const
 {
     return nrrow_p;
 }
@@ -36,7 +36,17 @@
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/Copy.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Utilities/ValType.h>
+#include <casacore/casa/Arrays/ArrayIO.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/DirectoryIterator.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <algorithm>
+#include <ctime>
+#include <limits>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -44,7 +54,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 ColumnsIndex::ColumnsIndex (const Table& table, const String& columnName,
 			    Compare* compareFunction, Bool noSort)
 : itsLowerKeyPtr (0),
-  itsUpperKeyPtr (0)
+  itsUpperKeyPtr (0),
+  itsPersistent  (False),
+  itsNeedWrite   (False)
 {
   Vector<String> columnNames(1);
   columnNames(0) = columnName;
@@ -54,17 +66,30 @@ ColumnsIndex::ColumnsIndex (const Table& table, const String& columnName,
 ColumnsIndex::ColumnsIndex (const Table& table,
 			    const Vector<String>& columnNames,
 			    Compare* compareFunction, Bool noSort)
+: itsLowerKeyPtr (0),
+  itsUpperKeyPtr (0),
+  itsPersistent  (False),
+  itsNeedWrite   (False)
 {
   create (table, columnNames, compareFunction, noSort);
 }
 
 ColumnsIndex::ColumnsIndex (const ColumnsIndex& that)
 : itsLowerKeyPtr (0),
-  itsUpperKeyPtr (0)
+  itsUpperKeyPtr (0),
+  itsPersistent  (False),
+  itsNeedWrite   (False)
 {
   copy (that);
 }
 
+ColumnsIndex::ColumnsIndex()
+: itsLowerKeyPtr (0),
+  itsUpperKeyPtr (0),
+  itsPersistent  (False),
+  itsNeedWrite   (False)
+{}
+
 ColumnsIndex::~ColumnsIndex()
 {
   deleteObjects();
@@ -84,6 +109,8 @@ void ColumnsIndex::copy (const ColumnsIndex& that)
     itsNrrow   = itsTable.nrow();
     itsNoSort  = that.itsNoSort;
     itsCompare = that.itsCompare;
+    itsPersistent = False;
+    itsNeedWrite  = False;
     makeObjects (that.itsLowerKeyPtr->description());
   }
 }
@@ -180,12 +207,17 @@ void ColumnsIndex::addColumnToDesc (RecordDesc& description,
   description.addField (columnDesc.name(), dataType);
 }
 
-void ColumnsIndex::create (const Table& table,
+Bool ColumnsIndex::create (const Table& table,
 			   const Vector<String>& columnNames,
 			   Compare* compareFunction,
-			   Bool noSort)
+			   Bool noSort, Bool onlyPersistent)
 {
   itsTable = table;
+  // The index holds 32-bit row numbers.
+  if (itsTable.nrow() > rownr_t(std::numeric_limits<uInt>::max())) {
+    throw (TableError ("ColumnsIndex: table " + itsTable.tableName() +
+                       " has more than 2**32-1 rows"));
+  }
   itsNrrow = itsTable.nrow();
   itsCompare = (compareFunction == 0  ?  compare : compareFunction);
   itsNoSort = noSort;
@@ -198,7 +230,15 @@ void ColumnsIndex::create (const Table& table,
 		     TableColumn (itsTable, columnNames(i)));
   }
   makeObjects (description);
-  readData();
+  // Use a persistent index if it is still valid.
+  itsPersistent = hasPersistent (itsTable, columnNames);
+  if (!itsPersistent  ||  !readIndex()) {
+    if (onlyPersistent) {
+      return False;
+    }
+    readData();
+  }
+  return True;
 }
 	    
 void ColumnsIndex::makeObjects (const RecordDesc& description)
@@ -219,7 +259,13 @@ void ColumnsIndex::makeObjects (const RecordDesc& description)
   itsUpperFields.set (static_cast<void*>(0));
   itsColumnChanged.resize (nrfield, False, False);
   itsColumnChanged.set (True);
+  itsGenerations.resize (nrfield, False, False);
+  itsGenerations.set (0);
   itsChanged = True;
+  itsColumns.resize (nrfield);
+  for (uInt i=0; i<nrfield; i++) {
+    itsColumns[i].attach (itsTable, description.name(i));
+  }
   // Create the correct column object for each field.
   // Also create a RecordFieldPtr object for each Key.
   // This makes a fast data copy possible.
@@ -306,19 +352,42 @@ void ColumnsIndex::readData()
 {
   // Acquire a lock if needed.
   TableLocker locker(itsTable, FileLocker::Read);
+  uInt oldNrrow = itsNrrow;
   uInt nrrow = itsTable.nrow();
+  // Use the change generations of the columns (if tracked) to find out
+  // which columns have changed. If only rows have been added, only the
+  // data of those rows have to be read.
+  Bool tracked = (nrrow >= oldNrrow);
+  uInt nrfield = itsDataTypes.nelements();
+  for (uInt i=0; i<nrfield; i++) {
+    uInt64 generation = itsColumns[i].changeGeneration();
+    if (generation == 0) {
+      tracked = False;
+    } else if (generation != itsGenerations[i]  &&
+               itsColumns[i].lowestRowChanged(itsGenerations[i]) < oldNrrow) {
+      itsColumnChanged[i] = True;
+      itsChanged = True;
+    }
+  }
   if (nrrow != itsNrrow) {
-    itsColumnChanged.set (True);
+    if (!tracked) {
+      itsColumnChanged.set (True);
+    }
     itsChanged = True;
     itsNrrow = nrrow;
   }
   if (!itsChanged) {
     return;
   }
+  Bool onlyAdded = True;
+  for (uInt i=0; i<nrfield; i++) {
+    if (itsColumnChanged[i]) {
+      onlyAdded = False;
+    }
+  }
   Sort sort;
   Bool deleteIt;
   const RecordDesc& desc = itsLowerKeyPtr->description();
-  uInt nrfield = itsDataTypes.nelements();
   for (uInt i=0; i<nrfield; i++) {
     const String& name = desc.name(i);
     switch (itsDataTypes[i]) {
@@ -327,6 +396,8 @@ void ColumnsIndex::readData()
       Vector<Bool>* vecptr = (Vector<Bool>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Bool>(itsTable, name).getColumn (*vecptr, True);
+      } else if (itsNrrow > oldNrrow) {
+	readAddedRows (itsTable, name, *vecptr, oldNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -337,6 +408,8 @@ void ColumnsIndex::readData()
       Vector<uChar>* vecptr = (Vector<uChar>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<uChar>(itsTable, name).getColumn (*vecptr, True);
+      } else if (itsNrrow > oldNrrow) {
+	readAddedRows (itsTable, name, *vecptr, oldNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -347,6 +420,8 @@ void ColumnsIndex::readData()
       Vector<Short>* vecptr = (Vector<Short>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Short>(itsTable, name).getColumn (*vecptr, True);
+      } else if (itsNrrow > oldNrrow) {
+	readAddedRows (itsTable, name, *vecptr, oldNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -357,6 +432,8 @@ void ColumnsIndex::readData()
       Vector<Int>* vecptr = (Vector<Int>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Int>(itsTable, name).getColumn (*vecptr, True);
+      } else if (itsNrrow > oldNrrow) {
+	readAddedRows (itsTable, name, *vecptr, oldNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -367,6 +444,8 @@ void ColumnsIndex::readData()
       Vector<uInt>* vecptr = (Vector<uInt>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<uInt>(itsTable, name).getColumn (*vecptr, True);
+      } else if (itsNrrow > oldNrrow) {
+	readAddedRows (itsTable, name, *vecptr, oldNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -377,6 +456,8 @@ void ColumnsIndex::readData()
       Vector<Float>* vecptr = (Vector<Float>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Float>(itsTable, name).getColumn (*vecptr, True);
+      } else if (itsNrrow > oldNrrow) {
+	readAddedRows (itsTable, name, *vecptr, oldNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -387,6 +468,8 @@ void ColumnsIndex::readData()
       Vector<Double>* vecptr = (Vector<Double>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Double>(itsTable, name).getColumn (*vecptr, True);
+      } else if (itsNrrow > oldNrrow) {
+	readAddedRows (itsTable, name, *vecptr, oldNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -397,6 +480,8 @@ void ColumnsIndex::readData()
       Vector<Complex>* vecptr = (Vector<Complex>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<Complex>(itsTable, name).getColumn (*vecptr, True);
+      } else if (itsNrrow > oldNrrow) {
+	readAddedRows (itsTable, name, *vecptr, oldNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -407,6 +492,8 @@ void ColumnsIndex::readData()
       Vector<DComplex>* vecptr = (Vector<DComplex>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<DComplex>(itsTable, name).getColumn (*vecptr, True);
+      } else if (itsNrrow > oldNrrow) {
+	readAddedRows (itsTable, name, *vecptr, oldNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -417,6 +504,8 @@ void ColumnsIndex::readData()
       Vector<String>* vecptr = (Vector<String>*)itsDataVectors[i];
       if (itsColumnChanged[i]) {
 	ScalarColumn<String>(itsTable, name).getColumn (*vecptr, True);
+      } else if (itsNrrow > oldNrrow) {
+	readAddedRows (itsTable, name, *vecptr, oldNrrow);
       }
       itsData[i] = vecptr->getStorage (deleteIt);
       sort.sortKey (itsData[i], desc.type(i));
@@ -429,18 +518,120 @@ void ColumnsIndex::readData()
   }
   // Sort the data if needed.
   // Otherwise fill the index vector with 0..n.
-  itsDataIndex.resize (itsNrrow);
-  if (!itsNoSort) {
-    sort.sort (itsDataIndex, itsNrrow);
-  } else {
+  // If only rows were added, they are merged into the sorted index.
+  if (itsNoSort) {
+    itsDataIndex.resize (itsNrrow);
     indgen (itsDataIndex);
+  } else if (onlyAdded) {
+    mergeRows (oldNrrow);
+  } else {
+    itsDataIndex.resize (itsNrrow);
+    sort.sort (itsDataIndex, itsNrrow);
   }
   // Determine all unique keys (itsUniqueIndex will contain the index of
   // each first unique entry in itsDataIndex).
   sort.unique (itsUniqueIndex, itsDataIndex);
   itsDataInx = itsDataIndex.getStorage (deleteIt);
   itsUniqueInx = itsUniqueIndex.getStorage (deleteIt);
+  for (uInt i=0; i<nrfield; i++) {
+    itsGenerations[i] = itsColumns[i].changeGeneration();
+  }
   itsChanged = False;
+  itsNeedWrite = itsPersistent;
+}
+
+template <typename T>
+void ColumnsIndex::readAddedRows (const Table& table, const String& name,
+                                  Vector<T>& vec, uInt oldNrrow)
+{
+  ScalarColumn<T> column(table, name);
+  uInt nrrow = column.nrow();
+  vec.resize (nrrow, True);
+  Vector<T> added (vec(Slice(oldNrrow, nrrow-oldNrrow)));
+  column.getColumnRange (Slicer(IPosition(1,oldNrrow),
+                                IPosition(1,nrrow-oldNrrow)), added);
+}
+
+void ColumnsIndex::mergeRows (uInt oldNrrow)
+{
+  // Sort the added rows.
+  uInt nradd = itsNrrow - oldNrrow;
+  Sort sort;
+  for (uInt i=0; i<itsData.nelements(); i++) {
+    DataType dtype = DataType(itsDataTypes[i]);
+    sort.sortKey (static_cast<const char*>(itsData[i]) +
+                  oldNrrow * ValType::getTypeSize(dtype), dtype);
+  }
+  Vector<uInt> addIndex;
+  sort.sort (addIndex, nradd);
+  // Merge them with the old rows (which go first for equal keys).
+  Vector<uInt> index(itsNrrow);
+  uInt i=0;
+  uInt j=0;
+  uInt k=0;
+  while (i < oldNrrow  &&  j < nradd) {
+    uInt row = oldNrrow + addIndex[j];
+    if (compareData (itsData, itsDataTypes, itsDataIndex[i], row) <= 0) {
+      index[k++] = itsDataIndex[i++];
+    } else {
+      index[k++] = row;
+      j++;
+    }
+  }
+  while (i < oldNrrow) {
+    index[k++] = itsDataIndex[i++];
+  }
+  while (j < nradd) {
+    index[k++] = oldNrrow + addIndex[j++];
+  }
+  itsDataIndex.reference (index);
+}
+
+Int ColumnsIndex::compareData (const Block<void*>& dataPtrs,
+                               const Block<Int>& dataTypes,
+                               uInt index1, uInt index2)
+{
+  for (uInt i=0; i<dataPtrs.nelements(); i++) {
+    Int cmp = 0;
+    switch (dataTypes[i]) {
+    case TpBool:
+      cmp = compareValues<Bool> (dataPtrs[i], index1, index2);
+      break;
+    case TpUChar:
+      cmp = compareValues<uChar> (dataPtrs[i], index1, index2);
+      break;
+    case TpShort:
+      cmp = compareValues<Short> (dataPtrs[i], index1, index2);
+      break;
+    case TpInt:
+      cmp = compareValues<Int> (dataPtrs[i], index1, index2);
+      break;
+    case TpUInt:
+      cmp = compareValues<uInt> (dataPtrs[i], index1, index2);
+      break;
+    case TpFloat:
+      cmp = compareValues<Float> (dataPtrs[i], index1, index2);
+      break;
+    case TpDouble:
+      cmp = compareValues<Double> (dataPtrs[i], index1, index2);
+      break;
+    case TpComplex:
+      cmp = compareValues<Complex> (dataPtrs[i], index1, index2);
+      break;
+    case TpDComplex:
+      cmp = compareValues<DComplex> (dataPtrs[i], index1, index2);
+      break;
+    case TpString:
+      cmp = compareValues<String> (dataPtrs[i], index1, index2);
+      break;
+    default:
+      throw (TableError ("ColumnsIndex: unknown data type"));
+    }
+    if (cmp != 0) {
+      return cmp;
+    }
+  }
+  return 0;
 }
 
 uInt ColumnsIndex::bsearch (Bool& found, const Block<void*>& fieldPtrs) const
@@ -704,6 +895,280 @@ void ColumnsIndex::setChanged (const String& columnName)
   }
 }
 
+void ColumnsIndex::makePersistent()
+{
+  if (! isPlainTable (itsTable, columnNames())) {
+    throw TableError ("ColumnsIndex: only an index on a plain table "
+                      "can be made persistent");
+  }
+  itsPersistent = True;
+  readData();
+  writeIndex();
+}
+
+void ColumnsIndex::flush()
+{
+  if (itsPersistent  &&  itsNeedWrite) {
+    writeIndex();
+  }
+}
+
+CountedPtr<ColumnsIndex> ColumnsIndex::getPersistent
+                                     (const Table& table,
+                                      const Vector<String>& columnNames)
+{
+  CountedPtr<ColumnsIndex> index;
+  if (hasPersistent (table, columnNames)) {
+    index = new ColumnsIndex();
+    if (! index->create (table, columnNames, 0, False, True)) {
+      index = CountedPtr<ColumnsIndex>();
+    }
+  }
+  return index;
+}
+
+Bool ColumnsIndex::hasPersistent (const Table& table,
+                                  const Vector<String>& columnNames)
+{
+  return isPlainTable (table, columnNames)  &&
+         File(indexFileName (table, columnNames)).exists();
+}
+
+Bool ColumnsIndex::isPlainTable (const Table& table,
+                                 const Vector<String>& columnNames)
+{
+  // Only the columns of a plain table track their changes.
+  if (table.tableType() != Table::Plain  ||  !table.isRootTable()) {
+    return False;
+  }
+  for (uInt i=0; i<columnNames.size(); i++) {
+    if (TableColumn(table, columnNames[i]).changeGeneration() == 0) {
+      return False;
+    }
+  }
+  return True;
+}
+
+void ColumnsIndex::removePersistent (const Table& table,
+                                     const Vector<String>& columnNames)
+{
+  if (hasPersistent (table, columnNames)) {
+    RegularFile(indexFileName (table, columnNames)).remove();
+  }
+}
+
+String ColumnsIndex::indexFileName (const Table& table,
+                                    const Vector<String>& columnNames)
+{
+  String name = table.tableName() + "/table.index_";
+  for (uInt i=0; i<columnNames.size(); i++) {
+    if (i > 0) {
+      name += ',';
+    }
+    name += columnNames[i];
+  }
+  return name;
+}
+
+uInt ColumnsIndex::tableFilesChecksum (const String& tableName,
+                                       uInt& lastTime)
+{
+  // Use the names, sizes and modification times of the files in the table
+  // directory (in sorted order). table.dat and table.lock are also
+  // written if the data in the other files do not change, while the
+  // number of rows is checked separately.
+  std::vector<String> names;
+  DirectoryIterator iter ((Directory(tableName)));
+  while (! iter.pastEnd()) {
+    names.push_back (iter.name());
+    iter++;
+  }
+  std::sort (names.begin(), names.end());
+  lastTime = 0;
+  // Use a 32-bit FNV-1a hash.
+  uInt hash = 2166136261u;
+  for (uInt i=0; i<names.size(); ++i) {
+    if (names[i] == "table.dat"  ||  names[i] == "table.lock"  ||
+        names[i].startsWith ("table.index_")) {
+      continue;
+    }
+    File file(tableName + '/' + names[i]);
+    if (! file.isRegular()) {
+      continue;
+    }
+    uInt mtime = file.modifyTime();
+    lastTime = std::max (lastTime, mtime);
+    String str = names[i] + '\0' +
+                 String::toString (RegularFile(file.path()).size()) + '\0' +
+                 String::toString (mtime);
+    for (uInt j=0; j<str.size(); ++j) {
+      hash = (hash ^ uChar(str[j])) * 16777619u;
+    }
+  }
+  return hash;
+}
+
+void ColumnsIndex::writeIndex()
+{
+  // Write the data first, so the checksum is taken from the final files.
+  if (itsTable.isWritable()) {
+    itsTable.flush();
+  }
+  uInt lastTime;
+  uInt checksum = tableFilesChecksum (itsTable.tableName(), lastTime);
+  // A file changed in the current second might change again unnoticed,
+  // so the index is marked invalid in that case.
+  Bool valid = (lastTime < uInt(std::time(0)));
+  // Write into a temporary file which replaces the index file, so
+  // other processes never see a partly written index.
+  Vector<String> names = columnNames();
+  String fileName = indexFileName (itsTable, names);
+  String tmpName = File::newUniqueName (itsTable.tableName(),
+                                        "table.index_tmp").absoluteName();
+  {
+    AipsIO aio(tmpName, ByteIO::New);
+    aio.putstart ("ColumnsIndex", 1);
+    aio << names << itsNrrow << checksum << valid << itsNoSort;
+    for (uInt i=0; i<itsDataTypes.nelements(); i++) {
+      aio << itsDataTypes[i];
+      switch (itsDataTypes[i]) {
+      case TpBool:
+        aio << *(Vector<Bool>*)itsDataVectors[i];
+        break;
+      case TpUChar:
+        aio << *(Vector<uChar>*)itsDataVectors[i];
+        break;
+      case TpShort:
+        aio << *(Vector<Short>*)itsDataVectors[i];
+        break;
+      case TpInt:
+        aio << *(Vector<Int>*)itsDataVectors[i];
+        break;
+      case TpUInt:
+        aio << *(Vector<uInt>*)itsDataVectors[i];
+        break;
+      case TpFloat:
+        aio << *(Vector<Float>*)itsDataVectors[i];
+        break;
+      case TpDouble:
+        aio << *(Vector<Double>*)itsDataVectors[i];
+        break;
+      case TpComplex:
+        aio << *(Vector<Complex>*)itsDataVectors[i];
+        break;
+      case TpDComplex:
+        aio << *(Vector<DComplex>*)itsDataVectors[i];
+        break;
+      case TpString:
+        aio << *(Vector<String>*)itsDataVectors[i];
+        break;
+      default:
+        throw (TableError ("ColumnsIndex: unknown data type"));
+      }
+    }
+    aio << itsDataIndex << itsUniqueIndex;
+    aio.putend();
+  }
+  RegularFile(tmpName).move (fileName);
+  itsNeedWrite = False;
+}
+
+Bool ColumnsIndex::readIndex()
+{
+  // The table is not flushed, because reading must not write. So the
+  // index cannot be used if the columns have unflushed changes, because
+  // the table files do not reflect them.
+  TableLocker locker(itsTable, FileLocker::Read);
+  for (uInt i=0; i<itsColumns.size(); i++) {
+    if (itsColumns[i].changeGeneration() !=
+        itsColumns[i].flushedGeneration()) {
+      return False;
+    }
+  }
+  Vector<String> names = columnNames();
+  try {
+    AipsIO aio(indexFileName (itsTable, names));
+    aio.getstart ("ColumnsIndex");
+    Vector<String> fileNames;
+    uInt nrrow, checksum;
+    Bool valid, noSort;
+    aio >> fileNames >> nrrow >> checksum >> valid >> noSort;
+    uInt lastTime;
+    if (!valid  ||  noSort != itsNoSort  ||  nrrow != itsTable.nrow()  ||
+        fileNames.size() != names.size()  ||  !allEQ (fileNames, names)  ||
+        checksum != tableFilesChecksum (itsTable.tableName(), lastTime)) {
+      return False;
+    }
+    Bool deleteIt;
+    for (uInt i=0; i<itsDataTypes.nelements(); i++) {
+      Int dtype;
+      aio >> dtype;
+      if (dtype != itsDataTypes[i]) {
+        return False;
+      }
+      switch (dtype) {
+      case TpBool:
+        aio >> *(Vector<Bool>*)itsDataVectors[i];
+        itsData[i] = ((Vector<Bool>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpUChar:
+        aio >> *(Vector<uChar>*)itsDataVectors[i];
+        itsData[i] = ((Vector<uChar>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpShort:
+        aio >> *(Vector<Short>*)itsDataVectors[i];
+        itsData[i] = ((Vector<Short>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpInt:
+        aio >> *(Vector<Int>*)itsDataVectors[i];
+        itsData[i] = ((Vector<Int>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpUInt:
+        aio >> *(Vector<uInt>*)itsDataVectors[i];
+        itsData[i] = ((Vector<uInt>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpFloat:
+        aio >> *(Vector<Float>*)itsDataVectors[i];
+        itsData[i] = ((Vector<Float>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpDouble:
+        aio >> *(Vector<Double>*)itsDataVectors[i];
+        itsData[i] = ((Vector<Double>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpComplex:
+        aio >> *(Vector<Complex>*)itsDataVectors[i];
+        itsData[i] = ((Vector<Complex>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpDComplex:
+        aio >> *(Vector<DComplex>*)itsDataVectors[i];
+        itsData[i] = ((Vector<DComplex>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpString:
+        aio >> *(Vector<String>*)itsDataVectors[i];
+        itsData[i] = ((Vector<String>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      default:
+        return False;
+      }
+    }
+    aio >> itsDataIndex >> itsUniqueIndex;
+    aio.getend();
+    itsDataInx = itsDataIndex.getStorage (deleteIt);
+    itsUniqueInx = itsUniqueIndex.getStorage (deleteIt);
+  } catch (std::exception&) {
+    // A damaged index is recreated.
+    return False;
+  }
+  itsNrrow = itsTable.nrow();
+  for (uInt i=0; i<itsDataTypes.nelements(); i++) {
+    itsGenerations[i] = itsColumns[i].changeGeneration();
+  }
+  itsColumnChanged.set (False);
+  itsChanged = False;
+  itsNeedWrite = False;
+  return True;
+}
+
 void ColumnsIndex::copyKeyField (void* fieldPtr, int dtype, const Record& key)
 {
   switch (dtype) {
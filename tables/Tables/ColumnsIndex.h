@@ -32,9 +32,12 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -110,6 +113,30 @@ template<typename T> class RecordFieldPtr;
 // <br>If data have changed, the entire index will be recreated by
 // rereading and optionally resorting the data. This will be deferred
 // until the next key lookup.
+// <br>For the columns of a plain table the index detects changes itself
+// using the change generation of the columns. If rows have only been
+// added at the end of the table, the index is updated by merging the
+// keys of the new rows into it. If data in the other rows have changed,
+// the data of the changed columns are reread and the index is resorted.
+// <p>
+// An index on a plain table can be made persistent using the function
+// <src>makePersistent</src>. It is stored in a file in the table
+// directory (named <src>table.index_</src> followed by the comma
+// separated column names). When a <src>ColumnsIndex</src> object is
+// constructed for the same columns, the index is read from that file
+// instead of reading and sorting the column data. It is only used if
+// the table has not changed since it was stored, which is checked using
+// the number of rows and the names, sizes and modification times of the
+// table files, and if the columns have no unflushed changes. Otherwise
+// the index is recreated in memory. It is only stored again by an explicit
+// call to <src>flush</src> or <src>makePersistent</src>, which also flush
+// the table.
+// Note that a file modified in the same second as the index was stored
+// makes it invalid, because such a change cannot be detected.
+// <br>TaQL (and <src>Table::operator()</src>) use a valid persistent index
+// on a single column to find the rows matching a comparison of that column
+// with a constant in the WHERE clause. Such a query only reads the index
+// (using <src>getPersistent</src>); it never creates, updates or stores it.
 // </synopsis>
 
 // <example>
@@ -288,6 +315,35 @@ public:
     void setChanged (const String& columnName);
     // </group>
 
+    // Make the index persistent, thus store it in the table directory.
+    // The table is flushed first.
+    // It can only be done for an index on a plain table.
+    void makePersistent();
+
+    // Is the index persistent?
+    Bool isPersistent() const
+      { return itsPersistent; }
+
+    // Store a persistent index if it has been updated. The table is
+    // flushed first. Note that the destructor does not store the index.
+    void flush();
+
+    // Get the persistent index for the given columns if it exists and is
+    // still valid. Otherwise a null pointer is returned.
+    // The index is only read; the table is not flushed and the index is
+    // neither recreated nor stored, so it can be used by read-only queries.
+    static CountedPtr<ColumnsIndex> getPersistent
+                                  (const Table& table,
+                                   const Vector<String>& columnNames);
+
+    // Does a persistent index exist for the given columns in the table?
+    static Bool hasPersistent (const Table& table,
+                               const Vector<String>& columnNames);
+
+    // Remove the persistent index for the given columns (if existing).
+    static void removePersistent (const Table& table,
+                                  const Vector<String>& columnNames);
+
     // Access the key values.
     // These functions allow you to create RecordFieldPtr<T> objects
     // for each field in the key. In this way you can quickly fill in
@@ -340,6 +396,9 @@ public:
     static void copyKeyField (void* field, int dtype, const Record& key);
 
 protected:
+    // Construct an empty object (to be filled by <src>create</src>).
+    ColumnsIndex();
+
     // Copy that object to this.
     void copy (const ColumnsIndex& that);
 
@@ -351,8 +410,11 @@ protected:
 			  const TableColumn& column);
 
     // Create the various members in the object.
-    void create (const Table& table, const Vector<String>& columnNames,
-		 Compare* compareFunction, Bool noSort);
+    // If <src>onlyPersistent=True</src>, only a valid persistent index is
+    // read; False is returned if there is none.
+    Bool create (const Table& table, const Vector<String>& columnNames,
+		 Compare* compareFunction, Bool noSort,
+		 Bool onlyPersistent = False);
 
     // Make the various internal <src>RecordFieldPtr</src> objects.
     void makeObjects (const RecordDesc& description);
@@ -361,6 +423,29 @@ protected:
     // form the index.
     void readData();
 
+    // Merge the added rows (from <src>oldNrrow</src> on) into the
+    // sorted index.
+    void mergeRows (uInt oldNrrow);
+
+    // Is the table a plain table, so the index can be made persistent?
+    static Bool isPlainTable (const Table& table,
+                              const Vector<String>& columnNames);
+
+    // Get the name of the file holding a persistent index.
+    static String indexFileName (const Table& table,
+                                 const Vector<String>& columnNames);
+
+    // Get the checksum of the names, sizes and modification times of
+    // the data files of a table. The latest modification time is
+    // returned in <src>lastTime</src>.
+    static uInt tableFilesChecksum (const String& tableName, uInt& lastTime);
+
+    // Read a persistent index. False is returned if it is invalid.
+    Bool readIndex();
+
+    // Write the index into its file in the table directory.
+    void writeIndex();
+
     // Do a binary search on <src>itsUniqueIndex</src> for the key in
     // <src>fieldPtrs</src>.
     // If the key is found, <src>found</src> is set to True and the index
@@ -376,6 +461,12 @@ protected:
 			const Block<Int>& dataTypes,
 			Int index);
 
+    // Compare the keys of the given entries in the column data.
+    // -1 is returned when less, 0 when equal, 1 when greater.
+    static Int compareData (const Block<void*>& dataPtrs,
+                            const Block<Int>& dataTypes,
+                            uInt index1, uInt index2);
+
     // Fill the row numbers vector for the given start till end in the
     // <src>itsUniqueIndex</src> vector (end is not inclusive).
     void fillRowNumbers (Vector<uInt>& rows, uInt start, uInt end) const;
@@ -392,10 +483,26 @@ private:
       key.get (field.name(), *field);
     }
 
+    // Read the data of the rows added to the column (from
+    // <src>oldNrrow</src> on) and append them to the vector.
+    template <typename T>
+    static void readAddedRows (const Table& table, const String& name,
+                               Vector<T>& vec, uInt oldNrrow);
+
+    // Compare two values in the column data.
+    template <typename T>
+    static Int compareValues (const void* dataPtr, uInt index1, uInt index2)
+    {
+      const T& left  = static_cast<const T*>(dataPtr)[index1];
+      const T& right = static_cast<const T*>(dataPtr)[index2];
+      return (left < right  ?  -1 : (right < left  ?  1 : 0));
+    }
+
     Table  itsTable;
     uInt   itsNrrow;
     Record* itsLowerKeyPtr;
     Record* itsUpperKeyPtr;
+    std::vector<TableColumn> itsColumns;
     Block<Int>   itsDataTypes;
     Block<void*> itsDataVectors;
     Block<void*> itsData;              //# pointer to data in itsDataVectors
@@ -404,7 +511,10 @@ private:
     Block<void*> itsLowerFields;
     Block<void*> itsUpperFields;
     Block<Bool>  itsColumnChanged;
+    Block<uInt64> itsGenerations;      //# change generation of columns read
     Bool         itsChanged;
+    Bool         itsPersistent;        //# True = index is stored in table
+    Bool         itsNeedWrite;         //# True = persistent index updated
     Bool         itsNoSort;            //# True = sort is not needed
     Compare*     itsCompare;           //# Compare function
     Vector<uInt> itsDataIndex;         //# Row numbers of all keys
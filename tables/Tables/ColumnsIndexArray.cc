@@ -39,6 +39,7 @@
 #include <casacore/casa/Utilities/Copy.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -49,6 +50,11 @@ ColumnsIndexArray::ColumnsIndexArray (const Table& table,
   itsUpperKeyPtr (0)
 {
   itsTable = table;
+  // The index holds 32-bit row numbers.
+  if (itsTable.nrow() > rownr_t(std::numeric_limits<uInt>::max())) {
+    throw (TableError ("ColumnsIndexArray: table " + itsTable.tableName() +
+                       " has more than 2**32-1 rows"));
+  }
   itsNrrow = itsTable.nrow();
   // Add column to the RecordDesc.
   RecordDesc description;
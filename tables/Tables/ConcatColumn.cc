@@ -66,31 +66,34 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return keywordSet_p;
   }
 
-  uInt ConcatColumn::nrow() const
+  rownr_t ConcatColumn::nrow() const
   {
     return refTabPtr_p->nrow();
   }
 
-  void ConcatColumn::initialize (uInt startRow, uInt endRow)
+  void ConcatColumn::initialize (rownr_t startRow, rownr_t endRow)
   {
-    uInt tableNr, tabRownr;
-    for (uInt i=startRow; i<endRow; ++i) {
+    uInt tableNr;
+    rownr_t tabRownr;
+    for (rownr_t i=startRow; i<endRow; ++i) {
       refTabPtr_p->rows().mapRownr (tableNr, tabRownr, i);
       refColPtr_p[tableNr]->initialize (tabRownr, tabRownr);
     }
   }
 
-  void ConcatColumn::setShape (uInt rownr, const IPosition& shape)
+  void ConcatColumn::setShape (rownr_t rownr, const IPosition& shape)
   {
-    uInt tableNr, tabRownr;
+    uInt tableNr;
+    rownr_t tabRownr;
     refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
     refColPtr_p[tableNr]->setShape (tabRownr, shape);
   }
 
-  void ConcatColumn::setShape (uInt rownr, const IPosition& shape,
+  void ConcatColumn::setShape (rownr_t rownr, const IPosition& shape,
 			       const IPosition& tileShape)
   {
-    uInt tableNr, tabRownr;
+    uInt tableNr;
+    rownr_t tabRownr;
     refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
     refColPtr_p[tableNr]->setShape (tabRownr, shape, tileShape);
   }
@@ -105,23 +108,26 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return refColPtr_p[0]->shapeColumn();
   }
 
-  uInt ConcatColumn::ndim (uInt rownr) const
+  uInt ConcatColumn::ndim (rownr_t rownr) const
   {
-    uInt tableNr, tabRownr;
+    uInt tableNr;
+    rownr_t tabRownr;
     refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
     return refColPtr_p[tableNr]->ndim (tabRownr);
   }
 
-  IPosition ConcatColumn::shape(uInt rownr) const
+  IPosition ConcatColumn::shape(rownr_t rownr) const
   {
-    uInt tableNr, tabRownr;
+    uInt tableNr;
+    rownr_t tabRownr;
     refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
     return refColPtr_p[tableNr]->shape (tabRownr);
   }
 
-  Bool ConcatColumn::isDefined (uInt rownr) const
+  Bool ConcatColumn::isDefined (rownr_t rownr) const
   {
-    uInt tableNr, tabRownr;
+    uInt tableNr;
+    rownr_t tabRownr;
     refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
     return refColPtr_p[tableNr]->isDefined (tabRownr);
   }
@@ -158,36 +164,40 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
-  void ConcatColumn::get (uInt rownr, void* dataPtr) const
+  void ConcatColumn::get (rownr_t rownr, void* dataPtr) const
   {
-    uInt tableNr, tabRownr;
+    uInt tableNr;
+    rownr_t tabRownr;
     refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
     refColPtr_p[tableNr]->get (tabRownr, dataPtr);
     // Set the column cache to the table used.
     ///setColumnCache (tableNr, refColPtr_p[tableNr]->columnCache());
   }
 
-  void ConcatColumn::getSlice (uInt rownr, const Slicer& ns,
+  void ConcatColumn::getSlice (rownr_t rownr, const Slicer& ns,
 			       void* dataPtr) const
   {
-    uInt tableNr, tabRownr;
+    uInt tableNr;
+    rownr_t tabRownr;
     refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
     refColPtr_p[tableNr]->getSlice (tabRownr, ns, dataPtr);
   }
 
-  void ConcatColumn::put (uInt rownr, const void* dataPtr)
+  void ConcatColumn::put (rownr_t rownr, const void* dataPtr)
   {
-    uInt tableNr, tabRownr;
+    uInt tableNr;
+    rownr_t tabRownr;
     refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
     refColPtr_p[tableNr]->put (tabRownr, dataPtr);
     // Set the column cache to the table used.
     ///setColumnCache (tableNr, refColPtr_p[tableNr]->columnCache());
   }
 
-  void ConcatColumn::putSlice (uInt rownr, const Slicer& ns,
+  void ConcatColumn::putSlice (rownr_t rownr, const Slicer& ns,
 			       const void* dataPtr)
   {
-    uInt tableNr, tabRownr;
+    uInt tableNr;
+    rownr_t tabRownr;
     refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
     refColPtr_p[tableNr]->putSlice (tabRownr, ns, dataPtr);
   }
@@ -301,15 +311,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     IPosition sz(arr.shape());       // size of array part
     Int lastTabNr = -1;
     uInt tableNr;
+    rownr_t tabRownr;
     // Step through all concat rownrs.
     for (uInt i=0; i<rows.nelements(); ++i) {
       // Map to the table and rownr in it.
-      ccRows.mapRownr (tableNr, tabRowNrs[i], rows[i]);
+      ccRows.mapRownr (tableNr, tabRownr, rows[i]);
+      tabRowNrs[i] = tabRownr;
       // An access has to be done if we have another table.
       if (Int(tableNr) != lastTabNr) {
 	// Access the cells if not the first time.
 	if (lastTabNr >= 0) {
-	  uInt nrrow = i - st[rowAxis];
+	  rownr_t nrrow = i - st[rowAxis];
 	  sz[rowAxis] = nrrow;
 	  Vector<uInt> rowPart(tabRowNrs(Slice(st[rowAxis], nrrow))); 
 	  part = arr.getSection (Slicer(st, sz));
@@ -321,7 +333,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       }
     }
     if (lastTabNr >= 0) {
-      uInt nrrow = rows.nelements() - st[rowAxis];
+      rownr_t nrrow = rows.nelements() - st[rowAxis];
       sz[rowAxis] = nrrow;
       Vector<uInt> rowPart(tabRowNrs(Slice(st[rowAxis], nrrow))); 
       part = arr.getSection (Slicer(st, sz));
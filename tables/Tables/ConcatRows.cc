@@ -32,17 +32,14 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
-  void ConcatRows::add (uInt nrow)
+  void ConcatRows::add (rownr_t nrow)
   {
-    if (Int64(nrow) + itsRows[itsNTable] >= Int64(65536)*65536) {
-      throw TableError ("Concatenation of tables exceeds 2**32 rows");
-    }
     itsNTable++;
     itsRows.resize (itsNTable+1);
     itsRows[itsNTable] = itsRows[itsNTable-1] + nrow;
   }
 
-  void ConcatRows::findRownr (uInt rownr) const
+  void ConcatRows::findRownr (rownr_t rownr) const
   {
     if (rownr >= itsRows[itsNTable]) {
       throw TableError ("ConcatTable: rownr " + String::toString(rownr) +
@@ -82,7 +79,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     : itsRows  (&rows),
       itsChunk (3),
       itsStart (start),
-      itsEnd   (std::min(end+1, rows.nrow())),
+      itsEnd   (std::min(rownr_t(end)+1, rows.nrow())),
       itsIncr  (incr),
       itsPos   (0)
   {
@@ -90,8 +87,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       itsPastEnd = True;
     } else {
       itsPastEnd = False;
-      rows.mapRownr (itsPos, itsChunk[0], start);
-      itsChunk[1] = std::min(rows[itsPos], itsEnd) - 1 - rows[itsPos-1];
+      rownr_t tabRownr;
+      rows.mapRownr (itsPos, tabRownr, start);
+      itsChunk[0] = tabRownr;
+      itsChunk[1] = std::min(rows[itsPos], rownr_t(itsEnd)) - 1 -
+                    rows[itsPos-1];
       itsChunk[2] = itsIncr;
     }
   }
@@ -109,7 +109,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 	    itsChunk[0] = itsIncr - rem;
 	  }
 	}
-	itsChunk[1] = std::min((*itsRows)[itsPos+1], itsEnd) - 1 -
+	itsChunk[1] = std::min((*itsRows)[itsPos+1], rownr_t(itsEnd)) - 1 -
 	  (*itsRows)[itsPos];
 	++itsPos;
       }
@@ -73,12 +73,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Vector<uInt> inx;
     GenSortIndirect<uInt>::sort (inx, rows);
     const ConcatRows& ccRows = refTabPtr_p->rows();
-    uInt tabRownr;
+    rownr_t tabRownr;
     uInt tableNr=0;
     // Map each row to rownr and tablenr.
     // Note this is pretty fast because it is done in row order.
     for (uInt i=0; i<inx.nelements(); ++i) {
-      uInt row = inx[i];
+      rownr_t row = inx[i];
       ccRows.mapRownr (tableNr, tabRownr, rows[row]);
       refColPtr_p[tableNr]->get (tabRownr, &(vec[row]));
     }
@@ -112,12 +112,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Vector<uInt> inx;
     GenSortIndirect<uInt>::sort (inx, rows);
     const ConcatRows& ccRows = refTabPtr_p->rows();
-    uInt tabRownr;
+    rownr_t tabRownr;
     uInt tableNr=0;
     // Map each row to rownr and tablenr.
     // Note this is pretty fast because it is done in row order.
     for (uInt i=0; i<inx.nelements(); ++i) {
-      uInt row = inx[i];
+      rownr_t row = inx[i];
       ccRows.mapRownr (tableNr, tabRownr, rows[row]);
       refColPtr_p[tableNr]->put (tabRownr, &(vec[row]));
     }
@@ -0,0 +1,129 @@
+//# FlagColumn.cc: Access to a Bool array column using packed flags
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables/FlagColumn.h>
+#include <casacore/casa/Arrays/Slicer.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+FlagColumn::FlagColumn()
+{}
+
+FlagColumn::FlagColumn (const Table& tab, const String& columnName)
+: ArrayColumn<Bool> (tab, columnName)
+{}
+
+FlagColumn::FlagColumn (const TableColumn& column)
+: ArrayColumn<Bool> (column)
+{}
+
+FlagColumn::FlagColumn (const FlagColumn& that)
+: ArrayColumn<Bool> (that)
+{}
+
+FlagColumn::~FlagColumn()
+{}
+
+TableColumn* FlagColumn::clone() const
+{
+    return new FlagColumn (*this);
+}
+
+FlagColumn& FlagColumn::operator= (const FlagColumn& that)
+{
+    reference (that);
+    return *this;
+}
+
+void FlagColumn::reference (const FlagColumn& that)
+{
+    ArrayColumn<Bool>::reference (that);
+}
+
+void FlagColumn::toBuffer (const FlagArray& flags)
+{
+    if (! buffer_p.shape().isEqual (flags.shape())) {
+        buffer_p.resize (flags.shape());
+    }
+    flags.toArray (buffer_p);
+}
+
+void FlagColumn::get (rownr_t rownr, FlagArray& flags) const
+{
+    ArrayColumn<Bool>::get (rownr, buffer_p, True);
+    flags.fromArray (buffer_p);
+}
+
+FlagArray FlagColumn::getFlags (rownr_t rownr) const
+{
+    FlagArray flags;
+    get (rownr, flags);
+    return flags;
+}
+
+void FlagColumn::getSlice (rownr_t rownr, const Slicer& arraySection,
+                           FlagArray& flags) const
+{
+    ArrayColumn<Bool>::getSlice (rownr, arraySection, buffer_p, True);
+    flags.fromArray (buffer_p);
+}
+
+void FlagColumn::getColumn (FlagArray& flags) const
+{
+    ArrayColumn<Bool>::getColumn (buffer_p, True);
+    flags.fromArray (buffer_p);
+}
+
+void FlagColumn::put (rownr_t rownr, const FlagArray& flags)
+{
+    toBuffer (flags);
+    ArrayColumn<Bool>::put (rownr, buffer_p);
+}
+
+void FlagColumn::putSlice (rownr_t rownr, const Slicer& arraySection,
+                           const FlagArray& flags)
+{
+    toBuffer (flags);
+    ArrayColumn<Bool>::putSlice (rownr, arraySection, buffer_p);
+}
+
+void FlagColumn::putColumn (const FlagArray& flags)
+{
+    toBuffer (flags);
+    ArrayColumn<Bool>::putColumn (buffer_p);
+}
+
+void FlagColumn::orFlags (rownr_t rownr, const FlagArray& flags)
+{
+    FlagArray current;
+    get (rownr, current);
+    current |= flags;
+    put (rownr, current);
+}
+
+} //# NAMESPACE CASACORE - END
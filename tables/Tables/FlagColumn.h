@@ -0,0 +1,164 @@
+//# FlagColumn.h: Access to a Bool array column using packed flags
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_FLAGCOLUMN_H
+#define TABLES_FLAGCOLUMN_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/FlagArray.h>
+#include <casacore/casa/Arrays/Array.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Access to a Bool array column using packed flags
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tFlagColumn.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=ArrayColumn>ArrayColumn</linkto>
+//   <li> <linkto class=FlagArray>FlagArray</linkto>
+// </prerequisite>
+
+// <synopsis>
+// FlagColumn is an <src>ArrayColumn<Bool></src> which can also get and
+// put the arrays in a column as packed <linkto class=FlagArray>
+// FlagArray</linkto> objects (one bit per flag).
+// In this way the flags of many rows can be kept in memory and be combined
+// using fast word-wise logical operations.
+// <p>
+// The storage managers keep Bool values as bits on disk, but cache them
+// as bytes. The conversion from and to the packed form is done using an
+// internal buffer which is reused, so no array is allocated per cell.
+// Note that this means that a FlagColumn object should not be used by
+// multiple threads concurrently.
+// <br>Tiled storage managers can compress flags efficiently using the
+// run-length codec of <linkto class=TiledCompressStMan>
+// TiledCompressStMan</linkto>.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   FlagColumn flagCol (ms, "FLAG");
+//   FlagArray flags;
+//   for (uInt i=0; i<ms.nrow(); i++) {
+//     flagCol.get (i, flags);
+//     flags |= newFlags;
+//     flagCol.put (i, flags);
+//   }
+// </srcblock>
+// </example>
+
+class FlagColumn : public ArrayColumn<Bool>
+{
+public:
+    // The default constructor creates a null object.
+    FlagColumn();
+
+    // Construct for the given column in the given table.
+    FlagColumn (const Table&, const String& columnName);
+
+    // Construct from the given table column.
+    explicit FlagColumn (const TableColumn&);
+
+    // Copy constructor (reference semantics).
+    FlagColumn (const FlagColumn&);
+
+    ~FlagColumn();
+
+    // Clone the object.
+    virtual TableColumn* clone() const;
+
+    // Assignment uses reference semantics.
+    FlagColumn& operator= (const FlagColumn&);
+
+    // Change the reference to another column.
+    void reference (const FlagColumn&);
+
+    // Make the Array functions of ArrayColumn visible.
+    // <group>
+    using ArrayColumn<Bool>::get;
+    using ArrayColumn<Bool>::getSlice;
+    using ArrayColumn<Bool>::getColumn;
+    using ArrayColumn<Bool>::put;
+    using ArrayColumn<Bool>::putSlice;
+    using ArrayColumn<Bool>::putColumn;
+    // </group>
+
+    // Get the flags of a cell.
+    // The FlagArray is resized to the shape of the cell.
+    // <group>
+    void get (rownr_t rownr, FlagArray& flags) const;
+    FlagArray getFlags (rownr_t rownr) const;
+    // </group>
+
+    // Get a slice of the flags of a cell.
+    // The FlagArray is resized to the shape of the slice.
+    void getSlice (rownr_t rownr, const Slicer& arraySection,
+                   FlagArray& flags) const;
+
+    // Get the flags of all cells in the column.
+    // The last axis of the FlagArray is the row axis.
+    void getColumn (FlagArray& flags) const;
+
+    // Put the flags of a cell.
+    void put (rownr_t rownr, const FlagArray& flags);
+
+    // Put a slice of the flags of a cell.
+    void putSlice (rownr_t rownr, const Slicer& arraySection,
+                   const FlagArray& flags);
+
+    // Put the flags of all cells in the column.
+    // The last axis of the FlagArray is the row axis.
+    void putColumn (const FlagArray& flags);
+
+    // OR the given flags with the flags of a cell.
+    // It is a shorthand for getting, combining and putting the flags.
+    void orFlags (rownr_t rownr, const FlagArray& flags);
+
+private:
+    // Copy the given flags into the buffer.
+    void toBuffer (const FlagArray& flags);
+
+    //# The buffer used for the conversion to and from Bool arrays.
+    mutable Array<Bool> buffer_p;
+};
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
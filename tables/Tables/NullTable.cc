@@ -171,7 +171,7 @@ Bool NullTable::canAddRow() const
   return False;
 }
 
-void NullTable::addRow (uInt, Bool)
+void NullTable::addRow (rownr_t, Bool)
 {
   throwError ("addRow");
 }
@@ -182,7 +182,7 @@ Bool NullTable::canRemoveRow() const
   return False;
 }
 
-void NullTable::removeRow (uInt)
+void NullTable::removeRow (rownr_t)
 {
   throwError ("removeRow");
 }
@@ -104,9 +104,9 @@ public:
   virtual BaseColumn* getColumn (uInt columnIndex) const;
   virtual BaseColumn* getColumn (const String& columnName) const;
   virtual Bool canAddRow() const;
-  virtual void addRow (uInt nrrow, Bool initialize);
+  virtual void addRow (rownr_t nrrow, Bool initialize);
   virtual Bool canRemoveRow() const;
-  virtual void removeRow (uInt rownr);
+  virtual void removeRow (rownr_t rownr);
   virtual DataManager* findDataManager (const String& name,
                                         Bool byColumn) const;
   virtual void addColumn (const ColumnDesc& columnDesc, Bool addToParent);
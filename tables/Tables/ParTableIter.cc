@@ -0,0 +1,172 @@
+//# ParTableIter.cc: Process the groups of a table iteration in parallel
+//# Copyright (C) 2018
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/ParTableIter.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/OS/OMP.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <exception>
+#include <algorithm>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+TableGroupWorker::~TableGroupWorker()
+{}
+
+void TableGroupWorker::write (uInt, rownr_t, rownr_t)
+{}
+
+
+ParallelTableIterator::ParallelTableIterator (const TableIterator& iter)
+{
+  iter.throwIfNull();
+  itsTable  = iter.sortedTable();
+  itsGroups = iter.groupBoundaries();
+}
+
+ParallelTableIterator::ParallelTableIterator
+                              (const Table& sortedTable,
+                               const std::vector<rownr_t>& groups)
+: itsTable  (sortedTable),
+  itsGroups (groups)
+{
+  Bool ok = !groups.empty()  &&  groups[0] == 0  &&
+            groups[groups.size()-1] == sortedTable.nrow();
+  for (uInt i=1; ok && i<groups.size(); ++i) {
+    ok = groups[i] >= groups[i-1];
+  }
+  if (!ok) {
+    throw TableError ("ParallelTableIterator: invalid group boundaries "
+                      "for table " + sortedTable.tableName());
+  }
+}
+
+ParallelTableIterator::~ParallelTableIterator()
+{}
+
+Table ParallelTableIterator::group (uInt groupnr) const
+{
+  if (groupnr+1 >= itsGroups.size()) {
+    throw TableError ("ParallelTableIterator::group - group number " +
+                      String::toString(groupnr) + " exceeds " +
+                      String::toString(itsGroups.size()-1) + " groups");
+  }
+  return makeTable (itsGroups[groupnr], itsGroups[groupnr+1]);
+}
+
+Table ParallelTableIterator::makeTable (rownr_t startRow,
+                                        rownr_t endRow) const
+{
+  Vector<uInt> rownrs(endRow - startRow);
+  indgen (rownrs, uInt(startRow));
+  return itsTable(rownrs);
+}
+
+void ParallelTableIterator::run (TableGroupWorker& worker, uInt nthreads)
+{
+  const std::vector<rownr_t>& groups = itsGroups;
+  uInt ngr = groups.size() - 1;
+  if (nthreads == 0) {
+    nthreads = OMP::maxThreads();
+  }
+  nthreads = std::max (1u, std::min (nthreads, ngr));
+  // Create and attach the workers of the other threads.
+  // Creating the tables is not thread-safe, so it is done beforehand.
+  // The tables are kept alive here, because column objects do not
+  // keep their table alive. The clones are deleted automatically, also
+  // if an exception is thrown.
+  std::vector<TableGroupWorker*> workers(nthreads);
+  std::vector<CountedPtr<TableGroupWorker> > clones(nthreads);
+  std::vector<Table> tables(nthreads);
+  workers[0] = &worker;
+  for (uInt i=1; i<nthreads; ++i) {
+    clones[i]  = CountedPtr<TableGroupWorker> (worker.clone());
+    workers[i] = clones[i].get();
+  }
+  for (uInt i=0; i<nthreads; ++i) {
+    tables[i] = makeTable (0, itsTable.nrow());
+    workers[i]->attach (tables[i]);
+  }
+  String error;
+  Bool failed = False;
+#pragma omp parallel num_threads(nthreads)
+  {
+    TableGroupWorker& wrk = *workers[OMP::threadNum()];
+#pragma omp for schedule(dynamic)
+    for (Int i=0; i<Int(ngr); ++i) {
+      rownr_t startRow = groups[i];
+      rownr_t nrow = groups[i+1] - startRow;
+      Bool ok;
+      String msg;
+      // Skip the remaining groups after a failure.
+#pragma omp critical(ParallelTableIterator_io)
+      ok = !failed  &&  doStep (wrk, 0, i, startRow, nrow, msg);
+      if (ok) {
+        ok = doStep (wrk, 1, i, startRow, nrow, msg);
+      }
+#pragma omp critical(ParallelTableIterator_io)
+      {
+        if (ok) {
+          ok = doStep (wrk, 2, i, startRow, nrow, msg);
+        }
+        if (!ok  &&  !failed  &&  !msg.empty()) {
+          error  = msg;
+          failed = True;
+        }
+      }
+    }
+  }
+  if (failed) {
+    throw TableError ("ParallelTableIterator: processing failed: " + error);
+  }
+}
+
+Bool ParallelTableIterator::doStep (TableGroupWorker& worker, uInt step,
+                                    uInt groupnr, rownr_t startRow, rownr_t nrow,
+                                    String& error)
+{
+  try {
+    if (step == 0) {
+      worker.read (groupnr, startRow, nrow);
+    } else if (step == 1) {
+      worker.process (groupnr);
+    } else {
+      worker.write (groupnr, startRow, nrow);
+    }
+  } catch (std::exception& x) {
+    error = x.what();
+    return False;
+  }
+  return True;
+}
+
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,216 @@
+//# ParTableIter.h: Process the groups of a table iteration in parallel
+//# Copyright (C) 2018
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_PARTABLEITER_H
+#define TABLES_PARTABLEITER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/TableIter.h>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Abstract base class for processing the groups of a ParallelTableIterator.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTableIter,tMSIter" demos="">
+// </reviewed>
+
+// <synopsis>
+// A class derived from TableGroupWorker does the actual processing of the
+// iteration groups handed out by
+// <linkto class=ParallelTableIterator>ParallelTableIterator</linkto>.
+// Each thread uses its own worker object made by <src>clone</src>, so
+// a worker can keep its column objects and data buffers as data members.
+// <br>The processing of a group is split into three steps:
+// <ol>
+//  <li> <src>read</src> reads the data of the group from the table.
+//  <li> <src>process</src> processes the data read.
+//  <li> <src>write</src> writes the results (if any) into the table.
+// </ol>
+// Only the <src>process</src> steps are executed in parallel. Table access
+// is not thread-safe (the storage managers keep state per column), so the
+// <src>read</src> and <src>write</src> steps (and <src>attach</src>) are
+// executed one at a time.
+// </synopsis>
+
+class TableGroupWorker
+{
+public:
+  virtual ~TableGroupWorker();
+
+  // Make a copy of this worker for use in another thread.
+  virtual TableGroupWorker* clone() const = 0;
+
+  // Attach the worker to the table to be used by its thread.
+  // It contains all rows in iteration order, so the rows of a group
+  // are consecutive. Usually the column objects are created here.
+  // The table exists until the end of <src>ParallelTableIterator::run</src>.
+  virtual void attach (const Table& table) = 0;
+
+  // Read the data of the given group, which consists of
+  // <src>nrow</src> rows starting at <src>startRow</src>.
+  virtual void read (uInt groupnr, rownr_t startRow, rownr_t nrow) = 0;
+
+  // Process the data of the given group.
+  virtual void process (uInt groupnr) = 0;
+
+  // Write the results of the given group.
+  // The default implementation does nothing.
+  virtual void write (uInt groupnr, rownr_t startRow, rownr_t nrow);
+};
+
+
+// <summary>
+// Process the groups of a table iteration in parallel.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTableIter,tMSIter" demos="">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=TableIterator>TableIterator</linkto>
+// </prerequisite>
+
+// <synopsis>
+// ParallelTableIterator hands out the groups of a
+// <linkto class=TableIterator>TableIterator</linkto> to several threads.
+// The table is sorted and the group boundaries are determined once.
+// Thereafter the groups are processed by
+// <linkto class=TableGroupWorker>TableGroupWorker</linkto> objects; each
+// thread has its own worker object attached to its own reference table
+// containing all rows in iteration order. The groups are handed out
+// dynamically, so groups of different sizes are balanced over the threads.
+// <br>The table data are read and written one group at a time (see
+// TableGroupWorker), while the processing is done in parallel. Hence it is
+// useful if the processing of a group (e.g. the calibration of a baseline
+// or time slot) takes more time than reading its data.
+// <br>OpenMP is used for the threads; without OpenMP all groups are
+// processed sequentially by the given worker.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//    // Sum the DATA per baseline.
+//    class SumWorker : public TableGroupWorker {
+//    public:
+//      virtual TableGroupWorker* clone() const
+//        { return new SumWorker(*this); }
+//      virtual void attach (const Table& tab)
+//        { itsCol.attach (tab, "DATA"); }
+//      virtual void read (uInt, rownr_t startRow, rownr_t nrow)
+//        { itsCol.getColumnRange (Slicer(IPosition(1,startRow),
+//                                        IPosition(1,nrow)), itsData, True); }
+//      virtual void process (uInt groupnr)
+//        { ... sum itsData and store it for groupnr ... }
+//    private:
+//      ArrayColumn<Complex> itsCol;
+//      Array<Complex> itsData;
+//    };
+//    Block<String> keys(2);
+//    keys[0] = "ANTENNA1";
+//    keys[1] = "ANTENNA2";
+//    ParallelTableIterator iter (TableIterator(ms, keys));
+//    SumWorker worker;
+//    iter.run (worker);
+// </srcblock>
+// </example>
+
+// <motivation>
+// Per-baseline or per-timeslot processing loops should be able to use all
+// cores without partitioning the table by hand.
+// </motivation>
+
+class ParallelTableIterator
+{
+public:
+  // Create from the given table iterator.
+  // Its iteration state is not used.
+  explicit ParallelTableIterator (const TableIterator& iter);
+
+  // Create from a table containing all rows in iteration order and the
+  // boundaries of the groups in it (see
+  // <src>TableIterator::groupBoundaries</src>). It can be used if the
+  // groups are not determined by a TableIterator (e.g. the iteration steps
+  // of an MSIter, see <src>MSIter::groupBoundaries</src>).
+  // <br>An exception is thrown if the boundaries are not ascending from 0
+  // to the number of rows in the table.
+  ParallelTableIterator (const Table& sortedTable,
+                         const std::vector<rownr_t>& groups);
+
+  ~ParallelTableIterator();
+
+  // Get the number of groups.
+  uInt ngroup() const
+    { return itsGroups.size() - 1; }
+
+  // Get the boundaries of the groups (see
+  // <src>TableIterator::groupBoundaries</src>).
+  const std::vector<rownr_t>& groupBoundaries() const
+    { return itsGroups; }
+
+  // Get the given group as a table.
+  Table group (uInt groupnr) const;
+
+  // Process all groups using at most <src>nthreads</src> threads.
+  // 0 means the maximum number of OpenMP threads.
+  // The given worker is used by the first thread; the other threads use
+  // a clone, which is deleted at the end.
+  // If the worker throws an exception, the remaining groups are not
+  // processed and an exception with its message is thrown at the end.
+  void run (TableGroupWorker& worker, uInt nthreads=0);
+
+private:
+  // Forbid copy constructor and assignment.
+  ParallelTableIterator (const ParallelTableIterator&);
+  ParallelTableIterator& operator= (const ParallelTableIterator&);
+
+  // Do a step of the worker for the given group.
+  // It returns False if an exception was thrown, whose message is set in
+  // <src>error</src>.
+  static Bool doStep (TableGroupWorker& worker, uInt step, uInt groupnr,
+                      rownr_t startRow, rownr_t nrow, String& error);
+
+  // Make a reference table containing the given rows of the sorted table.
+  Table makeTable (rownr_t startRow, rownr_t endRow) const;
+
+  //# Data members
+  Table                itsTable;
+  std::vector<rownr_t> itsGroups;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
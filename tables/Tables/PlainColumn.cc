@@ -30,11 +30,13 @@
 #include <casacore/tables/Tables/TableTrace.h>
 #include <casacore/tables/Tables/BaseColDesc.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayIter.h>
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -44,7 +46,9 @@ PlainColumn::PlainColumn (const BaseColumnDesc* cdp, ColumnSet* csp)
   dataManPtr_p  (0),
   dataColPtr_p  (0),
   colSetPtr_p   (csp),
-  originalName_p(cdp->name())
+  originalName_p(cdp->name()),
+  changeGen_p   (1),
+  flushGen_p    (1)
 {
   int trace = TableTrace::traceColumn (colDesc_p);
   rtraceColumn_p = (trace&TableTrace::READ)  != 0;
@@ -55,9 +59,72 @@ PlainColumn::~PlainColumn()
 {}
 
 
-uInt PlainColumn:: nrow() const
+rownr_t PlainColumn::nrow() const
     { return colSetPtr_p->nrow(); }
 
+uInt64 PlainColumn::changeGeneration() const
+{
+    return changeGen_p;
+}
+
+uInt64 PlainColumn::flushedGeneration() const
+{
+    return flushGen_p;
+}
+
+rownr_t PlainColumn::lowestRowChanged (uInt64 generation) const
+{
+    if (generation == changeGen_p) {
+        return nrow();
+    }
+    for (uInt i=0; i<changeLog_p.size(); ++i) {
+        if (changeLog_p[i].first > generation) {
+            return changeLog_p[i].second;
+        }
+    }
+    return 0;
+}
+
+Bool PlainColumn::getZoneMap (Vector<uInt>& startRows,
+                              Vector<Double>& minValues,
+                              Vector<Double>& maxValues,
+                              Bool create)
+{
+    checkReadLock (True);
+    Bool result = dataColPtr_p->getZoneMap (startRows, minValues, maxValues,
+                                            create);
+    autoReleaseLock();
+    return result;
+}
+
+void PlainColumn::columnChanged (rownr_t lowRow)
+{
+    changeGen_p++;
+    // Entries for higher rows are covered by the new one.
+    while (!changeLog_p.empty()  &&  changeLog_p.back().second >= lowRow) {
+        changeLog_p.pop_back();
+    }
+    changeLog_p.push_back (std::make_pair (changeGen_p, lowRow));
+    // Limit the size by combining the two oldest entries; keeping the
+    // lower row makes the result for older generations conservative.
+    if (changeLog_p.size() > 64) {
+        changeLog_p[1].second = changeLog_p[0].second;
+        changeLog_p.erase (changeLog_p.begin());
+    }
+}
+
+void PlainColumn::columnChanged (const RefRows& rownrs)
+{
+    // A sliced vector contains start,end,incr triplets.
+    const Vector<uInt>& rows = rownrs.rowVector();
+    uInt incr = (rownrs.isSliced()  ?  3 : 1);
+    rownr_t lowRow = nrow();
+    for (uInt i=0; i<rows.size(); i+=incr) {
+        lowRow = std::min (lowRow, rownr_t(rows[i]));
+    }
+    columnChanged (lowRow);
+}
+
 
 TableRecord& PlainColumn::rwKeywordSet()
 {
@@ -34,6 +34,8 @@
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/Tables/ColumnSet.h>
 #include <casacore/tables/Tables/TableRecord.h>
+#include <vector>
+#include <utility>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -43,6 +45,7 @@ class BaseColumnDesc;
 class DataManager;
 class DataManagerColumn;
 class AipsIO;
+class RefRows;
 template<class T> class Array;
 class IPosition;
 
@@ -104,7 +107,30 @@ public:
     // </group>
 
     // Get nr of rows in the column.
-    uInt nrow() const;
+    rownr_t nrow() const;
+
+    // Get the change generation of the column.
+    virtual uInt64 changeGeneration() const;
+
+    // Get the lowest row changed since the given change generation.
+    virtual rownr_t lowestRowChanged (uInt64 generation) const;
+
+    // Get the zone map of the column from its data manager.
+    virtual Bool getZoneMap (Vector<uInt>& startRows,
+                             Vector<Double>& minValues,
+                             Vector<Double>& maxValues,
+                             Bool create);
+
+    // Register that the data in the column have changed from the given
+    // row on (which increments the change generation).
+    void columnChanged (rownr_t lowRow);
+
+    // Get the change generation at the last flush or resync.
+    virtual uInt64 flushedGeneration() const;
+
+    // Register that the data in the column have been flushed or resynced.
+    void columnFlushed()
+        { flushGen_p = changeGen_p; }
 
     // Define the shape of all arrays in the column.
     virtual void setShapeColumn (const IPosition& shape);
@@ -144,6 +170,12 @@ protected:
     String              originalName_p;  //# Column name before any rename
     Bool                rtraceColumn_p;  //# trace reads of the column?
     Bool                wtraceColumn_p;  //# trace writes of the column?
+    uInt64              changeGen_p;     //# change generation (starts at 1)
+    uInt64              flushGen_p;      //# change generation at last flush
+    //# Generation and lowest row changed since the previous entry.
+    //# The rows are ascending, so the lowest row changed since a
+    //# generation is given by the first later entry.
+    std::vector<std::pair<uInt64,rownr_t> > changeLog_p;
 
     // Get the trace-id of the table.
     int traceId() const
@@ -159,6 +191,9 @@ protected:
     // This is used to bind the column to the appropriate data manager.
     virtual void getFileDerived (AipsIO&, const ColumnSet&) = 0;
 
+    // Register that the data in the given rows have changed.
+    void columnChanged (const RefRows& rownrs);
+
     // Check the length of a value.
     // This a meant for String values for which a maximum length is defined.
     // The void* version is a no-op for other values.
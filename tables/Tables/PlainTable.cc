@@ -41,7 +41,12 @@
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/DirectoryIterator.h>
 #include <casacore/casa/System/AipsrcValue.h>
+#include <algorithm>
+#include <vector>
 #include <time.h>    //# for nanosleep
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -50,7 +55,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 TableCache PlainTable::theirTableCache;
 
 
-PlainTable::PlainTable (SetupNewTable& newtab, uInt nrrow, Bool initialize,
+PlainTable::PlainTable (SetupNewTable& newtab, rownr_t nrrow, Bool initialize,
 			const TableLock& lockOptions, int endianFormat,
                         const TSMOption& tsmOption)
 : BaseTable      (newtab.name(), newtab.option(), 0),
@@ -58,7 +63,10 @@ PlainTable::PlainTable (SetupNewTable& newtab, uInt nrrow, Bool initialize,
   tableChanged_p (True),
   addToCache_p   (True),
   lockPtr_p      (0),
-  tsmOption_p    (tsmOption)
+  tsmOption_p    (tsmOption),
+  sealed_p       (False),
+  sealGeneration_p (0),
+  sealChecksum_p (0)
 {
   try {
     // Determine and set the endian option.
@@ -160,7 +168,10 @@ PlainTable::PlainTable (AipsIO&, uInt version, const String& tabname,
   tableChanged_p (False),
   addToCache_p   (addToCache),
   lockPtr_p      (0),
-  tsmOption_p    (tsmOption)
+  tsmOption_p    (tsmOption),
+  sealed_p       (False),
+  sealGeneration_p (0),
+  sealChecksum_p (0)
 {
     // Replace default TSM option for existing table.
     tsmOption_p.fillOption (False);
@@ -181,10 +192,14 @@ PlainTable::PlainTable (AipsIO&, uInt version, const String& tabname,
     } else {
         lockPtr_p->getInfo (lockSync_p.memoryIO());
     }
+    //# The sync data are empty if there is no lock file (e.g. if sealed),
+    //# so keep the #rows given in that case.
     uInt ncolumn;
+    uInt nrrowSync = nrrow_p;
     Bool tableChanged;
     Block<Bool> dmChanged;
-    lockSync_p.read (nrrow_p, ncolumn, tableChanged, dmChanged);
+    lockSync_p.read (nrrowSync, ncolumn, tableChanged, dmChanged);
+    nrrow_p = nrrowSync;
     tdescPtr_p = new TableDesc ("", TableDesc::Scratch);
 
     //# Reopen the file to be sure that the internal stdio buffer is not reused.
@@ -199,7 +214,14 @@ PlainTable::PlainTable (AipsIO&, uInt version, const String& tabname,
     ios >> nrrow;
     ios >> format;
     bigEndian_p = (format==0);
+    readSealInfo (ios, version, sealed_p, sealGeneration_p, sealChecksum_p);
     ios >> tp;
+    //# A sealed table is opened without locking (see Table::makeBaseTable),
+    //# which is only safe if it cannot be written.
+    if (sealed_p  &&  opt != Table::Old) {
+        throw (TableError ("Table " + tableName() + " is sealed and cannot"
+                           " be opened for write; unseal it first"));
+    }
 #if defined(TABLEREPAIR)
     cerr << "tableRepair: found " << nrrow << " rows; give new number: ";
     cin >> nrrow_p;
@@ -325,6 +347,10 @@ void PlainTable::reopenRW()
     if (isWritable()) {
 	return;
     }
+    if (sealed_p) {
+	throw (TableError ("Table " + tableName() + " is sealed and cannot"
+			   " be opened for read/write; unseal it first"));
+    }
     // Exception when readonly table.
     if (! Table::isWritable (tableName())) {
 	throw (TableError ("Table " + tableName() +
@@ -380,6 +406,10 @@ const TableLock& PlainTable::lockOptions() const
 }
 void PlainTable::mergeLock (const TableLock& lockOptions)
 {
+    // A sealed table never needs locking.
+    if (sealed_p) {
+        return;
+    }
     Bool isPerm = lockPtr_p->isPermanent();
     lockPtr_p->merge (lockOptions);
     // Acquire if needed a permanent lock.
@@ -394,6 +424,10 @@ Bool PlainTable::hasLock (FileLocker::LockType type) const
 }
 Bool PlainTable::lock (FileLocker::LockType type, uInt nattempts)
 {
+    //# A sealed table cannot change, so it need not be locked nor synced.
+    if (sealed_p) {
+        return True;
+    }
     //# When the table is already locked (read locked is sufficient),
     //# no synchronization is needed (other processes could not write).
     Bool noSync = hasLock (FileLocker::Read);
@@ -491,6 +525,10 @@ void PlainTable::flush (Bool fsync, Bool recursive)
 
 void PlainTable::resync()
 {
+    //# A sealed table cannot have been changed by another process.
+    if (sealed_p) {
+        return;
+    }
     TableTrace::traceFile (itsTraceId, "resync");
     Bool tableChanged = True;
     lockPtr_p->getInfo (lockSync_p.memoryIO());
@@ -527,7 +565,8 @@ Bool PlainTable::putFile (Bool always)
 #ifdef AIPS_TRACE
         cout << "  full PlainTable::putFile" << endl;
 #endif
-	writeStart (ios, bigEndian_p);
+	writeStart (ios, bigEndian_p, sealed_p, sealGeneration_p,
+		    sealChecksum_p);
 	ios << "PlainTable";
 	tdescPtr_p->putFile (ios, attr);                 // write description
 	colSetPtr_p->putFile (True, ios, attr, False);   // write column data
@@ -643,7 +682,7 @@ Bool PlainTable::canRenameColumn (const String& columnName) const
 
 
 //# Add rows.
-void PlainTable::addRow (uInt nrrw, Bool initialize)
+void PlainTable::addRow (rownr_t nrrw, Bool initialize)
 {
     if (nrrw > 0) {
         checkWritable("addRow");
@@ -661,7 +700,7 @@ void PlainTable::addRow (uInt nrrw, Bool initialize)
     }
 }
 
-void PlainTable::removeRow (uInt rownr)
+void PlainTable::removeRow (rownr_t rownr)
 {
     checkWritable("rowmoveRow");
     //# Locking has to be done here, otherwise nrrow_p is not up-to-date
@@ -783,6 +822,95 @@ void PlainTable::setEndian (int endianFormat)
     }
 }
 
+Bool PlainTable::isSealed() const
+{
+    return sealed_p;
+}
+
+void PlainTable::setSealed (Bool seal)
+{
+    if (seal == sealed_p) {
+        return;
+    }
+    if (seal) {
+        checkWritable ("seal");
+        if (isMultiUsed (False)) {
+            throw (TableError ("Table " + tableName() + " cannot be sealed;"
+                               " it is in use in another process"));
+        }
+        // Write all data, so the checksum is taken from the final files.
+        lockPtr_p->acquire (&(lockSync_p.memoryIO()), FileLocker::Write, 0);
+        putFile (True);
+        sealChecksum_p = sealChecksum (tableName());
+        sealGeneration_p++;
+        sealed_p = True;
+        putFile (True);
+        lockPtr_p->release();
+    } else {
+        if (! File(Table::fileName(tableName())).isWritable()) {
+            throw (TableError ("Table " + tableName() + " cannot be"
+                               " unsealed; it is not writable"));
+        }
+        // The sealed table was opened without locking, so create a lock
+        // object with the default options before making it writable.
+        // Table::isWritable cannot be used (as in reopenRW), because it
+        // tells that the sealed table file is not writable.
+        sealed_p = False;
+        delete lockPtr_p;
+        lockPtr_p = 0;
+        lockPtr_p = new TableLockData (TableLock(), releaseCallBack, this);
+        colSetPtr_p->linkToLockObject (lockPtr_p);
+        lockPtr_p->makeLock (name_p, False, FileLocker::Write);
+        option_p = Table::Update;
+        colSetPtr_p->reopenRW();
+        keywordSet().reopenRW();
+        lockPtr_p->acquire (&(lockSync_p.memoryIO()), FileLocker::Write, 0);
+        putFile (True);
+        lockPtr_p->release();
+    }
+}
+
+uInt PlainTable::sealChecksum (const String& tableName)
+{
+    // Use the names and sizes of the files in the table directory
+    // (in sorted order). Subtables have their own seal, while
+    // table.dat and table.lock change when sealing.
+    std::vector<String> names;
+    DirectoryIterator iter ((Directory(tableName)));
+    while (! iter.pastEnd()) {
+        names.push_back (iter.name());
+        iter++;
+    }
+    std::sort (names.begin(), names.end());
+    // Use a 32-bit FNV-1a hash.
+    uInt hash = 2166136261u;
+    for (uInt i=0; i<names.size(); ++i) {
+        if (names[i] == "table.dat"  ||  names[i] == "table.lock") {
+            continue;
+        }
+        File file(tableName + '/' + names[i]);
+        if (! file.isRegular()) {
+            continue;
+        }
+        String str = names[i] + '\0' +
+                     String::toString (RegularFile(file.path()).size());
+        for (uInt j=0; j<str.size(); ++j) {
+            hash = (hash ^ uChar(str[j])) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+uInt PlainTable::sealGeneration() const
+{
+    return sealGeneration_p;
+}
+
+Bool PlainTable::checkSeal() const
+{
+    return sealed_p  &&  sealChecksum_p == sealChecksum (tableName());
+}
+
 void PlainTable::checkWritable (const char* func) const
 {
     if (! isWritable()) {
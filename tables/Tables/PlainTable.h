@@ -90,7 +90,7 @@ public:
     // It creates storage manager(s) for unbound columns and initializes
     // all storage managers. The given number of rows is stored in
     // the table and initialized if the flag is set.
-    PlainTable (SetupNewTable&, uInt nrrow, Bool initialize,
+    PlainTable (SetupNewTable&, rownr_t nrrow, Bool initialize,
 		const TableLock& lockOptions, int endianFormat,
                 const TSMOption& tsmOption);
 
@@ -129,6 +129,30 @@ public:
     // a subtable is used in another process.
     virtual Bool isMultiUsed (Bool checkSubTables) const;
 
+    // Is the table sealed?
+    virtual Bool isSealed() const;
+
+    // Seal or unseal the table.
+    // Sealing requires the table to be open for write and not used in
+    // another process. It writes all data and stores the seal info in the
+    // table file. Unsealing makes the table writable again.
+    virtual void setSealed (Bool seal);
+
+    // Get the number of times the table has been sealed.
+    // It is only kept in the table file while the table is sealed,
+    // so it restarts when a table is sealed again after being unsealed
+    // and reopened.
+    uInt sealGeneration() const;
+
+    // Check if the table is sealed and its files match the checksum
+    // taken when it was sealed.
+    Bool checkSeal() const;
+
+    // Calculate the checksum of the files in the table directory.
+    // It uses the names and sizes of the regular files (except table.dat
+    // and table.lock), thus it is cheap to calculate.
+    static uInt sealChecksum (const String& tableName);
+
     // Get the locking info.
     virtual const TableLock& lockOptions() const;
 
@@ -201,14 +225,14 @@ public:
 
     // Add one or more rows and possibly initialize them.
     // This will fail for tables not supporting addition of rows.
-    virtual void addRow (uInt nrrow, Bool initialize);
+    virtual void addRow (rownr_t nrrow, Bool initialize);
 
     // Test if it is possible to remove a row from this table.
     virtual Bool canRemoveRow() const;
 
     // Remove the given row.
     // This will fail for tables not supporting removal of rows.
-    virtual void removeRow (uInt rownr);
+    virtual void removeRow (rownr_t rownr);
 
     // Add a column to the table.
     // The last Bool argument is not used in PlainTable, but can be used in
@@ -301,6 +325,9 @@ private:
     Bool           bigEndian_p;        //# True  = big endian canonical
                                        //# False = little endian canonical
     TSMOption      tsmOption_p;
+    Bool           sealed_p;           //# Is the table sealed (immutable)?
+    uInt           sealGeneration_p;   //# Number of times sealed
+    uInt           sealChecksum_p;     //# Checksum of the sealed files
     //# cache of open (plain) tables
     static TableCache theirTableCache;
 };
@@ -40,11 +40,12 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
-RefTable::RefTable (AipsIO& ios, const String& name, uInt nrrow, int opt,
+RefTable::RefTable (AipsIO& ios, const String& name, rownr_t nrrow, int opt,
 		    const TableLock& lockOptions, const TSMOption& tsmOption)
 : BaseTable    (name, opt, nrrow),
   rowStorage_p (0),              // initially empty vector of rownrs
@@ -63,15 +64,18 @@ RefTable::RefTable (AipsIO& ios, const String& name, uInt nrrow, int opt,
 }
 
 
-RefTable::RefTable (BaseTable* btp, Bool order, uInt nrall)
+RefTable::RefTable (BaseTable* btp, Bool order, rownr_t nrall)
 : BaseTable    ("", Table::Scratch, nrall),
   baseTabPtr_p (btp->root()),
   rowOrd_p     (order),
-  rowStorage_p (nrall),       // allocate vector of rownrs
+  rowStorage_p (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (True)
 {
+    //# Allocate vector of rownrs.
+    checkRownr (nrall);
+    rowStorage_p.resize (nrall);
     rows_p = getStorage (rowStorage_p);
     //# Copy the table description and create the columns.
     tdescPtr_p = new TableDesc (btp->tableDesc(), TableDesc::Scratch);
@@ -123,8 +127,8 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
     tdescPtr_p = new TableDesc (btp->tableDesc(), TableDesc::Scratch);
     setup (btp, Vector<String>());
     //# Store the rownr if the mask is set.
-    uInt nr = min (mask.nelements(), btp->nrow());
-    for (uInt i=0; i<nr; i++) {
+    rownr_t nr = min (rownr_t(mask.nelements()), btp->nrow());
+    for (rownr_t i=0; i<nr; i++) {
 	if (mask(i)) {
 	    addRownr (i);
 	}
@@ -156,6 +160,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<String>& columnNames)
     setup (btp, columnNames);
     //# Get the row numbers from the input table.
     //# Copy them to this table.
+    checkRownr (btp->nrow());
     rowStorage_p = btp->rowNumbers();
     rows_p = getStorage (rowStorage_p);
     //# Link to the root table.
@@ -307,13 +312,13 @@ void RefTable::writeRefTable (Bool)
 	    names(i) = tdescPtr_p->columnDesc(i).name();
 	}
 	ios << names;
-	ios << baseTabPtr_p->nrow();
+	ios << uInt(baseTabPtr_p->nrow());
 	ios << rowOrd_p;
-        ios << nrrow_p;
+        ios << uInt(nrrow_p);
         // Do not write more than 2**20 rownrs at once (CAS-7020).
         uInt done = 0;
         while (done < nrrow_p) {
-          uInt todo = std::min(nrrow_p-done, 1048576u);
+          uInt todo = std::min(nrrow_p-done, rownr_t(1048576));
           ios.put (todo, rows_p+done, False);
           done += todo;
         }
@@ -350,7 +355,7 @@ void RefTable::getRef (AipsIO& ios, int opt, const TableLock& lockOptions,
     // Do not read more than 2**20 rows at once (CAS-7020).
     uInt done = 0;
     while (done < nrrow) {
-      uInt todo = std::min(nrrow_p-done, 1048576u);
+      uInt todo = std::min(nrrow_p-done, rownr_t(1048576));
       ios.get (todo, rows_p+done);
       done += todo;
     }
@@ -504,8 +509,18 @@ void RefTable::addRefCol (const TableDesc& tdesc)
 
 
 //# Add a row number of the root table.
-void RefTable::addRownr (uInt rnr)
+void RefTable::checkRownr (rownr_t rownr)
+{
+    if (rownr > rownr_t(std::numeric_limits<uInt>::max())) {
+        throw TableError ("RefTable: row number " + String::toString(rownr) +
+                          " exceeds 2**32-1, which is the maximum that can"
+                          " be referenced by a RefTable");
+    }
+}
+
+void RefTable::addRownr (rownr_t rnr)
 {
+    checkRownr (rnr);
     uInt nrow = rowStorage_p.nelements();
     if (nrrow_p >= nrow) {
         nrow = max ( nrow + 1024, uInt(1.2f * nrow));
@@ -517,7 +532,7 @@ void RefTable::addRownr (uInt rnr)
 }
 
 //# Set exact number of rows.
-void RefTable::setNrrow (uInt nrrow)
+void RefTable::setNrrow (rownr_t nrrow)
 {
     if (nrrow > nrrow_p) {
 	throw (TableError ("RefTable::setNrrow: exceeds current nrrow"));
@@ -680,9 +695,9 @@ Vector<uInt>* RefTable::rowStorage()
 //# Convert a vector of row numbers to row numbers in this table.
 Vector<uInt> RefTable::rootRownr (const Vector<uInt>& rownrs) const
 {
-    uInt nrow = rownrs.nelements();
+    rownr_t nrow = rownrs.nelements();
     Vector<uInt> rnr(nrow);
-    for (uInt i=0; i<nrow; i++) {
+    for (rownr_t i=0; i<nrow; i++) {
 	rnr(i) = rows_p[rownrs(i)];
     }
     return rnr;
@@ -777,7 +792,7 @@ Bool RefTable::canRemoveColumn (const Vector<String>& columnNames) const
 Bool RefTable::canRenameColumn (const String& columnName) const
     { return tdescPtr_p->isColumn (columnName); }
 
-void RefTable::removeRow (uInt rownr)
+void RefTable::removeRow (rownr_t rownr)
 {
     if (rownr >= nrrow_p) {
 	throw (TableInvOper ("removeRow: rownr out of bounds"));
@@ -977,11 +992,12 @@ void RefTable::refXor (uInt nr1, const uInt* inx1,
 }
 
 // Negate a table.
-void RefTable::refNot (uInt nr, const uInt* inx, uInt nrtot)
+void RefTable::refNot (uInt nr, const uInt* inx, rownr_t nrtot)
 {
     // All rows not in the original table must be "selected".
     // The original table has NRTOT rows.
     // So loop through the inx-array and store all rownrs not in the array.
+    checkRownr (nrtot);
     uInt allrow = nrtot - nr;                 // #output rows
     rowStorage_p.resize (allrow);             // allocate output storage
     rows_p = getStorage (rowStorage_p);
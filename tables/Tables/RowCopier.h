@@ -179,9 +179,9 @@ public:
     // The things that actually do the copying when requested.
     // <group>
     // Copy different row numbers.
-    Bool copy (uInt toRow, uInt fromRow);
+    Bool copy (rownr_t toRow, rownr_t fromRow);
     // Copy to and from the same row number
-    Bool copy (uInt rownr);
+    Bool copy (rownr_t rownr);
     // </group>
 
     ~RowCopier();
@@ -200,7 +200,7 @@ private:
 };
 
 
-inline Bool RowCopier::copy (uInt rownr)
+inline Bool RowCopier::copy (rownr_t rownr)
     { return copy (rownr, rownr); }
 
 
@@ -87,17 +87,17 @@ Bool ScalarColumnData<T>::canAccessScalarColumnCells (Bool& reask) const
 
 
 template<class T>
-void ScalarColumnData<T>::initialize (uInt startRow, uInt endRow)
+void ScalarColumnData<T>::initialize (rownr_t startRow, rownr_t endRow)
 {
     if (colDescPtr_p->dataType() != TpOther) {
-	for (uInt i=startRow; i<=endRow; i++) {
+	for (rownr_t i=startRow; i<=endRow; i++) {
 	    dataColPtr_p->put (i, &(scaDescPtr_p->defaultValue()));
 	}
     }
 }	
 
 template<class T>
-Bool ScalarColumnData<T>::isDefined (uInt rownr) const
+Bool ScalarColumnData<T>::isDefined (rownr_t rownr) const
 {
     if (!undefFlag_p) {
 	return True;
@@ -109,7 +109,7 @@ Bool ScalarColumnData<T>::isDefined (uInt rownr) const
 
 
 template<class T>
-void ScalarColumnData<T>::get (uInt rownr, void* val) const
+void ScalarColumnData<T>::get (rownr_t rownr, void* val) const
 {
     if (rtraceColumn_p) {
       TableTrace::trace (traceId(), columnDesc().name(), 'r', rownr);
@@ -154,13 +154,14 @@ void ScalarColumnData<T>::getScalarColumnCells (const RefRows& rownrs,
 
 
 template<class T>
-void ScalarColumnData<T>::put (uInt rownr, const void* val)
+void ScalarColumnData<T>::put (rownr_t rownr, const void* val)
 {
     if (wtraceColumn_p) {
       TableTrace::trace (traceId(), columnDesc().name(), 'w', rownr);
     }
     checkValueLength ((const T*)val);
     checkWriteLock (True);
+    columnChanged (rownr);
     dataColPtr_p->put (rownr, (const T*)val);
     autoReleaseLock();
 }
@@ -177,6 +178,7 @@ void ScalarColumnData<T>::putScalarColumn (const void* val)
     }
     checkValueLength (vecPtr);
     checkWriteLock (True);
+    columnChanged (0);
     dataColPtr_p->putScalarColumnV (vecPtr);
     autoReleaseLock();
 }
@@ -194,6 +196,7 @@ void ScalarColumnData<T>::putScalarColumnCells (const RefRows& rownrs,
     }
     checkValueLength (&vec);
     checkWriteLock (True);
+    columnChanged (rownrs);
     dataColPtr_p->putScalarColumnCellsV (rownrs, &vec);
     autoReleaseLock();
 }
@@ -210,14 +213,14 @@ void ScalarColumnData<T>::makeSortKey (Sort& sortobj,
     //# Get the data as a column.
     //# Save the pointer to the vector for deletion by freeSortKey().
     dataSave = 0;
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     Vector<T>* vecPtr = new Vector<T>(nrrow);
     Bool reask;
     if (canAccessScalarColumn (reask)) {
 	getScalarColumn (vecPtr);
     }else{
 	checkReadLock (True);
-	for (uInt i=0; i<nrrow; i++) {
+	for (rownr_t i=0; i<nrrow; i++) {
 	    dataColPtr_p->get (i,  &(*vecPtr)(i));
 	}
 	autoReleaseLock();
@@ -237,14 +240,14 @@ void ScalarColumnData<T>::makeRefSortKey (Sort& sortobj,
     //#// the consecutive data. Often this may succeed.
     //# Get the data as a column.
     dataSave = 0;
-    uInt nrrow = rownrs.nelements();
+    rownr_t nrrow = rownrs.nelements();
     Vector<T>* vecPtr = new Vector<T>(nrrow);
     Bool reask;
     if (canAccessScalarColumnCells (reask)) {
 	getScalarColumnCells (rownrs, vecPtr);
     }else{
 	checkReadLock (True);
-	for (uInt i=0; i<nrrow; i++) {
+	for (rownr_t i=0; i<nrrow; i++) {
 	    dataColPtr_p->get (rownrs(i),  &(*vecPtr)(i));
 	}
 	autoReleaseLock();
@@ -75,16 +75,16 @@ Bool ScalarRecordColumnData::canAccessScalarColumnCells (Bool& reask) const
 }
 
 
-void ScalarRecordColumnData::initialize (uInt, uInt)
+void ScalarRecordColumnData::initialize (rownr_t, rownr_t)
 {}	
 
-Bool ScalarRecordColumnData::isDefined (uInt) const
+Bool ScalarRecordColumnData::isDefined (rownr_t) const
 {
     return True;
 }
 
 
-void ScalarRecordColumnData::get (uInt rownr, void* val) const
+void ScalarRecordColumnData::get (rownr_t rownr, void* val) const
 {
     checkReadLock (True);
     getRecord (rownr, *(TableRecord*)val);
@@ -118,7 +118,7 @@ void ScalarRecordColumnData::getScalarColumnCells (const RefRows& rownrs,
     RefRowsSliceIter iter(rownrs);
     uInt i=0;
     while (! iter.pastEnd()) {
-	uInt rownr = iter.sliceStart();
+	rownr_t rownr = iter.sliceStart();
 	uInt end = iter.sliceEnd();
 	uInt incr = iter.sliceIncr();
 	while (rownr <= end) {
@@ -131,9 +131,10 @@ void ScalarRecordColumnData::getScalarColumnCells (const RefRows& rownrs,
 }
 
 
-void ScalarRecordColumnData::put (uInt rownr, const void* val)
+void ScalarRecordColumnData::put (rownr_t rownr, const void* val)
 {
     checkWriteLock (True);
+    columnChanged (rownr);
     putRecord (rownr, *(const TableRecord*)val);
     autoReleaseLock();
 }
@@ -147,6 +148,7 @@ void ScalarRecordColumnData::putScalarColumn (const void* val)
                                  ("ScalarRecordColumnData::putScalarColumn"));
     }
     checkWriteLock (True);
+    columnChanged (0);
     for (uInt i=0; i<nr; i++) {
 	putRecord (i, vec(i));
     }
@@ -162,10 +164,11 @@ void ScalarRecordColumnData::putScalarColumnCells (const RefRows& rownrs,
                                  ("ScalarRecordColumnData::putColumnCells"));
     }
     checkWriteLock (True);
+    columnChanged (rownrs);
     RefRowsSliceIter iter(rownrs);
     uInt i=0;
     while (! iter.pastEnd()) {
-	uInt rownr = iter.sliceStart();
+	rownr_t rownr = iter.sliceStart();
 	uInt end = iter.sliceEnd();
 	uInt incr = iter.sliceIncr();
 	while (rownr <= end) {
@@ -178,7 +181,7 @@ void ScalarRecordColumnData::putScalarColumnCells (const RefRows& rownrs,
 }
 
 
-void ScalarRecordColumnData::getRecord (uInt rownr, TableRecord& rec) const
+void ScalarRecordColumnData::getRecord (rownr_t rownr, TableRecord& rec) const
 {
     if (! dataColPtr_p->isShapeDefined (rownr)) {
 	rec = TableRecord();
@@ -196,7 +199,7 @@ void ScalarRecordColumnData::getRecord (uInt rownr, TableRecord& rec) const
     }
 }
 
-void ScalarRecordColumnData::putRecord (uInt rownr, const TableRecord& rec)
+void ScalarRecordColumnData::putRecord (rownr_t rownr, const TableRecord& rec)
 {
     MemoryIO memio;
     AipsIO aio(&memio);
@@ -37,6 +37,7 @@
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableLock.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/TableAttr.h>
 #include <casacore/tables/DataMan/StManColumn.h>
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/casa/Arrays/Vector.h>
@@ -49,7 +50,10 @@
 #include <casacore/casa/OS/File.h>
 #include <casacore/casa/OS/Directory.h>
 #include <casacore/casa/OS/DirectoryIterator.h>
+#include <casacore/casa/OS/Mutex.h>
 #include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <map>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -126,7 +130,7 @@ Table::Table (const String& name, const String& type,
     baseTabPtr_p->link();
 }
 
-Table::Table (SetupNewTable& newtab, uInt nrrow, Bool initialize,
+Table::Table (SetupNewTable& newtab, rownr_t nrrow, Bool initialize,
 	      Table::EndianFormat endianFormat, const TSMOption& tsmOpt)
 : baseTabPtr_p     (0),
   isCounted_p      (True),
@@ -137,7 +141,7 @@ Table::Table (SetupNewTable& newtab, uInt nrrow, Bool initialize,
     baseTabPtr_p->link();
 }
 Table::Table (SetupNewTable& newtab, Table::TableType type,
-	      uInt nrrow, Bool initialize,
+	      rownr_t nrrow, Bool initialize,
 	      Table::EndianFormat endianFormat, const TSMOption& tsmOpt)
 : baseTabPtr_p     (0),
   isCounted_p      (True),
@@ -153,7 +157,7 @@ Table::Table (SetupNewTable& newtab, Table::TableType type,
 }
 Table::Table (SetupNewTable& newtab, Table::TableType type,
 	      const TableLock& lockOptions,
-	      uInt nrrow, Bool initialize,
+	      rownr_t nrrow, Bool initialize,
 	      Table::EndianFormat endianFormat, const TSMOption& tsmOpt)
 : baseTabPtr_p     (0),
   isCounted_p      (True),
@@ -168,7 +172,7 @@ Table::Table (SetupNewTable& newtab, Table::TableType type,
     baseTabPtr_p->link();
 }
 Table::Table (SetupNewTable& newtab, TableLock::LockOption lockOption,
-	      uInt nrrow, Bool initialize, Table::EndianFormat endianFormat,
+	      rownr_t nrrow, Bool initialize, Table::EndianFormat endianFormat,
               const TSMOption& tsmOpt)
 : baseTabPtr_p     (0),
   isCounted_p      (True),
@@ -180,7 +184,7 @@ Table::Table (SetupNewTable& newtab, TableLock::LockOption lockOption,
     baseTabPtr_p->link();
 }
 Table::Table (SetupNewTable& newtab, const TableLock& lockOptions,
-	      uInt nrrow, Bool initialize, Table::EndianFormat endianFormat,
+	      rownr_t nrrow, Bool initialize, Table::EndianFormat endianFormat,
               const TSMOption& tsmOpt)
 : baseTabPtr_p     (0),
   isCounted_p      (True),
@@ -428,9 +432,12 @@ uInt Table::getLayout (TableDesc& desc, const String& tableName)
     uInt nrow, format;
     String tp;
     AipsIO ios (Table::fileName(tabName));
-    ios.getstart ("Table");
+    uInt version = ios.getstart ("Table");
     ios >> nrow;
     ios >> format;
+    Bool sealed;
+    uInt sealGen, sealCheck;
+    BaseTable::readSealInfo (ios, version, sealed, sealGen, sealCheck);
     ios >> tp;
     if (tp == "PlainTable") {
 	PlainTable::getLayout (desc, ios);
@@ -548,14 +555,20 @@ BaseTable* Table::makeBaseTable (const String& name, const String& type,
     //# Determine the kind of table by reading the type.
     String tp;
     uInt version = ios.getstart ("Table");
-    uInt nrrow, format;
+    uInt nrrow, format, sealGen, sealCheck;
+    Bool sealed;
     ios >> nrrow;
     ios >> format;
+    BaseTable::readSealInfo (ios, version, sealed, sealGen, sealCheck);
     ios >> tp;
     if (tp == "PlainTable") {
+        //# A sealed table cannot change, so it is opened without locking.
+        //# PlainTable checks that it is not opened for write.
 	baseTabPtr = new PlainTable (ios, version, name, type, nrrow,
-				     tableOption, lockOptions, tsmOpt,
-                                     addToCache, locknr);
+				     tableOption,
+                                     sealed ? TableLock(TableLock::NoLocking)
+                                            : lockOptions,
+                                     tsmOpt, addToCache, locknr);
     } else if (tp == "RefTable") {
 	baseTabPtr = new RefTable (ios, name, nrrow, tableOption,
                                    lockOptions, tsmOpt);
@@ -838,8 +851,8 @@ TableExprNode Table::nodeRandom () const
 
 //# Select rows based on an expression.
 Table Table::operator() (const TableExprNode& expr,
-                         uInt maxRow, uInt offset) const
-    { return Table (baseTabPtr_p->select (expr, maxRow, offset)); }
+                         rownr_t maxRow, uInt offset, uInt nthreads) const
+    { return Table (baseTabPtr_p->select (expr, maxRow, offset, nthreads)); }
 //# Select rows based on row numbers.
 Table Table::operator() (const Vector<uInt>& rownrs) const
     { return Table (baseTabPtr_p->select (rownrs)); }
@@ -925,9 +938,164 @@ Bool Table::isWritable (const String& tableName, Bool throwIf)
     if (throwIf  &&  !wb) {
         throw TableError("Table " + tableName + " is not writable");
     }
+    if (wb  &&  isSealed (tabName)) {
+        if (throwIf) {
+            throw TableError("Table " + tableName + " is sealed");
+        }
+        wb = False;
+    }
     return wb;
 }
 
+//# The seal state of tables not opened in this process, keyed on table name.
+//# It is valid as long as the table file has the same modification time
+//# and size.
+namespace {
+    struct SealState
+    {
+        uInt  mtime;
+        Int64 size;
+        Bool  sealed;
+    };
+    std::map<String,SealState> theirSealStates;
+    Mutex theirSealMutex;
+}
+
+//# Read the kind and seal info from the table file.
+static void readSealHeader (const String& tabName, String& kind, Bool& sealed,
+                            uInt& sealGeneration, uInt& sealChecksum)
+{
+    AipsIO ios (Table::fileName(tabName));
+    uInt version = ios.getstart ("Table");
+    uInt nrrow, format;
+    ios >> nrrow >> format;
+    BaseTable::readSealInfo (ios, version, sealed, sealGeneration,
+                             sealChecksum);
+    ios >> kind;
+}
+
+//# Get the names of the subtables in the keywords.
+static void collectSubTables (const TableRecord& keys,
+                              std::vector<String>& names)
+{
+    for (uInt i=0; i<keys.nfields(); ++i) {
+        if (keys.type(i) == TpTable) {
+            names.push_back (keys.tableAttributes(i).name());
+        } else if (keys.type(i) == TpRecord) {
+            collectSubTables (keys.subRecord(i), names);
+        }
+    }
+}
+
+void Table::sealTable (const String& tabName, Bool seal,
+                       std::vector<String>& done)
+{
+    if (std::find (done.begin(), done.end(), tabName) != done.end()) {
+        return;
+    }
+    done.push_back (tabName);
+    //# Test this first, because the table file of an open table
+    //# might not have been written yet.
+    if (Table::isOpened (tabName)) {
+        throw TableError ("Table " + tabName + " cannot be " +
+                          (seal ? "sealed" : "unsealed") +
+                          "; it is open in this process");
+    }
+    String kind;
+    Bool sealed;
+    uInt sealGen, sealCheck;
+    readSealHeader (tabName, kind, sealed, sealGen, sealCheck);
+    if (kind != "PlainTable") {
+        return;
+    }
+    std::vector<String> subNames;
+    {
+        Table tab(tabName);
+        collectSubTables (tab.keywordSet(), subNames);
+        const TableDesc& desc = tab.tableDesc();
+        for (uInt i=0; i<desc.ncolumn(); ++i) {
+            collectSubTables (desc[i].keywordSet(), subNames);
+        }
+    }
+    for (uInt i=0; i<subNames.size(); ++i) {
+        if (Table::isReadable (subNames[i])) {
+            sealTable (subNames[i], seal, done);
+        }
+    }
+    if (seal != sealed) {
+        Table tab(tabName, seal ? Table::Update : Table::Old);
+        tab.baseTablePtr()->setSealed (seal);
+    }
+}
+
+void Table::seal (const String& tableName)
+{
+    String tabName = Path(tableName).absoluteName();
+    isReadable (tabName, True);
+    std::vector<String> done;
+    sealTable (tabName, True, done);
+}
+
+void Table::unseal (const String& tableName)
+{
+    String tabName = Path(tableName).absoluteName();
+    isReadable (tabName, True);
+    std::vector<String> done;
+    sealTable (tabName, False, done);
+}
+
+Bool Table::isSealed (const String& tableName)
+{
+    String tabName = Path(tableName).absoluteName();
+    //# Use the table if open in this process, because its table file
+    //# might not have been written yet (e.g. a new table).
+    PlainTable* tab = PlainTable::tableCache()(tabName);
+    if (tab != 0) {
+        return tab->isSealed();
+    }
+    if (! isReadable (tabName)) {
+        return False;
+    }
+    //# Use the cached seal state if the table file has not changed.
+    //# Sealing and unsealing change the size of the table file, because
+    //# only a sealed table has the seal info.
+    File file (Table::fileName(tabName));
+    uInt mtime = file.modifyTime();
+    Int64 size = file.size();
+    {
+        ScopedMutexLock lock(theirSealMutex);
+        std::map<String,SealState>::const_iterator iter =
+                                                theirSealStates.find (tabName);
+        if (iter != theirSealStates.end()  &&
+            iter->second.mtime == mtime  &&  iter->second.size == size) {
+            return iter->second.sealed;
+        }
+    }
+    String kind;
+    Bool sealed;
+    uInt sealGen, sealCheck;
+    readSealHeader (tabName, kind, sealed, sealGen, sealCheck);
+    ScopedMutexLock lock(theirSealMutex);
+    SealState& state = theirSealStates[tabName];
+    state.mtime  = mtime;
+    state.size   = size;
+    state.sealed = sealed;
+    return sealed;
+}
+
+Bool Table::checkSeal (const String& tableName)
+{
+    String tabName = Path(tableName).absoluteName();
+    if (! isReadable (tabName)) {
+        return False;
+    }
+    String kind;
+    Bool sealed;
+    uInt sealGen, sealCheck;
+    readSealHeader (tabName, kind, sealed, sealGen, sealCheck);
+    return sealed  &&  sealCheck == PlainTable::sealChecksum (tabName);
+}
+
 
 TableDesc Table::actualTableDesc() const
 {
@@ -36,6 +36,7 @@
 #include <casacore/tables/DataMan/TSMOption.h>
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/Utilities/Sort.h>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -125,8 +126,8 @@ template<class T> class CountedPtr;
 // Table myTable ("theTable", Table::Update);
 // // Write the column containing the scalar RA.
 // ScalarColumn<double> raColumn(myTable, "RA");
-// uInt nrrow = myTable.nrow();
-// for (uInt i=0; i<nrrow; i++) {
+// rownr_t nrrow = myTable.nrow();
+// for (rownr_t i=0; i<nrrow; i++) {
 //    raColumn.put (i, i+10);    // Put value i+10 into row i
 // }
 // </srcblock>
@@ -270,20 +271,20 @@ public:
     // inspection interval of 5 seconds.
     // <br>The data will be stored in the given endian format.
     // <group>
-    explicit Table (SetupNewTable&, uInt nrrow = 0, Bool initialize = False,
+    explicit Table (SetupNewTable&, rownr_t nrrow = 0, Bool initialize = False,
 		    EndianFormat = Table::AipsrcEndian,
                     const TSMOption& = TSMOption());
     Table (SetupNewTable&, TableType,
-	   uInt nrrow = 0, Bool initialize = False,
+	   rownr_t nrrow = 0, Bool initialize = False,
 	   EndianFormat = Table::AipsrcEndian, const TSMOption& = TSMOption());
     Table (SetupNewTable&, TableType, const TableLock& lockOptions,
-	   uInt nrrow = 0, Bool initialize = False,
+	   rownr_t nrrow = 0, Bool initialize = False,
 	   EndianFormat = Table::AipsrcEndian, const TSMOption& = TSMOption());
     Table (SetupNewTable&, TableLock::LockOption,
-	   uInt nrrow = 0, Bool initialize = False,
+	   rownr_t nrrow = 0, Bool initialize = False,
 	   EndianFormat = Table::AipsrcEndian, const TSMOption& = TSMOption());
     Table (SetupNewTable&, const TableLock& lockOptions,
-	   uInt nrrow = 0, Bool initialize = False,
+	   rownr_t nrrow = 0, Bool initialize = False,
 	   EndianFormat = Table::AipsrcEndian, const TSMOption& = TSMOption());
     // </group>
 
@@ -477,6 +478,12 @@ public:
     // (or is being changed) since the last time this function was called.
     Bool hasDataChanged();
 
+    // Get the modify counter of the table. It is incremented when the
+    // table (data or keywords) is changed, also by another process.
+    // Unlike <src>hasDataChanged</src> it does not acquire a lock, so
+    // the counter is as of the last time the table was locked.
+    uInt getModifyCounter() const;
+
     // Flush the table, i.e. write out the buffers. If <src>sync=True</src>,
     // it is ensured that all data are physically written to disk.
     // Nothing will be done if the table is not writable.
@@ -561,8 +568,38 @@ public:
                           Int maxVal) const;
 
     // Test if a table with the given name exists and is writable.
+    // A sealed table is not writable.
     static Bool isWritable (const String& tableName, bool throwIf=False);
 
+    // Seal a table and all its subtables, i.e. make them immutable.
+    // All data is written and the seal (with a generation number and a
+    // checksum of the table files) is stored in the table files.
+    // A sealed table is opened without any locking and synchronization,
+    // thus without creating or checking lock files. Hence many processes
+    // can read it concurrently without any locking overhead, also on a
+    // shared file system. It cannot be opened for write until unsealed.
+    // <br>The table must not be open in this or another process.
+    // Subtables being a RefTable or ConcatTable are not sealed.
+    // Note that tables written by a sealed table cannot be read by
+    // versions of casacore not knowing about sealing.
+    static void seal (const String& tableName);
+
+    // Unseal a table and all its subtables, so they can be written again.
+    // The table must not be open in this process.
+    static void unseal (const String& tableName);
+
+    // Test if the table with the given name is sealed.
+    static Bool isSealed (const String& tableName);
+
+    // Test if the table with the given name is sealed and its files still
+    // match the checksum taken when sealing. The checksum is based on the
+    // names and sizes of the table files (not their contents), so it is
+    // cheap to check. Subtables are not checked.
+    static Bool checkSeal (const String& tableName);
+
+    // Test if this table is sealed.
+    Bool isSealed() const;
+
     // Find the non-writable files in a table.
     static Vector<String> nonWritableFiles (const String& tableName);
 
@@ -732,7 +769,10 @@ public:
     // process updated the table, thus possible increased the number of rows.
     // If one wants to take that into account, he should acquire a
     // read-lock (using the lock function) before using nrow().
-    uInt nrow() const;
+    // <br>The number of rows is a 64-bit value, so a concatenated table
+    // can have more than 2**32 rows. A plain table cannot, because its
+    // data managers use 32-bit row numbers.
+    rownr_t nrow() const;
 
     // Test if it is possible to add a row to this table.
     // It is possible if all storage managers used for the table
@@ -743,7 +783,7 @@ public:
     // This will fail for tables not supporting addition of rows.
     // Optionally the rows can be initialized with the default
     // values as defined in the column descriptions.
-    void addRow (uInt nrrow = 1, Bool initialize = False);
+    void addRow (rownr_t nrrow = 1, Bool initialize = False);
 
     // Test if it is possible to remove a row from this table.
     // It is possible if all storage managers used for the table
@@ -768,7 +808,7 @@ public:
     // row 21 into row 20.
     // </note>
     // <group>
-    void removeRow (uInt rownr);
+    void removeRow (rownr_t rownr);
     void removeRow (const Vector<uInt>& rownrs);
     // </group>
 
@@ -820,7 +860,13 @@ public:
     // when <src>maxRow</src> rows are selected.
     // <br>The TableExprNode argument can be empty (null) meaning that only
     // the <src>maxRow/offset</src> arguments are taken into account.
-    Table operator() (const TableExprNode&, uInt maxRow=0, uInt offset=0) const;
+    // <br>If <src>nthreads</src> differs from 1, the expression is evaluated
+    // in parallel by that number of threads (0 means
+    // <src>OMP::maxThreads()</src>) if possible (see
+    // <linkto class=TableExprNode>TableExprNode::canGetBlock</linkto>).
+    // Note that table access itself is serialized.
+    Table operator() (const TableExprNode&, rownr_t maxRow=0, uInt offset=0,
+                      uInt nthreads=1) const;
 
     // Select rows using a vector of row numbers.
     // This can, for instance, be used to select the same rows as
@@ -1081,6 +1127,12 @@ private:
     // This is needed for some friend classes.
     BaseTable* baseTablePtr() const;
 
+    // Seal or unseal a plain table and its subtables (which are done first).
+    // The tables already done are skipped, because a subtable can refer
+    // to its parent.
+    static void sealTable (const String& tableName, Bool seal,
+                           std::vector<String>& done);
+
     // Look in the cache if the table is already open.
     // If so, check if table option matches.
     // If needed reopen the table for read/write and merge the lock options.
@@ -1137,6 +1189,8 @@ inline Bool Table::isRootTable() const
 
 inline Bool Table::isWritable() const
     { return baseTabPtr_p->isWritable(); }
+inline Bool Table::isSealed() const
+    { return baseTabPtr_p->isSealed(); }
 inline Bool Table::isColumnWritable (const String& columnName) const
     { return baseTabPtr_p->isColumnWritable (columnName); }
 inline Bool Table::isColumnWritable (uInt columnIndex) const
@@ -1175,7 +1229,7 @@ inline void Table::unmarkForDelete()
 inline Bool Table::isMarkedForDelete() const
     { return baseTabPtr_p->isMarkedForDelete(); }
 
-inline uInt Table::nrow() const
+inline rownr_t Table::nrow() const
     { return baseTabPtr_p->nrow(); }
 inline BaseTable* Table::baseTablePtr() const
     { return baseTabPtr_p; }
@@ -1193,6 +1247,9 @@ inline TableInfo& Table::tableInfo()
 inline void Table::flushTableInfo() const
     { baseTabPtr_p->flushTableInfo(); }
 
+inline uInt Table::getModifyCounter() const
+    { return baseTabPtr_p->getModifyCounter(); }
+
 inline const String& Table::tableName() const
     { return baseTabPtr_p->tableName(); }
 inline Table::TableType Table::tableType() const
@@ -1209,9 +1266,9 @@ inline Bool Table::canRemoveColumn (const Vector<String>& columnNames) const
 inline Bool Table::canRenameColumn (const String& columnName) const
     { return baseTabPtr_p->canRenameColumn (columnName); }
 
-inline void Table::addRow (uInt nrrow, Bool initialize)
+inline void Table::addRow (rownr_t nrrow, Bool initialize)
     { baseTabPtr_p->addRow (nrrow, initialize); }
-inline void Table::removeRow (uInt rownr)
+inline void Table::removeRow (rownr_t rownr)
     { baseTabPtr_p->removeRow (rownr); }
 inline void Table::removeRow (const Vector<uInt>& rownrs)
     { baseTabPtr_p->removeRow (rownrs); }
@@ -127,77 +127,77 @@ Table TableColumn::table() const
     { return Table (baseTabPtr_p, False); }
 
 
-Bool TableColumn::asBool (uInt rownr) const
+Bool TableColumn::asBool (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     Bool value;
     baseColPtr_p->getScalar (rownr, value);
     return value;
 }
-uChar TableColumn::asuChar (uInt rownr) const
+uChar TableColumn::asuChar (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     uChar value;
     baseColPtr_p->getScalar (rownr, value);
     return value;
 }
-Short TableColumn::asShort (uInt rownr) const
+Short TableColumn::asShort (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     Short value;
     baseColPtr_p->getScalar (rownr, value);
     return value;
 }
-uShort TableColumn::asuShort (uInt rownr) const
+uShort TableColumn::asuShort (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     uShort value;
     baseColPtr_p->getScalar (rownr, value);
     return value;
 }
-Int TableColumn::asInt (uInt rownr) const
+Int TableColumn::asInt (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     Int value;
     baseColPtr_p->getScalar (rownr, value);
     return value;
 }
-uInt TableColumn::asuInt (uInt rownr) const
+uInt TableColumn::asuInt (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     uInt value;
     baseColPtr_p->getScalar (rownr, value);
     return value;
 }
-float TableColumn::asfloat (uInt rownr) const
+float TableColumn::asfloat (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     float value;
     baseColPtr_p->getScalar (rownr, value);
     return value;
 }
-double TableColumn::asdouble (uInt rownr) const
+double TableColumn::asdouble (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     double value;
     baseColPtr_p->getScalar (rownr, value);
     return value;
 }
-Complex TableColumn::asComplex (uInt rownr) const
+Complex TableColumn::asComplex (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     Complex value;
     baseColPtr_p->getScalar (rownr, value);
     return value;
 }
-DComplex TableColumn::asDComplex (uInt rownr) const
+DComplex TableColumn::asDComplex (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     DComplex value;
     baseColPtr_p->getScalar (rownr, value);
     return value;
 }
-String TableColumn::asString (uInt rownr) const
+String TableColumn::asString (rownr_t rownr) const
 {
     TABLECOLUMNCHECKROW(rownr); 
     String value;
@@ -206,8 +206,8 @@ String TableColumn::asString (uInt rownr) const
 }
 
 
-void TableColumn::put (uInt thisRownr, const TableColumn& that,
-		       uInt thatRownr, Bool preserveTileShape)
+void TableColumn::put (rownr_t thisRownr, const TableColumn& that,
+		       rownr_t thatRownr, Bool preserveTileShape)
 {
   TABLECOLUMNCHECKROW(thisRownr);
   checkWritable();
@@ -435,11 +435,11 @@ void TableColumn::put (uInt thisRownr, const TableColumn& that,
 void TableColumn::putColumn (const TableColumn& that)
 {
     checkWritable();
-    uInt nrrow = nrow();
+    rownr_t nrrow = nrow();
     if (nrrow != that.nrow()) {
 	throw (TableConformanceError ("TableColumn::putColumn"));
     }
-    for (uInt i=0; i<nrrow; i++) {
+    for (rownr_t i=0; i<nrrow; i++) {
 	put (i, that, i);
     }
 }
@@ -450,7 +450,7 @@ void TableColumn::throwNotWritable() const
                     baseTabPtr_p->tableName() + " is not writable");
 }
 
-Bool TableColumn::hasContent (uInt rownr) const
+Bool TableColumn::hasContent (rownr_t rownr) const
 {
   Bool retval = !isNull() && isDefined(rownr);
   if (retval  &&  columnDesc().isArray()) {
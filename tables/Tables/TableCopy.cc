@@ -33,6 +33,8 @@
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/tables/Tables/TableLocker.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/tables/DataMan/DataManInfo.h>
@@ -41,7 +43,15 @@
 #include <casacore/casa/Utilities/LinearSearch.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/OS/Path.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/OS/OMP.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <casacore/casa/iostream.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <algorithm>
+#include <map>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -53,7 +63,8 @@ Table TableCopy::makeEmptyTable (const String& newName,
 				 Table::EndianFormat endianFormat,
 				 Bool replaceTSM,
 				 Bool noRows,
-                                 const StorageOption& stopt)
+                                 const StorageOption& stopt,
+                                 const TableLock& lockOptions)
 {
   TableDesc tabDesc = tab.actualTableDesc();
   Record dminfo (dataManagerInfo);
@@ -74,7 +85,8 @@ Table TableCopy::makeEmptyTable (const String& newName,
   dminfo = DataManInfo::adjustStMan (dminfo, "StandardStMan", True);
   SetupNewTable newtab (newName, tabDesc, option, stopt);
   newtab.bindCreate (dminfo);
-  return Table(newtab, (noRows ? 0 : tab.nrow()), False, endianFormat);
+  return Table(newtab, lockOptions, (noRows ? 0 : tab.nrow()), False,
+               endianFormat);
 }
 
 Table TableCopy::makeEmptyMemoryTable (const String& newName,
@@ -88,9 +100,237 @@ Table TableCopy::makeEmptyMemoryTable (const String& newName,
   return Table(newtab, Table::Memory, (noRows ? 0 : tab.nrow()));
 }
 
-void TableCopy::copyRows (Table& out, const Table& in, uInt startout,
-			  uInt startin, uInt nrrow, Bool flush)
+// Helper classes to copy a column in blocks of rows.
+// They are created before the copy starts, because creating column objects
+// is not thread-safe.
+class TableCopyColumn
 {
+public:
+  virtual ~TableCopyColumn()
+    {}
+  // Copy the rows and return the number of bytes copied.
+  virtual Int64 copy (uInt startout, uInt startin, uInt nrrow) = 0;
+};
+
+// Copy blocks of about 4 MB.
+static const Int64 theCopyBlockSize = 4194304;
+
+template<typename T>
+inline Int64 tableCopyNBytes (const Array<T>& arr)
+  { return arr.nelements() * sizeof(T); }
+inline Int64 tableCopyNBytes (const Array<String>& arr)
+{
+  Int64 nbytes = 0;
+  for (Array<String>::const_iterator iter=arr.begin();
+       iter!=arr.end(); ++iter) {
+    nbytes += iter->size();
+  }
+  return nbytes;
+}
+
+template<typename T>
+class TableCopyScalarColumn : public TableCopyColumn
+{
+public:
+  TableCopyScalarColumn (Table& out, const Table& in, const String& name)
+    : out_p (out, name),
+      in_p  (in, name)
+    {}
+  virtual Int64 copy (uInt startout, uInt startin, uInt nrrow)
+  {
+    uInt blockSize = std::max (Int64(1), theCopyBlockSize / Int64(sizeof(T)));
+    Int64 nbytes = 0;
+    Vector<T> buf;
+    for (uInt i=0; i<nrrow; i+=blockSize) {
+      uInt nr = std::min (blockSize, nrrow-i);
+      in_p.getColumnRange (Slicer(IPosition(1,startin+i), IPosition(1,nr)),
+                           buf, True);
+      out_p.putColumnRange (Slicer(IPosition(1,startout+i), IPosition(1,nr)),
+                            buf);
+      nbytes += tableCopyNBytes (buf);
+    }
+    return nbytes;
+  }
+private:
+  ScalarColumn<T> out_p;
+  ScalarColumn<T> in_p;
+};
+
+template<typename T>
+class TableCopyArrayColumn : public TableCopyColumn
+{
+public:
+  TableCopyArrayColumn (Table& out, const Table& in, const String& name)
+    : out_p (out, name),
+      in_p  (in, name)
+    {}
+  // Copy the rows in blocks of cells with the same shape.
+  // Undefined cells are not copied.
+  virtual Int64 copy (uInt startout, uInt startin, uInt nrrow)
+  {
+    Bool fixed = in_p.columnDesc().isFixedShape();
+    Int64 nbytes = 0;
+    Array<T> buf;
+    uInt i = 0;
+    while (i < nrrow) {
+      uInt inrow = startin + i;
+      if (!fixed  &&  !in_p.isDefined (inrow)) {
+        i++;
+        continue;
+      }
+      IPosition shape = (fixed  ?  in_p.shapeColumn() : in_p.shape(inrow));
+      Int64 cellSize = std::max (Int64(1), shape.product()) * sizeof(T);
+      uInt maxnr = std::min (Int64(nrrow - i),
+                             std::max (Int64(1), theCopyBlockSize / cellSize));
+      uInt nr = 1;
+      if (fixed) {
+        nr = maxnr;
+      } else {
+        while (nr < maxnr  &&  in_p.isDefined (inrow+nr)  &&
+               in_p.shape(inrow+nr).isEqual (shape)) {
+          nr++;
+        }
+      }
+      in_p.getColumnRange (Slicer(IPosition(1,inrow), IPosition(1,nr)),
+                           buf, True);
+      out_p.putColumnRange (Slicer(IPosition(1,startout+i), IPosition(1,nr)),
+                            buf);
+      nbytes += tableCopyNBytes (buf);
+      i += nr;
+    }
+    return nbytes;
+  }
+private:
+  ArrayColumn<T> out_p;
+  ArrayColumn<T> in_p;
+};
+
+// Make the object to copy a column in blocks.
+// A null pointer is returned if it cannot be copied in blocks.
+template<typename T>
+static TableCopyColumn* makeTableCopyColumn (Table& out, const Table& in,
+                                             const String& name,
+                                             Bool isScalar)
+{
+  if (isScalar) {
+    return new TableCopyScalarColumn<T> (out, in, name);
+  }
+  return new TableCopyArrayColumn<T> (out, in, name);
+}
+
+static TableCopyColumn* makeTableCopyColumn (Table& out, const Table& in,
+                                             const String& name)
+{
+  const ColumnDesc& outDesc = out.tableDesc()[name];
+  const ColumnDesc& inDesc  = in.tableDesc()[name];
+  if (outDesc.dataType() != inDesc.dataType()  ||
+      outDesc.isScalar() != inDesc.isScalar()  ||
+      outDesc.isArray()  != inDesc.isArray()) {
+    return 0;
+  }
+  Bool isScalar = inDesc.isScalar();
+  switch (inDesc.dataType()) {
+  case TpBool:
+    return makeTableCopyColumn<Bool> (out, in, name, isScalar);
+  case TpUChar:
+    return makeTableCopyColumn<uChar> (out, in, name, isScalar);
+  case TpShort:
+    return makeTableCopyColumn<Short> (out, in, name, isScalar);
+  case TpUShort:
+    return makeTableCopyColumn<uShort> (out, in, name, isScalar);
+  case TpInt:
+    return makeTableCopyColumn<Int> (out, in, name, isScalar);
+  case TpUInt:
+    return makeTableCopyColumn<uInt> (out, in, name, isScalar);
+  case TpFloat:
+    return makeTableCopyColumn<Float> (out, in, name, isScalar);
+  case TpDouble:
+    return makeTableCopyColumn<Double> (out, in, name, isScalar);
+  case TpComplex:
+    return makeTableCopyColumn<Complex> (out, in, name, isScalar);
+  case TpDComplex:
+    return makeTableCopyColumn<DComplex> (out, in, name, isScalar);
+  case TpString:
+    return makeTableCopyColumn<String> (out, in, name, isScalar);
+  default:
+    return 0;
+  }
+}
+
+// Get the object a column's data manager uses for its I/O.
+// Data managers in the same MultiFile share it.
+// A null pointer is returned for a virtual column engine.
+static const void* tableCopyIOKey (const Table& tab, const String& name)
+{
+  const DataManager* dm = tab.findDataManager (name, True);
+  if (! dm->isStorageManager()) {
+    return 0;
+  }
+  DataManager* ncdm = const_cast<DataManager*>(dm);
+  if (ncdm->multiFile()) {
+    return ncdm->multiFile();
+  }
+  return dm;
+}
+
+static Bool tableCopyAutoLocking (const Table& tab)
+{
+  TableLock::LockOption opt = tab.lockOptions().option();
+  return opt == TableLock::AutoLocking  ||  opt == TableLock::AutoNoReadLocking;
+}
+
+// Divide the columns in groups not sharing a data manager in input and
+// output. It returns False if the columns cannot be copied in parallel.
+static Bool tableCopyGroups (Table& out, const Table& in,
+                             const Vector<String>& cols,
+                             std::vector<Int>& groups)
+{
+  groups.assign (cols.size(), 0);
+  if (tableCopyAutoLocking(out)  ||  tableCopyAutoLocking(in)  ||
+      in.getPartNames(True).size() > 1) {
+    return False;
+  }
+  std::map<const void*,Int> keyGroups;
+  for (uInt i=0; i<cols.size(); ++i) {
+    const void* keys[2];
+    keys[0] = tableCopyIOKey (in, cols[i]);
+    keys[1] = tableCopyIOKey (out, cols[i]);
+    if (keys[0] == 0  ||  keys[1] == 0) {
+      return False;
+    }
+    groups[i] = i;
+    for (uInt j=0; j<2; ++j) {
+      std::map<const void*,Int>::iterator iter = keyGroups.find (keys[j]);
+      if (iter == keyGroups.end()) {
+        keyGroups[keys[j]] = groups[i];
+      } else if (iter->second != groups[i]) {
+        // Merge the groups.
+        Int oldGroup = groups[i];
+        Int newGroup = iter->second;
+        for (uInt k=0; k<=i; ++k) {
+          if (groups[k] == oldGroup) {
+            groups[k] = newGroup;
+          }
+        }
+        for (iter=keyGroups.begin(); iter!=keyGroups.end(); ++iter) {
+          if (iter->second == oldGroup) {
+            iter->second = newGroup;
+          }
+        }
+      }
+    }
+  }
+  return True;
+}
+
+TableCopy::CopyStatistics TableCopy::copyRows (Table& out, const Table& in,
+                                               uInt startout, uInt startin,
+                                               uInt nrrow, Bool flush,
+                                               uInt nthreads)
+{
+  Timer timer;
+  CopyStatistics stats;
+  stats.nrow = nrrow;
   // Check if startin and nrrow are correct for input.
   if (startin + nrrow > in.nrow()) {
     throw TableError ("TableCopy: startin+nrrow exceed nr of input rows");
@@ -101,29 +341,98 @@ void TableCopy::copyRows (Table& out, const Table& in, uInt startout,
   Vector<String> columns = outrow.columnNames();
   const TableDesc& tdesc = in.tableDesc();
   // Only copy the columns that exist in the input table.
-  Vector<String> cols(columns.nelements());
-  uInt nrcol = 0;
+  // Determine which ones can be copied in blocks.
+  Vector<String> rowCols(columns.nelements());
+  Vector<String> blockCols(columns.nelements());
+  std::vector<CountedPtr<TableCopyColumn> > copiers;
+  uInt nrowcol = 0;
   for (uInt i=0; i<columns.nelements(); i++) {
     if (tdesc.isColumn (columns(i))) {
-      cols(nrcol++) = columns(i);
+      TableCopyColumn* copier = makeTableCopyColumn (out, in, columns(i));
+      if (copier) {
+        blockCols(copiers.size()) = columns(i);
+        copiers.push_back (copier);
+      } else {
+        rowCols(nrowcol++) = columns(i);
+      }
     }
   }
-  if (nrcol > 0) {
-    cols.resize (nrcol, True);
-    // Add rows as needed.
-    if (startout + nrrow > out.nrow()) {
-      out.addRow (startout + nrrow - out.nrow());
+  blockCols.resize (copiers.size(), True);
+  rowCols.resize (nrowcol, True);
+  if (copiers.empty()  &&  nrowcol == 0) {
+    return stats;
+  }
+  // Add rows as needed.
+  if (startout + nrrow > out.nrow()) {
+    out.addRow (startout + nrrow - out.nrow());
+  }
+  // Copy the columns in blocks; in parallel if possible.
+  if (! copiers.empty()) {
+    if (nthreads == 0) {
+      nthreads = OMP::maxThreads();
+    }
+    std::vector<Int> groups;
+    if (nthreads <= 1  ||  !tableCopyGroups (out, in, blockCols, groups)) {
+      for (uInt i=0; i<copiers.size(); ++i) {
+        stats.nbytes += copiers[i]->copy (startout, startin, nrrow);
+      }
+    } else {
+      std::vector<Int> groupIds (groups);
+      std::sort (groupIds.begin(), groupIds.end());
+      groupIds.erase (std::unique (groupIds.begin(), groupIds.end()),
+                      groupIds.end());
+      stats.nthreads = std::min (nthreads, uInt(groupIds.size()));
+      // Lock the tables, so no locking is done in the threads.
+      Table inTab(in);
+      TableLocker inLocker (inTab, FileLocker::Read);
+      TableLocker outLocker (out, FileLocker::Write);
+      Int64 nbytes = 0;
+      String errMsg;
+#pragma omp parallel for num_threads(stats.nthreads) schedule(dynamic) reduction(+:nbytes)
+      for (Int g=0; g<Int(groupIds.size()); ++g) {
+        try {
+          for (uInt i=0; i<copiers.size(); ++i) {
+            if (groups[i] == groupIds[g]) {
+              nbytes += copiers[i]->copy (startout, startin, nrrow);
+            }
+          }
+        } catch (const std::exception& x) {
+#pragma omp critical(TableCopy_copyRows)
+          {
+            if (errMsg.empty()) {
+              errMsg = x.what();
+            }
+          }
+        }
+      }
+      if (! errMsg.empty()) {
+        throw TableError ("TableCopy::copyRows: " + errMsg);
+      }
+      stats.nbytes = nbytes;
     }
-    ROTableRow inrow(in, cols);
-    outrow = TableRow(out, cols);
+  }
+  // Copy the other columns row by row.
+  if (nrowcol > 0) {
+    ROTableRow inrow(in, rowCols);
+    outrow = TableRow(out, rowCols);
     for (uInt i=0; i<nrrow; i++) {
       inrow.get (startin + i);
       outrow.put (startout + i, inrow.record(), inrow.getDefined(), False);
     }
-    if (flush) {
-      out.flush();
-    }
   }
+  if (flush) {
+    out.flush();
+  }
+  stats.seconds = timer.real();
+  return stats;
+}
+
+void TableCopy::CopyStatistics::show (ostream& os) const
+{
+  os << "copied " << nrow << " rows (" << nbytes/1e6 << " MB) in "
+     << seconds << " sec using " << nthreads << " thread"
+     << (nthreads == 1 ? "" : "s") << ": " << throughput() << " MB/sec"
+     << endl;
 }
 
 void TableCopy::copyInfo (Table& out, const Table& in)
@@ -65,6 +65,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //       existing table.
 //  <li> <src>copyRows</src> copies the data of one to another table.
 //       It is possible to specify where to start in the input and output.
+//       The data are copied column by column in large blocks of rows.
+//       Columns in independent data managers can be copied in parallel.
 //  <li> <src>CopyInfo</src> copies the table info data.
 //  <li> <src>copySubTables</src> copies all the subtables in table and
 //       column keywords. It is done recursively.
@@ -89,6 +91,7 @@ public:
   // <br>By default, the TiledDataStMan will be replaced by the TiledShapeStMan.
   // <br>By default, the new table has the same nr of rows as the input table.
   // If <src>noRows=True</src> is given, it does not contain any row.
+  // <br>The new table is opened with the given locking options.
   static Table makeEmptyTable (const String& newName,
 			       const Record& dataManagerInfo,
 			       const Table& tab,
@@ -96,7 +99,8 @@ public:
 			       Table::EndianFormat endianFormat,
 			       Bool replaceTSM = True,
 			       Bool noRows = False,
-                               const StorageOption& = StorageOption());
+                               const StorageOption& = StorageOption(),
+                               const TableLock& = TableLock());
 
   // Make an (empty) memory table with the same layout as the input one.
   // It has the same keywords and columns as the input one.
@@ -106,6 +110,25 @@ public:
 				     const Table& tab,
 				     Bool noRows = False);
 
+  // Statistics of a copy done by <src>copyRows</src>.
+  struct CopyStatistics {
+    CopyStatistics()
+      : nrow(0), nbytes(0), seconds(0), nthreads(1) {}
+    // Get the throughput in MB/sec.
+    Double throughput() const
+      { return (seconds > 0  ?  nbytes / seconds / 1e6 : 0); }
+    // Show the statistics on one line.
+    void show (ostream&) const;
+    // Number of rows copied.
+    rownr_t nrow;
+    // Approximate number of data bytes copied.
+    Int64   nbytes;
+    // Elapsed time of the copy.
+    Double  seconds;
+    // Number of threads used.
+    uInt    nthreads;
+  };
+
   // Copy rows from the input to the output.
   // By default all rows will be copied starting at row 0 of the output.
   // Rows will be added to the output table as needed.
@@ -114,12 +137,26 @@ public:
   // column with the same name in table <src>in</src>. In principle only
   // stored columns will be filled; however if the output table has only
   // one column, it can also be a virtual one.
+  // <br>Columns with the same data type in input and output are copied in
+  // blocks of rows (arrays in blocks of cells with equal shape). Other
+  // columns (e.g., records or columns needing type conversion) are copied
+  // row by row.
+  // <br>The columns are divided in groups not sharing a data manager
+  // (or MultiFile) in input or output. The groups are copied in parallel
+  // using at most <src>nthreads</src> threads (0 means the OpenMP default).
+  // Because the table system is not thread-safe, it is only done if all
+  // data managers involved are storage managers, the input is not a
+  // concatenated table, and neither table uses AutoLocking (because an
+  // auto lock can be released at any time). For a parallel copy open the
+  // input table with, say, <src>TableLock::UserNoReadLocking</src>.
+  // <br>The statistics of the copy are returned.
   // <group>
-  static void copyRows (Table& out, const Table& in, Bool flush=True)
-    { copyRows (out, in, 0, 0, in.nrow(), flush); }
-  static void copyRows (Table& out, const Table& in,
-			uInt startout, uInt startin, uInt nrrow,
-                        Bool flush=True);
+  static CopyStatistics copyRows (Table& out, const Table& in,
+                                  Bool flush=True, uInt nthreads=0)
+    { return copyRows (out, in, 0, 0, in.nrow(), flush, nthreads); }
+  static CopyStatistics copyRows (Table& out, const Table& in,
+                                  uInt startout, uInt startin, uInt nrrow,
+                                  Bool flush=True, uInt nthreads=0);
   // </group>
 
   // Copy the table info block from input to output table.
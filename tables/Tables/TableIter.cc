@@ -135,6 +135,26 @@ TableIterator::copyState(const TableIterator &other)
     tabIterPtr_p->copyState(*other.tabIterPtr_p);
 }
 
+uInt TableIterator::ngroup() const
+{
+    return tabIterPtr_p->groupBoundaries().size() - 1;
+}
+
+const std::vector<rownr_t>& TableIterator::groupBoundaries() const
+{
+    return tabIterPtr_p->groupBoundaries();
+}
+
+Table TableIterator::group (uInt groupnr) const
+{
+    return Table(tabIterPtr_p->group (groupnr));
+}
+
+Table TableIterator::sortedTable() const
+{
+    return Table(tabIterPtr_p->sortedTable());
+}
+
 // Report Name of slowest column that changes at end of current iteration
 const String& TableIterator::keyChangeAtLastNext() const
 { 
@@ -33,6 +33,7 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/Compare.h>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -76,6 +77,12 @@ template<class T> class Block;
 //
 // The table is sorted before doing the iteration unless TableIterator::NoSort
 // is given.
+//
+// Besides stepping through the groups one by one, it is possible to
+// determine the boundaries of all groups in advance and to get an arbitrary
+// group using the function <src>group</src>. This is used by
+// <linkto class=ParallelTableIterator>ParallelTableIterator</linkto> to
+// process the groups in parallel.
 // </synopsis> 
 
 // <example>
@@ -213,6 +220,24 @@ public:
     // Get the current group.
     Table table() const;
 
+    // Get the number of iteration groups.
+    // The group boundaries are determined on first use.
+    uInt ngroup() const;
+
+    // Get the boundaries of the groups in the table returned by
+    // <src>sortedTable</src>. Element i gives the first row of group i;
+    // the last element gives the total number of rows.
+    const std::vector<rownr_t>& groupBoundaries() const;
+
+    // Get the given group (0-based).
+    // It does not change the state of the iteration.
+    Table group (uInt groupnr) const;
+
+    // Get a table containing all rows in iteration order.
+    // Each call gives a new reference table, so several threads can each
+    // have their own table (and column) objects.
+    Table sortedTable() const;
+
 protected:
     BaseTableIterator* tabIterPtr_p;
     Table              subTable_p;
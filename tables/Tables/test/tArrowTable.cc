@@ -0,0 +1,253 @@
+//# tArrowTable.cc: Test program for the Arrow table classes
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables/ArrowTable.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayIO.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// This program tests classes ArrowTableWriter and ArrowTableReader
+// by writing a table to an Arrow file and reading it back.
+// The Arrow file can also be checked with pyarrow, for example:
+//   python -c "import pyarrow.ipc as i; print(i.open_file('tArrowTable_tmp.arrow').read_all())"
+
+void createTable (uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Bool>("BOOL"));
+  td.addColumn (ScalarColumnDesc<uChar>("UCHAR"));
+  td.addColumn (ScalarColumnDesc<Short>("SHORT"));
+  td.addColumn (ScalarColumnDesc<uShort>("USHORT"));
+  td.addColumn (ScalarColumnDesc<Int>("INT"));
+  td.addColumn (ScalarColumnDesc<uInt>("UINT"));
+  td.addColumn (ScalarColumnDesc<Float>("FLOAT"));
+  td.addColumn (ScalarColumnDesc<Double>("TIME"));
+  td.addColumn (ScalarColumnDesc<Complex>("COMPLEX"));
+  td.addColumn (ScalarColumnDesc<DComplex>("DCOMPLEX"));
+  td.addColumn (ScalarColumnDesc<String>("STRING"));
+  td.addColumn (ArrayColumnDesc<Double>("UVW", IPosition(1,3),
+                                        ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Complex>("DATA", IPosition(2,2,5),
+                                         ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Bool>("FLAG", IPosition(2,2,5),
+                                      ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Float>("VARSHAPE"));
+  SetupNewTable newtab("tArrowTable_tmp.data", td, Table::New);
+  Table tab(newtab, nrow);
+  ScalarColumn<Bool> boolCol(tab, "BOOL");
+  ScalarColumn<uChar> ucharCol(tab, "UCHAR");
+  ScalarColumn<Short> shortCol(tab, "SHORT");
+  ScalarColumn<uShort> ushortCol(tab, "USHORT");
+  ScalarColumn<Int> intCol(tab, "INT");
+  ScalarColumn<uInt> uintCol(tab, "UINT");
+  ScalarColumn<Float> floatCol(tab, "FLOAT");
+  ScalarColumn<Double> timeCol(tab, "TIME");
+  ScalarColumn<Complex> complexCol(tab, "COMPLEX");
+  ScalarColumn<DComplex> dcomplexCol(tab, "DCOMPLEX");
+  ScalarColumn<String> stringCol(tab, "STRING");
+  ArrayColumn<Double> uvwCol(tab, "UVW");
+  ArrayColumn<Complex> dataCol(tab, "DATA");
+  ArrayColumn<Bool> flagCol(tab, "FLAG");
+  ArrayColumn<Float> varCol(tab, "VARSHAPE");
+  for (uInt i=0; i<nrow; i++) {
+    boolCol.put (i, i%3 == 0);
+    ucharCol.put (i, i%256);
+    shortCol.put (i, -Int(i));
+    ushortCol.put (i, i+1);
+    intCol.put (i, -10*Int(i));
+    uintCol.put (i, 10*i);
+    floatCol.put (i, i+0.5);
+    timeCol.put (i, 4.8e9 + i);
+    complexCol.put (i, Complex(i, -Float(i)));
+    dcomplexCol.put (i, DComplex(2*i, -2.*i));
+    stringCol.put (i, (i%4 == 0 ? String() : "str" + String::toString(i)));
+    Vector<Double> uvw(3);
+    indgen (uvw, Double(3*i));
+    uvwCol.put (i, uvw);
+    Matrix<Complex> data(2,5);
+    indgen (data, Complex(i, i));
+    dataCol.put (i, data);
+    Matrix<Bool> flag(2,5, False);
+    flag(i%2, i%5) = True;
+    flagCol.put (i, flag);
+    varCol.put (i, Vector<Float>(1+i%3, 1.));
+  }
+}
+
+template<typename T>
+void checkScalar (const ArrowTableReader& reader, const Table& tab,
+                  const String& name)
+{
+  Array<T> arr = reader.getColumn<T> (name);
+  AlwaysAssertExit (arr.shape().isEqual (IPosition(1, tab.nrow())));
+  AlwaysAssertExit (allEQ (arr, ScalarColumn<T>(tab, name).getColumn()));
+  // Check per batch.
+  rownr_t row = 0;
+  for (uInt i=0; i<reader.nbatch(); i++) {
+    Array<T> barr = reader.getColumn<T> (name, i);
+    rownr_t nr = reader.batchRows(i);
+    AlwaysAssertExit (barr.shape().isEqual (IPosition(1, nr)));
+    AlwaysAssertExit (allEQ (barr, ScalarColumn<T>(tab, name).getColumnRange
+                             (Slicer(IPosition(1,row), IPosition(1,nr)))));
+    row += nr;
+  }
+}
+
+template<typename T>
+void checkArray (const ArrowTableReader& reader, const Table& tab,
+                 const String& name)
+{
+  Array<T> arr = reader.getColumn<T> (name);
+  AlwaysAssertExit (allEQ (arr, ArrayColumn<T>(tab, name).getColumn()));
+}
+
+void checkFile (const String& fileName, const Table& tab, uInt nbatch)
+{
+  ArrowTableReader reader(fileName);
+  cout << "nrow=" << reader.nrow() << " nbatch=" << reader.nbatch()
+       << " columns=" << reader.columnNames() << endl;
+  AlwaysAssertExit (reader.nrow() == tab.nrow());
+  AlwaysAssertExit (reader.nbatch() == nbatch);
+  Vector<String> names = reader.columnNames();
+  for (uInt i=0; i<names.size(); i++) {
+    cout << "  " << names[i] << ' ' << reader.dataType(names[i])
+         << ' ' << reader.shape(names[i]) << endl;
+  }
+  checkScalar<Bool> (reader, tab, "BOOL");
+  checkScalar<uChar> (reader, tab, "UCHAR");
+  checkScalar<Short> (reader, tab, "SHORT");
+  checkScalar<uShort> (reader, tab, "USHORT");
+  checkScalar<Int> (reader, tab, "INT");
+  checkScalar<uInt> (reader, tab, "UINT");
+  checkScalar<Float> (reader, tab, "FLOAT");
+  checkScalar<Double> (reader, tab, "TIME");
+  checkScalar<Complex> (reader, tab, "COMPLEX");
+  checkScalar<DComplex> (reader, tab, "DCOMPLEX");
+  checkScalar<String> (reader, tab, "STRING");
+  checkArray<Double> (reader, tab, "UVW");
+  checkArray<Complex> (reader, tab, "DATA");
+  checkArray<Bool> (reader, tab, "FLAG");
+  AlwaysAssertExit (! reader.isColumn ("VARSHAPE"));
+  // A type mismatch is an error.
+  Bool ok = False;
+  try {
+    reader.getColumn<Float> ("TIME");
+  } catch (const TableError& x) {
+    cout << "Expected exception: " << x.getMesg() << endl;
+    ok = True;
+  }
+  AlwaysAssertExit (ok);
+}
+
+void checkTable (const Table& tab1, const Table& tab2)
+{
+  AlwaysAssertExit (tab1.nrow() == tab2.nrow());
+  AlwaysAssertExit (allEQ (ScalarColumn<Double>(tab1, "TIME").getColumn(),
+                           ScalarColumn<Double>(tab2, "TIME").getColumn()));
+  AlwaysAssertExit (allEQ (ScalarColumn<String>(tab1, "STRING").getColumn(),
+                           ScalarColumn<String>(tab2, "STRING").getColumn()));
+  AlwaysAssertExit (allEQ (ArrayColumn<Complex>(tab1, "DATA").getColumn(),
+                           ArrayColumn<Complex>(tab2, "DATA").getColumn()));
+  AlwaysAssertExit (allEQ (ArrayColumn<Bool>(tab1, "FLAG").getColumn(),
+                           ArrayColumn<Bool>(tab2, "FLAG").getColumn()));
+}
+
+int main()
+{
+  try {
+    createTable (100);
+    Table tab("tArrowTable_tmp.data");
+    AlwaysAssertExit (! ArrowTableWriter::canWrite (tab, "VARSHAPE"));
+    // Write all columns in a single batch.
+    ArrowTableWriter::write (tab, "tArrowTable_tmp.arrow");
+    checkFile ("tArrowTable_tmp.arrow", tab, 1);
+    // The data of a single batch are not copied.
+    {
+      ArrowTableReader reader("tArrowTable_tmp.arrow");
+      Array<Double> uvw = reader.getColumn<Double> ("UVW");
+      Array<Double> uvw2 = reader.getColumn<Double> ("UVW");
+      AlwaysAssertExit (uvw.data() == uvw2.data());
+    }
+    // Write in batches of 30 rows (the last one is shorter).
+    ArrowTableWriter::write (tab, "tArrowTable_tmp.arrow2",
+                             Vector<String>(), 30);
+    checkFile ("tArrowTable_tmp.arrow2", tab, 4);
+    // Convert back to a table.
+    {
+      ArrowTableReader reader("tArrowTable_tmp.arrow2");
+      Table tab2 = reader.toTable ("tArrowTable_tmp.data2");
+      checkTable (tab, tab2);
+    }
+    // Write a selection of columns.
+    ArrowTableWriter::write (tab, "tArrowTable_tmp.arrow3",
+                             stringToVector("TIME,UVW"));
+    {
+      ArrowTableReader reader("tArrowTable_tmp.arrow3");
+      cout << reader.columnNames() << endl;
+      AlwaysAssertExit (reader.columnNames().size() == 2);
+    }
+    // Writing an array with a varying shape is an error.
+    Bool ok = False;
+    try {
+      ArrowTableWriter::write (tab, "tArrowTable_tmp.arrow3",
+                               stringToVector("TIME,VARSHAPE"));
+    } catch (const TableError& x) {
+      cout << "Expected exception: " << x.getMesg() << endl;
+      ok = True;
+    }
+    AlwaysAssertExit (ok);
+    // An empty table.
+    {
+      Table sel = tab(tab.col("TIME") < 0);
+      ArrowTableWriter::write (sel, "tArrowTable_tmp.arrow4",
+                               stringToVector("TIME,UVW,STRING"));
+      ArrowTableReader reader("tArrowTable_tmp.arrow4");
+      AlwaysAssertExit (reader.nrow() == 0);
+      AlwaysAssertExit (reader.getColumn<Double>("UVW").shape().isEqual
+                        (IPosition(2,3,0)));
+    }
+  } catch (const AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  return 0;
+}
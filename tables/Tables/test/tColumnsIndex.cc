@@ -31,6 +31,7 @@
 #include <casacore/tables/Tables/ScaColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ColumnsIndex.h>
+#include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
 #include <casacore/casa/Arrays/ArrayUtil.h>
 #include <casacore/casa/Containers/Record.h>
@@ -40,6 +41,7 @@
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/stdio.h>
+#include <unistd.h>
 
 
 #include <casacore/casa/namespace.h>
@@ -325,6 +327,121 @@ void d()
     cout << "<<<" << endl;
 }
 
+// Check the rows found for a key against the column data.
+void checkRows (const ColumnsIndex& colInx, const Vector<uInt>& rows,
+		const ScalarColumn<Int>& col, Int key)
+{
+    uInt nr = 0;
+    for (uInt i=0; i<col.nrow(); i++) {
+        if (col(i) == key) {
+	    nr++;
+	}
+    }
+    AlwaysAssertExit (rows.nelements() == nr);
+    for (uInt i=0; i<rows.nelements(); i++) {
+        AlwaysAssertExit (col(rows[i]) == key);
+    }
+}
+
+// Test the change tracking and the persistent index.
+void e()
+{
+    TableDesc td("", "1", TableDesc::Scratch);
+    td.addColumn (ScalarColumnDesc<Int>("ant"));
+    td.addColumn (ScalarColumnDesc<Double>("time"));
+    SetupNewTable newtab("tColumnsIndex_tmp.data2", td, Table::New);
+    Table tab(newtab, 100);
+    ScalarColumn<Int> ant(tab, "ant");
+    ScalarColumn<Double> time(tab, "time");
+    for (uInt i=0; i<100; i++) {
+        ant.put (i, i%10);
+	time.put (i, i/10);
+    }
+    ColumnsIndex colInx (tab, "ant");
+    RecordFieldPtr<Int> key (colInx.accessKey(), "ant");
+    *key = 3;
+    checkRows (colInx, colInx.getRowNumbers(), ant, 3);
+    // Added rows are merged into the index without telling it.
+    tab.addRow (50);
+    for (uInt i=100; i<150; i++) {
+        ant.put (i, 13 - i%17);
+	time.put (i, i/10);
+    }
+    for (Int k=-4; k<15; k++) {
+        *key = k;
+	checkRows (colInx, colInx.getRowNumbers(), ant, k);
+    }
+    // A change in an existing row and a row removal are also detected.
+    ant.put (3, 4);
+    tab.removeRow (10);
+    for (Int k=-4; k<15; k++) {
+        *key = k;
+	checkRows (colInx, colInx.getRowNumbers(), ant, k);
+    }
+    cout << colInx.getRowNumbers() << endl;
+    // Make an index persistent and use it in a new index object.
+    // Wait a second after writing the data, otherwise the index is
+    // marked invalid.
+    AlwaysAssertExit (! ColumnsIndex::hasPersistent
+		      (tab, Vector<String>(1, "ant")));
+    tab.flush();
+    sleep (1);
+    colInx.makePersistent();
+    AlwaysAssertExit (colInx.isPersistent());
+    AlwaysAssertExit (ColumnsIndex::hasPersistent
+		      (tab, Vector<String>(1, "ant")));
+    {
+        ColumnsIndex colInx2 (tab, "ant");
+	AlwaysAssertExit (colInx2.isPersistent());
+	RecordFieldPtr<Int> key2 (colInx2.accessKey(), "ant");
+	for (Int k=-4; k<15; k++) {
+	    *key2 = k;
+	    checkRows (colInx2, colInx2.getRowNumbers(), ant, k);
+	}
+    }
+    AlwaysAssertExit (! ColumnsIndex::getPersistent
+		      (tab, Vector<String>(1, "ant")).null());
+    // A selection uses the persistent index.
+    Table sel = tab(tab.col("ant") == 5  &&  tab.col("time") < 12);
+    cout << sel.rowNumbers() << endl;
+    sel = tab(tab.col("ant") > 10  &&  tab.col("ant") <= 12.5);
+    cout << sel.rowNumbers() << endl;
+    sel = tab(2 >= tab.col("ant")  &&  tab.col("ant") > 1.5);
+    cout << sel.rowNumbers() << endl;
+    // The selection is still right after a change of the data.
+    // It does not flush the table, nor does it update the index.
+    ant.put (0, 5);
+    AlwaysAssertExit (ColumnsIndex::getPersistent
+		      (tab, Vector<String>(1, "ant")).null());
+    sel = tab(tab.col("ant") == 5  &&  tab.col("time") < 12);
+    cout << sel.rowNumbers() << endl;
+    AlwaysAssertExit (ant.changeGeneration() != ant.flushedGeneration());
+    tab.flush();
+    AlwaysAssertExit (ant.changeGeneration() == ant.flushedGeneration());
+    AlwaysAssertExit (ColumnsIndex::getPersistent
+		      (tab, Vector<String>(1, "ant")).null());
+    sel = tab(tab.col("ant") == 5  &&  tab.col("time") < 12);
+    AlwaysAssertExit (ColumnsIndex::getPersistent
+		      (tab, Vector<String>(1, "ant")).null());
+    // Only an explicit flush of the index stores it again.
+    {
+        ColumnsIndex colInx3 (tab, "ant");
+	AlwaysAssertExit (colInx3.isPersistent());
+	RecordFieldPtr<Int> key3 (colInx3.accessKey(), "ant");
+	*key3 = 5;
+	checkRows (colInx3, colInx3.getRowNumbers(), ant, 5);
+	sleep (1);
+	colInx3.flush();
+    }
+    AlwaysAssertExit (! ColumnsIndex::getPersistent
+		      (tab, Vector<String>(1, "ant")).null());
+    ColumnsIndex::removePersistent (tab, Vector<String>(1, "ant"));
+    AlwaysAssertExit (! ColumnsIndex::hasPersistent
+		      (tab, Vector<String>(1, "ant")));
+    sel = tab(tab.col("ant") == 5  &&  tab.col("time") < 12);
+    cout << sel.rowNumbers() << endl;
+}
+
 int main()
 {
     try {
@@ -332,6 +449,7 @@ int main()
 	b();
 	c();
 	d();
+	e();
     } catch (AipsError x) {
         cout << "Exception caught: " << x.getMesg() << endl;
 	return 1;
@@ -53,7 +53,7 @@ void doIt()
 
   // Check if rownr mapping is fine.
   uInt tabnr;
-  uInt rownr;
+  rownr_t rownr;
   for (uInt i=0; i<10; ++i) {
     rows.mapRownr (tabnr, rownr, i);
     AlwaysAssertExit (tabnr == 0);
@@ -73,6 +73,18 @@ void doIt()
   }
   AlwaysAssertExit (!ok);
 
+  // Check that more than 2**32 rows can be concatenated.
+  {
+    ConcatRows bigRows;
+    bigRows.add (3000000000u);
+    bigRows.add (3000000000u);
+    AlwaysAssertExit (bigRows.nrow() == rownr_t(6000000000ll));
+    AlwaysAssertExit (bigRows.offset(1) == 3000000000u);
+    bigRows.mapRownr (tabnr, rownr, rownr_t(5000000000ll));
+    AlwaysAssertExit (tabnr == 1);
+    AlwaysAssertExit (rownr == 2000000000);
+  }
+
   // Check if iteration is fine.
   {
     // Check for an empty object.
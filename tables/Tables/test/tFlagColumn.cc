@@ -0,0 +1,158 @@
+//# tFlagColumn.cc: Test program for class FlagColumn
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables/FlagColumn.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/TiledCompressStMan.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// This program tests class FlagColumn using a flag column in a
+// TiledCompressStMan using the run-length codec and in a StandardStMan.
+
+// Make the flags of a row; channels 10-19 are flagged in some rows,
+// the first half of the band in others.
+FlagArray makeFlags (const IPosition& shape, uInt row)
+{
+  FlagArray flags(shape);
+  if (row%3 == 0) {
+    for (Int chan=10; chan<20; chan++) {
+      for (Int corr=0; corr<shape[0]; corr++) {
+        flags.putFlag (IPosition(2,corr,chan), True);
+      }
+    }
+  } else if (row%3 == 1) {
+    for (Int chan=0; chan<shape[1]/2; chan++) {
+      for (Int corr=0; corr<shape[0]; corr++) {
+        flags.putFlag (IPosition(2,corr,chan), True);
+      }
+    }
+  }
+  return flags;
+}
+
+void createTable (const IPosition& shape, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Bool>("FLAG", shape,
+                                      ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Bool>("FLAG2", shape,
+                                      ColumnDesc::FixedShape));
+  td.defineHypercolumn ("TSMFlag", 3, stringToVector("FLAG"));
+  SetupNewTable newtab("tFlagColumn_tmp.data", td, Table::New);
+  TiledCompressStMan tsm ("TSMFlag", IPosition(3,4,256,16),
+                          TSMCodec::RunLength);
+  StandardStMan ssm;
+  newtab.bindAll (ssm);
+  newtab.bindColumn ("FLAG", tsm);
+  Table tab(newtab, nrow);
+  FlagColumn flagCol(tab, "FLAG");
+  FlagColumn flagCol2(tab, "FLAG2");
+  for (uInt i=0; i<nrow; i++) {
+    FlagArray flags = makeFlags (shape, i);
+    flagCol.put (i, flags);
+    flagCol2.put (i, flags);
+  }
+}
+
+void checkTable (const String& colName, const IPosition& shape, uInt nrow)
+{
+  Table tab("tFlagColumn_tmp.data", Table::Update);
+  FlagColumn flagCol(tab, colName);
+  ArrayColumn<Bool> boolCol(tab, colName);
+  FlagArray flags;
+  for (uInt i=0; i<nrow; i++) {
+    FlagArray expected = makeFlags (shape, i);
+    flagCol.get (i, flags);
+    AlwaysAssertExit (flags == expected);
+    AlwaysAssertExit (allEQ (boolCol(i), expected.array()));
+  }
+  // Get a slice.
+  Slicer slicer(IPosition(2,1,5), IPosition(2,2,10));
+  flagCol.getSlice (0, slicer, flags);
+  AlwaysAssertExit (flags.shape() == IPosition(2,2,10));
+  AlwaysAssertExit (allEQ (flags.array(),
+                           makeFlags(shape,0).array()(slicer)));
+  // Get the entire column.
+  flagCol.getColumn (flags);
+  AlwaysAssertExit (flags.shape() == IPosition(3, shape[0], shape[1], nrow));
+  AlwaysAssertExit (allEQ (flags.array(), boolCol.getColumn()));
+  // OR flags into a row.
+  FlagArray extra(shape);
+  extra.putFlag (IPosition(2,3,100), True);
+  flagCol.orFlags (1, extra);
+  FlagArray expected = makeFlags (shape, 1) | extra;
+  AlwaysAssertExit (flagCol.getFlags(1) == expected);
+  // Put a slice and the entire column.
+  FlagArray sliceFlags(IPosition(2,2,10), True);
+  flagCol.putSlice (2, slicer, sliceFlags);
+  flagCol.getSlice (2, slicer, flags);
+  AlwaysAssertExit (flags.allFlagged());
+  FlagArray colFlags(IPosition(3, shape[0], shape[1], nrow), False);
+  flagCol.putColumn (colFlags);
+  flagCol.getColumn (flags);
+  AlwaysAssertExit (! flags.anyFlagged());
+  // Put the original flags back.
+  for (uInt i=0; i<nrow; i++) {
+    flagCol.put (i, makeFlags (shape, i));
+  }
+  cout << colName << " ok" << endl;
+}
+
+int main()
+{
+  try {
+    IPosition shape(2,4,256);
+    uInt nrow = 100;
+    createTable (shape, nrow);
+    checkTable ("FLAG", shape, nrow);
+    checkTable ("FLAG2", shape, nrow);
+    // The flags compress very well.
+    Table tab("tFlagColumn_tmp.data");
+    Record spec = tab.dataManagerInfo().subRecord(1).subRecord("SPEC");
+    cout << "CODEC=" << spec.asString("CODEC") << endl;
+    cout << "compressed "
+         << (spec.asInt64("CompressedSize") * 10 <
+             spec.asInt64("UncompressedSize"))
+         << endl;
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -30,10 +30,14 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/ScaColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/RefTable.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/TaQL/TableExprId.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/stdio.h>
+#include <limits>
 
 #include <casacore/casa/namespace.h>
 
@@ -108,9 +112,29 @@ void makeRef()
   readTab ("tRefTable_tmp.dataref", 10, 4);
 }
 
+void checkRowLimit()
+{
+  // The row numbers in a RefTable are 32-bit, so larger ones are refused
+  // instead of being truncated.
+  RefTable::checkRownr (std::numeric_limits<uInt>::max());
+  Bool ok = False;
+  try {
+    RefTable::checkRownr (rownr_t(std::numeric_limits<uInt>::max()) + 1);
+  } catch (const TableError&) {
+    ok = True;
+  }
+  AlwaysAssertExit (ok);
+  // A TableExprId does not truncate row numbers.
+  TableExprId id(rownr_t(5000000000ll));
+  AlwaysAssertExit (id.rownr() == 5000000000ll);
+  id.setRownr (rownr_t(6000000000ll));
+  AlwaysAssertExit (id.rownr() == 6000000000ll);
+}
+
 int main()
 {
   try {
+    checkRowLimit();
     makeTable();
     makeRef();
     readTab ("tRefTable_tmp.data", 10, 5);
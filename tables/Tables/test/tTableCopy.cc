@@ -147,6 +147,109 @@ void testCloneColumns()
   testCloneColumn (tsm3, True);
 }
 
+// Check if the columns in two tables are equal.
+void checkEqual (const Table& tab1, const Table& tab2)
+{
+  AlwaysAssertExit (tab1.nrow() == tab2.nrow());
+  AlwaysAssertExit (allEQ (ScalarColumn<Int>(tab1, "INT").getColumn(),
+                           ScalarColumn<Int>(tab2, "INT").getColumn()));
+  AlwaysAssertExit (allEQ (ScalarColumn<Double>(tab1, "TIME").getColumn(),
+                           ScalarColumn<Double>(tab2, "TIME").getColumn()));
+  AlwaysAssertExit (allEQ (ScalarColumn<String>(tab1, "NAME").getColumn(),
+                           ScalarColumn<String>(tab2, "NAME").getColumn()));
+  AlwaysAssertExit (allEQ (ArrayColumn<Double>(tab1, "UVW").getColumn(),
+                           ArrayColumn<Double>(tab2, "UVW").getColumn()));
+  ArrayColumn<Complex> data1(tab1, "DATA");
+  ArrayColumn<Complex> data2(tab2, "DATA");
+  ScalarColumn<TableRecord> rec1(tab1, "REC");
+  ScalarColumn<TableRecord> rec2(tab2, "REC");
+  for (uInt i=0; i<tab1.nrow(); ++i) {
+    AlwaysAssertExit (data1.isDefined(i) == data2.isDefined(i));
+    if (data1.isDefined(i)) {
+      AlwaysAssertExit (allEQ (data1(i), data2(i)));
+    }
+    AlwaysAssertExit (rec1(i).asInt("i") == rec2(i).asInt("i"));
+  }
+}
+
+// Test copying rows in blocks and in parallel.
+void testCopyRows()
+{
+  cout << "testCopyRows ..." << endl;
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("INT"));
+  td.addColumn (ScalarColumnDesc<Double>("TIME"));
+  td.addColumn (ScalarColumnDesc<String>("NAME"));
+  td.addColumn (ScalarRecordColumnDesc("REC"));
+  td.addColumn (ArrayColumnDesc<Double>("UVW", IPosition(1,3),
+                                        ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Complex>("DATA", 2));
+  {
+    SetupNewTable newtab("tTableCopy_tmp.rows", td, Table::New);
+    StandardStMan ssm;
+    IncrementalStMan ism;
+    TiledColumnStMan tcsm("TCSM", IPosition(2,3,128));
+    TiledShapeStMan tssm("TSSM", IPosition(3,2,8,64));
+    newtab.bindAll (ssm);
+    newtab.bindColumn ("TIME", ism);
+    newtab.bindColumn ("UVW", tcsm);
+    newtab.bindColumn ("DATA", tssm);
+    Table tab(newtab, 1000);
+    ScalarColumn<Int> intCol(tab, "INT");
+    ScalarColumn<Double> timeCol(tab, "TIME");
+    ScalarColumn<String> nameCol(tab, "NAME");
+    ScalarColumn<TableRecord> recCol(tab, "REC");
+    ArrayColumn<Double> uvwCol(tab, "UVW");
+    ArrayColumn<Complex> dataCol(tab, "DATA");
+    for (uInt i=0; i<tab.nrow(); ++i) {
+      intCol.put (i, i);
+      timeCol.put (i, 1e9 + i/10);
+      nameCol.put (i, "name" + String::toString(i%7));
+      TableRecord rec;
+      rec.define ("i", Int(i));
+      recCol.put (i, rec);
+      Vector<Double> uvw(3);
+      indgen (uvw, 3.*i);
+      uvwCol.put (i, uvw);
+      // Leave some cells undefined and vary the shape.
+      if (i%100 != 5) {
+        Matrix<Complex> data(2, (i < 500 ? 16 : 8));
+        indgen (data, Complex(i, -1.*i));
+        dataCol.put (i, data);
+      }
+    }
+  }
+  // Reading the table without locks makes a parallel copy possible.
+  Table tab("tTableCopy_tmp.rows", TableLock::UserNoReadLocking);
+  Record dminfo = tab.dataManagerInfo();
+  // Copy serially and in parallel.
+  for (uInt nthreads=1; nthreads<=4; nthreads+=3) {
+    Table out = TableCopy::makeEmptyTable
+      ("tTableCopy_tmp.rowscp", Record(), tab, Table::New,
+       Table::AipsrcEndian, True, True, StorageOption(),
+       TableLock(TableLock::PermanentLocking));
+    TableCopy::CopyStatistics stats =
+      TableCopy::copyRows (out, tab, True, nthreads);
+    cout << "copied " << stats.nrow << " rows " << (stats.nbytes > 0) << endl;
+    AlwaysAssertExit (stats.nthreads <= nthreads);
+    checkEqual (tab, out);
+  }
+  // Copy a selection of rows into the middle of a table.
+  {
+    Table sel = tab(tab.col("INT") >= 250);
+    Table out = TableCopy::makeEmptyTable
+      ("tTableCopy_tmp.rowscp", Record(), tab, Table::New,
+       Table::AipsrcEndian, True, False, StorageOption(),
+       TableLock(TableLock::PermanentLocking));
+    TableCopy::copyRows (out, sel, 100, 0, 500, True, 4);
+    Table part = out(out.nodeRownr() >= 100  &&  out.nodeRownr() < 600);
+    checkEqual (sel(sel.nodeRownr() < 500), part);
+  }
+  // A deep copy by value.
+  tab.deepCopy ("tTableCopy_tmp.rowscp", Table::New, True);
+  checkEqual (tab, Table("tTableCopy_tmp.rowscp"));
+}
+
 
 int main (int argc, const char* argv[])
 {
@@ -192,6 +295,7 @@ int main (int argc, const char* argv[])
     if (argc <= 1) {
       testDM();
       testCloneColumns();
+      testCopyRows();
     }
   } catch (const exception& x) {
     cout << x.what() << endl;
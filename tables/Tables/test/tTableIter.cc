@@ -30,10 +30,14 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/SetupNewTab.h>
 #include <casacore/tables/Tables/TableIter.h>
+#include <casacore/tables/Tables/ParTableIter.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Utilities/Assert.h>
 
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/sstream.h>
@@ -56,6 +60,7 @@ void doiter0();
 void doiter1();
 void doiter2();
 void doiter3();
+void doiter4();
 
 int main (int argc, const char* argv[])
 {
@@ -70,6 +75,7 @@ int main (int argc, const char* argv[])
     doiter1();         // do single column iteration
     doiter2();         // do two column iteration
     doiter3();         // do interval iteration
+    doiter4();         // do parallel iteration
     return 0;          // successfully executed
 }
 
@@ -274,3 +280,55 @@ void doiter3()
     }
     cout << "   #iter3=" << nr << endl;
 }
+
+// Worker summing col3 per iteration group.
+class SumWorker : public TableGroupWorker
+{
+public:
+  explicit SumWorker (std::vector<double>* sums)
+    : itsSums (sums)
+  {}
+  virtual TableGroupWorker* clone() const
+    { return new SumWorker(itsSums); }
+  virtual void attach (const Table& tab)
+    { itsCol.attach (tab, "col3"); }
+  virtual void read (uInt, rownr_t startRow, rownr_t nrow)
+    { itsCol.getColumnRange (Slicer(IPosition(1,startRow),
+                                    IPosition(1,nrow)), itsData, True); }
+  virtual void process (uInt groupnr)
+    { (*itsSums)[groupnr] = sum(itsData); }
+private:
+  std::vector<double>* itsSums;
+  ScalarColumn<float>  itsCol;
+  Vector<float>        itsData;
+};
+
+void doiter4()
+{
+    Table tab ("tTableIter_tmp.data");
+    Block<String> iv0(2);
+    iv0[0] = "col1";
+    iv0[1] = "col2";
+    TableIterator iter0(tab, iv0);
+    ParallelTableIterator piter(iter0);
+    uInt ngroup = piter.ngroup();
+    std::vector<double> sums(ngroup, -1.);
+    SumWorker worker(&sums);
+    piter.run (worker, 4);
+    // Check against the sequential iteration.
+    const std::vector<rownr_t>& groups = piter.groupBoundaries();
+    AlwaysAssertExit (groups.size() == ngroup+1);
+    AlwaysAssertExit (groups[ngroup] == tab.nrow());
+    uInt nr = 0;
+    while (!iter0.pastEnd()) {
+        Table t = iter0.table();
+        AlwaysAssertExit (t.nrow() == groups[nr+1] - groups[nr]);
+        AlwaysAssertExit (piter.group(nr).nrow() == t.nrow());
+        ScalarColumn<float> col3(t, "col3");
+        AlwaysAssertExit (sums[nr] == sum(col3.getColumn()));
+        nr++;
+        iter0.next();
+    }
+    AlwaysAssertExit (nr == ngroup);
+    cout << "   #pariter=" << nr << endl;
+}
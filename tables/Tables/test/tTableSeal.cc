@@ -0,0 +1,186 @@
+//# tTableSeal.cc: Test program for sealing tables
+//# Copyright (C) 2018
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for sealing tables.
+// </summary>
+
+// Get the version of the table file.
+uInt tableVersion (const String& name)
+{
+  AipsIO ios (name + "/table.dat");
+  return ios.getstart ("Table");
+}
+
+// Create a table with the given number of rows.
+Table createTable (const String& name, uInt nrow)
+{
+  TableDesc desc;
+  desc.addColumn (ScalarColumnDesc<Int>("col"));
+  SetupNewTable newtab (name, desc, Table::New);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> col(tab, "col");
+  for (uInt i=0; i<nrow; ++i) {
+    col.put (i, i);
+  }
+  return tab;
+}
+
+void checkTable (const String& name, uInt nrow)
+{
+  Table tab(name);
+  AlwaysAssertExit (tab.nrow() == nrow);
+  ScalarColumn<Int> col(tab, "col");
+  for (uInt i=0; i<nrow; ++i) {
+    AlwaysAssertExit (col(i) == Int(i));
+  }
+}
+
+void testSeal()
+{
+  {
+    Table tab = createTable ("tTableSeal_tmp.tab", 10);
+    Table sub = createTable ("tTableSeal_tmp.tab/SUB", 5);
+    tab.rwKeywordSet().defineTable ("SUB", sub);
+    // A table open in this process cannot be sealed.
+    Bool ok = False;
+    try {
+      Table::seal ("tTableSeal_tmp.tab");
+    } catch (TableError&) {
+      ok = True;
+    }
+    AlwaysAssertExit (ok);
+  }
+  AlwaysAssertExit (! Table::isSealed ("tTableSeal_tmp.tab"));
+  AlwaysAssertExit (! Table::checkSeal ("tTableSeal_tmp.tab"));
+  Table::seal ("tTableSeal_tmp.tab");
+  AlwaysAssertExit (Table::isSealed ("tTableSeal_tmp.tab"));
+  AlwaysAssertExit (Table::isSealed ("tTableSeal_tmp.tab/SUB"));
+  AlwaysAssertExit (Table::checkSeal ("tTableSeal_tmp.tab"));
+  AlwaysAssertExit (Table::checkSeal ("tTableSeal_tmp.tab/SUB"));
+  AlwaysAssertExit (! Table::isWritable ("tTableSeal_tmp.tab"));
+  AlwaysAssertExit (! Table::isWritable ("tTableSeal_tmp.tab"));
+  AlwaysAssertExit (tableVersion ("tTableSeal_tmp.tab") == 3);
+  // Sealing again is a no-op.
+  Table::seal ("tTableSeal_tmp.tab");
+}
+
+void testRead()
+{
+  // A sealed table does not need its lock file.
+  RegularFile("tTableSeal_tmp.tab/table.lock").remove();
+  RegularFile("tTableSeal_tmp.tab/SUB/table.lock").remove();
+  {
+    Table tab("tTableSeal_tmp.tab");
+    AlwaysAssertExit (tab.isSealed());
+    AlwaysAssertExit (tab.lockOptions().option() == TableLock::NoLocking);
+    AlwaysAssertExit (tab.lock (FileLocker::Write));
+    tab.resync();
+    checkTable ("tTableSeal_tmp.tab", 10);
+    // The subtable is opened readonly.
+    Table sub = tab.keywordSet().asTable ("SUB");
+    AlwaysAssertExit (sub.isSealed());
+    AlwaysAssertExit (! sub.isWritable());
+    AlwaysAssertExit (sub.nrow() == 5);
+    // The table cannot be made writable.
+    Bool ok = False;
+    try {
+      tab.reopenRW();
+    } catch (TableError&) {
+      ok = True;
+    }
+    AlwaysAssertExit (ok);
+  }
+  AlwaysAssertExit (! File("tTableSeal_tmp.tab/table.lock").exists());
+  AlwaysAssertExit (! File("tTableSeal_tmp.tab/SUB/table.lock").exists());
+  // It cannot be opened for write.
+  Bool ok = False;
+  try {
+    Table tab("tTableSeal_tmp.tab", Table::Update);
+  } catch (TableError&) {
+    ok = True;
+  }
+  AlwaysAssertExit (ok);
+}
+
+void testUnseal()
+{
+  Table::unseal ("tTableSeal_tmp.tab");
+  AlwaysAssertExit (! Table::isSealed ("tTableSeal_tmp.tab"));
+  AlwaysAssertExit (! Table::isSealed ("tTableSeal_tmp.tab/SUB"));
+  AlwaysAssertExit (Table::isWritable ("tTableSeal_tmp.tab"));
+  {
+    Table tab("tTableSeal_tmp.tab", Table::Update);
+    AlwaysAssertExit (! tab.isSealed());
+    tab.addRow();
+    ScalarColumn<Int> col(tab, "col");
+    col.put (10, 10);
+    Table sub = tab.keywordSet().asTable ("SUB");
+    AlwaysAssertExit (sub.isWritable());
+  }
+  checkTable ("tTableSeal_tmp.tab", 11);
+  // Seal again; the checksum changes because the table grew.
+  Table::seal ("tTableSeal_tmp.tab");
+  AlwaysAssertExit (Table::checkSeal ("tTableSeal_tmp.tab"));
+  checkTable ("tTableSeal_tmp.tab", 11);
+  Table::unseal ("tTableSeal_tmp.tab");
+  AlwaysAssertExit (! Table::checkSeal ("tTableSeal_tmp.tab"));
+  // An unsealed table is written in the old format.
+  AlwaysAssertExit (tableVersion ("tTableSeal_tmp.tab") == 2);
+  AlwaysAssertExit (tableVersion ("tTableSeal_tmp.tab/SUB") == 2);
+  AlwaysAssertExit (Table::isWritable ("tTableSeal_tmp.tab"));
+}
+
+int main()
+{
+  try {
+    testSeal();
+    testRead();
+    testUnseal();
+  } catch (AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
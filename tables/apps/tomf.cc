@@ -31,6 +31,7 @@
 #include <casacore/casa/IO/RegularFileIO.h>
 #include <casacore/casa/IO/FiledesIO.h>
 #include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/OS/Timer.h>
 #include <vector>
 #include <stdexcept>
 #include <iostream>
@@ -39,6 +40,15 @@ using namespace casacore;
 using namespace std;
 
 
+void showThroughput (Int64 size, double seconds)
+{
+  cout << "  " << size/1e6 << " MB in " << seconds << " sec";
+  if (seconds > 0) {
+    cout << " (" << size/1e6/seconds << " MB/sec)";
+  }
+  cout << endl;
+}
+
 int main (int argc, char* argv[])
 {
   try {
@@ -74,6 +84,8 @@ int main (int argc, char* argv[])
       mfile = new MultiFile (outName, ByteIO::New, blockSize);
     }
     Block<char> buffer (blockSize);
+    Timer totalTimer;
+    Int64 totalSize = 0;
     for (vector<String>::const_iterator iter=fname.begin();
          iter!=fname.end(); ++iter) {
       if (iter->empty()) {
@@ -84,14 +96,20 @@ int main (int argc, char* argv[])
         Int64 todo = file.length();
         cout << "  copying " << todo << " bytes of " << *iter
              << " ..." << endl;
+        Timer timer;
+        Int64 size = todo;
         MFFileIO outfile (*mfile, *iter, ByteIO::New);
         while (todo > 0) {
           Int64 sz = file.read (std::min(todo, blockSize), buffer.storage());
           outfile.write (sz, buffer.storage());
           todo -= sz;
         }
+        showThroughput (size, timer.real());
+        totalSize += size;
       }
     }
+    cout << "Total:";
+    showThroughput (totalSize, totalTimer.real());
     cout << endl;
   } catch (const std::exception& x) {
     cerr << x.what() << endl;